@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+namespace engine::core
+{
+
+////////////////////////////////////////////////
+// Numarul de alocari globale (operator new), pentru a verifica ca bucla de cadre nu mai aloca
+// - doar in Debug: AllocationCounter.cpp inlocuieste operator new / delete; in Release numaratoarea e mereu 0
+// - nu se numara operator new cu aliniere explicita si nici malloc direct (FrameArena)
+// - UncountedAllocationScope scoate din numaratoare alocarile facute la cerere (titlul ferestrei, statistici
+//   afisate la apasarea unei taste), pe thread-ul curent
+///////////////////////////////////////////////
+#ifdef _DEBUG
+inline constexpr bool AllocationCountingEnabled = true;
+#else
+inline constexpr bool AllocationCountingEnabled = false;
+#endif
+
+uint64_t GetAllocationCount();
+
+class UncountedAllocationScope
+{
+public:
+	UncountedAllocationScope();
+	~UncountedAllocationScope();
+	UncountedAllocationScope(const UncountedAllocationScope&) = delete;
+	UncountedAllocationScope& operator=(const UncountedAllocationScope&) = delete;
+};
+
+}  // namespace engine::core
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace engine::core
+{
+
+////////////////////////////////////////////////
+// Coada FIFO cu capacitate fixa, fara alocari (buffer circular in obiect)
+// - Push pe o coada plina pierde elementul cel mai vechi, ca bufferele de input
+///////////////////////////////////////////////
+template <typename T, size_t Capacity>
+class FixedQueue
+{
+	static_assert(Capacity > 0);
+
+public:
+	FixedQueue() = default;
+	~FixedQueue() { Clear(); }
+	FixedQueue(const FixedQueue&) = delete;
+	FixedQueue& operator=(const FixedQueue&) = delete;
+
+	void Push(const T& value)
+	{
+		if (m_size == Capacity)
+			Pop();
+
+		new (m_storage + ((m_first + m_size) % Capacity) * sizeof(T)) T(value);
+		m_size++;
+	}
+
+	void Pop()
+	{
+		assert(m_size > 0);
+
+		std::destroy_at(GetSlot(m_first));
+		m_first = (m_first + 1) % Capacity;
+		m_size--;
+	}
+
+	void Clear()
+	{
+		while (m_size > 0)
+			Pop();
+		m_first = 0;
+	}
+
+	T& Front()
+	{
+		assert(m_size > 0);
+		return *GetSlot(m_first);
+	}
+	const T& Front() const
+	{
+		assert(m_size > 0);
+		return *GetSlot(m_first);
+	}
+
+	inline bool IsEmpty() const { return m_size == 0; }
+	inline size_t GetSize() const { return m_size; }
+	static constexpr size_t GetCapacity() { return Capacity; }
+
+private:
+	T* GetSlot(size_t index) { return std::launder(reinterpret_cast<T*>(m_storage + index * sizeof(T))); }
+	const T* GetSlot(size_t index) const
+	{
+		return std::launder(reinterpret_cast<const T*>(m_storage + index * sizeof(T)));
+	}
+
+	alignas(T) std::byte m_storage[Capacity * sizeof(T)];
+	size_t m_first = 0;
+	size_t m_size = 0;
+};
+
+}  // namespace engine::core
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace engine::core
+{
+
+////////////////////////////////////////////////
+// Alocator liniar pentru datele temporare ale unui cadru
+// - fiecare thread are arena lui (GetThreadArena); se goleste la primul acces dupa BeginFrame
+// - Allocate doar avanseaza intr-un bloc; eliberarea individuala nu exista, totul se elibereaza la Reset
+// - cand blocul curent se umple se leaga unul nou; Reset le inlocuieste cu unul singur de marimea tuturor, asa ca
+//   dupa cateva cadre arena nu mai aloca deloc
+// - blocurile vin din malloc, nu din operator new: nu se numara ca alocari ale cadrului
+///////////////////////////////////////////////
+class FrameArena
+{
+public:
+	static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+	FrameArena() = default;
+	~FrameArena();
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator=(const FrameArena&) = delete;
+
+	void* Allocate(size_t size, size_t alignment);
+	// Toate alocarile de pana acum devin invalide
+	void Reset();
+
+	inline size_t GetUsedSize() const { return m_usedSize; }
+	inline size_t GetPeakSize() const { return m_peakSize; }
+	inline size_t GetCapacity() const { return m_capacity; }
+	// De cate ori s-a legat un bloc nou; ramane constant cand arena si-a atins marimea
+	inline uint64_t GetGrowCount() const { return m_growCount; }
+
+	// Arena thread-ului curent, golita daca de la ultimul acces a inceput un cadru nou
+	static FrameArena& GetThreadArena();
+	// La inceputul fiecarui cadru, pe thread-ul principal, cand nu mai traieste nimic alocat in cadrul trecut
+	static void BeginFrame();
+	static uint64_t GetFrame();
+
+	// Cu ocolirea activa FrameAllocator ia memoria din operator new, ca inainte de arena (comparatia din rularea fara
+	// interfata); se schimba doar intre cadre, cand nu mai traieste nicio alocare a cadrului
+	static void SetBypass(bool bypass);
+	static bool IsBypassed();
+
+private:
+	struct Block
+	{
+		Block* pPrevious;
+		size_t size;
+	};
+
+	void AddBlock(size_t minSize);
+	void FreeBlocks();
+
+	// Blocul curent e ultimul legat
+	Block* m_pBlock = nullptr;
+	std::byte* m_pCurrent = nullptr;
+	std::byte* m_pEnd = nullptr;
+
+	size_t m_usedSize = 0;
+	size_t m_peakSize = 0;
+	size_t m_capacity = 0;
+	uint64_t m_growCount = 0;
+};
+
+// Alocator STL peste arena thread-ului curent; deallocate nu face nimic, in afara de ocolirea arenei
+template <typename T>
+class FrameAllocator
+{
+public:
+	using value_type = T;
+
+	FrameAllocator() noexcept = default;
+	template <typename U>
+	FrameAllocator(const FrameAllocator<U>&) noexcept
+	{
+	}
+
+	T* allocate(size_t count)
+	{
+		if (count > std::numeric_limits<size_t>::max() / sizeof(T))
+			throw std::bad_array_new_length();
+
+		if (FrameArena::IsBypassed())
+			return static_cast<T*>(::operator new(count * sizeof(T)));
+
+		return static_cast<T*>(FrameArena::GetThreadArena().Allocate(count * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* pointer, size_t) noexcept
+	{
+		if (FrameArena::IsBypassed())
+			::operator delete(pointer);
+	}
+
+	template <typename U>
+	bool operator==(const FrameAllocator<U>&) const noexcept
+	{
+		return true;
+	}
+};
+
+// Doar pentru variabile locale dintr-un cadru: memoria dispare la urmatorul BeginFrame, chiar daca vectorul e gol
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+}  // namespace engine::core
@@ -84,6 +84,24 @@ class Settings
 
 		INLINE bool UseBundles() { return useBundles; }
 
+		// Chunk-urile si obiectele se deseneaza cu ExecuteIndirect in loc de draw-uri inregistrate unul cate unul
+		INLINE bool UseIndirectDraws() { return useIndirectDraws; }
+
+		// Obiectele vizibile cu acelasi mesh si material se deseneaza cu un singur draw instantiat
+		INLINE bool UseInstancing() { return useInstancing; }
+
+		// Datele obiectelor si materialelor stau in structured buffere indexate prin root constants, nu in CB-uri
+		INLINE bool UseBindlessData() { return useBindlessData; }
+
+		// Workerii care inregistreaza pass-urile rasterizarii pe command list-uri separate; 0 = totul pe contextul de
+		// cadru, pe thread-ul principal
+		INLINE UINT GetRecordingThreadCount() { return recordingThreadCount; }
+
+		// Bugetul de memorie video al procesului dupa care se evacueaza texturile; 0 = bugetul dat de DXGI, altfel
+		// minimul dintre cele doua (ex. pentru a simula o placa mai mica)
+		INLINE UINT GetResidencyBudgetMB() { return residencyBudgetMB; }
+		INLINE void SetResidencyBudgetMB(UINT toSet) { residencyBudgetMB = toSet; }
+
 	private:
 		friend Settings;
 
@@ -120,6 +138,11 @@ class Settings
 		bool isRayTracingSupported = false;
 
 		bool useBundles = true;
+		bool useIndirectDraws = true;
+		bool useInstancing = true;
+		bool useBindlessData = true;
+		UINT recordingThreadCount = 3;
+		UINT residencyBudgetMB = 0;
 	};
 
 	class GameSettings
@@ -0,0 +1,58 @@
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace engine::core
+{
+
+namespace
+{
+std::atomic<uint64_t> g_allocationCount = 0;
+thread_local int g_uncountedDepth = 0;
+}  // namespace
+
+uint64_t GetAllocationCount()
+{
+	return g_allocationCount.load(std::memory_order_relaxed);
+}
+
+UncountedAllocationScope::UncountedAllocationScope()
+{
+	g_uncountedDepth++;
+}
+
+UncountedAllocationScope::~UncountedAllocationScope()
+{
+	g_uncountedDepth--;
+}
+
+}  // namespace engine::core
+
+#ifdef _DEBUG
+
+// Inlocuirile sunt in acelasi fisier cu GetAllocationCount, ca linker-ul sa le ia din biblioteca statica.
+// new[], new nothrow si delete[] trec prin acestea in CRT
+void* operator new(std::size_t size)
+{
+	if (engine::core::g_uncountedDepth == 0)
+		engine::core::g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+	if (void* p = std::malloc(size != 0 ? size : 1))
+		return p;
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+#endif
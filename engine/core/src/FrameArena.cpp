@@ -0,0 +1,133 @@
+#include "FrameArena.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+
+namespace engine::core
+{
+
+namespace
+{
+std::atomic<uint64_t> g_frame = 0;
+std::atomic<bool> g_bypass = false;
+
+// Datele incep dupa antet, aliniate ca malloc
+constexpr size_t BlockHeaderSize =
+	(sizeof(void*) + sizeof(size_t) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+}  // namespace
+
+FrameArena::~FrameArena()
+{
+	FreeBlocks();
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+	assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+	size = std::max<size_t>(size, 1);
+
+	uintptr_t address = ((uintptr_t)m_pCurrent + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	if (m_pBlock == nullptr || address + size > (uintptr_t)m_pEnd)
+	{
+		AddBlock(size + alignment);
+		address = ((uintptr_t)m_pCurrent + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	}
+
+	std::byte* pNext = (std::byte*)(address + size);
+	m_usedSize += pNext - m_pCurrent;
+	m_peakSize = std::max(m_peakSize, m_usedSize);
+	m_pCurrent = pNext;
+
+	return (void*)address;
+}
+
+void FrameArena::Reset()
+{
+	// Mai multe blocuri inseamna ca arena a crescut in cadrul trecut: se inlocuiesc cu unul singur
+	if (m_pBlock != nullptr && m_pBlock->pPrevious != nullptr)
+	{
+		const size_t capacity = m_capacity;
+		FreeBlocks();
+		AddBlock(capacity);
+	}
+	else if (m_pBlock != nullptr)
+	{
+		m_pCurrent = (std::byte*)m_pBlock + BlockHeaderSize;
+	}
+
+	m_usedSize = 0;
+}
+
+FrameArena& FrameArena::GetThreadArena()
+{
+	thread_local FrameArena arena;
+	thread_local uint64_t arenaFrame = 0;
+
+	const uint64_t frame = g_frame.load(std::memory_order_acquire);
+	if (arenaFrame != frame)
+	{
+		arena.Reset();
+		arenaFrame = frame;
+	}
+
+	return arena;
+}
+
+void FrameArena::BeginFrame()
+{
+	g_frame.fetch_add(1, std::memory_order_release);
+}
+
+uint64_t FrameArena::GetFrame()
+{
+	return g_frame.load(std::memory_order_acquire);
+}
+
+void FrameArena::SetBypass(bool bypass)
+{
+	g_bypass.store(bypass, std::memory_order_release);
+}
+
+bool FrameArena::IsBypassed()
+{
+	return g_bypass.load(std::memory_order_acquire);
+}
+
+void FrameArena::AddBlock(size_t minSize)
+{
+	// Cel putin cat toate blocurile de pana acum, ca numarul de blocuri sa creasca logaritmic
+	const size_t size = std::max({minSize, m_capacity, DefaultBlockSize});
+
+	Block* pBlock = (Block*)std::malloc(BlockHeaderSize + size);
+	if (pBlock == nullptr)
+		throw std::bad_alloc();
+
+	pBlock->pPrevious = m_pBlock;
+	pBlock->size = size;
+
+	m_pBlock = pBlock;
+	m_pCurrent = (std::byte*)pBlock + BlockHeaderSize;
+	m_pEnd = m_pCurrent + size;
+
+	m_capacity += size;
+	m_growCount++;
+}
+
+void FrameArena::FreeBlocks()
+{
+	while (m_pBlock != nullptr)
+	{
+		Block* pPrevious = m_pBlock->pPrevious;
+		std::free(m_pBlock);
+		m_pBlock = pPrevious;
+	}
+
+	m_pCurrent = nullptr;
+	m_pEnd = nullptr;
+	m_capacity = 0;
+}
+
+}  // namespace engine::core
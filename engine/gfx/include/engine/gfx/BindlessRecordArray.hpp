@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace engine::gfx
+{
+
+////////////////////////////////////////////////
+// Recordurile unui buffer bindless (obiecte, materiale, instante), impachetate la rand dupa index
+// - indexul unui record e ID-ul lui (ex. GetObjectCB_ID); shaderul il primeste ca root constant
+// - capacitatea creste prin dublare cand se scrie un index in afara ei; bufferul GPU se realoca la urmatorul upload
+// - se tine intervalul modificat de la ultimul upload, deci se copiaza doar recordurile scrise
+// - partea GPU e GrowableStructuredBuffer
+///////////////////////////////////////////////
+template <class T>
+class BindlessRecordArray
+{
+public:
+	static constexpr uint32_t MinCapacity = 64;
+
+	// Cea mai mica capacitate obtinuta prin dublare care cuprinde required
+	static inline uint32_t GetGrownCapacity(uint32_t capacity, uint32_t required)
+	{
+		uint32_t grown = std::max(capacity, MinCapacity);
+		while (grown < required)
+		{
+			grown *= 2;
+		}
+
+		return grown;
+	}
+
+	inline void Reserve(uint32_t capacity) { m_capacity = GetGrownCapacity(m_capacity, capacity); }
+
+	inline void Write(uint32_t index, const T& record)
+	{
+		if (index >= m_capacity)
+			m_capacity = GetGrownCapacity(m_capacity, index + 1);
+
+		if (index >= m_records.size())
+			m_records.resize(index + 1);
+
+		m_records[index] = record;
+
+		m_dirtyBegin = std::min(m_dirtyBegin, index);
+		m_dirtyEnd = std::max(m_dirtyEnd, index + 1);
+	}
+
+	inline const T& operator[](uint32_t index) const
+	{
+		assert(index < m_records.size());
+		return m_records[index];
+	}
+
+	inline uint32_t GetCount() const { return (uint32_t)m_records.size(); }
+	inline uint32_t GetCapacity() const { return m_capacity; }
+	inline const T* GetData() const { return m_records.data(); }
+
+	// Intervalul [begin, end) scris de la ultimul ClearDirty
+	inline bool IsDirty() const { return m_dirtyBegin < m_dirtyEnd; }
+	inline uint32_t GetDirtyBegin() const { return m_dirtyBegin; }
+	inline uint32_t GetDirtyEnd() const { return m_dirtyEnd; }
+
+	inline void ClearDirty()
+	{
+		m_dirtyBegin = UINT32_MAX;
+		m_dirtyEnd = 0;
+	}
+
+	// Dupa realocarea bufferului GPU toate recordurile trebuie copiate din nou
+	inline void MarkAllDirty()
+	{
+		m_dirtyBegin = 0;
+		m_dirtyEnd = GetCount();
+	}
+
+private:
+	std::vector<T> m_records;
+	uint32_t m_capacity = 0;
+
+	uint32_t m_dirtyBegin = UINT32_MAX;
+	uint32_t m_dirtyEnd = 0;
+};
+
+}  // namespace engine::gfx
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::gfx
+{
+
+////////////////////////////////////////////////
+// Alocator buddy peste un interval [0, capacity)
+// - fiecare alocare ocupa un bloc de minBlockSize * 2^k octeti, aliniat la marimea lui; la eliberare blocul se
+//   reuneste cu buddy-ul lui cat timp acesta e liber
+// - din blocurile libere de aceeasi marime se alege cel cu offset-ul cel mai mic, ca alocarile sa se stranga la
+//   inceputul intervalului
+// - offset-urile sunt in heap-ul sau bufferul apelantului
+///////////////////////////////////////////////
+class BuddyAllocator
+{
+public:
+	static constexpr uint64_t InvalidOffset = UINT64_MAX;
+
+	// capacity si minBlockSize puteri ale lui 2, capacity >= minBlockSize
+	void Create(uint64_t capacity, uint64_t minBlockSize);
+
+	// alignment putere a lui 2; InvalidOffset daca nu exista un bloc liber destul de mare
+	uint64_t Allocate(uint64_t size, uint64_t alignment);
+	void Free(uint64_t offset);
+
+	// Marimea blocului ocupat de alocarea de la offset (>= marimea ceruta)
+	uint64_t GetBlockSize(uint64_t offset) const;
+	void GetAllocationOffsets(std::vector<uint64_t>& offsets) const;
+
+	inline uint64_t GetCapacity() const { return m_capacity; }
+	inline uint64_t GetUsedSize() const { return m_usedSize; }
+	inline size_t GetAllocationCount() const { return m_allocations.size(); }
+	uint64_t GetLargestFreeBlockSize() const;
+
+private:
+	uint64_t m_capacity = 0;
+	uint64_t m_minBlockSize = 0;
+	uint64_t m_usedSize = 0;
+
+	// Offset-urile blocurilor libere, pe ordine (blocul de ordin k are minBlockSize << k octeti)
+	std::vector<std::set<uint64_t>> m_freeBlocks;
+	// Offset alocare -> ordinul blocului
+	std::unordered_map<uint64_t, uint32_t> m_allocations;
+};
+
+}  // namespace engine::gfx
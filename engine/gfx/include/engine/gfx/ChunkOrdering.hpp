@@ -0,0 +1,60 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace engine::gfx
+{
+
+////////////////////////////////////////////////
+// Ordinea chunk-urilor de teren si de apa
+// - in memorie: de-a lungul unei curbe Hilbert (GeometryGenerator::GenerateChunks)
+// - la desenare: pe benzi de distanta fata de camera (GeometryRenderer::OrderChunksFrontToBack)
+// - nu depinde de D3D12 / DirectXMath, ca sa se poata testa si masura separat
+///////////////////////////////////////////////
+struct ChunkOrdering
+{
+	// Pozitia d de pe curba Hilbert care acopera o grila side x side (side putere a lui 2) -> (row, column)
+	static void HilbertCurveToGrid(const int side, int d, int& row, int& column);
+
+	// Counting sort pe BandCount benzi egale intre 0 si maxDistance, O(n); ce e mai departe ajunge in ultima banda.
+	// In interiorul unei benzi ramane ordinea indicilor. distance(i) se apeleaza de doua ori pentru fiecare element.
+	template <uint32_t BandCount, typename DistanceFunction>
+	static void SortByDistanceBands(
+		uint32_t count, DistanceFunction distance, float maxDistance, std::vector<uint32_t>& order);
+};
+
+template <uint32_t BandCount, typename DistanceFunction>
+void ChunkOrdering::SortByDistanceBands(
+	uint32_t count, DistanceFunction distance, float maxDistance, std::vector<uint32_t>& order)
+{
+	const float bandScale = BandCount / maxDistance;
+
+	const auto computeBand = [&distance, bandScale](uint32_t i) -> uint32_t
+	{
+		return std::min((uint32_t)(distance(i) * bandScale), BandCount - 1);
+	};
+
+	std::array<uint32_t, BandCount + 1> bandStart = {};
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		bandStart[computeBand(i) + 1]++;
+	}
+
+	for (uint32_t band = 1; band <= BandCount; band++)
+	{
+		bandStart[band] += bandStart[band - 1];
+	}
+
+	order.resize(count);
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		order[bandStart[computeBand(i)]++] = i;
+	}
+}
+
+}  // namespace engine::gfx
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CommandSequenceCache.hpp"
+#include "Context.hpp"
+#include "DrawPacket.hpp"
+#include "engine/core/TickTimer.hpp"
+
+namespace engine::gfx
+{
+
+// Timpii de inregistrare ai ultimului Execute, in secunde
+struct CommandBundleStatistics
+{
+	bool isRecorded = false;
+	float recordingTime = 0.f;
+	// Bundle-ul refolosit: timpul ultimei inregistrari a slotului, evitat in acest cadru
+	float savedTime = 0.f;
+};
+
+////////////////////////////////////////////////
+// Draw-urile unei cozi sortate, inregistrate intr-un bundle D3D12 si refolosite cat timp intrarile nu se schimba
+// - cate un bundle pentru fiecare frame resource; slotul cadrului curent se reinregistreaza doar cand amprenta
+//   cozii (draw-uri vizibile, PSO-uri, buffere si CB-uri legate) difera de cea de la ultima lui inregistrare
+// - bundle-ul seteaza root signature-ul primit, care trebuie sa fie cel al command list-ului apelant; pass CB-ul si
+//   tabelele de descriptori se mostenesc de la apelant
+///////////////////////////////////////////////
+class CommandBundle
+{
+public:
+	using Ptr = std::unique_ptr<CommandBundle>;
+
+	static CommandBundle::Ptr CreateCommandBundle();
+
+	void Execute(
+		GraphicsContext& graphicsContext, const RootSignature& rootSignature, const RenderQueue<DrawPacket>& queue);
+
+	// Toate sloturile se reinregistreaza la urmatorul Execute
+	inline void Invalidate() { m_cache.Invalidate(); }
+
+	inline const CommandBundleStatistics& GetStatistics() const { return m_statistics; }
+
+private:
+	CommandBundle() = default;
+
+	std::array<GraphicsContext::Ptr, engine::core::Settings::GetFrameResourcesCount()> m_bundles;
+	std::array<float, engine::core::Settings::GetFrameResourcesCount()> m_recordingTimes = {};
+
+	CommandSequenceCache m_cache;
+
+	engine::core::TickTimer<float> m_timer;
+	CommandBundleStatistics m_statistics;
+};
+
+}  // namespace engine::gfx
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace engine::gfx
+{
+
+////////////////////////////////////////////////
+// Contexte de inregistrare (command allocator + command list) refolosite dupa ce GPU-ul le-a terminat
+// - un context eliberat cu valoarea de fence a submit-ului lui redevine disponibil cand fence-ul cozii o atinge;
+//   pana atunci Acquire creeaza un context nou, deci pool-ul creste doar pana la numarul de contexte in zbor
+// - contextele eliberate se refolosesc in ordinea eliberarii, deci fence-urile se verifica crescator
+// - Acquire / Release doar de pe thread-ul care construieste cadrul; contextele luate se inregistreaza apoi pe workeri
+// - contextele sunt create de factory-ul primit
+///////////////////////////////////////////////
+template <class Context>
+class CommandContextPool
+{
+public:
+	using Factory = std::function<std::unique_ptr<Context>()>;
+
+	inline void Create(Factory factory) { m_factory = std::move(factory); }
+
+	Context& Acquire(uint64_t completedFenceValue)
+	{
+		if (!m_retired.empty() && m_retired.front().fenceValue <= completedFenceValue)
+		{
+			Context* context = m_retired.front().context;
+			m_retired.pop_front();
+
+			return *context;
+		}
+
+		assert(m_factory);
+		m_contexts.push_back(m_factory());
+
+		return *m_contexts.back();
+	}
+
+	// Contextul se poate refolosi dupa ce coada semnaleaza fenceValue
+	inline void Release(Context& context, uint64_t fenceValue)
+	{
+		assert(m_retired.empty() || m_retired.back().fenceValue <= fenceValue);
+		m_retired.push_back({fenceValue, &context});
+	}
+
+	inline size_t GetSize() const { return m_contexts.size(); }
+	inline size_t GetRetiredCount() const { return m_retired.size(); }
+
+private:
+	struct RetiredContext
+	{
+		uint64_t fenceValue;
+		Context* context;
+	};
+
+	Factory m_factory;
+
+	std::vector<std::unique_ptr<Context>> m_contexts;
+	std::deque<RetiredContext> m_retired;
+};
+
+}  // namespace engine::gfx
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace engine::gfx
+{
+
+// Amprenta FNV-1a pe 64 de biti a intrarilor unei secvente de comenzi
+class CommandFingerprint
+{
+public:
+	void Add(const void* data, size_t size);
+
+	// Doar pentru valori fara padding (scalari, pointeri); structurile se adauga camp cu camp
+	template <class T>
+	inline void Add(const T& value)
+	{
+		static_assert(std::is_scalar_v<T>, "Structurile se adauga camp cu camp");
+		Add(&value, sizeof(T));
+	}
+
+	inline uint64_t Get() const { return m_hash; }
+
+private:
+	uint64_t m_hash = 14695981039346656037ull;
+};
+
+////////////////////////////////////////////////
+// Starea de invalidare a unei secvente inregistrate o singura data si refolosite (bundle)
+// - o secventa are cate un slot pentru fiecare frame resource: comenzile unui cadru raman in folosinta pe GPU
+//   pana cand cadrul se termina, deci fiecare slot se reinregistreaza separat
+// - un slot se reinregistreaza doar daca amprenta intrarilor (draw-uri vizibile, PSO-uri, resurse legate) difera
+//   de cea de la ultima inregistrare in acel slot, sau dupa Invalidate
+///////////////////////////////////////////////
+class CommandSequenceCache
+{
+public:
+	void Create(uint32_t slotCount);
+
+	bool NeedsRecording(uint32_t slot, uint64_t fingerprint) const;
+	void MarkRecorded(uint32_t slot, uint64_t fingerprint);
+
+	// Toate sloturile se reinregistreaza la urmatoarea folosire (ex. resurse recreate)
+	void Invalidate();
+
+private:
+	struct Slot
+	{
+		bool isRecorded;
+		uint64_t fingerprint;
+	};
+
+	std::vector<Slot> m_slots;
+};
+
+}  // namespace engine::gfx
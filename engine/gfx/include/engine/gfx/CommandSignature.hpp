@@ -0,0 +1,47 @@
+#pragma once
+
+#include "RootSignature.hpp"
+
+#include <memory>
+
+namespace engine::gfx
+{
+
+////////////////////////////////////////////////
+// Command signature pentru ExecuteIndirect, potrivita cu layout-urile din IndirectDrawBuilder
+// - DrawIndexed: doar IndirectDrawIndexedArguments (chunk-uri de teren / apa)
+// - ObjectDraw: root CBV pentru CB-ul de obiect + draw (IndirectObjectDrawArguments)
+// - BindlessObjectDraw: 2 root constants (obiect, material) + draw, acelasi stride (IndirectObjectDrawArguments)
+///////////////////////////////////////////////
+class CommandSignature
+{
+public:
+	using Ptr = std::unique_ptr<CommandSignature>;
+
+	static CommandSignature::Ptr CreateDrawIndexed(ID3D12Device* pDevice);
+	static CommandSignature::Ptr CreateObjectDraw(
+		ID3D12Device* pDevice, const RootSignature& rootSignature, UINT objectCBRootIndex);
+	static CommandSignature::Ptr CreateBindlessObjectDraw(
+		ID3D12Device* pDevice, const RootSignature& rootSignature, UINT drawConstantsRootIndex);
+
+	inline ID3D12CommandSignature* GetID3D12CommandSignature() const { return m_commandSignature.Get(); }
+	inline UINT GetByteStride() const { return m_byteStride; }
+	// Root argumentele scrise de ExecuteIndirect (bitul i = indexul i); dupa executie valorile lor sunt necunoscute
+	inline UINT64 GetRootArgumentMask() const { return m_rootArgumentMask; }
+
+private:
+	CommandSignature() = default;
+
+	void Create(
+		ID3D12Device* pDevice,
+		const D3D12_INDIRECT_ARGUMENT_DESC* arguments,
+		UINT argumentCount,
+		UINT byteStride,
+		ID3D12RootSignature* pRootSignature);
+
+	Microsoft::WRL::ComPtr<ID3D12CommandSignature> m_commandSignature;
+	UINT m_byteStride = 0;
+	UINT64 m_rootArgumentMask = 0;
+};
+
+}  // namespace engine::gfx
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine::gfx
+{
+
+// Matrice 4x4 pe randuri, cu layout-ul lui Matrix4 / XMFLOAT4X4
+struct Float4x4
+{
+	float m[16];
+};
+
+// Layout-ul ObjectConstantBuffer: matricele transpuse, cum le citeste HLSL
+struct ObjectRecord
+{
+	Float4x4 worldMatrix;
+	Float4x4 invWorldMatrix;
+	Float4x4 textureTransform;
+};
+
+////////////////////////////////////////////////
+// Impachetarea recordurilor din constant buffere
+// - matricele se proceseaza cate 4 odata cu SSE, cate o matrice pe lane; restul de la capat se completeaza cu
+//   identitate
+///////////////////////////////////////////////
+void TransposeMatrices(const Float4x4* pMatrices, size_t count, Float4x4* pTransposes);
+// Inversele si inversele transpuse (ce se scrie in CB pentru inversa) pentru count matrice; oricare iesire poate fi
+// nullptr. O matrice singulara da valori infinite / NaN, ca XMMatrixInverse
+void InvertMatrices(const Float4x4* pMatrices, size_t count, Float4x4* pInverses, Float4x4* pInverseTransposes);
+
+// Recordurile a count obiecte, din transformul si transformul de textura al fiecaruia
+void PackObjectRecords(
+	const Float4x4* pTransforms, const Float4x4* pTextureTransforms, size_t count, ObjectRecord* pRecords);
+
+////////////////////////////////////////////////
+// Versiunea scrisa ultima data pentru fiecare record al unei copii a datelor (ex. bufferele unui FrameResources)
+// - versiunea 0 inseamna nescris; sursele numara versiunile de la 1
+// - un record se rescrie doar daca versiunea sursei difera de cea scrisa
+///////////////////////////////////////////////
+class RecordVersionTracker
+{
+public:
+	inline bool IsStale(uint32_t id, uint32_t version) const
+	{
+		return id >= m_versions.size() || m_versions[id] != version;
+	}
+
+	inline void SetWritten(uint32_t id, uint32_t version)
+	{
+		if (id >= m_versions.size())
+			m_versions.resize(id + 1, 0);
+
+		m_versions[id] = version;
+	}
+
+	// Toate recordurile se rescriu (ex. dupa realocarea bufferului)
+	inline void Invalidate() { m_versions.clear(); }
+
+private:
+	std::vector<uint32_t> m_versions;
+};
+
+}  // namespace engine::gfx
@@ -1,12 +1,17 @@
 #pragma once
 
+#include "CommandContextPool.hpp"
+#include "CommandSignature.hpp"
 #include "FrameResources.hpp"
 #include "GPUBuffers.hpp"
+#include "GraphicsCommandFilter.hpp"
 #include "PipelineState.hpp"
 #include "RootSignature.hpp"
 #include "Texture.hpp"
+#include "UploadManager.hpp"
 #include "d3dx12.h"
 
+#include "engine/core/FrameArena.hpp"
 #include "engine/core/Settings.hpp"
 
 namespace engine::gfx
@@ -36,7 +41,12 @@ class CommandContext
 	void CopyBuffer(GpuResource& Dest, GpuResource& Src);
 	void CopyBufferRegion(GpuResource& Dest, size_t DestOffset, GpuResource& Src, size_t SrcOffset, size_t NumBytes);
 
+	// Tranzitiile trec prin trackerul listei: prima folosire a unei resurse in lista se rezolva la submit
 	void TransitionResource(GpuResource& Resource, D3D12_RESOURCE_STATES NewState, bool FlushImmediate = false);
+	// Doar o subresursa (ex. o fata sau un mip), cu indexul dat de D3D12CalcSubresource
+	void TransitionSubresource(
+		GpuResource& Resource, UINT Subresource, D3D12_RESOURCE_STATES NewState, bool FlushImmediate = false);
+	// Tranzitie split: se termina la urmatorul TransitionResource spre aceeasi stare sau la inchiderea listei
 	void BeginResourceTransition(GpuResource& Resource, D3D12_RESOURCE_STATES NewState, bool FlushImmediate = false);
 	void InsertUAVBarrier(GpuResource& Resource, bool FlushImmediate = false);
 	void InsertAliasBarrier(GpuResource& Before, GpuResource& After, bool FlushImmediate = false);
@@ -48,24 +58,35 @@ class CommandContext
 
 	void Finish(ID3D12CommandQueue* pCommandQueue);
 	void End(ID3D12CommandQueue* pCommandQueue);
+	// Inchide command list-ul fara sa-l trimita pe coada (bundle-uri)
+	void Close();
 	void Reset();
 
 	void FlushResourceBarriers(void);
 
+	// Apelurile redundante filtrate de la ultimul Reset (pentru contextele de frame, cadrul curent)
+	inline const StateFilterStatistics& GetStateFilterStatistics() const { return m_commandFilter.GetStatistics(); }
+
 protected:
+	// Muta tranzitiile noi ale trackerului in bufferul de bariere
+	void QueueTrackedBarriers();
+	void QueueTransition(const StateTransition& transition);
+
 	Microsoft::WRL::ComPtr<ID3D12CommandAllocator> pCommandAllocator;
 	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList7> pCommandList;
 	Microsoft::WRL::ComPtr<ID3D12Fence> pFence;
 	HANDLE m_fenceEvent;
 
-	ID3D12RootSignature* m_CurGraphicsRootSignature;
 	ID3D12RootSignature* m_CurComputeRootSignature;
-	ID3D12PipelineState* m_CurPipelineState;
+
+	// Apelurile de stare trec prin filtru, care sare peste cele redundante
+	GraphicsCommandFilter<ID3D12GraphicsCommandList7> m_commandFilter;
 
 	D3D12_COMMAND_LIST_TYPE m_Type;
 
-	D3D12_RESOURCE_BARRIER m_ResourceBarrierBuffer[16];
-	UINT m_NumBarriersToFlush;
+	// Barierele se aduna pana la urmatorul punct de flush (draw, copiere, submit) si se trimit intr-un singur apel
+	std::vector<D3D12_RESOURCE_BARRIER> m_ResourceBarrierBuffer;
+	ResourceStateTracker m_stateTracker;
 
 	ID3D12DescriptorHeap* m_CurrentDescriptorHeaps[D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES];
 
@@ -98,6 +119,9 @@ class GraphicsContext : public CommandContext
 
 	void SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY Topology);
 	void SetConstantBuffer(UINT RootIndex, D3D12_GPU_VIRTUAL_ADDRESS CBV);
+	void SetShaderResourceView(UINT RootIndex, D3D12_GPU_VIRTUAL_ADDRESS SRV);
+	void SetConstant(UINT RootIndex, UINT Value, UINT DestOffset = 0);
+	void SetConstants(UINT RootIndex, UINT Value0, UINT Value1);
 	void SetDescriptorTable(UINT RootIndex, D3D12_GPU_DESCRIPTOR_HANDLE FirstHandle);
 	void SetDescriptorTable(UINT RootIndex, D3D12_DESCRIPTOR_HEAP_TYPE type);
 	void SetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW& IBView);
@@ -114,6 +138,14 @@ class GraphicsContext : public CommandContext
 		UINT StartIndexLocation,
 		INT BaseVertexLocation,
 		UINT StartInstanceLocation);
+	void ExecuteIndirect(
+		const CommandSignature& commandSignature,
+		UINT MaxCommandCount,
+		ID3D12Resource* pArgumentBuffer,
+		UINT64 ArgumentBufferOffset,
+		ID3D12Resource* pCountBuffer,
+		UINT64 CountBufferOffset);
+	void ExecuteBundle(GraphicsContext& bundle);
 
 	void BuildRaytracingAccelerationStructure(
 		D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC* pDesc,
@@ -159,46 +191,80 @@ class ContextManager
 	ID3D12CommandQueue* GetCommandQueue() { return pCommandQueue.Get(); }
 	UINT& GetFrameIndex() { return frameIndex; }
 
+	// Copierile adunate pleaca pe coada de copiere la Flush / SwapContext, inaintea oricarei liste de pe coada directa
+	inline UploadManager& GetUploadManager() { return m_uploadManager; }
+
+	// Context pentru un pass inregistrat separat (ex. pe un worker), deja resetat; se trimite pe coada inaintea
+	// contextului de cadru, in ordinea in care a fost luat
+	GraphicsContext& AcquireRecordingContext();
+
+	// Fence-ul ultimului cadru trimis cu SwapContext si cel atins de GPU; leaga de cadru resursele folosite in el
+	inline UINT64 GetSubmittedFenceValue() const { return m_queueFenceValue; }
+	inline UINT64 GetCompletedFenceValue() const { return pQueueFence->GetCompletedValue(); }
+
+	// Apelurile de stare filtrate in ultimul cadru trimis cu SwapContext, adunate din contextul de cadru si din cele
+	// de inregistrare
+	inline const StateFilterStatistics& GetStateFilterStatistics() const { return m_lastFrameStateFilterStatistics; }
+
 	void Flush(bool waitForCompletition);
 	void End();
 	void SwapContext();
 
+private:
+	// Trimite contextele luate cu AcquireRecordingContext si le elibereaza cu fence-ul submit-ului
+	void SubmitRecordingContexts();
+	// Trimite un context de cadru (Finish sau End), precedat de tranzitiile cerute de prima folosire a resurselor in el
+	void SubmitFrameContext(GraphicsContext& context, bool waitForCompletition);
+	// Inchide tranzitiile listei si publica starile ei; tranzitiile de la starea publicata anterior se inregistreaza
+	// pe un context din pool, adaugat in commandLists / pooledContexts inaintea listei
+	void ResolveResourceStates(
+		CommandContext& context,
+		engine::core::FrameVector<ID3D12CommandList*>& commandLists,
+		engine::core::FrameVector<GraphicsContext*>& pooledContexts);
+	void ExecutePooledContexts(
+		const engine::core::FrameVector<ID3D12CommandList*>& commandLists,
+		const engine::core::FrameVector<GraphicsContext*>& pooledContexts);
+
 private:
 	std::array<GraphicsContext::Ptr, engine::core::Settings::GetFrameResourcesCount()> m_graphicsContexts;
 	std::array<ComputeContext::Ptr, engine::core::Settings::GetFrameResourcesCount()> m_computeContexts;
 	std::array<FrameResources::Ptr, engine::core::Settings::GetFrameResourcesCount()> m_frameResources;
 
+	CommandContextPool<GraphicsContext> m_recordingContexts;
+	std::vector<GraphicsContext*> m_pendingRecordingContexts;
+	// Semnalat dupa contextele din pool si dupa fiecare cadru trimis
+	Microsoft::WRL::ComPtr<ID3D12Fence> pQueueFence;
+	UINT64 m_queueFenceValue;
+
+	// Fiecare context se aduna o data, cand e trimis; se muta in m_lastFrameStateFilterStatistics la SwapContext
+	StateFilterStatistics m_frameStateFilterStatistics;
+	StateFilterStatistics m_lastFrameStateFilterStatistics;
+
 	Microsoft::WRL::ComPtr<ID3D12CommandQueue> pCommandQueue;
 	UINT frameIndex;
+
+	UploadManager m_uploadManager;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 // Definire inline-uri
 inline void CommandContext::SetPipelineState(const PipelineState& pipelineState)
 {
-	ID3D12PipelineState* nativeState = pipelineState.GetID3D12PipelineState();
-	if (nativeState == m_CurPipelineState)
-		return;
-
-	pCommandList->SetPipelineState(nativeState);
-	m_CurPipelineState = nativeState;
+	m_commandFilter.SetPipelineState(pipelineState.GetID3D12PipelineState());
 }
 
 inline void CommandContext::FlushResourceBarriers(void)
 {
-	if (m_NumBarriersToFlush > 0)
+	if (!m_ResourceBarrierBuffer.empty())
 	{
-		pCommandList->ResourceBarrier(m_NumBarriersToFlush, m_ResourceBarrierBuffer);
-		m_NumBarriersToFlush = 0;
+		pCommandList->ResourceBarrier((UINT)m_ResourceBarrierBuffer.size(), m_ResourceBarrierBuffer.data());
+		m_ResourceBarrierBuffer.clear();
 	}
 }
 
 inline void GraphicsContext::SetRootSignature(const RootSignature& rs)
 {
-	if (rs.GetID3D12RootSignature() == m_CurGraphicsRootSignature)
-		return;
-
-	pCommandList->SetGraphicsRootSignature(m_CurGraphicsRootSignature = rs.GetID3D12RootSignature());
+	m_commandFilter.SetGraphicsRootSignature(rs.GetID3D12RootSignature());
 }
 
 inline void ComputeContext::SetRootSignature(const RootSignature& rs)
@@ -211,7 +277,7 @@ inline void ComputeContext::SetRootSignature(const RootSignature& rs)
 
 inline void ComputeContext::SetPipelineStateObject(const PipelineState& pipelineState)
 {
-	pCommandList->SetPipelineState1(pipelineState.GetID3D12StateObject());
+	m_commandFilter.SetPipelineState1(pipelineState.GetID3D12StateObject());
 }
 
 inline void CommandContext::SetDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE Type, ID3D12DescriptorHeap* HeapPtr)
@@ -254,12 +320,28 @@ inline void GraphicsContext::SetScissor(UINT left, UINT top, UINT right, UINT bo
 
 inline void GraphicsContext::SetConstantBuffer(UINT RootIndex, D3D12_GPU_VIRTUAL_ADDRESS CBV)
 {
-	pCommandList->SetGraphicsRootConstantBufferView(RootIndex, CBV);
+	m_commandFilter.SetGraphicsRootConstantBufferView(RootIndex, CBV);
+}
+
+inline void GraphicsContext::SetShaderResourceView(UINT RootIndex, D3D12_GPU_VIRTUAL_ADDRESS SRV)
+{
+	m_commandFilter.SetGraphicsRootShaderResourceView(RootIndex, SRV);
+}
+
+inline void GraphicsContext::SetConstant(UINT RootIndex, UINT Value, UINT DestOffset)
+{
+	m_commandFilter.SetGraphicsRoot32BitConstant(RootIndex, Value, DestOffset);
+}
+
+inline void GraphicsContext::SetConstants(UINT RootIndex, UINT Value0, UINT Value1)
+{
+	const UINT values[] = {Value0, Value1};
+	m_commandFilter.SetGraphicsRoot32BitConstants(RootIndex, 2, values, 0);
 }
 
 inline void GraphicsContext::SetDescriptorTable(UINT RootIndex, D3D12_GPU_DESCRIPTOR_HANDLE FirstHandle)
 {
-	pCommandList->SetGraphicsRootDescriptorTable(RootIndex, FirstHandle);
+	m_commandFilter.SetGraphicsRootDescriptorTable(RootIndex, FirstHandle);
 }
 
 inline void GraphicsContext::SetDescriptorTable(UINT RootIndex, D3D12_DESCRIPTOR_HEAP_TYPE type)
@@ -269,7 +351,7 @@ inline void GraphicsContext::SetDescriptorTable(UINT RootIndex, D3D12_DESCRIPTOR
 
 inline void GraphicsContext::SetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW& IBView)
 {
-	pCommandList->IASetIndexBuffer(&IBView);
+	m_commandFilter.IASetIndexBuffer(&IBView);
 }
 
 inline void GraphicsContext::SetVertexBuffer(UINT Slot, const D3D12_VERTEX_BUFFER_VIEW& VBView)
@@ -279,7 +361,7 @@ inline void GraphicsContext::SetVertexBuffer(UINT Slot, const D3D12_VERTEX_BUFFE
 
 inline void GraphicsContext::SetVertexBuffers(UINT StartSlot, UINT Count, const D3D12_VERTEX_BUFFER_VIEW VBViews[])
 {
-	pCommandList->IASetVertexBuffers(StartSlot, Count, VBViews);
+	m_commandFilter.IASetVertexBuffers(StartSlot, Count, VBViews);
 }
 
 inline void GraphicsContext::Draw(UINT VertexCount, UINT VertexStartOffset)
@@ -311,6 +393,31 @@ inline void GraphicsContext::DrawIndexedInstanced(
 		IndexCountPerInstance, InstanceCount, StartIndexLocation, BaseVertexLocation, StartInstanceLocation);
 }
 
+inline void GraphicsContext::ExecuteIndirect(
+	const CommandSignature& commandSignature,
+	UINT MaxCommandCount,
+	ID3D12Resource* pArgumentBuffer,
+	UINT64 ArgumentBufferOffset,
+	ID3D12Resource* pCountBuffer,
+	UINT64 CountBufferOffset)
+{
+	FlushResourceBarriers();
+	m_commandFilter.ExecuteIndirect(
+		commandSignature.GetID3D12CommandSignature(),
+		commandSignature.GetRootArgumentMask(),
+		MaxCommandCount,
+		pArgumentBuffer,
+		ArgumentBufferOffset,
+		pCountBuffer,
+		CountBufferOffset);
+}
+
+inline void GraphicsContext::ExecuteBundle(GraphicsContext& bundle)
+{
+	FlushResourceBarriers();
+	m_commandFilter.ExecuteBundle(bundle.GetCommandList());
+}
+
 inline void GraphicsContext::BuildRaytracingAccelerationStructure(
 	D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC* pDesc,
 	UINT NumPostbuildInfoDescs,
@@ -321,7 +428,7 @@ inline void GraphicsContext::BuildRaytracingAccelerationStructure(
 
 inline void GraphicsContext::SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY Topology)
 {
-	pCommandList->IASetPrimitiveTopology(Topology);
+	m_commandFilter.IASetPrimitiveTopology(Topology);
 }
 
 inline void ComputeContext::SetDescriptorTable(UINT RootIndex, D3D12_GPU_DESCRIPTOR_HANDLE FirstHandle)
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+namespace engine::gfx
+{
+
+struct DeferredReleaseStatistics
+{
+	uint64_t pendingCount = 0;
+	uint64_t pendingSize = 0;
+	// Cel mai mare pendingSize atins
+	uint64_t peakPendingSize = 0;
+	uint64_t releasedCount = 0;
+	uint64_t releasedSize = 0;
+};
+
+////////////////////////////////////////////////
+// Obiecte a caror distrugere asteapta GPU-ul (resurse, memoria lor, date CPU citite de copieri)
+// - Retire leaga tot ce s-a adaugat de la Retire-ul anterior de fence-ul submit-ului care le foloseste, ca la
+//   UploadRingAllocator; Release elibereaza, in ordine, obiectele submit-urilor terminate
+// - size e doar pentru contabilizarea memoriei (octetii tinuti in viata pana la eliberare)
+// - eliberarea propriu-zisa e functia primita de Release
+///////////////////////////////////////////////
+template <class T>
+class DeferredReleaseQueue
+{
+public:
+	void Push(T item, uint64_t size)
+	{
+		m_entries.push_back({UnretiredFenceValue, size, std::move(item)});
+		m_unretiredCount++;
+
+		m_statistics.pendingCount++;
+		m_statistics.pendingSize += size;
+		m_statistics.peakPendingSize = std::max(m_statistics.peakPendingSize, m_statistics.pendingSize);
+	}
+
+	void Retire(uint64_t fenceValue)
+	{
+		assert(fenceValue != UnretiredFenceValue);
+		assert(m_entries.size() == m_unretiredCount || m_entries[m_entries.size() - m_unretiredCount - 1].fenceValue
+			<= fenceValue);
+
+		for (size_t i = m_entries.size() - m_unretiredCount; i < m_entries.size(); i++)
+		{
+			m_entries[i].fenceValue = fenceValue;
+		}
+
+		m_unretiredCount = 0;
+	}
+
+	// Apeleaza release(item) pentru obiectele terminate, in ordinea adaugarii; intoarce octetii eliberati
+	template <class Function>
+	uint64_t Release(uint64_t completedFenceValue, Function&& release)
+	{
+		return ReleaseUntil(m_entries.size() - m_unretiredCount, completedFenceValue, release);
+	}
+
+	// Doar cu GPU-ul oprit (ex. la distrugerea device-ului); elibereaza si obiectele nelegate de un fence
+	template <class Function>
+	uint64_t ReleaseAll(Function&& release)
+	{
+		m_unretiredCount = 0;
+		return ReleaseUntil(m_entries.size(), UnretiredFenceValue, release);
+	}
+
+	inline bool IsEmpty() const { return m_entries.empty(); }
+	inline const DeferredReleaseStatistics& GetStatistics() const { return m_statistics; }
+
+private:
+	static constexpr uint64_t UnretiredFenceValue = UINT64_MAX;
+
+	struct Entry
+	{
+		uint64_t fenceValue;
+		uint64_t size;
+		T item;
+	};
+
+	template <class Function>
+	uint64_t ReleaseUntil(size_t retiredCount, uint64_t completedFenceValue, Function& release)
+	{
+		uint64_t releasedSize = 0;
+
+		for (; retiredCount != 0 && m_entries.front().fenceValue <= completedFenceValue; retiredCount--)
+		{
+			Entry entry = std::move(m_entries.front());
+			m_entries.pop_front();
+
+			m_statistics.pendingCount--;
+			m_statistics.pendingSize -= entry.size;
+			m_statistics.releasedCount++;
+			m_statistics.releasedSize += entry.size;
+			releasedSize += entry.size;
+
+			release(entry.item);
+		}
+
+		return releasedSize;
+	}
+
+	std::deque<Entry> m_entries;
+	// Ultimele m_unretiredCount obiecte asteapta Retire
+	size_t m_unretiredCount = 0;
+
+	DeferredReleaseStatistics m_statistics;
+};
+
+}  // namespace engine::gfx
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "UploadRingAllocator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace engine::gfx
+{
+
+////////////////////////////////////////////////
+// Indicii descriptorilor unui heap, impartit in doua regiuni
+// - regiunea persistenta [0, persistentCount): lista de intervale libere; Allocate ia primul interval liber de la
+//   inceputul heap-ului, deci fara eliberari alocarile consecutive raman alaturate si in ordine (tabelele legate la
+//   inceputul heap-ului depind de asta); Free uneste intervalul cu vecinii liberi
+// - regiunea tranzitorie [persistentCount, persistentCount + transientCount): inel pentru tabelele unui cadru,
+//   eliberat cu fence-ul submit-ului care le foloseste (Retire / Reclaim, ca la UploadRingAllocator)
+///////////////////////////////////////////////
+class DescriptorAllocator
+{
+public:
+	static constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+	void Create(uint32_t persistentCount, uint32_t transientCount);
+
+	// InvalidIndex daca niciun interval liber nu are count descriptori
+	uint32_t Allocate(uint32_t count);
+	// Descriptorii se pot refolosi imediat: apelantul garanteaza ca GPU-ul nu-i mai citeste
+	void Free(uint32_t index, uint32_t count);
+
+	// InvalidIndex daca inelul e plin pana la terminarea unui submit
+	uint32_t AllocateTransient(uint32_t count);
+	void RetireTransient(uint64_t fenceValue);
+	void ReclaimTransient(uint64_t completedFenceValue);
+
+	inline uint32_t GetPersistentCount() const { return m_persistentCount; }
+	inline uint32_t GetTransientCount() const { return (uint32_t)m_transientRing.GetCapacity(); }
+	inline uint32_t GetFreeCount() const { return m_freeCount; }
+	inline size_t GetFreeRangeCount() const { return m_freeRanges.size(); }
+	uint32_t GetLargestFreeRange() const;
+	inline uint32_t GetTransientUsedCount() const { return (uint32_t)m_transientRing.GetUsedSize(); }
+
+private:
+	uint32_t m_persistentCount = 0;
+	uint32_t m_freeCount = 0;
+
+	// Inceputul intervalului -> numarul de descriptori; intervalele alaturate sunt mereu unite
+	std::map<uint32_t, uint32_t> m_freeRanges;
+
+	UploadRingAllocator m_transientRing;
+};
+
+}  // namespace engine::gfx
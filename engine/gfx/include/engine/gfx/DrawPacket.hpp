@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CommandSequenceCache.hpp"
+#include "CommandSignature.hpp"
+#include "IndirectDrawBuilder.hpp"
+#include "PipelineState.hpp"
+#include "RenderQueue.hpp"
+
+namespace engine::gfx
+{
+
+class GraphicsContext;
+
+// Layer-ele cheii de sortare pentru pass-urile de rasterizare
+namespace RenderQueueLayer
+{
+enum Value : uint32_t
+{
+	// Skybox-ul nu are depth test, deci trebuie desenat inaintea geometriei opace
+	Background = 0,
+	Opaque = 1
+};
+}
+
+////////////////////////////////////////////////
+// Un draw complet descris, trimis in RenderQueue si redat prin GraphicsContext
+// - toate pachetele unui pass folosesc root signature-ul deja setat (Default); pass CB-ul si tabelele de
+//   descriptori raman cele setate inainte de redare
+// - adresele 0 inseamna "nu se seteaza" (ex. pachetele fara material CB)
+// - signature != nullptr: draw-ul se face cu ExecuteIndirect din argumentBuffer, altfel cu draw
+///////////////////////////////////////////////
+struct DrawPacket
+{
+	const GraphicsPSO* pso = nullptr;
+	D3D12_PRIMITIVE_TOPOLOGY topology = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+
+	// Adresele view-urilor ramase valabile pana la redare (membrii bufferelor renderer-elor)
+	const D3D12_VERTEX_BUFFER_VIEW* vertexBufferView = nullptr;
+	const D3D12_INDEX_BUFFER_VIEW* indexBufferView = nullptr;
+
+	D3D12_GPU_VIRTUAL_ADDRESS objectCB = 0;
+	D3D12_GPU_VIRTUAL_ADDRESS materialCB = 0;
+
+	// Datele bindless: indecsii recordurilor de obiect si material, trimisi ca root constants in locul CB-urilor
+	bool useDrawConstants = false;
+	UINT objectIndex = 0;
+	UINT materialIndex = 0;
+
+	// Desenarea instantiata: bufferul de instante si pozitia primei instante
+	D3D12_GPU_VIRTUAL_ADDRESS instanceData = 0;
+	UINT instanceOffset = 0;
+
+	IndirectDrawIndexedArguments draw = {};
+
+	const CommandSignature* signature = nullptr;
+	ID3D12Resource* argumentBuffer = nullptr;
+	UINT64 argumentOffset = 0;
+	UINT64 countOffset = 0;
+	UINT maxCommandCount = 0;
+};
+
+// Numarul de schimbari de stare facute la ultima redare
+struct DrawPacketReplayStatistics
+{
+	UINT packetCount = 0;
+	UINT pipelineStateChanges = 0;
+	UINT bufferChanges = 0;
+	UINT constantBufferChanges = 0;
+};
+
+// Reda coada sortata; fiecare stare se seteaza doar cand difera de cea a pachetului anterior
+DrawPacketReplayStatistics ReplayDrawPackets(GraphicsContext& graphicsContext, const RenderQueue<DrawPacket>& queue);
+
+// Adauga la amprenta toate pachetele cozii sortate, in ordinea de redare; view-urile de buffer dupa continut
+void AddDrawPackets(CommandFingerprint& fingerprint, const RenderQueue<DrawPacket>& queue);
+
+}  // namespace engine::gfx
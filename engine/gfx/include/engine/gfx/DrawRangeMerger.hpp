@@ -0,0 +1,47 @@
+#pragma once
+
+#include "SubMesh.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::gfx
+{
+
+// Interval continuu din index buffer desenat cu un singur DrawIndexed
+struct DrawRange
+{
+	uint32_t startIndexLocation;
+	uint32_t indexCount;
+	int32_t baseVertexLocation;
+
+	inline uint32_t GetEndIndexLocation() const { return startIndexLocation + indexCount; }
+};
+
+////////////////////////////////////////////////
+// Uneste intervalele de indecsi ale chunk-urilor vizibile in cat mai putine draw-uri
+// - un interval nou se lipeste de ultimul daca incepe exact unde se termina acela (si are acelasi base vertex)
+// - ordinea intervalelor adaugate se pastreaza; adaugate in ordinea din index buffer rezulta lista minima
+///////////////////////////////////////////////
+class DrawRangeMerger
+{
+public:
+	inline void Reset() { m_ranges.clear(); }
+
+	void Add(uint32_t startIndexLocation, uint32_t indexCount, int32_t baseVertexLocation);
+	inline void Add(const SubMesh& subMesh)
+	{
+		Add((uint32_t)subMesh.startIndexLocation, (uint32_t)subMesh.indexCount, (int32_t)subMesh.baseVertexLocation);
+	}
+
+	inline const std::vector<DrawRange>& GetRanges() const { return m_ranges; }
+	inline size_t GetDrawCount() const { return m_ranges.size(); }
+
+	// Lista minima pentru o multime oarecare de intervale disjuncte (sortare + unire)
+	static std::vector<DrawRange> MergeMinimal(std::vector<DrawRange> ranges);
+
+private:
+	std::vector<DrawRange> m_ranges;
+};
+
+}  // namespace engine::gfx
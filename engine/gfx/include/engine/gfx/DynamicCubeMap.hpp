@@ -22,10 +22,12 @@ class DynamicCubeMap
 		return m_cubeMapTexture->GetRtvHandle(index);
 	}
 	inline const CubeMapCameraController& GetCameraController() const { return m_cameraController; }
+	inline ColorTexture& GetCubeMapTexture() { return *m_cubeMapTexture; }
+	inline DepthTexture& GetDepthTexture() { return *m_depthTexture; }
 
+	// Tranzitiile texturilor le pune graful cadrului
 	void Setup(GraphicsContext& graphicsContext);
 	void SetRenderTarget(GraphicsContext& graphicsContext, UINT index);
-	void Finish(GraphicsContext& graphicsContext);
 
 	inline float GetCubeMapSphereRadius() const { return m_cubeMapSphereRadius; }
 	inline engine::math::Vector3 GetCubeMapCenter() const { return m_center; }
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "ResourceStateTracker.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine::gfx
+{
+
+// Utilizarile unei resurse intr-un pass, independente de API; un pass poate cere mai multe utilizari deodata (masca)
+namespace FrameGraphUsage
+{
+using Mask = uint32_t;
+
+enum Value : Mask
+{
+	Undefined = 0,
+	RenderTarget = 1 << 0,
+	DepthWrite = 1 << 1,
+	UnorderedAccess = 1 << 2,
+	CopyDest = 1 << 3,
+	DepthRead = 1 << 4,
+	ShaderResource = 1 << 5,
+	CopySource = 1 << 6,
+	Present = 1 << 7
+};
+
+constexpr Mask WriteMask = RenderTarget | DepthWrite | UnorderedAccess | CopyDest;
+
+inline bool IsReadOnly(Mask usage)
+{
+	return (usage & WriteMask) == 0;
+}
+}  // namespace FrameGraphUsage
+
+// O versiune a unei resurse: ImportResource / CreateTransient dau versiunea initiala, fiecare Write una noua
+using FrameGraphResource = uint32_t;
+using FrameGraphPass = uint32_t;
+
+// Tranzitia unei resurse inaintea unui pass sau la sfarsitul cadrului
+// - resource e indexul resursei fizice (ordinea ImportResource / CreateTransient)
+// - before == Undefined la prima folosire a unei resurse tranzitorii: continutul e nedefinit (aliasing)
+// - o tranzitie split apare de doua ori: BeginOnly imediat dupa ultima folosire, EndOnly in pass-ul care o cere
+struct FrameGraphBarrier
+{
+	uint32_t resource;
+	FrameGraphUsage::Mask before;
+	FrameGraphUsage::Mask after;
+	SplitBarrier::Value split;
+};
+
+struct FrameGraphMemoryStatistics
+{
+	// Resursele tranzitorii folosite, fiecare in memoria ei
+	uint64_t transientBytes = 0;
+	// Heap-ul comun in care resursele cu durate de viata disjuncte se suprapun
+	uint64_t aliasedBytes = 0;
+	uint32_t culledPasses = 0;
+	uint32_t barrierCount = 0;
+};
+
+////////////////////////////////////////////////
+// Graful unui cadru: pass-urile declara ce resurse citesc si scriu, Compile decide restul
+// - ordinea: sortare topologica dupa dependinte (producator -> cititor, cititori -> urmatorul scriitor); la egalitate
+//   ramane ordinea declararii
+// - culling: raman pass-urile cu efecte laterale, cele care scriu resurse importate (rezultatul iese din cadru) si
+//   producatorii versiunilor citite de acestea; un Write nu citeste continutul anterior, daca il foloseste il declara
+//   si cu Read
+// - barierele: o singura tranzitie per resursa per pass; o resursa trecuta intr-o stare de citire primeste direct
+//   toate citirile urmatoare pana la urmatorul scriitor, deci nu mai are tranzitii intre ele; cu useSplitBarriers o
+//   tranzitie cu pass-uri libere inaintea ei devine split (jumatatile trebuie inregistrate pe acelasi command list)
+// - aliasing: resursele tranzitorii primesc offset-uri intr-un heap comun; doua resurse se suprapun in memorie doar
+//   daca duratele lor de viata (primul - ultimul pass care le foloseste) sunt disjuncte
+// - Reset pastreaza memoria pass-urilor si resurselor: un graf reconstruit la fel in fiecare cadru nu mai aloca
+// - backend-ul traduce utilizarile in stari si aplica barierele
+///////////////////////////////////////////////
+class FrameGraph
+{
+public:
+	static constexpr FrameGraphPass NoPass = UINT32_MAX;
+	static constexpr uint64_t NoOffset = UINT64_MAX;
+
+	void Reset();
+
+	// initialUsage: starea la inceputul cadrului; finalUsage: starea ceruta la sfarsit (Undefined = oricare)
+	FrameGraphResource ImportResource(
+		std::string_view name, FrameGraphUsage::Mask initialUsage, FrameGraphUsage::Mask finalUsage);
+	FrameGraphResource CreateTransient(std::string_view name, uint64_t sizeInBytes, uint64_t alignment);
+
+	FrameGraphPass AddPass(std::string_view name, bool hasSideEffects = false);
+	void Read(FrameGraphPass pass, FrameGraphResource resource, FrameGraphUsage::Mask usage);
+	// Doar ultima versiune a unei resurse se poate scrie; intoarce versiunea noua
+	FrameGraphResource Write(FrameGraphPass pass, FrameGraphResource resource, FrameGraphUsage::Mask usage);
+
+	void Compile(bool useSplitBarriers = false);
+
+	// Rezultatele Compile
+	inline const std::vector<FrameGraphPass>& GetExecutionOrder() const { return m_executionOrder; }
+	inline bool IsCulled(FrameGraphPass pass) const { return m_passes[pass].isCulled; }
+	inline const std::vector<FrameGraphBarrier>& GetBarriers(FrameGraphPass pass) const
+	{
+		return m_passes[pass].barriers;
+	}
+	inline const std::vector<FrameGraphBarrier>& GetFinalBarriers() const { return m_finalBarriers; }
+	inline uint64_t GetTransientOffset(uint32_t resourceIndex) const { return m_resources[resourceIndex].offset; }
+	inline const FrameGraphMemoryStatistics& GetMemoryStatistics() const { return m_statistics; }
+
+	inline uint32_t GetResourceIndex(FrameGraphResource resource) const { return m_versions[resource].resource; }
+	inline uint32_t GetResourceCount() const { return m_resourceCount; }
+	inline uint32_t GetPassCount() const { return m_passCount; }
+	inline const std::string& GetResourceName(uint32_t resourceIndex) const { return m_resources[resourceIndex].name; }
+	inline const std::string& GetPassName(FrameGraphPass pass) const { return m_passes[pass].name; }
+
+private:
+	struct Resource
+	{
+		std::string name;
+		bool isImported;
+		FrameGraphUsage::Mask initialUsage;
+		FrameGraphUsage::Mask finalUsage;
+		uint64_t sizeInBytes;
+		uint64_t alignment;
+		FrameGraphResource lastVersion;
+		uint64_t offset;
+	};
+
+	struct Version
+	{
+		uint32_t resource;
+		FrameGraphPass producer;
+		// Versiunea din care a fost scrisa (pentru ordinea fata de cititorii ei)
+		FrameGraphResource previous;
+		std::vector<FrameGraphPass> readers;
+	};
+
+	struct Access
+	{
+		FrameGraphResource version;
+		FrameGraphUsage::Mask usage;
+	};
+
+	struct Pass
+	{
+		std::string name;
+		bool hasSideEffects;
+		std::vector<Access> reads;
+		std::vector<Access> writes;
+
+		bool isCulled;
+		std::vector<FrameGraphBarrier> barriers;
+	};
+
+	// Refolosesc elementele ramase de la cadrele trecute
+	FrameGraphResource AddResource(std::string_view name, bool isImported);
+	FrameGraphResource AddVersion(uint32_t resource, FrameGraphPass producer, FrameGraphResource previous);
+
+	void CullPasses();
+	void SortPasses();
+	void BuildBarriers(bool useSplitBarriers);
+	void AliasTransients();
+
+	// Utilizarea ceruta de pass pentru o resursa fizica (toate accesele lui, combinate)
+	FrameGraphUsage::Mask GetPassUsage(const Pass& pass, uint32_t resource) const;
+
+	// Doar primele m_*Count elemente apartin cadrului curent
+	std::vector<Resource> m_resources;
+	std::vector<Version> m_versions;
+	std::vector<Pass> m_passes;
+	uint32_t m_resourceCount = 0;
+	uint32_t m_versionCount = 0;
+	uint32_t m_passCount = 0;
+
+	std::vector<FrameGraphPass> m_executionOrder;
+	std::vector<FrameGraphBarrier> m_finalBarriers;
+	FrameGraphMemoryStatistics m_statistics;
+};
+
+}  // namespace engine::gfx
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "ConstantPacking.hpp"
 #include "GPUBuffers.hpp"
 #include "Utilities.hpp"
+#include "engine/core/Settings.hpp"
 
 namespace engine::gfx
 {
@@ -35,15 +37,29 @@ class FrameResources
 	static UINT GetObjectCB_ID() { return objectCB_ID++; }
 	static UINT GetMaterialCB_ID() { return materialCB_ID++; }
 
+	// Root signature-ul Default citeste obiectele si materialele din bufferele bindless (doar la rasterizare)
+	static bool UseBindlessData()
+	{
+		return !engine::core::Settings::UseRayTracing()
+			&& engine::core::Settings::GetGraphicsSettings().UseBindlessData();
+	}
+
 	// Functii de actualizare CB
 	void UpdateObjectRendererCB(const ObjectRenderer& gameComponentRenderer);
 	void UpdatePerObjectCB(const Object& object);
+	void UpdateInstanceData(const ObjectRenderer& objectRenderer);
 	void UpdatePerMaterialCB(const MaterialManager& materialManager);
 
 	void UpdateTerrainCB(const TerrainRenderer& terrain);
 	void UpdateSkyBoxCB(const SkyBoxRenderer& skyBox);
 	void UpdateWaterCB(const WaterRenderer& water);
 
+	// Copiaza in bufferele bindless recordurile scrise in cadrul curent; se apeleaza dupa actualizarile CB
+	void UploadBindlessData();
+
+	// Octetii scrisi in memoria mapata de la ultimul UpdateMainPassCB (primul update al cadrului)
+	inline UINT64 GetWrittenBytes() const { return m_writtenBytes; }
+
 	void UpdateShadowMapPassCB(const ShadowMap& shadowMap);
 	void UpdateDyanmicCubeMapPassCB(const DynamicCubeMap& dynamicCubeMap);
 	void UpdateMainPassCB(
@@ -63,12 +79,47 @@ class FrameResources
 	friend RayTracingGraphics;
 
 	void UpdateCameraAndTransferToGPUPassCB(const BaseCamera& camera, int i = 0);
+	// Impacheteaza recordurile obiectelor date (toate odata) si le scrie in CB-ul de obiect si in datele bindless
+	void WriteObjectRecords(const std::vector<const Object*>& objects);
+
+	// Camera din care s-au calculat matricele unui slot de pass
+	struct PassCamera
+	{
+		engine::math::Matrix4 viewMatrix;
+		engine::math::Matrix4 projectionMatrix;
+		float nearZ = 0.f;
+		float farZ = 0.f;
+		bool isValid = false;
+	};
+
+	static constexpr UINT PassCount = 8;
 
 	ConstantBuffer<MaterialProperties> m_perMaterialCB;
 	ConstantBuffer<ObjectConstantBuffer> m_perObjectCB;
 	ConstantBuffer<PassConstantBuffer> m_perPassCB;
 	ConstantBuffer<WaterConstantBuffer> m_waterCB;
 
+	// Datele bindless, indexate dupa ID-urile de CB; nu sunt limitate de numarul maxim de CB-uri
+	GrowableStructuredBuffer<ObjectConstantBuffer> m_objectData;
+	GrowableStructuredBuffer<MaterialProperties> m_materialData;
+
+	// Transformarile obiectelor desenate instantiat, in ordinea data de InstanceBatcher
+	GrowableStructuredBuffer<InstanceData> m_perInstanceData;
+
+	// Versiunile obiectelor scrise in bufferele acestui frame resource
+	RecordVersionTracker m_objectVersions;
+	// Recordurile sloturilor de pass; partea de camera se recalculeaza doar cand se schimba camera
+	std::array<PassConstantBuffer, PassCount> m_passRecords = {};
+	std::array<PassCamera, PassCount> m_passCameras;
+
+	// Memorie de lucru pentru impachetare, refolosita de la un cadru la altul
+	std::vector<const Object*> m_staleObjects;
+	std::vector<Float4x4> m_transforms;
+	std::vector<Float4x4> m_textureTransforms;
+	std::vector<ObjectRecord> m_objectRecords;
+
+	UINT64 m_writtenBytes = 0;
+
 private:
 	static UINT objectCB_ID;
 	static UINT materialCB_ID;
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "engine/core/Exceptions.hpp"
+#include "BindlessRecordArray.hpp"
+#include "GpuMemoryAllocator.hpp"
+#include "IndirectDrawBuilder.hpp"
+#include "ResidencyPolicy.hpp"
+#include "ResourceStateTracker.hpp"
 #include "Utilities.hpp"
 #include "engine/core/DxgiInfoManager.hpp"
 #include "engine/core/GraphicsThrowMacros.hpp"
@@ -25,14 +30,15 @@ class GpuResource
 		std::wstring resourceName = L"");
 	static void AllocateUploadBuffer(
 		const void* pData, UINT64 datasize, GpuResource& resource, std::wstring resourceName = L"");
-	static void AllocateDefaultBuffer(
+	// Copierea pleaca asincron pe coada de copiere; intoarce UploadTicket-ul ei. Bufferul ramane in COMMON, iar
+	// coada directa il vede copiat in orice lista trimisa dupa urmatorul Flush / SwapContext
+	// - bufferele mici impart un buffer comun; elementSize pastreaza offset-ul multiplu de stride pentru SRV-uri
+	static UINT64 AllocateDefaultBuffer(
 		const void* pData,
 		UINT64 datasize,
 		GpuResource& defaultResource,
-		GpuResource& uploadResource,
-		D3D12_RESOURCE_STATES resourceState = D3D12_RESOURCE_STATE_COMMON,
-		std::wstring defaultResourceName = L"",
-		std::wstring uploadResourceName = L"");
+		UINT64 elementSize = 4,
+		std::wstring defaultResourceName = L"");
 
 	static engine::gfx::DescriptorHandle CreateTextureView(GpuResource& texture, D3D12_SHADER_RESOURCE_VIEW_DESC* descriptor);
 	static engine::gfx::DescriptorHandle CreateTextureView(GpuResource& texture, D3D12_UNORDERED_ACCESS_VIEW_DESC* descriptor);
@@ -44,28 +50,21 @@ class GpuResource
 	static engine::gfx::DescriptorHandle CreateAccelerationStructureSRV(GpuResource& accelerationStructure);
 
 public:
-	GpuResource()
-		: m_GpuVirtualAddress(D3D12_GPU_VIRTUAL_ADDRESS_NULL),
-		  m_UsageState(D3D12_RESOURCE_STATE_COMMON),
-		  m_TransitioningState((D3D12_RESOURCE_STATES)-1)
-	{
-	}
+	GpuResource() : m_GpuVirtualAddress(D3D12_GPU_VIRTUAL_ADDRESS_NULL), m_States(D3D12_RESOURCE_STATE_COMMON) {}
 
 	GpuResource(ID3D12Resource* pResource, D3D12_RESOURCE_STATES CurrentState)
 		: m_GpuVirtualAddress(D3D12_GPU_VIRTUAL_ADDRESS_NULL),
 		  m_pResource(pResource),
-		  m_UsageState(CurrentState),
-		  m_TransitioningState((D3D12_RESOURCE_STATES)-1)
+		  m_States(CurrentState)
 	{
 	}
 
 	~GpuResource() { Destroy(); }
 
-	virtual void Destroy()
-	{
-		m_pResource = nullptr;
-		m_GpuVirtualAddress = D3D12_GPU_VIRTUAL_ADDRESS_NULL;
-	}
+	// Resursele cu alocare din GpuMemoryAllocator trec mereu prin DestroyDeferred
+	virtual void Destroy();
+	// Resursa si memoria ei se elibereaza abia dupa ce GPU-ul termina cadrele in care e folosita
+	void DestroyDeferred();
 
 	ID3D12Resource* operator->() { return m_pResource.Get(); }
 	const ID3D12Resource* operator->() const { return m_pResource.Get(); }
@@ -76,12 +75,43 @@ class GpuResource
 	ID3D12Resource** GetAddressOf() { return m_pResource.GetAddressOf(); }
 
 	D3D12_GPU_VIRTUAL_ADDRESS GetGpuVirtualAddress() const { return m_GpuVirtualAddress; }
+	// Nenul doar pentru bufferele care impart un buffer comun
+	UINT64 GetBufferOffset() const { return m_bufferOffset; }
+
+	// Mip-uri x elemente de array x plane-uri; subresursa i are starea m_States.GetState(i)
+	UINT GetSubresourceCount();
+
+	// Resursa committed poate fi evacuata de ResidencyManager cand nu e folosita; cele plasate raman rezidente cu
+	// heap-ul lor. Se scoate din evidenta la Destroy
+	void TrackResidency(ResidencyPriority::Value priority);
+	// In fiecare cadru in care listele folosesc resursa; nimic pentru resursele neurmarite
+	void MarkUsed();
 
 protected:
+	// Resursa plasata de GpuMemoryAllocator (sau committed); resursa anterioara se elibereaza cu DestroyDeferred
+	void CreateResource(
+		D3D12_HEAP_TYPE heapType,
+		const D3D12_RESOURCE_DESC& desc,
+		D3D12_RESOURCE_STATES initialState,
+		const D3D12_CLEAR_VALUE* pClearValue = nullptr);
+
+	// Starea in care resursa a fost creata, pentru toate subresursele
+	inline void SetInitialState(D3D12_RESOURCE_STATES state)
+	{
+		m_States = SubresourceStates(state);
+		m_subresourceCount = 0;
+	}
+
 	Microsoft::WRL::ComPtr<ID3D12Resource> m_pResource;
-	D3D12_RESOURCE_STATES m_UsageState;
-	D3D12_RESOURCE_STATES m_TransitioningState;
+	// Starea lasata de ultimul command list trimis; listele in inregistrare o vad doar prin trackerul lor
+	SubresourceStates m_States;
+	UINT m_subresourceCount = 0;
 	D3D12_GPU_VIRTUAL_ADDRESS m_GpuVirtualAddress;
+
+	GpuAllocation m_allocation;
+	UINT64 m_bufferOffset = 0;
+
+	ResidencyPolicy::Handle m_residencyHandle = ResidencyPolicy::InvalidHandle;
 };
 
 
@@ -160,6 +190,16 @@ class ConstantBuffer : public GpuUploadBuffer
 		memcpy(m_mappedConstantData + instanceIndex * m_alignedInstanceSize, &data, sizeof(T));
 	}
 
+	// Doar octetii [offset, offset + size) ai recordului, cand restul e deja in buffer
+	void CopyDataRange(UINT instanceIndex, const T& data, size_t offset, size_t size)
+	{
+		assert(offset + size <= sizeof(T));
+		memcpy(
+			m_mappedConstantData + instanceIndex * m_alignedInstanceSize + offset,
+			reinterpret_cast<const uint8_t*>(&data) + offset,
+			size);
+	}
+
 	// Accessors
 	T staging;
 	T* operator->() { return &staging; }
@@ -202,6 +242,13 @@ class StructuredBuffer : public GpuUploadBuffer
 		memcpy(m_mappedBuffers + instanceIndex, &m_staging[0], InstanceSize());
 	}
 
+	// Copiaza doar primele elementCount elemente din staging
+	void CopyStagingToGpu(UINT instanceIndex, UINT elementCount)
+	{
+		assert(elementCount <= m_staging.size());
+		memcpy(m_mappedBuffers + instanceIndex * m_staging.size(), m_staging.data(), elementCount * sizeof(T));
+	}
+
 	// Accessors
 	T& operator[](UINT elementIndex) { return m_staging[elementIndex]; }
 	size_t NumElementsPerInstance() { return m_staging.size(); }
@@ -213,6 +260,140 @@ class StructuredBuffer : public GpuUploadBuffer
 	}
 };
 
+// Structured buffer in upload heap a carui capacitate creste dupa indecsii scrisi (date bindless).
+// Fiecare frame resource are bufferul lui, deci la Upload se poate realoca: GPU-ul a terminat cadrul care il folosea.
+// Adresa GPU se schimba la realocare, deci se citeste dupa Upload, la fiecare cadru.
+template <class T>
+class GrowableStructuredBuffer : public GpuUploadBuffer
+{
+	BindlessRecordArray<T> m_records;
+	T* m_mappedData;
+	UINT m_allocatedCapacity;
+	std::wstring m_name;
+
+public:
+	static_assert(sizeof(T) % 16 == 0, "Align structure buffers on 16 byte boundary for performance reasons.");
+
+	GrowableStructuredBuffer() : m_mappedData(nullptr), m_allocatedCapacity(0) {}
+
+	void Create(ID3D12Device* device, UINT initialCapacity, LPCWSTR resourceName = nullptr)
+	{
+		m_name = resourceName ? resourceName : L"";
+		m_records.Reserve(initialCapacity);
+		Reallocate(device);
+	}
+
+	void CopyData(UINT elementIndex, const T& data) { m_records.Write(elementIndex, data); }
+
+	// Realoca daca s-a depasit capacitatea, apoi copiaza doar recordurile scrise de la ultimul Upload; intoarce
+	// octetii copiati
+	UINT64 Upload(ID3D12Device* device)
+	{
+		if (m_records.GetCapacity() != m_allocatedCapacity)
+		{
+			Reallocate(device);
+			m_records.MarkAllDirty();
+		}
+
+		if (!m_records.IsDirty())
+			return 0;
+
+		const UINT begin = m_records.GetDirtyBegin();
+		const UINT64 size = (m_records.GetDirtyEnd() - begin) * sizeof(T);
+		memcpy(m_mappedData + begin, m_records.GetData() + begin, size);
+		m_records.ClearDirty();
+
+		return size;
+	}
+
+	// Accessors
+	UINT GetCount() const { return m_records.GetCount(); }
+	UINT GetCapacity() const { return m_allocatedCapacity; }
+	D3D12_GPU_VIRTUAL_ADDRESS GpuVirtualAddress() const { return m_resource->GetGPUVirtualAddress(); }
+
+private:
+	void Reallocate(ID3D12Device* device)
+	{
+		// Vechiul buffer se elibereaza la suprascrierea lui m_resource
+		m_allocatedCapacity = m_records.GetCapacity();
+		Allocate(device, m_allocatedCapacity * (UINT)sizeof(T), m_name.c_str());
+		m_mappedData = reinterpret_cast<T*>(MapCpuWriteOnly());
+	}
+};
+
+// Buffer in upload heap cu cate o regiune pentru fiecare frame resource.
+// Datele scrise de CPU pentru frame-ul curent nu suprascriu ce citeste inca GPU-ul din frame-urile anterioare.
+template <class T>
+class UploadRingBuffer : public GpuUploadBuffer
+{
+	uint8_t* m_mappedData;
+	UINT m_elementsPerFrame;
+	UINT m_frameCount;
+
+public:
+	UploadRingBuffer() : m_mappedData(nullptr), m_elementsPerFrame(0), m_frameCount(0) {}
+
+	void Create(ID3D12Device* device, UINT elementsPerFrame, UINT frameCount, LPCWSTR resourceName = nullptr)
+	{
+		m_elementsPerFrame = elementsPerFrame;
+		m_frameCount = frameCount;
+		Allocate(device, GetFrameSizeInBytes() * frameCount, resourceName);
+		m_mappedData = MapCpuWriteOnly();
+	}
+
+	void CopyData(UINT frameIndex, const T* pData, UINT elementCount)
+	{
+		assert(frameIndex < m_frameCount && elementCount <= m_elementsPerFrame);
+		memcpy(m_mappedData + frameIndex * GetFrameSizeInBytes(), pData, elementCount * sizeof(T));
+	}
+
+	// Accessors
+	UINT GetElementsPerFrame() const { return m_elementsPerFrame; }
+	UINT GetFrameSizeInBytes() const { return m_elementsPerFrame * (UINT)sizeof(T); }
+
+	D3D12_GPU_VIRTUAL_ADDRESS GetGpuVirtualAdress(UINT frameIndex) const
+	{
+		return m_resource->GetGPUVirtualAddress() + frameIndex * GetFrameSizeInBytes();
+	}
+};
+
+// Buffer de argumente pentru ExecuteIndirect, cu cate o regiune pentru fiecare frame resource.
+// Fiecare regiune contine si count buffer-ul si argumentele, in layout-ul dat de IndirectDrawBuilder.
+template <class Arguments>
+class IndirectArgumentBuffer : public GpuUploadBuffer
+{
+	uint8_t* m_mappedData;
+	UINT64 m_frameSize;
+	UINT m_frameCount;
+
+public:
+	IndirectArgumentBuffer() : m_mappedData(nullptr), m_frameSize(0), m_frameCount(0) {}
+
+	void Create(
+		ID3D12Device* device,
+		const IndirectDrawBuilder<Arguments>& layout,
+		UINT frameCount,
+		LPCWSTR resourceName = nullptr)
+	{
+		// Offset-urile de argumente trebuie sa ramana aliniate si in regiunile urmatoare
+		m_frameSize = engine::gfx::Align(
+			(UINT)layout.GetBufferSize(), IndirectDrawBuilder<Arguments>::ArgumentAlignment);
+		m_frameCount = frameCount;
+		Allocate(device, (UINT)(m_frameSize * frameCount), resourceName);
+		m_mappedData = MapCpuWriteOnly();
+	}
+
+	void Upload(UINT frameIndex, const IndirectDrawBuilder<Arguments>& builder)
+	{
+		assert(frameIndex < m_frameCount && builder.GetBufferSize() <= m_frameSize);
+		builder.Pack(m_mappedData + frameIndex * m_frameSize);
+	}
+
+	// Accessors
+	ID3D12Resource* GetD3D12Resource() const { return m_resource.Get(); }
+	UINT64 GetFrameOffset(UINT frameIndex) const { return frameIndex * m_frameSize; }
+};
+
 class VertexBuffer : public GpuResource
 {
 public:
@@ -222,12 +403,12 @@ class VertexBuffer : public GpuResource
 
 	void Create(const Mesh& mesh);
 	inline const D3D12_VERTEX_BUFFER_VIEW& GetVertexBufferView() noexcept { return m_vertexBufferView; }
+	inline UINT GetVertexCount() const { return m_vertexCount; }
 
 	void AllocateSRV();
 	inline const engine::gfx::DescriptorHandle& GetSRVHandle() const { return m_SRVHandle; }
 
 private:
-	GpuResource m_uploadResource;
 	D3D12_VERTEX_BUFFER_VIEW m_vertexBufferView;
 	UINT m_vertexBufferSize;
 	UINT m_vertexCount;
@@ -244,12 +425,12 @@ class IndexBuffer : public GpuResource
 
 	void Create(const Mesh& mesh);
 	inline const D3D12_INDEX_BUFFER_VIEW& GetIndexBufferView() noexcept { return m_indexBufferView; }
+	inline UINT GetIndexCount() const { return m_indexCount; }
 
 	void AllocateSRV();
 	inline const engine::gfx::DescriptorHandle& GetSRVHandle() const { return m_SRVHandle; }
 
 private:
-	GpuResource m_uploadResource;
 	D3D12_INDEX_BUFFER_VIEW m_indexBufferView;
 	UINT m_indexBufferSize;
 	UINT m_indexCount;
@@ -37,6 +37,9 @@ class GeometryGenerator
 		const float gridLength,
 		const int chunkKernelSize,
 		const int chunkCountPerSide);
+
+	// Numarul de puncte pe latura grilei generate de GenerateChunks
+	static int GetChunksSidePointCount(const int chunkKernelSize, const int chunkCountPerSide);
 };
 
 }  // namespace engine::gfx
@@ -2,11 +2,15 @@
 
 #include "CameraController.hpp"
 #include "AccelerationStructures.hpp"
+#include "CommandSignature.hpp"
+#include "DrawPacket.hpp"
+#include "DrawRangeMerger.hpp"
 #include "PipelineState.hpp"
 #include "Utilities.hpp"
 #include "GraphicsResources.hpp"
 #include "engine/math/Frustum.hpp"
 #include "Mesh.hpp"
+#include "MultiViewCuller.hpp"
 
 #include <variant>
 
@@ -18,9 +22,25 @@ class GeometryRenderer
 public:
 	virtual void Render(engine::gfx::rasterization::RenderLayer::Value renderLayer) const = 0;
 	virtual void BuildAccelerationStructures() = 0;
-	virtual void FrustumCulling(const CameraController& cameraController) = 0;
+	virtual void FrustumCulling(const MultiViewCuller& culler) = 0;
 	virtual void Update(float deltaTime) = 0;
 
+	// Copiaza argumentele ExecuteIndirect in regiunea frame-ului curent; se apeleaza in fiecare frame, dupa culling
+	virtual void UploadIndirectDraws();
+
+	// Trimite draw-urile unui pass in coada de randare, in loc sa le inregistreze direct ca Render.
+	// Implicit nu trimite nimic: renderer-ele fara implementare se deseneaza in continuare prin Render.
+	virtual void SubmitDraws(
+		RenderQueue<DrawPacket>& queue,
+		engine::gfx::rasterization::RenderLayer::Value renderLayer,
+		const BaseCamera& camera) const;
+
+	// Fata de cube map randata la urmatorul Render(RenderLayer::CubeMap)
+	inline void SetCubeMapFace(UINT face) { m_cubeMapFace = face; }
+
+	// Indexul primului chunk in lista de tinte a PVS-ului
+	inline void SetPVSTargetOffset(uint32_t offset) { m_pvsTargetOffset = offset; }
+
 	const VertexBuffer& GetVertexBuffer() const { return *m_vertexBuffer; }
 	const IndexBuffer& GetIndexBuffer() const { return *m_indexBuffer; }
 
@@ -34,18 +54,21 @@ class GeometryRenderer
 
 		Chunk() = delete;
 		Chunk(const SubMesh& subMesh, const engine::math::AABB& aabb)
-			: m_subMesh(subMesh), m_boundingBox(aabb), m_isVisible(true)
+			: m_subMesh(subMesh), m_boundingBox(aabb), m_visibleViews(CullingView::AllViews)
 		{
 		}
 
 		inline const engine::math::AABB& GetAABB() const { return m_boundingBox; }
 		inline const SubMesh& GetSubMesh() const { return m_subMesh; }
-		inline const bool IsVisible() const { return m_isVisible; }
+		inline const bool IsVisible(CullingView::Value view = CullingView::Main) const
+		{
+			return (m_visibleViews & CullingView::ToMask(view)) != 0;
+		}
 
-		void SetVisible(bool toSet) { m_isVisible = toSet; }
+		void SetVisibleViews(CullingView::Mask toSet) { m_visibleViews = toSet; }
 
 	private:
-		bool m_isVisible;
+		CullingView::Mask m_visibleViews;
 
 		const engine::math::AABB m_boundingBox;
 		const SubMesh m_subMesh;
@@ -59,12 +82,51 @@ class GeometryRenderer
 		engine::gfx::render_descriptors::DX_TEXTURE_DESCRIPTOR>;
 
 protected:
-	GeometryRenderer() = default;
+	GeometryRenderer();
 	virtual ~GeometryRenderer();
 
 	virtual void LoadGeometry(DescriptorVariant descriptor) = 0;
+	// Mesh-ul CPU se elibereaza dupa upload
 	void CreateVertexAndIndexBuffer(bool allocateSRVs = false);
-	void ReleaseUploadBuffers();
+
+	// Numarul de benzi de distanta folosite la ordonarea chunk-urilor
+	static constexpr UINT ChunkDistanceBandCount = 16;
+
+	// Ordinea de desenare a chunk-urilor de la camera spre departe, pe benzi de distanta (counting sort, O(n)).
+	// In interiorul unei benzi ramane ordinea din GenerateChunks (curba Hilbert).
+	static void OrderChunksFrontToBack(
+		const std::vector<Chunk>& chunks,
+		const engine::math::Float3& cameraPosition,
+		float maxDistance,
+		std::vector<UINT>& drawOrder);
+
+	using ViewDrawRanges = std::array<DrawRangeMerger, CullingView::Count>;
+
+	// Intervalele de indecsi ale chunk-urilor vizibile, unite pe fiecare view.
+	// View-ul principal urmeaza drawOrder (unirea se face in interiorul benzilor de distanta),
+	// celelalte urmeaza ordinea din index buffer, deci au numarul minim de draw-uri.
+	static void BuildDrawRanges(
+		const std::vector<Chunk>& chunks, const std::vector<UINT>& drawOrder, ViewDrawRanges& drawRanges);
+
+	// Calea ExecuteIndirect pentru chunk-uri: un draw pentru fiecare interval unit, pe fiecare view
+	void CreateIndirectChunkDraws(UINT maxDrawsPerView);
+	void BuildIndirectChunkDraws(const ViewDrawRanges& drawRanges);
+	void DrawChunksIndirect(GraphicsContext& graphicsContext, CullingView::Value view) const;
+	inline bool UseIndirectChunkDraws() const { return m_drawIndexedSignature != nullptr; }
+
+	// Pachetul de baza al unui pass: PSO-ul, topologia si bufferele renderer-ului
+	DrawPacket MakeDrawPacket(engine::gfx::rasterization::RenderLayer::Value renderLayer) const;
+	// Chunk-urile vizibile intr-un view: un pachet ExecuteIndirect sau cate unul pentru fiecare interval unit.
+	// Toate primesc aceeasi cheie, deci raman in ordinea din drawRanges (sortarea este stabila).
+	void SubmitChunkDraws(
+		RenderQueue<DrawPacket>& queue,
+		uint64_t key,
+		DrawPacket packet,
+		const ViewDrawRanges& drawRanges,
+		CullingView::Value view) const;
+
+	// Datele mesh-ului raman doar in bufferele GPU; numarul de vertecsi / indecsi se citeste din ele
+	void ReleaseCpuGeometry();
 
 protected:
 	Mesh::Ptr m_mesh;
@@ -82,6 +144,19 @@ class GeometryRenderer
 	D3D12_PRIMITIVE_TOPOLOGY m_dynamicCubeMapTopology;
 
 	BottomLevelAccelerationStructure m_bottomLevelAccelerationStructure;
+
+	IndirectDrawBuilder<IndirectDrawIndexedArguments> m_indirectChunkDraws;
+	IndirectArgumentBuffer<IndirectDrawIndexedArguments> m_indirectChunkArguments;
+	CommandSignature::Ptr m_drawIndexedSignature;
+
+	UINT m_cubeMapFace = 0;
+	uint32_t m_pvsTargetOffset = 0;
+
+	// Campul de mesh din cheile de sortare: draw-urile aceluiasi renderer impart vertex si index buffer-ul
+	uint32_t m_meshSortID;
+
+private:
+	static uint32_t nextMeshSortID;
 };
 
 }  // namespace engine::gfx
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "MemoryPool.hpp"
+
+#include <d3d12.h>
+#include <wrl/client.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace engine::gfx
+{
+
+namespace GpuMemoryPool
+{
+enum Value : uint8_t
+{
+	// Resurse plasate in heap-uri D3D12
+	DefaultBuffers,
+	DefaultTextures,
+	UploadBuffers,
+	// Intervale din buffere mari din default heap, impartite de bufferele mici
+	PackedBuffers,
+	Count
+};
+}
+
+// Alocarea din care provine o resursa; invalida pentru resursele committed
+struct GpuAllocation
+{
+	GpuMemoryPool::Value pool = GpuMemoryPool::Count;
+	MemoryAllocation range;
+
+	inline bool IsValid() const { return pool != GpuMemoryPool::Count; }
+};
+
+////////////////////////////////////////////////
+// Memoria resurselor GPU, sub-alocata din heap-uri mari in loc de cate un heap implicit pe resursa (committed)
+// - cate un pool de heap-uri pe tip de heap si categorie de resursa (heap tier 1 nu amesteca bufferele cu
+//   texturile); heap-urile se creeaza la nevoie si se elibereaza cand se golesc
+// - bufferele mici impart buffere mari din default heap, la offset-uri diferite
+// - render target-urile, depth buffer-ele, resursele MSAA si cele mai mari decat jumatate de heap raman committed
+// - defragmentarea e doar un hook: PlanDefragmentation rezerva destinatiile, iar proprietarul resurselor le
+//   recreeaza, copiaza datele si elibereaza sursele
+///////////////////////////////////////////////
+class GpuMemoryAllocator
+{
+public:
+	using Ptr = std::unique_ptr<GpuMemoryAllocator>;
+
+	// Bufferele pana la marimea asta se impart; peste ea un buffer plasat nu mai risipeste mult din cei 64 KB
+	static constexpr UINT64 PackedBufferMaxSize = 64 * 1024;
+
+	void Create();
+
+	GpuAllocation CreateResource(
+		D3D12_HEAP_TYPE heapType,
+		const D3D12_RESOURCE_DESC& desc,
+		D3D12_RESOURCE_STATES initialState,
+		const D3D12_CLEAR_VALUE* pClearValue,
+		ID3D12Resource** ppResource);
+	// *ppResource primeste bufferul comun; datele incep la bufferOffset, multiplu de alignment (oricare, ex. stride)
+	GpuAllocation AllocateBufferRange(
+		UINT64 size, UINT64 alignment, ID3D12Resource** ppResource, UINT64& bufferOffset);
+	// Memoria se poate refolosi imediat: apelantul garanteaza ca GPU-ul nu mai foloseste resursa
+	void Free(const GpuAllocation& allocation);
+
+	std::vector<MemoryMove> PlanDefragmentation(GpuMemoryPool::Value pool, size_t maxMoves);
+	ID3D12Heap* GetHeap(GpuMemoryPool::Value pool, uint32_t block) const;
+
+	// Memoria rezervata in heap-uri si cea ocupata de alocari, pentru toate pool-urile
+	UINT64 GetReservedSize() const;
+	UINT64 GetUsedSize() const;
+	inline const MemoryPool& GetPool(GpuMemoryPool::Value pool) const { return m_pools[pool].memory; }
+
+private:
+	struct Pool
+	{
+		MemoryPool memory;
+		D3D12_HEAP_TYPE heapType;
+		D3D12_HEAP_FLAGS heapFlags;
+		// Pe blocurile MemoryPool-ului; pentru PackedBuffers bufferul comun si alocarea lui in DefaultBuffers
+		std::vector<Microsoft::WRL::ComPtr<ID3D12Heap>> heaps;
+		std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> buffers;
+		std::vector<GpuAllocation> bufferAllocations;
+	};
+
+	// Pool-ul in care se plaseaza resursa; Count daca ramane committed
+	static GpuMemoryPool::Value SelectPool(D3D12_HEAP_TYPE heapType, const D3D12_RESOURCE_DESC& desc);
+
+	MemoryAllocation AllocateRange(GpuMemoryPool::Value pool, UINT64 size, UINT64 alignment);
+	void AddBlock(GpuMemoryPool::Value pool);
+	void RemoveBlock(GpuMemoryPool::Value pool, uint32_t block);
+
+	std::array<Pool, GpuMemoryPool::Count> m_pools;
+};
+
+}  // namespace engine::gfx
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "GraphicsStateCache.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+namespace engine::gfx
+{
+
+////////////////////////////////////////////////
+// Apelurile de stare ale unui command list grafic, trimise doar cand schimba ceva (vezi GraphicsStateCache)
+// - CommandList e ID3D12GraphicsCommandList7 in CommandContext; orice tip cu aceleasi metode merge, testele folosesc
+//   un command list fals care inregistreaza apelurile
+// - view-urile si handle-urile sunt parametri template: se citesc doar campurile cu numele din D3D12
+// - apelurile care schimba starea pe langa cache (heap-uri, ExecuteIndirect, bundle-uri) o invalideaza aici
+///////////////////////////////////////////////
+template <typename CommandList>
+class GraphicsCommandFilter
+{
+public:
+	void SetCommandList(CommandList* pCommandList) { m_pCommandList = pCommandList; }
+
+	// Command list resetat: starea e necunoscuta si statisticile pornesc de la 0
+	void Reset() { m_stateCache.Reset(); }
+
+	template <typename PipelineState>
+	void SetPipelineState(PipelineState* pPipelineState)
+	{
+		if (!m_stateCache.SetPipelineState(pPipelineState))
+			return;
+
+		m_pCommandList->SetPipelineState(pPipelineState);
+	}
+
+	template <typename StateObject>
+	void SetPipelineState1(StateObject* pStateObject)
+	{
+		// State object-ul inlocuieste PSO-ul curent
+		m_stateCache.SetPipelineState(nullptr);
+		m_pCommandList->SetPipelineState1(pStateObject);
+	}
+
+	template <typename RootSignature>
+	void SetGraphicsRootSignature(RootSignature* pRootSignature)
+	{
+		if (!m_stateCache.SetRootSignature(pRootSignature))
+			return;
+
+		m_pCommandList->SetGraphicsRootSignature(pRootSignature);
+	}
+
+	template <typename Topology>
+	void IASetPrimitiveTopology(Topology topology)
+	{
+		if (!m_stateCache.SetPrimitiveTopology(static_cast<uint32_t>(topology)))
+			return;
+
+		m_pCommandList->IASetPrimitiveTopology(topology);
+	}
+
+	template <typename VertexBufferView>
+	void IASetVertexBuffers(uint32_t startSlot, uint32_t count, const VertexBufferView* pViews)
+	{
+		// Se trimite tot intervalul daca cel putin un slot s-a schimbat
+		assert(count <= GraphicsStateCache::MaxVertexBufferSlots);
+
+		std::array<GraphicsStateCache::VertexBufferState, GraphicsStateCache::MaxVertexBufferSlots> states;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			states[i] = {pViews[i].BufferLocation, pViews[i].SizeInBytes, pViews[i].StrideInBytes};
+		}
+
+		if (!m_stateCache.SetVertexBuffers(startSlot, count, states.data()))
+			return;
+
+		m_pCommandList->IASetVertexBuffers(startSlot, count, pViews);
+	}
+
+	template <typename IndexBufferView>
+	void IASetIndexBuffer(const IndexBufferView* pView)
+	{
+		const uint32_t format = static_cast<uint32_t>(pView->Format);
+		if (!m_stateCache.SetIndexBuffer(pView->BufferLocation, pView->SizeInBytes, format))
+			return;
+
+		m_pCommandList->IASetIndexBuffer(pView);
+	}
+
+	void SetGraphicsRootConstantBufferView(uint32_t rootIndex, uint64_t location)
+	{
+		if (!m_stateCache.SetRootArgument(rootIndex, location))
+			return;
+
+		m_pCommandList->SetGraphicsRootConstantBufferView(rootIndex, location);
+	}
+
+	void SetGraphicsRootShaderResourceView(uint32_t rootIndex, uint64_t location)
+	{
+		if (!m_stateCache.SetRootArgument(rootIndex, location))
+			return;
+
+		m_pCommandList->SetGraphicsRootShaderResourceView(rootIndex, location);
+	}
+
+	template <typename DescriptorHandle>
+	void SetGraphicsRootDescriptorTable(uint32_t rootIndex, DescriptorHandle firstHandle)
+	{
+		if (!m_stateCache.SetRootArgument(rootIndex, firstHandle.ptr))
+			return;
+
+		m_pCommandList->SetGraphicsRootDescriptorTable(rootIndex, firstHandle);
+	}
+
+	void SetGraphicsRoot32BitConstant(uint32_t rootIndex, uint32_t value, uint32_t destOffset)
+	{
+		if (!m_stateCache.SetRootConstants(rootIndex, destOffset, 1, &value))
+			return;
+
+		m_pCommandList->SetGraphicsRoot32BitConstant(rootIndex, value, destOffset);
+	}
+
+	void SetGraphicsRoot32BitConstants(uint32_t rootIndex, uint32_t count, const uint32_t* pValues, uint32_t destOffset)
+	{
+		if (!m_stateCache.SetRootConstants(rootIndex, destOffset, count, pValues))
+			return;
+
+		m_pCommandList->SetGraphicsRoot32BitConstants(rootIndex, count, pValues, destOffset);
+	}
+
+	template <typename DescriptorHeap>
+	void SetDescriptorHeaps(uint32_t count, DescriptorHeap* const* ppHeaps)
+	{
+		m_pCommandList->SetDescriptorHeaps(count, ppHeaps);
+
+		// Tabelele de descriptori setate pe heap-urile anterioare nu mai sunt valide
+		m_stateCache.InvalidateRootArguments();
+	}
+
+	// rootArgumentMask: root argumentele scrise de command signature (CommandSignature::GetRootArgumentMask)
+	template <typename CommandSignature, typename Resource>
+	void ExecuteIndirect(
+		CommandSignature* pCommandSignature,
+		uint64_t rootArgumentMask,
+		uint32_t maxCommandCount,
+		Resource* pArgumentBuffer,
+		uint64_t argumentBufferOffset,
+		Resource* pCountBuffer,
+		uint64_t countBufferOffset)
+	{
+		m_pCommandList->ExecuteIndirect(
+			pCommandSignature, maxCommandCount, pArgumentBuffer, argumentBufferOffset, pCountBuffer, countBufferOffset);
+
+		m_stateCache.InvalidateRootArguments(rootArgumentMask);
+	}
+
+	template <typename Bundle>
+	void ExecuteBundle(Bundle* pBundle)
+	{
+		m_pCommandList->ExecuteBundle(pBundle);
+
+		// Starea setata in bundle ramane pe command list-ul apelant
+		m_stateCache.Invalidate();
+	}
+
+	// Apelurile redundante filtrate de la ultimul Reset
+	inline const StateFilterStatistics& GetStatistics() const { return m_stateCache.GetStatistics(); }
+
+private:
+	CommandList* m_pCommandList = nullptr;
+	GraphicsStateCache m_stateCache;
+};
+
+}  // namespace engine::gfx
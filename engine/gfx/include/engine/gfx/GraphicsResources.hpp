@@ -5,8 +5,10 @@
 #include <wrl/client.h>
 
 #include "Context.hpp"
+#include "DeferredReleaseQueue.hpp"
 #include "FrameResources.hpp"
 #include "engine/core/DxgiInfoManager.hpp"
+#include "ResidencyManager.hpp"
 #include "Texture.hpp"
 
 namespace engine::gfx
@@ -42,12 +44,31 @@ class GraphicsResources
 
 	static inline ID3D12CommandQueue* GetCommandQueue() { return GetInstance().pContextManager->GetCommandQueue(); }
 	static inline ContextManager& GetContextManager() { return *GetInstance().pContextManager; }
+	static inline UploadManager& GetUploadManager() { return GetInstance().pContextManager->GetUploadManager(); }
 	static inline ID3D12Device10* GetDevice() { return GetInstance().pDevice.Get(); }
-
-	static engine::gfx::DescriptorHandle AllocateDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE heapType);
+	static inline GpuMemoryAllocator& GetMemoryAllocator() { return *GetInstance().pMemoryAllocator; }
+	static inline ResidencyManager& GetResidencyManager() { return *GetInstance().pResidencyManager; }
+
+	// Descriptori persistenti; se elibereaza doar dupa ce GPU-ul nu-i mai foloseste
+	static engine::gfx::DescriptorHandle AllocateDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE heapType, UINT count = 1);
+	static void FreeDescriptor(
+		D3D12_DESCRIPTOR_HEAP_TYPE heapType, const engine::gfx::DescriptorHandle& handle, UINT count = 1);
+	// Tabel CBV / SRV / UAV pentru cadrul curent, copiat din pSources la EndFrame (nu in listele trimise cu Flush)
+	static engine::gfx::DescriptorHandle StageDescriptorTable(const D3D12_CPU_DESCRIPTOR_HANDLE* pSources, UINT count);
 	inline const engine::gfx::DescriptorHeap& GetDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE heapType);
 	inline UINT GetDescriptorIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE heapType);
 
+	// Resursa si memoria ei se elibereaza dupa ce GPU-ul termina listele trimise sau inregistrate pana acum, fara
+	// Flush (imediat cand device-ul e distrus); size e doar pentru contabilizare
+	static void DeferRelease(
+		Microsoft::WRL::ComPtr<ID3D12Resource> pResource, const GpuAllocation& allocation, UINT64 size);
+	// Datele CPU ale unui mesh copiat deja in buffere GPU, eliberate dupa terminarea uploadului
+	static void DeferRelease(Mesh::Ptr mesh);
+	static inline const DeferredReleaseStatistics& GetDeferredReleaseStatistics()
+	{
+		return GetInstance().m_deferredReleases.GetStatistics();
+	}
+
 	void SetSizeChnaged(bool toSet) { m_sizeChanged = toSet; }
 	bool GetSizeChnaged() const { return m_sizeChanged; }
 
@@ -58,12 +79,24 @@ class GraphicsResources
 
 	GraphicsResources() = default;
 
+	struct DeferredRelease
+	{
+		Microsoft::WRL::ComPtr<ID3D12Resource> pResource;
+		GpuAllocation allocation;
+		Mesh::Ptr mesh;
+	};
+
+	// Nu foloseste GetInstance: se apeleaza si din destructor
+	void ReleaseDeferred(DeferredRelease& deferredRelease);
+
 private:
 	ContextManager::Ptr pContextManager;
 
 	HWND m_hWnd;
 
 	bool m_sizeChanged = false;
+	// Setat in destructor, dupa ce GPU-ul s-a oprit: DeferRelease elibereaza imediat
+	bool m_isTearingDown = false;
 
 	D3D_FEATURE_LEVEL m_minimalFeatureLevel;
 	D3D_FEATURE_LEVEL m_featureLevel;
@@ -78,6 +111,9 @@ class GraphicsResources
 	Microsoft::WRL::ComPtr<IDXGISwapChain4> pSwapChain;
 	Microsoft::WRL::ComPtr<IDXGIFactory4> pFactory;
 	Microsoft::WRL::ComPtr<ID3D12Device10> pDevice;
+	// Inaintea texturilor de mai jos, ca sa fie distrus dupa ele
+	GpuMemoryAllocator::Ptr pMemoryAllocator;
+	ResidencyManager::Ptr pResidencyManager;
 
 	// Obiecte Swap-Chain, MSAA, RT
 	std::array<ColorTexture::Ptr, engine::core::Settings::GetBackBufferCount()> m_renderTargetTextures;
@@ -86,6 +122,9 @@ class GraphicsResources
 
 	std::array<engine::gfx::DescriptorHeap, D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES> m_descriptorHeaps;
 
+	// Legate la EndFrame de fence-ul cadrului (ContextManager::GetSubmittedFenceValue)
+	DeferredReleaseQueue<DeferredRelease> m_deferredReleases;
+
 	UINT m_backBufferIndex;
 
 	static Ptr instance;
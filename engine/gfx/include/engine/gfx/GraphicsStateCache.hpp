@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace engine::gfx
+{
+
+// Apelurile redundante eliminate de la ultimul Reset, pe tipuri de stare
+struct StateFilterStatistics
+{
+	uint32_t pipelineStates = 0;
+	uint32_t rootSignatures = 0;
+	uint32_t primitiveTopologies = 0;
+	uint32_t vertexBuffers = 0;
+	uint32_t indexBuffers = 0;
+	uint32_t rootArguments = 0;
+
+	inline uint32_t GetTotal() const
+	{
+		return pipelineStates + rootSignatures + primitiveTopologies + vertexBuffers + indexBuffers + rootArguments;
+	}
+
+	StateFilterStatistics& operator+=(const StateFilterStatistics& other)
+	{
+		pipelineStates += other.pipelineStates;
+		rootSignatures += other.rootSignatures;
+		primitiveTopologies += other.primitiveTopologies;
+		vertexBuffers += other.vertexBuffers;
+		indexBuffers += other.indexBuffers;
+		rootArguments += other.rootArguments;
+
+		return *this;
+	}
+};
+
+////////////////////////////////////////////////
+// Starea curenta a unui command list grafic, folosita de CommandContext pentru a nu retrimite aceeasi stare
+// - fiecare Set* intoarce true daca apelul trebuie trimis si retine noua valoare; false inseamna apel redundant
+// - starea necunoscuta (dupa Reset, schimbarea root signature-ului, ExecuteIndirect) nu se filtreaza niciodata
+// - root argumentele (CBV, SRV, tabele de descriptori) se retin ca o valoare pe 64 de biti pe index; tipul
+//   parametrului e fixat de root signature, deci valorile nu se amesteca
+// - constantele root se retin pe dword, fiecare cu bitul lui de validitate (primele MaxCachedRootConstants din
+//   fiecare index); un dword nescris ramane necunoscut, iar cele de dupa nu se filtreaza
+// - obiectele se compara dupa adresa, view-urile dupa campuri
+///////////////////////////////////////////////
+class GraphicsStateCache
+{
+public:
+	static constexpr uint32_t MaxRootParameters = 64;
+	static constexpr uint32_t MaxVertexBufferSlots = 32;
+	static constexpr uint32_t MaxCachedRootConstants = 2;
+
+	struct VertexBufferState
+	{
+		uint64_t location;
+		uint32_t sizeInBytes;
+		uint32_t strideInBytes;
+	};
+
+	// Command list nou: toata starea e necunoscuta si statisticile pornesc de la 0
+	void Reset();
+	// Toata starea devine necunoscuta (ex. dupa ExecuteBundle); statisticile raman
+	void Invalidate();
+
+	bool SetPipelineState(const void* pipelineState);
+	bool SetRootSignature(const void* rootSignature);
+	bool SetPrimitiveTopology(uint32_t topology);
+	// Intervalul se filtreaza ca un singur apel: false doar daca niciun slot nu s-a schimbat
+	bool SetVertexBuffers(uint32_t startSlot, uint32_t count, const VertexBufferState* states);
+	bool SetIndexBuffer(uint64_t location, uint32_t sizeInBytes, uint32_t format);
+	bool SetRootArgument(uint32_t rootIndex, uint64_t value);
+	// Dword-urile destOffset .. destOffset + count - 1 ale unui parametru de constante; false doar daca toate sunt
+	// deja cunoscute si egale
+	bool SetRootConstants(uint32_t rootIndex, uint32_t destOffset, uint32_t count, const uint32_t* values);
+
+	// Root argumentele si constantele din mask (bitul i = indexul i) devin necunoscute
+	void InvalidateRootArguments(uint64_t mask = ~0ull);
+
+	inline const StateFilterStatistics& GetStatistics() const { return m_statistics; }
+
+private:
+	const void* m_pipelineState = nullptr;
+	const void* m_rootSignature = nullptr;
+
+	bool m_isTopologyValid = false;
+	uint32_t m_topology = 0;
+
+	uint32_t m_vertexBufferValidMask = 0;
+	std::array<VertexBufferState, MaxVertexBufferSlots> m_vertexBuffers = {};
+
+	bool m_isIndexBufferValid = false;
+	uint64_t m_indexBufferLocation = 0;
+	uint32_t m_indexBufferSize = 0;
+	uint32_t m_indexBufferFormat = 0;
+
+	uint64_t m_rootArgumentValidMask = 0;
+	std::array<uint64_t, MaxRootParameters> m_rootArguments = {};
+
+	// Masca dword-ului i din fiecare index (bitul j = indexul j)
+	std::array<uint64_t, MaxCachedRootConstants> m_rootConstantValidMasks = {};
+	std::array<std::array<uint32_t, MaxCachedRootConstants>, MaxRootParameters> m_rootConstants = {};
+
+	StateFilterStatistics m_statistics;
+};
+
+}  // namespace engine::gfx
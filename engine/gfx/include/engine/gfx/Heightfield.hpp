@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace engine::gfx
+{
+
+////////////////////////////////////////////////
+// Inaltimile grilei din GenerateChunks, fara restul atributelor vertecsilor
+// - sidePointCount x sidePointCount puncte, X pe randuri si Z pe coloane, cu pas constant pe fiecare axa
+// - il folosesc ocluderul terenului si bake-ul PVS-ului; nu depinde de D3D12 / DirectXMath
+///////////////////////////////////////////////
+struct Heightfield
+{
+	std::vector<float> heights;
+	int sidePointCount = 0;
+
+	float minX = 0.f;
+	float minZ = 0.f;
+	float stepX = 0.f;
+	float stepZ = 0.f;
+
+	inline float GetHeight(int row, int column) const { return heights[(size_t)row * sidePointCount + column]; }
+	inline float GetX(int row) const { return minX + row * stepX; }
+	inline float GetZ(int column) const { return minZ + column * stepZ; }
+
+	// Din vertecsii grilei, in ordinea din GenerateChunks
+	template <typename Vertex>
+	static Heightfield FromGridVertices(const std::vector<Vertex>& vertices, int sidePointCount)
+	{
+		Heightfield heightfield;
+		heightfield.sidePointCount = sidePointCount;
+		heightfield.heights.reserve(vertices.size());
+
+		for (const Vertex& vertex : vertices)
+		{
+			heightfield.heights.push_back(vertex.position.y);
+		}
+
+		if (sidePointCount >= 2 && vertices.size() >= (size_t)sidePointCount * sidePointCount)
+		{
+			heightfield.minX = vertices[0].position.x;
+			heightfield.minZ = vertices[0].position.z;
+			heightfield.stepX = vertices[sidePointCount].position.x - heightfield.minX;
+			heightfield.stepZ = vertices[1].position.z - heightfield.minZ;
+		}
+
+		return heightfield;
+	}
+};
+
+}  // namespace engine::gfx
@@ -154,6 +154,28 @@ struct ObjectConstantBuffer
 	XMFLOAT4X4 textureTransform;
 };
 
+// Datele unei instante din bufferul structurat folosit la desenarea instantiata
+struct InstanceData
+{
+	XMFLOAT4X4 worldMatrix;
+	XMFLOAT4X4 invWorldMatrix;
+	UINT materialIndex;
+	XMFLOAT3 padding;
+};
+
+// Root constant: pozitia primei instante a grupului curent in bufferul de instante
+struct InstanceConstants
+{
+	UINT instanceOffset;
+};
+
+// Root constants pentru datele bindless: indexul recordului de obiect si de material al draw-ului
+struct DrawConstants
+{
+	UINT objectIndex;
+	UINT materialIndex;
+};
+
 struct WaterConstantBuffer
 {
 	XMFLOAT3 cubeMapCenter;
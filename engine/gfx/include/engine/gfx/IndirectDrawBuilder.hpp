@@ -0,0 +1,121 @@
+#pragma once
+
+#include "DrawRangeMerger.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace engine::gfx
+{
+
+// Oglinda portabila a D3D12_DRAW_INDEXED_ARGUMENTS (verificata in CommandSignature.cpp)
+struct IndirectDrawIndexedArguments
+{
+	uint32_t indexCountPerInstance;
+	uint32_t instanceCount;
+	uint32_t startIndexLocation;
+	int32_t baseVertexLocation;
+	uint32_t startInstanceLocation;
+};
+
+// Draw de obiect: adresa CB-ului de obiect (root CBV) sau, cu date bindless, indecsii de obiect si material
+// (root constants), urmate de draw
+struct IndirectObjectDrawArguments
+{
+	union
+	{
+		uint64_t objectCBAddress;
+		uint32_t drawConstants[2];
+	};
+	IndirectDrawIndexedArguments draw;
+	uint32_t padding;
+};
+
+static_assert(sizeof(IndirectDrawIndexedArguments) == 20, "Layout diferit de D3D12_DRAW_INDEXED_ARGUMENTS");
+static_assert(sizeof(IndirectObjectDrawArguments) == 32, "Stride-ul argumentelor de obiect trebuie sa fie fix");
+
+inline IndirectDrawIndexedArguments MakeIndirectDrawArguments(const DrawRange& range)
+{
+	return {range.indexCount, 1, range.startIndexLocation, range.baseVertexLocation, 0};
+}
+
+inline IndirectDrawIndexedArguments MakeIndirectDrawArguments(const SubMesh& subMesh)
+{
+	return {(uint32_t)subMesh.indexCount, 1, (uint32_t)subMesh.startIndexLocation, (int32_t)subMesh.baseVertexLocation, 0};
+}
+
+////////////////////////////////////////////////
+// Listele de argumente pentru ExecuteIndirect, cate una pe view (render layer)
+// - layout-ul bufferului: numarul de draw-uri pentru fiecare view (uint32), apoi, aliniat la ArgumentAlignment,
+//   cate maxDrawsPerView argumente pentru fiecare view
+// - numarul de draw-uri ajunge in count buffer, deci zona nefolosita dintr-un view nu trebuie curatata
+// - partea de submit e in CommandSignature / IndirectArgumentBuffer
+///////////////////////////////////////////////
+template <class Arguments>
+class IndirectDrawBuilder
+{
+public:
+	static constexpr uint32_t ArgumentStride = (uint32_t)sizeof(Arguments);
+	static constexpr uint32_t ArgumentAlignment = 16;
+
+	IndirectDrawBuilder() : m_viewCount(0), m_maxDrawsPerView(0) {}
+
+	void Create(uint32_t viewCount, uint32_t maxDrawsPerView)
+	{
+		m_viewCount = viewCount;
+		m_maxDrawsPerView = maxDrawsPerView;
+
+		m_counts.assign(viewCount, 0);
+		m_draws.resize((size_t)viewCount * maxDrawsPerView);
+	}
+
+	inline void Reset() { std::fill(m_counts.begin(), m_counts.end(), 0); }
+
+	// Draw-urile peste capacitatea view-ului se ignora (capacitatea se alege din numarul de chunk-uri / obiecte)
+	inline void Add(uint32_t view, const Arguments& arguments)
+	{
+		assert(view < m_viewCount && m_counts[view] < m_maxDrawsPerView);
+
+		if (m_counts[view] < m_maxDrawsPerView)
+			m_draws[(size_t)view * m_maxDrawsPerView + m_counts[view]++] = arguments;
+	}
+
+	inline uint32_t GetDrawCount(uint32_t view) const { return m_counts[view]; }
+	inline const Arguments* GetDraws(uint32_t view) const { return &m_draws[(size_t)view * m_maxDrawsPerView]; }
+
+	inline uint32_t GetViewCount() const { return m_viewCount; }
+	inline uint32_t GetMaxDrawsPerView() const { return m_maxDrawsPerView; }
+
+	inline uint64_t GetCountOffset(uint32_t view) const { return (uint64_t)view * sizeof(uint32_t); }
+	inline uint64_t GetArgumentOffset(uint32_t view) const
+	{
+		const uint64_t countsSize = (uint64_t)m_viewCount * sizeof(uint32_t);
+		const uint64_t argumentsStart = (countsSize + ArgumentAlignment - 1) / ArgumentAlignment * ArgumentAlignment;
+
+		return argumentsStart + (uint64_t)view * m_maxDrawsPerView * ArgumentStride;
+	}
+	inline uint64_t GetBufferSize() const { return GetArgumentOffset(m_viewCount); }
+
+	// Scrie layout-ul complet la destination (memoria mapata a frame-ului curent)
+	void Pack(uint8_t* destination) const
+	{
+		memcpy(destination, m_counts.data(), m_counts.size() * sizeof(uint32_t));
+
+		for (uint32_t view = 0; view < m_viewCount; view++)
+		{
+			memcpy(destination + GetArgumentOffset(view), GetDraws(view), (size_t)m_counts[view] * ArgumentStride);
+		}
+	}
+
+private:
+	uint32_t m_viewCount;
+	uint32_t m_maxDrawsPerView;
+
+	std::vector<uint32_t> m_counts;
+	std::vector<Arguments> m_draws;
+};
+
+}  // namespace engine::gfx
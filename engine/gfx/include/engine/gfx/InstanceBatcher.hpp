@@ -0,0 +1,55 @@
+#pragma once
+
+#include "DrawRangeMerger.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::gfx
+{
+
+// Obiecte cu acelasi mesh si acelasi material, desenate cu un singur DrawIndexedInstanced
+struct InstanceGroup
+{
+	DrawRange mesh;
+	uint32_t materialID;
+
+	// Prima instanta a grupului in bufferul de instante (peste toate view-urile) si numarul de instante
+	uint32_t firstInstance;
+	uint32_t instanceCount;
+};
+
+////////////////////////////////////////////////
+// Gruparea obiectelor vizibile pentru desenarea instantiata
+// - pentru fiecare view, obiectele se sorteaza dupa (mesh, material) si fiecare secventa devine un grup
+// - instantele tuturor view-urilor stau la rand in bufferul de instante; un obiect vizibil in mai multe view-uri
+//   apare o data pentru fiecare view
+// - GetInstanceObjects da obiectul fiecarei instante, in ordinea din buffer, pentru scrierea datelor de instanta
+///////////////////////////////////////////////
+class InstanceBatcher
+{
+public:
+	void Create(uint32_t viewCount);
+	void Reset();
+
+	void Add(uint32_t view, const SubMesh& subMesh, uint32_t materialID, uint32_t objectIndex);
+	void Build();
+
+	inline const std::vector<InstanceGroup>& GetGroups(uint32_t view) const { return m_groups[view]; }
+	inline const std::vector<uint32_t>& GetInstanceObjects() const { return m_instanceObjects; }
+	inline uint32_t GetInstanceCount() const { return (uint32_t)m_instanceObjects.size(); }
+
+private:
+	struct Entry
+	{
+		DrawRange mesh;
+		uint32_t materialID;
+		uint32_t objectIndex;
+	};
+
+	std::vector<std::vector<Entry>> m_entries;
+	std::vector<std::vector<InstanceGroup>> m_groups;
+	std::vector<uint32_t> m_instanceObjects;
+};
+
+}  // namespace engine::gfx
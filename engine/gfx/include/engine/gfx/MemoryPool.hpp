@@ -0,0 +1,68 @@
+#pragma once
+
+#include "BuddyAllocator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace engine::gfx
+{
+
+struct MemoryAllocation
+{
+	static constexpr uint32_t InvalidBlock = UINT32_MAX;
+
+	uint32_t block = InvalidBlock;
+	uint64_t offset = 0;
+	uint64_t size = 0;
+
+	inline bool IsValid() const { return block != InvalidBlock; }
+};
+
+// Mutare propusa de PlanDefragmentation: destinatia e deja rezervata, sursa se elibereaza dupa copiere
+struct MemoryMove
+{
+	MemoryAllocation source;
+	MemoryAllocation destination;
+};
+
+////////////////////////////////////////////////
+// Blocuri de memorie de aceeasi marime (ex. heap-uri D3D), fiecare impartit cu un BuddyAllocator
+// - Allocate cauta primul bloc in care incape alocarea; daca nu incape nicaieri apelantul creeaza resursa
+//   blocului, il adauga cu AddBlock si reincearca
+// - indicii blocurilor raman stabili; un bloc golit se poate scoate cu RemoveBlock, iar slotul lui se refoloseste
+///////////////////////////////////////////////
+class MemoryPool
+{
+public:
+	void Create(uint64_t blockSize, uint64_t minAllocationSize);
+
+	bool Allocate(uint64_t size, uint64_t alignment, MemoryAllocation& allocation);
+	uint32_t AddBlock();
+	// Intoarce true daca blocul alocarii a ramas gol
+	bool Free(const MemoryAllocation& allocation);
+	void RemoveBlock(uint32_t block);
+
+	// Propune mutarea alocarilor din blocul cel mai putin folosit in celelalte blocuri, ca el sa poata fi scos;
+	// apelantul copiaza datele, muta resursele si elibereaza sursele
+	std::vector<MemoryMove> PlanDefragmentation(size_t maxMoves);
+
+	inline uint64_t GetBlockSize() const { return m_blockSize; }
+	inline bool IsBlockUsed(uint32_t block) const { return block < m_blocks.size() && m_blocks[block]; }
+	inline size_t GetBlockSlotCount() const { return m_blocks.size(); }
+	size_t GetBlockCount() const;
+	uint64_t GetUsedSize() const;
+	// 1 - cel mai mare bloc liber / memoria libera, pe blocul cel mai fragmentat
+	float GetFragmentation() const;
+
+private:
+	uint64_t m_blockSize = 0;
+	uint64_t m_minAllocationSize = 0;
+
+	// Slot gol: bloc scos
+	std::vector<std::unique_ptr<BuddyAllocator>> m_blocks;
+};
+
+}  // namespace engine::gfx
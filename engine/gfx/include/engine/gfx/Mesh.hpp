@@ -1,5 +1,7 @@
 #pragma once
 
+#include "SubMesh.hpp"
+
 #include "engine/math/AxisAllignedBBox.hpp"
 #include "engine/core/CustomException.hpp"
 
@@ -97,11 +99,4 @@ class Mesh
 	std::vector<Index> m_indices;
 };
 
-struct SubMesh
-{
-	size_t indexCount;
-	size_t startIndexLocation;
-	size_t baseVertexLocation;
-};
-
 }  // namespace engine::gfx
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "OcclusionCuller.hpp"
+#include "RenderLayer.hpp"
+#include "TerrainPVS.hpp"
+#include "engine/math/FloatTypes.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace engine::gfx
+{
+
+namespace CullingView
+{
+enum Value : uint32_t
+{
+	Main = 0,
+	Shadow = 1,
+	CubeMapFace0 = 2,
+	Count = CubeMapFace0 + 6
+};
+
+// Un bit pentru fiecare view in care este vizibil un chunk / obiect
+using Mask = uint8_t;
+
+static_assert(Count <= sizeof(Mask) * 8, "Masca de vizibilitate prea mica");
+
+static constexpr Mask AllViews = (Mask)((1u << Count) - 1);
+
+inline constexpr Mask ToMask(Value view)
+{
+	return (Mask)(1u << view);
+}
+
+// View-ul in care se deseneaza un render layer; pentru cube map conteaza si fata curenta
+inline Value FromRenderLayer(engine::gfx::rasterization::RenderLayer::Value renderLayer, uint32_t cubeMapFace)
+{
+	switch (renderLayer)
+	{
+	case engine::gfx::rasterization::RenderLayer::CubeMap: return (Value)(CubeMapFace0 + cubeMapFace);
+	case engine::gfx::rasterization::RenderLayer::ShadowMap: return Shadow;
+	default: return Main;
+	}
+}
+}  // namespace CullingView
+
+////////////////////////////////////////////////
+// Culling pentru mai multe view-uri intr-o singura trecere
+// - camera principala, shadow map-ul (ortografic) si cele 6 fete ale cube map-ului
+// - pentru fiecare bounding box se testeaza toate view-urile active si se intoarce masca de vizibilitate
+// - statisticile (cate teste / cate vizibile pe view) se reseteaza la BeginSweep
+// - nu depinde de D3D12 / DirectXMath: view-urile si cutiile vin ca tipuri simple (FloatTypes.hpp)
+///////////////////////////////////////////////
+class MultiViewCuller
+{
+public:
+	struct View
+	{
+		engine::math::FrustumPlanes frustum;
+		engine::math::Float4x4 viewProjMatrix;
+		engine::math::Float3 position;
+
+		// 0 - fara test de distanta
+		float maxDistance;
+	};
+
+	MultiViewCuller();
+
+	void SetView(
+		CullingView::Value view,
+		const engine::math::FrustumPlanes& frustum,
+		const engine::math::Float4x4& viewProjMatrix,
+		const engine::math::Float3& position,
+		float maxDistance);
+	void DisableView(CullingView::Value view);
+
+	// Testul de ocluzie se aplica doar view-ului principal; nullptr il dezactiveaza
+	inline void SetOcclusionCuller(const OcclusionCuller* occlusionCuller) { m_occlusionCuller = occlusionCuller; }
+
+	// PVS-ul se aplica tot doar view-ului principal; celula camerei se calculeaza la BeginSweep
+	static constexpr uint32_t NoPVSTarget = UINT32_MAX;
+	inline void SetPotentiallyVisibleSet(const TerrainPVS* pvs) { m_pvs = pvs; }
+
+	void BeginSweep();
+	// pvsTarget - indexul bounding box-ului in PVS; NoPVSTarget pentru obiectele care nu fac parte din el
+	CullingView::Mask Cull(const engine::math::BoxBounds& bounds, uint32_t pvsTarget = NoPVSTarget) const;
+
+	inline bool IsViewActive(CullingView::Value view) const { return (m_activeViews & CullingView::ToMask(view)) != 0; }
+	inline const View& GetView(CullingView::Value view) const { return m_views[view]; }
+
+	// Procentul de bounding box-uri eliminate pentru un view de la ultimul BeginSweep
+	float GetCulledRatio(CullingView::Value view) const;
+
+private:
+	std::array<View, CullingView::Count> m_views;
+	CullingView::Mask m_activeViews;
+
+	const OcclusionCuller* m_occlusionCuller;
+
+	const TerrainPVS* m_pvs;
+	int m_pvsCell;
+
+	mutable uint32_t m_testedCount;
+	mutable std::array<uint32_t, CullingView::Count> m_visibleCount;
+};
+
+}  // namespace engine::gfx
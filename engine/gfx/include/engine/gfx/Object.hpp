@@ -3,10 +3,13 @@
 #include "Utilities.hpp"
 #include "GraphicsResources.hpp"
 #include "Mesh.hpp"
+#include "MultiViewCuller.hpp"
 
 namespace engine::gfx
 {
 
+struct DrawPacket;
+
 class Object
 {
 public:
@@ -20,6 +23,11 @@ class Object
 	virtual void Render(engine::gfx::rasterization::RenderLayer::Value renderLayer);
 	virtual void Update(float delatTime);
 
+	// Leaga datele obiectului pentru root signature-ul Default: indecsii bindless de obiect si material sau CB-ul de
+	// obiect
+	void BindObjectData(GraphicsContext& graphicsContext) const;
+	void BindObjectData(DrawPacket& packet) const;
+
 	const engine::math::Matrix4& GetTextureTransform() const { return m_textureTransform; }
 	const engine::math::Quaternion& GetRotation() const { return m_rotation; }
 	const engine::math::Matrix4& GetTransform() const { return m_transform; }
@@ -31,10 +39,14 @@ class Object
 	inline const engine::math::AABB& GetWorldSpaceAABB() const { return m_worldSpaceAABB; }
 	inline const SubMesh& GetSubMesh() const { return m_subMesh; }
 
-	inline bool IsDirty() const { return m_dirtyCount != 0 && !m_isStatic; }
+	// Creste la fiecare modificare a datelor din CB-ul obiectului; FrameResources rescrie doar recordurile schimbate
+	inline UINT GetVersion() const { return m_version; }
 	inline UINT GetMaterialCB_ID() const { return m_materialCB_ID; }
 	inline UINT GetObjectCB_ID() const { return m_objectCB_ID; }
-	inline bool IsVisible() const { return m_isVisible; }
+	inline bool IsVisible(CullingView::Value view = CullingView::Main) const
+	{
+		return m_isEnabled && (m_visibleViews & CullingView::ToMask(view)) != 0;
+	}
 	inline bool IsStatic() const { return m_isStatic; }
 
 	void SetTextureTransform(const engine::math::Matrix4& toSet);
@@ -45,8 +57,8 @@ class Object
 	void SeColor(const engine::math::Vector4& toSet);
 	void SetObjectCB_ID(UINT toSet);
 	void SetVisible(bool toSet);
+	void SetVisibleViews(CullingView::Mask toSet);
 
-	void DecreaseDirtyCount();
 	void SetDirty();
 
 protected:
@@ -65,8 +77,12 @@ class Object
 	SubMesh m_subMesh;
 
 	bool m_isStatic;
-	bool m_isVisible;
-	int m_dirtyCount;
+	// SetVisible ascunde obiectul in toate view-urile, indiferent de culling
+	bool m_isEnabled;
+	CullingView::Mask m_visibleViews;
+	UINT m_version;
+	// Pozitia, scala sau rotatia s-au schimbat de la ultimul Update
+	bool m_isTransformOutdated;
 
 	UINT m_objectCB_ID;
 	UINT m_materialCB_ID;
@@ -2,7 +2,9 @@
 
 #include "FrameResources.hpp"
 #include "GeometryRenderer.hpp"
+#include "InstanceBatcher.hpp"
 #include "Object.hpp"
+#include "engine/math/LooseOctree.hpp"
 
 #include <unordered_map>
 
@@ -17,13 +19,25 @@ class ObjectRenderer : public GeometryRenderer
 	static ObjectRenderer::Ptr CreateObjectRenderer(engine::gfx::render_descriptors::DX_OBJECTS_RENDERER_DESCRIPTOR descriptor);
 
 	void Render(engine::gfx::rasterization::RenderLayer::Value renderLayer) const override;
+	void SubmitDraws(
+		RenderQueue<DrawPacket>& queue,
+		engine::gfx::rasterization::RenderLayer::Value renderLayer,
+		const BaseCamera& camera) const override;
 	void BuildAccelerationStructures() override;
-	void FrustumCulling(const CameraController& cameraController) override;
+	void FrustumCulling(const MultiViewCuller& culler) override;
 	void Update(float delatTime) override;
+	void UploadIndirectDraws() override;
+
+	// Grupeaza obiectele vizibile dupa mesh si material; se apeleaza dupa culling, inainte de actualizarea CB-urilor
+	void BuildInstanceBatches();
+	inline bool UseInstancing() const { return m_baseInstancedPSO != nullptr; }
+	inline const InstanceBatcher& GetInstanceBatcher() const { return m_instanceBatcher; }
 
 	inline const engine::math::AABB& GetAABB(std::string name) const { return m_boundingBoxes.at(name); }
 	inline const SubMesh& GetSubMesh(std::string name) const { return m_subMeshes.at(name); }
 	inline const Object::Vec& GetObjects() const { return m_objects; }
+	// Interogarile intorc indecsi in GetObjects()
+	inline const engine::math::LooseOctree& GetObjectTree() const { return *m_objectTree; }
 
 	~ObjectRenderer();
 
@@ -32,14 +46,38 @@ class ObjectRenderer : public GeometryRenderer
 
 	void LoadGeometry(DescriptorVariant descriptor) override;
 	void CreateObjects(const engine::gfx::render_descriptors::DX_OBJECTS_RENDERER_DESCRIPTOR&);
+	void CreateIndirectObjectDraws();
+
+	// Calea indirecta se poate folosi doar cu PSO-urile care au root signature-ul signaturii de comanda
+	bool UseIndirectObjectDraws(const GraphicsPSO& pso) const;
+	const GraphicsPSO* GetInstancedPipelineState(engine::gfx::rasterization::RenderLayer::Value renderLayer) const;
 
 	GraphicsPSO::Ptr m_shadowDebugPSO;
+	GraphicsPSO::Ptr m_baseInstancedPSO;
+	GraphicsPSO::Ptr m_dynamicCubeMapInstancedPSO;
+	GraphicsPSO::Ptr m_shadowInstancedPSO;
 	Texture::Ptr m_shadowTexture;
 
 	std::unordered_map<std::string, engine::math::AABB> m_boundingBoxes;
 	std::unordered_map<std::string, SubMesh> m_subMeshes;
 
 	std::vector<Object::Ptr> m_objects;
+
+	// Indexul spatial al obiectelor; handle-ul fiecarui obiect, in ordinea din m_objects
+	std::unique_ptr<engine::math::LooseOctree> m_objectTree;
+	std::vector<engine::math::LooseOctree::Handle> m_objectHandles;
+
+	// Candidatii din octree pentru sweep-ul curent si marcajul folosit la eliminarea duplicatelor
+	std::vector<uint32_t> m_cullCandidates;
+	std::vector<uint32_t> m_cullStamps;
+	uint32_t m_cullStamp = 0;
+
+	IndirectDrawBuilder<IndirectObjectDrawArguments> m_indirectObjectDraws;
+	IndirectArgumentBuffer<IndirectObjectDrawArguments> m_indirectObjectArguments;
+	CommandSignature::Ptr m_objectDrawSignature;
+	ID3D12RootSignature* m_objectDrawRootSignature = nullptr;
+
+	InstanceBatcher m_instanceBatcher;
 };
 
 }  // namespace engine::gfx
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Heightfield.hpp"
+#include "RecordingScheduler.hpp"
+#include "engine/math/FloatTypes.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace engine::gfx
+{
+
+////////////////////////////////////////////////
+// Occlusion culling pe CPU cu un depth buffer de rezolutie mica
+// - bufferul este impartit in tile-uri de 8x4 pixeli; fiecare tile pastreaza doua straturi de adancime
+//   (zMax0 - adancimea maxima garantata pe tot tile-ul, zMax1 - adancimea maxima a zonei acoperite de mask)
+//   si masca de acoperire a stratului de lucru (masked depth)
+// - ocluderii se rasterizeaza pe benzi de tile-uri, in paralel pe workerii RecordingScheduler (fara alocari);
+//   masca de acoperire se calculeaza cu SSE
+// - adancimea este z / w din D3D: 0 aproape, 1 departe
+// - totul este conservativ: un AABB care atinge planul near sau iese din ecran e considerat vizibil
+// - nu depinde de D3D12 / DirectXMath: matricea si cutiile vin ca tipuri simple (FloatTypes.hpp)
+///////////////////////////////////////////////
+class OcclusionCuller
+{
+public:
+	using Ptr = std::unique_ptr<OcclusionCuller>;
+
+	static constexpr uint32_t TileWidth = 8;
+	static constexpr uint32_t TileHeight = 4;
+
+	struct Occluder
+	{
+		std::vector<engine::math::Float3> vertices;
+		std::vector<uint32_t> indices;
+	};
+
+	OcclusionCuller(uint32_t width, uint32_t height, uint32_t bandCount);
+
+	// Lucrarile benzilor pastreaza this
+	OcclusionCuller(const OcclusionCuller&) = delete;
+	OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+	// Ocluder grosier, cellsPerSide x cellsPerSide celule, din grila terenului.
+	// Fiecare varf primeste minimul inaltimilor din celulele vecine, deci ocluderul ramane sub teren.
+	static Occluder BuildHeightfieldOccluder(const Heightfield& heightfield, int cellsPerSide);
+
+	void BeginFrame(const engine::math::Float4x4& viewProjMatrix);
+	void AddOccluder(const Occluder& occluder);
+	// Fara scheduler (sau cu un scheduler fara workeri) benzile se rasterizeaza pe rand, pe thread-ul apelant
+	void Rasterize(RecordingScheduler* scheduler = nullptr);
+
+	bool IsVisible(const engine::math::BoxBounds& box) const;
+
+	// Statistici pentru ultimul frame
+	inline uint32_t GetRasterizedTriangleCount() const { return (uint32_t)m_triangles.size(); }
+	inline uint32_t GetTestedCount() const { return m_testedCount; }
+	inline uint32_t GetOccludedCount() const { return m_occludedCount; }
+
+	inline uint32_t GetWidth() const { return m_width; }
+	inline uint32_t GetHeight() const { return m_height; }
+
+	// Adancimea garantata a unui tile (pentru debug)
+	inline float GetTileDepth(uint32_t tileX, uint32_t tileY) const { return m_zMax0[tileY * m_tilesPerRow + tileX]; }
+
+private:
+	// Triunghi in spatiu ecran: pozitii in pixeli, adancime in [0, 1]
+	struct ScreenTriangle
+	{
+		float x[3];
+		float y[3];
+		float z[3];
+
+		float minX, maxX, minY, maxY;
+		float maxZ;
+	};
+
+	void RasterizeBand(uint32_t band);
+	void RasterizeTriangle(const ScreenTriangle& triangle, uint32_t firstTileRow, uint32_t lastTileRow);
+	void UpdateTile(uint32_t tileIndex, uint32_t coverage, float depth);
+
+	static uint32_t ComputeCoverage(const float edges[3][3], float tileX, float tileY);
+
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_tilesPerRow;
+	uint32_t m_tileRows;
+	uint32_t m_bandCount;
+
+	engine::math::Float4x4 m_viewProjMatrix;
+
+	std::vector<ScreenTriangle> m_triangles;
+	std::vector<RecordingPass> m_bandPasses;
+
+	// Structura de tip SoA ca testarea sa compare 4 tile-uri odata
+	std::vector<float> m_zMax0;
+	std::vector<float> m_zMax1;
+	std::vector<uint32_t> m_masks;
+
+	mutable uint32_t m_testedCount;
+	mutable uint32_t m_occludedCount;
+};
+
+}  // namespace engine::gfx
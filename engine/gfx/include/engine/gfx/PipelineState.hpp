@@ -23,8 +23,11 @@ class PipelineState
 
 	void SetRootSignature(RootSignature::Ptr rootSiganture) { m_rootSignature = rootSiganture; }
 
+	// Identificator mic si unic, folosit in cheile de sortare ale RenderQueue
+	inline uint32_t GetSortID() const { return m_sortID; }
+
 protected:
-	PipelineState() = default;
+	PipelineState() : m_sortID(nextSortID++) {}
 	PipelineState(const PipelineState&) = delete;
 	PipelineState& operator=(const PipelineState&) = delete;
 
@@ -33,6 +36,11 @@ class PipelineState
 	Microsoft::WRL::ComPtr<ID3D12StateObject> m_pipelineStateObject;
 
 	RootSignature::Ptr m_rootSignature;
+
+private:
+	uint32_t m_sortID;
+
+	static uint32_t nextSortID;
 };
 
 
@@ -21,6 +21,10 @@ struct PipelineStateLoader
 	static GraphicsPSO::Ptr LoadShadowMapPipelineState(const ShadersManager& shadersManager);
 	static GraphicsPSO::Ptr LoadTexturePipelineState(const ShadersManager& shadersManager);
 
+	// Variantele instantiate ale PSO-urilor pentru obiecte (vertex shader compilat cu INSTANCED)
+	static GraphicsPSO::Ptr LoadDefaultInstancedPipelineState(const ShadersManager& shadersManager);
+	static GraphicsPSO::Ptr LoadShadowMapInstancedPipelineState(const ShadersManager& shadersManager);
+
 	// Compute PSOs
 	static ComputePSO::Ptr LoadWavesComputePipelineState(const ShadersManager& shadersManager);
 
@@ -5,7 +5,8 @@
 #include "ShadersManager.hpp"
 #include "PipelineStateLoader.hpp"
 
-#include <unordered_map>
+#include <map>
+#include <string_view>
 
 namespace engine::gfx
 {
@@ -17,14 +18,15 @@ class PipelineStateManager
 	PipelineStateManager() = default;
 	~PipelineStateManager();
 
-	PipelineStateType::Ptr GetPipelineState(std::string name);
+	// Cautarea nu construieste std::string, se poate folosi in fiecare cadru
+	PipelineStateType::Ptr GetPipelineState(std::string_view name);
 	bool AddPipelineState(std::string name, PipelineStateType::Ptr pipelineState);
 
 	void LoadPipelineStates(
 		const RootSignatureManager& rsManager, const ShadersManager& shadersManager, ID3D12Device10* pDevice);
 
 private:
-	std::unordered_map<std::string, typename PipelineStateType::Ptr> m_pipelineStates;
+	std::map<std::string, typename PipelineStateType::Ptr, std::less<>> m_pipelineStates;
 	bool firstLoad = true;
 };
 
@@ -36,7 +38,7 @@ PipelineStateManager<PipelineStateType>::~PipelineStateManager()
 }
 
 template <class PipelineStateType>
-inline PipelineStateType::Ptr PipelineStateManager<PipelineStateType>::GetPipelineState(std::string name)
+inline PipelineStateType::Ptr PipelineStateManager<PipelineStateType>::GetPipelineState(std::string_view name)
 {
 	auto it = m_pipelineStates.find(name);
 	if (it == m_pipelineStates.end())
@@ -112,6 +114,22 @@ inline void PipelineStateManager<GraphicsPSO>::LoadPipelineStates(
 		AddPipelineState("ShadowMap", pipelineState);
 	}
 
+	{
+		GraphicsPSO::Ptr pipelineState = PipelineStateLoader::LoadDefaultInstancedPipelineState(shadersManager);
+		pipelineState->SetRootSignature(rsManager.GetRootSignature("Default"));
+		pipelineState->Finalize(pDevice);
+
+		AddPipelineState("DefaultInstanced", pipelineState);
+	}
+
+	{
+		GraphicsPSO::Ptr pipelineState = PipelineStateLoader::LoadShadowMapInstancedPipelineState(shadersManager);
+		pipelineState->SetRootSignature(rsManager.GetRootSignature("Default"));
+		pipelineState->Finalize(pDevice);
+
+		AddPipelineState("ShadowMapInstanced", pipelineState);
+	}
+
 	{
 		GraphicsPSO::Ptr pipelineState = PipelineStateLoader::LoadTexturePipelineState(shadersManager);
 		pipelineState->SetRootSignature(rsManager.GetRootSignature("Texture"));
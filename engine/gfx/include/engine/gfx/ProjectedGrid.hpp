@@ -0,0 +1,92 @@
+#pragma once
+
+#include "engine/math/FloatTypes.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace engine::gfx
+{
+
+////////////////////////////////////////////////
+// Grila proiectata pentru suprafata apei
+// - grila este uniforma in spatiul ecran al camerei si se proiecteaza pe planul apei
+// - zona ecranului acoperita se calculeaza din intersectia frustumului cu stratul
+//   [planeHeight - maxAmplitude, planeHeight + maxAmplitude] in care se pot afla valurile
+// - numarul de vertecsi nu depinde de intinderea apei
+// - nu depinde de D3D12; Generate scrie doar pozitia si coordonatele de textura ale vertecsilor
+///////////////////////////////////////////////
+class ProjectedGrid
+{
+public:
+	using Ptr = std::unique_ptr<ProjectedGrid>;
+	using Float3 = engine::math::Float3;
+	using Float4x4 = engine::math::Float4x4;
+
+	ProjectedGrid(uint32_t columns, uint32_t rows, float maxAmplitude, float planeHeight = 0.f);
+
+	// Completeaza GetVertexCount() vertecsi; intoarce false daca planul apei nu este vizibil.
+	// Coordonatele de textura urmeaza conventia din GenerateChunks pentru o suprafata width x length.
+	// Restul atributelor raman cele din vector, deci se pot completa o singura data.
+	template <typename Vertex>
+	bool Generate(const Float4x4& viewProjMatrix, float width, float length, std::vector<Vertex>& vertices) const;
+
+	std::vector<uint32_t> GenerateIndices() const;
+
+	inline uint32_t GetVertexCount() const { return (m_columns + 1) * (m_rows + 1); }
+	inline uint32_t GetIndexCount() const { return m_columns * m_rows * 6; }
+
+private:
+	// Dreptunghiul din NDC (minX, minY, maxX, maxY) in care se vede planul apei
+	bool ComputeScreenBounds(const Float4x4& viewProjMatrix, const Float4x4& invViewProjMatrix, float bounds[4]) const;
+
+	// Intersectia razei prin punctul (x, y) din NDC cu planul apei
+	Float3 ProjectOnPlane(const Float4x4& invViewProjMatrix, float x, float y) const;
+
+	uint32_t m_columns;
+	uint32_t m_rows;
+
+	float m_maxAmplitude;
+	float m_planeHeight;
+};
+
+template <typename Vertex>
+bool ProjectedGrid::Generate(
+	const Float4x4& viewProjMatrix, float width, float length, std::vector<Vertex>& vertices) const
+{
+	Float4x4 invViewProjMatrix;
+	if (!engine::math::Invert(viewProjMatrix, invViewProjMatrix))
+		return false;
+
+	float bounds[4];
+	if (!ComputeScreenBounds(viewProjMatrix, invViewProjMatrix, bounds))
+		return false;
+
+	vertices.resize(GetVertexCount());
+
+	for (uint32_t i = 0; i <= m_rows; i++)
+	{
+		const float y = bounds[1] + (bounds[3] - bounds[1]) * i / m_rows;
+
+		for (uint32_t j = 0; j <= m_columns; j++)
+		{
+			const float x = bounds[0] + (bounds[2] - bounds[0]) * j / m_columns;
+			const Float3 position = ProjectOnPlane(invViewProjMatrix, x, y);
+
+			Vertex& vertex = vertices[i * (m_columns + 1) + j];
+
+			vertex.position.x = position[0];
+			vertex.position.y = position[1];
+			vertex.position.z = position[2];
+
+			// Aceeasi conventie ca GenerateChunks: u pe Z, v pe X
+			vertex.texC.x = (position[2] + width / 2.0f) / width;
+			vertex.texC.y = (position[0] + length / 2.0f) / length;
+		}
+	}
+
+	return true;
+}
+
+}  // namespace engine::gfx
@@ -1,8 +1,15 @@
 #pragma once
 
 #include "Graphics.hpp"
+#include "CommandBundle.hpp"
+#include "DrawPacket.hpp"
 #include "DynamicCubeMap.hpp"
+#include "FrameGraph.hpp"
+#include "MultiViewCuller.hpp"
+#include "OcclusionCuller.hpp"
+#include "RecordingScheduler.hpp"
 #include "ShadowMap.hpp"
+#include "TerrainPVS.hpp"
 #include "engine/core/TickTimer.hpp"
 
 namespace engine::gfx
@@ -28,6 +35,14 @@ class RasterizationGraphics : public Graphics
 	void LoadAssets() override;
 	void PopulateCommandList() override;
 
+	void UpdateCullingViews();
+	void LoadPotentiallyVisibleSet();
+
+	// Root signature-ul Default si argumentele comune tuturor pass-urilor; fiecare command list le seteaza separat
+	void SetDefaultRootArguments(GraphicsContext& graphicsContext);
+	// Tranzitiile calculate de graful cadrului, aplicate pe contextul pass-ului
+	void ApplyBarriers(GraphicsContext& graphicsContext, const std::vector<FrameGraphBarrier>& barriers);
+
 private:
 	PipelineStateManager<GraphicsPSO> m_graphicsPipelineStateManager;
 
@@ -40,6 +55,25 @@ class RasterizationGraphics : public Graphics
 	DynamicCubeMap::Ptr m_dynamicCubeMap;
 	ShadowMap::Ptr m_shadowMap;
 	TextureRenderer::Ptr m_textureRenderer;
+
+	MultiViewCuller m_culler;
+	OcclusionCuller::Ptr m_occlusionCuller;
+	TerrainPVS::Ptr m_terrainPVS;
+
+	RenderQueue<DrawPacket> m_renderQueue;
+	RenderQueue<DrawPacket> m_shadowQueue;
+	std::array<RenderQueue<DrawPacket>, 6> m_cubeMapQueues;
+	CommandBundle::Ptr m_baseBundle;
+
+	// Shadow map-ul, fetele cube map-ului si pass-ul principal se inregistreaza in paralel
+	RecordingScheduler m_recordingScheduler;
+	// Refolosit in fiecare cadru, ca sa nu se aloce din nou
+	std::vector<RecordingPass> m_recordingPasses;
+
+	// Ordinea pass-urilor si tranzitiile dintre ele; m_frameGraphResources e indexat ca resursele grafului
+	FrameGraph m_frameGraph;
+	std::vector<GpuResource*> m_frameGraphResources;
+	uint32_t m_reportedFrameGraphPassCount = 0;
 };
 
 }  // namespace engine::gfx
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine::gfx
+{
+
+// Un pass inregistrat pe command list-ul lui
+// - begin si end ruleaza pe thread-ul apelant, in ordinea pass-urilor: tot ce modifica starea comuna a resurselor
+//   (tranzitii, render target-uri, flag-uri de dirty)
+// - record poate rula pe orice worker si scrie doar command list-ul pass-ului (draw-uri)
+struct RecordingPass
+{
+	std::function<void()> begin;
+	std::function<void()> record;
+	std::function<void()> end;
+};
+
+////////////////////////////////////////////////
+// Inregistrarea pass-urilor unui cadru pe mai multe thread-uri
+// - Execute ruleaza toate begin-urile in ordine, apoi record-urile in paralel (workerii si thread-ul apelant iau
+//   pass-uri pe rand), apoi toate end-urile in ordine; listele se trimit in ordinea pass-urilor, oricare s-a terminat
+//   primul
+// - fara workeri fiecare pass ruleaza begin, record, end inaintea urmatorului, deci pass-urile pot imparti acelasi
+//   command list
+// - o exceptie aruncata dintr-un record se rearunca pe thread-ul apelant, dupa ce toate record-urile s-au terminat
+///////////////////////////////////////////////
+class RecordingScheduler
+{
+public:
+	RecordingScheduler() = default;
+	~RecordingScheduler();
+
+	RecordingScheduler(const RecordingScheduler&) = delete;
+	RecordingScheduler& operator=(const RecordingScheduler&) = delete;
+
+	void Create(uint32_t workerCount);
+
+	void Execute(const std::vector<RecordingPass>& passes);
+
+	inline uint32_t GetWorkerCount() const { return (uint32_t)m_workers.size(); }
+	inline bool IsParallel() const { return !m_workers.empty(); }
+
+private:
+	void WorkerLoop();
+	// Ia pass-uri din lotul generation pana se termina; un thread intarziat nu mai ia nimic dintr-un lot nou
+	void RunPasses(uint64_t generation);
+
+	std::vector<std::thread> m_workers;
+
+	std::mutex m_mutex;
+	std::condition_variable m_workAvailable;
+	std::condition_variable m_workDone;
+
+	// Lotul curent, protejat de m_mutex
+	const std::vector<RecordingPass>* m_passes = nullptr;
+	uint64_t m_generation = 0;
+	uint32_t m_nextPass = 0;
+	uint32_t m_pendingPasses = 0;
+	std::exception_ptr m_exception;
+	bool m_isStopping = false;
+};
+
+}  // namespace engine::gfx
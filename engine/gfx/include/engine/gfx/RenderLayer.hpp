@@ -0,0 +1,23 @@
+#pragma once
+
+namespace engine::gfx
+{
+
+// Pass-urile de rasterizare in care se deseneaza un renderer; separat de Utilities.hpp ca sa se poata folosi si in
+// modulele care nu depind de D3D12 (ex. MultiViewCuller)
+namespace rasterization
+{
+namespace RenderLayer
+{
+enum Value : int
+{
+	Base = 0,
+	CubeMap = 1,
+	ShadowMap = 2,
+	DebugShadowMap = 3,
+	OcclusionQuery = 4
+};
+}
+}  // namespace rasterization
+
+}  // namespace engine::gfx
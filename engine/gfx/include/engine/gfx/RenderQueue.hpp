@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine::gfx
+{
+
+////////////////////////////////////////////////
+// Cheia de sortare pe 64 de biti a unui draw, de la cel mai semnificativ camp:
+// layer (4) | PSO (12) | material (16) | mesh (16) | adancime cuantizata (16)
+// - layer-ul separa grupurile care trebuie desenate intr-o ordine fixa (ex. skybox-ul fara depth test inaintea restului)
+// - in interiorul unui layer draw-urile se grupeaza dupa PSO, apoi material si mesh; adancimea ordoneaza de la camera
+//   spre departe ce ramane cu aceeasi stare
+///////////////////////////////////////////////
+namespace SortKey
+{
+static constexpr uint32_t LayerBits = 4;
+static constexpr uint32_t PSOBits = 12;
+static constexpr uint32_t MaterialBits = 16;
+static constexpr uint32_t MeshBits = 16;
+static constexpr uint32_t DepthBits = 16;
+
+static_assert(LayerBits + PSOBits + MaterialBits + MeshBits + DepthBits == 64, "Cheia trebuie sa aiba 64 de biti");
+
+// Valorile mai mari decat campul se trunchiaza la bitii de jos
+inline constexpr uint64_t Make(uint32_t layer, uint32_t psoID, uint32_t materialID, uint32_t meshID, uint32_t depth)
+{
+	uint64_t key = layer & ((1u << LayerBits) - 1);
+	key = (key << PSOBits) | (psoID & ((1u << PSOBits) - 1));
+	key = (key << MaterialBits) | (materialID & ((1u << MaterialBits) - 1));
+	key = (key << MeshBits) | (meshID & ((1u << MeshBits) - 1));
+	key = (key << DepthBits) | (depth & ((1u << DepthBits) - 1));
+
+	return key;
+}
+
+// Distanta fata de camera in [0, maxDistance] -> [0, 65535]; reverse pentru ordinea de la departe spre camera
+uint32_t QuantizeDepth(float distance, float maxDistance, bool reverse = false);
+}  // namespace SortKey
+
+struct SortEntry
+{
+	uint64_t key;
+	uint32_t packet;
+};
+
+// Radix sort LSD pe octeti, stabil: la chei egale ramane ordinea de submit.
+// Trecerile in care toate cheile au acelasi octet se sar. scratch se redimensioneaza la nevoie.
+void RadixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch);
+
+////////////////////////////////////////////////
+// Coada de draw-uri a unui pass
+// - renderer-ele trimit pachete cu cheia lor; Sort le ordoneaza, apoi pachetele se parcurg in ordinea cheilor
+// - pachetele nu se muta la sortare, se sorteaza doar perechile (cheie, index)
+// - pachetul concret si redarea lui prin GraphicsContext sunt in DrawPacket
+///////////////////////////////////////////////
+template <class Packet>
+class RenderQueue
+{
+public:
+	inline void Reset()
+	{
+		m_entries.clear();
+		m_packets.clear();
+		m_isSorted = true;
+	}
+
+	inline void Submit(uint64_t key, const Packet& packet)
+	{
+		m_entries.push_back({key, (uint32_t)m_packets.size()});
+		m_packets.push_back(packet);
+		m_isSorted = false;
+	}
+
+	inline void Sort()
+	{
+		RadixSort(m_entries, m_scratch);
+		m_isSorted = true;
+	}
+
+	inline size_t GetPacketCount() const { return m_entries.size(); }
+	inline uint64_t GetSortedKey(size_t index) const { return m_entries[index].key; }
+	inline const Packet& GetSortedPacket(size_t index) const
+	{
+		assert(m_isSorted);
+		return m_packets[m_entries[index].packet];
+	}
+
+private:
+	std::vector<SortEntry> m_entries;
+	std::vector<SortEntry> m_scratch;
+	std::vector<Packet> m_packets;
+
+	bool m_isSorted = true;
+};
+
+}  // namespace engine::gfx
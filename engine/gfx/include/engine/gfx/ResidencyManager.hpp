@@ -0,0 +1,84 @@
+#pragma once
+
+#include "ResidencyPolicy.hpp"
+
+#include <d3d12.h>
+#include <dxgi1_6.h>
+#include <wrl/client.h>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace engine::gfx
+{
+
+////////////////////////////////////////////////
+// Rezidenta resurselor urmarite (MakeResident / Evict), dupa ResidencyPolicy
+// - bugetul e cel dat de DXGI pentru memoria locala (sau Settings::GetResidencyBudgetMB, daca e mai mic), minus
+//   ce folosesc resursele neurmarite (heap-uri, buffere, render target-uri)
+// - cadrele se numara aici; RetireFrame leaga cadrul de fence-ul lui, ca Update sa stie ce a terminat GPU-ul
+// - doar resursele committed: cele plasate impart heap-ul, care e rezident sau nu in intregime
+// - doar de pe thread-ul principal; MarkUsed inainte de a trimite listele care folosesc resursa
+///////////////////////////////////////////////
+class ResidencyManager
+{
+public:
+	using Ptr = std::unique_ptr<ResidencyManager>;
+	using Handle = ResidencyPolicy::Handle;
+
+	static constexpr Handle InvalidHandle = ResidencyPolicy::InvalidHandle;
+
+	void Create(ID3D12Device* device, IDXGIAdapter3* adapter);
+
+	// Resursa e rezidenta la creare; trebuie scoasa cu Untrack inainte de a fi eliberata
+	Handle Track(ID3D12Pageable* pObject, UINT64 size, ResidencyPriority::Value priority);
+	void Untrack(Handle handle);
+
+	// O resursa evacuata se face rezidenta pe loc (blocant)
+	void MarkUsed(Handle handle);
+
+	// Evacueaza / aduce inapoi resurse dupa bugetul curent; inainte de SwapContext
+	void Update(UINT64 completedFenceValue);
+	// Dupa SwapContext, cu fence-ul cadrului; incepe cadrul urmator
+	void RetireFrame(UINT64 fenceValue);
+
+	inline UINT64 GetBudget() const { return m_budget; }
+	inline UINT64 GetResidentSize() const { return m_policy.GetResidentSize(); }
+	inline UINT64 GetTrackedSize() const { return m_policy.GetTotalSize(); }
+	inline const ResidencyStatistics& GetStatistics() const { return m_policy.GetStatistics(); }
+
+private:
+	// Bugetul pentru resursele urmarite
+	UINT64 QueryBudget();
+
+	void Evict(const std::vector<Handle>& handles);
+	void MakeResident(const std::vector<Handle>& handles);
+
+	Microsoft::WRL::ComPtr<ID3D12Device> pDevice;
+	Microsoft::WRL::ComPtr<IDXGIAdapter3> pAdapter;
+
+	ResidencyPolicy m_policy;
+	// Pe handle; nullptr pentru handle-urile libere
+	std::vector<ID3D12Pageable*> m_objects;
+
+	struct FrameFence
+	{
+		UINT64 frame;
+		UINT64 fenceValue;
+	};
+
+	// Resursele create la incarcare sunt socotite folosite in primul cadru
+	UINT64 m_frame = 1;
+	UINT64 m_completedFrame = 0;
+	std::deque<FrameFence> m_framesInFlight;
+
+	UINT64 m_budget = 0;
+
+	// Refolosite in fiecare cadru
+	std::vector<Handle> m_evicted;
+	std::vector<Handle> m_madeResident;
+	std::vector<ID3D12Pageable*> m_batch;
+};
+
+}  // namespace engine::gfx
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine::gfx
+{
+
+namespace ResidencyPriority
+{
+enum Value : uint8_t
+{
+	// Se evacueaza primele si se aduc inapoi ultimele
+	Low,
+	Normal,
+	High,
+	Count
+};
+}
+
+struct ResidencyStatistics
+{
+	// Folosiri numarate o data pe cadru; miss = folosire a unei resurse evacuate
+	uint64_t useCount = 0;
+	uint64_t missCount = 0;
+	uint64_t evictedCount = 0;
+	uint64_t evictedSize = 0;
+	// Din miss-uri si din prefetch
+	uint64_t madeResidentCount = 0;
+	uint64_t madeResidentSize = 0;
+	uint64_t prefetchCount = 0;
+	// Cadre in care resursele folosite inca de GPU nu au incaput in buget
+	uint64_t overBudgetFrameCount = 0;
+
+	inline double GetMissRate() const { return useCount != 0 ? (double)missCount / (double)useCount : 0.0; }
+};
+
+////////////////////////////////////////////////
+// Ce resurse raman rezidente in memoria video, in limita unui buget
+// - fiecare resursa are marime, prioritate si ultimul cadru in care a fost folosita; resursele noi sunt rezidente
+// - o resursa evacuata folosita din nou trebuie facuta rezidenta imediat (MarkUsed intoarce true), inainte ca
+//   listele care o folosesc sa plece
+// - Update evacueaza peste buget doar resursele terminate de GPU (ultima folosire <= completedFrame), intai
+//   prioritatea mica, apoi cele folosite cel mai demult (LRU); sub buget aduce inapoi resursele evacuate care
+//   incap, intai prioritatea mare, apoi cele folosite recent
+// - apelantul face MakeResident / Evict pe handle-urile intoarse
+///////////////////////////////////////////////
+class ResidencyPolicy
+{
+public:
+	using Handle = uint32_t;
+
+	static constexpr Handle InvalidHandle = UINT32_MAX;
+
+	// frame e cadrul curent: resursa nu se evacueaza pana nu il termina GPU-ul
+	Handle Add(uint64_t size, ResidencyPriority::Value priority, uint64_t frame);
+	// Resursa poate fi si evacuata; handle-ul se refoloseste
+	void Remove(Handle handle);
+
+	// true daca resursa era evacuata: e deja socotita rezidenta, apelantul o face rezidenta inainte de folosire
+	bool MarkUsed(Handle handle, uint64_t frame);
+
+	// Handle-urile de evacuat si de facut rezidente, in ordinea in care s-au ales
+	void Update(
+		uint64_t completedFrame, uint64_t budget, std::vector<Handle>& evicted, std::vector<Handle>& madeResident);
+
+	inline bool IsResident(Handle handle) const { return m_entries[handle].isResident; }
+	inline uint64_t GetSize(Handle handle) const { return m_entries[handle].size; }
+	inline uint64_t GetResidentSize() const { return m_residentSize; }
+	inline uint64_t GetTotalSize() const { return m_totalSize; }
+	inline size_t GetCount() const { return m_entries.size() - m_freeHandles.size(); }
+	inline const ResidencyStatistics& GetStatistics() const { return m_statistics; }
+
+private:
+	struct Entry
+	{
+		uint64_t size = 0;
+		uint64_t lastUsedFrame = 0;
+		ResidencyPriority::Value priority = ResidencyPriority::Normal;
+		bool isResident = false;
+		bool isAlive = false;
+	};
+
+	void Evict(Handle handle, std::vector<Handle>& evicted);
+	void MakeResident(Handle handle);
+
+	std::vector<Entry> m_entries;
+	std::vector<Handle> m_freeHandles;
+	// Refolosit de Update, ca sa nu aloce in fiecare cadru
+	std::vector<Handle> m_candidates;
+
+	uint64_t m_residentSize = 0;
+	uint64_t m_totalSize = 0;
+
+	ResidencyStatistics m_statistics;
+};
+
+}  // namespace engine::gfx
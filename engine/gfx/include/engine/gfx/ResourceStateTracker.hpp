@@ -0,0 +1,132 @@
+#pragma once
+
+#include "engine/core/FrameArena.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::gfx
+{
+
+// Starea unei resurse pe subresurse; cat timp toate subresursele au aceeasi stare se tine o singura valoare
+// - starile sunt valorile API-ului (ex. D3D12_RESOURCE_STATES), UnknownState nu e o stare valida
+class SubresourceStates
+{
+public:
+	static constexpr uint32_t AllSubresources = UINT32_MAX;
+	static constexpr uint32_t UnknownState = UINT32_MAX;
+
+	SubresourceStates() = default;
+	explicit SubresourceStates(uint32_t state) : m_state(state) {}
+
+	inline bool IsUniform() const { return m_states.empty(); }
+	// Starea comuna, doar cand toate subresursele o au
+	inline uint32_t GetState() const
+	{
+		assert(IsUniform());
+		return m_state;
+	}
+	inline uint32_t GetState(uint32_t subresource) const
+	{
+		return IsUniform() || subresource == AllSubresources ? m_state : m_states[subresource];
+	}
+
+	// subresourceCount e necesar doar la prima separare a starilor
+	void SetState(uint32_t subresource, uint32_t state, uint32_t subresourceCount);
+
+private:
+	// Starea tuturor subresurselor cand m_states e gol
+	uint32_t m_state = UnknownState;
+	std::vector<uint32_t> m_states;
+};
+
+namespace SplitBarrier
+{
+enum Value : uint8_t
+{
+	None,
+	BeginOnly,
+	EndOnly
+};
+}
+
+struct StateTransition
+{
+	void* resource;
+	uint32_t subresource;
+	uint32_t before;
+	uint32_t after;
+	SplitBarrier::Value split;
+};
+
+////////////////////////////////////////////////
+// Starile resurselor vazute de un singur command list
+// - fiecare lista porneste fara sa stie starea resurselor: prima folosire a unei (sub)resurse nu pune bariera, doar
+//   retine starea ceruta; Resolve, apelat la submit in ordinea listelor, intoarce tranzitiile de la starea publicata
+//   de listele anterioare (committedStates) si publica starile de la sfarsitul listei
+// - tranzitiile se aduna in GetPendingBarriers pana la urmatorul punct de flush al contextului (un singur apel
+//   ResourceBarrier)
+// - BeginTransition incepe o tranzitie split; urmatorul Transition al subresursei o termina (EndOnly); tranzitiile
+//   ramase deschise se termina cu EndPendingTransitions inainte de inchiderea listei
+// - resource e doar o cheie intoarsa in tranzitii
+///////////////////////////////////////////////
+class ResourceStateTracker
+{
+public:
+	// Intoarce false daca subresursa era deja in state (nicio tranzitie, nici acum, nici la submit)
+	bool Transition(
+		void* resource,
+		SubresourceStates& committedStates,
+		uint32_t subresourceCount,
+		uint32_t subresource,
+		uint32_t state);
+	void BeginTransition(
+		void* resource,
+		SubresourceStates& committedStates,
+		uint32_t subresourceCount,
+		uint32_t subresource,
+		uint32_t state);
+	void EndPendingTransitions();
+
+	inline const std::vector<StateTransition>& GetPendingBarriers() const { return m_pendingBarriers; }
+	inline void ClearPendingBarriers() { m_pendingBarriers.clear(); }
+
+	// Tranzitiile care trebuie executate inaintea listei se adauga la fixups; trackerul ramane gol
+	void Resolve(engine::core::FrameVector<StateTransition>& fixups);
+	void Reset();
+
+	inline size_t GetTrackedResourceCount() const { return m_resources.size(); }
+
+private:
+	struct TrackedResource
+	{
+		void* resource;
+		SubresourceStates* committedStates;
+		uint32_t subresourceCount;
+
+		// Starea ceruta la prima folosire in lista (Unknown: nefolosita)
+		SubresourceStates initialStates;
+		// Starea curenta in lista (Unknown: nefolosita inca)
+		SubresourceStates currentStates;
+		// Tinta tranzitiei split incepute (Unknown: niciuna)
+		SubresourceStates transitioningStates;
+	};
+
+	TrackedResource& Track(void* resource, SubresourceStates& committedStates, uint32_t subresourceCount);
+	// Operatia se poate face o singura data pentru toate subresursele doar cand toate starile resursei sunt comune
+	static bool IsUniform(const TrackedResource& trackedResource);
+
+	bool TransitionSubresource(TrackedResource& trackedResource, uint32_t subresource, uint32_t state);
+	void BeginSubresourceTransition(TrackedResource& trackedResource, uint32_t subresource, uint32_t state);
+	void EndSubresourceTransition(TrackedResource& trackedResource, uint32_t subresource);
+
+	std::vector<TrackedResource> m_resources;
+	std::unordered_map<void*, size_t> m_resourceIndices;
+
+	std::vector<StateTransition> m_pendingBarriers;
+};
+
+}  // namespace engine::gfx
@@ -2,8 +2,10 @@
 
 #include "RootSignature.hpp"
 
-#include <unordered_map>
 #include <functional>
+#include <map>
+#include <string_view>
+#include <unordered_map>
 
 namespace engine::gfx
 {
@@ -14,8 +16,9 @@ class RootSignatureManager
 	RootSignatureManager();
 
 	bool AddRootSiganture(std::string name, RootSignature::Ptr rootSignture);
-	RootSignature::Ptr GetRootSignature(std::string name) const;
-	ID3D12RootSignature* GetID3D12RootSignature(std::string name) const;
+	// Cautarea nu construieste std::string, se poate folosi in fiecare cadru
+	RootSignature::Ptr GetRootSignature(std::string_view name) const;
+	ID3D12RootSignature* GetID3D12RootSignature(std::string_view name) const;
 
 	void LoadRootSignatures(ID3D12Device10* pDevice);
 
@@ -38,7 +41,7 @@ class RootSignatureManager
 
 private:
 	std::unordered_map<std::string, std::function<RootSignature::Ptr(ID3D12Device10* pDevice)>> m_loadFunctions;
-	std::unordered_map<std::string, RootSignature::Ptr> m_rootSignatures;
+	std::map<std::string, RootSignature::Ptr, std::less<>> m_rootSignatures;
 
 	bool firstLoad = true;
 };
@@ -18,10 +18,11 @@ class ShadowMap
 
 	void SetDirection(engine::math::Vector3 direction);
 
+	// Tranzitiile texturii le pune graful cadrului
 	void Setup(GraphicsContext& graphicsContext);
-	void Finish(GraphicsContext& graphicsContext);
 
 	inline const engine::gfx::DescriptorHandle& GetTextureSRVHandle() { return m_depthTexture->GetSrvHandle(); }
+	inline DepthTexture& GetDepthTexture() { return *m_depthTexture; }
 
 	inline const engine::math::Vector3& GetLightDirection() const { return m_lightDirection; }
 	inline const OrthograficCamera& GetCamera() const { return m_camera; }
@@ -14,8 +14,12 @@ class SkyBoxRenderer : public GeometryRenderer, public Object
 	static SkyBoxRenderer::Ptr CreateSkyBoxRenderer(engine::gfx::render_descriptors::DX_SKYBOX_DESCRIPTOR& descriptor);
 
 	void Render(engine::gfx::rasterization::RenderLayer::Value renderLayer) const override;
+	void SubmitDraws(
+		RenderQueue<DrawPacket>& queue,
+		engine::gfx::rasterization::RenderLayer::Value renderLayer,
+		const BaseCamera& camera) const override;
 	void BuildAccelerationStructures() override;
-	void FrustumCulling(const CameraController& cameraController) override;
+	void FrustumCulling(const MultiViewCuller& culler) override;
 	void Update(float delatTime) override;
 
 	inline const engine::math::Vector3& GetLightDirection() const { return m_lightDirection; }
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+namespace engine::gfx
+{
+
+// Intervalul unei parti dintr-un mesh in bufferele lui de varfuri si indecsi
+struct SubMesh
+{
+	size_t indexCount;
+	size_t startIndexLocation;
+	size_t baseVertexLocation;
+};
+
+}  // namespace engine::gfx
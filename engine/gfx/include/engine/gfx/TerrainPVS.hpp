@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Heightfield.hpp"
+#include "engine/math/FloatTypes.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace engine::gfx
+{
+
+////////////////////////////////////////////////
+// Potentially visible set pentru grila terenului
+// - planul XZ al terenului se imparte in cellsPerSide x cellsPerSide coloane, iar fiecare coloana in heightLevels
+//   straturi de inaltime (pana la maxCameraHeight); o celula a camerei este un strat dintr-o coloana
+// - din mai multe puncte de vedere ale fiecarei celule se arunca raze spre fata de sus a fiecarei tinte
+//   (chunk de teren sau de apa) si se merge pe raza prin heightfield-ul coborat cu heightMargin
+// - o tinta e vizibila daca o singura raza ajunge la ea; rezultatul se dilata cu celulele vecine
+// - camera in afara grilei sau peste maxCameraHeight nu are PVS (totul e potential vizibil)
+// - pe disc fiecare bitset e comprimat cu run-length (varint)
+// - nu depinde de D3D12 / DirectXMath: bake-ul primeste doar inaltimile terenului si cutiile tintelor
+///////////////////////////////////////////////
+class TerrainPVS
+{
+public:
+	using Ptr = std::unique_ptr<TerrainPVS>;
+
+	struct Properties
+	{
+		int cellsPerSide;
+		// Puncte de vedere pe latura unei coloane si numarul de straturi de inaltime
+		int viewpointsPerSide;
+		int heightLevels;
+		// Camera nu coboara sub teren + minCameraHeightAboveTerrain
+		float minCameraHeightAboveTerrain;
+		float maxCameraHeight;
+		// Cu cat se coboara heightfield-ul la testul razelor (acopera erorile de esantionare)
+		float heightMargin;
+		bool dilateNeighbours;
+	};
+
+	// heightfield - grila generata de GenerateChunks
+	static TerrainPVS::Ptr Bake(
+		const Heightfield& heightfield,
+		const std::vector<engine::math::BoxBounds>& targets,
+		const Properties& properties);
+
+	// Incarca fisierul daca exista si corespunde datelor de intrare, altfel face bake si il salveaza
+	static TerrainPVS::Ptr LoadOrBake(
+		const std::wstring& path,
+		const Heightfield& heightfield,
+		const std::vector<engine::math::BoxBounds>& targets,
+		const Properties& properties);
+
+	bool Save(const std::wstring& path) const;
+	static TerrainPVS::Ptr Load(const std::wstring& path, uint64_t expectedSourceHash);
+
+	// Amprenta datelor de intrare; un fisier cu alta amprenta trebuie refacut
+	static uint64_t ComputeSourceHash(
+		const Heightfield& heightfield,
+		const std::vector<engine::math::BoxBounds>& targets,
+		const Properties& properties);
+
+	// -1 daca pozitia nu e acoperita de PVS
+	int GetCell(float x, float y, float z) const;
+	inline bool IsVisible(int cell, uint32_t target) const
+	{
+		return (m_bits[(size_t)cell * m_wordsPerCell + target / 64] >> (target % 64)) & 1;
+	}
+
+	inline uint32_t GetTargetCount() const { return m_targetCount; }
+	inline int GetCellCount() const { return m_cellsPerSide * m_cellsPerSide * m_heightLevels; }
+	size_t GetCompressedSize() const;
+	float GetVisibleRatio() const;
+
+private:
+	TerrainPVS() = default;
+
+	void Allocate(int cellsPerSide, int heightLevels, uint32_t targetCount);
+
+	static std::vector<uint8_t> CompressCell(const uint64_t* bits, uint32_t targetCount);
+	static bool DecompressCell(const std::vector<uint8_t>& data, uint64_t* bits, uint32_t targetCount);
+
+	int m_cellsPerSide = 0;
+	int m_heightLevels = 0;
+	uint32_t m_targetCount = 0;
+	uint32_t m_wordsPerCell = 0;
+
+	float m_minX = 0.f;
+	float m_minZ = 0.f;
+	float m_cellSizeX = 0.f;
+	float m_cellSizeZ = 0.f;
+	float m_minCameraHeight = 0.f;
+	float m_levelHeight = 0.f;
+	float m_maxCameraHeight = 0.f;
+
+	uint64_t m_sourceHash = 0;
+
+	std::vector<uint64_t> m_bits;
+};
+
+}  // namespace engine::gfx
@@ -2,6 +2,10 @@
 
 #include "GeometryRenderer.hpp"
 #include "Object.hpp"
+#include "OcclusionCuller.hpp"
+#include "TerrainPVS.hpp"
+#include "TerrainSplatMap.hpp"
+#include "TerrainTessellationMap.hpp"
 
 namespace engine::gfx
 {
@@ -14,10 +18,27 @@ class TerrainRenderer : public GeometryRenderer, public Object
 	static TerrainRenderer::Ptr CreateTerrainRenderer(engine::gfx::render_descriptors::DX_TERRAIN_DESCRIPTOR& descriptor);
 
 	void Render(engine::gfx::rasterization::RenderLayer::Value renderLayer) const override;
-	void FrustumCulling(const CameraController& cameraController) override;
+	void SubmitDraws(
+		RenderQueue<DrawPacket>& queue,
+		engine::gfx::rasterization::RenderLayer::Value renderLayer,
+		const BaseCamera& camera) const override;
+	void FrustumCulling(const MultiViewCuller& culler) override;
 	void BuildAccelerationStructures() override;
 	void Update(float delatTime) override;
 
+	// Texturile coapte pe CPU, pentru TextureManager::CreateTextureFromMemory
+	D3D12_RESOURCE_DESC GetSplatMapDescriptor() const;
+	std::vector<D3D12_SUBRESOURCE_DATA> GetSplatMapSubresources() const;
+	D3D12_RESOURCE_DESC GetTessellationMapDescriptor() const;
+	std::vector<D3D12_SUBRESOURCE_DATA> GetTessellationMapSubresources() const;
+	inline const OcclusionCuller::Occluder& GetOccluder() const { return m_occluder; }
+
+	// Datele de intrare pentru bake-ul PVS-ului
+	inline const Heightfield& GetHeightfield() const { return m_heightfield; }
+	inline bool IsPVSEnabled() const { return m_isPVSEnabled; }
+	inline const TerrainPVS::Properties& GetPVSProperties() const { return m_pvsProperties; }
+	std::vector<engine::math::AABB> GetChunkBoundingBoxes() const;
+
 private:
 	TerrainRenderer() = delete;
 	TerrainRenderer(const engine::gfx::render_descriptors::DX_OBJECT_DESCRIPTOR&);
@@ -25,6 +46,17 @@ class TerrainRenderer : public GeometryRenderer, public Object
 	void LoadGeometry(DescriptorVariant descriptor) override;
 
 	std::vector<Chunk> m_chunks;
+	std::vector<UINT> m_chunkDrawOrder;
+	ViewDrawRanges m_drawRanges;
+
+	TerrainSplatMap::Ptr m_splatMap;
+	TerrainTessellationMap::Ptr m_tessellationMap;
+
+	Heightfield m_heightfield;
+	OcclusionCuller::Occluder m_occluder;
+
+	bool m_isPVSEnabled = false;
+	TerrainPVS::Properties m_pvsProperties = {};
 };
 
 }  // namespace engine::gfx
@@ -0,0 +1,67 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// Regulile de amestec ale straturilor de teren
+// - sunt evaluate o singura data pe CPU (TerrainSplatMap) intr-o harta de splat
+// - shaderele doar decodeaza harta de splat
+// Fisierul este inclus atat din C++ cat si din HLSL.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef HLSL
+#define SPLAT_FUNCTION
+#define SPLAT_OUT(type) out type
+#else
+#include <cmath>
+#define SPLAT_FUNCTION inline
+#define SPLAT_OUT(type) type&
+#endif
+
+#define TERRAIN_LAYER_COUNT 5
+
+// Inaltimea de start a fiecarui strat si cat de mult o deplaseaza zgomotul
+static const float TerrainLayerHeights[TERRAIN_LAYER_COUNT] = {-10.f, 0.f, 15.f, 20.f, 300.f};
+static const float TerrainLayerNoise[TERRAIN_LAYER_COUNT] = {0.f, 0.f, 15.f, 40.f, 0.f};
+
+SPLAT_FUNCTION float NoiseFunction(float x, float z)
+{
+	return sin(x * 0.1f) * cos(z * 0.1f) * 0.5f + 0.5f;
+}
+
+// Stratul de baza si factorul de interpolare spre stratul urmator pentru un punct de pe teren.
+// In afara benzilor se foloseste primul strat.
+SPLAT_FUNCTION void ComputeTerrainLayerBlend(
+	float x, float y, float z, SPLAT_OUT(int) textureIndex, SPLAT_OUT(float) lerpFactor)
+{
+	const float noise = NoiseFunction(x, z);
+
+	textureIndex = 0;
+	lerpFactor = 0.f;
+
+	for (int i = 0; i < TERRAIN_LAYER_COUNT - 1; ++i)
+	{
+		const float low = TerrainLayerHeights[i] + TerrainLayerNoise[i] * noise;
+		const float high = TerrainLayerHeights[i + 1] + TerrainLayerNoise[i + 1] * noise;
+
+		if (y >= low && y < high)
+		{
+			textureIndex = i;
+			lerpFactor = (y - low) / (high - low);
+
+			break;
+		}
+	}
+}
+
+// Harta de splat (RGBA8) contine ponderile straturilor 1..4, ponderea stratului 0 fiind restul pana la 1.
+// Media ponderata a indicilor da stratul si factorul de interpolare si ramane corecta dupa filtrare / mip-uri.
+SPLAT_FUNCTION void DecodeTerrainSplat(
+	float r, float g, float b, float a, SPLAT_OUT(int) textureIndex, SPLAT_OUT(float) lerpFactor)
+{
+	const float layer = r + 2.f * g + 3.f * b + 4.f * a;
+
+	textureIndex = (int)layer;
+	if (textureIndex > TERRAIN_LAYER_COUNT - 2)
+		textureIndex = TERRAIN_LAYER_COUNT - 2;
+
+	lerpFactor = layer - (float)textureIndex;
+}
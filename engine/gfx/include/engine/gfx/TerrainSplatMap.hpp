@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace engine::gfx
+{
+
+////////////////////////////////////////////////
+// Harta de splat a terenului
+// - RGBA8, ponderile straturilor 1..4 (vezi TerrainSplat.h)
+// - coordonatele de textura sunt cele ale mesh-ului generat de GenerateChunks:
+//   u pe Z (width), v pe X (length)
+// - texelul (i, j) al mip-ului 0 e esantionat in centrul lui: v = (i + 0.5) / resolution, u = (j + 0.5) / resolution
+// - nu depinde de D3D12; descriptorul texturii se face in TerrainRenderer
+///////////////////////////////////////////////
+class TerrainSplatMap
+{
+public:
+	using Ptr = std::unique_ptr<TerrainSplatMap>;
+
+	// Eroarea maxima acceptata la validare (un pas de cuantizare pe 8 biti)
+	static constexpr float ValidationTolerance = 1.f / 255.f + 1e-4f;
+
+	static TerrainSplatMap::Ptr Bake(
+		std::function<float(float, float)> heightFunction, float gridWidth, float gridLength, uint32_t resolution);
+
+	// Compara mip-ul 0 cu formula din shader si intoarce eroarea maxima pe indicele de strat
+	float Validate(std::function<float(float, float)> heightFunction) const;
+
+	inline uint32_t GetResolution() const { return m_resolution; }
+	inline uint32_t GetMipCount() const { return (uint32_t)m_mips.size(); }
+	inline const std::vector<uint32_t>& GetMip(uint32_t level) const { return m_mips[level]; }
+
+private:
+	TerrainSplatMap(float gridWidth, float gridLength, uint32_t resolution);
+
+	void GenerateMips();
+
+	float m_gridWidth;
+	float m_gridLength;
+	uint32_t m_resolution;
+
+	std::vector<std::vector<uint32_t>> m_mips;
+};
+
+}  // namespace engine::gfx
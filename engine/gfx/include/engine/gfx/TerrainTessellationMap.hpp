@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace engine::gfx
+{
+
+////////////////////////////////////////////////
+// Scalarea factorului de teselare pentru fiecare patch al terenului
+// - un patch este o celula a grilei generate de GenerateChunks
+// - R8_UNORM, sidePointCount x sidePointCount texeli; texelul (i, j) acopera
+//   coordonatele de textura [j / N, (j + 1) / N) x [i / N, (i + 1) / N) ale mesh-ului,
+//   ultimul rand / ultima coloana dubleaza vecinii
+// - hull shader-ul inmulteste factorul dat de distanta cu valoarea din centrul patch-ului (interior) si cu maximul
+//   celor doua celule vecine mijlocului fiecarei muchii (muchii), ca patch-urile vecine sa nu crape
+// - nu depinde de D3D12; descriptorul texturii se face in TerrainRenderer
+///////////////////////////////////////////////
+class TerrainTessellationMap
+{
+public:
+	using Ptr = std::unique_ptr<TerrainTessellationMap>;
+
+	struct Properties
+	{
+		float fullTessellationDeviation;
+		float minScale;
+		int sampleCount;
+	};
+
+	static TerrainTessellationMap::Ptr Compute(
+		std::function<float(float, float)> heightFunction,
+		float gridWidth,
+		float gridLength,
+		int sidePointCount,
+		const Properties& properties);
+
+	// Deviatia maxima a inaltimii fata de patch-ul biliniar definit de colturile celulei
+	static float MeasureCellDeviation(
+		const std::function<float(float, float)>& heightFunction, float x0, float z0, float dx, float dz, int sampleCount);
+
+	// Deviatie -> scalare in [minScale, 1]
+	static float DeviationToScale(float deviation, const Properties& properties);
+
+	float GetScale(uint32_t row, uint32_t column) const;
+
+	inline uint32_t GetResolution() const { return m_resolution; }
+	inline const std::vector<uint8_t>& GetData() const { return m_scales; }
+
+private:
+	TerrainTessellationMap(uint32_t resolution);
+
+	uint32_t m_resolution;
+	std::vector<uint8_t> m_scales;
+};
+
+}  // namespace engine::gfx
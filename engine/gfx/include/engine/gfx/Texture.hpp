@@ -27,6 +27,9 @@ class Texture : public GpuResource
 	void AllocateSrvHandle(
 		DXGI_FORMAT srvFormat = DXGI_FORMAT_UNKNOWN, D3D12_SHADER_RESOURCE_VIEW_DESC* srvDescriptor = nullptr);
 
+	// Elibereaza vederile din heap-uri; apelantul garanteaza ca GPU-ul nu le mai foloseste
+	virtual void ReleaseDescriptors();
+
 	INLINE const engine::gfx::DescriptorHandle& GetSrvHandle() const { return m_SrvHandle; }
 
 protected:
@@ -73,6 +76,7 @@ class ColorTexture : public Texture
 		DXGI_FORMAT uavFormat = DXGI_FORMAT_UNKNOWN, D3D12_UNORDERED_ACCESS_VIEW_DESC* uavDescriptor = nullptr);
 	void AllocateRtvHandle(
 		DXGI_FORMAT rtvFormat = DXGI_FORMAT_UNKNOWN, D3D12_RENDER_TARGET_VIEW_DESC* rtvDescriptor = nullptr);
+	void ReleaseDescriptors() override;
 
 	INLINE const engine::gfx::DescriptorHandle& GetRtvHandle(size_t index) const { return m_RtvHandle[index]; };
 	INLINE const engine::gfx::DescriptorHandle& GetRtvHandle() const { return m_RtvHandle[0]; };
@@ -100,6 +104,7 @@ class DepthTexture : public Texture
 
 	void AllocateDsvHandle(
 		DXGI_FORMAT dsvFormat = DXGI_FORMAT_UNKNOWN, D3D12_DEPTH_STENCIL_VIEW_DESC* dsvDescriptor = nullptr);
+	void ReleaseDescriptors() override;
 
 	INLINE const engine::gfx::DescriptorHandle& GetDsvHandle() const { return m_DsvHandle; }
 	INLINE const UINT8& GetClearStencil() const { return m_clearStencil; }
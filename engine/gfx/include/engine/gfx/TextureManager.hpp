@@ -3,6 +3,8 @@
 #include "Context.hpp"
 #include "Texture.hpp"
 
+#include <string_view>
+
 namespace engine::gfx
 {
 
@@ -14,8 +16,19 @@ class TextureManager
 	void CreateSRVHandles();
 	void LoadTexturesFormFiles(ID3D12Device10* pDevice, ID3D12CommandQueue* pCommandQueue);
 	void SwapNonPixelShaderTextures(GraphicsContext& context);
+	// Pentru ResidencyManager, in fiecare cadru in care texturile pot fi citite
+	void MarkUsed();
+
+	// Creeaza o textura din date generate pe CPU (ex: harta de splat a terenului) si ii aloca SRV-ul
+	void CreateTextureFromMemory(
+		ID3D12Device10* pDevice,
+		ID3D12CommandQueue* pCommandQueue,
+		std::wstring name,
+		const D3D12_RESOURCE_DESC& resourceDesc,
+		const std::vector<D3D12_SUBRESOURCE_DATA>& subresources,
+		bool isNonPixelShaderResource = false);
 
-	const ColorTexture& GetTexture(std::wstring textureName) const;
+	const ColorTexture& GetTexture(std::wstring_view textureName) const;
 
 private:
 	std::vector<ColorTexture::Ptr> m_textures;
@@ -14,7 +14,7 @@ class TextureRenderer : public GeometryRenderer
 
 	void Render(engine::gfx::rasterization::RenderLayer::Value renderLayer) const override;
 	void BuildAccelerationStructures() override;
-	void FrustumCulling(const CameraController& cameraController) override;
+	void FrustumCulling(const MultiViewCuller& culler) override;
 	void Update(float deltaTime) override;
 
 	void SetTextureSRVHandle(const engine::gfx::DescriptorHandle& textureSRVHandle);
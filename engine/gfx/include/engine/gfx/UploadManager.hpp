@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CommandContextPool.hpp"
+#include "GPUBuffers.hpp"
+#include "UploadRingAllocator.hpp"
+
+#include <deque>
+
+namespace engine::gfx
+{
+
+class CommandContext;
+
+// Valoarea de fence a submit-ului pe coada de copiere care contine o copiere
+using UploadTicket = UINT64;
+
+struct UploadStatistics
+{
+	UINT64 copyCount = 0;
+	UINT64 uploadedBytes = 0;
+	UINT64 submitCount = 0;
+	// De cate ori CPU-ul a asteptat GPU-ul pentru a elibera spatiu in ring
+	UINT64 ringWaitCount = 0;
+	// Copieri mai mari decat ring-ul, facute prin buffere de upload separate
+	UINT64 dedicatedBufferCount = 0;
+};
+
+////////////////////////////////////////////////
+// Copieri in buffere din default heap, prin coada de copiere
+// - datele se scriu intr-un buffer de upload persistent mapat (ring); copierile se aduna intr-un singur command
+//   list pana la Submit, care le trimite pe coada de copiere si face coada directa sa astepte fence-ul pe GPU
+// - spatiul din ring se elibereaza cand fence-ul submit-ului care il foloseste e atins; doar cand ring-ul e plin
+//   CPU-ul asteapta cel mai vechi submit
+// - bufferele destinatie raman in D3D12_RESOURCE_STATE_COMMON: coada de copiere le promoveaza implicit in
+//   COPY_DEST, iar dupa executie revin in COMMON si se promoveaza implicit la prima citire pe coada directa
+///////////////////////////////////////////////
+class UploadManager
+{
+public:
+	UploadManager() = default;
+	~UploadManager();
+
+	void Create(ID3D12CommandQueue* directQueue, UINT64 ringSize);
+
+	// Copierea pleaca la urmatorul Submit; datele sunt deja copiate la intoarcere
+	UploadTicket UploadBuffer(GpuResource& dest, UINT64 destOffset, const void* pData, UINT64 dataSize);
+
+	// Nimic de facut daca nu s-a adunat nicio copiere de la ultimul Submit
+	void Submit();
+
+	bool IsComplete(UploadTicket ticket);
+	// Trimite copierea daca nu a plecat inca si asteapta terminarea ei pe CPU
+	void Wait(UploadTicket ticket);
+	void WaitForIdle();
+
+	inline const UploadStatistics& GetStatistics() const { return m_statistics; }
+
+private:
+	struct DedicatedUpload
+	{
+		UINT64 fenceValue;
+		Microsoft::WRL::ComPtr<ID3D12Resource> pResource;
+	};
+
+	CommandContext& GetBatch();
+	void WaitForFence(UINT64 fenceValue);
+	// Elibereaza spatiul din ring si bufferele separate ale submit-urilor terminate
+	void Reclaim();
+
+	Microsoft::WRL::ComPtr<ID3D12CommandQueue> pCopyQueue;
+	ID3D12CommandQueue* pDirectQueue = nullptr;
+	Microsoft::WRL::ComPtr<ID3D12Fence> pFence;
+	// Ultima valoare semnalata pe coada de copiere
+	UINT64 m_fenceValue = 0;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> pRingBuffer;
+	uint8_t* m_pMappedRing = nullptr;
+	UploadRingAllocator m_ring;
+
+	CommandContextPool<CommandContext> m_batches;
+	// Command list-ul in care se adauga copierile pana la Submit
+	CommandContext* m_pBatch = nullptr;
+
+	std::deque<DedicatedUpload> m_dedicatedUploads;
+
+	UploadStatistics m_statistics;
+};
+
+}  // namespace engine::gfx
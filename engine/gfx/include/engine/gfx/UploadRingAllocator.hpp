@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+namespace engine::gfx
+{
+
+////////////////////////////////////////////////
+// Alocator circular pentru un buffer de upload persistent (si regiunea tranzitorie a unui heap de descriptori)
+// - alocarile se fac in ordine; o alocare care nu mai incape pana la capatul bufferului sare la inceput (restul
+//   capatului se pierde pana la eliberare)
+// - Retire leaga tot ce s-a alocat de la Retire-ul anterior de fence-ul submit-ului care il foloseste; Reclaim
+//   elibereaza, in ordine, submit-urile pe care GPU-ul le-a terminat
+///////////////////////////////////////////////
+class UploadRingAllocator
+{
+public:
+	static constexpr uint64_t InvalidOffset = UINT64_MAX;
+
+	void Create(uint64_t capacity);
+
+	// alignment putere a lui 2; InvalidOffset daca nu e loc pana la eliberarea unui submit
+	uint64_t Allocate(uint64_t size, uint64_t alignment);
+
+	void Retire(uint64_t fenceValue);
+	void Reclaim(uint64_t completedFenceValue);
+
+	// Fence-ul celui mai vechi submit inca nefinalizat (0 daca nu e niciunul)
+	inline uint64_t GetOldestFenceValue() const { return m_retired.empty() ? 0 : m_retired.front().fenceValue; }
+
+	inline uint64_t GetCapacity() const { return m_capacity; }
+	inline uint64_t GetUsedSize() const { return m_usedSize; }
+	inline uint64_t GetPendingSize() const { return m_pendingSize; }
+	inline bool HasRetiredSpace() const { return !m_retired.empty(); }
+
+private:
+	struct RetiredRange
+	{
+		uint64_t fenceValue;
+		uint64_t size;
+	};
+
+	uint64_t m_capacity = 0;
+	uint64_t m_head = 0;
+	// Octeti ocupati, inclusiv capetele sarite; ocupatul incepe la (m_head - m_usedSize) modulo capacitate
+	uint64_t m_usedSize = 0;
+	// Octetii alocati de la ultimul Retire
+	uint64_t m_pendingSize = 0;
+
+	std::deque<RetiredRange> m_retired;
+};
+
+}  // namespace engine::gfx
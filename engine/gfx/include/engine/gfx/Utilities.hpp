@@ -1,5 +1,6 @@
 #pragma once
 
+#include "DescriptorAllocator.hpp"
 #include "PipelineState.hpp"
 #include "HlslUtils.h"
 #include <d3d12.h>
@@ -8,8 +9,10 @@
 #include <dxgi1_6.h>
 
 #include "Mesh.hpp"
+#include "RenderLayer.hpp"
 
 #include <array>
+#include <vector>
 
 #define D3D12_GPU_VIRTUAL_ADDRESS_NULL ((D3D12_GPU_VIRTUAL_ADDRESS)0)
 #define D3D12_GPU_VIRTUAL_ADDRESS_UNKNOWN ((D3D12_GPU_VIRTUAL_ADDRESS)-1)
@@ -40,21 +43,6 @@ static const wchar_t* Miss_ShadowShader = L"ShadowMiss";
 ////////////////////////////////////////////////////////////////////////////////
 // Chestii ajutatoare rasterizare
 ////////////////////////////////////////////////////////////////////////////////
-namespace rasterization
-{
-namespace RenderLayer
-{
-enum Value : int
-{
-	Base = 0,
-	CubeMap = 1,
-	ShadowMap = 2,
-	DebugShadowMap = 3,
-	OcclusionQuery = 4
-};
-}
-}  // namespace rasterization
-
 namespace RSBinding
 {
 namespace DefaultRSBindings
@@ -67,6 +55,13 @@ enum Value : int
 	StaticPixelTextures,
 	StaticNonPixelTextures,
 	DynamicTextures,
+	TerrainSplatMap,
+	TerrainTessellationScale,
+	InstanceData,
+	InstanceConstants,
+	ObjectData,
+	MaterialData,
+	DrawConstants,
 	Count
 };
 }
@@ -151,6 +146,8 @@ class DescriptorHandle
 };
 
 
+// Regiunea persistenta (Alloc / Free) e la inceputul heap-ului, urmata de cea tranzitorie (AllocTransient), vezi
+// DescriptorAllocator
 class DescriptorHeap
 {
 public:
@@ -158,15 +155,30 @@ class DescriptorHeap
 	~DescriptorHeap(void) { Destroy(); }
 
 	void Create(
-		ID3D12Device10* pDevice, const std::wstring& DebugHeapName, D3D12_DESCRIPTOR_HEAP_TYPE Type, uint32_t MaxCount);
+		ID3D12Device10* pDevice,
+		const std::wstring& DebugHeapName,
+		D3D12_DESCRIPTOR_HEAP_TYPE Type,
+		uint32_t PersistentCount,
+		uint32_t TransientCount = 0);
 	void Destroy(void) { m_Heap = nullptr; }
 
-	bool HasAvailableSpace(uint32_t Count) const { return Count <= m_NumFreeDescriptors; }
+	bool HasAvailableSpace(uint32_t Count) const { return Count <= m_Allocator.GetLargestFreeRange(); }
 	DescriptorHandle Alloc(uint32_t Count = 1);
+	// Apelantul garanteaza ca GPU-ul nu mai citeste descriptorii
+	void Free(const DescriptorHandle& DHandle, uint32_t Count = 1);
+
+	// Tabel valabil pana la terminarea submit-ului cu fence-ul dat la urmatorul RetireTransient
+	DescriptorHandle AllocTransient(uint32_t Count);
+	// Copiaza descriptorii (din heap-uri CPU) intr-un tabel tranzitoriu; copierile se fac toate odata, cu un singur
+	// CopyDescriptors, la FlushStagedCopies, inainte de trimiterea listelor care folosesc tabelele
+	DescriptorHandle StageTable(const D3D12_CPU_DESCRIPTOR_HANDLE* pSources, uint32_t Count);
+	void FlushStagedCopies(ID3D12Device10* pDevice);
+	void RetireTransient(uint64_t FenceValue) { m_Allocator.RetireTransient(FenceValue); }
+	void ReclaimTransient(uint64_t CompletedFenceValue) { m_Allocator.ReclaimTransient(CompletedFenceValue); }
 
 	DescriptorHandle operator[](uint32_t arrayIdx) const { return m_FirstHandle + arrayIdx * m_DescriptorSize; }
 
-	uint32_t GetOffsetOfHandle(const DescriptorHandle& DHandle)
+	uint32_t GetOffsetOfHandle(const DescriptorHandle& DHandle) const
 	{
 		return (uint32_t)(DHandle.GetCpuPtr() - m_FirstHandle.GetCpuPtr()) / m_DescriptorSize;
 	}
@@ -179,13 +191,20 @@ class DescriptorHeap
 
 	const DescriptorHandle& GetFirstDescriptorHandle() const { return m_FirstHandle; }
 
+	const DescriptorAllocator& GetAllocator() const { return m_Allocator; }
+
 private:
 	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_Heap;
 	D3D12_DESCRIPTOR_HEAP_DESC m_HeapDesc = {};
 	uint32_t m_DescriptorSize = 0;
-	uint32_t m_NumFreeDescriptors = 0;
 	DescriptorHandle m_FirstHandle;
-	DescriptorHandle m_NextFreeHandle;
+
+	DescriptorAllocator m_Allocator;
+
+	// Copierile adunate de StageTable: cate un interval destinatie pe tabel, cate o sursa pe descriptor
+	std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> m_StagedDestinations;
+	std::vector<UINT> m_StagedDestinationSizes;
+	std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> m_StagedSources;
 };
 
 
@@ -226,6 +245,37 @@ struct DX_TERRAIN_DESCRIPTOR
 	int chunkKernelSize;
 	int chunkCountPerSide;
 
+	// Rezolutia hartii de splat (putere a lui 2)
+	uint32_t splatMapResolution = 512;
+
+	// Numarul de celule pe latura ocluderului grosier folosit la occlusion culling
+	int occluderCellsPerSide = 64;
+
+	// PVS precalculat pentru chunk-urile de teren si apa (vezi TerrainPVS)
+	struct DX_PVS_PROPERTIES
+	{
+		bool enabled = true;
+		int cellsPerSide = 16;
+		int viewpointsPerSide = 3;
+		int heightLevels = 4;
+		float minCameraHeightAboveTerrain = 2.f;
+		// Peste aceasta inaltime camera vede tot si PVS-ul nu se mai foloseste
+		float maxCameraHeight = 120.f;
+		float heightMargin = 1.f;
+		bool dilateNeighbours = true;
+	} pvsProperties;
+
+	// Scalarea factorului de teselare dupa rugozitatea fiecarui patch
+	struct DX_TESSELLATION_PROPERTIES
+	{
+		// Deviatia fata de patch-ul biliniar de la care se foloseste teselarea maxima
+		float fullTessellationDeviation = 0.25f;
+		// Scalarea minima, pentru zonele plate
+		float minScale = 0.1f;
+		// Numarul de esantioane pe latura unui patch la masurare
+		int sampleCount = 4;
+	} tessellationProperties;
+
 	// Proprietati fractal noise
 	struct DX_SIMPLEX_PROPERTIES
 	{
@@ -255,6 +305,11 @@ struct DX_WATER_DESCRIPTOR
 	int chunkKernelSize = 0;
 	int chunkCountPerSide = 0;
 
+	// Grila proiectata din camera in locul grilei uniforme pe chunk-uri (doar rasterizare)
+	bool useProjectedGrid = false;
+	UINT projectedGridColumns = 128;
+	UINT projectedGridRows = 128;
+
 	std::array<WaveProperties, WAVE_PROPERTIES_COUNT> waveProperties;
 };
 struct DX_SKYBOX_DESCRIPTOR
@@ -282,6 +337,10 @@ struct DX_OBJECTS_RENDERER_DESCRIPTOR
 {
 	std::vector<DX_OBJECT_DESCRIPTOR> objectDescriptors;
 
+	// Cubul lumii si adancimea maxima pentru loose octree-ul obiectelor
+	float spatialIndexHalfSize = 512.f;
+	UINT spatialIndexMaxDepth = 6;
+
 	GraphicsPSO::Ptr basePSO;
 	D3D12_PRIMITIVE_TOPOLOGY baseToplogy;
 
@@ -292,6 +351,11 @@ struct DX_OBJECTS_RENDERER_DESCRIPTOR
 	D3D12_PRIMITIVE_TOPOLOGY shadowTopology;
 
 	GraphicsPSO::Ptr debugShadowPSO;
+
+	// PSO-urile folosite cand obiectele se deseneaza instantiat (Settings UseInstancing)
+	GraphicsPSO::Ptr baseInstancedPSO;
+	GraphicsPSO::Ptr dynamicCubeMapInstancedPSO;
+	GraphicsPSO::Ptr shadowInstancedPSO;
 };
 }  // namespace render_descriptors
 
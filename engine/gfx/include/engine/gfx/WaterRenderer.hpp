@@ -2,6 +2,7 @@
 
 #include "GeometryRenderer.hpp"
 #include "Object.hpp"
+#include "ProjectedGrid.hpp"
 
 namespace engine::gfx
 {
@@ -15,7 +16,7 @@ class WaterRenderer : public GeometryRenderer, public Object
 
 	void Render(engine::gfx::rasterization::RenderLayer::Value renderLayer) const override;
 	void BuildAccelerationStructures() override;
-	void FrustumCulling(const CameraController& cameraController) override;
+	void FrustumCulling(const MultiViewCuller& culler) override;
 	void Update(float delatTime) override;
 
 	inline const WaveProperties& GetWaveParameters(int index) const { return m_waveProperties[index]; }
@@ -23,6 +24,9 @@ class WaterRenderer : public GeometryRenderer, public Object
 	inline const engine::math::Vector3& GetCubeMapCenter() const { return m_cubeMapCenter; }
 	inline void SetCubeMapCenter(engine::math::Vector3 toSet) { m_cubeMapCenter = toSet; };
 
+	// Gol pentru grila proiectata
+	std::vector<engine::math::AABB> GetChunkBoundingBoxes() const;
+
 	~WaterRenderer();
 
 private:
@@ -30,10 +34,22 @@ class WaterRenderer : public GeometryRenderer, public Object
 	WaterRenderer(const engine::gfx::render_descriptors::DX_OBJECT_DESCRIPTOR&);
 
 	void LoadGeometry(DescriptorVariant descriptor) override;
+	void LoadProjectedGrid(const engine::gfx::render_descriptors::DX_WATER_DESCRIPTOR& waterDesc);
 
 	std::array<WaveProperties, WAVE_PROPERTIES_COUNT> m_waveProperties;
 
 	std::vector<Chunk> m_chunks;
+	std::vector<UINT> m_chunkDrawOrder;
+	ViewDrawRanges m_drawRanges;
+
+	// Grila proiectata - vertecsii se regenereaza pe CPU cand se misca camera
+	ProjectedGrid::Ptr m_projectedGrid;
+	UploadRingBuffer<Mesh::Vertex> m_projectedGridVertices;
+	std::vector<Mesh::Vertex> m_projectedGridStaging;
+	std::array<bool, engine::core::Settings::GetFrameResourcesCount()> m_isProjectedGridVisible = {};
+	float m_width;
+	float m_length;
+
 	std::vector<D3D12_RAYTRACING_AABB> m_AABBs;
 	GpuResource m_AABBsResource;
 
@@ -33,10 +33,11 @@ void BottomLevelAccelerationStructure::Build(
 		L"ScratchResource");
 
 	{
-		m_UsageState = D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE;
-
 		GpuResource::AllocateUAVBuffer(
-			bottomLevelPrebuildInfo.ResultDataMaxSizeInBytes, *this, m_UsageState, L"BottomLevelAccelerationStructure");
+			bottomLevelPrebuildInfo.ResultDataMaxSizeInBytes,
+			*this,
+			D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE,
+			L"BottomLevelAccelerationStructure");
 
 		m_GpuVirtualAddress = m_pResource->GetGPUVirtualAddress();
 	}
@@ -47,8 +48,8 @@ void BottomLevelAccelerationStructure::Build(
 	graphicsContext.BuildRaytracingAccelerationStructure(&bottomLevelBuildDesc);
 	graphicsContext.InsertUAVBarrier(*this, true);
 
-	GraphicsResources::GetContextManager().Flush(true);
-	GraphicsResources::GetContextManager().GetGraphicsContext().Reset();
+	// Build-ul pleaca cu urmatorul Flush / SwapContext; bufferul temporar traieste pana il termina GPU-ul
+	buffers.scratch.DestroyDeferred();
 }
 
 void TopLevelAccelerationStructure::Build(
@@ -76,10 +77,11 @@ void TopLevelAccelerationStructure::Build(
 		topLevelPrebuildInfo.ScratchDataSizeInBytes, buffers.scratch, D3D12_RESOURCE_STATE_COMMON, L"ScratchBuffer");
 
 	{
-		m_UsageState = D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE;
-
 		GpuResource::AllocateUAVBuffer(
-			topLevelPrebuildInfo.ResultDataMaxSizeInBytes, *this, m_UsageState, L"TopLevelAccelerationStructure");
+			topLevelPrebuildInfo.ResultDataMaxSizeInBytes,
+			*this,
+			D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE,
+			L"TopLevelAccelerationStructure");
 
 		m_GpuVirtualAddress = m_pResource->GetGPUVirtualAddress();
 	}
@@ -97,8 +99,8 @@ void TopLevelAccelerationStructure::Build(
 	graphicsContext.BuildRaytracingAccelerationStructure(&topLevelBuildDesc);
 	graphicsContext.InsertUAVBarrier(*this, true);
 
-	GraphicsResources::GetContextManager().Flush(true);
-	GraphicsResources::GetContextManager().GetGraphicsContext().Reset();
+	buffers.scratch.DestroyDeferred();
+	buffers.instanceDesc.DestroyDeferred();
 }
 
 void TopLevelAccelerationStructure::CreateSRV()
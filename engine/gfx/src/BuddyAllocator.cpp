@@ -0,0 +1,122 @@
+#include "BuddyAllocator.hpp"
+
+#include <cassert>
+
+namespace engine::gfx
+{
+
+void BuddyAllocator::Create(uint64_t capacity, uint64_t minBlockSize)
+{
+	assert(minBlockSize != 0 && (minBlockSize & (minBlockSize - 1)) == 0);
+	assert(capacity >= minBlockSize && (capacity & (capacity - 1)) == 0);
+
+	m_capacity = capacity;
+	m_minBlockSize = minBlockSize;
+	m_usedSize = 0;
+
+	uint32_t orderCount = 1;
+	while ((minBlockSize << (orderCount - 1)) < capacity)
+	{
+		orderCount++;
+	}
+
+	m_freeBlocks.assign(orderCount, {});
+	m_freeBlocks.back().insert(0);
+	m_allocations.clear();
+}
+
+uint64_t BuddyAllocator::Allocate(uint64_t size, uint64_t alignment)
+{
+	assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+	if (size == 0)
+		return InvalidOffset;
+
+	// Blocurile sunt aliniate la marimea lor, deci alinierea se obtine cerand un bloc cel putin la fel de mare
+	const uint64_t requiredSize = size > alignment ? size : alignment;
+
+	uint32_t order = 0;
+	while ((m_minBlockSize << order) < requiredSize)
+	{
+		if (++order >= m_freeBlocks.size())
+			return InvalidOffset;
+	}
+
+	uint32_t freeOrder = order;
+	while (freeOrder < m_freeBlocks.size() && m_freeBlocks[freeOrder].empty())
+	{
+		freeOrder++;
+	}
+
+	if (freeOrder == m_freeBlocks.size())
+		return InvalidOffset;
+
+	const uint64_t offset = *m_freeBlocks[freeOrder].begin();
+	m_freeBlocks[freeOrder].erase(m_freeBlocks[freeOrder].begin());
+
+	// Blocul mai mare se injumatateste; jumatatile de sus raman libere
+	while (freeOrder > order)
+	{
+		freeOrder--;
+		m_freeBlocks[freeOrder].insert(offset + (m_minBlockSize << freeOrder));
+	}
+
+	m_allocations.emplace(offset, order);
+	m_usedSize += m_minBlockSize << order;
+
+	return offset;
+}
+
+void BuddyAllocator::Free(uint64_t offset)
+{
+	const auto it = m_allocations.find(offset);
+	assert(it != m_allocations.end());
+
+	uint32_t order = it->second;
+	m_allocations.erase(it);
+	m_usedSize -= m_minBlockSize << order;
+
+	while (order + 1 < m_freeBlocks.size())
+	{
+		const uint64_t buddy = offset ^ (m_minBlockSize << order);
+		if (m_freeBlocks[order].erase(buddy) == 0)
+			break;
+
+		offset = offset < buddy ? offset : buddy;
+		order++;
+	}
+
+	m_freeBlocks[order].insert(offset);
+}
+
+uint64_t BuddyAllocator::GetBlockSize(uint64_t offset) const
+{
+	const auto it = m_allocations.find(offset);
+	assert(it != m_allocations.end());
+
+	return m_minBlockSize << it->second;
+}
+
+void BuddyAllocator::GetAllocationOffsets(std::vector<uint64_t>& offsets) const
+{
+	offsets.clear();
+	offsets.reserve(m_allocations.size());
+
+	for (const auto& [offset, order] : m_allocations)
+	{
+		offsets.push_back(offset);
+	}
+}
+
+uint64_t BuddyAllocator::GetLargestFreeBlockSize() const
+{
+	for (size_t order = m_freeBlocks.size(); order > 0; order--)
+	{
+		if (!m_freeBlocks[order - 1].empty())
+			return m_minBlockSize << (order - 1);
+	}
+
+	return 0;
+}
+
+}  // namespace engine::gfx
@@ -0,0 +1,35 @@
+#include "ChunkOrdering.hpp"
+
+#include <utility>
+
+namespace engine::gfx
+{
+
+void ChunkOrdering::HilbertCurveToGrid(const int side, int d, int& row, int& column)
+{
+	row = column = 0;
+
+	for (int s = 1; s < side; s *= 2)
+	{
+		const int rx = 1 & (d / 2);
+		const int ry = 1 & (d ^ rx);
+
+		// Rotatia cadranului
+		if (ry == 0)
+		{
+			if (rx == 1)
+			{
+				row = s - 1 - row;
+				column = s - 1 - column;
+			}
+
+			std::swap(row, column);
+		}
+
+		row += s * rx;
+		column += s * ry;
+		d /= 4;
+	}
+}
+
+}  // namespace engine::gfx
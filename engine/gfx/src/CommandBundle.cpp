@@ -0,0 +1,62 @@
+#include "CommandBundle.hpp"
+
+#include "GraphicsResources.hpp"
+
+namespace engine::gfx
+{
+
+CommandBundle::Ptr CommandBundle::CreateCommandBundle()
+{
+	CommandBundle::Ptr commandBundle = Ptr(new CommandBundle());
+
+	for (size_t i = 0; i < commandBundle->m_bundles.size(); i++)
+	{
+		commandBundle->m_bundles[i] = std::make_unique<GraphicsContext>();
+		commandBundle->m_bundles[i]->Create(D3D12_COMMAND_LIST_TYPE_BUNDLE);
+
+		std::wstring name = L"Bundle_" + std::to_wstring(i);
+		commandBundle->m_bundles[i]->GetCommandList()->SetName(name.c_str());
+	}
+
+	commandBundle->m_cache.Create((uint32_t)commandBundle->m_bundles.size());
+
+	return commandBundle;
+}
+
+void CommandBundle::Execute(
+	GraphicsContext& graphicsContext, const RootSignature& rootSignature, const RenderQueue<DrawPacket>& queue)
+{
+	// Slotul cadrului curent nu mai e folosit de GPU: contextul de frame a asteptat terminarea lui
+	const UINT slot = GraphicsResources::GetContextManager().GetFrameIndex();
+	GraphicsContext& bundle = *m_bundles[slot];
+
+	CommandFingerprint fingerprint;
+	fingerprint.Add(rootSignature.GetID3D12RootSignature());
+	AddDrawPackets(fingerprint, queue);
+
+	m_statistics = {};
+
+	if (m_cache.NeedsRecording(slot, fingerprint.Get()))
+	{
+		m_timer.StartClock();
+
+		bundle.Reset();
+		bundle.SetRootSignature(rootSignature);
+		ReplayDrawPackets(bundle, queue);
+		bundle.Close();
+
+		m_recordingTimes[slot] = m_timer.GetTimeSinceStart();
+		m_cache.MarkRecorded(slot, fingerprint.Get());
+
+		m_statistics.isRecorded = true;
+		m_statistics.recordingTime = m_recordingTimes[slot];
+	}
+	else
+	{
+		m_statistics.savedTime = m_recordingTimes[slot];
+	}
+
+	graphicsContext.ExecuteBundle(bundle);
+}
+
+}  // namespace engine::gfx
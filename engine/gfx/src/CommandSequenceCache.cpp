@@ -0,0 +1,46 @@
+#include "CommandSequenceCache.hpp"
+
+#include <cassert>
+
+namespace engine::gfx
+{
+
+void CommandFingerprint::Add(const void* data, size_t size)
+{
+	constexpr uint64_t prime = 1099511628211ull;
+
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; i++)
+	{
+		m_hash = (m_hash ^ bytes[i]) * prime;
+	}
+}
+
+void CommandSequenceCache::Create(uint32_t slotCount)
+{
+	m_slots.assign(slotCount, {false, 0});
+}
+
+bool CommandSequenceCache::NeedsRecording(uint32_t slot, uint64_t fingerprint) const
+{
+	assert(slot < m_slots.size());
+
+	return !m_slots[slot].isRecorded || m_slots[slot].fingerprint != fingerprint;
+}
+
+void CommandSequenceCache::MarkRecorded(uint32_t slot, uint64_t fingerprint)
+{
+	assert(slot < m_slots.size());
+
+	m_slots[slot] = {true, fingerprint};
+}
+
+void CommandSequenceCache::Invalidate()
+{
+	for (Slot& slot : m_slots)
+	{
+		slot.isRecorded = false;
+	}
+}
+
+}  // namespace engine::gfx
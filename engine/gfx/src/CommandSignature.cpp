@@ -0,0 +1,114 @@
+#include "CommandSignature.hpp"
+
+#include "IndirectDrawBuilder.hpp"
+#include "engine/core/DxgiInfoManager.hpp"
+#include "engine/core/Exceptions.hpp"
+#include "engine/core/GraphicsThrowMacros.hpp"
+
+#include <cstddef>
+
+namespace engine::gfx
+{
+
+static_assert(
+	sizeof(IndirectDrawIndexedArguments) == sizeof(D3D12_DRAW_INDEXED_ARGUMENTS),
+	"IndirectDrawIndexedArguments trebuie sa aiba layout-ul din D3D12");
+static_assert(
+	offsetof(IndirectObjectDrawArguments, draw) == sizeof(D3D12_GPU_VIRTUAL_ADDRESS),
+	"Draw-ul trebuie sa urmeze imediat dupa adresa root CBV-ului");
+static_assert(
+	offsetof(IndirectObjectDrawArguments, draw) == 2 * sizeof(uint32_t),
+	"Draw-ul trebuie sa urmeze imediat dupa root constants");
+
+CommandSignature::Ptr CommandSignature::CreateDrawIndexed(ID3D12Device* pDevice)
+{
+	D3D12_INDIRECT_ARGUMENT_DESC argument = {};
+	argument.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+
+	CommandSignature::Ptr signature = Ptr(new CommandSignature());
+	signature->Create(pDevice, &argument, 1, IndirectDrawBuilder<IndirectDrawIndexedArguments>::ArgumentStride, nullptr);
+
+	return signature;
+}
+
+CommandSignature::Ptr CommandSignature::CreateObjectDraw(
+	ID3D12Device* pDevice, const RootSignature& rootSignature, UINT objectCBRootIndex)
+{
+	D3D12_INDIRECT_ARGUMENT_DESC arguments[2] = {};
+	arguments[0].Type = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT_BUFFER_VIEW;
+	arguments[0].ConstantBufferView.RootParameterIndex = objectCBRootIndex;
+	arguments[1].Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+
+	// Signatura modifica un root argument, deci trebuie creata pentru root signature-ul folosit la desenare
+	CommandSignature::Ptr signature = Ptr(new CommandSignature());
+	signature->Create(
+		pDevice,
+		arguments,
+		_countof(arguments),
+		IndirectDrawBuilder<IndirectObjectDrawArguments>::ArgumentStride,
+		rootSignature.GetID3D12RootSignature());
+
+	return signature;
+}
+
+CommandSignature::Ptr CommandSignature::CreateBindlessObjectDraw(
+	ID3D12Device* pDevice, const RootSignature& rootSignature, UINT drawConstantsRootIndex)
+{
+	D3D12_INDIRECT_ARGUMENT_DESC arguments[2] = {};
+	arguments[0].Type = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT;
+	arguments[0].Constant.RootParameterIndex = drawConstantsRootIndex;
+	arguments[0].Constant.DestOffsetIn32BitValues = 0;
+	arguments[0].Constant.Num32BitValuesToSet = 2;
+	arguments[1].Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+
+	CommandSignature::Ptr signature = Ptr(new CommandSignature());
+	signature->Create(
+		pDevice,
+		arguments,
+		_countof(arguments),
+		IndirectDrawBuilder<IndirectObjectDrawArguments>::ArgumentStride,
+		rootSignature.GetID3D12RootSignature());
+
+	return signature;
+}
+
+void CommandSignature::Create(
+	ID3D12Device* pDevice,
+	const D3D12_INDIRECT_ARGUMENT_DESC* arguments,
+	UINT argumentCount,
+	UINT byteStride,
+	ID3D12RootSignature* pRootSignature)
+{
+	HRESULT hr;
+
+	D3D12_COMMAND_SIGNATURE_DESC desc = {};
+	desc.pArgumentDescs = arguments;
+	desc.NumArgumentDescs = argumentCount;
+	desc.ByteStride = byteStride;
+
+	GFX_THROW_INFO(pDevice->CreateCommandSignature(&desc, pRootSignature, IID_PPV_ARGS(&m_commandSignature)));
+
+	m_byteStride = byteStride;
+
+	for (UINT i = 0; i < argumentCount; i++)
+	{
+		switch (arguments[i].Type)
+		{
+		case D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT:
+			m_rootArgumentMask |= 1ull << arguments[i].Constant.RootParameterIndex;
+			break;
+		case D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT_BUFFER_VIEW:
+			m_rootArgumentMask |= 1ull << arguments[i].ConstantBufferView.RootParameterIndex;
+			break;
+		case D3D12_INDIRECT_ARGUMENT_TYPE_SHADER_RESOURCE_VIEW:
+			m_rootArgumentMask |= 1ull << arguments[i].ShaderResourceView.RootParameterIndex;
+			break;
+		case D3D12_INDIRECT_ARGUMENT_TYPE_UNORDERED_ACCESS_VIEW:
+			m_rootArgumentMask |= 1ull << arguments[i].UnorderedAccessView.RootParameterIndex;
+			break;
+		default: break;
+		}
+	}
+}
+
+}  // namespace engine::gfx
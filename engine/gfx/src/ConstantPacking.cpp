@@ -0,0 +1,222 @@
+#include "ConstantPacking.hpp"
+
+#include <xmmintrin.h>
+
+#include <cstring>
+
+namespace engine::gfx
+{
+
+namespace
+{
+
+constexpr size_t LaneCount = 4;
+
+// Registrul r * 4 + c tine elementul (r, c) al fiecarei matrice din grup, cate una pe lane
+using MatrixLanes = __m128[16];
+
+void LoadLanes(const Float4x4* pMatrices, MatrixLanes& lanes)
+{
+	for (int row = 0; row < 4; row++)
+	{
+		__m128 x0 = _mm_loadu_ps(pMatrices[0].m + row * 4);
+		__m128 x1 = _mm_loadu_ps(pMatrices[1].m + row * 4);
+		__m128 x2 = _mm_loadu_ps(pMatrices[2].m + row * 4);
+		__m128 x3 = _mm_loadu_ps(pMatrices[3].m + row * 4);
+		_MM_TRANSPOSE4_PS(x0, x1, x2, x3);
+
+		lanes[row * 4 + 0] = x0;
+		lanes[row * 4 + 1] = x1;
+		lanes[row * 4 + 2] = x2;
+		lanes[row * 4 + 3] = x3;
+	}
+}
+
+// Cu transpose randul r al fiecarei matrice e coloana r din lanes
+void StoreLanes(const MatrixLanes& lanes, bool transpose, Float4x4* pMatrices)
+{
+	for (int row = 0; row < 4; row++)
+	{
+		__m128 x0 = transpose ? lanes[0 * 4 + row] : lanes[row * 4 + 0];
+		__m128 x1 = transpose ? lanes[1 * 4 + row] : lanes[row * 4 + 1];
+		__m128 x2 = transpose ? lanes[2 * 4 + row] : lanes[row * 4 + 2];
+		__m128 x3 = transpose ? lanes[3 * 4 + row] : lanes[row * 4 + 3];
+		_MM_TRANSPOSE4_PS(x0, x1, x2, x3);
+
+		_mm_storeu_ps(pMatrices[0].m + row * 4, x0);
+		_mm_storeu_ps(pMatrices[1].m + row * 4, x1);
+		_mm_storeu_ps(pMatrices[2].m + row * 4, x2);
+		_mm_storeu_ps(pMatrices[3].m + row * 4, x3);
+	}
+}
+
+inline __m128 Cross2(__m128 a, __m128 b, __m128 c, __m128 d)
+{
+	return _mm_sub_ps(_mm_mul_ps(a, b), _mm_mul_ps(c, d));
+}
+
+// Inversa prin adjuncta: determinantii 2x2 ai primelor doua randuri (s) si ai ultimelor doua (c)
+void InvertLanes(const MatrixLanes& a, MatrixLanes& inverse)
+{
+	const __m128 s0 = Cross2(a[0], a[5], a[4], a[1]);
+	const __m128 s1 = Cross2(a[0], a[6], a[4], a[2]);
+	const __m128 s2 = Cross2(a[0], a[7], a[4], a[3]);
+	const __m128 s3 = Cross2(a[1], a[6], a[5], a[2]);
+	const __m128 s4 = Cross2(a[1], a[7], a[5], a[3]);
+	const __m128 s5 = Cross2(a[2], a[7], a[6], a[3]);
+
+	const __m128 c5 = Cross2(a[10], a[15], a[14], a[11]);
+	const __m128 c4 = Cross2(a[9], a[15], a[13], a[11]);
+	const __m128 c3 = Cross2(a[9], a[14], a[13], a[10]);
+	const __m128 c2 = Cross2(a[8], a[15], a[12], a[11]);
+	const __m128 c1 = Cross2(a[8], a[14], a[12], a[10]);
+	const __m128 c0 = Cross2(a[8], a[13], a[12], a[9]);
+
+	__m128 determinant = _mm_sub_ps(_mm_mul_ps(s0, c5), _mm_mul_ps(s1, c4));
+	determinant = _mm_add_ps(determinant, _mm_mul_ps(s2, c3));
+	determinant = _mm_add_ps(determinant, _mm_mul_ps(s3, c2));
+	determinant = _mm_sub_ps(determinant, _mm_mul_ps(s4, c1));
+	determinant = _mm_add_ps(determinant, _mm_mul_ps(s5, c0));
+
+	const __m128 invDeterminant = _mm_div_ps(_mm_set1_ps(1.f), determinant);
+
+	// x * p - y * q + z * r
+	const auto cofactor = [invDeterminant](__m128 x, __m128 p, __m128 y, __m128 q, __m128 z, __m128 r)
+	{
+		const __m128 sum = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(x, p), _mm_mul_ps(y, q)), _mm_mul_ps(z, r));
+		return _mm_mul_ps(sum, invDeterminant);
+	};
+	const __m128 zero = _mm_setzero_ps();
+
+	inverse[0] = cofactor(a[5], c5, a[6], c4, a[7], c3);
+	inverse[1] = _mm_sub_ps(zero, cofactor(a[1], c5, a[2], c4, a[3], c3));
+	inverse[2] = cofactor(a[13], s5, a[14], s4, a[15], s3);
+	inverse[3] = _mm_sub_ps(zero, cofactor(a[9], s5, a[10], s4, a[11], s3));
+
+	inverse[4] = _mm_sub_ps(zero, cofactor(a[4], c5, a[6], c2, a[7], c1));
+	inverse[5] = cofactor(a[0], c5, a[2], c2, a[3], c1);
+	inverse[6] = _mm_sub_ps(zero, cofactor(a[12], s5, a[14], s2, a[15], s1));
+	inverse[7] = cofactor(a[8], s5, a[10], s2, a[11], s1);
+
+	inverse[8] = cofactor(a[4], c4, a[5], c2, a[7], c0);
+	inverse[9] = _mm_sub_ps(zero, cofactor(a[0], c4, a[1], c2, a[3], c0));
+	inverse[10] = cofactor(a[12], s4, a[13], s2, a[15], s0);
+	inverse[11] = _mm_sub_ps(zero, cofactor(a[8], s4, a[9], s2, a[11], s0));
+
+	inverse[12] = _mm_sub_ps(zero, cofactor(a[4], c3, a[5], c1, a[6], c0));
+	inverse[13] = cofactor(a[0], c3, a[1], c1, a[2], c0);
+	inverse[14] = _mm_sub_ps(zero, cofactor(a[12], s3, a[13], s1, a[14], s0));
+	inverse[15] = cofactor(a[8], s3, a[9], s1, a[10], s0);
+}
+
+// Ultimul grup incomplet trece prin copii locale, completate cu identitate
+template <class Function>
+void ForEachGroup(const Float4x4* pMatrices, size_t count, Function&& function)
+{
+	const size_t fullCount = count - count % LaneCount;
+
+	for (size_t i = 0; i < fullCount; i += LaneCount)
+	{
+		function(pMatrices + i, i, LaneCount);
+	}
+
+	if (fullCount == count)
+		return;
+
+	Float4x4 padded[LaneCount] = {};
+	for (size_t lane = 0; lane < LaneCount; lane++)
+	{
+		if (fullCount + lane < count)
+			padded[lane] = pMatrices[fullCount + lane];
+		else
+			padded[lane].m[0] = padded[lane].m[5] = padded[lane].m[10] = padded[lane].m[15] = 1.f;
+	}
+
+	function(padded, fullCount, count - fullCount);
+}
+
+void StoreGroup(const MatrixLanes& lanes, bool transpose, Float4x4* pDestination, size_t validCount)
+{
+	if (validCount == LaneCount)
+	{
+		StoreLanes(lanes, transpose, pDestination);
+		return;
+	}
+
+	Float4x4 stored[LaneCount];
+	StoreLanes(lanes, transpose, stored);
+	std::memcpy(pDestination, stored, validCount * sizeof(Float4x4));
+}
+
+}  // namespace
+
+void TransposeMatrices(const Float4x4* pMatrices, size_t count, Float4x4* pTransposes)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		__m128 x0 = _mm_loadu_ps(pMatrices[i].m + 0);
+		__m128 x1 = _mm_loadu_ps(pMatrices[i].m + 4);
+		__m128 x2 = _mm_loadu_ps(pMatrices[i].m + 8);
+		__m128 x3 = _mm_loadu_ps(pMatrices[i].m + 12);
+		_MM_TRANSPOSE4_PS(x0, x1, x2, x3);
+
+		_mm_storeu_ps(pTransposes[i].m + 0, x0);
+		_mm_storeu_ps(pTransposes[i].m + 4, x1);
+		_mm_storeu_ps(pTransposes[i].m + 8, x2);
+		_mm_storeu_ps(pTransposes[i].m + 12, x3);
+	}
+}
+
+void InvertMatrices(const Float4x4* pMatrices, size_t count, Float4x4* pInverses, Float4x4* pInverseTransposes)
+{
+	ForEachGroup(
+		pMatrices,
+		count,
+		[pInverses, pInverseTransposes](const Float4x4* pGroup, size_t first, size_t validCount)
+		{
+			MatrixLanes lanes;
+			MatrixLanes inverse;
+
+			LoadLanes(pGroup, lanes);
+			InvertLanes(lanes, inverse);
+
+			if (pInverses)
+				StoreGroup(inverse, false, pInverses + first, validCount);
+			if (pInverseTransposes)
+				StoreGroup(inverse, true, pInverseTransposes + first, validCount);
+		});
+}
+
+void PackObjectRecords(
+	const Float4x4* pTransforms, const Float4x4* pTextureTransforms, size_t count, ObjectRecord* pRecords)
+{
+	ForEachGroup(
+		pTransforms,
+		count,
+		[pRecords](const Float4x4* pGroup, size_t first, size_t validCount)
+		{
+			MatrixLanes lanes;
+			MatrixLanes inverse;
+
+			LoadLanes(pGroup, lanes);
+			InvertLanes(lanes, inverse);
+
+			Float4x4 transposes[LaneCount];
+			Float4x4 inverseTransposes[LaneCount];
+			StoreLanes(lanes, true, transposes);
+			StoreLanes(inverse, true, inverseTransposes);
+
+			for (size_t lane = 0; lane < validCount; lane++)
+			{
+				pRecords[first + lane].worldMatrix = transposes[lane];
+				pRecords[first + lane].invWorldMatrix = inverseTransposes[lane];
+			}
+		});
+
+	for (size_t i = 0; i < count; i++)
+	{
+		TransposeMatrices(pTextureTransforms + i, 1, &pRecords[i].textureTransform);
+	}
+}
+
+}  // namespace engine::gfx
@@ -7,6 +7,14 @@
 namespace engine::gfx
 {
 
+namespace
+{
+
+// Incape geometria incarcata la pornire fara asteptari pe CPU
+constexpr UINT64 UploadRingSize = 64ull * 1024 * 1024;
+
+}  // namespace
+
 void ContextManager::Create()
 {
 	HRESULT hr;
@@ -34,6 +42,123 @@ void ContextManager::Create()
 		m_computeContexts[i] = std::make_unique<ComputeContext>();
 		m_computeContexts[i]->Create(D3D12_COMMAND_LIST_TYPE_COMPUTE);
 	}
+
+	m_queueFenceValue = 0;
+	GFX_THROW_INFO(
+		GraphicsResources::GetDevice()->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&pQueueFence)));
+
+	m_recordingContexts.Create(
+		[this]()
+		{
+			GraphicsContext::Ptr context = std::make_unique<GraphicsContext>();
+			context->Create(D3D12_COMMAND_LIST_TYPE_DIRECT);
+
+			std::wstring name = L"RecordingCommandList_" + std::to_wstring(m_recordingContexts.GetSize());
+			context->GetCommandList()->SetName(name.c_str());
+
+			return context;
+		});
+
+	m_uploadManager.Create(pCommandQueue.Get(), UploadRingSize);
+}
+
+GraphicsContext& ContextManager::AcquireRecordingContext()
+{
+	GraphicsContext& context = m_recordingContexts.Acquire(pQueueFence->GetCompletedValue());
+	context.Reset();
+
+	m_pendingRecordingContexts.push_back(&context);
+
+	return context;
+}
+
+void ContextManager::SubmitRecordingContexts()
+{
+	if (m_pendingRecordingContexts.empty())
+		return;
+
+	engine::core::FrameVector<ID3D12CommandList*> commandLists;
+	engine::core::FrameVector<GraphicsContext*> pooledContexts;
+	commandLists.reserve(m_pendingRecordingContexts.size());
+	pooledContexts.reserve(m_pendingRecordingContexts.size());
+
+	// Starile se rezolva in ordinea in care listele ajung pe coada
+	for (GraphicsContext* context : m_pendingRecordingContexts)
+	{
+		ResolveResourceStates(*context, commandLists, pooledContexts);
+		context->Close();
+		m_frameStateFilterStatistics += context->GetStateFilterStatistics();
+
+		commandLists.push_back(context->GetCommandList());
+		pooledContexts.push_back(context);
+	}
+
+	m_pendingRecordingContexts.clear();
+
+	ExecutePooledContexts(commandLists, pooledContexts);
+}
+
+void ContextManager::SubmitFrameContext(GraphicsContext& context, bool waitForCompletition)
+{
+	engine::core::FrameVector<ID3D12CommandList*> commandLists;
+	engine::core::FrameVector<GraphicsContext*> pooledContexts;
+
+	ResolveResourceStates(context, commandLists, pooledContexts);
+	ExecutePooledContexts(commandLists, pooledContexts);
+
+	// Contextul se reseteaza inainte sa fie inregistrat din nou, deci statisticile lui se numara o singura data
+	m_frameStateFilterStatistics += context.GetStateFilterStatistics();
+
+	if (waitForCompletition)
+		context.End(pCommandQueue.Get());
+	else
+		context.Finish(pCommandQueue.Get());
+}
+
+void ContextManager::ResolveResourceStates(
+	CommandContext& context,
+	engine::core::FrameVector<ID3D12CommandList*>& commandLists,
+	engine::core::FrameVector<GraphicsContext*>& pooledContexts)
+{
+	context.m_stateTracker.EndPendingTransitions();
+	context.QueueTrackedBarriers();
+	context.FlushResourceBarriers();
+
+	engine::core::FrameVector<StateTransition> fixups;
+	context.m_stateTracker.Resolve(fixups);
+
+	if (fixups.empty())
+		return;
+
+	GraphicsContext& fixupContext = m_recordingContexts.Acquire(pQueueFence->GetCompletedValue());
+	fixupContext.Reset();
+
+	for (const StateTransition& transition : fixups)
+	{
+		fixupContext.QueueTransition(transition);
+	}
+
+	fixupContext.FlushResourceBarriers();
+	fixupContext.Close();
+
+	commandLists.push_back(fixupContext.GetCommandList());
+	pooledContexts.push_back(&fixupContext);
+}
+
+void ContextManager::ExecutePooledContexts(
+	const engine::core::FrameVector<ID3D12CommandList*>& commandLists,
+	const engine::core::FrameVector<GraphicsContext*>& pooledContexts)
+{
+	if (commandLists.empty())
+		return;
+
+	pCommandQueue->ExecuteCommandLists((UINT)commandLists.size(), commandLists.data());
+	pCommandQueue->Signal(pQueueFence.Get(), ++m_queueFenceValue);
+
+	for (GraphicsContext* context : pooledContexts)
+	{
+		m_recordingContexts.Release(*context, m_queueFenceValue);
+	}
 }
 
 void CommandContext::Create(D3D12_COMMAND_LIST_TYPE type)
@@ -46,6 +171,13 @@ void CommandContext::Create(D3D12_COMMAND_LIST_TYPE type)
 	GFX_THROW_INFO(GraphicsResources::GetDevice()->CreateCommandList(
 		0, type, pCommandAllocator.Get(), nullptr, IID_PPV_ARGS(&pCommandList)));
 	pCommandList->Close();
+
+	m_commandFilter.SetCommandList(pCommandList.Get());
+
+	// Bundle-urile nu se trimit pe coada, deci nu au fence
+	if (type == D3D12_COMMAND_LIST_TYPE_BUNDLE)
+		return;
+
 	GFX_THROW_INFO(GraphicsResources::GetDevice()->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&pFence)));
 	m_fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
 	if (m_fenceEvent == nullptr)
@@ -90,47 +222,32 @@ void CommandContext::CopyBufferRegion(
 
 void CommandContext::TransitionResource(GpuResource& Resource, D3D12_RESOURCE_STATES NewState, bool FlushImmediate)
 {
-	D3D12_RESOURCE_STATES OldState = Resource.m_UsageState;
+	TransitionSubresource(Resource, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, NewState, FlushImmediate);
+}
 
+void CommandContext::TransitionSubresource(
+	GpuResource& Resource, UINT Subresource, D3D12_RESOURCE_STATES NewState, bool FlushImmediate)
+{
 	// if (m_Type == D3D12_COMMAND_LIST_TYPE_COMPUTE)
 	//{
 	// assert((OldState & VALID_COMPUTE_QUEUE_RESOURCE_STATES) == OldState);
 	// assert((NewState & VALID_COMPUTE_QUEUE_RESOURCE_STATES) == NewState);
 	//}
 
-	if (OldState != NewState)
-	{
-		// assert(m_NumBarriersToFlush < 16, "Exceeded arbitrary limit on buffered barriers");
-		D3D12_RESOURCE_BARRIER& BarrierDesc = m_ResourceBarrierBuffer[m_NumBarriersToFlush++];
-
-		BarrierDesc.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-		BarrierDesc.Transition.pResource = Resource.GetResource();
-		BarrierDesc.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-		BarrierDesc.Transition.StateBefore = OldState;
-		BarrierDesc.Transition.StateAfter = NewState;
-
-		// Check to see if we already started the transition
-		if (NewState == Resource.m_TransitioningState)
-		{
-			BarrierDesc.Flags = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;
-			Resource.m_TransitioningState = (D3D12_RESOURCE_STATES)-1;
-		}
-		else
-			BarrierDesc.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+	const bool isChanged = m_stateTracker.Transition(
+		&Resource, Resource.m_States, Resource.GetSubresourceCount(), Subresource, NewState);
+	QueueTrackedBarriers();
 
-		Resource.m_UsageState = NewState;
-	}
-	else if (NewState == D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+	if (!isChanged && NewState == D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
 		InsertUAVBarrier(Resource, FlushImmediate);
 
-	if (FlushImmediate || m_NumBarriersToFlush == 16)
+	if (FlushImmediate)
 		FlushResourceBarriers();
 }
 
 void CommandContext::InsertUAVBarrier(GpuResource& Resource, bool FlushImmediate)
 {
-	// assert(m_NumBarriersToFlush < 16, "Exceeded arbitrary limit on buffered barriers");
-	D3D12_RESOURCE_BARRIER& BarrierDesc = m_ResourceBarrierBuffer[m_NumBarriersToFlush++];
+	D3D12_RESOURCE_BARRIER& BarrierDesc = m_ResourceBarrierBuffer.emplace_back();
 
 	BarrierDesc.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
 	BarrierDesc.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
@@ -142,8 +259,7 @@ void CommandContext::InsertUAVBarrier(GpuResource& Resource, bool FlushImmediate
 
 void CommandContext::InsertAliasBarrier(GpuResource& Before, GpuResource& After, bool FlushImmediate)
 {
-	// assert(m_NumBarriersToFlush < 16, "Exceeded arbitrary limit on buffered barriers");
-	D3D12_RESOURCE_BARRIER& BarrierDesc = m_ResourceBarrierBuffer[m_NumBarriersToFlush++];
+	D3D12_RESOURCE_BARRIER& BarrierDesc = m_ResourceBarrierBuffer.emplace_back();
 
 	BarrierDesc.Type = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
 	BarrierDesc.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
@@ -156,30 +272,50 @@ void CommandContext::InsertAliasBarrier(GpuResource& Before, GpuResource& After,
 
 void CommandContext::BeginResourceTransition(GpuResource& Resource, D3D12_RESOURCE_STATES NewState, bool FlushImmediate)
 {
-	// If it's already transitioning, finish that transition
-	if (Resource.m_TransitioningState != (D3D12_RESOURCE_STATES)-1)
-		TransitionResource(Resource, Resource.m_TransitioningState);
+	m_stateTracker.BeginTransition(
+		&Resource,
+		Resource.m_States,
+		Resource.GetSubresourceCount(),
+		D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES,
+		NewState);
+	QueueTrackedBarriers();
 
-	D3D12_RESOURCE_STATES OldState = Resource.m_UsageState;
+	if (FlushImmediate)
+		FlushResourceBarriers();
+}
 
-	if (OldState != NewState)
+void CommandContext::QueueTrackedBarriers()
+{
+	for (const StateTransition& transition : m_stateTracker.GetPendingBarriers())
 	{
-		// assert(m_NumBarriersToFlush < 16, "Exceeded arbitrary limit on buffered barriers");
-		D3D12_RESOURCE_BARRIER& BarrierDesc = m_ResourceBarrierBuffer[m_NumBarriersToFlush++];
+		QueueTransition(transition);
+	}
 
-		BarrierDesc.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-		BarrierDesc.Transition.pResource = Resource.GetResource();
-		BarrierDesc.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-		BarrierDesc.Transition.StateBefore = OldState;
-		BarrierDesc.Transition.StateAfter = NewState;
+	m_stateTracker.ClearPendingBarriers();
+}
 
-		BarrierDesc.Flags = D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY;
+void CommandContext::QueueTransition(const StateTransition& transition)
+{
+	D3D12_RESOURCE_BARRIER& BarrierDesc = m_ResourceBarrierBuffer.emplace_back();
 
-		Resource.m_TransitioningState = NewState;
-	}
+	BarrierDesc.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+	BarrierDesc.Transition.pResource = static_cast<GpuResource*>(transition.resource)->GetResource();
+	BarrierDesc.Transition.Subresource = transition.subresource;
+	BarrierDesc.Transition.StateBefore = (D3D12_RESOURCE_STATES)transition.before;
+	BarrierDesc.Transition.StateAfter = (D3D12_RESOURCE_STATES)transition.after;
 
-	if (FlushImmediate || m_NumBarriersToFlush == 16)
-		FlushResourceBarriers();
+	switch (transition.split)
+	{
+	case SplitBarrier::BeginOnly:
+		BarrierDesc.Flags = D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY;
+		break;
+	case SplitBarrier::EndOnly:
+		BarrierDesc.Flags = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;
+		break;
+	default:
+		BarrierDesc.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+		break;
+	}
 }
 
 void CommandContext::BindDescriptorHeaps(void)
@@ -194,8 +330,9 @@ void CommandContext::BindDescriptorHeaps(void)
 			HeapsToBind[NonNullHeaps++] = HeapIter;
 	}
 
+	// Filtrul invalideaza tabelele de descriptori setate pe heap-urile anterioare
 	if (NonNullHeaps > 0)
-		pCommandList->SetDescriptorHeaps(NonNullHeaps, HeapsToBind);
+		m_commandFilter.SetDescriptorHeaps(NonNullHeaps, HeapsToBind);
 }
 
 void CommandContext::Reset()
@@ -205,9 +342,12 @@ void CommandContext::Reset()
 	GFX_THROW_INFO(pCommandAllocator->Reset());
 	GFX_THROW_INFO(pCommandList->Reset(pCommandAllocator.Get(), nullptr));
 
-	m_CurGraphicsRootSignature = nullptr;
 	m_CurComputeRootSignature = nullptr;
-	m_CurPipelineState = nullptr;
+	m_commandFilter.Reset();
+
+	// O lista noua nu stie nimic despre starea resurselor; ce a ramas nerezolvat apartinea unei liste netrimise
+	m_stateTracker.Reset();
+	m_ResourceBarrierBuffer.clear();
 }
 
 void GraphicsContext::SetRenderTargetAndDepthStencil(
@@ -311,6 +451,13 @@ void CommandContext::Finish(ID3D12CommandQueue* pCommandQueue)
 	m_fenceValue++;
 }
 
+void CommandContext::Close()
+{
+	HRESULT hr;
+
+	GFX_THROW_INFO(pCommandList->Close());
+}
+
 void CommandContext::End(ID3D12CommandQueue* pCommandQueue)
 {
 	HRESULT hr;
@@ -336,7 +483,9 @@ void CommandContext::End(ID3D12CommandQueue* pCommandQueue)
 
 void ContextManager::Flush(bool waitForCompletition)
 {
-	GetGraphicsContext().Finish(pCommandQueue.Get());
+	m_uploadManager.Submit();
+	SubmitRecordingContexts();
+	SubmitFrameContext(GetGraphicsContext(), false);
 
 	if (waitForCompletition)
 		GetGraphicsContext().IsReadyOrWait();
@@ -344,15 +493,34 @@ void ContextManager::Flush(bool waitForCompletition)
 
 void ContextManager::End()
 {
+	m_uploadManager.Submit();
+
 	for (size_t i = 0; i < engine::core::Settings::GetFrameResourcesCount(); i++)
 	{
-		m_graphicsContexts[i]->End(pCommandQueue.Get());
+		SubmitFrameContext(*m_graphicsContexts[i], true);
 	}
+
+	// Contextele de inregistrare se distrug doar dupa ce GPU-ul le-a terminat; cu eveniment nul apelul asteapta
+	if (pQueueFence->GetCompletedValue() < m_queueFenceValue)
+	{
+		HRESULT hr;
+
+		GFX_THROW_INFO(pQueueFence->SetEventOnCompletion(m_queueFenceValue, nullptr));
+	}
+
+	m_uploadManager.WaitForIdle();
 }
 
 void ContextManager::SwapContext()
 {
-	GetGraphicsContext().Finish(pCommandQueue.Get());
+	// Copierile si pass-urile inregistrate separat se executa inaintea contextului de cadru
+	m_uploadManager.Submit();
+	SubmitRecordingContexts();
+	SubmitFrameContext(GetGraphicsContext(), false);
+	pCommandQueue->Signal(pQueueFence.Get(), ++m_queueFenceValue);
+
+	m_lastFrameStateFilterStatistics = m_frameStateFilterStatistics;
+	m_frameStateFilterStatistics = {};
 
 	frameIndex = (frameIndex + 1) % engine::core::Settings::GetFrameResourcesCount();
 
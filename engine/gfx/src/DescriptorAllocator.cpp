@@ -0,0 +1,109 @@
+#include "DescriptorAllocator.hpp"
+
+#include <cassert>
+#include <iterator>
+
+namespace engine::gfx
+{
+
+void DescriptorAllocator::Create(uint32_t persistentCount, uint32_t transientCount)
+{
+	m_persistentCount = persistentCount;
+	m_freeCount = persistentCount;
+
+	m_freeRanges.clear();
+	if (persistentCount != 0)
+		m_freeRanges.emplace(0, persistentCount);
+
+	// Heap-urile fara regiune tranzitorie (RTV, DSV) lasa inelul gol; AllocateTransient intoarce InvalidIndex
+	if (transientCount != 0)
+		m_transientRing.Create(transientCount);
+}
+
+uint32_t DescriptorAllocator::Allocate(uint32_t count)
+{
+	assert(count != 0);
+
+	for (auto it = m_freeRanges.begin(); it != m_freeRanges.end(); ++it)
+	{
+		if (it->second < count)
+			continue;
+
+		const uint32_t index = it->first;
+		const uint32_t remaining = it->second - count;
+
+		m_freeRanges.erase(it);
+		if (remaining != 0)
+			m_freeRanges.emplace(index + count, remaining);
+
+		m_freeCount -= count;
+
+		return index;
+	}
+
+	return InvalidIndex;
+}
+
+void DescriptorAllocator::Free(uint32_t index, uint32_t count)
+{
+	assert(count != 0 && index + count <= m_persistentCount);
+
+	uint32_t start = index;
+	uint32_t end = index + count;
+
+	auto next = m_freeRanges.lower_bound(index);
+	assert(next == m_freeRanges.end() || end <= next->first);
+
+	if (next != m_freeRanges.begin())
+	{
+		auto previous = std::prev(next);
+		assert(previous->first + previous->second <= start);
+
+		if (previous->first + previous->second == start)
+		{
+			start = previous->first;
+			m_freeRanges.erase(previous);
+		}
+	}
+
+	if (next != m_freeRanges.end() && next->first == end)
+	{
+		end += next->second;
+		m_freeRanges.erase(next);
+	}
+
+	m_freeRanges.emplace(start, end - start);
+	m_freeCount += count;
+}
+
+uint32_t DescriptorAllocator::AllocateTransient(uint32_t count)
+{
+	const uint64_t offset = m_transientRing.Allocate(count, 1);
+	if (offset == UploadRingAllocator::InvalidOffset)
+		return InvalidIndex;
+
+	return m_persistentCount + (uint32_t)offset;
+}
+
+void DescriptorAllocator::RetireTransient(uint64_t fenceValue)
+{
+	m_transientRing.Retire(fenceValue);
+}
+
+void DescriptorAllocator::ReclaimTransient(uint64_t completedFenceValue)
+{
+	m_transientRing.Reclaim(completedFenceValue);
+}
+
+uint32_t DescriptorAllocator::GetLargestFreeRange() const
+{
+	uint32_t largest = 0;
+	for (const auto& [index, count] : m_freeRanges)
+	{
+		largest = count > largest ? count : largest;
+	}
+
+	return largest;
+}
+
+}  // namespace engine::gfx
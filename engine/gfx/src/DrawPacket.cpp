@@ -0,0 +1,137 @@
+#include "DrawPacket.hpp"
+
+#include "Context.hpp"
+
+namespace engine::gfx
+{
+
+using namespace engine::gfx::RSBinding;
+
+DrawPacketReplayStatistics ReplayDrawPackets(GraphicsContext& graphicsContext, const RenderQueue<DrawPacket>& queue)
+{
+	DrawPacketReplayStatistics statistics;
+	statistics.packetCount = (UINT)queue.GetPacketCount();
+
+	// Starea setata de pachetul anterior; primul pachet seteaza tot
+	const DrawPacket* previous = nullptr;
+
+	for (size_t i = 0; i < queue.GetPacketCount(); i++)
+	{
+		const DrawPacket& packet = queue.GetSortedPacket(i);
+
+		if (!previous || packet.pso != previous->pso)
+		{
+			graphicsContext.SetPipelineState(*packet.pso);
+			statistics.pipelineStateChanges++;
+		}
+
+		if (!previous || packet.topology != previous->topology)
+			graphicsContext.SetPrimitiveTopology(packet.topology);
+
+		if (!previous || packet.vertexBufferView != previous->vertexBufferView)
+		{
+			graphicsContext.SetVertexBuffer(0, *packet.vertexBufferView);
+			statistics.bufferChanges++;
+		}
+
+		if (!previous || packet.indexBufferView != previous->indexBufferView)
+		{
+			graphicsContext.SetIndexBuffer(*packet.indexBufferView);
+			statistics.bufferChanges++;
+		}
+
+		if (packet.objectCB != 0 && (!previous || packet.objectCB != previous->objectCB))
+		{
+			graphicsContext.SetConstantBuffer(DefaultRSBindings::ObjectCB, packet.objectCB);
+			statistics.constantBufferChanges++;
+		}
+
+		if (packet.materialCB != 0 && (!previous || packet.materialCB != previous->materialCB))
+		{
+			graphicsContext.SetConstantBuffer(DefaultRSBindings::MaterialCB, packet.materialCB);
+			statistics.constantBufferChanges++;
+		}
+
+		if (packet.useDrawConstants
+			&& (!previous || !previous->useDrawConstants || packet.objectIndex != previous->objectIndex
+				|| packet.materialIndex != previous->materialIndex))
+		{
+			graphicsContext.SetConstants(DefaultRSBindings::DrawConstants, packet.objectIndex, packet.materialIndex);
+			statistics.constantBufferChanges++;
+		}
+
+		if (packet.instanceData != 0)
+		{
+			if (!previous || packet.instanceData != previous->instanceData)
+				graphicsContext.SetShaderResourceView(DefaultRSBindings::InstanceData, packet.instanceData);
+
+			graphicsContext.SetConstant(DefaultRSBindings::InstanceConstants, packet.instanceOffset);
+		}
+
+		if (packet.signature)
+		{
+			graphicsContext.ExecuteIndirect(
+				*packet.signature,
+				packet.maxCommandCount,
+				packet.argumentBuffer,
+				packet.argumentOffset,
+				packet.argumentBuffer,
+				packet.countOffset);
+		}
+		else
+		{
+			graphicsContext.DrawIndexedInstanced(
+				packet.draw.indexCountPerInstance,
+				packet.draw.instanceCount,
+				packet.draw.startIndexLocation,
+				packet.draw.baseVertexLocation,
+				packet.draw.startInstanceLocation);
+		}
+
+		previous = &packet;
+	}
+
+	return statistics;
+}
+
+void AddDrawPackets(CommandFingerprint& fingerprint, const RenderQueue<DrawPacket>& queue)
+{
+	fingerprint.Add(queue.GetPacketCount());
+
+	for (size_t i = 0; i < queue.GetPacketCount(); i++)
+	{
+		const DrawPacket& packet = queue.GetSortedPacket(i);
+
+		fingerprint.Add(packet.pso->GetID3D12PipelineState());
+		fingerprint.Add(packet.topology);
+
+		fingerprint.Add(packet.vertexBufferView->BufferLocation);
+		fingerprint.Add(packet.vertexBufferView->SizeInBytes);
+		fingerprint.Add(packet.vertexBufferView->StrideInBytes);
+		fingerprint.Add(packet.indexBufferView->BufferLocation);
+		fingerprint.Add(packet.indexBufferView->SizeInBytes);
+		fingerprint.Add(packet.indexBufferView->Format);
+
+		fingerprint.Add(packet.objectCB);
+		fingerprint.Add(packet.materialCB);
+		fingerprint.Add(packet.useDrawConstants);
+		fingerprint.Add(packet.objectIndex);
+		fingerprint.Add(packet.materialIndex);
+		fingerprint.Add(packet.instanceData);
+		fingerprint.Add(packet.instanceOffset);
+
+		fingerprint.Add(packet.draw.indexCountPerInstance);
+		fingerprint.Add(packet.draw.instanceCount);
+		fingerprint.Add(packet.draw.startIndexLocation);
+		fingerprint.Add(packet.draw.baseVertexLocation);
+		fingerprint.Add(packet.draw.startInstanceLocation);
+
+		fingerprint.Add(packet.signature);
+		fingerprint.Add(packet.argumentBuffer);
+		fingerprint.Add(packet.argumentOffset);
+		fingerprint.Add(packet.countOffset);
+		fingerprint.Add(packet.maxCommandCount);
+	}
+}
+
+}  // namespace engine::gfx
@@ -0,0 +1,49 @@
+#include "DrawRangeMerger.hpp"
+
+#include <algorithm>
+
+namespace engine::gfx
+{
+
+void DrawRangeMerger::Add(uint32_t startIndexLocation, uint32_t indexCount, int32_t baseVertexLocation)
+{
+	if (indexCount == 0)
+		return;
+
+	if (!m_ranges.empty())
+	{
+		DrawRange& last = m_ranges.back();
+
+		if (last.baseVertexLocation == baseVertexLocation && last.GetEndIndexLocation() == startIndexLocation)
+		{
+			last.indexCount += indexCount;
+			return;
+		}
+	}
+
+	m_ranges.push_back({startIndexLocation, indexCount, baseVertexLocation});
+}
+
+std::vector<DrawRange> DrawRangeMerger::MergeMinimal(std::vector<DrawRange> ranges)
+{
+	std::sort(
+		ranges.begin(),
+		ranges.end(),
+		[](const DrawRange& lhs, const DrawRange& rhs)
+		{
+			if (lhs.baseVertexLocation != rhs.baseVertexLocation)
+				return lhs.baseVertexLocation < rhs.baseVertexLocation;
+
+			return lhs.startIndexLocation < rhs.startIndexLocation;
+		});
+
+	DrawRangeMerger merger;
+	for (const DrawRange& range : ranges)
+	{
+		merger.Add(range.startIndexLocation, range.indexCount, range.baseVertexLocation);
+	}
+
+	return merger.m_ranges;
+}
+
+}  // namespace engine::gfx
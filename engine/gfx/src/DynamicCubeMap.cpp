@@ -39,16 +39,18 @@ void DynamicCubeMap::Create()
 		m_width, m_height, DXGI_FORMAT_R8G8B8A8_UNORM, D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET, L"DynamicCubeMap");
 	m_cubeMapTexture->AllocateRtvHandle();
 	m_cubeMapTexture->AllocateSrvHandle();
+	m_cubeMapTexture->TrackResidency(ResidencyPriority::High);
 
 	m_depthTexture.reset(new DepthTexture(1.0f, 0));
 	m_depthTexture->Create(m_width, m_height, DXGI_FORMAT_D24_UNORM_S8_UINT, L"DynamicCubeMapDepthTexture");
 	m_depthTexture->AllocateDsvHandle();
+	// Folosit doar cand se randeaza fetele, deci primul evacuat
+	m_depthTexture->TrackResidency(ResidencyPriority::Low);
 }
 
 void DynamicCubeMap::Setup(GraphicsContext& graphicsContext)
 {
 	graphicsContext.SetViewportAndScissor(m_viewport, m_scissorRect);
-	graphicsContext.TransitionResource(*m_cubeMapTexture, D3D12_RESOURCE_STATE_RENDER_TARGET);
 }
 
 void DynamicCubeMap::SetRenderTarget(GraphicsContext& graphicsContext, UINT index)
@@ -59,11 +61,6 @@ void DynamicCubeMap::SetRenderTarget(GraphicsContext& graphicsContext, UINT inde
 	graphicsContext.ClearDepthAndStencil(*m_depthTexture);
 }
 
-void DynamicCubeMap::Finish(GraphicsContext& graphicsContext)
-{
-	graphicsContext.TransitionResource(*m_cubeMapTexture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-}
-
 void DynamicCubeMap::Update()
 {
 	m_cameraController.Update(m_center);
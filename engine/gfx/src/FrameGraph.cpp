@@ -0,0 +1,449 @@
+#include "FrameGraph.hpp"
+
+#include "engine/core/FrameArena.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace engine::gfx
+{
+
+namespace
+{
+
+// Elementul urmator din storage-ul refolosit; obiectele vechi isi pastreaza memoria (nume, vectori)
+template <typename T>
+T& ReuseNext(std::vector<T>& items, uint32_t& count)
+{
+	if (count == items.size())
+		items.emplace_back();
+
+	return items[count++];
+}
+
+}  // namespace
+
+void FrameGraph::Reset()
+{
+	m_resourceCount = 0;
+	m_versionCount = 0;
+	m_passCount = 0;
+
+	m_executionOrder.clear();
+	m_finalBarriers.clear();
+	m_statistics = {};
+}
+
+FrameGraphResource FrameGraph::ImportResource(
+	std::string_view name, FrameGraphUsage::Mask initialUsage, FrameGraphUsage::Mask finalUsage)
+{
+	const FrameGraphResource version = AddResource(name, true);
+
+	Resource& resource = m_resources[m_resourceCount - 1];
+	resource.initialUsage = initialUsage;
+	resource.finalUsage = finalUsage;
+
+	return version;
+}
+
+FrameGraphResource FrameGraph::CreateTransient(std::string_view name, uint64_t sizeInBytes, uint64_t alignment)
+{
+	assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+	const FrameGraphResource version = AddResource(name, false);
+
+	Resource& resource = m_resources[m_resourceCount - 1];
+	resource.sizeInBytes = sizeInBytes;
+	resource.alignment = alignment;
+
+	return version;
+}
+
+FrameGraphPass FrameGraph::AddPass(std::string_view name, bool hasSideEffects)
+{
+	Pass& pass = ReuseNext(m_passes, m_passCount);
+	pass.name.assign(name);
+	pass.hasSideEffects = hasSideEffects;
+	pass.reads.clear();
+	pass.writes.clear();
+	pass.isCulled = false;
+	pass.barriers.clear();
+
+	return m_passCount - 1;
+}
+
+void FrameGraph::Read(FrameGraphPass pass, FrameGraphResource resource, FrameGraphUsage::Mask usage)
+{
+	assert(pass < m_passCount && resource < m_versionCount);
+	assert(FrameGraphUsage::IsReadOnly(usage));
+
+	m_passes[pass].reads.push_back({resource, usage});
+	m_versions[resource].readers.push_back(pass);
+}
+
+FrameGraphResource FrameGraph::Write(FrameGraphPass pass, FrameGraphResource resource, FrameGraphUsage::Mask usage)
+{
+	assert(pass < m_passCount && resource < m_versionCount);
+
+	const uint32_t physical = m_versions[resource].resource;
+	// Doua scrieri din aceeasi versiune ar bifurca continutul resursei
+	assert(m_resources[physical].lastVersion == resource);
+
+	const FrameGraphResource version = AddVersion(physical, pass, resource);
+	m_resources[physical].lastVersion = version;
+
+	m_passes[pass].writes.push_back({version, usage});
+
+	return version;
+}
+
+FrameGraphResource FrameGraph::AddResource(std::string_view name, bool isImported)
+{
+	const uint32_t index = m_resourceCount;
+
+	Resource& resource = ReuseNext(m_resources, m_resourceCount);
+	resource.name.assign(name);
+	resource.isImported = isImported;
+	resource.initialUsage = FrameGraphUsage::Undefined;
+	resource.finalUsage = FrameGraphUsage::Undefined;
+	resource.sizeInBytes = 0;
+	resource.alignment = 0;
+	resource.lastVersion = AddVersion(index, NoPass, UINT32_MAX);
+	resource.offset = NoOffset;
+
+	return resource.lastVersion;
+}
+
+FrameGraphResource FrameGraph::AddVersion(uint32_t resource, FrameGraphPass producer, FrameGraphResource previous)
+{
+	Version& version = ReuseNext(m_versions, m_versionCount);
+	version.resource = resource;
+	version.producer = producer;
+	version.previous = previous;
+	version.readers.clear();
+
+	return m_versionCount - 1;
+}
+
+void FrameGraph::Compile(bool useSplitBarriers)
+{
+	m_executionOrder.clear();
+	m_finalBarriers.clear();
+	m_statistics = {};
+
+	CullPasses();
+	SortPasses();
+	BuildBarriers(useSplitBarriers);
+	AliasTransients();
+}
+
+void FrameGraph::CullPasses()
+{
+	engine::core::FrameVector<FrameGraphPass> stack;
+
+	for (FrameGraphPass i = 0; i < m_passCount; i++)
+	{
+		Pass& pass = m_passes[i];
+		pass.isCulled = true;
+
+		bool isRoot = pass.hasSideEffects;
+		for (const Access& write : pass.writes)
+		{
+			isRoot = isRoot || m_resources[m_versions[write.version].resource].isImported;
+		}
+
+		if (isRoot)
+		{
+			pass.isCulled = false;
+			stack.push_back(i);
+		}
+	}
+
+	while (!stack.empty())
+	{
+		const Pass& pass = m_passes[stack.back()];
+		stack.pop_back();
+
+		for (const Access& read : pass.reads)
+		{
+			const FrameGraphPass producer = m_versions[read.version].producer;
+			if (producer != NoPass && m_passes[producer].isCulled)
+			{
+				m_passes[producer].isCulled = false;
+				stack.push_back(producer);
+			}
+		}
+	}
+
+	for (FrameGraphPass i = 0; i < m_passCount; i++)
+	{
+		m_statistics.culledPasses += m_passes[i].isCulled ? 1 : 0;
+	}
+}
+
+void FrameGraph::SortPasses()
+{
+	const FrameGraphPass passCount = m_passCount;
+
+	engine::core::FrameVector<engine::core::FrameVector<FrameGraphPass>> successors(passCount);
+	engine::core::FrameVector<uint32_t> predecessorCount(passCount, 0);
+
+	const auto addEdge = [this, &successors, &predecessorCount](FrameGraphPass from, FrameGraphPass to)
+	{
+		if (from == NoPass || from == to || m_passes[from].isCulled)
+			return;
+
+		successors[from].push_back(to);
+		predecessorCount[to]++;
+	};
+
+	for (FrameGraphPass i = 0; i < passCount; i++)
+	{
+		if (m_passes[i].isCulled)
+			continue;
+
+		for (const Access& read : m_passes[i].reads)
+		{
+			addEdge(m_versions[read.version].producer, i);
+		}
+
+		for (const Access& write : m_passes[i].writes)
+		{
+			const Version& previous = m_versions[m_versions[write.version].previous];
+
+			addEdge(previous.producer, i);
+			for (FrameGraphPass reader : previous.readers)
+			{
+				addEdge(reader, i);
+			}
+		}
+	}
+
+	// Kahn; dintre pass-urile gata se alege mereu cel declarat primul
+	engine::core::FrameVector<bool> isScheduled(passCount, false);
+	for (;;)
+	{
+		FrameGraphPass next = NoPass;
+		for (FrameGraphPass i = 0; i < passCount; i++)
+		{
+			if (!m_passes[i].isCulled && !isScheduled[i] && predecessorCount[i] == 0)
+			{
+				next = i;
+				break;
+			}
+		}
+
+		if (next == NoPass)
+			break;
+
+		isScheduled[next] = true;
+		m_executionOrder.push_back(next);
+
+		for (FrameGraphPass successor : successors[next])
+		{
+			predecessorCount[successor]--;
+		}
+	}
+
+	assert(m_executionOrder.size() == passCount - m_statistics.culledPasses);
+}
+
+FrameGraphUsage::Mask FrameGraph::GetPassUsage(const Pass& pass, uint32_t resource) const
+{
+	FrameGraphUsage::Mask usage = FrameGraphUsage::Undefined;
+
+	for (const Access& read : pass.reads)
+	{
+		if (m_versions[read.version].resource == resource)
+			usage |= read.usage;
+	}
+
+	for (const Access& write : pass.writes)
+	{
+		if (m_versions[write.version].resource == resource)
+			usage |= write.usage;
+	}
+
+	return usage;
+}
+
+void FrameGraph::BuildBarriers(bool useSplitBarriers)
+{
+	engine::core::FrameVector<FrameGraphUsage::Mask> currentUsage(m_resourceCount);
+	for (uint32_t i = 0; i < m_resourceCount; i++)
+	{
+		currentUsage[i] = m_resources[i].initialUsage;
+	}
+
+	for (FrameGraphPass pass : m_executionOrder)
+	{
+		m_passes[pass].barriers.clear();
+	}
+
+	// Pozitia ultimului pass care a folosit resursa in cadru (SIZE_MAX: niciunul)
+	engine::core::FrameVector<size_t> lastUse(m_resourceCount, SIZE_MAX);
+
+	for (size_t position = 0; position < m_executionOrder.size(); position++)
+	{
+		Pass& pass = m_passes[m_executionOrder[position]];
+
+		for (uint32_t resource = 0; resource < m_resourceCount; resource++)
+		{
+			FrameGraphUsage::Mask usage = GetPassUsage(pass, resource);
+			if (usage == FrameGraphUsage::Undefined)
+				continue;
+
+			const FrameGraphUsage::Mask current = currentUsage[resource];
+			const size_t beginPosition = lastUse[resource] == SIZE_MAX ? 0 : lastUse[resource] + 1;
+			lastUse[resource] = position;
+
+			// Citirea e deja acoperita de starea de citire curenta
+			if (FrameGraphUsage::IsReadOnly(usage) && FrameGraphUsage::IsReadOnly(current)
+				&& current != FrameGraphUsage::Undefined && (usage & ~current) == 0)
+				continue;
+
+			// Starea de citire include si citirile urmatoare, pana la urmatorul scriitor
+			if (FrameGraphUsage::IsReadOnly(usage))
+			{
+				for (size_t later = position + 1; later < m_executionOrder.size(); later++)
+				{
+					const FrameGraphUsage::Mask laterUsage = GetPassUsage(m_passes[m_executionOrder[later]], resource);
+					if (!FrameGraphUsage::IsReadOnly(laterUsage))
+						break;
+
+					usage |= laterUsage;
+				}
+			}
+
+			if (usage == current)
+				continue;
+
+			// Continutul nedefinit nu are o stare din care tranzitia sa poata incepe devreme
+			if (useSplitBarriers && current != FrameGraphUsage::Undefined && beginPosition < position)
+			{
+				m_passes[m_executionOrder[beginPosition]].barriers.push_back(
+					{resource, current, usage, SplitBarrier::BeginOnly});
+				pass.barriers.push_back({resource, current, usage, SplitBarrier::EndOnly});
+			}
+			else
+			{
+				pass.barriers.push_back({resource, current, usage, SplitBarrier::None});
+			}
+
+			currentUsage[resource] = usage;
+		}
+	}
+
+	for (uint32_t resource = 0; resource < m_resourceCount; resource++)
+	{
+		const FrameGraphUsage::Mask finalUsage = m_resources[resource].finalUsage;
+		if (finalUsage != FrameGraphUsage::Undefined && finalUsage != currentUsage[resource])
+			m_finalBarriers.push_back({resource, currentUsage[resource], finalUsage, SplitBarrier::None});
+	}
+
+	// O tranzitie split se numara o singura data
+	for (FrameGraphPass pass : m_executionOrder)
+	{
+		for (const FrameGraphBarrier& barrier : m_passes[pass].barriers)
+		{
+			m_statistics.barrierCount += barrier.split == SplitBarrier::BeginOnly ? 0 : 1;
+		}
+	}
+
+	m_statistics.barrierCount += (uint32_t)m_finalBarriers.size();
+}
+
+void FrameGraph::AliasTransients()
+{
+	struct Lifetime
+	{
+		uint32_t resource;
+		size_t first;
+		size_t last;
+	};
+
+	engine::core::FrameVector<Lifetime> lifetimes;
+
+	for (uint32_t resource = 0; resource < m_resourceCount; resource++)
+	{
+		m_resources[resource].offset = NoOffset;
+		if (m_resources[resource].isImported)
+			continue;
+
+		Lifetime lifetime = {resource, SIZE_MAX, 0};
+		for (size_t position = 0; position < m_executionOrder.size(); position++)
+		{
+			if (GetPassUsage(m_passes[m_executionOrder[position]], resource) == FrameGraphUsage::Undefined)
+				continue;
+
+			lifetime.first = std::min(lifetime.first, position);
+			lifetime.last = position;
+		}
+
+		// Resursele folosite doar de pass-uri eliminate nu primesc memorie
+		if (lifetime.first != SIZE_MAX)
+			lifetimes.push_back(lifetime);
+	}
+
+	// Resursele mari se plaseaza primele, ca cele mici sa umple golurile dintre ele
+	std::stable_sort(
+		lifetimes.begin(),
+		lifetimes.end(),
+		[this](const Lifetime& a, const Lifetime& b)
+		{ return m_resources[a.resource].sizeInBytes > m_resources[b.resource].sizeInBytes; });
+
+	engine::core::FrameVector<Lifetime> placed;
+
+	for (const Lifetime& lifetime : lifetimes)
+	{
+		Resource& resource = m_resources[lifetime.resource];
+
+		const auto align = [&resource](uint64_t offset)
+		{ return (offset + resource.alignment - 1) & ~(resource.alignment - 1); };
+
+		// Doar resursele care traiesc in acelasi timp limiteaza offset-ul
+		engine::core::FrameVector<const Lifetime*> overlapping;
+		for (const Lifetime& other : placed)
+		{
+			if (other.first <= lifetime.last && lifetime.first <= other.last)
+				overlapping.push_back(&other);
+		}
+
+		// Candidatii: inceputul heap-ului si capetele resurselor suprapuse in timp
+		engine::core::FrameVector<uint64_t> candidates(1, 0);
+		for (const Lifetime* other : overlapping)
+		{
+			const Resource& otherResource = m_resources[other->resource];
+			candidates.push_back(align(otherResource.offset + otherResource.sizeInBytes));
+		}
+		std::sort(candidates.begin(), candidates.end());
+
+		for (uint64_t candidate : candidates)
+		{
+			bool fits = true;
+			for (const Lifetime* other : overlapping)
+			{
+				const Resource& otherResource = m_resources[other->resource];
+				if (candidate < otherResource.offset + otherResource.sizeInBytes
+					&& otherResource.offset < candidate + resource.sizeInBytes)
+				{
+					fits = false;
+					break;
+				}
+			}
+
+			if (fits)
+			{
+				resource.offset = candidate;
+				break;
+			}
+		}
+
+		placed.push_back(lifetime);
+
+		m_statistics.transientBytes += resource.sizeInBytes;
+		m_statistics.aliasedBytes = std::max(m_statistics.aliasedBytes, resource.offset + resource.sizeInBytes);
+	}
+}
+
+}  // namespace engine::gfx
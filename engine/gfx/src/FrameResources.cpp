@@ -15,11 +15,34 @@
 #include "TextureManager.hpp"
 #include "WaterRenderer.hpp"
 
+#include <cstddef>
+#include <cstring>
+
 namespace engine::gfx
 {
 
 using namespace DirectX;
 
+static_assert(sizeof(ObjectRecord) == sizeof(ObjectConstantBuffer), "ObjectRecord trebuie sa aiba layout-ul CB-ului");
+static_assert(sizeof(Float4x4) == sizeof(XMFLOAT4X4) && sizeof(Float4x4) == sizeof(engine::math::Matrix4));
+
+namespace
+{
+
+// Partea recordului de pass comuna tuturor sloturilor (rezolutie, timp, lumini), scrisa de UpdateMainPassCB; farZ e
+// singurul camp de camera din ea
+constexpr size_t PassFrameDataOffset = offsetof(PassConstantBuffer, renderTargetSize);
+constexpr size_t PassFrameDataSize = sizeof(PassConstantBuffer) - PassFrameDataOffset;
+
+inline Float4x4 ToFloat4x4(const engine::math::Matrix4& matrix)
+{
+	Float4x4 result;
+	std::memcpy(&result, &matrix, sizeof(Float4x4));
+	return result;
+}
+
+}  // namespace
+
 UINT FrameResources::objectCB_ID = 0;
 UINT FrameResources::materialCB_ID = 0;
 
@@ -33,6 +56,24 @@ void FrameResources::Create()
 
 	if (!engine::core::Settings::UseRayTracing())
 	{
+		// Un obiect poate aparea o data in fiecare view; bufferul creste daca sunt mai multe instante
+		m_perInstanceData.Create(
+			GraphicsResources::GetDevice(),
+			engine::core::Settings::GetGameSettings().GetMaxNumberOfObjectCB() * CullingView::Count,
+			L"PerInstanceData");
+
+		if (UseBindlessData())
+		{
+			m_objectData.Create(
+				GraphicsResources::GetDevice(),
+				engine::core::Settings::GetGameSettings().GetMaxNumberOfObjectCB(),
+				L"ObjectData");
+			m_materialData.Create(
+				GraphicsResources::GetDevice(),
+				engine::core::Settings::GetGameSettings().GetMaxNumberOfMaterialCB(),
+				L"MaterialData");
+		}
+
 		m_perPassCB.Create(
 			GraphicsResources::GetDevice(),
 			8 /*1 + (engine::core::Settings::UseAdvancedReflections() ? 6 : 0) + (engine::core::Settings::UseShadows() ? 1 : 0)*/,
@@ -46,26 +87,93 @@ void FrameResources::Create()
 
 void FrameResources::UpdateObjectRendererCB(const ObjectRenderer& objectRenderer)
 {
+	m_staleObjects.clear();
+
 	for (const auto& object : objectRenderer.GetObjects())
 	{
-		this->UpdatePerObjectCB(*object);
+		if (m_objectVersions.IsStale(object->GetObjectCB_ID(), object->GetVersion()))
+			m_staleObjects.push_back(object.get());
+	}
+
+	WriteObjectRecords(m_staleObjects);
+
+	if (objectRenderer.UseInstancing())
+		this->UpdateInstanceData(objectRenderer);
+}
+
+void FrameResources::UpdateInstanceData(const ObjectRenderer& objectRenderer)
+{
+	const std::vector<uint32_t>& instanceObjects = objectRenderer.GetInstanceBatcher().GetInstanceObjects();
+	const Object::Vec& objects = objectRenderer.GetObjects();
+
+	// Ordinea instantelor se reface la fiecare cadru, deci se scriu toate; inversele se calculeaza toate odata
+	const size_t instanceCount = instanceObjects.size();
+	m_transforms.resize(instanceCount);
+	m_textureTransforms.resize(instanceCount);
+
+	for (size_t i = 0; i < instanceCount; i++)
+	{
+		m_transforms[i] = ToFloat4x4(objects[instanceObjects[i]]->GetTransform());
 	}
+
+	InvertMatrices(m_transforms.data(), instanceCount, nullptr, m_textureTransforms.data());
+
+	for (UINT i = 0; i < (UINT)instanceCount; i++)
+	{
+		InstanceData instance = {};
+
+		TransposeMatrices(&m_transforms[i], 1, reinterpret_cast<Float4x4*>(&instance.worldMatrix));
+		std::memcpy(&instance.invWorldMatrix, &m_textureTransforms[i], sizeof(Float4x4));
+		instance.materialIndex = objects[instanceObjects[i]]->GetMaterialCB_ID();
+
+		m_perInstanceData.CopyData(i, instance);
+	}
+
+	m_writtenBytes += m_perInstanceData.Upload(GraphicsResources::GetDevice());
 }
 
 void FrameResources::UpdatePerObjectCB(const Object& object)
 {
-	// Matrice transformare
-	XMStoreFloat4x4(&m_perObjectCB->worldMatrix, XMMatrixTranspose(object.GetTransform()));
+	if (!m_objectVersions.IsStale(object.GetObjectCB_ID(), object.GetVersion()))
+		return;
 
-	// Matricea de transformare inversa
-	XMVECTOR determinant = XMMatrixDeterminant(object.GetTransform());
-	XMStoreFloat4x4(
-		&m_perObjectCB->invWorldMatrix, XMMatrixTranspose(XMMatrixInverse(&determinant, object.GetTransform())));
+	m_staleObjects.assign(1, &object);
+	WriteObjectRecords(m_staleObjects);
+}
+
+void FrameResources::WriteObjectRecords(const std::vector<const Object*>& objects)
+{
+	const size_t count = objects.size();
+	m_transforms.resize(count);
+	m_textureTransforms.resize(count);
+	m_objectRecords.resize(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		m_transforms[i] = ToFloat4x4(objects[i]->GetTransform());
+		m_textureTransforms[i] = ToFloat4x4(objects[i]->GetTextureTransform());
+	}
+
+	PackObjectRecords(m_transforms.data(), m_textureTransforms.data(), count, m_objectRecords.data());
 
-	// Transformarea de textura
-	XMStoreFloat4x4(&m_perObjectCB->textureTransform, XMMatrixTranspose(object.GetTextureTransform()));
+	for (size_t i = 0; i < count; i++)
+	{
+		const ObjectConstantBuffer& record = reinterpret_cast<const ObjectConstantBuffer&>(m_objectRecords[i]);
+		const UINT id = objects[i]->GetObjectCB_ID();
+
+		if (UseBindlessData())
+			m_objectData.CopyData(id, record);
 
-	m_perObjectCB.CopyStagingToGpu(object.GetObjectCB_ID());
+		// CB-ul ramane pentru pipeline-urile fara date bindless (apa); ID-urile peste capacitatea lui sunt doar
+		// bindless
+		if (!UseBindlessData() || id < m_perObjectCB.NumInstances())
+		{
+			m_perObjectCB.CopyData(id, record);
+			m_writtenBytes += sizeof(ObjectConstantBuffer);
+		}
+
+		m_objectVersions.SetWritten(id, objects[i]->GetVersion());
+	}
 }
 
 void FrameResources::UpdateSkyBoxCB(const SkyBoxRenderer& skyBox)
@@ -85,6 +193,11 @@ void FrameResources::UpdateWaterCB(const WaterRenderer& water)
 	}
 
 	m_waterCB.CopyStagingToGpu();
+	m_writtenBytes += sizeof(WaterConstantBuffer);
+
+	// Apa are root signature propriu si citeste obiectul si materialul din CB-uri
+	assert(water.GetObjectCB_ID() < m_perObjectCB.NumInstances());
+	assert(water.GetMaterialCB_ID() < m_perMaterialCB.NumInstances());
 
 	this->UpdatePerObjectCB(water);
 }
@@ -93,10 +206,28 @@ void FrameResources::UpdatePerMaterialCB(const MaterialManager& materialManager)
 {
 	for (const auto& material : materialManager.GetMaterials())
 	{
-		m_perMaterialCB.CopyData(material.GetMaterialCB_ID(), material.GetMaterialProperties());
+		const UINT id = material.GetMaterialCB_ID();
+
+		if (UseBindlessData())
+			m_materialData.CopyData(id, material.GetMaterialProperties());
+
+		if (!UseBindlessData() || id < m_perMaterialCB.NumInstances())
+		{
+			m_perMaterialCB.CopyData(id, material.GetMaterialProperties());
+			m_writtenBytes += sizeof(MaterialProperties);
+		}
 	}
 }
 
+void FrameResources::UploadBindlessData()
+{
+	if (!UseBindlessData())
+		return;
+
+	m_writtenBytes += m_objectData.Upload(GraphicsResources::GetDevice());
+	m_writtenBytes += m_materialData.Upload(GraphicsResources::GetDevice());
+}
+
 void FrameResources::UpdateTerrainCB(const TerrainRenderer& terrain)
 {
 	this->UpdatePerObjectCB(terrain);
@@ -109,6 +240,8 @@ void FrameResources::UpdateMainPassCB(
 	const UINT& renderMode,
 	LightSource::Vec& lightSources)
 {
+	m_writtenBytes = 0;
+
 	// Doar provizorii, in realitate dimensiunea poate varia
 	m_perPassCB->renderTargetSize =
 		XMFLOAT2((float)engine::core::Settings::GetGraphicsSettings().GetWidth(), (float)engine::core::Settings::GetGraphicsSettings().GetHeight());
@@ -147,29 +280,62 @@ void FrameResources::UpdateDyanmicCubeMapPassCB(const DynamicCubeMap& dynamicCub
 
 void FrameResources::UpdateCameraAndTransferToGPUPassCB(const BaseCamera& camera, int i)
 {
-	// View si invView
-	XMStoreFloat4x4(&m_perPassCB->viewMatrix, XMMatrixTranspose(camera.GetViewMatrix()));
-	XMStoreFloat4x4(&m_perPassCB->invViewMatrix, XMMatrixTranspose(camera.GetInverseViewMatrix()));
-
-	// Proj si invProj
-	XMStoreFloat4x4(&m_perPassCB->projMatrix, XMMatrixTranspose(camera.GetProjectionMatrix()));
-	XMStoreFloat4x4(
-		&m_perPassCB->invProjMatrix, XMMatrixTranspose(engine::math::Matrix4::Inverse(camera.GetProjectionMatrix())));
-
-	// ViewProj si invViewProj
-	engine::math::Matrix4 viewProj = camera.GetViewMatrix() * camera.GetProjectionMatrix();
+	PassConstantBuffer& record = m_passRecords[i];
+	PassCamera& passCamera = m_passCameras[i];
 
-	XMStoreFloat4x4(&m_perPassCB->viewProjMatrix, XMMatrixTranspose(viewProj));
-	XMStoreFloat4x4(&m_perPassCB->invViewProjMatrix, XMMatrixTranspose(engine::math::Matrix4::Inverse(viewProj)));
+	// Camerele stau de obicei pe loc (cube map, shadow map); matricele se recalculeaza doar cand difera
+	const bool isCameraChanged = !passCamera.isValid
+		|| std::memcmp(&passCamera.viewMatrix, &camera.GetViewMatrix(), sizeof(engine::math::Matrix4)) != 0
+		|| std::memcmp(&passCamera.projectionMatrix, &camera.GetProjectionMatrix(), sizeof(engine::math::Matrix4)) != 0
+		|| passCamera.nearZ != camera.GetZNear() || passCamera.farZ != camera.GetZFar();
 
-	// EyePosition
-	XMStoreFloat3(&m_perPassCB->eyePosition, camera.GetPosition());
+	if (isCameraChanged)
+	{
+		passCamera.viewMatrix = camera.GetViewMatrix();
+		passCamera.projectionMatrix = camera.GetProjectionMatrix();
+		passCamera.nearZ = camera.GetZNear();
+		passCamera.farZ = camera.GetZFar();
+		passCamera.isValid = true;
+
+		// View si invView
+		XMStoreFloat4x4(&record.viewMatrix, XMMatrixTranspose(camera.GetViewMatrix()));
+		XMStoreFloat4x4(&record.invViewMatrix, XMMatrixTranspose(camera.GetInverseViewMatrix()));
+
+		// Proj, viewProj si inversele lor, calculate impreuna
+		const engine::math::Matrix4 viewProj = camera.GetViewMatrix() * camera.GetProjectionMatrix();
+		const Float4x4 matrices[2] = {ToFloat4x4(camera.GetProjectionMatrix()), ToFloat4x4(viewProj)};
+		Float4x4 inverseTransposes[2];
+		InvertMatrices(matrices, 2, nullptr, inverseTransposes);
+
+		XMStoreFloat4x4(&record.projMatrix, XMMatrixTranspose(camera.GetProjectionMatrix()));
+		std::memcpy(&record.invProjMatrix, &inverseTransposes[0], sizeof(Float4x4));
+		XMStoreFloat4x4(&record.viewProjMatrix, XMMatrixTranspose(viewProj));
+		std::memcpy(&record.invViewProjMatrix, &inverseTransposes[1], sizeof(Float4x4));
+
+		// EyePosition
+		XMStoreFloat3(&record.eyePosition, camera.GetPosition());
+
+		// Near Z (far Z e printre datele cadrului)
+		record.nearZ = camera.GetZNear();
+	}
 
-	// Far/near Z
-	m_perPassCB->farZ = camera.GetZFar();
-	m_perPassCB->nearZ = camera.GetZNear();
+	// Datele cadrului se schimba la fiecare cadru (timpul); se copiaza peste cele ale slotului
+	std::memcpy(
+		reinterpret_cast<uint8_t*>(&record) + PassFrameDataOffset,
+		reinterpret_cast<const uint8_t*>(&m_perPassCB.staging) + PassFrameDataOffset,
+		PassFrameDataSize);
+	record.farZ = camera.GetZFar();
 
-	m_perPassCB.CopyStagingToGpu(i);
+	if (isCameraChanged)
+	{
+		m_perPassCB.CopyData(i, record);
+		m_writtenBytes += sizeof(PassConstantBuffer);
+	}
+	else
+	{
+		m_perPassCB.CopyDataRange(i, record, PassFrameDataOffset, PassFrameDataSize);
+		m_writtenBytes += PassFrameDataSize;
+	}
 }
 
 }  // namespace engine::gfx
@@ -6,21 +6,113 @@
 namespace engine::gfx
 {
 
+UINT GpuResource::GetSubresourceCount()
+{
+	if (m_subresourceCount != 0)
+		return m_subresourceCount;
+
+	const D3D12_RESOURCE_DESC desc = m_pResource->GetDesc();
+
+	if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+	{
+		m_subresourceCount = 1;
+	}
+	else
+	{
+		// Texturile 3D au un singur element de array, oricare ar fi adancimea
+		const UINT arraySize = desc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D ? 1u : desc.DepthOrArraySize;
+		const UINT planeCount = D3D12GetFormatPlaneCount(GraphicsResources::GetDevice(), desc.Format);
+
+		m_subresourceCount = desc.MipLevels * arraySize * planeCount;
+	}
+
+	return m_subresourceCount;
+}
+
+void GpuResource::Destroy()
+{
+	// Bufferul impartit sau resursa plasata pot fi inca folosite de GPU: intervalul se refoloseste abia dupa fence-ul
+	// cadrului, altfel o alocare noua ar suprascrie date citite de liste aflate in executie
+	if (m_allocation.IsValid())
+	{
+		DestroyDeferred();
+		return;
+	}
+
+	m_pResource = nullptr;
+	m_GpuVirtualAddress = D3D12_GPU_VIRTUAL_ADDRESS_NULL;
+	m_subresourceCount = 0;
+	m_bufferOffset = 0;
+
+	if (m_residencyHandle != ResidencyPolicy::InvalidHandle)
+	{
+		GraphicsResources::GetResidencyManager().Untrack(m_residencyHandle);
+		m_residencyHandle = ResidencyPolicy::InvalidHandle;
+	}
+}
+
+void GpuResource::DestroyDeferred()
+{
+	if (m_pResource == nullptr && !m_allocation.IsValid())
+	{
+		Destroy();
+		return;
+	}
+
+	// Bufferele impartite si cele plasate ocupa doar alocarea lor; cele committed tot heap-ul implicit
+	UINT64 size = m_allocation.range.size;
+	if (!m_allocation.IsValid())
+	{
+		const D3D12_RESOURCE_DESC desc = m_pResource->GetDesc();
+		size = GraphicsResources::GetDevice()->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+	}
+
+	GraphicsResources::DeferRelease(std::move(m_pResource), m_allocation, size);
+	m_allocation = {};
+
+	Destroy();
+}
+
+void GpuResource::TrackResidency(ResidencyPriority::Value priority)
+{
+	assert(m_pResource != nullptr && m_residencyHandle == ResidencyPolicy::InvalidHandle);
+
+	if (m_allocation.IsValid())
+		return;
+
+	const D3D12_RESOURCE_DESC desc = m_pResource->GetDesc();
+	const UINT64 size = GraphicsResources::GetDevice()->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+
+	m_residencyHandle = GraphicsResources::GetResidencyManager().Track(m_pResource.Get(), size, priority);
+}
+
+void GpuResource::MarkUsed()
+{
+	if (m_residencyHandle != ResidencyPolicy::InvalidHandle)
+		GraphicsResources::GetResidencyManager().MarkUsed(m_residencyHandle);
+}
+
+void GpuResource::CreateResource(
+	D3D12_HEAP_TYPE heapType,
+	const D3D12_RESOURCE_DESC& desc,
+	D3D12_RESOURCE_STATES initialState,
+	const D3D12_CLEAR_VALUE* pClearValue)
+{
+	// La recreare (rebuild) resursa veche poate fi folosita inca de cadrele in zbor
+	DestroyDeferred();
+
+	m_allocation = GraphicsResources::GetMemoryAllocator().CreateResource(
+		heapType, desc, initialState, pClearValue, m_pResource.ReleaseAndGetAddressOf());
+
+	SetInitialState(initialState);
+}
+
 void GpuResource::AllocateUAVBuffer(
 	UINT64 bufferSize, GpuResource& resource, D3D12_RESOURCE_STATES initialResourceState, std::wstring resourceName)
 {
-	HRESULT hr;
-
-	auto uploadHeapProperties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
 	auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(bufferSize, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
 
-	GFX_THROW_INFO(GraphicsResources::GetDevice()->CreateCommittedResource(
-		&uploadHeapProperties,
-		D3D12_HEAP_FLAG_NONE,
-		&bufferDesc,
-		initialResourceState,
-		nullptr,
-		IID_PPV_ARGS(resource.GetAddressOf())));
+	resource.CreateResource(D3D12_HEAP_TYPE_DEFAULT, bufferDesc, initialResourceState);
 
 	if (!resourceName.empty())
 	{
@@ -31,20 +123,9 @@ void GpuResource::AllocateUAVBuffer(
 void GpuResource::AllocateUploadBuffer(
 	const void* pData, UINT64 datasize, GpuResource& resource, std::wstring resourceName)
 {
-	HRESULT hr;
-
-	auto uploadHeapProperties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
 	auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(datasize);
 
-	GFX_THROW_INFO(GraphicsResources::GetDevice()->CreateCommittedResource(
-		&uploadHeapProperties,
-		D3D12_HEAP_FLAG_NONE,
-		&bufferDesc,
-		D3D12_RESOURCE_STATE_GENERIC_READ,
-		nullptr,
-		IID_PPV_ARGS(resource.GetAddressOf())));
-
-	resource.m_UsageState = D3D12_RESOURCE_STATE_GENERIC_READ;
+	resource.CreateResource(D3D12_HEAP_TYPE_UPLOAD, bufferDesc, D3D12_RESOURCE_STATE_GENERIC_READ);
 	resource.m_GpuVirtualAddress = resource.GetResource()->GetGPUVirtualAddress();
 
 	if (!resourceName.empty())
@@ -61,43 +142,41 @@ void GpuResource::AllocateUploadBuffer(
 	}
 }
 
-void GpuResource::AllocateDefaultBuffer(
+UINT64 GpuResource::AllocateDefaultBuffer(
 	const void* pData,
 	UINT64 datasize,
 	GpuResource& defaultResource,
-	GpuResource& uploadResource,
-	D3D12_RESOURCE_STATES resourceState,
-	std::wstring defaultResourceName,
-	std::wstring uploadResourceName)
+	UINT64 elementSize,
+	std::wstring defaultResourceName)
 {
-	HRESULT hr;
-
-	AllocateUploadBuffer(pData, datasize, uploadResource, uploadResourceName);
-
-	CD3DX12_HEAP_PROPERTIES defaultHeapProps(D3D12_HEAP_TYPE_DEFAULT);
-	auto defaultDesc = CD3DX12_RESOURCE_DESC::Buffer(datasize);
-
-	GFX_THROW_INFO(GraphicsResources::GetDevice()->CreateCommittedResource(
-		&defaultHeapProps,
-		D3D12_HEAP_FLAG_NONE,
-		&defaultDesc,
-		D3D12_RESOURCE_STATE_COMMON,
-		nullptr,
-		IID_PPV_ARGS(defaultResource.GetAddressOf())));
-
-	defaultResource.m_UsageState = D3D12_RESOURCE_STATE_COMMON;
-
-	if (!uploadResourceName.empty())
+	if (datasize <= GpuMemoryAllocator::PackedBufferMaxSize)
 	{
-		uploadResource->SetName(uploadResourceName.c_str());
+		defaultResource.DestroyDeferred();
+
+		// Bufferul comun e creat in COMMON si ramane acolo; numele lui nu se schimba
+		defaultResource.m_allocation = GraphicsResources::GetMemoryAllocator().AllocateBufferRange(
+			datasize,
+			elementSize,
+			defaultResource.m_pResource.ReleaseAndGetAddressOf(),
+			defaultResource.m_bufferOffset);
+		defaultResource.SetInitialState(D3D12_RESOURCE_STATE_COMMON);
 	}
+	else
+	{
+		auto defaultDesc = CD3DX12_RESOURCE_DESC::Buffer(datasize);
+		defaultResource.CreateResource(D3D12_HEAP_TYPE_DEFAULT, defaultDesc, D3D12_RESOURCE_STATE_COMMON);
 
-	GraphicsResources::GetContextManager().GetGraphicsContext().CopyBuffer(defaultResource, uploadResource);
-	GraphicsResources::GetContextManager().GetGraphicsContext().TransitionResource(defaultResource, resourceState);
+		if (!defaultResourceName.empty())
+		{
+			defaultResource->SetName(defaultResourceName.c_str());
+		}
+	}
 
-	// GraphicsResources::GetContextManager().End();
-	GraphicsResources::GetContextManager().Flush(true);
-	GraphicsResources::GetContextManager().GetGraphicsContext().Reset();
+	defaultResource.m_GpuVirtualAddress =
+		defaultResource->GetGPUVirtualAddress() + defaultResource.m_bufferOffset;
+
+	return GraphicsResources::GetUploadManager().UploadBuffer(
+		defaultResource, defaultResource.m_bufferOffset, pData, datasize);
 }
 
 engine::gfx::DescriptorHandle GpuResource::CreateTextureView(GpuResource& texture, D3D12_SHADER_RESOURCE_VIEW_DESC* descriptor)
@@ -147,6 +226,12 @@ engine::gfx::DescriptorHandle GpuResource::CreateBufferSRV(GpuResource& buffer,
 	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
 	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 	srvDesc.Buffer.NumElements = numElements;
+
+	// Bufferele care impart un buffer comun incep la offset-ul lor, multiplu de marimea elementului
+	const UINT64 firstElementSize = elementSize == 0 ? 4 : elementSize;
+	assert(buffer.m_bufferOffset % firstElementSize == 0);
+	srvDesc.Buffer.FirstElement = buffer.m_bufferOffset / firstElementSize;
+
 	if (elementSize == 0)
 	{
 		srvDesc.Format = DXGI_FORMAT_R32_TYPELESS;
@@ -188,10 +273,9 @@ void VertexBuffer::Create(const Mesh& mesh)
 		reinterpret_cast<const void*>(mesh.GetVerticesData()),
 		mesh.GetVerticesDataSize(),
 		*this,
-		m_uploadResource,
-		D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+		Mesh::GetSizeOfVertex());
 
-	m_vertexBufferView.BufferLocation = m_pResource->GetGPUVirtualAddress();
+	m_vertexBufferView.BufferLocation = m_GpuVirtualAddress;
 	m_vertexBufferView.StrideInBytes = (UINT)Mesh::GetSizeOfVertex();
 	m_vertexBufferView.SizeInBytes = m_vertexBufferSize;
 }
@@ -210,10 +294,9 @@ void IndexBuffer::Create(const Mesh& mesh)
 		reinterpret_cast<const void*>(mesh.GetIndicesData()),
 		mesh.GetIndicesDataSize(),
 		*this,
-		m_uploadResource,
-		D3D12_RESOURCE_STATE_INDEX_BUFFER);
+		sizeof(UINT));
 
-	m_indexBufferView.BufferLocation = m_pResource->GetGPUVirtualAddress();
+	m_indexBufferView.BufferLocation = m_GpuVirtualAddress;
 	m_indexBufferView.Format = DXGI_FORMAT_R32_UINT;
 	m_indexBufferView.SizeInBytes = m_indexBufferSize;
 }
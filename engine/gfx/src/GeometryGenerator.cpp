@@ -1,5 +1,7 @@
 #include "GeometryGenerator.hpp"
 
+#include "ChunkOrdering.hpp"
+
 namespace engine::gfx
 {
 
@@ -441,6 +443,11 @@ Mesh::Ptr GeometryGenerator::GenerateChunk(
 	return mesh;
 }
 
+int GeometryGenerator::GetChunksSidePointCount(const int chunkKernelSize, const int chunkCountPerSide)
+{
+	return 2 * chunkKernelSize + chunkCountPerSide - 3 + (chunkKernelSize - 2) * (chunkCountPerSide - 2);
+}
+
 Mesh::Ptr GeometryGenerator::GenerateChunks(
 	std::vector<engine::math::AABB>& aabbs,
 	std::vector<SubMesh>& submeshs,
@@ -452,8 +459,7 @@ Mesh::Ptr GeometryGenerator::GenerateChunks(
 {
 	using namespace engine::math;
 
-	const int sidePointCount =
-		2 * chunkKernelSize + chunkCountPerSide - 3 + (chunkKernelSize - 2) * (chunkCountPerSide - 2);
+	const int sidePointCount = GetChunksSidePointCount(chunkKernelSize, chunkCountPerSide);
 
 	const float dz = gridWidth / sidePointCount;
 	const float dx = gridLength / sidePointCount;
@@ -493,40 +499,50 @@ Mesh::Ptr GeometryGenerator::GenerateChunks(
 		}
 	}
 
-	for (int i = 0; i < chunkCountPerSide; i++)
+	// Chunk-urile (si intervalele lor de indecsi) se aseaza de-a lungul unei curbe Hilbert:
+	// chunk-uri vecine in spatiu sunt vecine si in memorie, pentru culling si pentru ordonarea pe distanta
+	int curveSide = 1;
+	while (curveSide < chunkCountPerSide)
+		curveSide *= 2;
+
+	for (int d = 0; d < curveSide * curveSide; d++)
 	{
-		for (int j = 0; j < chunkCountPerSide; j++)
-		{
-			int startVertexPosition = (chunkKernelSize - 1) * j + (chunkKernelSize - 1) * i * sidePointCount;
+		int i, j;
+		ChunkOrdering::HilbertCurveToGrid(curveSide, d, i, j);
 
-			for (int k = startVertexPosition; k < startVertexPosition + chunkKernelSize - 1; k++)
-			{
-				for (int l = 0; l < chunkKernelSize - 1; l++)
-				{
-					indices.push_back(k + l * sidePointCount);
-					indices.push_back(k + 1 + (l + 1) * sidePointCount);
-					indices.push_back(k + (l + 1) * sidePointCount);
-
-					indices.push_back(k + l * sidePointCount);
-					indices.push_back(k + 1 + l * sidePointCount);
-					indices.push_back(k + 1 + (l + 1) * sidePointCount);
-				}
-			}
+		// Pentru un numar de chunk-uri care nu e putere a lui 2 se sare peste celulele din afara grilei
+		if (i >= chunkCountPerSide || j >= chunkCountPerSide)
+			continue;
 
-			SubMesh subMesh;
-			subMesh.baseVertexLocation = 0;
-			subMesh.indexCount = 6 * (size_t)pow(chunkKernelSize - 1, 2);
-			subMesh.startIndexLocation = indices.size() - subMesh.indexCount;
+		int startVertexPosition = (chunkKernelSize - 1) * j + (chunkKernelSize - 1) * i * sidePointCount;
 
-			engine::math::AABB aabb;
-			for (int i = 0; i < subMesh.indexCount; i++)
+		for (int k = startVertexPosition; k < startVertexPosition + chunkKernelSize - 1; k++)
+		{
+			for (int l = 0; l < chunkKernelSize - 1; l++)
 			{
-				aabb.EnlargeForPoint(vertices[indices[i + subMesh.startIndexLocation]].position);
+				indices.push_back(k + l * sidePointCount);
+				indices.push_back(k + 1 + (l + 1) * sidePointCount);
+				indices.push_back(k + (l + 1) * sidePointCount);
+
+				indices.push_back(k + l * sidePointCount);
+				indices.push_back(k + 1 + l * sidePointCount);
+				indices.push_back(k + 1 + (l + 1) * sidePointCount);
 			}
+		}
 
-			submeshs.push_back(subMesh);
-			aabbs.push_back(aabb);
+		SubMesh subMesh;
+		subMesh.baseVertexLocation = 0;
+		subMesh.indexCount = 6 * (size_t)pow(chunkKernelSize - 1, 2);
+		subMesh.startIndexLocation = indices.size() - subMesh.indexCount;
+
+		engine::math::AABB aabb;
+		for (int k = 0; k < subMesh.indexCount; k++)
+		{
+			aabb.EnlargeForPoint(vertices[indices[k + subMesh.startIndexLocation]].position);
 		}
+
+		submeshs.push_back(subMesh);
+		aabbs.push_back(aabb);
 	}
 
 	Mesh::Ptr mesh = Mesh::Ptr(new Mesh(vertices, indices));
@@ -1,12 +1,18 @@
 #include "GeometryRenderer.hpp"
 
+#include "ChunkOrdering.hpp"
+
+#include <cmath>
+
 namespace engine::gfx
 {
 
-void GeometryRenderer::ReleaseUploadBuffers()
+void GeometryRenderer::ReleaseCpuGeometry()
 {
-	// m_vertexBuffer->ReleaseUploadBuffer();
-	// m_indexBuffer->ReleaseUploadBuffer();
+	if (m_mesh == nullptr)
+		return;
+
+	GraphicsResources::DeferRelease(std::move(m_mesh));
 }
 
 ID3D12Resource* GeometryRenderer::GetBottomLevelAccelerationStructure()
@@ -32,10 +38,167 @@ void GeometryRenderer::CreateVertexAndIndexBuffer(bool allocateSRVs)
 			== (m_vertexBuffer->GetSRVHandle()
 				+ GraphicsResources::GetInstance().GetDescriptorIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV)));
 	}
+
+	ReleaseCpuGeometry();
+}
+
+void GeometryRenderer::OrderChunksFrontToBack(
+	const std::vector<Chunk>& chunks,
+	const engine::math::Float3& cameraPosition,
+	float maxDistance,
+	std::vector<UINT>& drawOrder)
+{
+	const engine::math::Vector3 position(cameraPosition[0], cameraPosition[1], cameraPosition[2]);
+	const auto distance = [&chunks, &position](uint32_t i) -> float
+	{
+		return std::sqrt((chunks[i].GetAABB().GetCenter() - position).Length2());
+	};
+
+	ChunkOrdering::SortByDistanceBands<ChunkDistanceBandCount>(
+		(uint32_t)chunks.size(), distance, maxDistance, drawOrder);
+}
+
+void GeometryRenderer::BuildDrawRanges(
+	const std::vector<Chunk>& chunks, const std::vector<UINT>& drawOrder, ViewDrawRanges& drawRanges)
+{
+	for (auto& merger : drawRanges)
+	{
+		merger.Reset();
+	}
+
+	for (const UINT chunkIndex : drawOrder)
+	{
+		if (chunks[chunkIndex].IsVisible(CullingView::Main))
+			drawRanges[CullingView::Main].Add(chunks[chunkIndex].GetSubMesh());
+	}
+
+	for (const auto& chunk : chunks)
+	{
+		for (UINT view = CullingView::Main + 1; view < CullingView::Count; view++)
+		{
+			if (chunk.IsVisible((CullingView::Value)view))
+				drawRanges[view].Add(chunk.GetSubMesh());
+		}
+	}
+}
+
+void GeometryRenderer::CreateIndirectChunkDraws(UINT maxDrawsPerView)
+{
+	m_indirectChunkDraws.Create(CullingView::Count, maxDrawsPerView);
+	m_indirectChunkArguments.Create(
+		GraphicsResources::GetDevice(),
+		m_indirectChunkDraws,
+		engine::core::Settings::GetFrameResourcesCount(),
+		L"Indirect chunk arguments");
+
+	m_drawIndexedSignature = CommandSignature::CreateDrawIndexed(GraphicsResources::GetDevice());
+}
+
+void GeometryRenderer::BuildIndirectChunkDraws(const ViewDrawRanges& drawRanges)
+{
+	m_indirectChunkDraws.Reset();
+
+	for (UINT view = 0; view < CullingView::Count; view++)
+	{
+		for (const DrawRange& range : drawRanges[view].GetRanges())
+		{
+			m_indirectChunkDraws.Add(view, MakeIndirectDrawArguments(range));
+		}
+	}
+}
+
+void GeometryRenderer::UploadIndirectDraws()
+{
+	if (!UseIndirectChunkDraws())
+		return;
+
+	m_indirectChunkArguments.Upload(GraphicsResources::GetContextManager().GetFrameIndex(), m_indirectChunkDraws);
+}
+
+void GeometryRenderer::DrawChunksIndirect(GraphicsContext& graphicsContext, CullingView::Value view) const
+{
+	const UINT64 frameOffset =
+		m_indirectChunkArguments.GetFrameOffset(GraphicsResources::GetContextManager().GetFrameIndex());
+
+	graphicsContext.ExecuteIndirect(
+		*m_drawIndexedSignature,
+		m_indirectChunkDraws.GetMaxDrawsPerView(),
+		m_indirectChunkArguments.GetD3D12Resource(),
+		frameOffset + m_indirectChunkDraws.GetArgumentOffset(view),
+		m_indirectChunkArguments.GetD3D12Resource(),
+		frameOffset + m_indirectChunkDraws.GetCountOffset(view));
+}
+
+uint32_t GeometryRenderer::nextMeshSortID = 0;
+
+GeometryRenderer::GeometryRenderer() : m_meshSortID(nextMeshSortID++)
+{
 }
 
 GeometryRenderer::~GeometryRenderer()
 {
 }
 
+void GeometryRenderer::SubmitDraws(
+	RenderQueue<DrawPacket>& queue,
+	engine::gfx::rasterization::RenderLayer::Value renderLayer,
+	const BaseCamera& camera) const
+{
+}
+
+DrawPacket GeometryRenderer::MakeDrawPacket(engine::gfx::rasterization::RenderLayer::Value renderLayer) const
+{
+	DrawPacket packet;
+	packet.vertexBufferView = &m_vertexBuffer->GetVertexBufferView();
+	packet.indexBufferView = &m_indexBuffer->GetIndexBufferView();
+
+	switch (renderLayer)
+	{
+	case rasterization::RenderLayer::Base:
+		packet.pso = m_basePSO.get();
+		packet.topology = m_baseToplogy;
+		break;
+	case rasterization::RenderLayer::CubeMap:
+		packet.pso = m_dynamicCubeMapPSO.get();
+		packet.topology = m_dynamicCubeMapTopology;
+		break;
+	case rasterization::RenderLayer::ShadowMap:
+		packet.pso = m_shadowPSO.get();
+		packet.topology = m_shadowTopology;
+		break;
+	default: throw engine::core::CustomException("Tip de randare inexistent!!");
+	}
+
+	return packet;
+}
+
+void GeometryRenderer::SubmitChunkDraws(
+	RenderQueue<DrawPacket>& queue,
+	uint64_t key,
+	DrawPacket packet,
+	const ViewDrawRanges& drawRanges,
+	CullingView::Value view) const
+{
+	if (UseIndirectChunkDraws())
+	{
+		const UINT64 frameOffset =
+			m_indirectChunkArguments.GetFrameOffset(GraphicsResources::GetContextManager().GetFrameIndex());
+
+		packet.signature = m_drawIndexedSignature.get();
+		packet.maxCommandCount = m_indirectChunkDraws.GetMaxDrawsPerView();
+		packet.argumentBuffer = m_indirectChunkArguments.GetD3D12Resource();
+		packet.argumentOffset = frameOffset + m_indirectChunkDraws.GetArgumentOffset(view);
+		packet.countOffset = frameOffset + m_indirectChunkDraws.GetCountOffset(view);
+
+		queue.Submit(key, packet);
+		return;
+	}
+
+	for (const DrawRange& range : drawRanges[view].GetRanges())
+	{
+		packet.draw = MakeIndirectDrawArguments(range);
+		queue.Submit(key, packet);
+	}
+}
+
 }  // namespace engine::gfx
@@ -0,0 +1,242 @@
+#include "GpuMemoryAllocator.hpp"
+
+#include "GraphicsResources.hpp"
+#include "d3dx12.h"
+#include "engine/core/DxgiInfoManager.hpp"
+#include "engine/core/GraphicsThrowMacros.hpp"
+
+#include <cassert>
+
+namespace engine::gfx
+{
+
+namespace
+{
+
+constexpr UINT64 DefaultHeapSize = 64ull * 1024 * 1024;
+constexpr UINT64 UploadHeapSize = 16ull * 1024 * 1024;
+constexpr UINT64 PackedBufferSize = 4ull * 1024 * 1024;
+// Cea mai mica aliniere a bufferelor din default heap care pot fi citite ca vertex / index / constant buffer
+constexpr UINT64 PackedBufferMinAllocationSize = 256;
+
+}  // namespace
+
+void GpuMemoryAllocator::Create()
+{
+	m_pools[GpuMemoryPool::DefaultBuffers].memory.Create(DefaultHeapSize, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+	m_pools[GpuMemoryPool::DefaultBuffers].heapType = D3D12_HEAP_TYPE_DEFAULT;
+	m_pools[GpuMemoryPool::DefaultBuffers].heapFlags = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+
+	m_pools[GpuMemoryPool::DefaultTextures].memory.Create(DefaultHeapSize, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+	m_pools[GpuMemoryPool::DefaultTextures].heapType = D3D12_HEAP_TYPE_DEFAULT;
+	m_pools[GpuMemoryPool::DefaultTextures].heapFlags = D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+
+	m_pools[GpuMemoryPool::UploadBuffers].memory.Create(UploadHeapSize, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+	m_pools[GpuMemoryPool::UploadBuffers].heapType = D3D12_HEAP_TYPE_UPLOAD;
+	m_pools[GpuMemoryPool::UploadBuffers].heapFlags = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+
+	m_pools[GpuMemoryPool::PackedBuffers].memory.Create(PackedBufferSize, PackedBufferMinAllocationSize);
+	m_pools[GpuMemoryPool::PackedBuffers].heapType = D3D12_HEAP_TYPE_DEFAULT;
+	m_pools[GpuMemoryPool::PackedBuffers].heapFlags = D3D12_HEAP_FLAG_NONE;
+}
+
+GpuAllocation GpuMemoryAllocator::CreateResource(
+	D3D12_HEAP_TYPE heapType,
+	const D3D12_RESOURCE_DESC& desc,
+	D3D12_RESOURCE_STATES initialState,
+	const D3D12_CLEAR_VALUE* pClearValue,
+	ID3D12Resource** ppResource)
+{
+	HRESULT hr;
+
+	GpuAllocation allocation;
+	allocation.pool = SelectPool(heapType, desc);
+
+	D3D12_RESOURCE_ALLOCATION_INFO allocationInfo = {};
+	if (allocation.IsValid())
+	{
+		allocationInfo = GraphicsResources::GetDevice()->GetResourceAllocationInfo(0, 1, &desc);
+
+		// Ar ocupa aproape tot heap-ul: un heap propriu (committed) nu risipeste restul
+		if (allocationInfo.SizeInBytes > m_pools[allocation.pool].memory.GetBlockSize() / 2)
+			allocation.pool = GpuMemoryPool::Count;
+	}
+
+	if (!allocation.IsValid())
+	{
+		CD3DX12_HEAP_PROPERTIES heapProperties(heapType);
+		GFX_THROW_INFO(GraphicsResources::GetDevice()->CreateCommittedResource(
+			&heapProperties, D3D12_HEAP_FLAG_NONE, &desc, initialState, pClearValue, IID_PPV_ARGS(ppResource)));
+
+		return allocation;
+	}
+
+	allocation.range = AllocateRange(allocation.pool, allocationInfo.SizeInBytes, allocationInfo.Alignment);
+
+	GFX_THROW_INFO(GraphicsResources::GetDevice()->CreatePlacedResource(
+		m_pools[allocation.pool].heaps[allocation.range.block].Get(),
+		allocation.range.offset,
+		&desc,
+		initialState,
+		pClearValue,
+		IID_PPV_ARGS(ppResource)));
+
+	return allocation;
+}
+
+GpuAllocation GpuMemoryAllocator::AllocateBufferRange(
+	UINT64 size, UINT64 alignment, ID3D12Resource** ppResource, UINT64& bufferOffset)
+{
+	assert(alignment != 0 && size <= PackedBufferMaxSize);
+
+	GpuAllocation allocation;
+	allocation.pool = GpuMemoryPool::PackedBuffers;
+
+	// Alinierile care nu sunt puteri ale lui 2 (ex. stride-ul unui structured buffer) se obtin cu padding in interval
+	if ((alignment & (alignment - 1)) == 0)
+		allocation.range = AllocateRange(allocation.pool, size, alignment);
+	else
+		allocation.range = AllocateRange(allocation.pool, size + alignment - 1, 1);
+
+	bufferOffset = (allocation.range.offset + alignment - 1) / alignment * alignment;
+	m_pools[allocation.pool].buffers[allocation.range.block].CopyTo(ppResource);
+
+	return allocation;
+}
+
+void GpuMemoryAllocator::Free(const GpuAllocation& allocation)
+{
+	if (!allocation.IsValid())
+		return;
+
+	Pool& pool = m_pools[allocation.pool];
+
+	// Ultimul heap al pool-ului se pastreaza, ca alocarile urmatoare sa nu-l recreeze
+	if (pool.memory.Free(allocation.range) && pool.memory.GetBlockCount() > 1)
+		RemoveBlock(allocation.pool, allocation.range.block);
+}
+
+std::vector<MemoryMove> GpuMemoryAllocator::PlanDefragmentation(GpuMemoryPool::Value pool, size_t maxMoves)
+{
+	return m_pools[pool].memory.PlanDefragmentation(maxMoves);
+}
+
+ID3D12Heap* GpuMemoryAllocator::GetHeap(GpuMemoryPool::Value pool, uint32_t block) const
+{
+	assert(m_pools[pool].memory.IsBlockUsed(block));
+
+	return m_pools[pool].heaps[block].Get();
+}
+
+UINT64 GpuMemoryAllocator::GetReservedSize() const
+{
+	UINT64 reservedSize = 0;
+
+	// Bufferele comune ale PackedBuffers sunt deja alocari in DefaultBuffers
+	for (UINT pool = 0; pool < GpuMemoryPool::PackedBuffers; pool++)
+	{
+		reservedSize += m_pools[pool].memory.GetBlockCount() * m_pools[pool].memory.GetBlockSize();
+	}
+
+	return reservedSize;
+}
+
+UINT64 GpuMemoryAllocator::GetUsedSize() const
+{
+	UINT64 usedSize = 0;
+
+	for (UINT pool = 0; pool < GpuMemoryPool::PackedBuffers; pool++)
+	{
+		usedSize += m_pools[pool].memory.GetUsedSize();
+	}
+
+	return usedSize;
+}
+
+GpuMemoryPool::Value GpuMemoryAllocator::SelectPool(D3D12_HEAP_TYPE heapType, const D3D12_RESOURCE_DESC& desc)
+{
+	if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+	{
+		if (heapType == D3D12_HEAP_TYPE_DEFAULT)
+			return GpuMemoryPool::DefaultBuffers;
+		if (heapType == D3D12_HEAP_TYPE_UPLOAD)
+			return GpuMemoryPool::UploadBuffers;
+
+		return GpuMemoryPool::Count;
+	}
+
+	// Tintele de randare si MSAA cer alta aliniere si alte flag-uri de heap; sunt putine si mari
+	const D3D12_RESOURCE_FLAGS targetFlags =
+		D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+	if (heapType == D3D12_HEAP_TYPE_DEFAULT && (desc.Flags & targetFlags) == 0 && desc.SampleDesc.Count == 1)
+		return GpuMemoryPool::DefaultTextures;
+
+	return GpuMemoryPool::Count;
+}
+
+MemoryAllocation GpuMemoryAllocator::AllocateRange(GpuMemoryPool::Value pool, UINT64 size, UINT64 alignment)
+{
+	MemoryAllocation range;
+
+	if (!m_pools[pool].memory.Allocate(size, alignment, range))
+	{
+		AddBlock(pool);
+
+		[[maybe_unused]] const bool isAllocated = m_pools[pool].memory.Allocate(size, alignment, range);
+		assert(isAllocated);
+	}
+
+	return range;
+}
+
+void GpuMemoryAllocator::AddBlock(GpuMemoryPool::Value pool)
+{
+	HRESULT hr;
+
+	Pool& memoryPool = m_pools[pool];
+
+	const uint32_t block = memoryPool.memory.AddBlock();
+	if (block >= memoryPool.heaps.size())
+	{
+		memoryPool.heaps.resize(block + 1);
+		memoryPool.buffers.resize(block + 1);
+		memoryPool.bufferAllocations.resize(block + 1);
+	}
+
+	if (pool == GpuMemoryPool::PackedBuffers)
+	{
+		const CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(PackedBufferSize);
+		memoryPool.bufferAllocations[block] = CreateResource(
+			D3D12_HEAP_TYPE_DEFAULT,
+			bufferDesc,
+			D3D12_RESOURCE_STATE_COMMON,
+			nullptr,
+			memoryPool.buffers[block].ReleaseAndGetAddressOf());
+		memoryPool.buffers[block]->SetName(L"PackedBuffer");
+
+		return;
+	}
+
+	D3D12_HEAP_DESC heapDesc = {};
+	heapDesc.SizeInBytes = memoryPool.memory.GetBlockSize();
+	heapDesc.Properties = CD3DX12_HEAP_PROPERTIES(memoryPool.heapType);
+	heapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+	heapDesc.Flags = memoryPool.heapFlags;
+
+	GFX_THROW_INFO(GraphicsResources::GetDevice()->CreateHeap(
+		&heapDesc, IID_PPV_ARGS(memoryPool.heaps[block].ReleaseAndGetAddressOf())));
+}
+
+void GpuMemoryAllocator::RemoveBlock(GpuMemoryPool::Value pool, uint32_t block)
+{
+	Pool& memoryPool = m_pools[pool];
+
+	memoryPool.memory.RemoveBlock(block);
+	memoryPool.heaps[block].Reset();
+	memoryPool.buffers[block].Reset();
+
+	Free(memoryPool.bufferAllocations[block]);
+	memoryPool.bufferAllocations[block] = {};
+}
+
+}  // namespace engine::gfx
@@ -9,11 +9,25 @@ namespace engine::gfx
 
 using namespace Microsoft::WRL;
 
+namespace
+{
+
+// Regiunile heap-ului CBV / SRV / UAV: vederile resurselor, apoi inelul tabelelor tranzitorii
+constexpr UINT PersistentDescriptorCount = 1024;
+constexpr UINT TransientDescriptorCount = 1024;
+
+}  // namespace
+
 std::unique_ptr<GraphicsResources> GraphicsResources::instance = nullptr;
 
 GraphicsResources::~GraphicsResources()
 {
 	pContextManager->End();
+
+	// GPU-ul e oprit dupa End: ce se elibereaza de aici (inclusiv resursele membre) nu mai asteapta un fence.
+	// Memoria se intoarce in heap-uri inainte ca allocatorul sa fie distrus
+	m_isTearingDown = true;
+	m_deferredReleases.ReleaseAll([this](DeferredRelease& deferredRelease) { ReleaseDeferred(deferredRelease); });
 }
 
 void GraphicsResources::BeginFrame()
@@ -94,8 +108,25 @@ void GraphicsResources::EndFrame()
 		graphicsContext.TransitionResource(*m_renderTargetTextures[m_backBufferIndex], D3D12_RESOURCE_STATE_PRESENT);
 	}
 
+	// Tabelele tranzitorii ale cadrului se completeaza inainte de submit si se elibereaza cu fence-ul lui
+	DescriptorHeap& shaderVisibleHeap = m_descriptorHeaps[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV];
+	shaderVisibleHeap.FlushStagedCopies(pDevice.Get());
+
+	// Listele cadrului sunt inregistrate, deci resursele folosite de ele sunt marcate si nu se evacueaza
+	pResidencyManager->Update(pContextManager->GetCompletedFenceValue());
+
 	pContextManager->SwapContext();
 
+	pResidencyManager->RetireFrame(pContextManager->GetSubmittedFenceValue());
+
+	shaderVisibleHeap.RetireTransient(pContextManager->GetSubmittedFenceValue());
+	shaderVisibleHeap.ReclaimTransient(pContextManager->GetCompletedFenceValue());
+
+	m_deferredReleases.Retire(pContextManager->GetSubmittedFenceValue());
+	m_deferredReleases.Release(
+		pContextManager->GetCompletedFenceValue(),
+		[this](DeferredRelease& deferredRelease) { ReleaseDeferred(deferredRelease); });
+
 #if _DEBUG
 	engine::core::DxgiInfoManager::GetInstance().Set();
 #endif
@@ -170,10 +201,24 @@ void GraphicsResources::CreateDeviceResources()
 
 	engine::gfx::SetOptimalMSAALevel(pDevice.Get(), m_backBufferFormat);
 
+	pMemoryAllocator = std::make_unique<GpuMemoryAllocator>();
+	pMemoryAllocator->Create();
+
+	// Bugetul de memorie video vine de la adaptorul pe care s-a creat device-ul
+	ComPtr<IDXGIAdapter3> adapter;
+	GFX_THROW_INFO(pFactory->EnumAdapterByLuid(pDevice->GetAdapterLuid(), IID_PPV_ARGS(&adapter)));
+
+	pResidencyManager = std::make_unique<ResidencyManager>();
+	pResidencyManager->Create(pDevice.Get(), adapter.Get());
+
 	//////////////////////////////////////////////////////////////////////////////////////////////////
 	// Creare descriptor heaps
 	m_descriptorHeaps[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV].Create(
-		GetDevice(), L"CbvSrvUavHeap", D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 30);
+		GetDevice(),
+		L"CbvSrvUavHeap",
+		D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV,
+		PersistentDescriptorCount,
+		TransientDescriptorCount);
 	m_descriptorHeaps[D3D12_DESCRIPTOR_HEAP_TYPE_RTV].Create(
 		GetDevice(), L"RtvHeap", D3D12_DESCRIPTOR_HEAP_TYPE_RTV, 10);
 	m_descriptorHeaps[D3D12_DESCRIPTOR_HEAP_TYPE_DSV].Create(
@@ -230,9 +275,11 @@ GraphicsResources& GraphicsResources::GetInstance()
 void GraphicsResources::DestroyInstance()
 {
 	if (!instance)
-		delete instance.release();
+		return;
 
-	instance = nullptr;
+	// GetInstance ramane valid cat timp ruleaza destructorul: resursele membre isi elibereaza memoria prin el
+	delete instance.get();
+	instance.release();
 }
 
 void GraphicsResources::OnSizeChanged(UINT width, UINT height)
@@ -263,6 +310,17 @@ void GraphicsResources::LoadSizeDependentResoruces(UINT width, UINT height)
 {
 	CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_DEFAULT);
 
+	// Flush-ul din OnSizeChanged a asteptat GPU-ul; texturile noi refolosesc sloturile vederilor vechi
+	for (auto& renderTarget : m_renderTargetTextures)
+	{
+		if (renderTarget)
+			renderTarget->ReleaseDescriptors();
+	}
+	if (m_renderTexture)
+		m_renderTexture->ReleaseDescriptors();
+	if (m_depthTexture)
+		m_depthTexture->ReleaseDescriptors();
+
 	for (UINT i = 0; i < engine::core::Settings::GetBackBufferCount(); i++)
 	{
 		m_renderTargetTextures[i].reset(new ColorTexture());
@@ -304,9 +362,58 @@ void GraphicsResources::LoadSizeDependentResoruces(UINT width, UINT height)
 	}
 }
 
-engine::gfx::DescriptorHandle GraphicsResources::AllocateDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE heapType)
+engine::gfx::DescriptorHandle GraphicsResources::AllocateDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE heapType, UINT count)
 {
-	return GetInstance().m_descriptorHeaps[heapType].Alloc();
+	return GetInstance().m_descriptorHeaps[heapType].Alloc(count);
+}
+
+void GraphicsResources::FreeDescriptor(
+	D3D12_DESCRIPTOR_HEAP_TYPE heapType, const engine::gfx::DescriptorHandle& handle, UINT count)
+{
+	GetInstance().m_descriptorHeaps[heapType].Free(handle, count);
+}
+
+engine::gfx::DescriptorHandle GraphicsResources::StageDescriptorTable(
+	const D3D12_CPU_DESCRIPTOR_HANDLE* pSources, UINT count)
+{
+	return GetInstance().m_descriptorHeaps[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV].StageTable(pSources, count);
+}
+
+void GraphicsResources::DeferRelease(ComPtr<ID3D12Resource> pResource, const GpuAllocation& allocation, UINT64 size)
+{
+	GraphicsResources& graphicsResources = GetInstance();
+	DeferredRelease deferredRelease = {std::move(pResource), allocation, nullptr};
+
+	if (graphicsResources.m_isTearingDown)
+	{
+		graphicsResources.ReleaseDeferred(deferredRelease);
+		return;
+	}
+
+	// Se leaga de fence-ul cadrului la EndFrame: listele inregistrate pana atunci pleaca cel tarziu cu el
+	graphicsResources.m_deferredReleases.Push(std::move(deferredRelease), size);
+}
+
+void GraphicsResources::DeferRelease(Mesh::Ptr mesh)
+{
+	// Coada directa asteapta pe GPU copierile trimise inaintea ei, deci dupa fence-ul cadrului si uploadul s-a terminat
+	const UINT64 size = mesh->GetVerticesDataSize() + mesh->GetIndicesDataSize();
+
+	GraphicsResources& graphicsResources = GetInstance();
+	if (graphicsResources.m_isTearingDown)
+		return;
+
+	graphicsResources.m_deferredReleases.Push({nullptr, {}, std::move(mesh)}, size);
+}
+
+void GraphicsResources::ReleaseDeferred(DeferredRelease& deferredRelease)
+{
+	deferredRelease.pResource = nullptr;
+	deferredRelease.mesh.reset();
+
+	// Resursa plasata s-a distrus deja, deci memoria ei se poate refolosi
+	if (deferredRelease.allocation.IsValid())
+		pMemoryAllocator->Free(deferredRelease.allocation);
 }
 
 void GraphicsResources::LoadResources(
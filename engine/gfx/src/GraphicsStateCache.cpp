@@ -0,0 +1,167 @@
+#include "GraphicsStateCache.hpp"
+
+namespace engine::gfx
+{
+
+void GraphicsStateCache::Reset()
+{
+	Invalidate();
+	m_statistics = {};
+}
+
+void GraphicsStateCache::Invalidate()
+{
+	m_pipelineState = nullptr;
+	m_rootSignature = nullptr;
+	m_isTopologyValid = false;
+	m_vertexBufferValidMask = 0;
+	m_isIndexBufferValid = false;
+	InvalidateRootArguments();
+}
+
+bool GraphicsStateCache::SetPipelineState(const void* pipelineState)
+{
+	if (pipelineState != nullptr && pipelineState == m_pipelineState)
+	{
+		m_statistics.pipelineStates++;
+		return false;
+	}
+
+	m_pipelineState = pipelineState;
+	return true;
+}
+
+bool GraphicsStateCache::SetRootSignature(const void* rootSignature)
+{
+	if (rootSignature != nullptr && rootSignature == m_rootSignature)
+	{
+		m_statistics.rootSignatures++;
+		return false;
+	}
+
+	// Un root signature nou sterge toate root argumentele
+	m_rootSignature = rootSignature;
+	InvalidateRootArguments();
+
+	return true;
+}
+
+bool GraphicsStateCache::SetPrimitiveTopology(uint32_t topology)
+{
+	if (m_isTopologyValid && topology == m_topology)
+	{
+		m_statistics.primitiveTopologies++;
+		return false;
+	}
+
+	m_isTopologyValid = true;
+	m_topology = topology;
+
+	return true;
+}
+
+bool GraphicsStateCache::SetVertexBuffers(uint32_t startSlot, uint32_t count, const VertexBufferState* states)
+{
+	bool anyChanged = false;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		const uint32_t slot = startSlot + i;
+		if (slot >= MaxVertexBufferSlots)
+		{
+			anyChanged = true;
+			continue;
+		}
+
+		VertexBufferState& state = m_vertexBuffers[slot];
+		const uint32_t slotBit = 1u << slot;
+
+		if ((m_vertexBufferValidMask & slotBit) && state.location == states[i].location
+			&& state.sizeInBytes == states[i].sizeInBytes && state.strideInBytes == states[i].strideInBytes)
+			continue;
+
+		m_vertexBufferValidMask |= slotBit;
+		state = states[i];
+		anyChanged = true;
+	}
+
+	if (!anyChanged)
+		m_statistics.vertexBuffers++;
+
+	return anyChanged;
+}
+
+bool GraphicsStateCache::SetIndexBuffer(uint64_t location, uint32_t sizeInBytes, uint32_t format)
+{
+	if (m_isIndexBufferValid && m_indexBufferLocation == location && m_indexBufferSize == sizeInBytes
+		&& m_indexBufferFormat == format)
+	{
+		m_statistics.indexBuffers++;
+		return false;
+	}
+
+	m_isIndexBufferValid = true;
+	m_indexBufferLocation = location;
+	m_indexBufferSize = sizeInBytes;
+	m_indexBufferFormat = format;
+
+	return true;
+}
+
+bool GraphicsStateCache::SetRootArgument(uint32_t rootIndex, uint64_t value)
+{
+	if (rootIndex >= MaxRootParameters)
+		return true;
+
+	const uint64_t rootBit = 1ull << rootIndex;
+
+	if ((m_rootArgumentValidMask & rootBit) && m_rootArguments[rootIndex] == value)
+	{
+		m_statistics.rootArguments++;
+		return false;
+	}
+
+	m_rootArgumentValidMask |= rootBit;
+	m_rootArguments[rootIndex] = value;
+
+	return true;
+}
+
+bool GraphicsStateCache::SetRootConstants(
+	uint32_t rootIndex, uint32_t destOffset, uint32_t count, const uint32_t* values)
+{
+	if (rootIndex >= MaxRootParameters || count == 0)
+		return true;
+
+	const uint64_t rootBit = 1ull << rootIndex;
+
+	// Dword-urile de dupa cele retinute nu se pot compara
+	bool isRedundant = destOffset + count <= MaxCachedRootConstants;
+	for (uint32_t i = 0; i < count && isRedundant; i++)
+	{
+		const uint32_t offset = destOffset + i;
+		isRedundant = (m_rootConstantValidMasks[offset] & rootBit) && m_rootConstants[rootIndex][offset] == values[i];
+	}
+
+	if (isRedundant)
+	{
+		m_statistics.rootArguments++;
+		return false;
+	}
+
+	for (uint32_t i = 0; i < count && destOffset + i < MaxCachedRootConstants; i++)
+	{
+		m_rootConstantValidMasks[destOffset + i] |= rootBit;
+		m_rootConstants[rootIndex][destOffset + i] = values[i];
+	}
+
+	return true;
+}
+
+void GraphicsStateCache::InvalidateRootArguments(uint64_t mask)
+{
+	m_rootArgumentValidMask &= ~mask;
+	for (uint64_t& validMask : m_rootConstantValidMasks)
+		validMask &= ~mask;
+}
+
+}  // namespace engine::gfx
@@ -0,0 +1,81 @@
+#include "InstanceBatcher.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <tuple>
+
+namespace engine::gfx
+{
+
+void InstanceBatcher::Create(uint32_t viewCount)
+{
+	m_entries.assign(viewCount, {});
+	m_groups.assign(viewCount, {});
+	m_instanceObjects.clear();
+}
+
+void InstanceBatcher::Reset()
+{
+	for (auto& entries : m_entries)
+	{
+		entries.clear();
+	}
+
+	for (auto& groups : m_groups)
+	{
+		groups.clear();
+	}
+
+	m_instanceObjects.clear();
+}
+
+void InstanceBatcher::Add(uint32_t view, const SubMesh& subMesh, uint32_t materialID, uint32_t objectIndex)
+{
+	assert(view < m_entries.size());
+
+	const DrawRange mesh = {
+		(uint32_t)subMesh.startIndexLocation, (uint32_t)subMesh.indexCount, (int32_t)subMesh.baseVertexLocation};
+	m_entries[view].push_back({mesh, materialID, objectIndex});
+}
+
+void InstanceBatcher::Build()
+{
+	// Cheia completeaza ordinea cu indexul obiectului, deci rezultatul nu depinde de ordinea de adaugare
+	const auto toKey = [](const Entry& entry)
+	{
+		return std::make_tuple(
+			entry.mesh.startIndexLocation,
+			entry.mesh.indexCount,
+			entry.mesh.baseVertexLocation,
+			entry.materialID,
+			entry.objectIndex);
+	};
+
+	for (size_t view = 0; view < m_entries.size(); view++)
+	{
+		std::vector<Entry>& entries = m_entries[view];
+		std::vector<InstanceGroup>& groups = m_groups[view];
+
+		std::sort(
+			entries.begin(),
+			entries.end(),
+			[&toKey](const Entry& lhs, const Entry& rhs) { return toKey(lhs) < toKey(rhs); });
+
+		for (const Entry& entry : entries)
+		{
+			const bool sameGroup = !groups.empty() && groups.back().materialID == entry.materialID
+				&& groups.back().mesh.startIndexLocation == entry.mesh.startIndexLocation
+				&& groups.back().mesh.indexCount == entry.mesh.indexCount
+				&& groups.back().mesh.baseVertexLocation == entry.mesh.baseVertexLocation;
+
+			if (sameGroup)
+				groups.back().instanceCount++;
+			else
+				groups.push_back({entry.mesh, entry.materialID, (uint32_t)m_instanceObjects.size(), 1});
+
+			m_instanceObjects.push_back(entry.objectIndex);
+		}
+	}
+}
+
+}  // namespace engine::gfx
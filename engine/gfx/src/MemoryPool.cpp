@@ -0,0 +1,159 @@
+#include "MemoryPool.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace engine::gfx
+{
+
+void MemoryPool::Create(uint64_t blockSize, uint64_t minAllocationSize)
+{
+	m_blockSize = blockSize;
+	m_minAllocationSize = minAllocationSize;
+	m_blocks.clear();
+}
+
+bool MemoryPool::Allocate(uint64_t size, uint64_t alignment, MemoryAllocation& allocation)
+{
+	for (uint32_t block = 0; block < m_blocks.size(); block++)
+	{
+		if (!m_blocks[block])
+			continue;
+
+		const uint64_t offset = m_blocks[block]->Allocate(size, alignment);
+		if (offset == BuddyAllocator::InvalidOffset)
+			continue;
+
+		allocation.block = block;
+		allocation.offset = offset;
+		allocation.size = size;
+
+		return true;
+	}
+
+	return false;
+}
+
+uint32_t MemoryPool::AddBlock()
+{
+	auto freeSlot = std::find(m_blocks.begin(), m_blocks.end(), nullptr);
+	if (freeSlot == m_blocks.end())
+		freeSlot = m_blocks.insert(m_blocks.end(), nullptr);
+
+	*freeSlot = std::make_unique<BuddyAllocator>();
+	(*freeSlot)->Create(m_blockSize, m_minAllocationSize);
+
+	return (uint32_t)(freeSlot - m_blocks.begin());
+}
+
+bool MemoryPool::Free(const MemoryAllocation& allocation)
+{
+	assert(IsBlockUsed(allocation.block));
+
+	BuddyAllocator& block = *m_blocks[allocation.block];
+	block.Free(allocation.offset);
+
+	return block.GetAllocationCount() == 0;
+}
+
+void MemoryPool::RemoveBlock(uint32_t block)
+{
+	assert(IsBlockUsed(block) && m_blocks[block]->GetAllocationCount() == 0);
+
+	m_blocks[block].reset();
+}
+
+std::vector<MemoryMove> MemoryPool::PlanDefragmentation(size_t maxMoves)
+{
+	std::vector<MemoryMove> moves;
+
+	// Sursa: blocul nevid cu cei mai putini octeti de mutat
+	uint32_t source = MemoryAllocation::InvalidBlock;
+	for (uint32_t block = 0; block < m_blocks.size(); block++)
+	{
+		if (!m_blocks[block] || m_blocks[block]->GetAllocationCount() == 0)
+			continue;
+
+		if (source == MemoryAllocation::InvalidBlock
+			|| m_blocks[block]->GetUsedSize() < m_blocks[source]->GetUsedSize())
+			source = block;
+	}
+
+	if (source == MemoryAllocation::InvalidBlock || GetBlockCount() < 2)
+		return moves;
+
+	const BuddyAllocator& sourceBlock = *m_blocks[source];
+
+	std::vector<uint64_t> offsets;
+	sourceBlock.GetAllocationOffsets(offsets);
+
+	// Blocurile mari intai: sunt cele mai greu de plasat dupa ce restul spatiului s-a fragmentat
+	std::sort(
+		offsets.begin(),
+		offsets.end(),
+		[&sourceBlock](uint64_t a, uint64_t b) { return sourceBlock.GetBlockSize(a) > sourceBlock.GetBlockSize(b); });
+
+	for (const uint64_t offset : offsets)
+	{
+		if (moves.size() == maxMoves)
+			break;
+
+		// Un bloc de aceeasi marime, aliniat la ea, pastreaza alinierea alocarii originale
+		const uint64_t blockSize = sourceBlock.GetBlockSize(offset);
+
+		for (uint32_t block = 0; block < m_blocks.size(); block++)
+		{
+			if (block == source || !m_blocks[block])
+				continue;
+
+			const uint64_t destinationOffset = m_blocks[block]->Allocate(blockSize, blockSize);
+			if (destinationOffset == BuddyAllocator::InvalidOffset)
+				continue;
+
+			moves.push_back({{source, offset, blockSize}, {block, destinationOffset, blockSize}});
+			break;
+		}
+	}
+
+	return moves;
+}
+
+size_t MemoryPool::GetBlockCount() const
+{
+	return (size_t)std::count_if(
+		m_blocks.begin(),
+		m_blocks.end(),
+		[](const std::unique_ptr<BuddyAllocator>& block) { return block != nullptr; });
+}
+
+uint64_t MemoryPool::GetUsedSize() const
+{
+	uint64_t usedSize = 0;
+	for (const auto& block : m_blocks)
+	{
+		if (block)
+			usedSize += block->GetUsedSize();
+	}
+
+	return usedSize;
+}
+
+float MemoryPool::GetFragmentation() const
+{
+	float fragmentation = 0.f;
+	for (const auto& block : m_blocks)
+	{
+		if (!block)
+			continue;
+
+		const uint64_t freeSize = block->GetCapacity() - block->GetUsedSize();
+		if (freeSize == 0)
+			continue;
+
+		fragmentation = std::max(fragmentation, 1.f - (float)block->GetLargestFreeBlockSize() / (float)freeSize);
+	}
+
+	return fragmentation;
+}
+
+}  // namespace engine::gfx
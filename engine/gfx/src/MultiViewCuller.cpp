@@ -0,0 +1,122 @@
+#include "MultiViewCuller.hpp"
+
+#include <cassert>
+
+namespace engine::gfx
+{
+
+namespace
+{
+
+// Cutia e in afara daca si coltul cel mai departat in directia normalei e in spatele unui plan
+bool IntersectsFrustum(const engine::math::FrustumPlanes& planes, const engine::math::BoxBounds& bounds)
+{
+	for (const engine::math::Float4& plane : planes)
+	{
+		const float x = plane[0] > 0.f ? bounds.max[0] : bounds.min[0];
+		const float y = plane[1] > 0.f ? bounds.max[1] : bounds.min[1];
+		const float z = plane[2] > 0.f ? bounds.max[2] : bounds.min[2];
+
+		if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] < 0.f)
+			return false;
+	}
+
+	return true;
+}
+
+}  // namespace
+
+MultiViewCuller::MultiViewCuller()
+	: m_activeViews(0), m_occlusionCuller(nullptr), m_pvs(nullptr), m_pvsCell(-1), m_testedCount(0), m_visibleCount{}
+{
+}
+
+void MultiViewCuller::SetView(
+	CullingView::Value view,
+	const engine::math::FrustumPlanes& frustum,
+	const engine::math::Float4x4& viewProjMatrix,
+	const engine::math::Float3& position,
+	float maxDistance)
+{
+	assert(view < CullingView::Count);
+
+	m_views[view].frustum = frustum;
+	m_views[view].viewProjMatrix = viewProjMatrix;
+	m_views[view].position = position;
+	m_views[view].maxDistance = maxDistance;
+
+	m_activeViews |= CullingView::ToMask(view);
+}
+
+void MultiViewCuller::DisableView(CullingView::Value view)
+{
+	m_activeViews &= ~CullingView::ToMask(view);
+}
+
+void MultiViewCuller::BeginSweep()
+{
+	m_testedCount = 0;
+	m_visibleCount.fill(0);
+
+	m_pvsCell = -1;
+	if (m_pvs && IsViewActive(CullingView::Main))
+	{
+		const engine::math::Float3& position = m_views[CullingView::Main].position;
+		m_pvsCell = m_pvs->GetCell(position[0], position[1], position[2]);
+	}
+}
+
+CullingView::Mask MultiViewCuller::Cull(const engine::math::BoxBounds& bounds, uint32_t pvsTarget) const
+{
+	CullingView::Mask visibleViews = 0;
+
+	const engine::math::Float3 center = {
+		(bounds.min[0] + bounds.max[0]) * 0.5f,
+		(bounds.min[1] + bounds.max[1]) * 0.5f,
+		(bounds.min[2] + bounds.max[2]) * 0.5f};
+
+	for (uint32_t view = 0; view < CullingView::Count; view++)
+	{
+		if ((m_activeViews & CullingView::ToMask((CullingView::Value)view)) == 0)
+			continue;
+
+		// Lookup O(1), inaintea testelor de frustum si ocluzie
+		if (view == CullingView::Main && m_pvsCell >= 0 && pvsTarget < m_pvs->GetTargetCount()
+			&& !m_pvs->IsVisible(m_pvsCell, pvsTarget))
+			continue;
+
+		const View& currentView = m_views[view];
+
+		if (currentView.maxDistance > 0.f)
+		{
+			const float dx = center[0] - currentView.position[0];
+			const float dy = center[1] - currentView.position[1];
+			const float dz = center[2] - currentView.position[2];
+			if (dx * dx + dy * dy + dz * dz >= currentView.maxDistance * currentView.maxDistance)
+				continue;
+		}
+
+		if (!IntersectsFrustum(currentView.frustum, bounds))
+			continue;
+
+		if (view == CullingView::Main && m_occlusionCuller && !m_occlusionCuller->IsVisible(bounds))
+			continue;
+
+		visibleViews |= CullingView::ToMask((CullingView::Value)view);
+		m_visibleCount[view]++;
+	}
+
+	m_testedCount++;
+
+	return visibleViews;
+}
+
+float MultiViewCuller::GetCulledRatio(CullingView::Value view) const
+{
+	if (m_testedCount == 0 || !IsViewActive(view))
+		return 0.f;
+
+	return 1.f - (float)m_visibleCount[view] / m_testedCount;
+}
+
+}  // namespace engine::gfx
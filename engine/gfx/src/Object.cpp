@@ -1,5 +1,6 @@
 #include "Object.hpp"
 
+#include "DrawPacket.hpp"
 #include "GeometryGenerator.hpp"
 
 namespace engine::gfx
@@ -34,16 +35,17 @@ Object::Object(const DX_OBJECT_DESCRIPTOR& descriptor)
 
 	m_isStatic = descriptor.isStatic;
 
+	m_isEnabled = true;
+	m_visibleViews = CullingView::AllViews;
+
+	// Versiunea 1 se scrie o data in fiecare frame resource; obiectele statice nu se mai schimba
+	m_version = 1;
+	m_isTransformOutdated = !m_isStatic;
+
 	if (m_isStatic)
 	{
 		m_transform = engine::math::Matrix4::MakeScale(m_scale) * engine::math::Matrix4::MakeMatrixRotationQuaternion(m_rotation)
 			* engine::math::Matrix4::MakeTranslation(m_position);
-
-		m_dirtyCount = 0;
-	}
-	else
-	{
-		SetDirty();
 	}
 
 	m_textureTransform = descriptor.textureTransform;
@@ -52,10 +54,8 @@ Object::Object(const DX_OBJECT_DESCRIPTOR& descriptor)
 void Object::Render(engine::gfx::rasterization::RenderLayer::Value renderLayer)
 {
 	GraphicsContext& graphicsContext = GraphicsResources::GetInstance().GetGraphicsContext();
-	FrameResources& frameResources = GraphicsResources::GetInstance().GetFrameResources();
 
-	graphicsContext.SetConstantBuffer(
-		DefaultRSBindings::ObjectCB, frameResources.m_perObjectCB.GetGpuVirtualAdress(m_objectCB_ID));
+	BindObjectData(graphicsContext);
 
 	// if (UseLighting())
 	//{
@@ -78,15 +78,43 @@ void Object::Render(engine::gfx::rasterization::RenderLayer::Value renderLayer)
 		(UINT)m_subMesh.indexCount, (UINT)m_subMesh.startIndexLocation, (UINT)m_subMesh.baseVertexLocation);
 }
 
+void Object::BindObjectData(GraphicsContext& graphicsContext) const
+{
+	if (FrameResources::UseBindlessData())
+	{
+		graphicsContext.SetConstants(DefaultRSBindings::DrawConstants, m_objectCB_ID, m_materialCB_ID);
+		return;
+	}
+
+	FrameResources& frameResources = GraphicsResources::GetInstance().GetFrameResources();
+	graphicsContext.SetConstantBuffer(
+		DefaultRSBindings::ObjectCB, frameResources.m_perObjectCB.GetGpuVirtualAdress(m_objectCB_ID));
+}
+
+void Object::BindObjectData(DrawPacket& packet) const
+{
+	if (FrameResources::UseBindlessData())
+	{
+		packet.useDrawConstants = true;
+		packet.objectIndex = m_objectCB_ID;
+		packet.materialIndex = m_materialCB_ID;
+		return;
+	}
+
+	FrameResources& frameResources = GraphicsResources::GetInstance().GetFrameResources();
+	packet.objectCB = frameResources.m_perObjectCB.GetGpuVirtualAdress(m_objectCB_ID);
+}
+
 // Recalculate the transformation matrix
 void Object::Update(float deltaTime)
 {
-	if (m_isStatic)
+	if (m_isStatic || !m_isTransformOutdated)
 		return;
 
 	m_transform = engine::math::Matrix4::MakeMatrixRotationQuaternion(m_rotation) * engine::math::Matrix4::MakeScale(m_scale)
 		* engine::math::Matrix4::MakeTranslation(m_position);
 	m_worldSpaceAABB = m_objectSpaceAABB.Transformed(m_transform);
+	m_isTransformOutdated = false;
 
 	SetDirty();
 }
@@ -96,6 +124,9 @@ void Object::SetTransform(const engine::math::Matrix4& toSet)
 	assert(!m_isStatic);
 
 	m_transform = toSet;
+	m_worldSpaceAABB = m_objectSpaceAABB.Transformed(m_transform);
+	m_isTransformOutdated = false;
+
 	SetDirty();
 }
 
@@ -110,7 +141,7 @@ void Object::SetPosition(const engine::math::Vector3& toSet)
 	assert(!m_isStatic);
 
 	m_position = toSet;
-	SetDirty();
+	m_isTransformOutdated = true;
 }
 
 void Object::SetScale(const engine::math::Vector3& toSet)
@@ -118,7 +149,7 @@ void Object::SetScale(const engine::math::Vector3& toSet)
 	assert(!m_isStatic);
 
 	m_scale = toSet;
-	SetDirty();
+	m_isTransformOutdated = true;
 }
 
 void Object::SetRotation(const engine::math::Quaternion& toSet)
@@ -126,7 +157,7 @@ void Object::SetRotation(const engine::math::Quaternion& toSet)
 	assert(!m_isStatic);
 
 	m_rotation = toSet;
-	SetDirty();
+	m_isTransformOutdated = true;
 }
 
 void Object::SeColor(const engine::math::Vector4& toSet)
@@ -139,23 +170,22 @@ void Object::SeColor(const engine::math::Vector4& toSet)
 
 void Object::SetVisible(bool toSet)
 {
-	m_isVisible = toSet;
+	m_isEnabled = toSet;
 }
 
-void Object::SetObjectCB_ID(UINT toSet)
+void Object::SetVisibleViews(CullingView::Mask toSet)
 {
-	m_objectCB_ID = toSet;
+	m_visibleViews = toSet;
 }
 
-void Object::SetDirty()
+void Object::SetObjectCB_ID(UINT toSet)
 {
-	m_dirtyCount = engine::core::Settings::GetFrameResourcesCount();
+	m_objectCB_ID = toSet;
 }
 
-void Object::DecreaseDirtyCount()
+void Object::SetDirty()
 {
-	m_dirtyCount--;
-	assert(m_dirtyCount >= 0);
+	m_version++;
 }
 
 }  // namespace engine::gfx
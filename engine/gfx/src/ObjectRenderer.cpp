@@ -3,6 +3,7 @@
 #include "FrameResources.hpp"
 #include "GeometryGenerator.hpp"
 
+#include <algorithm>
 #include <map>
 
 namespace engine::gfx
@@ -26,6 +27,14 @@ ObjectRenderer::Ptr ObjectRenderer::CreateObjectRenderer(DX_OBJECTS_RENDERER_DES
 
 	objectRenderer->m_shadowDebugPSO = descriptor.debugShadowPSO;
 
+	// Calea instantiata exista doar la rasterizare; fara PSO-urile instantiate se deseneaza obiect cu obiect
+	if (!engine::core::Settings::UseRayTracing() && engine::core::Settings::GetGraphicsSettings().UseInstancing())
+	{
+		objectRenderer->m_baseInstancedPSO = descriptor.baseInstancedPSO;
+		objectRenderer->m_dynamicCubeMapInstancedPSO = descriptor.dynamicCubeMapInstancedPSO;
+		objectRenderer->m_shadowInstancedPSO = descriptor.shadowInstancedPSO;
+	}
+
 	objectRenderer->LoadGeometry(descriptor);
 	objectRenderer->CreateObjects(descriptor);
 
@@ -95,6 +104,105 @@ void ObjectRenderer::CreateObjects(const DX_OBJECTS_RENDERER_DESCRIPTOR& desc)
 
 		m_objects.push_back(aux);
 	}
+
+	const float halfSize = desc.spatialIndexHalfSize;
+	m_objectTree = std::make_unique<engine::math::LooseOctree>(
+		engine::math::BoxBounds{{-halfSize, -halfSize, -halfSize}, {halfSize, halfSize, halfSize}},
+		desc.spatialIndexMaxDepth);
+
+	for (size_t i = 0; i < m_objects.size(); i++)
+	{
+		m_objectHandles.push_back(m_objectTree->Insert(m_objects[i]->GetWorldSpaceAABB().GetBounds(), (uint32_t)i));
+	}
+	m_cullStamps.assign(m_objects.size(), 0);
+
+	if (UseInstancing())
+	{
+		m_instanceBatcher.Create(CullingView::Count);
+	}
+	else if (
+		!engine::core::Settings::UseRayTracing() && engine::core::Settings::GetGraphicsSettings().UseIndirectDraws())
+	{
+		CreateIndirectObjectDraws();
+	}
+}
+
+void ObjectRenderer::CreateIndirectObjectDraws()
+{
+	m_indirectObjectDraws.Create(CullingView::Count, (UINT)m_objects.size());
+	m_indirectObjectArguments.Create(
+		GraphicsResources::GetDevice(),
+		m_indirectObjectDraws,
+		engine::core::Settings::GetFrameResourcesCount(),
+		L"Indirect object arguments");
+
+	if (FrameResources::UseBindlessData())
+		m_objectDrawSignature = CommandSignature::CreateBindlessObjectDraw(
+			GraphicsResources::GetDevice(), m_basePSO->GetRootSignature(), RSBinding::DefaultRSBindings::DrawConstants);
+	else
+		m_objectDrawSignature = CommandSignature::CreateObjectDraw(
+			GraphicsResources::GetDevice(), m_basePSO->GetRootSignature(), RSBinding::DefaultRSBindings::ObjectCB);
+	m_objectDrawRootSignature = m_basePSO->GetID3D12RootSignature();
+}
+
+bool ObjectRenderer::UseIndirectObjectDraws(const GraphicsPSO& pso) const
+{
+	return m_objectDrawSignature && pso.GetID3D12RootSignature() == m_objectDrawRootSignature;
+}
+
+void ObjectRenderer::UploadIndirectDraws()
+{
+	if (!m_objectDrawSignature)
+		return;
+
+	// Adresele CB-urilor de obiect difera de la un frame resource la altul, deci argumentele se refac la fiecare frame
+	FrameResources& frameResources = GraphicsResources::GetInstance().GetFrameResources();
+
+	m_indirectObjectDraws.Reset();
+
+	for (const auto& object : m_objects)
+	{
+		IndirectObjectDrawArguments arguments = {};
+		if (FrameResources::UseBindlessData())
+		{
+			arguments.drawConstants[0] = object->GetObjectCB_ID();
+			arguments.drawConstants[1] = object->GetMaterialCB_ID();
+		}
+		else
+		{
+			arguments.objectCBAddress = frameResources.m_perObjectCB.GetGpuVirtualAdress(object->GetObjectCB_ID());
+		}
+		arguments.draw = MakeIndirectDrawArguments(object->GetSubMesh());
+
+		for (UINT view = 0; view < CullingView::Count; view++)
+		{
+			if (object->IsVisible((CullingView::Value)view))
+				m_indirectObjectDraws.Add(view, arguments);
+		}
+	}
+
+	m_indirectObjectArguments.Upload(GraphicsResources::GetContextManager().GetFrameIndex(), m_indirectObjectDraws);
+}
+
+void ObjectRenderer::BuildInstanceBatches()
+{
+	if (!UseInstancing())
+		return;
+
+	m_instanceBatcher.Reset();
+
+	for (UINT i = 0; i < (UINT)m_objects.size(); i++)
+	{
+		const Object& object = *m_objects[i];
+
+		for (UINT view = 0; view < CullingView::Count; view++)
+		{
+			if (object.IsVisible((CullingView::Value)view))
+				m_instanceBatcher.Add(view, object.GetSubMesh(), object.GetMaterialCB_ID(), i);
+		}
+	}
+
+	m_instanceBatcher.Build();
 }
 
 void ObjectRenderer::BuildAccelerationStructures()
@@ -103,9 +211,15 @@ void ObjectRenderer::BuildAccelerationStructures()
 
 void ObjectRenderer::Update(float deltaTime)
 {
-	for (auto& object : m_objects)
+	for (size_t i = 0; i < m_objects.size(); i++)
 	{
-		object->Update(deltaTime);
+		Object& object = *m_objects[i];
+		const UINT version = object.GetVersion();
+		object.Update(deltaTime);
+
+		// Doar obiectele modificate in cadrul asta se actualizeaza in octree; de obicei raman in acelasi nod
+		if (object.GetVersion() != version)
+			m_objectTree->Update(m_objectHandles[i], object.GetWorldSpaceAABB().GetBounds());
 	}
 }
 
@@ -117,11 +231,57 @@ void ObjectRenderer::Render(engine::gfx::rasterization::RenderLayer::Value rende
 	graphicsContext.SetVertexBuffer(0, m_vertexBuffer->GetVertexBufferView());
 	graphicsContext.SetIndexBuffer(m_indexBuffer->GetIndexBufferView());
 
-	const auto renderObjects = [this, &renderLayer](const bool performVisbilityTest = true)
+	const CullingView::Value view = CullingView::FromRenderLayer(renderLayer, m_cubeMapFace);
+
+	const auto renderObjects = [this, &graphicsContext, &frameResources, &renderLayer, view](
+								   const GraphicsPSO& pso, const GraphicsPSO::Ptr& instancedPSO)
 	{
+		if (UseInstancing())
+		{
+			// Un draw pe grup; shaderul citeste transformarea din instanceOffset + SV_InstanceID
+			graphicsContext.SetPipelineState(*instancedPSO);
+			graphicsContext.SetShaderResourceView(
+				RSBinding::DefaultRSBindings::InstanceData, frameResources.m_perInstanceData.GpuVirtualAddress());
+
+			for (const InstanceGroup& group : m_instanceBatcher.GetGroups(view))
+			{
+				// Cu date bindless materialul grupului se citeste din bufferul de materiale
+				if (FrameResources::UseBindlessData())
+					graphicsContext.SetConstants(RSBinding::DefaultRSBindings::DrawConstants, 0, group.materialID);
+
+				graphicsContext.SetConstant(RSBinding::DefaultRSBindings::InstanceConstants, group.firstInstance);
+				graphicsContext.DrawIndexedInstanced(
+					group.mesh.indexCount,
+					group.instanceCount,
+					group.mesh.startIndexLocation,
+					group.mesh.baseVertexLocation,
+					0);
+			}
+
+			return;
+		}
+
+		graphicsContext.SetPipelineState(pso);
+
+		if (UseIndirectObjectDraws(pso))
+		{
+			const UINT64 frameOffset =
+				m_indirectObjectArguments.GetFrameOffset(GraphicsResources::GetContextManager().GetFrameIndex());
+
+			graphicsContext.ExecuteIndirect(
+				*m_objectDrawSignature,
+				m_indirectObjectDraws.GetMaxDrawsPerView(),
+				m_indirectObjectArguments.GetD3D12Resource(),
+				frameOffset + m_indirectObjectDraws.GetArgumentOffset(view),
+				m_indirectObjectArguments.GetD3D12Resource(),
+				frameOffset + m_indirectObjectDraws.GetCountOffset(view));
+
+			return;
+		}
+
 		for (auto& object : m_objects)
 		{
-			if (performVisbilityTest && !object->IsVisible())
+			if (!object->IsVisible(view))
 				continue;
 
 			object->Render(renderLayer);
@@ -131,21 +291,15 @@ void ObjectRenderer::Render(engine::gfx::rasterization::RenderLayer::Value rende
 	switch (renderLayer)
 	{
 	case engine::gfx::rasterization::RenderLayer::Base:
-		graphicsContext.SetPipelineState(*m_basePSO);
-
-		renderObjects();
+		renderObjects(*m_basePSO, m_baseInstancedPSO);
 
 		break;
 	case RenderLayer::CubeMap:
-		graphicsContext.SetPipelineState(*m_dynamicCubeMapPSO);
-
-		renderObjects();
+		renderObjects(*m_dynamicCubeMapPSO, m_dynamicCubeMapInstancedPSO);
 
 		break;
 	case engine::gfx::rasterization::RenderLayer::ShadowMap:
-		graphicsContext.SetPipelineState(*m_shadowPSO);
-
-		renderObjects();
+		renderObjects(*m_shadowPSO, m_shadowInstancedPSO);
 
 		break;
 	// case engine::gfx::rasterization::RenderLayer::DebugShadowMap:
@@ -166,11 +320,112 @@ void ObjectRenderer::Render(engine::gfx::rasterization::RenderLayer::Value rende
 	}
 }
 
-void ObjectRenderer::FrustumCulling(const CameraController& cameraController)
+void ObjectRenderer::SubmitDraws(
+	RenderQueue<DrawPacket>& queue, RenderLayer::Value renderLayer, const BaseCamera& camera) const
 {
+	FrameResources& frameResources = GraphicsResources::GetInstance().GetFrameResources();
+
+	const CullingView::Value view = CullingView::FromRenderLayer(renderLayer, m_cubeMapFace);
+	DrawPacket packet = MakeDrawPacket(renderLayer);
+
+	if (UseInstancing())
+	{
+		packet.pso = GetInstancedPipelineState(renderLayer);
+		packet.instanceData = frameResources.m_perInstanceData.GpuVirtualAddress();
+
+		packet.useDrawConstants = FrameResources::UseBindlessData();
+
+		for (const InstanceGroup& group : m_instanceBatcher.GetGroups(view))
+		{
+			packet.materialIndex = group.materialID;
+			packet.instanceOffset = group.firstInstance;
+			packet.draw = MakeIndirectDrawArguments(group.mesh);
+			packet.draw.instanceCount = group.instanceCount;
+
+			queue.Submit(
+				SortKey::Make(RenderQueueLayer::Opaque, packet.pso->GetSortID(), group.materialID, m_meshSortID, 0),
+				packet);
+		}
+
+		return;
+	}
+
+	if (UseIndirectObjectDraws(*packet.pso))
+	{
+		const UINT64 frameOffset =
+			m_indirectObjectArguments.GetFrameOffset(GraphicsResources::GetContextManager().GetFrameIndex());
+
+		packet.signature = m_objectDrawSignature.get();
+		packet.maxCommandCount = m_indirectObjectDraws.GetMaxDrawsPerView();
+		packet.argumentBuffer = m_indirectObjectArguments.GetD3D12Resource();
+		packet.argumentOffset = frameOffset + m_indirectObjectDraws.GetArgumentOffset(view);
+		packet.countOffset = frameOffset + m_indirectObjectDraws.GetCountOffset(view);
+
+		queue.Submit(SortKey::Make(RenderQueueLayer::Opaque, packet.pso->GetSortID(), 0, m_meshSortID, 0), packet);
+		return;
+	}
+
+	for (const auto& object : m_objects)
+	{
+		if (!object->IsVisible(view))
+			continue;
+
+		const float distance = (float)~(object->GetWorldSpaceAABB().GetCenter() - camera.GetPosition());
+
+		object->BindObjectData(packet);
+		packet.draw = MakeIndirectDrawArguments(object->GetSubMesh());
+
+		queue.Submit(
+			SortKey::Make(
+				RenderQueueLayer::Opaque,
+				packet.pso->GetSortID(),
+				object->GetMaterialCB_ID(),
+				m_meshSortID,
+				SortKey::QuantizeDepth(distance, camera.GetZFar())),
+			packet);
+	}
+}
+
+const GraphicsPSO* ObjectRenderer::GetInstancedPipelineState(RenderLayer::Value renderLayer) const
+{
+	switch (renderLayer)
+	{
+	case RenderLayer::Base: return m_baseInstancedPSO.get();
+	case RenderLayer::CubeMap: return m_dynamicCubeMapInstancedPSO.get();
+	case RenderLayer::ShadowMap: return m_shadowInstancedPSO.get();
+	default: throw engine::core::CustomException("Tip de randare inexistent!!");
+	}
+}
+
+void ObjectRenderer::FrustumCulling(const MultiViewCuller& culler)
+{
+	// Doar obiectele din nodurile atinse de cel putin un frustum activ trec prin testul complet pe toate view-urile
+	m_cullCandidates.clear();
+
+	for (UINT view = 0; view < CullingView::Count; view++)
+	{
+		if (culler.IsViewActive((CullingView::Value)view))
+			m_objectTree->QueryFrustum(culler.GetView((CullingView::Value)view).frustum, m_cullCandidates);
+	}
+
 	for (auto& object : m_objects)
 	{
-		object->SetVisible(cameraController.GetWorldSpaceFrustum().IntersectBoundingBox(object->GetWorldSpaceAABB()));
+		object->SetVisibleViews(0);
+	}
+
+	if (++m_cullStamp == 0)
+	{
+		std::fill(m_cullStamps.begin(), m_cullStamps.end(), 0);
+		m_cullStamp = 1;
+	}
+
+	for (const uint32_t index : m_cullCandidates)
+	{
+		if (m_cullStamps[index] == m_cullStamp)
+			continue;
+
+		m_cullStamps[index] = m_cullStamp;
+		m_objects[index]->SetVisibleViews(culler.Cull(m_objects[index]->GetWorldSpaceAABB().GetBounds()));
 	}
 }
 
@@ -0,0 +1,404 @@
+#include "OcclusionCuller.hpp"
+
+#include "engine/core/CustomException.hpp"
+#include "engine/core/FrameArena.hpp"
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace engine::gfx
+{
+
+namespace
+{
+
+// Sub aceasta valoare a lui w un punct este considerat pe / in spatele planului near
+constexpr float MinClipW = 1e-4f;
+
+constexpr engine::math::Float4x4 IdentityMatrix = {{
+	{1.f, 0.f, 0.f, 0.f},
+	{0.f, 1.f, 0.f, 0.f},
+	{0.f, 0.f, 1.f, 0.f},
+	{0.f, 0.f, 0.f, 1.f},
+}};
+
+}  // namespace
+
+OcclusionCuller::OcclusionCuller(uint32_t width, uint32_t height, uint32_t bandCount)
+	: m_width(width),
+	  m_height(height),
+	  m_tilesPerRow(width / TileWidth),
+	  m_tileRows(height / TileHeight),
+	  m_bandCount(bandCount),
+	  m_testedCount(0),
+	  m_occludedCount(0)
+{
+	if (width == 0 || height == 0 || width % TileWidth != 0 || height % TileHeight != 0)
+		throw engine::core::CustomException("Rezolutia bufferului de ocluzie trebuie sa fie multiplu de 8x4");
+
+	if (bandCount == 0 || bandCount > m_tileRows)
+		throw engine::core::CustomException("Numar invalid de benzi pentru bufferul de ocluzie");
+
+	m_zMax0.resize(m_tilesPerRow * m_tileRows);
+	m_zMax1.resize(m_tilesPerRow * m_tileRows);
+	m_masks.resize(m_tilesPerRow * m_tileRows);
+
+	// Lucrarile pentru scheduler se fac o singura data; Rasterize nu aloca nimic
+	m_bandPasses.resize(bandCount);
+	for (uint32_t band = 0; band < bandCount; band++)
+	{
+		m_bandPasses[band].record = [this, band]() { RasterizeBand(band); };
+	}
+
+	m_viewProjMatrix = IdentityMatrix;
+}
+
+OcclusionCuller::Occluder OcclusionCuller::BuildHeightfieldOccluder(const Heightfield& heightfield, int cellsPerSide)
+{
+	const int sidePointCount = heightfield.sidePointCount;
+
+	if (cellsPerSide < 1 || sidePointCount < 2 || heightfield.heights.size() < (size_t)sidePointCount * sidePointCount)
+		throw engine::core::CustomException("Parametri invalizi pentru ocluderul terenului");
+
+	cellsPerSide = std::min(cellsPerSide, sidePointCount - 1);
+
+	// Indicele din grila fina corespunzator unui varf al grilei grosiere
+	const auto toFine = [sidePointCount, cellsPerSide](int coarse)
+	{ return (int)std::lround((float)coarse * (sidePointCount - 1) / cellsPerSide); };
+
+	Occluder occluder;
+	occluder.vertices.reserve((size_t)(cellsPerSide + 1) * (cellsPerSide + 1));
+
+	for (int i = 0; i <= cellsPerSide; i++)
+	{
+		const int fineI = toFine(i);
+		const int firstI = toFine(std::max(i - 1, 0));
+		const int lastI = toFine(std::min(i + 1, cellsPerSide));
+
+		for (int j = 0; j <= cellsPerSide; j++)
+		{
+			const int fineJ = toFine(j);
+			const int firstJ = toFine(std::max(j - 1, 0));
+			const int lastJ = toFine(std::min(j + 1, cellsPerSide));
+
+			// Minimul pe celulele grosiere vecine: orice interpolare intre varfuri ramane sub suprafata fina
+			float minHeight = heightfield.GetHeight(fineI, fineJ);
+			for (int k = firstI; k <= lastI; k++)
+			{
+				for (int l = firstJ; l <= lastJ; l++)
+				{
+					minHeight = std::min(minHeight, heightfield.GetHeight(k, l));
+				}
+			}
+
+			occluder.vertices.push_back({heightfield.GetX(fineI), minHeight, heightfield.GetZ(fineJ)});
+		}
+	}
+
+	const uint32_t rowPitch = cellsPerSide + 1;
+	occluder.indices.reserve((size_t)cellsPerSide * cellsPerSide * 6);
+
+	for (uint32_t i = 0; i < (uint32_t)cellsPerSide; i++)
+	{
+		for (uint32_t j = 0; j < (uint32_t)cellsPerSide; j++)
+		{
+			occluder.indices.push_back(i * rowPitch + j);
+			occluder.indices.push_back((i + 1) * rowPitch + j + 1);
+			occluder.indices.push_back((i + 1) * rowPitch + j);
+
+			occluder.indices.push_back(i * rowPitch + j);
+			occluder.indices.push_back(i * rowPitch + j + 1);
+			occluder.indices.push_back((i + 1) * rowPitch + j + 1);
+		}
+	}
+
+	return occluder;
+}
+
+void OcclusionCuller::BeginFrame(const engine::math::Float4x4& viewProjMatrix)
+{
+	m_viewProjMatrix = viewProjMatrix;
+
+	m_triangles.clear();
+
+	std::fill(m_zMax0.begin(), m_zMax0.end(), 1.f);
+	std::fill(m_zMax1.begin(), m_zMax1.end(), 0.f);
+	std::fill(m_masks.begin(), m_masks.end(), 0u);
+
+	m_testedCount = 0;
+	m_occludedCount = 0;
+}
+
+void OcclusionCuller::AddOccluder(const Occluder& occluder)
+{
+	engine::core::FrameVector<engine::math::Float4> clipVertices(occluder.vertices.size());
+
+	for (size_t i = 0; i < occluder.vertices.size(); i++)
+	{
+		clipVertices[i] = engine::math::TransformPoint(m_viewProjMatrix, occluder.vertices[i]);
+	}
+
+	for (size_t i = 0; i + 2 < occluder.indices.size(); i += 3)
+	{
+		ScreenTriangle triangle;
+		bool isClipped = false;
+
+		for (int k = 0; k < 3; k++)
+		{
+			const engine::math::Float4& clip = clipVertices[occluder.indices[i + k]];
+
+			// Triunghiurile taiate de planul near nu se rasterizeaza: un ocluder lipsa nu ascunde nimic gresit
+			if (clip[3] <= MinClipW)
+			{
+				isClipped = true;
+				break;
+			}
+
+			triangle.x[k] = (clip[0] / clip[3] * 0.5f + 0.5f) * m_width;
+			triangle.y[k] = (0.5f - clip[1] / clip[3] * 0.5f) * m_height;
+			triangle.z[k] = clip[2] / clip[3];
+		}
+
+		if (isClipped)
+			continue;
+
+		// Orientare consecventa, ca functiile de muchie sa fie pozitive in interior
+		const float area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0])
+						   - (triangle.y[1] - triangle.y[0]) * (triangle.x[2] - triangle.x[0]);
+
+		if (std::abs(area) < 1e-6f)
+			continue;
+
+		if (area < 0.f)
+		{
+			std::swap(triangle.x[1], triangle.x[2]);
+			std::swap(triangle.y[1], triangle.y[2]);
+			std::swap(triangle.z[1], triangle.z[2]);
+		}
+
+		triangle.minX = std::min({triangle.x[0], triangle.x[1], triangle.x[2]});
+		triangle.maxX = std::max({triangle.x[0], triangle.x[1], triangle.x[2]});
+		triangle.minY = std::min({triangle.y[0], triangle.y[1], triangle.y[2]});
+		triangle.maxY = std::max({triangle.y[0], triangle.y[1], triangle.y[2]});
+		triangle.maxZ = std::max({triangle.z[0], triangle.z[1], triangle.z[2]});
+
+		if (triangle.maxX < 0.f || triangle.minX >= m_width || triangle.maxY < 0.f || triangle.minY >= m_height)
+			continue;
+
+		m_triangles.push_back(triangle);
+	}
+}
+
+void OcclusionCuller::Rasterize(RecordingScheduler* scheduler)
+{
+	// Benzile nu impart tile-uri, deci se pot rasteriza fara sincronizare
+	if (scheduler)
+	{
+		scheduler->Execute(m_bandPasses);
+		return;
+	}
+
+	for (uint32_t band = 0; band < m_bandCount; band++)
+	{
+		RasterizeBand(band);
+	}
+}
+
+void OcclusionCuller::RasterizeBand(uint32_t band)
+{
+	const uint32_t firstTileRow = band * m_tileRows / m_bandCount;
+	const uint32_t lastTileRow = (band + 1) * m_tileRows / m_bandCount - 1;
+
+	const float bandTop = (float)(firstTileRow * TileHeight);
+	const float bandBottom = (float)((lastTileRow + 1) * TileHeight);
+
+	for (const auto& triangle : m_triangles)
+	{
+		if (triangle.maxY < bandTop || triangle.minY >= bandBottom)
+			continue;
+
+		RasterizeTriangle(triangle, firstTileRow, lastTileRow);
+	}
+}
+
+uint32_t OcclusionCuller::ComputeCoverage(const float edges[3][3], float tileX, float tileY)
+{
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 columnOffsets[2] = {
+		_mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f), _mm_setr_ps(4.5f, 5.5f, 6.5f, 7.5f)};
+
+	uint32_t coverage = 0;
+
+	for (uint32_t row = 0; row < TileHeight; row++)
+	{
+		const float pixelY = tileY + row + 0.5f;
+
+		for (uint32_t half = 0; half < 2; half++)
+		{
+			const __m128 pixelX = _mm_add_ps(_mm_set1_ps(tileX), columnOffsets[half]);
+
+			__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+			for (int k = 0; k < 3; k++)
+			{
+				// E(p) = A * x + (B * y + C)
+				const __m128 edge = _mm_add_ps(
+					_mm_mul_ps(_mm_set1_ps(edges[k][0]), pixelX), _mm_set1_ps(edges[k][1] * pixelY + edges[k][2]));
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(edge, zero));
+			}
+
+			coverage |= (uint32_t)_mm_movemask_ps(inside) << (row * TileWidth + half * 4);
+		}
+	}
+
+	return coverage;
+}
+
+void OcclusionCuller::RasterizeTriangle(const ScreenTriangle& triangle, uint32_t firstTileRow, uint32_t lastTileRow)
+{
+	// Functiile de muchie: A * x + B * y + C >= 0 in interior
+	float edges[3][3];
+	for (int k = 0; k < 3; k++)
+	{
+		const int next = (k + 1) % 3;
+
+		edges[k][0] = triangle.y[k] - triangle.y[next];
+		edges[k][1] = triangle.x[next] - triangle.x[k];
+		edges[k][2] = -(edges[k][0] * triangle.x[k] + edges[k][1] * triangle.y[k]);
+	}
+
+	// Planul adancimii: z = z0 + dzdx * (x - x0) + dzdy * (y - y0)
+	const float dx1 = triangle.x[1] - triangle.x[0];
+	const float dy1 = triangle.y[1] - triangle.y[0];
+	const float dx2 = triangle.x[2] - triangle.x[0];
+	const float dy2 = triangle.y[2] - triangle.y[0];
+	const float dz1 = triangle.z[1] - triangle.z[0];
+	const float dz2 = triangle.z[2] - triangle.z[0];
+
+	const float determinant = dx1 * dy2 - dx2 * dy1;
+	const float dzdx = (dz1 * dy2 - dz2 * dy1) / determinant;
+	const float dzdy = (dz2 * dx1 - dz1 * dx2) / determinant;
+
+	const uint32_t firstTileX = (uint32_t)std::max(0.f, std::floor(triangle.minX / TileWidth));
+	const uint32_t lastTileX = (uint32_t)std::min((float)m_tilesPerRow - 1, std::floor(triangle.maxX / TileWidth));
+	const uint32_t firstTileY = std::max(firstTileRow, (uint32_t)std::max(0.f, std::floor(triangle.minY / TileHeight)));
+	const uint32_t lastTileY = std::min(lastTileRow, (uint32_t)std::max(0.f, std::floor(triangle.maxY / TileHeight)));
+
+	for (uint32_t tileY = firstTileY; tileY <= lastTileY; tileY++)
+	{
+		const float top = (float)(tileY * TileHeight);
+
+		for (uint32_t tileX = firstTileX; tileX <= lastTileX; tileX++)
+		{
+			const float left = (float)(tileX * TileWidth);
+
+			const uint32_t coverage = ComputeCoverage(edges, left, top);
+			if (coverage == 0)
+				continue;
+
+			// Adancimea maxima pe tile: maximul planului in colturile tile-ului, limitat de varfuri
+			const float depthAtOrigin = triangle.z[0] + dzdx * (left - triangle.x[0]) + dzdy * (top - triangle.y[0]);
+			const float depth = std::min(
+				triangle.maxZ,
+				depthAtOrigin + std::max(0.f, dzdx * TileWidth) + std::max(0.f, dzdy * TileHeight));
+
+			UpdateTile(tileY * m_tilesPerRow + tileX, coverage, std::clamp(depth, 0.f, 1.f));
+		}
+	}
+}
+
+void OcclusionCuller::UpdateTile(uint32_t tileIndex, uint32_t coverage, float depth)
+{
+	float& zMax0 = m_zMax0[tileIndex];
+	float& zMax1 = m_zMax1[tileIndex];
+	uint32_t& mask = m_masks[tileIndex];
+
+	// Triunghiul e in spatele a ce ascunde deja tile-ul
+	if (depth >= zMax0)
+		return;
+
+	// Daca noul triunghi e mult mai aproape decat stratul de lucru, stratul vechi se abandoneaza
+	if (mask != 0 && zMax1 - depth > zMax0 - zMax1)
+	{
+		zMax1 = 0.f;
+		mask = 0;
+	}
+
+	zMax1 = std::max(zMax1, depth);
+	mask |= coverage;
+
+	// Tile acoperit complet: stratul de lucru devine adancimea garantata
+	if (mask == 0xFFFFFFFFu)
+	{
+		zMax0 = std::min(zMax0, zMax1);
+		zMax1 = 0.f;
+		mask = 0;
+	}
+}
+
+bool OcclusionCuller::IsVisible(const engine::math::BoxBounds& box) const
+{
+	m_testedCount++;
+
+	float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+	float minZ = FLT_MAX;
+
+	for (int i = 0; i < 8; i++)
+	{
+		const engine::math::Float4 clip = engine::math::TransformPoint(
+			m_viewProjMatrix,
+			{(i & 1) ? box.max[0] : box.min[0], (i & 2) ? box.max[1] : box.min[1], (i & 4) ? box.max[2] : box.min[2]});
+
+		if (clip[3] <= MinClipW)
+			return true;
+
+		const float x = (clip[0] / clip[3] * 0.5f + 0.5f) * m_width;
+		const float y = (0.5f - clip[1] / clip[3] * 0.5f) * m_height;
+
+		minX = std::min(minX, x);
+		maxX = std::max(maxX, x);
+		minY = std::min(minY, y);
+		maxY = std::max(maxY, y);
+		minZ = std::min(minZ, clip[2] / clip[3]);
+	}
+
+	// In afara ecranului decide frustum culling-ul
+	if (maxX < 0.f || minX >= m_width || maxY < 0.f || minY >= m_height)
+		return true;
+
+	const uint32_t firstTileX = (uint32_t)std::max(0.f, std::floor(minX / TileWidth));
+	const uint32_t lastTileX = (uint32_t)std::min((float)m_tilesPerRow - 1, std::floor(maxX / TileWidth));
+	const uint32_t firstTileY = (uint32_t)std::max(0.f, std::floor(minY / TileHeight));
+	const uint32_t lastTileY = (uint32_t)std::min((float)m_tileRows - 1, std::floor(maxY / TileHeight));
+
+	const __m128 boxDepth = _mm_set1_ps(minZ);
+
+	for (uint32_t tileY = firstTileY; tileY <= lastTileY; tileY++)
+	{
+		const float* rowDepths = &m_zMax0[tileY * m_tilesPerRow];
+
+		uint32_t tileX = firstTileX;
+
+		// Cate 4 tile-uri odata: vizibil daca punctul cel mai apropiat e in fata adancimii garantate
+		for (; tileX + 3 <= lastTileX; tileX += 4)
+		{
+			if (_mm_movemask_ps(_mm_cmplt_ps(boxDepth, _mm_loadu_ps(rowDepths + tileX))) != 0)
+				return true;
+		}
+
+		for (; tileX <= lastTileX; tileX++)
+		{
+			if (minZ < rowDepths[tileX])
+				return true;
+		}
+	}
+
+	m_occludedCount++;
+
+	return false;
+}
+
+}  // namespace engine::gfx
@@ -6,6 +6,8 @@
 namespace engine::gfx
 {
 
+uint32_t PipelineState::nextSortID = 0;
+
 GraphicsPSO::Ptr GraphicsPSO::CreateEmptyPSO()
 {
 	return GraphicsPSO::Ptr(new GraphicsPSO());
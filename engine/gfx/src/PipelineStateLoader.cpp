@@ -317,6 +317,24 @@ GraphicsPSO::Ptr PipelineStateLoader::LoadShadowMapPipelineState(const ShadersMa
 	return pso;
 }
 
+GraphicsPSO::Ptr PipelineStateLoader::LoadDefaultInstancedPipelineState(const ShadersManager& shadersManager)
+{
+	GraphicsPSO::Ptr pso = LoadDefaultPipelineState(shadersManager);
+
+	pso->SetVertexShader(GET_SHADER_DATA("DefaultInstancedVS"));
+
+	return pso;
+}
+
+GraphicsPSO::Ptr PipelineStateLoader::LoadShadowMapInstancedPipelineState(const ShadersManager& shadersManager)
+{
+	GraphicsPSO::Ptr pso = LoadShadowMapPipelineState(shadersManager);
+
+	pso->SetVertexShader(GET_SHADER_DATA("ShadowRenderInstancedVS"));
+
+	return pso;
+}
+
 GraphicsPSO::Ptr PipelineStateLoader::LoadTexturePipelineState(const ShadersManager& shadersManager)
 {
 	GraphicsPSO::Ptr pso = LoadDefaultPipelineState(shadersManager);
@@ -0,0 +1,157 @@
+#include "ProjectedGrid.hpp"
+
+#include "engine/core/CustomException.hpp"
+#include "engine/core/FrameArena.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace engine::gfx
+{
+
+using engine::math::Float4;
+
+namespace
+{
+
+ProjectedGrid::Float3 Unproject(const ProjectedGrid::Float4x4& invViewProjMatrix, float x, float y, float z)
+{
+	const Float4 point = engine::math::TransformPoint(invViewProjMatrix, {x, y, z});
+	return {point[0] / point[3], point[1] / point[3], point[2] / point[3]};
+}
+
+ProjectedGrid::Float3 Lerp(const ProjectedGrid::Float3& a, const ProjectedGrid::Float3& b, float t)
+{
+	return {a[0] + (b[0] - a[0]) * t, a[1] + (b[1] - a[1]) * t, a[2] + (b[2] - a[2]) * t};
+}
+
+}  // namespace
+
+ProjectedGrid::ProjectedGrid(uint32_t columns, uint32_t rows, float maxAmplitude, float planeHeight)
+	: m_columns(columns), m_rows(rows), m_maxAmplitude(maxAmplitude), m_planeHeight(planeHeight)
+{
+	if (columns == 0 || rows == 0)
+		throw engine::core::CustomException("Grila proiectata trebuie sa aiba cel putin o celula");
+}
+
+bool ProjectedGrid::ComputeScreenBounds(
+	const Float4x4& viewProjMatrix, const Float4x4& invViewProjMatrix, float bounds[4]) const
+{
+	// Colturile frustumului in spatiul lume (NDC D3D: z in [0, 1])
+	std::array<Float3, 8> corners;
+	for (int i = 0; i < 8; i++)
+	{
+		corners[i] = Unproject(
+			invViewProjMatrix, (i & 1) ? 1.f : -1.f, (i & 2) ? 1.f : -1.f, (i & 4) ? 1.f : 0.f);
+	}
+
+	static constexpr int edges[12][2] = {
+		{0, 1}, {2, 3}, {0, 2}, {1, 3}, {4, 5}, {6, 7}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7}};
+
+	const float lowerHeight = m_planeHeight - m_maxAmplitude;
+	const float upperHeight = m_planeHeight + m_maxAmplitude;
+
+	engine::core::FrameVector<Float3> points;
+
+	for (const auto& corner : corners)
+	{
+		if (corner[1] >= lowerHeight && corner[1] <= upperHeight)
+			points.push_back(corner);
+	}
+
+	for (const auto& edge : edges)
+	{
+		const Float3& a = corners[edge[0]];
+		const Float3& b = corners[edge[1]];
+
+		for (const float height : {lowerHeight, upperHeight})
+		{
+			if ((a[1] - height) * (b[1] - height) < 0.f)
+				points.push_back(Lerp(a, b, (height - a[1]) / (b[1] - a[1])));
+		}
+	}
+
+	if (points.empty())
+		return false;
+
+	bounds[0] = bounds[1] = 1.f;
+	bounds[2] = bounds[3] = -1.f;
+
+	for (const auto& point : points)
+	{
+		// Punctele se aduc pe plan inainte de proiectie, ca grila sa acopere si valurile cele mai inalte
+		const Float4 projected = engine::math::TransformPoint(viewProjMatrix, {point[0], m_planeHeight, point[2]});
+		const float w = projected[3];
+
+		if (w <= 1e-4f)
+		{
+			// Punctul ajunge in spatele camerei; se foloseste tot ecranul
+			bounds[0] = bounds[1] = -1.f;
+			bounds[2] = bounds[3] = 1.f;
+			return true;
+		}
+
+		const float x = projected[0] / w;
+		const float y = projected[1] / w;
+
+		bounds[0] = std::min(bounds[0], x);
+		bounds[1] = std::min(bounds[1], y);
+		bounds[2] = std::max(bounds[2], x);
+		bounds[3] = std::max(bounds[3], y);
+	}
+
+	for (int i = 0; i < 4; i++)
+	{
+		bounds[i] = std::clamp(bounds[i], -1.f, 1.f);
+	}
+
+	return bounds[0] < bounds[2] && bounds[1] < bounds[3];
+}
+
+ProjectedGrid::Float3 ProjectedGrid::ProjectOnPlane(const Float4x4& invViewProjMatrix, float x, float y) const
+{
+	const Float3 nearPoint = Unproject(invViewProjMatrix, x, y, 0.f);
+	const Float3 farPoint = Unproject(invViewProjMatrix, x, y, 1.f);
+
+	const float nearY = nearPoint[1];
+	const float farY = farPoint[1];
+
+	// Raza nu atinge planul intre near si far (aproape de orizont): se foloseste punctul de pe far
+	Float3 point = farPoint;
+	if (std::abs(farY - nearY) > 1e-6f)
+	{
+		const float t = (m_planeHeight - nearY) / (farY - nearY);
+		if (t >= 0.f && t <= 1.f)
+			point = Lerp(nearPoint, farPoint, t);
+	}
+
+	return {point[0], m_planeHeight, point[2]};
+}
+
+std::vector<uint32_t> ProjectedGrid::GenerateIndices() const
+{
+	std::vector<uint32_t> indices;
+	indices.reserve(GetIndexCount());
+
+	const uint32_t rowPitch = m_columns + 1;
+
+	// Grila e in spatiu ecran, deci ordinea in sensul acelor de ceas se pastreaza indiferent de camera
+	for (uint32_t i = 0; i < m_rows; i++)
+	{
+		for (uint32_t j = 0; j < m_columns; j++)
+		{
+			indices.push_back(i * rowPitch + j);
+			indices.push_back((i + 1) * rowPitch + j);
+			indices.push_back((i + 1) * rowPitch + j + 1);
+
+			indices.push_back(i * rowPitch + j);
+			indices.push_back((i + 1) * rowPitch + j + 1);
+			indices.push_back(i * rowPitch + j + 1);
+		}
+	}
+
+	return indices;
+}
+
+}  // namespace engine::gfx
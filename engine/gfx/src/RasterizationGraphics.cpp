@@ -1,7 +1,19 @@
 #include "RasterizationGraphics.hpp"
 
+#include "engine/core/AllocationCounter.hpp"
 #include "engine/math/Frustum.hpp"
 
+#include <string>
+
+// Fisierul PVS se pastreaza langa texturile procesate
+#ifndef TEXTURE_DIR
+#define TEXTURE_DIR "assets/processed/"
+#endif
+
+#define WIDEN2(x) L##x
+#define WIDEN(x) WIDEN2(x)
+#define TEXTURE_DIR_W WIDEN(TEXTURE_DIR)
+
 namespace engine::gfx
 {
 
@@ -10,6 +22,38 @@ using namespace engine::gfx::RSBinding;
 using namespace engine::gfx::render_descriptors;
 using namespace engine::gfx::rasterization;
 
+namespace
+{
+
+// Numele pass-urilor fetelor, fara string-uri construite in fiecare cadru
+constexpr const char* CubeMapFacePassNames[] = {
+	"CubeMapFace0", "CubeMapFace1", "CubeMapFace2", "CubeMapFace3", "CubeMapFace4", "CubeMapFace5"};
+
+D3D12_RESOURCE_STATES ToResourceState(FrameGraphUsage::Mask usage)
+{
+	D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;
+
+	if (usage & FrameGraphUsage::RenderTarget)
+		state |= D3D12_RESOURCE_STATE_RENDER_TARGET;
+	if (usage & FrameGraphUsage::DepthWrite)
+		state |= D3D12_RESOURCE_STATE_DEPTH_WRITE;
+	if (usage & FrameGraphUsage::UnorderedAccess)
+		state |= D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+	if (usage & FrameGraphUsage::CopyDest)
+		state |= D3D12_RESOURCE_STATE_COPY_DEST;
+	if (usage & FrameGraphUsage::DepthRead)
+		state |= D3D12_RESOURCE_STATE_DEPTH_READ;
+	if (usage & FrameGraphUsage::ShaderResource)
+		state |= D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE;
+	if (usage & FrameGraphUsage::CopySource)
+		state |= D3D12_RESOURCE_STATE_COPY_SOURCE;
+
+	// Present e D3D12_RESOURCE_STATE_COMMON
+	return state;
+}
+
+}  // namespace
+
 RasterizationGraphics::RasterizationGraphics(GraphicsResources& graphicsResorurces) : Graphics(graphicsResorurces)
 {
 	GraphicsContext& graphicsContext = m_graphicsResources.GetGraphicsContext();
@@ -37,6 +81,12 @@ RasterizationGraphics::RasterizationGraphics(GraphicsResources& graphicsResorurc
 		m_shadowMap->Create();
 	}
 
+	// Draw-urile pass-ului principal se inregistreaza o data si se refolosesc cat timp nu se schimba
+	if (engine::core::Settings::GetGraphicsSettings().UseBundles())
+		m_baseBundle = CommandBundle::CreateCommandBundle();
+
+	m_recordingScheduler.Create(engine::core::Settings::GetGraphicsSettings().GetRecordingThreadCount());
+
 	{
 		DX_TERRAIN_DESCRIPTOR desc;
 		DX_OBJECT_DESCRIPTOR& objectDesc = desc.objectDescriptor;
@@ -66,6 +116,22 @@ RasterizationGraphics::RasterizationGraphics(GraphicsResources& graphicsResorurc
 		desc.simplexProperties.amplitudeFactor = 30.f;
 
 		m_terrainRender = TerrainRenderer::CreateTerrainRenderer(desc);
+
+		m_textureManager.CreateTextureFromMemory(
+			GraphicsResources::GetDevice(),
+			GraphicsResources::GetCommandQueue(),
+			L"Terrain.Splat",
+			m_terrainRender->GetSplatMapDescriptor(),
+			m_terrainRender->GetSplatMapSubresources(),
+			true);
+
+		m_textureManager.CreateTextureFromMemory(
+			GraphicsResources::GetDevice(),
+			GraphicsResources::GetCommandQueue(),
+			L"Terrain.TessellationScale",
+			m_terrainRender->GetTessellationMapDescriptor(),
+			m_terrainRender->GetTessellationMapSubresources(),
+			true);
 	}
 
 	{
@@ -171,6 +237,10 @@ RasterizationGraphics::RasterizationGraphics(GraphicsResources& graphicsResorurc
 	desc.shadowPSO = m_graphicsPipelineStateManager.GetPipelineState("ShadowMap");
 		desc.shadowTopology = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
 
+		desc.baseInstancedPSO = m_graphicsPipelineStateManager.GetPipelineState("DefaultInstanced");
+		desc.dynamicCubeMapInstancedPSO = m_graphicsPipelineStateManager.GetPipelineState("DefaultInstanced");
+		desc.shadowInstancedPSO = m_graphicsPipelineStateManager.GetPipelineState("ShadowMapInstanced");
+
 		// desc.debugShadowPipelineState = m_graphicsPipelineStateManager.GetPipelineState("Debug");
 
 		m_objectRenderer = ObjectRenderer::CreateObjectRenderer(desc);
@@ -197,6 +267,7 @@ void RasterizationGraphics::LoadAssets()
 	for (UINT i = 0; i < engine::core::Settings::GetFrameResourcesCount(); i++)
 	{
 		m_graphicsResources.GetFrameResources(i).UpdateTerrainCB(*m_terrainRender);
+		m_graphicsResources.GetFrameResources(i).UploadBindlessData();
 	}
 
 	m_dynamicGameComponents = m_objectRenderer->GetObjects();
@@ -221,12 +292,57 @@ void RasterizationGraphics::LoadAssets()
 	lightSource.m_lightProperties.Direction = engine::math::Vector3(0.0f, -1.0f, 0.0f);
 	m_lightSources.push_back(lightSource);
 
+	// Buffer de ocluzie 256x128, rasterizat pe 4 benzi in paralel
+	m_occlusionCuller = std::make_unique<OcclusionCuller>(256, 128, 4);
+	m_culler.SetOcclusionCuller(m_occlusionCuller.get());
+
+	LoadPotentiallyVisibleSet();
+
 	m_inspectionCamera = std::make_unique<OrthograficCamera>(
 		engine::math::Vector3(0, 100, 0), engine::math::Vector3(0, 0, 0), engine::math::Vector3(0, 0, 1), -200.f, 200.f, -200.f, 200.f);
 
 	m_timer.StartClock();
 }
 
+void RasterizationGraphics::LoadPotentiallyVisibleSet()
+{
+	if (!m_terrainRender->IsPVSEnabled())
+		return;
+
+	// Tintele PVS-ului: chunk-urile terenului, apoi cele ale apei
+	const std::vector<engine::math::AABB> terrainTargets = m_terrainRender->GetChunkBoundingBoxes();
+	const std::vector<engine::math::AABB> waterTargets = m_waterRenderer->GetChunkBoundingBoxes();
+
+	m_terrainRender->SetPVSTargetOffset(0);
+	m_waterRenderer->SetPVSTargetOffset((uint32_t)terrainTargets.size());
+
+	std::vector<engine::math::BoxBounds> targets;
+	targets.reserve(terrainTargets.size() + waterTargets.size());
+	for (const engine::math::AABB& target : terrainTargets)
+	{
+		targets.push_back(target.GetBounds());
+	}
+	for (const engine::math::AABB& target : waterTargets)
+	{
+		targets.push_back(target.GetBounds());
+	}
+
+	// Bake-ul ruleaza doar cand fisierul lipseste sau nu mai corespunde terenului
+	m_terrainPVS = TerrainPVS::LoadOrBake(
+		std::wstring(TEXTURE_DIR_W) + L"Terrain.pvs",
+		m_terrainRender->GetHeightfield(),
+		targets,
+		m_terrainRender->GetPVSProperties());
+
+	m_culler.SetPotentiallyVisibleSet(m_terrainPVS.get());
+
+	const std::string message = "PVS: " + std::to_string(m_terrainPVS->GetCellCount()) + " cells, "
+		+ std::to_string(m_terrainPVS->GetTargetCount()) + " targets, "
+		+ std::to_string(m_terrainPVS->GetCompressedSize()) + " bytes, "
+		+ std::to_string((int)(m_terrainPVS->GetVisibleRatio() * 100.f)) + "% visible\n";
+	OutputDebugStringA(message.c_str());
+}
+
 void RasterizationGraphics::Update(float deltaTime, float totalTime)
 {
 	FrameResources& frameResources = m_graphicsResources.GetFrameResources();
@@ -261,35 +377,64 @@ void RasterizationGraphics::Update(float deltaTime, float totalTime)
 
 	/////////////////////////////////////////////////////////////////////////
 	// Actaulizam camerele - main, cele de cubemap si cea pentru shadow map
-	if (m_cameraController.IsDirty())
+	const bool isCameraDirty = m_cameraController.IsDirty();
+	const bool isCubeMapDirty = engine::core::Settings::UseAdvancedReflections() && m_dynamicCubeMap->IsDirty();
+	const bool isShadowMapDirty = engine::core::Settings::UseShadows() && m_shadowMap->IsDirty();
+
+	if (isCameraDirty)
 	{
 		m_cameraController.Update();
-
-		m_terrainRender->FrustumCulling(m_cameraController);
-		m_waterRenderer->FrustumCulling(m_cameraController);
-		m_objectRenderer->FrustumCulling(m_cameraController);
-
-		m_cameraController.DecreaseDirtyCount();
 	}
 
-	if (engine::core::Settings::UseAdvancedReflections() && m_dynamicCubeMap->IsDirty())
+	if (isCubeMapDirty)
 	{
 		m_dynamicCubeMap->Update();
-
-		m_dynamicCubeMap->DecreaseDirtyCount();
 	}
 
-	if (engine::core::Settings::UseShadows() && m_shadowMap->IsDirty())
+	if (isShadowMapDirty)
 	{
 		m_shadowMap->Update();
 
 		m_lightSources[0].m_lightProperties.Direction = m_shadowMap->GetLightDirection();
 		m_lightSources[0].m_lightProperties.lightTransformMatrix =
 			engine::math::Matrix4::Transpose(m_shadowMap->GetCamera().GetViewProjMatrix());
+	}
 
-		m_shadowMap->DecreaseDirtyCount();
+	// Un singur culling pentru toate view-urile, dupa ce s-au actualizat toate camerele
+	if (isCameraDirty || isCubeMapDirty || isShadowMapDirty)
+	{
+		UpdateCullingViews();
+
+		// Bufferul de ocluzie depinde doar de camera principala
+		if (isCameraDirty)
+		{
+			m_occlusionCuller->BeginFrame(m_cameraController.GetCamera().GetViewProjMatrix().GetFloat4x4());
+			m_occlusionCuller->AddOccluder(m_terrainRender->GetOccluder());
+			m_occlusionCuller->Rasterize(&m_recordingScheduler);
+		}
+
+		m_culler.BeginSweep();
+
+		m_terrainRender->FrustumCulling(m_culler);
+		m_waterRenderer->FrustumCulling(m_culler);
+		m_objectRenderer->FrustumCulling(m_culler);
 	}
 
+	// Regiunea ExecuteIndirect a frame-ului curent se scrie in fiecare frame, chiar daca nu s-a refacut culling-ul
+	m_terrainRender->UploadIndirectDraws();
+	m_waterRenderer->UploadIndirectDraws();
+	m_objectRenderer->UploadIndirectDraws();
+	m_objectRenderer->BuildInstanceBatches();
+
+	if (isCameraDirty)
+		m_cameraController.DecreaseDirtyCount();
+
+	if (isCubeMapDirty)
+		m_dynamicCubeMap->DecreaseDirtyCount();
+
+	if (isShadowMapDirty)
+		m_shadowMap->DecreaseDirtyCount();
+
 	/////////////////////////////////////////////////////////////////////////
 	// Actualizam bufferele CB
 	// Ordinea la pass este importanta!!!!
@@ -300,11 +445,58 @@ void RasterizationGraphics::Update(float deltaTime, float totalTime)
 	frameResources.UpdatePerMaterialCB(m_materialManager);
 	frameResources.UpdateSkyBoxCB(*m_skyBoxRenderer);
 	frameResources.UpdateWaterCB(*m_waterRenderer);
+	frameResources.UploadBindlessData();
 }
 
-void RasterizationGraphics::PopulateCommandList()
+void RasterizationGraphics::UpdateCullingViews()
+{
+	const PerspectiveCamera& camera = m_cameraController.GetCamera();
+	m_culler.SetView(
+		CullingView::Main,
+		m_cameraController.GetWorldSpaceFrustum().GetPlanes(),
+		camera.GetViewProjMatrix().GetFloat4x4(),
+		camera.GetPosition().GetFloat3(),
+		camera.GetZFar());
+
+	// Shadow map-ul este ortografic: frustumul se extrage din matrice, fara test de distanta
+	if (engine::core::Settings::UseShadows())
+	{
+		const OrthograficCamera& shadowCamera = m_shadowMap->GetCamera();
+		m_culler.SetView(
+			CullingView::Shadow,
+			engine::math::Frustum::FromViewProjMatrix(shadowCamera.GetViewProjMatrix()).GetPlanes(),
+			shadowCamera.GetViewProjMatrix().GetFloat4x4(),
+			shadowCamera.GetPosition().GetFloat3(),
+			0.f);
+	}
+	else
+	{
+		m_culler.DisableView(CullingView::Shadow);
+	}
+
+	const CubeMapCameraController& cubeMapController = m_dynamicCubeMap->GetCameraController();
+	for (UINT face = 0; face < 6; face++)
+	{
+		const CullingView::Value view = (CullingView::Value)(CullingView::CubeMapFace0 + face);
+
+		if (engine::core::Settings::UseAdvancedReflections())
+		{
+			m_culler.SetView(
+				view,
+				cubeMapController.GetFrustum(face).GetPlanes(),
+				cubeMapController.GetCamera(face).GetViewProjMatrix().GetFloat4x4(),
+				cubeMapController.GetPosition().GetFloat3(),
+				cubeMapController.GetZFar(face));
+		}
+		else
+		{
+			m_culler.DisableView(view);
+		}
+	}
+}
+
+void RasterizationGraphics::SetDefaultRootArguments(GraphicsContext& graphicsContext)
 {
-	GraphicsContext& graphicsContext = m_graphicsResources.GetGraphicsContext();
 	FrameResources& frameResources = m_graphicsResources.GetFrameResources();
 
 	graphicsContext.SetRootSignature(*m_rootSignatureManager.GetRootSignature("Default"));
@@ -315,61 +507,249 @@ void RasterizationGraphics::PopulateCommandList()
 	graphicsContext.SetDescriptorTable(DefaultRSBindings::StaticPixelTextures, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 	graphicsContext.SetDescriptorTable(
 		DefaultRSBindings::StaticNonPixelTextures, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	graphicsContext.SetDescriptorTable(
+		DefaultRSBindings::TerrainSplatMap, m_textureManager.GetTexture(L"Terrain.Splat").GetSrvHandle());
+	graphicsContext.SetDescriptorTable(
+		DefaultRSBindings::TerrainTessellationScale,
+		m_textureManager.GetTexture(L"Terrain.TessellationScale").GetSrvHandle());
+	graphicsContext.SetDescriptorTable(DefaultRSBindings::DynamicTextures, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+	// Bufferele bindless ale cadrului; bundle-ul pass-ului principal le mosteneste
+	if (FrameResources::UseBindlessData())
+	{
+		graphicsContext.SetShaderResourceView(
+			DefaultRSBindings::ObjectData, frameResources.m_objectData.GpuVirtualAddress());
+		graphicsContext.SetShaderResourceView(
+			DefaultRSBindings::MaterialData, frameResources.m_materialData.GpuVirtualAddress());
+	}
 
 	graphicsContext.SetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+}
 
-	if (m_shadowMap->IsRenderDirty())
+void RasterizationGraphics::ApplyBarriers(
+	GraphicsContext& graphicsContext, const std::vector<FrameGraphBarrier>& barriers)
+{
+	for (const FrameGraphBarrier& barrier : barriers)
 	{
-		m_shadowMap->Setup(graphicsContext);
+		GpuResource& resource = *m_frameGraphResources[barrier.resource];
 
-		graphicsContext.SetConstantBuffer(DefaultRSBindings::PassCB, frameResources.m_perPassCB.GetGpuVirtualAdress(7));
+		// Partea EndOnly e un TransitionResource obisnuit: trackerul contextului o recunoaste dupa tranzitia inceputa
+		if (barrier.split == SplitBarrier::BeginOnly)
+			graphicsContext.BeginResourceTransition(resource, ToResourceState(barrier.after));
+		else
+			graphicsContext.TransitionResource(resource, ToResourceState(barrier.after));
+	}
+}
 
-		//m_objectRenderer->Render(RenderLayer::ShadowMap);
-		m_terrainRender->Render(RenderLayer::ShadowMap);
+void RasterizationGraphics::PopulateCommandList()
+{
+	GraphicsContext& graphicsContext = m_graphicsResources.GetGraphicsContext();
+	FrameResources& frameResources = m_graphicsResources.GetFrameResources();
 
-		m_shadowMap->Finish(graphicsContext);
-		m_shadowMap->SetRenderDirty(false);
-	}
+	// Texturile statice se leaga ca tabele intregi in fiecare pass, deci sunt folosite in fiecare cadru
+	m_textureManager.MarkUsed();
 
-	graphicsContext.SetDescriptorTable(DefaultRSBindings::DynamicTextures, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	/////////////////////////////////////////////////////////////////////////
+	// Graful cadrului: pass-urile declara ce scriu si ce citesc, compilarea da ordinea si tranzitiile
+	m_frameGraph.Reset();
+	m_frameGraphResources.clear();
+
+	const auto importResource = [this](GpuResource& resource,
+									std::string_view name,
+									FrameGraphUsage::Mask initialUsage,
+									FrameGraphUsage::Mask finalUsage)
+	{
+		m_frameGraphResources.push_back(&resource);
+		return m_frameGraph.ImportResource(name, initialUsage, finalUsage);
+	};
+
+	// Shadow map-ul si cube map-ul se pastreaza intre cadre, deci raman citibile cat timp nu se randeaza din nou
+	FrameGraphResource shadowMap = importResource(
+		m_shadowMap->GetDepthTexture(),
+		"ShadowMap",
+		FrameGraphUsage::ShaderResource,
+		FrameGraphUsage::ShaderResource);
+	FrameGraphResource cubeMap = importResource(
+		m_dynamicCubeMap->GetCubeMapTexture(),
+		"CubeMap",
+		FrameGraphUsage::ShaderResource,
+		FrameGraphUsage::ShaderResource);
+	FrameGraphResource cubeMapDepth = importResource(
+		m_dynamicCubeMap->GetDepthTexture(), "CubeMapDepth", FrameGraphUsage::DepthWrite, FrameGraphUsage::Undefined);
+
+	// Pass-ul principal le citeste in fiecare cadru; depth-ul cube map-ului doar cand se randeaza fetele, altfel
+	// poate fi evacuat
+	m_shadowMap->GetDepthTexture().MarkUsed();
+	m_dynamicCubeMap->GetCubeMapTexture().MarkUsed();
+
+	FrameGraphPass shadowPass = FrameGraph::NoPass;
+	if (m_shadowMap->IsRenderDirty())
+	{
+		shadowPass = m_frameGraph.AddPass("ShadowMap");
+		shadowMap = m_frameGraph.Write(shadowPass, shadowMap, FrameGraphUsage::DepthWrite);
+	}
 
+	// Fetele se declara consecutiv, deci indexul fetei e distanta fata de primul pass
+	FrameGraphPass firstCubeMapPass = FrameGraph::NoPass;
 	if (m_dynamicCubeMap->IsRenderDirty())
 	{
-		m_dynamicCubeMap->Setup(graphicsContext);
+		m_dynamicCubeMap->GetDepthTexture().MarkUsed();
 
-		for (int i = 0; i < 6; i++)
-		{
-			m_dynamicCubeMap->SetRenderTarget(graphicsContext, i);
+		static_assert(std::size(CubeMapFacePassNames) == std::tuple_size_v<decltype(m_cubeMapQueues)>);
 
-			graphicsContext.SetConstantBuffer(
-				DefaultRSBindings::PassCB, frameResources.m_perPassCB.GetGpuVirtualAdress(i + 1));
+		for (UINT i = 0; i < (UINT)m_cubeMapQueues.size(); i++)
+		{
+			const FrameGraphPass facePass = m_frameGraph.AddPass(CubeMapFacePassNames[i]);
+			cubeMap = m_frameGraph.Write(facePass, cubeMap, FrameGraphUsage::RenderTarget);
+			cubeMapDepth = m_frameGraph.Write(facePass, cubeMapDepth, FrameGraphUsage::DepthWrite);
 
-			m_skyBoxRenderer->Render(RenderLayer::CubeMap);
-			m_terrainRender->Render(RenderLayer::CubeMap);
-			// m_objectRenderer->Render(RenderLayer::CubeMap);
+			if (i == 0)
+				firstCubeMapPass = facePass;
 		}
-
-		m_dynamicCubeMap->Finish(graphicsContext);
-		m_dynamicCubeMap->SetRenderDirty(false);
 	}
 
-	m_graphicsResources.SetRenderTarget();
+	// Back buffer-ul ramane la GraphicsResources (tranzitiile lui depind de modul RT / MSAA), deci pass-ul principal
+	// are efecte laterale
+	const FrameGraphPass mainPass = m_frameGraph.AddPass("Main", true);
+	m_frameGraph.Read(mainPass, shadowMap, FrameGraphUsage::ShaderResource);
+	m_frameGraph.Read(mainPass, cubeMap, FrameGraphUsage::ShaderResource);
 
-	graphicsContext.SetConstantBuffer(DefaultRSBindings::PassCB, frameResources.m_perPassCB.GetGpuVirtualAdress(0));
+	// Jumatatile unei tranzitii split trebuie sa fie pe aceeasi lista, deci doar cand toate pass-urile folosesc
+	// contextul de cadru
+	m_frameGraph.Compile(!m_recordingScheduler.IsParallel());
 
-	// m_objectRenderer->Render(pResources, RenderLayer::DebugShadowMap);
-	// return;
-	graphicsContext.SetDescriptorTable(DefaultRSBindings::DynamicTextures, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	if (m_frameGraph.GetPassCount() != m_reportedFrameGraphPassCount)
+	{
+		m_reportedFrameGraphPassCount = m_frameGraph.GetPassCount();
 
-	m_skyBoxRenderer->Render(RenderLayer::Base);
-	//m_objectRenderer->Render(RenderLayer::Base);
+		// Doar la schimbarea grafului; nu intra in numaratoarea alocarilor din cadru
+		engine::core::UncountedAllocationScope uncountedScope;
 
-	graphicsContext.SetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_3_CONTROL_POINT_PATCHLIST);
+		// Toate resursele de aici sunt importate (shadow map-ul si cube map-ul se pastreaza intre cadre, depth-ul cube
+		// map-ului e al DynamicCubeMap), deci aliasing-ul nu are ce suprapune; raportul o spune in loc de 0 bytes
+		const FrameGraphMemoryStatistics& statistics = m_frameGraph.GetMemoryStatistics();
+		std::string message = "FrameGraph: " + std::to_string(m_frameGraph.GetExecutionOrder().size()) + " passes, "
+			+ std::to_string(statistics.culledPasses) + " culled, " + std::to_string(statistics.barrierCount)
+			+ " barriers, ";
+
+		if (statistics.transientBytes == 0)
+			message += "no transient resources, aliasing inactive\n";
+		else
+			message += "transient " + std::to_string(statistics.transientBytes) + " bytes, aliased "
+				+ std::to_string(statistics.aliasedBytes) + " bytes\n";
+
+		OutputDebugStringA(message.c_str());
+	}
 
-	m_terrainRender->Render(RenderLayer::Base);
-	m_waterRenderer->Render(RenderLayer::Base);
+	/////////////////////////////////////////////////////////////////////////
+	// Cozile se construiesc aici, pe thread-ul principal (renderer-ele au stare comuna, ex. fata cube map-ului);
+	// workerii doar redau cozile gata sortate. Fara workeri toate pass-urile folosesc contextul de cadru.
+	// Contextele se iau in ordinea executiei, care e si ordinea in care se trimit.
+	const auto acquirePassContext = [this, &graphicsContext]() -> GraphicsContext&
+	{
+		if (!m_recordingScheduler.IsParallel())
+			return graphicsContext;
+
+		return GraphicsResources::GetContextManager().AcquireRecordingContext();
+	};
+
+	m_recordingPasses.clear();
+
+	for (FrameGraphPass pass : m_frameGraph.GetExecutionOrder())
+	{
+		if (pass == shadowPass)
+		{
+			m_shadowQueue.Reset();
+			//m_objectRenderer->SubmitDraws(m_shadowQueue, RenderLayer::ShadowMap, m_shadowMap->GetCamera());
+			m_terrainRender->SubmitDraws(m_shadowQueue, RenderLayer::ShadowMap, m_shadowMap->GetCamera());
+			m_shadowQueue.Sort();
+
+			GraphicsContext& shadowContext = acquirePassContext();
+
+			m_recordingPasses.push_back(
+				{[this, &shadowContext, &frameResources, pass]()
+				 {
+					 ApplyBarriers(shadowContext, m_frameGraph.GetBarriers(pass));
+					 SetDefaultRootArguments(shadowContext);
+					 m_shadowMap->Setup(shadowContext);
+					 shadowContext.SetConstantBuffer(
+						 DefaultRSBindings::PassCB, frameResources.m_perPassCB.GetGpuVirtualAdress(7));
+				 },
+				 [this, &shadowContext]() { ReplayDrawPackets(shadowContext, m_shadowQueue); },
+				 [this]() { m_shadowMap->SetRenderDirty(false); }});
+		}
+		else if (pass == mainPass)
+		{
+			// Draw-urile pass-ului principal trec prin coada sortata; skybox-ul e pe layer-ul Background, deci ramane
+			// primul
+			m_renderQueue.Reset();
+			m_skyBoxRenderer->SubmitDraws(m_renderQueue, RenderLayer::Base, m_camera);
+			//m_objectRenderer->SubmitDraws(m_renderQueue, RenderLayer::Base, m_camera);
+			m_terrainRender->SubmitDraws(m_renderQueue, RenderLayer::Base, m_camera);
+			m_renderQueue.Sort();
+
+			// Pass-ul principal ramane pe contextul de cadru: render target-ul si apa il folosesc direct
+			m_recordingPasses.push_back(
+				{[this, &graphicsContext, &frameResources, pass]()
+				 {
+					 ApplyBarriers(graphicsContext, m_frameGraph.GetBarriers(pass));
+					 SetDefaultRootArguments(graphicsContext);
+					 m_graphicsResources.SetRenderTarget();
+					 graphicsContext.SetConstantBuffer(
+						 DefaultRSBindings::PassCB, frameResources.m_perPassCB.GetGpuVirtualAdress(0));
+				 },
+				 [this, &graphicsContext]()
+				 {
+					 if (m_baseBundle)
+						 m_baseBundle->Execute(
+							 graphicsContext, *m_rootSignatureManager.GetRootSignature("Default"), m_renderQueue);
+					 else
+						 ReplayDrawPackets(graphicsContext, m_renderQueue);
+				 },
+				 [this, &graphicsContext]()
+				 {
+					 // Apa are root signature-ul ei, deci se deseneaza in afara cozii
+					 graphicsContext.SetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_3_CONTROL_POINT_PATCHLIST);
+
+					 m_waterRenderer->Render(RenderLayer::Base);
+
+					 //m_textureRenderer->Render(RenderLayer::Base);
+
+					 ApplyBarriers(graphicsContext, m_frameGraph.GetFinalBarriers());
+				 }});
+		}
+		else
+		{
+			const UINT i = pass - firstCubeMapPass;
+			const PerspectiveCamera& faceCamera = m_dynamicCubeMap->GetCameraController().GetCamera(i);
+
+			m_terrainRender->SetCubeMapFace(i);
+
+			m_cubeMapQueues[i].Reset();
+			m_skyBoxRenderer->SubmitDraws(m_cubeMapQueues[i], RenderLayer::CubeMap, faceCamera);
+			m_terrainRender->SubmitDraws(m_cubeMapQueues[i], RenderLayer::CubeMap, faceCamera);
+			// m_objectRenderer->SubmitDraws(m_cubeMapQueues[i], RenderLayer::CubeMap, faceCamera);
+			m_cubeMapQueues[i].Sort();
+
+			GraphicsContext& faceContext = acquirePassContext();
+
+			// Tranzitia cube map-ului o primeste doar prima fata; cele urmatoare il gasesc deja ca render target
+			m_recordingPasses.push_back(
+				{[this, &faceContext, &frameResources, pass, i]()
+				 {
+					 ApplyBarriers(faceContext, m_frameGraph.GetBarriers(pass));
+					 SetDefaultRootArguments(faceContext);
+					 m_dynamicCubeMap->Setup(faceContext);
+					 m_dynamicCubeMap->SetRenderTarget(faceContext, i);
+					 faceContext.SetConstantBuffer(
+						 DefaultRSBindings::PassCB, frameResources.m_perPassCB.GetGpuVirtualAdress(i + 1));
+				 },
+				 [this, &faceContext, i]() { ReplayDrawPackets(faceContext, m_cubeMapQueues[i]); },
+				 [this]() { m_dynamicCubeMap->SetRenderDirty(false); }});
+		}
+	}
 
-	//m_textureRenderer->Render(RenderLayer::Base);
+	m_recordingScheduler.Execute(m_recordingPasses);
 }
 
 }  // namespace engine::gfx
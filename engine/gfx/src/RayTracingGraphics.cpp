@@ -54,6 +54,14 @@ RayTracingGraphics::RayTracingGraphics(GraphicsResources& resources) : Graphics(
 		desc.simplexProperties.amplitudeFactor = 30.f;
 
 		m_terrainRender = TerrainRenderer::CreateTerrainRenderer(desc);
+
+		m_textureManager.CreateTextureFromMemory(
+			GraphicsResources::GetDevice(),
+			GraphicsResources::GetCommandQueue(),
+			L"Terrain.Splat",
+			m_terrainRender->GetSplatMapDescriptor(),
+			m_terrainRender->GetSplatMapSubresources(),
+			true);
 	}
 
 	{
@@ -199,6 +207,9 @@ void RayTracingGraphics::PopulateCommandList()
 	ComputeContext& commandContext = m_graphicsResources.GetGraphicsContext().GetComputeContext();
 	FrameResources& frameResources = m_graphicsResources.GetFrameResources();
 
+	// Shader-ele pot citi orice textura din heap
+	m_textureManager.MarkUsed();
+
 	D3D12_DISPATCH_RAYS_DESC raytraceDesc = {};
 	{
 		raytraceDesc.Width = engine::core::Settings::GetGraphicsSettings().GetWidth();
@@ -317,6 +328,7 @@ void RayTracingGraphics::CreateShaderTable()
 			D3D12_GPU_VIRTUAL_ADDRESS materialCBHnadle;
 			D3D12_GPU_DESCRIPTOR_HANDLE vertexIndexHandle;
 			D3D12_GPU_DESCRIPTOR_HANDLE textureSRVHnadle;
+			D3D12_GPU_DESCRIPTOR_HANDLE splatMapSRVHandle;
 		};
 
 		struct AABBRootArguments
@@ -335,6 +347,7 @@ void RayTracingGraphics::CreateShaderTable()
 				frameResources.m_perMaterialCB.GetGpuVirtualAdress(m_terrainRender->GetMaterialCB_ID());
 			terrainRootArguments.vertexIndexHandle = m_terrainRender->GetVertexBuffer().GetSRVHandle();
 			terrainRootArguments.textureSRVHnadle = m_textureManager.GetTexture(L"Terrain.Diffuse").GetSrvHandle();
+			terrainRootArguments.splatMapSRVHandle = m_textureManager.GetTexture(L"Terrain.Splat").GetSrvHandle();
 		}
 
 		AABBRootArguments waterRootArguments;
@@ -0,0 +1,151 @@
+#include "RecordingScheduler.hpp"
+
+#include <cassert>
+
+namespace engine::gfx
+{
+
+RecordingScheduler::~RecordingScheduler()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isStopping = true;
+	}
+
+	m_workAvailable.notify_all();
+
+	for (std::thread& worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+void RecordingScheduler::Create(uint32_t workerCount)
+{
+	assert(m_workers.empty());
+
+	m_workers.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; i++)
+	{
+		m_workers.emplace_back(&RecordingScheduler::WorkerLoop, this);
+	}
+}
+
+void RecordingScheduler::Execute(const std::vector<RecordingPass>& passes)
+{
+	if (passes.empty())
+		return;
+
+	if (m_workers.empty())
+	{
+		for (const RecordingPass& pass : passes)
+		{
+			if (pass.begin)
+				pass.begin();
+			if (pass.record)
+				pass.record();
+			if (pass.end)
+				pass.end();
+		}
+
+		return;
+	}
+
+	for (const RecordingPass& pass : passes)
+	{
+		if (pass.begin)
+			pass.begin();
+	}
+
+	uint64_t generation;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		m_passes = &passes;
+		m_nextPass = 0;
+		m_pendingPasses = (uint32_t)passes.size();
+		m_exception = nullptr;
+		generation = ++m_generation;
+	}
+
+	m_workAvailable.notify_all();
+
+	// Thread-ul apelant inregistreaza si el, in loc sa astepte
+	RunPasses(generation);
+
+	std::exception_ptr exception;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_workDone.wait(lock, [this]() { return m_pendingPasses == 0; });
+
+		m_passes = nullptr;
+		exception = m_exception;
+		m_exception = nullptr;
+	}
+
+	if (exception)
+		std::rethrow_exception(exception);
+
+	for (const RecordingPass& pass : passes)
+	{
+		if (pass.end)
+			pass.end();
+	}
+}
+
+void RecordingScheduler::WorkerLoop()
+{
+	uint64_t seenGeneration = 0;
+
+	for (;;)
+	{
+		uint64_t generation;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_workAvailable.wait(
+				lock, [this, seenGeneration]() { return m_isStopping || m_generation != seenGeneration; });
+
+			if (m_isStopping)
+				return;
+
+			generation = seenGeneration = m_generation;
+		}
+
+		RunPasses(generation);
+	}
+}
+
+void RecordingScheduler::RunPasses(uint64_t generation)
+{
+	for (;;)
+	{
+		const RecordingPass* pass;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			// Lotul nu se poate termina cat timp un pass luat din el nu e gata, deci m_passes ramane valid
+			if (generation != m_generation || !m_passes || m_nextPass >= m_passes->size())
+				return;
+
+			pass = &(*m_passes)[m_nextPass++];
+		}
+
+		try
+		{
+			if (pass->record)
+				pass->record();
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_exception)
+				m_exception = std::current_exception();
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (--m_pendingPasses == 0)
+			m_workDone.notify_one();
+	}
+}
+
+}  // namespace engine::gfx
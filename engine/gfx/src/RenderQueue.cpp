@@ -0,0 +1,68 @@
+#include "RenderQueue.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace engine::gfx
+{
+
+uint32_t SortKey::QuantizeDepth(float distance, float maxDistance, bool reverse)
+{
+	constexpr uint32_t maxValue = (1u << DepthBits) - 1;
+
+	if (!(maxDistance > 0.f))
+		return 0;
+
+	const float normalized = std::clamp(distance / maxDistance, 0.f, 1.f);
+	const uint32_t depth = (uint32_t)std::lround(normalized * maxValue);
+
+	return reverse ? maxValue - depth : depth;
+}
+
+void RadixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch)
+{
+	constexpr int passCount = sizeof(uint64_t);
+	const size_t count = entries.size();
+
+	if (count < 2)
+		return;
+
+	// Histogramele tuturor octetilor dintr-o singura parcurgere
+	std::array<std::array<uint32_t, 256>, passCount> histograms = {};
+	for (const SortEntry& entry : entries)
+	{
+		for (int pass = 0; pass < passCount; pass++)
+		{
+			histograms[pass][(entry.key >> (pass * 8)) & 0xFF]++;
+		}
+	}
+
+	scratch.resize(count);
+
+	for (int pass = 0; pass < passCount; pass++)
+	{
+		std::array<uint32_t, 256>& histogram = histograms[pass];
+
+		// Toate cheile au acelasi octet - trecerea nu schimba ordinea
+		if (histogram[(entries[0].key >> (pass * 8)) & 0xFF] == count)
+			continue;
+
+		uint32_t offset = 0;
+		for (uint32_t& bucket : histogram)
+		{
+			const uint32_t bucketCount = bucket;
+			bucket = offset;
+			offset += bucketCount;
+		}
+
+		for (const SortEntry& entry : entries)
+		{
+			scratch[histogram[(entry.key >> (pass * 8)) & 0xFF]++] = entry;
+		}
+
+		entries.swap(scratch);
+	}
+}
+
+}  // namespace engine::gfx
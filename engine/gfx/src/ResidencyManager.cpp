@@ -0,0 +1,130 @@
+#include "ResidencyManager.hpp"
+
+#include "engine/core/DxgiInfoManager.hpp"
+#include "engine/core/Exceptions.hpp"
+#include "engine/core/GraphicsThrowMacros.hpp"
+#include "engine/core/Settings.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace engine::gfx
+{
+
+void ResidencyManager::Create(ID3D12Device* device, IDXGIAdapter3* adapter)
+{
+	pDevice = device;
+	pAdapter = adapter;
+
+	m_budget = QueryBudget();
+}
+
+ResidencyManager::Handle ResidencyManager::Track(
+	ID3D12Pageable* pObject, UINT64 size, ResidencyPriority::Value priority)
+{
+	assert(pObject != nullptr);
+
+	const Handle handle = m_policy.Add(size, priority, m_frame);
+
+	if (handle >= m_objects.size())
+		m_objects.resize(handle + 1, nullptr);
+	m_objects[handle] = pObject;
+
+	return handle;
+}
+
+void ResidencyManager::Untrack(Handle handle)
+{
+	// O resursa evacuata se poate elibera direct
+	m_policy.Remove(handle);
+	m_objects[handle] = nullptr;
+}
+
+void ResidencyManager::MarkUsed(Handle handle)
+{
+	HRESULT hr;
+
+	if (!m_policy.MarkUsed(handle, m_frame))
+		return;
+
+	ID3D12Pageable* pObject = m_objects[handle];
+	GFX_THROW_INFO(pDevice->MakeResident(1, &pObject));
+}
+
+void ResidencyManager::Update(UINT64 completedFenceValue)
+{
+	while (!m_framesInFlight.empty() && m_framesInFlight.front().fenceValue <= completedFenceValue)
+	{
+		m_completedFrame = m_framesInFlight.front().frame;
+		m_framesInFlight.pop_front();
+	}
+
+	m_budget = QueryBudget();
+
+	m_policy.Update(m_completedFrame, m_budget, m_evicted, m_madeResident);
+
+	Evict(m_evicted);
+	MakeResident(m_madeResident);
+}
+
+void ResidencyManager::RetireFrame(UINT64 fenceValue)
+{
+	assert(m_framesInFlight.empty() || m_framesInFlight.back().fenceValue <= fenceValue);
+
+	m_framesInFlight.push_back({m_frame, fenceValue});
+	m_frame++;
+}
+
+UINT64 ResidencyManager::QueryBudget()
+{
+	HRESULT hr;
+
+	DXGI_QUERY_VIDEO_MEMORY_INFO memoryInfo = {};
+	GFX_THROW_INFO(pAdapter->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &memoryInfo));
+
+	UINT64 budget = memoryInfo.Budget;
+
+	const UINT64 budgetMB = engine::core::Settings::GetGraphicsSettings().GetResidencyBudgetMB();
+	if (budgetMB != 0)
+		budget = std::min(budget, budgetMB * 1024 * 1024);
+
+	// CurrentUsage include resursele urmarite rezidente; restul memoriei e folosita de resurse neurmarite
+	const UINT64 residentSize = m_policy.GetResidentSize();
+	const UINT64 untrackedUsage = memoryInfo.CurrentUsage > residentSize ? memoryInfo.CurrentUsage - residentSize : 0;
+
+	return budget > untrackedUsage ? budget - untrackedUsage : 0;
+}
+
+void ResidencyManager::Evict(const std::vector<Handle>& handles)
+{
+	HRESULT hr;
+
+	if (handles.empty())
+		return;
+
+	m_batch.clear();
+	for (Handle handle : handles)
+	{
+		m_batch.push_back(m_objects[handle]);
+	}
+
+	GFX_THROW_INFO(pDevice->Evict((UINT)m_batch.size(), m_batch.data()));
+}
+
+void ResidencyManager::MakeResident(const std::vector<Handle>& handles)
+{
+	HRESULT hr;
+
+	if (handles.empty())
+		return;
+
+	m_batch.clear();
+	for (Handle handle : handles)
+	{
+		m_batch.push_back(m_objects[handle]);
+	}
+
+	GFX_THROW_INFO(pDevice->MakeResident((UINT)m_batch.size(), m_batch.data()));
+}
+
+}  // namespace engine::gfx
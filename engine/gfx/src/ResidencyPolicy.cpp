@@ -0,0 +1,168 @@
+#include "ResidencyPolicy.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace engine::gfx
+{
+
+ResidencyPolicy::Handle ResidencyPolicy::Add(uint64_t size, ResidencyPriority::Value priority, uint64_t frame)
+{
+	Handle handle;
+	if (!m_freeHandles.empty())
+	{
+		handle = m_freeHandles.back();
+		m_freeHandles.pop_back();
+	}
+	else
+	{
+		handle = (Handle)m_entries.size();
+		m_entries.emplace_back();
+	}
+
+	Entry& entry = m_entries[handle];
+	entry.size = size;
+	entry.lastUsedFrame = frame;
+	entry.priority = priority;
+	entry.isResident = true;
+	entry.isAlive = true;
+
+	m_residentSize += size;
+	m_totalSize += size;
+
+	return handle;
+}
+
+void ResidencyPolicy::Remove(Handle handle)
+{
+	Entry& entry = m_entries[handle];
+	assert(entry.isAlive);
+
+	if (entry.isResident)
+		m_residentSize -= entry.size;
+	m_totalSize -= entry.size;
+
+	entry = {};
+	m_freeHandles.push_back(handle);
+}
+
+bool ResidencyPolicy::MarkUsed(Handle handle, uint64_t frame)
+{
+	Entry& entry = m_entries[handle];
+	assert(entry.isAlive && entry.lastUsedFrame <= frame);
+
+	// Resursele folosite in cadrul curent nu se evacueaza, deci sunt rezidente
+	if (entry.lastUsedFrame == frame)
+		return false;
+
+	entry.lastUsedFrame = frame;
+	m_statistics.useCount++;
+
+	if (entry.isResident)
+		return false;
+
+	m_statistics.missCount++;
+	MakeResident(handle);
+
+	return true;
+}
+
+void ResidencyPolicy::Update(
+	uint64_t completedFrame, uint64_t budget, std::vector<Handle>& evicted, std::vector<Handle>& madeResident)
+{
+	evicted.clear();
+	madeResident.clear();
+
+	if (m_residentSize > budget)
+	{
+		m_candidates.clear();
+		for (Handle handle = 0; handle < (Handle)m_entries.size(); handle++)
+		{
+			const Entry& entry = m_entries[handle];
+			if (entry.isAlive && entry.isResident && entry.lastUsedFrame <= completedFrame)
+				m_candidates.push_back(handle);
+		}
+
+		std::sort(
+			m_candidates.begin(),
+			m_candidates.end(),
+			[this](Handle a, Handle b)
+			{
+				const Entry& first = m_entries[a];
+				const Entry& second = m_entries[b];
+				if (first.priority != second.priority)
+					return first.priority < second.priority;
+				return first.lastUsedFrame < second.lastUsedFrame;
+			});
+
+		for (size_t i = 0; i < m_candidates.size() && m_residentSize > budget; i++)
+		{
+			Evict(m_candidates[i], evicted);
+		}
+
+		// Restul sunt folosite de cadrele in zbor; se evacueaza dupa ce le termina GPU-ul
+		if (m_residentSize > budget)
+			m_statistics.overBudgetFrameCount++;
+
+		// Fara prefetch in acelasi Update: ar aduce inapoi ce tocmai s-a evacuat
+		return;
+	}
+
+	m_candidates.clear();
+	for (Handle handle = 0; handle < (Handle)m_entries.size(); handle++)
+	{
+		const Entry& entry = m_entries[handle];
+		if (entry.isAlive && !entry.isResident && m_residentSize + entry.size <= budget)
+			m_candidates.push_back(handle);
+	}
+
+	std::sort(
+		m_candidates.begin(),
+		m_candidates.end(),
+		[this](Handle a, Handle b)
+		{
+			const Entry& first = m_entries[a];
+			const Entry& second = m_entries[b];
+			if (first.priority != second.priority)
+				return first.priority > second.priority;
+			return first.lastUsedFrame > second.lastUsedFrame;
+		});
+
+	for (Handle handle : m_candidates)
+	{
+		if (m_residentSize + m_entries[handle].size > budget)
+			continue;
+
+		m_statistics.prefetchCount++;
+		MakeResident(handle);
+		madeResident.push_back(handle);
+	}
+}
+
+void ResidencyPolicy::Evict(Handle handle, std::vector<Handle>& evicted)
+{
+	Entry& entry = m_entries[handle];
+	assert(entry.isResident);
+
+	entry.isResident = false;
+	m_residentSize -= entry.size;
+
+	m_statistics.evictedCount++;
+	m_statistics.evictedSize += entry.size;
+
+	evicted.push_back(handle);
+}
+
+void ResidencyPolicy::MakeResident(Handle handle)
+{
+	Entry& entry = m_entries[handle];
+	assert(!entry.isResident);
+
+	entry.isResident = true;
+	m_residentSize += entry.size;
+
+	m_statistics.madeResidentCount++;
+	m_statistics.madeResidentSize += entry.size;
+}
+
+}  // namespace engine::gfx
@@ -0,0 +1,248 @@
+#include "ResourceStateTracker.hpp"
+
+#include <algorithm>
+
+namespace engine::gfx
+{
+
+void SubresourceStates::SetState(uint32_t subresource, uint32_t state, uint32_t subresourceCount)
+{
+	if (subresource == AllSubresources)
+	{
+		m_state = state;
+		m_states.clear();
+
+		return;
+	}
+
+	if (IsUniform())
+	{
+		if (m_state == state)
+			return;
+
+		assert(subresource < subresourceCount);
+		m_states.assign(subresourceCount, m_state);
+	}
+
+	m_states[subresource] = state;
+
+	// Daca starile au ajuns din nou egale se revine la o singura valoare
+	if (std::all_of(m_states.begin(), m_states.end(), [state](uint32_t other) { return other == state; }))
+	{
+		m_state = state;
+		m_states.clear();
+	}
+}
+
+bool ResourceStateTracker::Transition(
+	void* resource,
+	SubresourceStates& committedStates,
+	uint32_t subresourceCount,
+	uint32_t subresource,
+	uint32_t state)
+{
+	TrackedResource& trackedResource = Track(resource, committedStates, subresourceCount);
+
+	if (subresource != SubresourceStates::AllSubresources || IsUniform(trackedResource))
+		return TransitionSubresource(trackedResource, subresource, state);
+
+	bool isChanged = false;
+	for (uint32_t i = 0; i < subresourceCount; i++)
+	{
+		isChanged = TransitionSubresource(trackedResource, i, state) || isChanged;
+	}
+
+	return isChanged;
+}
+
+void ResourceStateTracker::BeginTransition(
+	void* resource,
+	SubresourceStates& committedStates,
+	uint32_t subresourceCount,
+	uint32_t subresource,
+	uint32_t state)
+{
+	TrackedResource& trackedResource = Track(resource, committedStates, subresourceCount);
+
+	if (subresource != SubresourceStates::AllSubresources || IsUniform(trackedResource))
+	{
+		BeginSubresourceTransition(trackedResource, subresource, state);
+		return;
+	}
+
+	for (uint32_t i = 0; i < subresourceCount; i++)
+	{
+		BeginSubresourceTransition(trackedResource, i, state);
+	}
+}
+
+void ResourceStateTracker::EndPendingTransitions()
+{
+	for (TrackedResource& trackedResource : m_resources)
+	{
+		const SubresourceStates& transitioningStates = trackedResource.transitioningStates;
+
+		if (IsUniform(trackedResource))
+		{
+			if (transitioningStates.GetState() != SubresourceStates::UnknownState)
+				EndSubresourceTransition(trackedResource, SubresourceStates::AllSubresources);
+
+			continue;
+		}
+
+		for (uint32_t i = 0; i < trackedResource.subresourceCount; i++)
+		{
+			if (transitioningStates.GetState(i) != SubresourceStates::UnknownState)
+				EndSubresourceTransition(trackedResource, i);
+		}
+	}
+}
+
+void ResourceStateTracker::Resolve(engine::core::FrameVector<StateTransition>& fixups)
+{
+	for (TrackedResource& trackedResource : m_resources)
+	{
+		// Split-urile nu pot trece dintr-o lista in alta
+		assert(trackedResource.transitioningStates.IsUniform()
+			&& trackedResource.transitioningStates.GetState() == SubresourceStates::UnknownState);
+
+		SubresourceStates& committedStates = *trackedResource.committedStates;
+		const SubresourceStates& initialStates = trackedResource.initialStates;
+		const SubresourceStates& currentStates = trackedResource.currentStates;
+		const uint32_t subresourceCount = trackedResource.subresourceCount;
+
+		if (initialStates.IsUniform() && committedStates.IsUniform())
+		{
+			const uint32_t before = committedStates.GetState();
+			const uint32_t after = initialStates.GetState();
+
+			if (after != SubresourceStates::UnknownState && before != SubresourceStates::UnknownState
+				&& before != after)
+				fixups.push_back(
+					{trackedResource.resource, SubresourceStates::AllSubresources, before, after, SplitBarrier::None});
+		}
+		else
+		{
+			for (uint32_t i = 0; i < subresourceCount; i++)
+			{
+				const uint32_t before = committedStates.GetState(i);
+				const uint32_t after = initialStates.GetState(i);
+
+				if (after != SubresourceStates::UnknownState && before != SubresourceStates::UnknownState
+					&& before != after)
+					fixups.push_back({trackedResource.resource, i, before, after, SplitBarrier::None});
+			}
+		}
+
+		// Subresursele nefolosite de lista isi pastreaza starea publicata
+		if (currentStates.IsUniform())
+		{
+			if (currentStates.GetState() != SubresourceStates::UnknownState)
+				committedStates.SetState(
+					SubresourceStates::AllSubresources, currentStates.GetState(), subresourceCount);
+		}
+		else
+		{
+			for (uint32_t i = 0; i < subresourceCount; i++)
+			{
+				if (currentStates.GetState(i) != SubresourceStates::UnknownState)
+					committedStates.SetState(i, currentStates.GetState(i), subresourceCount);
+			}
+		}
+	}
+
+	Reset();
+}
+
+void ResourceStateTracker::Reset()
+{
+	m_resources.clear();
+	m_resourceIndices.clear();
+	m_pendingBarriers.clear();
+}
+
+ResourceStateTracker::TrackedResource& ResourceStateTracker::Track(
+	void* resource, SubresourceStates& committedStates, uint32_t subresourceCount)
+{
+	const auto [it, isInserted] = m_resourceIndices.try_emplace(resource, m_resources.size());
+	if (isInserted)
+		m_resources.push_back({resource, &committedStates, subresourceCount, {}, {}, {}});
+
+	TrackedResource& trackedResource = m_resources[it->second];
+	assert(trackedResource.committedStates == &committedStates);
+
+	return trackedResource;
+}
+
+bool ResourceStateTracker::IsUniform(const TrackedResource& trackedResource)
+{
+	return trackedResource.initialStates.IsUniform() && trackedResource.currentStates.IsUniform()
+		&& trackedResource.transitioningStates.IsUniform();
+}
+
+bool ResourceStateTracker::TransitionSubresource(
+	TrackedResource& trackedResource, uint32_t subresource, uint32_t state)
+{
+	if (trackedResource.transitioningStates.GetState(subresource) != SubresourceStates::UnknownState)
+		EndSubresourceTransition(trackedResource, subresource);
+
+	const uint32_t current = trackedResource.currentStates.GetState(subresource);
+
+	// Prima folosire in lista: tranzitia se decide la submit, fata de starea lasata de listele anterioare
+	if (current == SubresourceStates::UnknownState)
+	{
+		trackedResource.initialStates.SetState(subresource, state, trackedResource.subresourceCount);
+		trackedResource.currentStates.SetState(subresource, state, trackedResource.subresourceCount);
+
+		return true;
+	}
+
+	if (current == state)
+		return false;
+
+	m_pendingBarriers.push_back({trackedResource.resource, subresource, current, state, SplitBarrier::None});
+	trackedResource.currentStates.SetState(subresource, state, trackedResource.subresourceCount);
+
+	return true;
+}
+
+void ResourceStateTracker::BeginSubresourceTransition(
+	TrackedResource& trackedResource, uint32_t subresource, uint32_t state)
+{
+	const uint32_t transitioning = trackedResource.transitioningStates.GetState(subresource);
+	if (transitioning == state)
+		return;
+
+	if (transitioning != SubresourceStates::UnknownState)
+		EndSubresourceTransition(trackedResource, subresource);
+
+	const uint32_t current = trackedResource.currentStates.GetState(subresource);
+
+	// Fara o stare cunoscuta in lista tranzitia nu se poate incepe devreme; o rezolva submit-ul
+	if (current == SubresourceStates::UnknownState)
+	{
+		TransitionSubresource(trackedResource, subresource, state);
+		return;
+	}
+
+	if (current == state)
+		return;
+
+	m_pendingBarriers.push_back({trackedResource.resource, subresource, current, state, SplitBarrier::BeginOnly});
+	trackedResource.transitioningStates.SetState(subresource, state, trackedResource.subresourceCount);
+}
+
+void ResourceStateTracker::EndSubresourceTransition(TrackedResource& trackedResource, uint32_t subresource)
+{
+	const uint32_t current = trackedResource.currentStates.GetState(subresource);
+	const uint32_t transitioning = trackedResource.transitioningStates.GetState(subresource);
+
+	// Partea de sfarsit repeta exact starile partii de inceput
+	m_pendingBarriers.push_back({trackedResource.resource, subresource, current, transitioning, SplitBarrier::EndOnly});
+
+	trackedResource.currentStates.SetState(subresource, transitioning, trackedResource.subresourceCount);
+	trackedResource.transitioningStates.SetState(
+		subresource, SubresourceStates::UnknownState, trackedResource.subresourceCount);
+}
+
+}  // namespace engine::gfx
@@ -13,10 +13,14 @@ namespace engine::gfx
 // t2, space0 - textura/texturi difuze
 // t3, space0 - textura/texturi de normale
 // t0, space1 - texturi displacement
+// t2, space1 - harta de splat a terenului
+// t3, space1 - scalarea teselarii pe patch-uri de teren
+// t0, space3 - datele de instanta (root SRV)
 
 // b0, space0 - pass CB
 // b1, space0 - object CB
 // b2, space0 - material CB
+// b3, space0 - root constant cu offset-ul instantelor
 // b0, space1 - water CB
 
 using namespace engine::gfx::RSBinding;
@@ -52,7 +56,7 @@ bool RootSignatureManager::AddRootSiganture(std::string name, RootSignature::Ptr
 	return true;
 }
 
-RootSignature::Ptr RootSignatureManager::GetRootSignature(std::string name) const
+RootSignature::Ptr RootSignatureManager::GetRootSignature(std::string_view name) const
 {
 	auto it = m_rootSignatures.find(name);
 	if (it == m_rootSignatures.end())
@@ -61,7 +65,7 @@ RootSignature::Ptr RootSignatureManager::GetRootSignature(std::string name) cons
 	return it->second;
 }
 
-ID3D12RootSignature* RootSignatureManager::GetID3D12RootSignature(std::string name) const
+ID3D12RootSignature* RootSignatureManager::GetID3D12RootSignature(std::string_view name) const
 {
 	return GetRootSignature(name)->GetID3D12RootSignature();
 }
@@ -100,7 +104,7 @@ RootSignature::Ptr RootSignatureManager::CreateDefaultRS(ID3D12Device10* pDevice
 	rs->GetRootParameter(DefaultRSBindings::MaterialCB)
 		.InitAsConstantBufferView(2, 0, D3D12_ROOT_DESCRIPTOR_FLAG_NONE, D3D12_SHADER_VISIBILITY_ALL);
 
-	std::array<CD3DX12_DESCRIPTOR_RANGE1, 3> SRVRange;
+	std::array<CD3DX12_DESCRIPTOR_RANGE1, 5> SRVRange;
 	SRVRange[0].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 4, 0, 0, D3D12_DESCRIPTOR_RANGE_FLAG_DATA_STATIC, 0);
 	rs->GetRootParameter(DefaultRSBindings::StaticPixelTextures)
 		.InitAsDescriptorTable(1, &SRVRange[0], D3D12_SHADER_VISIBILITY_PIXEL);
@@ -113,6 +117,25 @@ RootSignature::Ptr RootSignatureManager::CreateDefaultRS(ID3D12Device10* pDevice
 	rs->GetRootParameter(DefaultRSBindings::DynamicTextures)
 		.InitAsDescriptorTable(1, &SRVRange[2], D3D12_SHADER_VISIBILITY_PIXEL);
 
+	SRVRange[3].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 2, 1, D3D12_DESCRIPTOR_RANGE_FLAG_DATA_STATIC, 0);
+	rs->GetRootParameter(DefaultRSBindings::TerrainSplatMap)
+		.InitAsDescriptorTable(1, &SRVRange[3], D3D12_SHADER_VISIBILITY_ALL);
+
+	SRVRange[4].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 3, 1, D3D12_DESCRIPTOR_RANGE_FLAG_DATA_STATIC, 0);
+	rs->GetRootParameter(DefaultRSBindings::TerrainTessellationScale)
+		.InitAsDescriptorTable(1, &SRVRange[4], D3D12_SHADER_VISIBILITY_HULL);
+
+	rs->GetRootParameter(DefaultRSBindings::InstanceData)
+		.InitAsShaderResourceView(0, 3, D3D12_ROOT_DESCRIPTOR_FLAG_NONE, D3D12_SHADER_VISIBILITY_VERTEX);
+	rs->GetRootParameter(DefaultRSBindings::InstanceConstants)
+		.InitAsConstants(1, 3, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+
+	rs->GetRootParameter(DefaultRSBindings::ObjectData)
+		.InitAsShaderResourceView(1, 3, D3D12_ROOT_DESCRIPTOR_FLAG_NONE, D3D12_SHADER_VISIBILITY_ALL);
+	rs->GetRootParameter(DefaultRSBindings::MaterialData)
+		.InitAsShaderResourceView(2, 3, D3D12_ROOT_DESCRIPTOR_FLAG_NONE, D3D12_SHADER_VISIBILITY_ALL);
+	rs->GetRootParameter(DefaultRSBindings::DrawConstants).InitAsConstants(2, 4, 0, D3D12_SHADER_VISIBILITY_ALL);
+
 	rs->SetRootSignatureFlags(
 		D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT
 		| D3D12_ROOT_SIGNATURE_FLAG_DENY_AMPLIFICATION_SHADER_ROOT_ACCESS
@@ -214,7 +237,7 @@ RootSignature::Ptr RootSignatureManager::CreateGlobalRTRS(ID3D12Device10* pDevic
 
 RootSignature::Ptr RootSignatureManager::CreateTriangleHitRS(ID3D12Device10* pDevice)
 {
-	RootSignature::Ptr rs = RootSignature::CreateEmptyRootSignature(4);
+	RootSignature::Ptr rs = RootSignature::CreateEmptyRootSignature(5);
 
 	rs->SetRootSignatureFlags(D3D12_ROOT_SIGNATURE_FLAG_LOCAL_ROOT_SIGNATURE);
 	rs->AddDefaultStaticSamplers();
@@ -222,12 +245,14 @@ RootSignature::Ptr RootSignatureManager::CreateTriangleHitRS(ID3D12Device10* pDe
 	rs->GetRootParameter(0).InitAsConstantBufferView(1);
 	rs->GetRootParameter(1).InitAsConstantBufferView(2);
 
-	std::array<CD3DX12_DESCRIPTOR_RANGE1, 2> ranges;
+	std::array<CD3DX12_DESCRIPTOR_RANGE1, 3> ranges;
 	ranges[0].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 2, 1, 0, D3D12_DESCRIPTOR_RANGE_FLAG_DATA_STATIC, 0);
 	ranges[1].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 3, 0, 1, D3D12_DESCRIPTOR_RANGE_FLAG_DATA_STATIC, 0);
+	ranges[2].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 4, 1, D3D12_DESCRIPTOR_RANGE_FLAG_DATA_STATIC, 0);
 
 	rs->GetRootParameter(2).InitAsDescriptorTable(1, &ranges[0]);
 	rs->GetRootParameter(3).InitAsDescriptorTable(1, &ranges[1]);
+	rs->GetRootParameter(4).InitAsDescriptorTable(1, &ranges[2]);
 
 	rs->Finalize(pDevice);
 
@@ -58,6 +58,7 @@ void ShadersManager::CompileRasterizationShaders()
 
 	std::vector<std::wstring> includeDirectories = {L"-I", L"Shaders"};
 	std::vector<std::wstring> shadowRenderSwitch = {L"SHADOW_RENDER"};
+	std::vector<std::wstring> instancedSwitch = {L"INSTANCED"};
 
 	const auto defineMaxTesselation = [](const float tesselationFactor) -> std::vector<std::wstring>
 	{
@@ -66,17 +67,33 @@ void ShadersManager::CompileRasterizationShaders()
 		return defines;
 	};
 
+	// Shaderele root signature-ului Default citesc datele de obiect si material din bufferele bindless
+	const auto defaultRS = [](std::vector<std::wstring> defines) -> std::vector<std::wstring>
+	{
+		if (engine::core::Settings::GetGraphicsSettings().UseBindlessData())
+			defines.push_back(L"BINDLESS");
+		return defines;
+	};
+
 
 	//////////////////////////////////////////////////////////////////////////////////////////////
 	// Compilare shadere
 
 	// Shadere default
-	shaderMap["DefaultVS"] = CompileShader(ShaderPath(L"Default.hlsl").c_str(), L"VSMain", L"vs_6_6", includeDirectories);
-	shaderMap["DefaultPS"] = CompileShader(ShaderPath(L"Default.hlsl").c_str(), L"PSMain", L"ps_6_6", includeDirectories);
+	shaderMap["DefaultVS"] =
+		CompileShader(ShaderPath(L"Default.hlsl").c_str(), L"VSMain", L"vs_6_6", includeDirectories, defaultRS({}));
+	shaderMap["DefaultPS"] =
+		CompileShader(ShaderPath(L"Default.hlsl").c_str(), L"PSMain", L"ps_6_6", includeDirectories, defaultRS({}));
+	shaderMap["DefaultInstancedVS"] = CompileShader(
+		ShaderPath(L"Default.hlsl").c_str(), L"VSMain", L"vs_6_6", includeDirectories, defaultRS(instancedSwitch));
 
 	// Shadere randare shadow map
-	shaderMap["ShadowRenderVS"] = CompileShader(ShaderPath(L"Shadow.hlsl").c_str(), L"VSMain", L"vs_6_6", includeDirectories);
-	shaderMap["ShadowRenderPS"] = CompileShader(ShaderPath(L"Shadow.hlsl").c_str(), L"PSMain", L"ps_6_6", includeDirectories);
+	shaderMap["ShadowRenderVS"] =
+		CompileShader(ShaderPath(L"Shadow.hlsl").c_str(), L"VSMain", L"vs_6_6", includeDirectories, defaultRS({}));
+	shaderMap["ShadowRenderPS"] =
+		CompileShader(ShaderPath(L"Shadow.hlsl").c_str(), L"PSMain", L"ps_6_6", includeDirectories, defaultRS({}));
+	shaderMap["ShadowRenderInstancedVS"] = CompileShader(
+		ShaderPath(L"Shadow.hlsl").c_str(), L"VSMain", L"vs_6_6", includeDirectories, defaultRS(instancedSwitch));
 
 	// Shadere shadow debug
 	shaderMap["TextureRenderVS"] =
@@ -85,19 +102,27 @@ void ShadersManager::CompileRasterizationShaders()
 		CompileShader(ShaderPath(L"TextureRender.hlsl").c_str(), L"PSMain", L"ps_6_6", includeDirectories);
 
 	// Shadere skybox
-	shaderMap["SkyBoxVS"] = CompileShader(ShaderPath(L"SkyBox.hlsl").c_str(), L"VSMain", L"vs_6_6", includeDirectories);
-	shaderMap["SkyBoxPS"] = CompileShader(ShaderPath(L"SkyBox.hlsl").c_str(), L"PSMain", L"ps_6_6", includeDirectories);
+	shaderMap["SkyBoxVS"] =
+		CompileShader(ShaderPath(L"SkyBox.hlsl").c_str(), L"VSMain", L"vs_6_6", includeDirectories, defaultRS({}));
+	shaderMap["SkyBoxPS"] =
+		CompileShader(ShaderPath(L"SkyBox.hlsl").c_str(), L"PSMain", L"ps_6_6", includeDirectories, defaultRS({}));
 
 	// Shadere teren
-	shaderMap["TerrainVS"] = CompileShader(ShaderPath(L"Terrain.hlsl").c_str(), L"VSMain", L"vs_6_6", includeDirectories);
-	shaderMap["TerrainHS"] =
-		CompileShader(ShaderPath(L"Terrain.hlsl").c_str(), L"HSMain", L"hs_6_6", includeDirectories, defineMaxTesselation(20.f));
-	shaderMap["TerrainDS"] = CompileShader(ShaderPath(L"Terrain.hlsl").c_str(), L"DSMain", L"ds_6_6", includeDirectories);
-	shaderMap["TerrainPS"] =
-		CompileShader(ShaderPath(L"Terrain.hlsl").c_str(), L"PSMain", L"ps_6_6", includeDirectories, lightingDefines);
-
-	shaderMap["TerrainCubeMapVS"] =
-		CompileShader(ShaderPath(L"Terrain.hlsl").c_str(), L"VSForCubeMapRendering", L"vs_6_6", includeDirectories);
+	shaderMap["TerrainVS"] =
+		CompileShader(ShaderPath(L"Terrain.hlsl").c_str(), L"VSMain", L"vs_6_6", includeDirectories, defaultRS({}));
+	shaderMap["TerrainHS"] = CompileShader(
+		ShaderPath(L"Terrain.hlsl").c_str(),
+		L"HSMain",
+		L"hs_6_6",
+		includeDirectories,
+		defaultRS(defineMaxTesselation(20.f)));
+	shaderMap["TerrainDS"] =
+		CompileShader(ShaderPath(L"Terrain.hlsl").c_str(), L"DSMain", L"ds_6_6", includeDirectories, defaultRS({}));
+	shaderMap["TerrainPS"] = CompileShader(
+		ShaderPath(L"Terrain.hlsl").c_str(), L"PSMain", L"ps_6_6", includeDirectories, defaultRS(lightingDefines));
+
+	shaderMap["TerrainCubeMapVS"] = CompileShader(
+		ShaderPath(L"Terrain.hlsl").c_str(), L"VSForCubeMapRendering", L"vs_6_6", includeDirectories, defaultRS({}));
 
 	// Shadere apa
 	shaderMap["WaterVS"] = CompileShader(ShaderPath(L"Water.hlsl").c_str(), L"VSMain", L"vs_6_6", includeDirectories);
@@ -34,6 +34,8 @@ void ShadowMap::Create()
 	m_depthTexture->Create(m_width, m_height, DXGI_FORMAT_D24_UNORM_S8_UINT, L"ShadowMap");
 	m_depthTexture->AllocateDsvHandle();
 	m_depthTexture->AllocateSrvHandle();
+	// Citit in fiecare cadru si mare: readucerea lui dupa o evacuare ar bloca mult
+	m_depthTexture->TrackResidency(ResidencyPriority::High);
 }
 
 void ShadowMap::SetDirection(engine::math::Vector3 direction)
@@ -46,16 +48,10 @@ void ShadowMap::SetDirection(engine::math::Vector3 direction)
 void ShadowMap::Setup(GraphicsContext& graphicsContext)
 {
 	graphicsContext.SetViewportAndScissor(m_viewport, m_scissorRect);
-	graphicsContext.TransitionResource(*m_depthTexture, D3D12_RESOURCE_STATE_DEPTH_WRITE);
 	graphicsContext.SetDepthStencil(m_depthTexture->GetDsvHandle());
 	graphicsContext.ClearDepth(*m_depthTexture);
 }
 
-void ShadowMap::Finish(GraphicsContext& graphicsContext)
-{
-	graphicsContext.TransitionResource(*m_depthTexture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-}
-
 void ShadowMap::Update()
 {
 	m_camera.SetViewCoordinateSystem(-m_lightDirection * m_distanceFromCamera, engine::math::Vector3(engine::math::kZero));
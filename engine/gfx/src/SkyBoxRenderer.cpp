@@ -44,24 +44,22 @@ void SkyBoxRenderer::LoadGeometry(DescriptorVariant descriptor)
 void SkyBoxRenderer::Render(engine::gfx::rasterization::RenderLayer::Value renderLayer) const
 {
 	GraphicsContext& graphicsContext = GraphicsResources::GetInstance().GetGraphicsContext();
-	FrameResources& frameResources = GraphicsResources::GetInstance().GetFrameResources();
 
 	graphicsContext.SetVertexBuffer(0, m_vertexBuffer->GetVertexBufferView());
 	graphicsContext.SetIndexBuffer(m_indexBuffer->GetIndexBufferView());
 
-	graphicsContext.SetConstantBuffer(
-		DefaultRSBindings::ObjectCB, frameResources.m_perObjectCB.GetGpuVirtualAdress(GetObjectCB_ID()));
+	BindObjectData(graphicsContext);
 
 	switch (renderLayer)
 	{
 	case engine::gfx::rasterization::RenderLayer::Base:
 		graphicsContext.SetPipelineState(*m_basePSO);
-		graphicsContext.DrawIndexed((UINT)m_mesh->GetIndexCount());
+		graphicsContext.DrawIndexed(m_indexBuffer->GetIndexCount());
 
 		break;
 	case RenderLayer::CubeMap:
 		graphicsContext.SetPipelineState(*m_dynamicCubeMapPSO);
-		graphicsContext.DrawIndexed((UINT)m_mesh->GetIndexCount());
+		graphicsContext.DrawIndexed(m_indexBuffer->GetIndexCount());
 
 		break;
 	case engine::gfx::rasterization::RenderLayer::ShadowMap:
@@ -70,6 +68,21 @@ void SkyBoxRenderer::Render(engine::gfx::rasterization::RenderLayer::Value rende
 	}
 }
 
+void SkyBoxRenderer::SubmitDraws(
+	RenderQueue<DrawPacket>& queue, RenderLayer::Value renderLayer, const BaseCamera& camera) const
+{
+	if (renderLayer != RenderLayer::Base && renderLayer != RenderLayer::CubeMap)
+		return;
+
+	DrawPacket packet = MakeDrawPacket(renderLayer);
+	BindObjectData(packet);
+	packet.draw = {m_indexBuffer->GetIndexCount(), 1, 0, 0, 0};
+
+	queue.Submit(
+		SortKey::Make(RenderQueueLayer::Background, packet.pso->GetSortID(), GetMaterialCB_ID(), m_meshSortID, 0),
+		packet);
+}
+
 void SkyBoxRenderer::Update(float deltaTime)
 {
 	using namespace engine::math;
@@ -92,7 +105,7 @@ void SkyBoxRenderer::BuildAccelerationStructures()
 	return;
 }
 
-void SkyBoxRenderer::FrustumCulling(const CameraController& cameraController)
+void SkyBoxRenderer::FrustumCulling(const MultiViewCuller& culler)
 {
 	return;
 }
@@ -0,0 +1,546 @@
+#include "TerrainPVS.hpp"
+
+#include "engine/core/CustomException.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <execution>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+
+namespace engine::gfx
+{
+
+using engine::math::BoxBounds;
+using engine::math::Float3;
+
+namespace
+{
+
+constexpr uint32_t PVSMagic = 0x31535650;  // "PVS1"
+constexpr uint32_t PVSVersion = 1;
+
+// Esantionarea heightfield-ului de-a lungul razelor
+class HeightGrid
+{
+public:
+	explicit HeightGrid(const Heightfield& heightfield)
+		: m_heightfield(heightfield), m_sidePointCount(heightfield.sidePointCount)
+	{
+	}
+
+	// -FLT_MAX in afara grilei: acolo nu exista teren care sa blocheze raza
+	float Sample(float x, float z) const
+	{
+		const float fx = (x - m_heightfield.minX) / m_heightfield.stepX;
+		const float fz = (z - m_heightfield.minZ) / m_heightfield.stepZ;
+		const float last = (float)(m_sidePointCount - 1);
+
+		if (fx < 0.f || fz < 0.f || fx > last || fz > last)
+			return -FLT_MAX;
+
+		return Interpolate(fx, fz);
+	}
+
+	// Pentru punctele de vedere de pe marginea grilei
+	float SampleClamped(float x, float z) const
+	{
+		const float last = (float)(m_sidePointCount - 1);
+
+		return Interpolate(
+			std::clamp((x - m_heightfield.minX) / m_heightfield.stepX, 0.f, last),
+			std::clamp((z - m_heightfield.minZ) / m_heightfield.stepZ, 0.f, last));
+	}
+
+	float GetMinHeight() const
+	{
+		return *std::min_element(
+			m_heightfield.heights.begin(), m_heightfield.heights.begin() + m_sidePointCount * m_sidePointCount);
+	}
+
+	inline float GetMinX() const { return m_heightfield.minX; }
+	inline float GetMinZ() const { return m_heightfield.minZ; }
+	inline float GetSizeX() const { return m_heightfield.stepX * (m_sidePointCount - 1); }
+	inline float GetSizeZ() const { return m_heightfield.stepZ * (m_sidePointCount - 1); }
+	inline float GetStep() const
+	{
+		return 0.5f * std::min(std::abs(m_heightfield.stepX), std::abs(m_heightfield.stepZ));
+	}
+
+private:
+	float Interpolate(float fx, float fz) const
+	{
+		const int i = std::min((int)fx, m_sidePointCount - 2);
+		const int j = std::min((int)fz, m_sidePointCount - 2);
+		const float s = fx - i;
+		const float t = fz - j;
+
+		const float h00 = m_heightfield.GetHeight(i, j);
+		const float h10 = m_heightfield.GetHeight(i + 1, j);
+		const float h01 = m_heightfield.GetHeight(i, j + 1);
+		const float h11 = m_heightfield.GetHeight(i + 1, j + 1);
+
+		return (h00 * (1.f - s) + h10 * s) * (1.f - t) + (h01 * (1.f - s) + h11 * s) * t;
+	}
+
+	const Heightfield& m_heightfield;
+	int m_sidePointCount;
+};
+
+bool IsRayClear(const HeightGrid& grid, const Float3& from, const Float3& to, float margin)
+{
+	const float dirX = to[0] - from[0];
+	const float dirY = to[1] - from[1];
+	const float dirZ = to[2] - from[2];
+
+	const float length = std::sqrt(dirX * dirX + dirY * dirY + dirZ * dirZ);
+	const int stepCount = std::max(1, (int)std::ceil(length / grid.GetStep()));
+
+	// Ultimul pas (tinta insasi) nu se testeaza: punctul tinta poate sta chiar pe suprafata
+	for (int step = 1; step < stepCount; step++)
+	{
+		const float t = (float)step / stepCount;
+		const float x = from[0] + dirX * t;
+		const float z = from[2] + dirZ * t;
+
+		if (from[1] + dirY * t < grid.Sample(x, z) - margin)
+			return false;
+	}
+
+	return true;
+}
+
+inline void HashBytes(uint64_t& hash, const void* data, size_t size)
+{
+	// FNV-1a
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 0x100000001B3ull;
+	}
+}
+
+template <class T>
+inline void HashValue(uint64_t& hash, const T& value)
+{
+	HashBytes(hash, &value, sizeof(T));
+}
+
+inline void WriteVarint(std::vector<uint8_t>& data, uint32_t value)
+{
+	while (value >= 0x80)
+	{
+		data.push_back((uint8_t)(value | 0x80));
+		value >>= 7;
+	}
+	data.push_back((uint8_t)value);
+}
+
+inline bool ReadVarint(const std::vector<uint8_t>& data, size_t& offset, uint32_t& value)
+{
+	value = 0;
+	for (int shift = 0; shift < 35; shift += 7)
+	{
+		if (offset >= data.size())
+			return false;
+
+		const uint8_t byte = data[offset++];
+		value |= (uint32_t)(byte & 0x7F) << shift;
+
+		if ((byte & 0x80) == 0)
+			return true;
+	}
+
+	return false;
+}
+
+template <class T>
+inline void WritePod(std::ofstream& file, const T& value)
+{
+	file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+inline bool ReadPod(std::ifstream& file, T& value)
+{
+	return (bool)file.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+}  // namespace
+
+void TerrainPVS::Allocate(int cellsPerSide, int heightLevels, uint32_t targetCount)
+{
+	m_cellsPerSide = cellsPerSide;
+	m_heightLevels = heightLevels;
+	m_targetCount = targetCount;
+	m_wordsPerCell = (targetCount + 63) / 64;
+
+	m_bits.assign((size_t)GetCellCount() * m_wordsPerCell, 0);
+}
+
+uint64_t TerrainPVS::ComputeSourceHash(
+	const Heightfield& heightfield, const std::vector<BoxBounds>& targets, const Properties& properties)
+{
+	uint64_t hash = 0xCBF29CE484222325ull;
+
+	HashValue(hash, heightfield.sidePointCount);
+	HashValue(hash, heightfield.minX);
+	HashValue(hash, heightfield.minZ);
+	HashValue(hash, heightfield.stepX);
+	HashValue(hash, heightfield.stepZ);
+	HashBytes(hash, heightfield.heights.data(), heightfield.heights.size() * sizeof(float));
+
+	for (const BoxBounds& target : targets)
+	{
+		HashValue(hash, target.min);
+		HashValue(hash, target.max);
+	}
+
+	HashValue(hash, properties.cellsPerSide);
+	HashValue(hash, properties.viewpointsPerSide);
+	HashValue(hash, properties.heightLevels);
+	HashValue(hash, properties.minCameraHeightAboveTerrain);
+	HashValue(hash, properties.maxCameraHeight);
+	HashValue(hash, properties.heightMargin);
+	HashValue(hash, properties.dilateNeighbours);
+
+	return hash;
+}
+
+TerrainPVS::Ptr TerrainPVS::Bake(
+	const Heightfield& heightfield, const std::vector<BoxBounds>& targets, const Properties& properties)
+{
+	const int sidePointCount = heightfield.sidePointCount;
+	if (sidePointCount < 2 || heightfield.heights.size() < (size_t)sidePointCount * sidePointCount
+		|| heightfield.stepX == 0.f || heightfield.stepZ == 0.f || properties.cellsPerSide < 1
+		|| properties.viewpointsPerSide < 1 || properties.heightLevels < 1)
+		throw engine::core::CustomException("Parametri invalizi pentru PVS");
+
+	const HeightGrid grid(heightfield);
+
+	TerrainPVS::Ptr pvs = Ptr(new TerrainPVS());
+	pvs->Allocate(properties.cellsPerSide, properties.heightLevels, (uint32_t)targets.size());
+	pvs->m_minX = grid.GetMinX();
+	pvs->m_minZ = grid.GetMinZ();
+	pvs->m_cellSizeX = grid.GetSizeX() / properties.cellsPerSide;
+	pvs->m_cellSizeZ = grid.GetSizeZ() / properties.cellsPerSide;
+	pvs->m_minCameraHeight = grid.GetMinHeight() + properties.minCameraHeightAboveTerrain;
+	pvs->m_maxCameraHeight = std::max(properties.maxCameraHeight, pvs->m_minCameraHeight);
+	pvs->m_levelHeight = (pvs->m_maxCameraHeight - pvs->m_minCameraHeight) / properties.heightLevels;
+	pvs->m_sourceHash = ComputeSourceHash(heightfield, targets, properties);
+
+	// Punctele tinta: colturile si centrul fetei de sus a fiecarui AABB
+	std::vector<std::array<Float3, 5>> targetPoints(targets.size());
+	for (size_t t = 0; t < targets.size(); t++)
+	{
+		const float minX = targets[t].min[0], maxX = targets[t].max[0];
+		const float minZ = targets[t].min[2], maxZ = targets[t].max[2];
+		const float top = targets[t].max[1];
+
+		targetPoints[t] = {
+			Float3{(minX + maxX) / 2.f, top, (minZ + maxZ) / 2.f},
+			Float3{minX, top, minZ},
+			Float3{maxX, top, minZ},
+			Float3{minX, top, maxZ},
+			Float3{maxX, top, maxZ}};
+	}
+
+	std::vector<int> cells(pvs->GetCellCount());
+	std::iota(cells.begin(), cells.end(), 0);
+
+	// Fiecare celula scrie doar in propriul bitset, deci celulele se pot procesa in paralel
+	std::for_each(
+		std::execution::par,
+		cells.begin(),
+		cells.end(),
+		[&](int cell)
+		{
+			const int columnIndex = cell / properties.heightLevels;
+			const int level = cell % properties.heightLevels;
+			const int row = columnIndex / properties.cellsPerSide;
+			const int column = columnIndex % properties.cellsPerSide;
+
+			const float levelBottom = pvs->m_minCameraHeight + level * pvs->m_levelHeight;
+			const float levelHeights[3] = {
+				levelBottom, levelBottom + pvs->m_levelHeight / 2.f, levelBottom + pvs->m_levelHeight};
+
+			std::vector<Float3> viewpoints;
+
+			for (int a = 0; a < properties.viewpointsPerSide; a++)
+			{
+				const float u = properties.viewpointsPerSide > 1 ? (float)a / (properties.viewpointsPerSide - 1) : 0.5f;
+				const float x = pvs->m_minX + (row + u) * pvs->m_cellSizeX;
+
+				for (int b = 0; b < properties.viewpointsPerSide; b++)
+				{
+					const float v = properties.viewpointsPerSide > 1 ? (float)b / (properties.viewpointsPerSide - 1) : 0.5f;
+					const float z = pvs->m_minZ + (column + v) * pvs->m_cellSizeZ;
+
+					// Sub teren camera nu poate ajunge; stratul se esantioneaza de la sol in sus
+					const float ground = grid.SampleClamped(x, z) + properties.minCameraHeightAboveTerrain;
+
+					for (const float height : levelHeights)
+					{
+						viewpoints.push_back({x, std::max(height, ground), z});
+					}
+				}
+			}
+
+			uint64_t* bits = &pvs->m_bits[(size_t)cell * pvs->m_wordsPerCell];
+
+			for (uint32_t t = 0; t < (uint32_t)targets.size(); t++)
+			{
+				bool isVisible = false;
+
+				for (const auto& viewpoint : viewpoints)
+				{
+					for (const auto& point : targetPoints[t])
+					{
+						if (IsRayClear(grid, viewpoint, point, properties.heightMargin))
+						{
+							isVisible = true;
+							break;
+						}
+					}
+
+					if (isVisible)
+						break;
+				}
+
+				if (isVisible)
+					bits[t / 64] |= 1ull << (t % 64);
+			}
+		});
+
+	// Camera se poate afla oriunde in celula, nu doar in punctele esantionate: se adauga si ce vad vecinii
+	if (properties.dilateNeighbours)
+	{
+		const std::vector<uint64_t> original = pvs->m_bits;
+		const int side = properties.cellsPerSide;
+		const int levels = properties.heightLevels;
+
+		for (int cell = 0; cell < pvs->GetCellCount(); cell++)
+		{
+			const int level = cell % levels;
+			const int row = cell / levels / side;
+			const int column = cell / levels % side;
+
+			uint64_t* bits = &pvs->m_bits[(size_t)cell * pvs->m_wordsPerCell];
+
+			// Vecinii din acelasi strat de inaltime
+			for (int i = std::max(row - 1, 0); i <= std::min(row + 1, side - 1); i++)
+			{
+				for (int j = std::max(column - 1, 0); j <= std::min(column + 1, side - 1); j++)
+				{
+					const uint64_t* neighbour = &original[((size_t)(i * side + j) * levels + level) * pvs->m_wordsPerCell];
+
+					for (uint32_t w = 0; w < pvs->m_wordsPerCell; w++)
+					{
+						bits[w] |= neighbour[w];
+					}
+				}
+			}
+		}
+	}
+
+	return pvs;
+}
+
+TerrainPVS::Ptr TerrainPVS::LoadOrBake(
+	const std::wstring& path,
+	const Heightfield& heightfield,
+	const std::vector<BoxBounds>& targets,
+	const Properties& properties)
+{
+	const uint64_t sourceHash = ComputeSourceHash(heightfield, targets, properties);
+
+	TerrainPVS::Ptr pvs = Load(path, sourceHash);
+	if (pvs)
+		return pvs;
+
+	pvs = Bake(heightfield, targets, properties);
+	pvs->Save(path);
+
+	return pvs;
+}
+
+int TerrainPVS::GetCell(float x, float y, float z) const
+{
+	if (y > m_maxCameraHeight)
+		return -1;
+
+	const int row = (int)std::floor((x - m_minX) / m_cellSizeX);
+	const int column = (int)std::floor((z - m_minZ) / m_cellSizeZ);
+
+	if (row < 0 || column < 0 || row >= m_cellsPerSide || column >= m_cellsPerSide)
+		return -1;
+
+	// Sub primul strat camera e tratata ca fiind in primul strat
+	const int level = std::clamp((int)std::floor((y - m_minCameraHeight) / m_levelHeight), 0, m_heightLevels - 1);
+
+	return (row * m_cellsPerSide + column) * m_heightLevels + level;
+}
+
+std::vector<uint8_t> TerrainPVS::CompressCell(const uint64_t* bits, uint32_t targetCount)
+{
+	// Lungimile secventelor alternante de biti, incepand cu o secventa (posibil goala) de 0
+	std::vector<uint8_t> data;
+
+	bool current = false;
+	uint32_t runLength = 0;
+
+	for (uint32_t t = 0; t < targetCount; t++)
+	{
+		const bool bit = (bits[t / 64] >> (t % 64)) & 1;
+
+		if (bit != current)
+		{
+			WriteVarint(data, runLength);
+			current = bit;
+			runLength = 0;
+		}
+
+		runLength++;
+	}
+
+	WriteVarint(data, runLength);
+
+	return data;
+}
+
+bool TerrainPVS::DecompressCell(const std::vector<uint8_t>& data, uint64_t* bits, uint32_t targetCount)
+{
+	size_t offset = 0;
+	uint32_t target = 0;
+	bool current = false;
+
+	while (offset < data.size())
+	{
+		uint32_t runLength;
+		if (!ReadVarint(data, offset, runLength) || target + runLength > targetCount)
+			return false;
+
+		if (current)
+		{
+			for (uint32_t t = target; t < target + runLength; t++)
+			{
+				bits[t / 64] |= 1ull << (t % 64);
+			}
+		}
+
+		target += runLength;
+		current = !current;
+	}
+
+	return target == targetCount;
+}
+
+size_t TerrainPVS::GetCompressedSize() const
+{
+	size_t size = 0;
+
+	for (int cell = 0; cell < GetCellCount(); cell++)
+	{
+		size += sizeof(uint32_t) + CompressCell(&m_bits[(size_t)cell * m_wordsPerCell], m_targetCount).size();
+	}
+
+	return size;
+}
+
+float TerrainPVS::GetVisibleRatio() const
+{
+	if (m_targetCount == 0 || m_cellsPerSide == 0)
+		return 1.f;
+
+	size_t visibleCount = 0;
+	for (const uint64_t word : m_bits)
+	{
+		visibleCount += std::popcount(word);
+	}
+
+	return (float)visibleCount / ((size_t)GetCellCount() * m_targetCount);
+}
+
+bool TerrainPVS::Save(const std::wstring& path) const
+{
+	std::ofstream file(std::filesystem::path(path), std::ios::binary | std::ios::trunc);
+	if (!file)
+		return false;
+
+	WritePod(file, PVSMagic);
+	WritePod(file, PVSVersion);
+	WritePod(file, m_sourceHash);
+	WritePod(file, m_cellsPerSide);
+	WritePod(file, m_heightLevels);
+	WritePod(file, m_targetCount);
+	WritePod(file, m_minX);
+	WritePod(file, m_minZ);
+	WritePod(file, m_cellSizeX);
+	WritePod(file, m_cellSizeZ);
+	WritePod(file, m_minCameraHeight);
+	WritePod(file, m_levelHeight);
+	WritePod(file, m_maxCameraHeight);
+
+	for (int cell = 0; cell < GetCellCount(); cell++)
+	{
+		const std::vector<uint8_t> data = CompressCell(&m_bits[(size_t)cell * m_wordsPerCell], m_targetCount);
+
+		WritePod(file, (uint32_t)data.size());
+		file.write(reinterpret_cast<const char*>(data.data()), data.size());
+	}
+
+	return (bool)file;
+}
+
+TerrainPVS::Ptr TerrainPVS::Load(const std::wstring& path, uint64_t expectedSourceHash)
+{
+	std::ifstream file(std::filesystem::path(path), std::ios::binary);
+	if (!file)
+		return nullptr;
+
+	uint32_t magic, version;
+	uint64_t sourceHash;
+	if (!ReadPod(file, magic) || !ReadPod(file, version) || !ReadPod(file, sourceHash) || magic != PVSMagic
+		|| version != PVSVersion || sourceHash != expectedSourceHash)
+		return nullptr;
+
+	int cellsPerSide, heightLevels;
+	uint32_t targetCount;
+	TerrainPVS::Ptr pvs = Ptr(new TerrainPVS());
+
+	if (!ReadPod(file, cellsPerSide) || !ReadPod(file, heightLevels) || !ReadPod(file, targetCount)
+		|| cellsPerSide <= 0 || heightLevels <= 0)
+		return nullptr;
+
+	pvs->Allocate(cellsPerSide, heightLevels, targetCount);
+	pvs->m_sourceHash = sourceHash;
+
+	if (!ReadPod(file, pvs->m_minX) || !ReadPod(file, pvs->m_minZ) || !ReadPod(file, pvs->m_cellSizeX)
+		|| !ReadPod(file, pvs->m_cellSizeZ) || !ReadPod(file, pvs->m_minCameraHeight)
+		|| !ReadPod(file, pvs->m_levelHeight) || !ReadPod(file, pvs->m_maxCameraHeight))
+		return nullptr;
+
+	for (int cell = 0; cell < pvs->GetCellCount(); cell++)
+	{
+		uint32_t size;
+		if (!ReadPod(file, size))
+			return nullptr;
+
+		std::vector<uint8_t> data(size);
+		if (!file.read(reinterpret_cast<char*>(data.data()), size))
+			return nullptr;
+
+		if (!DecompressCell(data, &pvs->m_bits[(size_t)cell * pvs->m_wordsPerCell], targetCount))
+			return nullptr;
+	}
+
+	return pvs;
+}
+
+}  // namespace engine::gfx
@@ -4,6 +4,8 @@
 #include "GeometryGenerator.hpp"
 #include "engine/math/SimplexNoise.hpp"
 
+#include <numeric>
+
 namespace engine::gfx
 {
 
@@ -80,8 +82,59 @@ void TerrainRenderer::LoadGeometry(DescriptorVariant descriptor)
 		m_chunks.emplace_back(submeshs[i], aabbs[i]);
 	}
 
+	// Din mesh raman doar inaltimile (PVS si occluder); vertecsii se elibereaza dupa upload
+	const int sidePointCount =
+		GeometryGenerator::GetChunksSidePointCount(terrainDesc.chunkKernelSize, terrainDesc.chunkCountPerSide);
+	m_heightfield = Heightfield::FromGridVertices(m_mesh->GetVertexVector(), sidePointCount);
+
+	m_isPVSEnabled = terrainDesc.pvsProperties.enabled;
+	m_pvsProperties.cellsPerSide = terrainDesc.pvsProperties.cellsPerSide;
+	m_pvsProperties.viewpointsPerSide = terrainDesc.pvsProperties.viewpointsPerSide;
+	m_pvsProperties.heightLevels = terrainDesc.pvsProperties.heightLevels;
+	m_pvsProperties.minCameraHeightAboveTerrain = terrainDesc.pvsProperties.minCameraHeightAboveTerrain;
+	m_pvsProperties.maxCameraHeight = terrainDesc.pvsProperties.maxCameraHeight;
+	m_pvsProperties.heightMargin = terrainDesc.pvsProperties.heightMargin;
+	m_pvsProperties.dilateNeighbours = terrainDesc.pvsProperties.dilateNeighbours;
+
+	// Pana la primul culling se deseneaza in ordinea de generare
+	m_chunkDrawOrder.resize(m_chunks.size());
+	std::iota(m_chunkDrawOrder.begin(), m_chunkDrawOrder.end(), 0);
+	BuildDrawRanges(m_chunks, m_chunkDrawOrder, m_drawRanges);
+
 	CreateVertexAndIndexBuffer(engine::core::Settings::UseRayTracing());
 
+	// Regulile de amestec ale straturilor se evalueaza o singura data, aici, nu per pixel / per raza
+	m_splatMap = TerrainSplatMap::Bake(
+		heightFunction, terrainDesc.width, terrainDesc.length, terrainDesc.splatMapResolution);
+	if (m_splatMap->Validate(heightFunction) > TerrainSplatMap::ValidationTolerance)
+		throw engine::core::CustomException("Harta de splat nu reproduce amestecul straturilor din shader");
+
+	// Teselarea se face doar pe calea de rasterizare
+	if (!engine::core::Settings::UseRayTracing())
+	{
+		TerrainTessellationMap::Properties tessellationProperties;
+		tessellationProperties.fullTessellationDeviation =
+			terrainDesc.tessellationProperties.fullTessellationDeviation;
+		tessellationProperties.minScale = terrainDesc.tessellationProperties.minScale;
+		tessellationProperties.sampleCount = terrainDesc.tessellationProperties.sampleCount;
+
+		m_tessellationMap = TerrainTessellationMap::Compute(
+			heightFunction,
+			terrainDesc.width,
+			terrainDesc.length,
+			sidePointCount,
+			tessellationProperties);
+
+		if (engine::core::Settings::GetGraphicsSettings().UseIndirectDraws())
+		{
+			CreateIndirectChunkDraws((UINT)m_chunks.size());
+			BuildIndirectChunkDraws(m_drawRanges);
+		}
+
+		// Suprafata grosiera, sub teren, care ascunde vaile din spatele muntilor
+		m_occluder = OcclusionCuller::BuildHeightfieldOccluder(m_heightfield, terrainDesc.occluderCellsPerSide);
+	}
+
 	/*D3D12_UNORDERED_ACCESS_VIEW_DESC desc;
 	pGraphicsResources->GetDevice()->CreateUnorderedAccessView(
 		m_vertexBuffer->GetVertexBufferResource(),
@@ -98,22 +151,23 @@ void TerrainRenderer::Render(engine::gfx::rasterization::RenderLayer::Value rend
 	graphicsContext.SetVertexBuffer(0, m_vertexBuffer->GetVertexBufferView());
 	graphicsContext.SetIndexBuffer(m_indexBuffer->GetIndexBufferView());
 
-	graphicsContext.SetConstantBuffer(
-		DefaultRSBindings::ObjectCB, frameResources.m_perObjectCB.GetGpuVirtualAdress(GetObjectCB_ID()));
-	graphicsContext.SetConstantBuffer(
-		DefaultRSBindings::MaterialCB, frameResources.m_perMaterialCB.GetGpuVirtualAdress(GetMaterialCB_ID()));
+	BindObjectData(graphicsContext);
 
-	const auto renderChunks = [this, &graphicsContext](const bool performVisbilityTest = true)
+	if (!FrameResources::UseBindlessData())
+		graphicsContext.SetConstantBuffer(
+			DefaultRSBindings::MaterialCB, frameResources.m_perMaterialCB.GetGpuVirtualAdress(GetMaterialCB_ID()));
+
+	const auto renderChunks = [this, &graphicsContext](const CullingView::Value view)
 	{
-		for (const auto& chunk : m_chunks)
+		if (UseIndirectChunkDraws())
 		{
-			if (performVisbilityTest && !chunk.IsVisible())
-				continue;
-
-			const SubMesh& subMesh = chunk.GetSubMesh();
+			DrawChunksIndirect(graphicsContext, view);
+			return;
+		}
 
-			graphicsContext.DrawIndexed(
-				(UINT)subMesh.indexCount, (UINT)subMesh.startIndexLocation, (UINT)subMesh.baseVertexLocation);
+		for (const DrawRange& range : m_drawRanges[view].GetRanges())
+		{
+			graphicsContext.DrawIndexed(range.indexCount, range.startIndexLocation, range.baseVertexLocation);
 		}
 	};
 
@@ -122,19 +176,19 @@ void TerrainRenderer::Render(engine::gfx::rasterization::RenderLayer::Value rend
 	case RenderLayer::Base:
 		graphicsContext.SetPipelineState(*m_basePSO);
 
-		renderChunks(false);
+		renderChunks(CullingView::Main);
 
 		break;
 	case RenderLayer::CubeMap:
 		graphicsContext.SetPipelineState(*m_dynamicCubeMapPSO);
 
-		renderChunks(false);
+		renderChunks(CullingView::FromRenderLayer(renderLayer, m_cubeMapFace));
 
 		break;
 	case RenderLayer::ShadowMap:
 		graphicsContext.SetPipelineState(*m_shadowPSO);
 
-		renderChunks(false);
+		renderChunks(CullingView::Shadow);
 
 		break;
 	case RenderLayer::DebugShadowMap:
@@ -142,6 +196,24 @@ void TerrainRenderer::Render(engine::gfx::rasterization::RenderLayer::Value rend
 	}
 }
 
+void TerrainRenderer::SubmitDraws(
+	RenderQueue<DrawPacket>& queue, RenderLayer::Value renderLayer, const BaseCamera& camera) const
+{
+	FrameResources& frameResources = GraphicsResources::GetInstance().GetFrameResources();
+
+	DrawPacket packet = MakeDrawPacket(renderLayer);
+	BindObjectData(packet);
+
+	if (!FrameResources::UseBindlessData())
+		packet.materialCB = frameResources.m_perMaterialCB.GetGpuVirtualAdress(GetMaterialCB_ID());
+
+	// Intervalele vin deja de la camera spre departe, deci adancimea din cheie ramane 0
+	const uint64_t key =
+		SortKey::Make(RenderQueueLayer::Opaque, packet.pso->GetSortID(), GetMaterialCB_ID(), m_meshSortID, 0);
+
+	SubmitChunkDraws(queue, key, packet, m_drawRanges, CullingView::FromRenderLayer(renderLayer, m_cubeMapFace));
+}
+
 void TerrainRenderer::Update(float deltaTime)
 {
 	Object::Update(deltaTime);
@@ -155,11 +227,11 @@ void TerrainRenderer::BuildAccelerationStructures()
 	geometryDesc.Type = D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES;
 	geometryDesc.Flags = D3D12_RAYTRACING_GEOMETRY_FLAG_OPAQUE;
 	geometryDesc.Triangles.IndexBuffer = m_indexBuffer->GetIndexBufferView().BufferLocation;
-	geometryDesc.Triangles.IndexCount = (UINT)m_mesh->GetIndexCount();
+	geometryDesc.Triangles.IndexCount = m_indexBuffer->GetIndexCount();
 	geometryDesc.Triangles.IndexFormat = DXGI_FORMAT_R32_UINT;
 	geometryDesc.Triangles.Transform3x4 = 0;
 	geometryDesc.Triangles.VertexFormat = DXGI_FORMAT_R32G32B32_FLOAT;
-	geometryDesc.Triangles.VertexCount = (UINT)m_mesh->GetVertexCount();
+	geometryDesc.Triangles.VertexCount = m_vertexBuffer->GetVertexCount();
 	geometryDesc.Triangles.VertexBuffer.StartAddress = m_vertexBuffer->GetVertexBufferView().BufferLocation;
 	geometryDesc.Triangles.VertexBuffer.StrideInBytes = Mesh::GetSizeOfVertex();
 
@@ -169,16 +241,98 @@ void TerrainRenderer::BuildAccelerationStructures()
 		geomDescs, D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PREFER_FAST_TRACE);
 }
 
-void TerrainRenderer::FrustumCulling(const CameraController& cameraController)
+std::vector<engine::math::AABB> TerrainRenderer::GetChunkBoundingBoxes() const
+{
+	std::vector<engine::math::AABB> aabbs;
+	aabbs.reserve(m_chunks.size());
+
+	for (const auto& chunk : m_chunks)
+	{
+		aabbs.push_back(chunk.GetAABB());
+	}
+
+	return aabbs;
+}
+
+D3D12_RESOURCE_DESC TerrainRenderer::GetSplatMapDescriptor() const
+{
+	D3D12_RESOURCE_DESC desc = {};
+	desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+	desc.Alignment = 0;
+	desc.Width = m_splatMap->GetResolution();
+	desc.Height = m_splatMap->GetResolution();
+	desc.DepthOrArraySize = 1;
+	desc.MipLevels = (UINT16)m_splatMap->GetMipCount();
+	desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	desc.SampleDesc.Count = 1;
+	desc.SampleDesc.Quality = 0;
+	desc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+	desc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+	return desc;
+}
+
+std::vector<D3D12_SUBRESOURCE_DATA> TerrainRenderer::GetSplatMapSubresources() const
+{
+	std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+
+	uint32_t size = m_splatMap->GetResolution();
+	for (uint32_t level = 0; level < m_splatMap->GetMipCount(); level++)
+	{
+		D3D12_SUBRESOURCE_DATA data = {};
+		data.pData = m_splatMap->GetMip(level).data();
+		data.RowPitch = size * sizeof(uint32_t);
+		data.SlicePitch = data.RowPitch * size;
+
+		subresources.push_back(data);
+		size /= 2;
+	}
+
+	return subresources;
+}
+
+D3D12_RESOURCE_DESC TerrainRenderer::GetTessellationMapDescriptor() const
+{
+	D3D12_RESOURCE_DESC desc = {};
+	desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+	desc.Alignment = 0;
+	desc.Width = m_tessellationMap->GetResolution();
+	desc.Height = m_tessellationMap->GetResolution();
+	desc.DepthOrArraySize = 1;
+	desc.MipLevels = 1;
+	desc.Format = DXGI_FORMAT_R8_UNORM;
+	desc.SampleDesc.Count = 1;
+	desc.SampleDesc.Quality = 0;
+	desc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+	desc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+	return desc;
+}
+
+std::vector<D3D12_SUBRESOURCE_DATA> TerrainRenderer::GetTessellationMapSubresources() const
 {
-	const float zFarSq = std::pow(cameraController.GetCamera().GetZFar(), 2.f);
+	D3D12_SUBRESOURCE_DATA data = {};
+	data.pData = m_tessellationMap->GetData().data();
+	data.RowPitch = m_tessellationMap->GetResolution() * sizeof(uint8_t);
+	data.SlicePitch = data.RowPitch * m_tessellationMap->GetResolution();
+
+	return {data};
+}
 
-	for (auto& chunk : m_chunks)
+void TerrainRenderer::FrustumCulling(const MultiViewCuller& culler)
+{
+	for (uint32_t i = 0; i < (uint32_t)m_chunks.size(); i++)
 	{
-		chunk.SetVisible(
-			(chunk.GetAABB().GetCenter() - cameraController.GetCamera().GetPosition()).Length2() < zFarSq
-			&& cameraController.GetWorldSpaceFrustum().IntersectBoundingBox(chunk.GetAABB()));
+		m_chunks[i].SetVisibleViews(culler.Cull(m_chunks[i].GetAABB().GetBounds(), m_pvsTargetOffset + i));
 	}
+
+	// Desenarea de la camera spre departe lasa early-z sa respinga terenul ascuns inainte de pixel shader
+	const MultiViewCuller::View& mainView = culler.GetView(CullingView::Main);
+	OrderChunksFrontToBack(m_chunks, mainView.position, mainView.maxDistance, m_chunkDrawOrder);
+	BuildDrawRanges(m_chunks, m_chunkDrawOrder, m_drawRanges);
+
+	if (UseIndirectChunkDraws())
+		BuildIndirectChunkDraws(m_drawRanges);
 }
 
 }  // namespace engine::gfx
@@ -0,0 +1,154 @@
+#include "TerrainSplatMap.hpp"
+
+#include "TerrainSplat.h"
+#include "engine/core/CustomException.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace engine::gfx
+{
+
+namespace
+{
+
+inline uint32_t PackWeights(const std::array<uint32_t, 4>& weights)
+{
+	return weights[0] | (weights[1] << 8) | (weights[2] << 16) | (weights[3] << 24);
+}
+
+inline uint32_t UnpackWeight(uint32_t texel, uint32_t channel)
+{
+	return (texel >> (8 * channel)) & 0xFF;
+}
+
+// Ponderile straturilor 1..4 pentru un punct de pe teren; stratul 0 primeste restul.
+// Se cuantizeaza doar factorul de interpolare ca suma celor doua ponderi sa ramana exact 255.
+uint32_t EncodeTexel(float x, float y, float z)
+{
+	int textureIndex;
+	float lerpFactor;
+	ComputeTerrainLayerBlend(x, y, z, textureIndex, lerpFactor);
+
+	const uint32_t upper = (uint32_t)std::lround(std::clamp(lerpFactor, 0.f, 1.f) * 255.f);
+
+	std::array<uint32_t, 4> weights = {0, 0, 0, 0};
+	if (textureIndex > 0)
+		weights[textureIndex - 1] = 255 - upper;
+	weights[textureIndex] = upper;
+
+	return PackWeights(weights);
+}
+
+}  // namespace
+
+TerrainSplatMap::TerrainSplatMap(float gridWidth, float gridLength, uint32_t resolution)
+	: m_gridWidth(gridWidth), m_gridLength(gridLength), m_resolution(resolution)
+{
+}
+
+TerrainSplatMap::Ptr TerrainSplatMap::Bake(
+	std::function<float(float, float)> heightFunction, float gridWidth, float gridLength, uint32_t resolution)
+{
+	if (resolution == 0 || (resolution & (resolution - 1)) != 0)
+		throw engine::core::CustomException("Rezolutia hartii de splat trebuie sa fie putere a lui 2");
+
+	TerrainSplatMap::Ptr splatMap = Ptr(new TerrainSplatMap(gridWidth, gridLength, resolution));
+
+	std::vector<uint32_t> baseLevel(resolution * resolution);
+
+	// Centrul texelului (i, j) -> X pe v, Z pe u
+	for (uint32_t i = 0; i < resolution; i++)
+	{
+		const float x = (i + 0.5f) / resolution * gridLength - gridLength / 2.0f;
+
+		for (uint32_t j = 0; j < resolution; j++)
+		{
+			const float z = (j + 0.5f) / resolution * gridWidth - gridWidth / 2.0f;
+
+			baseLevel[i * resolution + j] = EncodeTexel(x, heightFunction(x, z), z);
+		}
+	}
+
+	splatMap->m_mips.push_back(std::move(baseLevel));
+	splatMap->GenerateMips();
+
+	return splatMap;
+}
+
+void TerrainSplatMap::GenerateMips()
+{
+	// Ponderile sunt liniare, deci media 2x2 a ponderilor este chiar filtrarea corecta
+	for (uint32_t size = m_resolution / 2; size > 0; size /= 2)
+	{
+		const std::vector<uint32_t>& source = m_mips.back();
+		const uint32_t sourceSize = size * 2;
+
+		std::vector<uint32_t> level(size * size);
+
+		for (uint32_t i = 0; i < size; i++)
+		{
+			for (uint32_t j = 0; j < size; j++)
+			{
+				const uint32_t t00 = source[(2 * i) * sourceSize + 2 * j];
+				const uint32_t t01 = source[(2 * i) * sourceSize + 2 * j + 1];
+				const uint32_t t10 = source[(2 * i + 1) * sourceSize + 2 * j];
+				const uint32_t t11 = source[(2 * i + 1) * sourceSize + 2 * j + 1];
+
+				std::array<uint32_t, 4> weights;
+				for (uint32_t c = 0; c < 4; c++)
+				{
+					weights[c] = (UnpackWeight(t00, c) + UnpackWeight(t01, c) + UnpackWeight(t10, c)
+								  + UnpackWeight(t11, c) + 2)
+								 / 4;
+				}
+
+				level[i * size + j] = PackWeights(weights);
+			}
+		}
+
+		m_mips.push_back(std::move(level));
+	}
+}
+
+float TerrainSplatMap::Validate(std::function<float(float, float)> heightFunction) const
+{
+	const std::vector<uint32_t>& baseLevel = m_mips.front();
+
+	float maxError = 0.f;
+
+	for (uint32_t i = 0; i < m_resolution; i++)
+	{
+		const float x = (i + 0.5f) / m_resolution * m_gridLength - m_gridLength / 2.0f;
+
+		for (uint32_t j = 0; j < m_resolution; j++)
+		{
+			const float z = (j + 0.5f) / m_resolution * m_gridWidth - m_gridWidth / 2.0f;
+
+			// Formula din shader, evaluata direct
+			int expectedIndex;
+			float expectedLerp;
+			ComputeTerrainLayerBlend(x, heightFunction(x, z), z, expectedIndex, expectedLerp);
+
+			// Ce obtine shaderul din harta de splat
+			const uint32_t texel = baseLevel[i * m_resolution + j];
+			int bakedIndex;
+			float bakedLerp;
+			DecodeTerrainSplat(
+				UnpackWeight(texel, 0) / 255.f,
+				UnpackWeight(texel, 1) / 255.f,
+				UnpackWeight(texel, 2) / 255.f,
+				UnpackWeight(texel, 3) / 255.f,
+				bakedIndex,
+				bakedLerp);
+
+			const float error = std::abs((expectedIndex + expectedLerp) - (bakedIndex + bakedLerp));
+			maxError = std::max(maxError, error);
+		}
+	}
+
+	return maxError;
+}
+
+}  // namespace engine::gfx
@@ -0,0 +1,98 @@
+#include "TerrainTessellationMap.hpp"
+
+#include "engine/core/CustomException.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine::gfx
+{
+
+TerrainTessellationMap::TerrainTessellationMap(uint32_t resolution)
+	: m_resolution(resolution), m_scales(resolution * resolution, 255)
+{
+}
+
+float TerrainTessellationMap::MeasureCellDeviation(
+	const std::function<float(float, float)>& heightFunction, float x0, float z0, float dx, float dz, int sampleCount)
+{
+	const float h00 = heightFunction(x0, z0);
+	const float h10 = heightFunction(x0 + dx, z0);
+	const float h01 = heightFunction(x0, z0 + dz);
+	const float h11 = heightFunction(x0 + dx, z0 + dz);
+
+	float maxDeviation = 0.f;
+
+	// Colturile sunt exacte, se esantioneaza doar interiorul si marginile
+	for (int i = 0; i <= sampleCount; i++)
+	{
+		const float s = (float)i / sampleCount;
+
+		for (int j = 0; j <= sampleCount; j++)
+		{
+			const float t = (float)j / sampleCount;
+
+			const float bilinear = (h00 * (1.f - s) + h10 * s) * (1.f - t) + (h01 * (1.f - s) + h11 * s) * t;
+			const float height = heightFunction(x0 + s * dx, z0 + t * dz);
+
+			maxDeviation = std::max(maxDeviation, std::abs(height - bilinear));
+		}
+	}
+
+	return maxDeviation;
+}
+
+float TerrainTessellationMap::DeviationToScale(float deviation, const Properties& properties)
+{
+	return std::clamp(deviation / properties.fullTessellationDeviation, properties.minScale, 1.f);
+}
+
+TerrainTessellationMap::Ptr TerrainTessellationMap::Compute(
+	std::function<float(float, float)> heightFunction,
+	float gridWidth,
+	float gridLength,
+	int sidePointCount,
+	const Properties& properties)
+{
+	if (sidePointCount < 2 || properties.sampleCount < 1 || properties.fullTessellationDeviation <= 0.f)
+		throw engine::core::CustomException("Parametri invalizi pentru harta de teselare");
+
+	TerrainTessellationMap::Ptr tessellationMap = Ptr(new TerrainTessellationMap((uint32_t)sidePointCount));
+
+	// Aceeasi conventie ca in GenerateChunks: X pe randuri, Z pe coloane
+	const float dx = gridLength / sidePointCount;
+	const float dz = gridWidth / sidePointCount;
+	const int cellCount = sidePointCount - 1;
+
+	for (int i = 0; i < cellCount; i++)
+	{
+		const float x0 = i * dx - gridLength / 2.0f;
+
+		for (int j = 0; j < cellCount; j++)
+		{
+			const float z0 = j * dz - gridWidth / 2.0f;
+
+			const float deviation = MeasureCellDeviation(heightFunction, x0, z0, dx, dz, properties.sampleCount);
+			const float scale = DeviationToScale(deviation, properties);
+
+			// Rotunjire in sus ca un patch sa nu primeasca mai putina teselare decat a cerut
+			tessellationMap->m_scales[i * sidePointCount + j] = (uint8_t)std::ceil(scale * 255.f);
+		}
+
+		tessellationMap->m_scales[i * sidePointCount + cellCount] = tessellationMap->m_scales[i * sidePointCount + cellCount - 1];
+	}
+
+	std::copy_n(
+		tessellationMap->m_scales.begin() + (cellCount - 1) * sidePointCount,
+		sidePointCount,
+		tessellationMap->m_scales.begin() + cellCount * sidePointCount);
+
+	return tessellationMap;
+}
+
+float TerrainTessellationMap::GetScale(uint32_t row, uint32_t column) const
+{
+	return m_scales[row * m_resolution + column] / 255.f;
+}
+
+}  // namespace engine::gfx
@@ -5,10 +5,27 @@
 namespace engine::gfx
 {
 
+namespace
+{
+
+void ReleaseHandle(D3D12_DESCRIPTOR_HEAP_TYPE heapType, DescriptorHandle& handle)
+{
+	if (handle.IsNull())
+		return;
+
+	GraphicsResources::FreeDescriptor(heapType, handle);
+	handle = DescriptorHandle();
+}
+
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 // Creare Handleri si Descriptori
+// La realocare (ex. textura reincarcata) vederea veche se elibereaza inainte, deci noua ii ia slotul din heap
 void Texture::AllocateSrvHandle(DXGI_FORMAT srvFormat, D3D12_SHADER_RESOURCE_VIEW_DESC* srvDescriptor)
 {
+	ReleaseHandle(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, m_SrvHandle);
+
 	if (srvFormat == DXGI_FORMAT_UNKNOWN)
 	{
 		if (DepthTexture* depthTexture = dynamic_cast<DepthTexture*>(this))
@@ -63,6 +80,8 @@ void Texture::AllocateSrvHandle(DXGI_FORMAT srvFormat, D3D12_SHADER_RESOURCE_VIE
 
 void ColorTexture::AllocateUavHandle(DXGI_FORMAT uavFormat, D3D12_UNORDERED_ACCESS_VIEW_DESC* uavDescriptor)
 {
+	ReleaseHandle(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, m_UavHandle);
+
 	if (uavFormat == DXGI_FORMAT_UNKNOWN)
 	{
 		uavFormat = GetUAVFormat(m_format);
@@ -96,6 +115,11 @@ void ColorTexture::AllocateUavHandle(DXGI_FORMAT uavFormat, D3D12_UNORDERED_ACCE
 
 void ColorTexture::AllocateRtvHandle(DXGI_FORMAT rtvFormat, D3D12_RENDER_TARGET_VIEW_DESC* rtvDescriptor)
 {
+	for (DescriptorHandle& rtvHandle : m_RtvHandle)
+	{
+		ReleaseHandle(D3D12_DESCRIPTOR_HEAP_TYPE_RTV, rtvHandle);
+	}
+
 	if (rtvFormat == DXGI_FORMAT_UNKNOWN)
 	{
 		rtvFormat = m_format;
@@ -135,6 +159,8 @@ void ColorTexture::AllocateRtvHandle(DXGI_FORMAT rtvFormat, D3D12_RENDER_TARGET_
 
 void DepthTexture::AllocateDsvHandle(DXGI_FORMAT dsvFormat, D3D12_DEPTH_STENCIL_VIEW_DESC* dsvDescriptor)
 {
+	ReleaseHandle(D3D12_DESCRIPTOR_HEAP_TYPE_DSV, m_DsvHandle);
+
 	if (dsvFormat == DXGI_FORMAT_UNKNOWN)
 	{
 		dsvFormat = GetDSVFormat(m_format);
@@ -166,13 +192,35 @@ void DepthTexture::AllocateDsvHandle(DXGI_FORMAT dsvFormat, D3D12_DEPTH_STENCIL_
 	}
 }
 
+void Texture::ReleaseDescriptors()
+{
+	ReleaseHandle(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, m_SrvHandle);
+}
+
+void ColorTexture::ReleaseDescriptors()
+{
+	Texture::ReleaseDescriptors();
+
+	ReleaseHandle(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, m_UavHandle);
+	for (DescriptorHandle& rtvHandle : m_RtvHandle)
+	{
+		ReleaseHandle(D3D12_DESCRIPTOR_HEAP_TYPE_RTV, rtvHandle);
+	}
+}
+
+void DepthTexture::ReleaseDescriptors()
+{
+	Texture::ReleaseDescriptors();
+
+	ReleaseHandle(D3D12_DESCRIPTOR_HEAP_TYPE_DSV, m_DsvHandle);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 // Creare resurse
 void DepthTexture::Create(UINT width, UINT height, DXGI_FORMAT format, std::wstring name)
 {
 	HRESULT hr;
 
-	m_UsageState = D3D12_RESOURCE_STATE_DEPTH_WRITE;
 	m_format = format;
 
 	CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_DEFAULT);
@@ -192,10 +240,11 @@ void DepthTexture::Create(UINT width, UINT height, DXGI_FORMAT format, std::wstr
 		&heapProps,
 		D3D12_HEAP_FLAG_NONE,
 		&textureDecs,
-		m_UsageState,
+		D3D12_RESOURCE_STATE_DEPTH_WRITE,
 		&clearValue,
 		IID_PPV_ARGS(m_pResource.ReleaseAndGetAddressOf())));
 
+	SetInitialState(D3D12_RESOURCE_STATE_DEPTH_WRITE);
 	SetName(name);
 }
 
@@ -203,7 +252,6 @@ void ColorTexture::Create(UINT width, UINT height, DXGI_FORMAT format, D3D12_RES
 {
 	HRESULT hr;
 
-	m_UsageState = D3D12_RESOURCE_STATE_COMMON;
 	m_format = format;
 
 	CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_DEFAULT);
@@ -225,10 +273,11 @@ void ColorTexture::Create(UINT width, UINT height, DXGI_FORMAT format, D3D12_RES
 		&heapProps,
 		D3D12_HEAP_FLAG_NONE,
 		&textureDecs,
-		m_UsageState,
+		D3D12_RESOURCE_STATE_DEPTH_WRITE,
 		&clearValue,
 		IID_PPV_ARGS(m_pResource.ReleaseAndGetAddressOf())));
 
+	SetInitialState(D3D12_RESOURCE_STATE_DEPTH_WRITE);
 	SetName(name);
 }
 
@@ -237,7 +286,7 @@ void ColorTexture::CreateFromSwapChain(IDXGISwapChain4* pSwapChain, UINT frameIn
 	pSwapChain->GetBuffer(frameIndex, IID_PPV_ARGS(m_pResource.ReleaseAndGetAddressOf()));
 
 	m_GpuVirtualAddress = D3D12_GPU_VIRTUAL_ADDRESS_UNKNOWN;
-	m_UsageState = D3D12_RESOURCE_STATE_COMMON;
+	SetInitialState(D3D12_RESOURCE_STATE_COMMON);
 	m_format = m_pResource->GetDesc().Format;
 
 	SetName(L"RenderTexture" + std::to_wstring(frameIndex));
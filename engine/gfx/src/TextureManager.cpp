@@ -72,15 +72,55 @@ void TextureManager::LoadTexturesFormFiles(ID3D12Device10* pDevice, ID3D12Comman
 			&texture->m_isCubeMap));
 
 		texture->SetName(texture->GetName());
-		texture->m_UsageState = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+		texture->SetInitialState(D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 		texture->m_format = texture->m_pResource->GetDesc().Format;
 		texture->m_GpuVirtualAddress = D3D12_GPU_VIRTUAL_ADDRESS_UNKNOWN;
+
+		texture->TrackResidency(ResidencyPriority::Normal);
 	}
 
 	auto uploadResourcesFinished = resourceUpload.End(pCommandQueue);
 	uploadResourcesFinished.wait();
 }
 
+void TextureManager::CreateTextureFromMemory(
+	ID3D12Device10* pDevice,
+	ID3D12CommandQueue* pCommandQueue,
+	std::wstring name,
+	const D3D12_RESOURCE_DESC& resourceDesc,
+	const std::vector<D3D12_SUBRESOURCE_DATA>& subresources,
+	bool isNonPixelShaderResource)
+{
+	ColorTexture::Ptr texture = std::make_unique<ColorTexture>(L"", name, false, isNonPixelShaderResource);
+
+	const D3D12_RESOURCE_STATES finalState = isNonPixelShaderResource
+		? D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE
+		: D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+
+	texture->CreateResource(D3D12_HEAP_TYPE_DEFAULT, resourceDesc, D3D12_RESOURCE_STATE_COPY_DEST);
+
+	ResourceUploadBatch resourceUpload(pDevice);
+	resourceUpload.Begin();
+
+	resourceUpload.Upload(texture->m_pResource.Get(), 0, subresources.data(), (UINT)subresources.size());
+	resourceUpload.Transition(texture->m_pResource.Get(), D3D12_RESOURCE_STATE_COPY_DEST, finalState);
+
+	auto uploadResourcesFinished = resourceUpload.End(pCommandQueue);
+	uploadResourcesFinished.wait();
+
+	texture->SetName(name);
+	texture->SetInitialState(finalState);
+	texture->m_format = resourceDesc.Format;
+	texture->m_GpuVirtualAddress = D3D12_GPU_VIRTUAL_ADDRESS_UNKNOWN;
+
+	texture->AllocateSrvHandle();
+
+	// Nimic pentru texturile plasate intr-un heap
+	texture->TrackResidency(ResidencyPriority::Normal);
+
+	m_textures.push_back(std::move(texture));
+}
+
 void TextureManager::CreateSRVHandles()
 {
 	for (auto& texture : m_textures)
@@ -103,12 +143,20 @@ void TextureManager::SwapNonPixelShaderTextures(GraphicsContext& context)
 	context.FlushResourceBarriers();
 }
 
-const ColorTexture& TextureManager::GetTexture(std::wstring textureName) const
+void TextureManager::MarkUsed()
+{
+	for (auto& texture : m_textures)
+	{
+		texture->MarkUsed();
+	}
+}
+
+const ColorTexture& TextureManager::GetTexture(std::wstring_view textureName) const
 {
 	return **std::find_if(
 		m_textures.begin(),
 		m_textures.end(),
-		[&textureName](const auto& texture) { return texture->GetName() == textureName; });
+		[textureName](const auto& texture) { return texture->GetName() == textureName; });
 }
 
 }  // namespace engine::gfx
@@ -51,14 +51,14 @@ void TextureRenderer::Render(engine::gfx::rasterization::RenderLayer::Value rend
 
 	graphicsContext.SetDescriptorTable(0, m_textureSRVHandle);
 
-	graphicsContext.Draw(m_mesh->GetVertexCount());
+	graphicsContext.Draw(m_vertexBuffer->GetVertexCount());
 }
 
 void TextureRenderer::BuildAccelerationStructures()
 {
 }
 
-void TextureRenderer::FrustumCulling(const CameraController& cameraController)
+void TextureRenderer::FrustumCulling(const MultiViewCuller& culler)
 {
 }
 
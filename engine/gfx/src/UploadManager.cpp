@@ -0,0 +1,208 @@
+#include "UploadManager.hpp"
+
+#include "Context.hpp"
+#include "GraphicsResources.hpp"
+
+namespace engine::gfx
+{
+
+namespace
+{
+
+// Suficient pentru copierile de buffere; texturile ar cere D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT
+constexpr UINT64 BufferPlacementAlignment = 16;
+
+}  // namespace
+
+UploadManager::~UploadManager()
+{
+	if (m_pMappedRing != nullptr)
+		pRingBuffer->Unmap(0, nullptr);
+}
+
+void UploadManager::Create(ID3D12CommandQueue* directQueue, UINT64 ringSize)
+{
+	HRESULT hr;
+
+	pDirectQueue = directQueue;
+
+	D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+	queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+	queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+	queueDesc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+	queueDesc.NodeMask = 0;
+	GFX_THROW_INFO(GraphicsResources::GetDevice()->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&pCopyQueue)));
+	pCopyQueue->SetName(L"UploadCopyQueue");
+
+	m_fenceValue = 0;
+	GFX_THROW_INFO(GraphicsResources::GetDevice()->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&pFence)));
+
+	auto uploadHeapProperties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+	auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(ringSize);
+	GFX_THROW_INFO(GraphicsResources::GetDevice()->CreateCommittedResource(
+		&uploadHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&bufferDesc,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(&pRingBuffer)));
+	pRingBuffer->SetName(L"UploadRing");
+
+	// Ramane mapat toata viata managerului; CPU-ul doar scrie
+	CD3DX12_RANGE readRange(0, 0);
+	GFX_THROW_INFO(pRingBuffer->Map(0, &readRange, reinterpret_cast<void**>(&m_pMappedRing)));
+
+	m_ring.Create(ringSize);
+
+	m_batches.Create(
+		[this]()
+		{
+			CommandContext::Ptr context = std::make_unique<CommandContext>();
+			context->Create(D3D12_COMMAND_LIST_TYPE_COPY);
+
+			std::wstring name = L"UploadCommandList_" + std::to_wstring(m_batches.GetSize());
+			context->GetCommandList()->SetName(name.c_str());
+
+			return context;
+		});
+}
+
+UploadTicket UploadManager::UploadBuffer(GpuResource& dest, UINT64 destOffset, const void* pData, UINT64 dataSize)
+{
+	assert(pData != nullptr && dataSize > 0);
+
+	Reclaim();
+
+	// Submit-ul in care va pleca copierea
+	const UploadTicket ticket = m_fenceValue + 1;
+
+	m_statistics.copyCount++;
+	m_statistics.uploadedBytes += dataSize;
+
+	if (dataSize > m_ring.GetCapacity())
+	{
+		HRESULT hr;
+
+		DedicatedUpload& upload = m_dedicatedUploads.emplace_back();
+		upload.fenceValue = ticket;
+
+		auto uploadHeapProperties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+		auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(dataSize);
+		GFX_THROW_INFO(GraphicsResources::GetDevice()->CreateCommittedResource(
+			&uploadHeapProperties,
+			D3D12_HEAP_FLAG_NONE,
+			&bufferDesc,
+			D3D12_RESOURCE_STATE_GENERIC_READ,
+			nullptr,
+			IID_PPV_ARGS(&upload.pResource)));
+
+		void* pMappedData;
+		CD3DX12_RANGE readRange(0, 0);
+		GFX_THROW_INFO(upload.pResource->Map(0, &readRange, &pMappedData));
+		memcpy(pMappedData, pData, dataSize);
+		upload.pResource->Unmap(0, nullptr);
+
+		GetBatch().GetCommandList()->CopyBufferRegion(
+			dest.GetResource(), destOffset, upload.pResource.Get(), 0, dataSize);
+		m_statistics.dedicatedBufferCount++;
+
+		return ticket;
+	}
+
+	UINT64 offset = m_ring.Allocate(dataSize, BufferPlacementAlignment);
+	while (offset == UploadRingAllocator::InvalidOffset)
+	{
+		// Ring plin: copierile adunate pleaca, apoi se asteapta cel mai vechi submit
+		Submit();
+		WaitForFence(m_ring.GetOldestFenceValue());
+		m_statistics.ringWaitCount++;
+
+		Reclaim();
+		offset = m_ring.Allocate(dataSize, BufferPlacementAlignment);
+	}
+
+	memcpy(m_pMappedRing + offset, pData, dataSize);
+	GetBatch().GetCommandList()->CopyBufferRegion(dest.GetResource(), destOffset, pRingBuffer.Get(), offset, dataSize);
+
+	// Copierea pleaca in submit-ul urmator, chiar daca ring-ul a fost golit mai sus
+	return m_fenceValue + 1;
+}
+
+void UploadManager::Submit()
+{
+	if (m_pBatch == nullptr)
+		return;
+
+	m_pBatch->Close();
+
+	ID3D12CommandList* ppCommandLists[] = {m_pBatch->GetCommandList()};
+	pCopyQueue->ExecuteCommandLists(_countof(ppCommandLists), ppCommandLists);
+	pCopyQueue->Signal(pFence.Get(), ++m_fenceValue);
+
+	// Tot ce se trimite dupa pe coada directa vede bufferele copiate, fara asteptare pe CPU
+	pDirectQueue->Wait(pFence.Get(), m_fenceValue);
+
+	m_batches.Release(*m_pBatch, m_fenceValue);
+	m_pBatch = nullptr;
+
+	m_ring.Retire(m_fenceValue);
+	m_statistics.submitCount++;
+}
+
+bool UploadManager::IsComplete(UploadTicket ticket)
+{
+	return pFence->GetCompletedValue() >= ticket;
+}
+
+void UploadManager::Wait(UploadTicket ticket)
+{
+	if (ticket > m_fenceValue)
+		Submit();
+
+	WaitForFence(ticket);
+	Reclaim();
+}
+
+void UploadManager::WaitForIdle()
+{
+	Submit();
+
+	WaitForFence(m_fenceValue);
+	Reclaim();
+}
+
+CommandContext& UploadManager::GetBatch()
+{
+	if (m_pBatch != nullptr)
+		return *m_pBatch;
+
+	m_pBatch = &m_batches.Acquire(pFence->GetCompletedValue());
+	m_pBatch->Reset();
+
+	return *m_pBatch;
+}
+
+void UploadManager::WaitForFence(UINT64 fenceValue)
+{
+	if (pFence->GetCompletedValue() >= fenceValue)
+		return;
+
+	HRESULT hr;
+
+	// Cu eveniment nul apelul asteapta
+	GFX_THROW_INFO(pFence->SetEventOnCompletion(fenceValue, nullptr));
+}
+
+void UploadManager::Reclaim()
+{
+	const UINT64 completedFenceValue = pFence->GetCompletedValue();
+
+	m_ring.Reclaim(completedFenceValue);
+
+	while (!m_dedicatedUploads.empty() && m_dedicatedUploads.front().fenceValue <= completedFenceValue)
+	{
+		m_dedicatedUploads.pop_front();
+	}
+}
+
+}  // namespace engine::gfx
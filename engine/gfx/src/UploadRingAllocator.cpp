@@ -0,0 +1,71 @@
+#include "UploadRingAllocator.hpp"
+
+#include <cassert>
+
+namespace engine::gfx
+{
+
+void UploadRingAllocator::Create(uint64_t capacity)
+{
+	assert(capacity > 0);
+
+	m_capacity = capacity;
+	m_head = 0;
+	m_usedSize = 0;
+	m_pendingSize = 0;
+	m_retired.clear();
+}
+
+uint64_t UploadRingAllocator::Allocate(uint64_t size, uint64_t alignment)
+{
+	assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+	if (size == 0 || size > m_capacity)
+		return InvalidOffset;
+
+	uint64_t offset = (m_head + alignment - 1) & ~(alignment - 1);
+	uint64_t padding = offset - m_head;
+
+	// Nu incape pana la capat: se sare la inceputul bufferului, aliniat pentru orice alignment
+	if (offset + size > m_capacity)
+	{
+		offset = 0;
+		padding = m_capacity - m_head;
+	}
+
+	// Spatiul liber e contiguu de la m_head pana la cea mai veche alocare, deci ajunge numararea octetilor
+	if (m_usedSize + padding + size > m_capacity)
+		return InvalidOffset;
+
+	m_usedSize += padding + size;
+	m_pendingSize += padding + size;
+	m_head = offset + size == m_capacity ? 0 : offset + size;
+
+	return offset;
+}
+
+void UploadRingAllocator::Retire(uint64_t fenceValue)
+{
+	if (m_pendingSize == 0)
+		return;
+
+	assert(m_retired.empty() || m_retired.back().fenceValue <= fenceValue);
+
+	m_retired.push_back({fenceValue, m_pendingSize});
+	m_pendingSize = 0;
+}
+
+void UploadRingAllocator::Reclaim(uint64_t completedFenceValue)
+{
+	while (!m_retired.empty() && m_retired.front().fenceValue <= completedFenceValue)
+	{
+		m_usedSize -= m_retired.front().size;
+		m_retired.pop_front();
+	}
+
+	// Ring gol: urmatoarea alocare poate porni de la inceput, fara capat sarit
+	if (m_usedSize == 0)
+		m_head = 0;
+}
+
+}  // namespace engine::gfx
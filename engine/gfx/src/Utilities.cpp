@@ -3,6 +3,7 @@
 #include "engine/core/DxgiInfoManager.hpp"
 #include "engine/core/Settings.hpp"
 
+#include <cassert>
 #include <iomanip>
 #include <sstream>
 
@@ -350,12 +351,16 @@ void SetTearing(Microsoft::WRL::ComPtr<IDXGIFactory4> pFactory)
 
 
 void DescriptorHeap::Create(
-	ID3D12Device10* pDevice, const std::wstring& Name, D3D12_DESCRIPTOR_HEAP_TYPE Type, uint32_t MaxCount)
+	ID3D12Device10* pDevice,
+	const std::wstring& Name,
+	D3D12_DESCRIPTOR_HEAP_TYPE Type,
+	uint32_t PersistentCount,
+	uint32_t TransientCount)
 {
 	HRESULT hr;
 
 	m_HeapDesc.Type = Type;
-	m_HeapDesc.NumDescriptors = MaxCount;
+	m_HeapDesc.NumDescriptors = PersistentCount + TransientCount;
 	m_HeapDesc.Flags = Type == D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV ? D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE
 																	  : D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
 	m_HeapDesc.NodeMask = 1;
@@ -365,24 +370,69 @@ void DescriptorHeap::Create(
 	m_Heap->SetName(Name.c_str());
 
 	m_DescriptorSize = pDevice->GetDescriptorHandleIncrementSize(m_HeapDesc.Type);
-	m_NumFreeDescriptors = m_HeapDesc.NumDescriptors;
 	m_FirstHandle = DescriptorHandle(
 		m_Heap->GetCPUDescriptorHandleForHeapStart(),
 		Type == D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV
 			? m_Heap->GetGPUDescriptorHandleForHeapStart()
 			: D3D12_GPU_DESCRIPTOR_HANDLE(D3D12_GPU_VIRTUAL_ADDRESS_UNKNOWN));
-	m_NextFreeHandle = m_FirstHandle;
+
+	m_Allocator.Create(PersistentCount, TransientCount);
 }
 
 DescriptorHandle DescriptorHeap::Alloc(uint32_t Count)
 {
-	assert(HasAvailableSpace(Count));
+	const uint32_t index = m_Allocator.Allocate(Count);
+	if (index == DescriptorAllocator::InvalidIndex)
+		throw engine::core::CustomException("Heap de descriptori plin");
+
+	return (*this)[index];
+}
+
+void DescriptorHeap::Free(const DescriptorHandle& DHandle, uint32_t Count)
+{
+	assert(ValidateHandle(DHandle));
+
+	m_Allocator.Free(GetOffsetOfHandle(DHandle), Count);
+}
+
+DescriptorHandle DescriptorHeap::AllocTransient(uint32_t Count)
+{
+	const uint32_t index = m_Allocator.AllocateTransient(Count);
+	if (index == DescriptorAllocator::InvalidIndex)
+		throw engine::core::CustomException("Regiunea tranzitorie a heap-ului de descriptori e plina");
 
-	DescriptorHandle ret = m_NextFreeHandle;
-	m_NextFreeHandle += Count * m_DescriptorSize;
-	m_NumFreeDescriptors -= Count;
+	return (*this)[index];
+}
+
+DescriptorHandle DescriptorHeap::StageTable(const D3D12_CPU_DESCRIPTOR_HANDLE* pSources, uint32_t Count)
+{
+	const DescriptorHandle table = AllocTransient(Count);
+
+	m_StagedDestinations.push_back(table);
+	m_StagedDestinationSizes.push_back(Count);
+	m_StagedSources.insert(m_StagedSources.end(), pSources, pSources + Count);
+
+	return table;
+}
+
+void DescriptorHeap::FlushStagedCopies(ID3D12Device10* pDevice)
+{
+	if (m_StagedDestinations.empty())
+		return;
 
-	return ret;
+	// Sursele sunt descriptori individuali: un array de marimi nul inseamna cate un descriptor pe interval
+	pDevice->CopyDescriptors(
+		(UINT)m_StagedDestinations.size(),
+		m_StagedDestinations.data(),
+		m_StagedDestinationSizes.data(),
+		(UINT)m_StagedSources.size(),
+		m_StagedSources.data(),
+		nullptr,
+		m_HeapDesc.Type);
+
+	m_StagedDestinations.clear();
+	m_StagedDestinationSizes.clear();
+	m_StagedSources.clear();
 }
 
 bool DescriptorHeap::ValidateHandle(const DescriptorHandle& DHandle) const
@@ -391,7 +441,9 @@ bool DescriptorHeap::ValidateHandle(const DescriptorHandle& DHandle) const
 		|| DHandle.GetCpuPtr() >= m_FirstHandle.GetCpuPtr() + m_HeapDesc.NumDescriptors * m_DescriptorSize)
 		return false;
 
-	if (DHandle.GetGpuPtr() - m_FirstHandle.GetGpuPtr() != DHandle.GetCpuPtr() - m_FirstHandle.GetCpuPtr())
+	// Heap-urile RTV / DSV nu au handle-uri GPU
+	if (m_FirstHandle.IsShaderVisible()
+		&& DHandle.GetGpuPtr() - m_FirstHandle.GetGpuPtr() != DHandle.GetCpuPtr() - m_FirstHandle.GetCpuPtr())
 		return false;
 
 	return true;
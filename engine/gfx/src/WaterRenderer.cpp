@@ -2,6 +2,8 @@
 
 #include "GeometryGenerator.hpp"
 
+#include <numeric>
+
 namespace engine::gfx
 {
 
@@ -47,7 +49,14 @@ void WaterRenderer::LoadGeometry(DescriptorVariant descriptor)
 {
 	DX_WATER_DESCRIPTOR& waterDesc = std::get<DX_WATER_DESCRIPTOR>(descriptor);
 
-	if (!engine::core::Settings::UseRayTracing())
+	m_width = waterDesc.width;
+	m_length = waterDesc.length;
+
+	if (!engine::core::Settings::UseRayTracing() && waterDesc.useProjectedGrid)
+	{
+		LoadProjectedGrid(waterDesc);
+	}
+	else if (!engine::core::Settings::UseRayTracing())
 	{
 		std::vector<engine::math::AABB> aabbs;
 		std::vector<SubMesh> submeshs;
@@ -66,9 +75,20 @@ void WaterRenderer::LoadGeometry(DescriptorVariant descriptor)
 			m_chunks.emplace_back(submeshs[i], aabbs[i]);
 		}
 
+		// Pana la primul culling se deseneaza in ordinea de generare
+		m_chunkDrawOrder.resize(m_chunks.size());
+		std::iota(m_chunkDrawOrder.begin(), m_chunkDrawOrder.end(), 0);
+		BuildDrawRanges(m_chunks, m_chunkDrawOrder, m_drawRanges);
+
 		// GeometryHelper::ChnageColor(m_mesh, GetColor());
 
 		CreateVertexAndIndexBuffer(engine::core::Settings::UseRayTracing());
+
+		if (engine::core::Settings::GetGraphicsSettings().UseIndirectDraws())
+		{
+			CreateIndirectChunkDraws((UINT)m_chunks.size());
+			BuildIndirectChunkDraws(m_drawRanges);
+		}
 	}
 	else
 	{
@@ -100,6 +120,39 @@ void WaterRenderer::LoadGeometry(DescriptorVariant descriptor)
 	}
 }
 
+void WaterRenderer::LoadProjectedGrid(const DX_WATER_DESCRIPTOR& waterDesc)
+{
+	// Inaltimea maxima a valurilor: suma amplitudinilor Gerstner + displacement-ul valurilor mici (x4 in Water.hlsl)
+	float maxAmplitude = 4.f;
+	for (const auto& wave : waterDesc.waveProperties)
+	{
+		maxAmplitude += std::abs(wave.amplitude);
+	}
+
+	m_projectedGrid =
+		std::make_unique<ProjectedGrid>(waterDesc.projectedGridColumns, waterDesc.projectedGridRows, maxAmplitude);
+
+	// Indecsii sunt statici, doar vertecsii se schimba de la un frame la altul
+	m_mesh = std::make_shared<Mesh>(std::vector<Mesh::Vertex>(), m_projectedGrid->GenerateIndices());
+
+	m_indexBuffer.reset(new IndexBuffer());
+	m_indexBuffer->Create(*m_mesh);
+	ReleaseCpuGeometry();
+
+	// Generate scrie doar pozitia si coordonatele de textura; restul atributelor sunt aceleasi pentru toata grila
+	Mesh::Vertex gridVertex;
+	gridVertex.color = DirectX::XMFLOAT4(0.f, 0.f, 1.f, 1.f);
+	gridVertex.normal = DirectX::XMFLOAT3(0.f, 1.f, 0.f);
+	gridVertex.tangent = DirectX::XMFLOAT3(1.f, 0.f, 0.f);
+	m_projectedGridStaging.assign(m_projectedGrid->GetVertexCount(), gridVertex);
+
+	m_projectedGridVertices.Create(
+		GraphicsResources::GetDevice(),
+		m_projectedGrid->GetVertexCount(),
+		engine::core::Settings::GetFrameResourcesCount(),
+		L"Water_ProjectedGrid_VB");
+}
+
 void WaterRenderer::Update(float deltaTime)
 {
 	using namespace engine::math;
@@ -110,16 +163,50 @@ void WaterRenderer::Update(float deltaTime)
 	Object::Update(deltaTime);
 }
 
-void WaterRenderer::FrustumCulling(const CameraController& cameraController)
+std::vector<engine::math::AABB> WaterRenderer::GetChunkBoundingBoxes() const
 {
-	const float zFarSq = std::pow(cameraController.GetCamera().GetZFar(), 2.f);
+	std::vector<engine::math::AABB> aabbs;
+	aabbs.reserve(m_chunks.size());
 
-	for (auto& chunk : m_chunks)
+	for (const auto& chunk : m_chunks)
 	{
-		chunk.SetVisible(
-			(chunk.GetAABB().GetCenter() - cameraController.GetCamera().GetPosition()).Length2() < zFarSq
-			&& cameraController.GetWorldSpaceFrustum().IntersectBoundingBox(chunk.GetAABB()));
+		aabbs.push_back(chunk.GetAABB());
 	}
+
+	return aabbs;
+}
+
+void WaterRenderer::FrustumCulling(const MultiViewCuller& culler)
+{
+	const MultiViewCuller::View& mainView = culler.GetView(CullingView::Main);
+
+	if (m_projectedGrid)
+	{
+		const UINT frameIndex = GraphicsResources::GetContextManager().GetFrameIndex();
+
+		m_isProjectedGridVisible[frameIndex] =
+			m_projectedGrid->Generate(mainView.viewProjMatrix, m_width, m_length, m_projectedGridStaging);
+
+		if (m_isProjectedGridVisible[frameIndex])
+		{
+			m_projectedGridVertices.CopyData(
+				frameIndex, m_projectedGridStaging.data(), (UINT)m_projectedGridStaging.size());
+		}
+
+		return;
+	}
+
+	for (uint32_t i = 0; i < (uint32_t)m_chunks.size(); i++)
+	{
+		m_chunks[i].SetVisibleViews(culler.Cull(m_chunks[i].GetAABB().GetBounds(), m_pvsTargetOffset + i));
+	}
+
+	// Desenarea de la camera spre departe lasa early-z sa respinga terenul ascuns inainte de pixel shader
+	OrderChunksFrontToBack(m_chunks, mainView.position, mainView.maxDistance, m_chunkDrawOrder);
+	BuildDrawRanges(m_chunks, m_chunkDrawOrder, m_drawRanges);
+
+	if (UseIndirectChunkDraws())
+		BuildIndirectChunkDraws(m_drawRanges);
 }
 
 void WaterRenderer::Render(engine::gfx::rasterization::RenderLayer::Value renderLayer) const
@@ -129,15 +216,33 @@ void WaterRenderer::Render(engine::gfx::rasterization::RenderLayer::Value render
 
 	const auto renderChunks = [this, &graphicsContext]
 	{
-		for (const auto& chunk : m_chunks)
+		if (m_projectedGrid)
 		{
-			if (!chunk.IsVisible())
-				continue;
+			const UINT frameIndex = GraphicsResources::GetContextManager().GetFrameIndex();
+
+			if (!m_isProjectedGridVisible[frameIndex])
+				return;
+
+			D3D12_VERTEX_BUFFER_VIEW vertexBufferView;
+			vertexBufferView.BufferLocation = m_projectedGridVertices.GetGpuVirtualAdress(frameIndex);
+			vertexBufferView.StrideInBytes = (UINT)Mesh::GetSizeOfVertex();
+			vertexBufferView.SizeInBytes = m_projectedGridVertices.GetFrameSizeInBytes();
+
+			graphicsContext.SetVertexBuffer(0, vertexBufferView);
+			graphicsContext.DrawIndexed(m_projectedGrid->GetIndexCount());
 
-			const SubMesh& subMesh = chunk.GetSubMesh();
+			return;
+		}
 
-			graphicsContext.DrawIndexed(
-				(UINT)subMesh.indexCount, (UINT)subMesh.startIndexLocation, (UINT)subMesh.baseVertexLocation);
+		if (UseIndirectChunkDraws())
+		{
+			DrawChunksIndirect(graphicsContext, CullingView::Main);
+			return;
+		}
+
+		for (const DrawRange& range : m_drawRanges[CullingView::Main].GetRanges())
+		{
+			graphicsContext.DrawIndexed(range.indexCount, range.startIndexLocation, range.baseVertexLocation);
 		}
 	};
 
@@ -149,7 +254,8 @@ void WaterRenderer::Render(engine::gfx::rasterization::RenderLayer::Value render
 
 		graphicsContext.SetPrimitiveTopology(m_baseToplogy);
 
-		graphicsContext.SetVertexBuffer(0, m_vertexBuffer->GetVertexBufferView());
+		if (!m_projectedGrid)
+			graphicsContext.SetVertexBuffer(0, m_vertexBuffer->GetVertexBufferView());
 		graphicsContext.SetIndexBuffer(m_indexBuffer->GetIndexBufferView());
 
 		graphicsContext.BindDescriptorHeaps();
@@ -38,6 +38,14 @@ class AABB
 	INLINE Scalar GetMaxY() const { return GetMax().GetY(); }
 	INLINE Scalar GetMaxZ() const { return GetMax().GetZ(); }
 
+	// Pentru modulele care nu depind de DirectXMath
+	INLINE BoxBounds GetBounds() const
+	{
+		return {
+			{(float)GetMinX(), (float)GetMinY(), (float)GetMinZ()},
+			{(float)GetMaxX(), (float)GetMaxY(), (float)GetMaxZ()}};
+	}
+
 	INLINE Scalar GetSizeX() const { return GetSize().GetX(); }
 	INLINE Scalar GetSizeY() const { return GetSize().GetY(); }
 	INLINE Scalar GetSizeZ() const { return GetSize().GetZ(); }
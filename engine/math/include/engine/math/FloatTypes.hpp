@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+
+namespace engine::math
+{
+
+////////////////////////////////////////////////
+// Tipuri simple din float-uri, fara DirectXMath
+// - le folosesc modulele de pe CPU care se compileaza si in testele de Linux
+// - conversiile din tipurile engine-ului sunt in clasele respective (ex. Matrix4::GetFloat4x4)
+///////////////////////////////////////////////
+using Float3 = std::array<float, 3>;
+using Float4 = std::array<float, 4>;
+
+// Aceeasi conventie ca XMFLOAT4X4: vectori linie, punctul transformat este [x y z 1] * M
+struct Float4x4
+{
+	float m[4][4];
+};
+
+// Cutie aliniata pe axe
+struct BoxBounds
+{
+	Float3 min;
+	Float3 max;
+};
+
+// Planele unui frustum (a, b, c, d), cu normala normalizata spre interior: punctul p e in interior daca
+// a * x + b * y + c * z + d >= 0 pentru toate planele. Ordinea e cea din Frustum: near, far, right, left, upper, bottom
+using FrustumPlanes = std::array<Float4, 6>;
+
+inline Float4 TransformPoint(const Float4x4& matrix, const Float3& point)
+{
+	Float4 result;
+	for (int c = 0; c < 4; c++)
+	{
+		result[c] = point[0] * matrix.m[0][c] + point[1] * matrix.m[1][c] + point[2] * matrix.m[2][c] + matrix.m[3][c];
+	}
+
+	return result;
+}
+
+inline Float4x4 Multiply(const Float4x4& a, const Float4x4& b)
+{
+	Float4x4 result = {};
+	for (int r = 0; r < 4; r++)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			for (int k = 0; k < 4; k++)
+				result.m[r][c] += a.m[r][k] * b.m[k][c];
+		}
+	}
+
+	return result;
+}
+
+// Inversa prin complementi algebrici; intoarce false pentru o matrice singulara
+bool Invert(const Float4x4& matrix, Float4x4& inverse);
+
+}  // namespace engine::math
@@ -13,7 +13,14 @@ class Frustum
 	bool IntersectBoundingBox(const AABB& aabb) const;
 	Frustum GetTransformedFrustum(const Matrix4& viewMatrix) const;
 
+	// Frustum in world space extras direct din matricea view * proiectie (merge si pentru proiectii ortografice)
+	static Frustum FromViewProjMatrix(const Matrix4& viewProjMatrix);
+
+	// Pentru modulele care nu depind de DirectXMath
+	FrustumPlanes GetPlanes() const;
+
 	BoundingPlane& GetBoundingPlane(size_t index);
+	const BoundingPlane& GetBoundingPlane(size_t index) const;
 	engine::math::Point3& GetCorner(size_t index);
 
 private:
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "FloatTypes.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace engine::math
+{
+
+////////////////////////////////////////////////
+// Loose octree pentru obiectele dinamice ale scenei
+// - fiecare nod are o cutie "larga" de looseness ori marimea celulei, deci un obiect ajunge direct in nodul
+//   dat de marimea si centrul lui (O(maxDepth) la inserare, fara sa coboare prin testari)
+// - Update muta obiectul doar cand nu mai incape in cutia larga a nodului curent
+// - obiectele cu centrul in afara lumii stau intr-o lista separata, testata la fiecare interogare
+// - nodurile goale raman alocate, dar interogarile sar peste subarborii fara obiecte
+// - interogarile intorc userData, in ordine nespecificata
+// - nu depinde de DirectXMath: cutiile, planele si punctele vin ca tipuri simple (FloatTypes.hpp)
+///////////////////////////////////////////////
+class LooseOctree
+{
+public:
+	using Handle = uint32_t;
+	static constexpr Handle InvalidHandle = UINT32_MAX;
+
+	// worldBounds - cubul radacinii (se foloseste latura cea mai mare); looseness in (1, 2]
+	LooseOctree(const BoxBounds& worldBounds, uint32_t maxDepth = 6, float looseness = 2.f);
+
+	Handle Insert(const BoxBounds& bounds, uint32_t userData);
+	void Update(Handle handle, const BoxBounds& bounds);
+	void Remove(Handle handle);
+	void Clear();
+
+	void QueryFrustum(const FrustumPlanes& planes, std::vector<uint32_t>& result) const;
+	void QueryBox(const BoxBounds& box, std::vector<uint32_t>& result) const;
+	void QuerySphere(const Float3& center, float radius, std::vector<uint32_t>& result) const;
+	// Segmentul origin + t * direction, t in [0, maxDistance]; direction nu trebuie sa fie normalizata
+	void QueryRay(
+		const Float3& origin, const Float3& direction, float maxDistance, std::vector<uint32_t>& result) const;
+
+	inline uint32_t GetUserData(Handle handle) const { return m_items[handle].userData; }
+	inline uint32_t GetObjectCount() const { return m_objectCount; }
+	inline uint32_t GetNodeCount() const { return (uint32_t)m_nodes.size(); }
+
+private:
+	struct Item
+	{
+		BoxBounds bounds;
+		uint32_t userData;
+
+		// Nodul curent (-1 - lista din afara lumii, -2 - slot liber) si pozitia in lista lui
+		int32_t node;
+		uint32_t slot;
+	};
+
+	struct Node
+	{
+		std::array<float, 3> center;
+		float halfSize;
+		float looseHalfSize;
+
+		uint32_t depth;
+		std::array<int32_t, 8> children;
+
+		std::vector<Handle> items;
+		uint32_t subtreeItemCount;
+	};
+
+	static constexpr int32_t OutsideNode = -1;
+	static constexpr int32_t FreeNode = -2;
+
+	inline BoxBounds GetLooseBox(const Node& node) const;
+
+	// Nodul in care trebuie sa stea o cutie (creat la nevoie); OutsideNode daca centrul e in afara lumii
+	int32_t FindNode(const BoxBounds& bounds);
+	int32_t CreateChild(int32_t parent, uint32_t childIndex);
+
+	void Link(Handle handle, int32_t node);
+	void Unlink(Handle handle);
+	void AddSubtreeCount(int32_t node, int32_t delta);
+
+	void CollectSubtree(int32_t node, std::vector<uint32_t>& result) const;
+
+	template <class BoxTest>
+	void QueryNodes(int32_t node, const BoxTest& test, std::vector<uint32_t>& result) const;
+
+	std::vector<Node> m_nodes;
+	std::vector<Item> m_items;
+	std::vector<Handle> m_freeItems;
+	std::vector<Handle> m_outsideItems;
+
+	// Parintele fiecarui nod, pentru actualizarea numarului de obiecte din subarbori
+	std::vector<int32_t> m_parents;
+
+	uint32_t m_maxDepth;
+	float m_looseness;
+	uint32_t m_objectCount;
+};
+
+}  // namespace engine::math
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include "FloatTypes.hpp"
 #include "Matrix3.hpp"
 
 namespace engine::math
@@ -87,6 +88,14 @@ __declspec(align(16)) class Matrix4
 		return mat;
 	}
 
+	// Pentru modulele care nu depind de DirectXMath (aceeasi asezare in memorie ca XMFLOAT4X4)
+	INLINE Float4x4 GetFloat4x4() const
+	{
+		Float4x4 mat;
+		XMStoreFloat4x4(reinterpret_cast<XMFLOAT4X4*>(&mat), m_mat);
+		return mat;
+	}
+
 	INLINE Vector4 operator*(Vector3 vec) const { return Vector4(XMVector3Transform(vec, m_mat)); }
 	INLINE Vector4 operator*(Vector4 vec) const { return Vector4(XMVector4Transform(vec, m_mat)); }
 	INLINE Matrix4 operator*(const Matrix4& mat) const { return Matrix4(XMMatrixMultiply(m_mat, mat)); }
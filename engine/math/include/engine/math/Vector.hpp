@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Common.hpp"
+#include "FloatTypes.hpp"
 #include "Scalar.hpp"
 
 #include <string>
@@ -41,6 +42,9 @@ __declspec(align(16)) class Vector3
 		return v;
 	}
 
+	// Pentru modulele care nu depind de DirectXMath
+	INLINE Float3 GetFloat3() const { return {(float)GetX(), (float)GetY(), (float)GetZ()}; }
+
 	INLINE Scalar GetX() const { return Scalar(XMVectorSplatX(m_vec)); }
 	INLINE Scalar GetY() const { return Scalar(XMVectorSplatY(m_vec)); }
 	INLINE Scalar GetZ() const { return Scalar(XMVectorSplatZ(m_vec)); }
@@ -35,11 +35,79 @@ Frustum engine::math::Frustum::GetTransformedFrustum(const Matrix4& invViewMatri
 	return result;
 }
 
+Frustum engine::math::Frustum::FromViewProjMatrix(const Matrix4& viewProjMatrix)
+{
+	Frustum result;
+
+	// Conventia cu vectori linie: planele se obtin din coloanele matricei (Gribb - Hartmann)
+	DirectX::XMFLOAT4X4 m;
+	DirectX::XMStoreFloat4x4(&m, viewProjMatrix);
+
+	const auto column = [&m](int c) { return DirectX::XMVectorSet(m.m[0][c], m.m[1][c], m.m[2][c], m.m[3][c]); };
+
+	const DirectX::XMVECTOR c0 = column(0);
+	const DirectX::XMVECTOR c1 = column(1);
+	const DirectX::XMVECTOR c2 = column(2);
+	const DirectX::XMVECTOR c3 = column(3);
+
+	// Aceeasi ordine ca in PerspectiveCamera::ConstructFrustum: near, far, right, left, upper, bottom
+	const DirectX::XMVECTOR planes[6] = {
+		c2,
+		DirectX::XMVectorSubtract(c3, c2),
+		DirectX::XMVectorSubtract(c3, c0),
+		DirectX::XMVectorAdd(c3, c0),
+		DirectX::XMVectorSubtract(c3, c1),
+		DirectX::XMVectorAdd(c3, c1)};
+
+	for (int i = 0; i < 6; ++i)
+	{
+		// Normala spre interior; se normalizeaza si distanta, nu doar normala
+		const float length = DirectX::XMVectorGetX(DirectX::XMVector3Length(planes[i]));
+		const DirectX::XMVECTOR plane = DirectX::XMVectorScale(planes[i], 1.f / length);
+
+		result.m_frustumPlanes[i] = BoundingPlane(Vector3(plane), Scalar(DirectX::XMVectorGetW(plane)));
+	}
+
+	// Colturile: aceeasi numerotare ca in ConstructFrustum (0 - 3 near, 4 - 7 far)
+	const Matrix4 invViewProjMatrix = Matrix4::Inverse(viewProjMatrix);
+	const float cornerX[4] = {1.f, -1.f, -1.f, 1.f};
+	const float cornerY[4] = {-1.f, -1.f, 1.f, 1.f};
+
+	for (int i = 0; i < 8; ++i)
+	{
+		const DirectX::XMVECTOR ndc = DirectX::XMVectorSet(cornerX[i % 4], cornerY[i % 4], i < 4 ? 0.f : 1.f, 1.f);
+		result.m_frustumCorners[i] = Point3(DirectX::XMVector3TransformCoord(ndc, invViewProjMatrix));
+	}
+
+	return result;
+}
+
+FrustumPlanes Frustum::GetPlanes() const
+{
+	FrustumPlanes planes;
+	for (int i = 0; i < 6; ++i)
+	{
+		const Vector3 normal = m_frustumPlanes[i].GetNormal();
+		planes[i] = {
+			(float)normal.GetX(),
+			(float)normal.GetY(),
+			(float)normal.GetZ(),
+			(float)m_frustumPlanes[i].GetDistanceFromOrigin()};
+	}
+
+	return planes;
+}
+
 BoundingPlane& Frustum::GetBoundingPlane(size_t index)
 {
 	return m_frustumPlanes[index];
 }
 
+const BoundingPlane& Frustum::GetBoundingPlane(size_t index) const
+{
+	return m_frustumPlanes[index];
+}
+
 engine::math::Point3& Frustum::GetCorner(size_t index)
 {
 	return m_frustumCorners[index];
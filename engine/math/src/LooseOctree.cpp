@@ -0,0 +1,438 @@
+#include "LooseOctree.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace engine::math
+{
+
+namespace
+{
+
+enum class Overlap
+{
+	Outside,
+	Intersects,
+	Inside
+};
+
+}  // namespace
+
+LooseOctree::LooseOctree(const BoxBounds& worldBounds, uint32_t maxDepth, float looseness)
+	: m_maxDepth(maxDepth), m_looseness(looseness), m_objectCount(0)
+{
+	assert(looseness > 1.f && looseness <= 2.f);
+
+	Node root = {};
+	root.halfSize = 0.f;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		root.center[axis] = (worldBounds.min[axis] + worldBounds.max[axis]) / 2.f;
+		root.halfSize = std::max(root.halfSize, (worldBounds.max[axis] - worldBounds.min[axis]) / 2.f);
+	}
+	root.looseHalfSize = root.halfSize * m_looseness;
+	root.depth = 0;
+	root.children.fill(-1);
+	root.subtreeItemCount = 0;
+
+	m_nodes.push_back(root);
+	m_parents.push_back(-1);
+}
+
+inline BoxBounds LooseOctree::GetLooseBox(const Node& node) const
+{
+	BoxBounds box;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		box.min[axis] = node.center[axis] - node.looseHalfSize;
+		box.max[axis] = node.center[axis] + node.looseHalfSize;
+	}
+
+	return box;
+}
+
+int32_t LooseOctree::CreateChild(int32_t parent, uint32_t childIndex)
+{
+	const Node& parentNode = m_nodes[parent];
+
+	Node child = {};
+	child.halfSize = parentNode.halfSize / 2.f;
+	child.looseHalfSize = child.halfSize * m_looseness;
+	child.depth = parentNode.depth + 1;
+	child.children.fill(-1);
+	child.subtreeItemCount = 0;
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		const float sign = (childIndex >> axis) & 1 ? 1.f : -1.f;
+		child.center[axis] = parentNode.center[axis] + sign * child.halfSize;
+	}
+
+	const int32_t childNode = (int32_t)m_nodes.size();
+	m_nodes.push_back(child);
+	m_parents.push_back(parent);
+	m_nodes[parent].children[childIndex] = childNode;
+
+	return childNode;
+}
+
+int32_t LooseOctree::FindNode(const BoxBounds& bounds)
+{
+	const Node& root = m_nodes[0];
+
+	std::array<float, 3> center;
+	float halfExtent = 0.f;
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		center[axis] = (bounds.min[axis] + bounds.max[axis]) / 2.f;
+		halfExtent = std::max(halfExtent, (bounds.max[axis] - bounds.min[axis]) / 2.f);
+
+		if (std::abs(center[axis] - root.center[axis]) > root.halfSize)
+			return OutsideNode;
+	}
+
+	// Cel mai adanc nivel la care cutia incape in cutia larga a celulei care ii contine centrul
+	uint32_t targetDepth = 0;
+	float cellHalfSize = root.halfSize;
+
+	while (targetDepth < m_maxDepth && halfExtent <= (m_looseness - 1.f) * cellHalfSize / 2.f)
+	{
+		targetDepth++;
+		cellHalfSize /= 2.f;
+	}
+
+	int32_t node = 0;
+	while (m_nodes[node].depth < targetDepth)
+	{
+		uint32_t childIndex = 0;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (center[axis] >= m_nodes[node].center[axis])
+				childIndex |= 1u << axis;
+		}
+
+		const int32_t child = m_nodes[node].children[childIndex];
+		node = child >= 0 ? child : CreateChild(node, childIndex);
+	}
+
+	return node;
+}
+
+void LooseOctree::AddSubtreeCount(int32_t node, int32_t delta)
+{
+	for (; node >= 0; node = m_parents[node])
+	{
+		m_nodes[node].subtreeItemCount += delta;
+	}
+}
+
+void LooseOctree::Link(Handle handle, int32_t node)
+{
+	Item& item = m_items[handle];
+	item.node = node;
+
+	if (node == OutsideNode)
+	{
+		item.slot = (uint32_t)m_outsideItems.size();
+		m_outsideItems.push_back(handle);
+		return;
+	}
+
+	item.slot = (uint32_t)m_nodes[node].items.size();
+	m_nodes[node].items.push_back(handle);
+	AddSubtreeCount(node, 1);
+}
+
+void LooseOctree::Unlink(Handle handle)
+{
+	Item& item = m_items[handle];
+	std::vector<Handle>& items = item.node == OutsideNode ? m_outsideItems : m_nodes[item.node].items;
+
+	// Stergere prin inlocuire cu ultimul element din lista nodului
+	const Handle last = items.back();
+	items[item.slot] = last;
+	m_items[last].slot = item.slot;
+	items.pop_back();
+
+	if (item.node != OutsideNode)
+		AddSubtreeCount(item.node, -1);
+
+	item.node = FreeNode;
+}
+
+LooseOctree::Handle LooseOctree::Insert(const BoxBounds& bounds, uint32_t userData)
+{
+	Handle handle;
+	if (!m_freeItems.empty())
+	{
+		handle = m_freeItems.back();
+		m_freeItems.pop_back();
+	}
+	else
+	{
+		handle = (Handle)m_items.size();
+		m_items.emplace_back();
+	}
+
+	Item& item = m_items[handle];
+	item.bounds = bounds;
+	item.userData = userData;
+
+	Link(handle, FindNode(item.bounds));
+	m_objectCount++;
+
+	return handle;
+}
+
+void LooseOctree::Update(Handle handle, const BoxBounds& bounds)
+{
+	assert(handle < m_items.size() && m_items[handle].node != FreeNode);
+
+	Item& item = m_items[handle];
+	item.bounds = bounds;
+
+	// Cat timp incape in cutia larga a nodului curent obiectul nu se muta
+	if (item.node >= 0)
+	{
+		const BoxBounds loose = GetLooseBox(m_nodes[item.node]);
+		bool fits = true;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			fits &= item.bounds.min[axis] >= loose.min[axis] && item.bounds.max[axis] <= loose.max[axis];
+		}
+
+		if (fits)
+			return;
+	}
+
+	const int32_t node = FindNode(item.bounds);
+	if (node == item.node)
+		return;
+
+	Unlink(handle);
+	Link(handle, node);
+}
+
+void LooseOctree::Remove(Handle handle)
+{
+	assert(handle < m_items.size() && m_items[handle].node != FreeNode);
+
+	Unlink(handle);
+	m_freeItems.push_back(handle);
+	m_objectCount--;
+}
+
+void LooseOctree::Clear()
+{
+	Node root = m_nodes[0];
+	root.children.fill(-1);
+	root.items.clear();
+	root.subtreeItemCount = 0;
+
+	m_nodes.assign(1, root);
+	m_parents.assign(1, -1);
+	m_items.clear();
+	m_freeItems.clear();
+	m_outsideItems.clear();
+	m_objectCount = 0;
+}
+
+void LooseOctree::CollectSubtree(int32_t node, std::vector<uint32_t>& result) const
+{
+	const Node& current = m_nodes[node];
+
+	for (const Handle handle : current.items)
+	{
+		result.push_back(m_items[handle].userData);
+	}
+
+	for (const int32_t child : current.children)
+	{
+		if (child >= 0 && m_nodes[child].subtreeItemCount > 0)
+			CollectSubtree(child, result);
+	}
+}
+
+template <class BoxTest>
+void LooseOctree::QueryNodes(int32_t node, const BoxTest& test, std::vector<uint32_t>& result) const
+{
+	const Node& current = m_nodes[node];
+
+	if (current.subtreeItemCount == 0)
+		return;
+
+	// Radacina nu se testeaza: obiectele prea mari pentru cutia ei larga tot aici ajung
+	if (node != 0)
+	{
+		const Overlap overlap = test(GetLooseBox(current));
+
+		if (overlap == Overlap::Outside)
+			return;
+
+		if (overlap == Overlap::Inside)
+		{
+			CollectSubtree(node, result);
+			return;
+		}
+	}
+
+	for (const Handle handle : current.items)
+	{
+		if (test(m_items[handle].bounds) != Overlap::Outside)
+			result.push_back(m_items[handle].userData);
+	}
+
+	for (const int32_t child : current.children)
+	{
+		if (child >= 0)
+			QueryNodes(child, test, result);
+	}
+}
+
+void LooseOctree::QueryFrustum(const FrustumPlanes& planes, std::vector<uint32_t>& result) const
+{
+	const auto test = [&planes](const BoxBounds& box) -> Overlap
+	{
+		Overlap overlap = Overlap::Inside;
+
+		for (const auto& plane : planes)
+		{
+			// Coltul cel mai departat in directia normalei si cel opus
+			float farDistance = plane[3];
+			float nearDistance = plane[3];
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+				farDistance += plane[axis] * (plane[axis] > 0.f ? box.max[axis] : box.min[axis]);
+				nearDistance += plane[axis] * (plane[axis] > 0.f ? box.min[axis] : box.max[axis]);
+			}
+
+			if (farDistance < 0.f)
+				return Overlap::Outside;
+
+			if (nearDistance < 0.f)
+				overlap = Overlap::Intersects;
+		}
+
+		return overlap;
+	};
+
+	QueryNodes(0, test, result);
+
+	for (const Handle handle : m_outsideItems)
+	{
+		if (test(m_items[handle].bounds) != Overlap::Outside)
+			result.push_back(m_items[handle].userData);
+	}
+}
+
+void LooseOctree::QueryBox(const BoxBounds& query, std::vector<uint32_t>& result) const
+{
+	const auto test = [&query](const BoxBounds& other) -> Overlap
+	{
+		bool inside = true;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (other.max[axis] < query.min[axis] || other.min[axis] > query.max[axis])
+				return Overlap::Outside;
+
+			inside &= other.min[axis] >= query.min[axis] && other.max[axis] <= query.max[axis];
+		}
+
+		return inside ? Overlap::Inside : Overlap::Intersects;
+	};
+
+	QueryNodes(0, test, result);
+
+	for (const Handle handle : m_outsideItems)
+	{
+		if (test(m_items[handle].bounds) != Overlap::Outside)
+			result.push_back(m_items[handle].userData);
+	}
+}
+
+void LooseOctree::QuerySphere(const Float3& center, float radius, std::vector<uint32_t>& result) const
+{
+	const float radius2 = radius * radius;
+
+	const auto test = [&center, radius2](const BoxBounds& box) -> Overlap
+	{
+		// Distanta pana la cel mai apropiat si cel mai departat punct al cutiei
+		float nearDistance2 = 0.f;
+		float farDistance2 = 0.f;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			const float closest = std::clamp(center[axis], box.min[axis], box.max[axis]);
+			const float farthest =
+				std::max(std::abs(center[axis] - box.min[axis]), std::abs(center[axis] - box.max[axis]));
+
+			nearDistance2 += (center[axis] - closest) * (center[axis] - closest);
+			farDistance2 += farthest * farthest;
+		}
+
+		if (nearDistance2 > radius2)
+			return Overlap::Outside;
+
+		return farDistance2 <= radius2 ? Overlap::Inside : Overlap::Intersects;
+	};
+
+	QueryNodes(0, test, result);
+
+	for (const Handle handle : m_outsideItems)
+	{
+		if (test(m_items[handle].bounds) != Overlap::Outside)
+			result.push_back(m_items[handle].userData);
+	}
+}
+
+void LooseOctree::QueryRay(
+	const Float3& origin, const Float3& direction, float maxDistance, std::vector<uint32_t>& result) const
+{
+	const auto test = [&origin, &direction, maxDistance](const BoxBounds& box) -> Overlap
+	{
+		// Metoda slab-urilor pe segmentul [0, maxDistance]
+		float tMin = 0.f;
+		float tMax = maxDistance;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (direction[axis] == 0.f)
+			{
+				if (origin[axis] < box.min[axis] || origin[axis] > box.max[axis])
+					return Overlap::Outside;
+
+				continue;
+			}
+
+			const float inverse = 1.f / direction[axis];
+			float t0 = (box.min[axis] - origin[axis]) * inverse;
+			float t1 = (box.max[axis] - origin[axis]) * inverse;
+			if (t0 > t1)
+				std::swap(t0, t1);
+
+			tMin = std::max(tMin, t0);
+			tMax = std::min(tMax, t1);
+
+			if (tMin > tMax)
+				return Overlap::Outside;
+		}
+
+		return Overlap::Intersects;
+	};
+
+	QueryNodes(0, test, result);
+
+	for (const Handle handle : m_outsideItems)
+	{
+		if (test(m_items[handle].bounds) != Overlap::Outside)
+			result.push_back(m_items[handle].userData);
+	}
+}
+
+}  // namespace engine::math
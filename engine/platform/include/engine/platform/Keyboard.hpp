@@ -1,6 +1,7 @@
 #pragma once
+#include "engine/core/FixedQueue.hpp"
+
 #include <bitset>
-#include <queue>
 #include <optional>
 
 namespace engine::platform
@@ -55,8 +56,6 @@ class Keyboard
 	void OnKeyReleased(unsigned char keycode);
 	void OnChar(char character);
 	void ClearState();
-	template <typename T>
-	void TrimBuffer(std::queue<T>& buffer);
 
 private:
 	static constexpr unsigned int nKeys = 256u;
@@ -66,7 +65,8 @@ class Keyboard
 	
 	std::bitset<nKeys> keystates;
 	
-	std::queue<Event> keybuffer;
-	std::queue<char> charbuffer;
+	// Cand se umplu, se pierd evenimentele cele mai vechi
+	engine::core::FixedQueue<Event, bufferSize> keybuffer;
+	engine::core::FixedQueue<char, bufferSize> charbuffer;
 };
 }  // namespace engine::platform
\ No newline at end of file
@@ -1,7 +1,8 @@
 #pragma once
 
+#include "engine/core/FixedQueue.hpp"
+
 #include <optional>
-#include <queue>
 
 namespace engine::platform
 {
@@ -81,7 +82,7 @@ class Mouse
 	bool LeftIsPressed() const noexcept;
 	bool RightIsPressed() const noexcept;
 	std::optional<Mouse::Event> Read() noexcept;
-	bool IsEmpty() const noexcept { return buffer.empty(); }
+	bool IsEmpty() const noexcept { return buffer.IsEmpty(); }
 	void Flush() noexcept;
 	void EnableRaw() noexcept;
 	void DisableRaw() noexcept;
@@ -101,8 +102,6 @@ class Mouse
 	void OnRightReleased(int x, int y) noexcept;
 	void OnWheelUp(int x, int y) noexcept;
 	void OnWheelDown(int x, int y) noexcept;
-	void TrimBuffer() noexcept;
-	void TrimRawInputBuffer() noexcept;
 	void OnWheelDelta(int x, int y, int delta) noexcept;
 
 private:
@@ -118,8 +117,9 @@ class Mouse
 	bool isInWindow = false;
 	int wheelDeltaCarry = 0;
 	bool rawEnabled = false;
-	std::queue<Event> buffer;
-	std::queue<RawDelta> rawDeltaBuffer;
+	// Cand se umplu, se pierd evenimentele cele mai vechi
+	engine::core::FixedQueue<Event, bufferSize> buffer;
+	engine::core::FixedQueue<RawDelta, bufferSize> rawDeltaBuffer;
 };
 
 }  // namespace engine::platform
\ No newline at end of file
@@ -62,7 +62,8 @@ class Window
 
 public:
 	Window() = delete;
-	Window(int width, int height, const wchar_t* name);
+	// visible = false: fereastra exista doar pentru swap chain (rulare fara interfata)
+	Window(int width, int height, const wchar_t* name, bool visible = true);
 	~Window();
 
 	Window(const Window&) = delete;
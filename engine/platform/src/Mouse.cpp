@@ -12,12 +12,12 @@ std::pair<int, int> Mouse::GetPos() const noexcept
 
 std::optional<Mouse::RawDelta> Mouse::ReadRawDelta() noexcept
 {
-	if (rawDeltaBuffer.empty())
+	if (rawDeltaBuffer.IsEmpty())
 	{
 		return std::nullopt;
 	}
-	const RawDelta d = rawDeltaBuffer.front();
-	rawDeltaBuffer.pop();
+	const RawDelta d = rawDeltaBuffer.Front();
+	rawDeltaBuffer.Pop();
 	return d;
 }
 
@@ -48,10 +48,10 @@ bool Mouse::RightIsPressed() const noexcept
 
 std::optional<Mouse::Event> Mouse::Read() noexcept
 {
-	if (buffer.size() > 0u)
+	if (!buffer.IsEmpty())
 	{
-		Mouse::Event e = buffer.front();
-		buffer.pop();
+		Mouse::Event e = buffer.Front();
+		buffer.Pop();
 		return e;
 	}
 	return {};
@@ -59,7 +59,7 @@ std::optional<Mouse::Event> Mouse::Read() noexcept
 
 void Mouse::Flush() noexcept
 {
-	buffer = std::queue<Event>();
+	buffer.Clear();
 }
 
 void Mouse::EnableRaw() noexcept
@@ -85,88 +85,62 @@ void Mouse::OnMouseMove(int newx, int newy) noexcept
 	x = newx;
 	y = newy;
 
-	buffer.push(Mouse::Event(Mouse::Event::Type::Move, *this));
-	TrimBuffer();
+	buffer.Push(Mouse::Event(Mouse::Event::Type::Move, *this));
 }
 
 void Mouse::OnMouseLeave() noexcept
 {
 	isInWindow = false;
-	buffer.push(Mouse::Event(Mouse::Event::Type::Leave, *this));
-	TrimBuffer();
+	buffer.Push(Mouse::Event(Mouse::Event::Type::Leave, *this));
 }
 
 void Mouse::OnMouseEnter() noexcept
 {
 	isInWindow = true;
-	buffer.push(Mouse::Event(Mouse::Event::Type::Enter, *this));
-	TrimBuffer();
+	buffer.Push(Mouse::Event(Mouse::Event::Type::Enter, *this));
 }
 
 void Mouse::OnRawDelta(int dx, int dy) noexcept
 {
-	rawDeltaBuffer.push({dx, dy});
-	TrimBuffer();
+	rawDeltaBuffer.Push({dx, dy});
 }
 
 void Mouse::OnLeftPressed(int x, int y) noexcept
 {
 	leftIsPressed = true;
 
-	buffer.push(Mouse::Event(Mouse::Event::Type::LPress, *this));
-	TrimBuffer();
+	buffer.Push(Mouse::Event(Mouse::Event::Type::LPress, *this));
 }
 
 void Mouse::OnLeftReleased(int x, int y) noexcept
 {
 	leftIsPressed = false;
 
-	buffer.push(Mouse::Event(Mouse::Event::Type::LRelease, *this));
-	TrimBuffer();
+	buffer.Push(Mouse::Event(Mouse::Event::Type::LRelease, *this));
 }
 
 void Mouse::OnRightPressed(int x, int y) noexcept
 {
 	rightIsPressed = true;
 
-	buffer.push(Mouse::Event(Mouse::Event::Type::RPress, *this));
-	TrimBuffer();
+	buffer.Push(Mouse::Event(Mouse::Event::Type::RPress, *this));
 }
 
 void Mouse::OnRightReleased(int x, int y) noexcept
 {
 	rightIsPressed = false;
 
-	buffer.push(Mouse::Event(Mouse::Event::Type::RRelease, *this));
-	TrimBuffer();
+	buffer.Push(Mouse::Event(Mouse::Event::Type::RRelease, *this));
 }
 
 void Mouse::OnWheelUp(int x, int y) noexcept
 {
-	buffer.push(Mouse::Event(Mouse::Event::Type::WheelUp, *this));
-	TrimBuffer();
+	buffer.Push(Mouse::Event(Mouse::Event::Type::WheelUp, *this));
 }
 
 void Mouse::OnWheelDown(int x, int y) noexcept
 {
-	buffer.push(Mouse::Event(Mouse::Event::Type::WheelDown, *this));
-	TrimBuffer();
-}
-
-void Mouse::TrimBuffer() noexcept
-{
-	while (buffer.size() > bufferSize)
-	{
-		buffer.pop();
-	}
-}
-
-void Mouse::TrimRawInputBuffer() noexcept
-{
-	while (rawDeltaBuffer.size() > bufferSize)
-	{
-		rawDeltaBuffer.pop();
-	}
+	buffer.Push(Mouse::Event(Mouse::Event::Type::WheelDown, *this));
 }
 
 void Mouse::OnWheelDelta(int x, int y, int delta) noexcept
@@ -51,7 +51,7 @@ WindowClass::~WindowClass()
 	UnregisterClass(wndClassName, hInstance);
 }
 
-Window::Window(int width, int height, const wchar_t* name) : width(width), height(height)
+Window::Window(int width, int height, const wchar_t* name, bool visible) : width(width), height(height)
 {
 	engine::core::Settings::GetGraphicsSettings().SetWidth(width);
 	engine::core::Settings::GetGraphicsSettings().SetHeight(height);
@@ -90,7 +90,7 @@ Window::Window(int width, int height, const wchar_t* name) : width(width), heigh
 
 	engine::gfx::GraphicsResources::GetInstance().LoadResources(hWnd);
 
-	ShowWindow(hWnd, SW_SHOWDEFAULT);
+	ShowWindow(hWnd, visible ? SW_SHOWDEFAULT : SW_HIDE);
 }
 
 Window::~Window()
@@ -56,28 +56,15 @@ void CHS_TriangleGeometry(inout RayPayload payload, in BuiltInTriangleIntersecti
     const float3 bitangent = normalize(cross(input.Tangent, input.Normal));
     const float3x3 TBNMatrix = float3x3(input.Tangent, bitangent, input.Normal); 
 
+    const float2 splatC = input.TextureC;
     input.TextureC = mul(float4(input.TextureC, 0.0f, 1.0f), objectCB.textureTransform).xy;
  
+    // Straturile si factorul de interpolare vin din harta de splat calculata pe CPU
     int textureIndex = 0;
     float lerpFactor = 0.0f;
 
-    float heights[5] = { -10, 0, 15, 20, 300 };
-    
-    heights[2] += 15 * NoiseFunction(input.Position.x, input.Position.z);
-    heights[3] += 40 * NoiseFunction(input.Position.x, input.Position.z);
-
-    for (int i = 0; i < 4; ++i)
-    {
-        if (input.Position.y >= heights[i] && input.Position.y < heights[i + 1])
-        {
-            float range = heights[i + 1] - heights[i];
-            lerpFactor = (input.Position.y - heights[i]) / range;
-            
-            textureIndex = i;
-
-            break;
-        }
-    }
+    const float4 splat = terrainSplat.SampleLevel(gsamLinearClamp, splatC, 0);
+    DecodeTerrainSplat(splat.r, splat.g, splat.b, splat.a, textureIndex, lerpFactor);
 
     const float4 texDiffuseAlbedo1 
         = terrainDiffuse.SampleLevel(gsamAnisotropicWrap, float3(input.TextureC, textureIndex), 0);
@@ -21,11 +21,11 @@ Texture2D normalTexture : register(t3, space0);
 
 ////////////////////////////////////////////////////////////////////////////////
 // Vertex shader
-VertexOut VSMain(VertexIn input)
+VertexOut VSMain(VertexIn input, uint instanceID : SV_InstanceID)
 {
-    float4 worldPos = mul(float4(input.Position, 1.0f), objectCB.worldMatrix);
+    float4 worldPos = mul(float4(input.Position, 1.0f), GetWorldMatrix(instanceID));
 
-    float3 worldNormal = mul(float4(input.Normal, 0.0f), transpose(objectCB.invWorldMatrix)).xyz;
+    float3 worldNormal = mul(float4(input.Normal, 0.0f), transpose(GetInvWorldMatrix(instanceID))).xyz;
     worldNormal = normalize(worldNormal);
 
     float4 color = float4(1.f, 1.f, 1.f, 1.f);
@@ -5,12 +5,24 @@
 #endif
 
 #include "../gfx/include/engine/gfx/HlslUtils.h"
+#include "../gfx/include/engine/gfx/TerrainSplat.h"
 
 //////////////////////////////////////////////////////////////////
 // Shader resorurces common to RT and RAST
 ConstantBuffer<PassConstantBuffer> passCB : register(b0, space0);
+
+// Datele bindless (BINDLESS): obiectul si materialul draw-ului se citesc din structured buffere, dupa drawCB
+#ifdef BINDLESS
+StructuredBuffer<ObjectConstantBuffer> objectData : register(t1, space3);
+StructuredBuffer<MaterialProperties> materialData : register(t2, space3);
+ConstantBuffer<DrawConstants> drawCB : register(b4, space0);
+
+#define objectCB objectData[drawCB.objectIndex]
+#define materialCB materialData[drawCB.materialIndex]
+#else
 ConstantBuffer<ObjectConstantBuffer> objectCB : register(b1, space0);
 ConstantBuffer<MaterialProperties> materialCB : register(b2, space0);
+#endif
 
 
 
@@ -171,8 +183,3 @@ float ComputeFogFactor(float startFogDistance, float endFogDistance, float dista
 {   
     return smoothstep(startFogDistance, endFogDistance, distance);
 }
-
-float NoiseFunction(float x, float z)
-{
-    return sin(x * 0.1) * cos(z * 0.1) * 0.5 + 0.5;
-}
\ No newline at end of file
@@ -22,10 +22,38 @@ TextureCube skyBox : register(t3, space0);
 
 Texture2DArray terrainDisp : register(t0, space1);
 Texture2D waterDisp : register(t1, space1);
+Texture2D terrainSplat : register(t2, space1);
+Texture2D terrainTessellationScale : register(t3, space1);
 
 TextureCube environmentalTexture : register(t0, space2);
 Texture2D shadowTexture : register(t1, space2);
 
+// Desenarea instantiata (INSTANCED): transformarile vin din bufferul de instante, nu din object CB
+#ifdef INSTANCED
+StructuredBuffer<InstanceData> instanceData : register(t0, space3);
+ConstantBuffer<InstanceConstants> instanceCB : register(b3, space0);
+
+float4x4 GetWorldMatrix(uint instanceID)
+{
+    return instanceData[instanceCB.instanceOffset + instanceID].worldMatrix;
+}
+
+float4x4 GetInvWorldMatrix(uint instanceID)
+{
+    return instanceData[instanceCB.instanceOffset + instanceID].invWorldMatrix;
+}
+#else
+float4x4 GetWorldMatrix(uint instanceID)
+{
+    return objectCB.worldMatrix;
+}
+
+float4x4 GetInvWorldMatrix(uint instanceID)
+{
+    return objectCB.invWorldMatrix;
+}
+#endif
+
 // Functie de calcul a poizitie valurilor
 float3 CalculateWavePosition(float3 pos)
 {
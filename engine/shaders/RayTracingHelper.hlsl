@@ -57,6 +57,7 @@ SamplerState gsamAnisotropicWrap : register(s4);
 SamplerState gsamAnisotropicClamp : register(s5);
 
 TextureCube skyboxTexture : register(t3, space1);
+Texture2D terrainSplat : register(t4, space1);
 
 ConstantBuffer<WaterConstantBuffer> waterCB : register(b3, space0);
 
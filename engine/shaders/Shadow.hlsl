@@ -12,11 +12,11 @@ struct VertexOut
 
 //////////////////////////////////////////////
 // Vertex shader
-VertexOut VSMain(VertexIn vin)
+VertexOut VSMain(VertexIn vin, uint instanceID : SV_InstanceID)
 {
     VertexOut vout;
 
-    const float4 worldPosition = mul(float4(vin.Position, 1.0f), objectCB.worldMatrix);
+    const float4 worldPosition = mul(float4(vin.Position, 1.0f), GetWorldMatrix(instanceID));
     vout.Position = mul(worldPosition, passCB.viewProjMatrix);
 	
     return vout;
@@ -14,6 +14,7 @@ struct VertexOut
     float3 Normal : Normal;
     float3 Tangent : Tangent;
     float2 TextureC : TextureC;
+    float2 SplatC : SplatC;
 };
 
 struct HullOut
@@ -22,6 +23,7 @@ struct HullOut
     float3 Normal : Normal;
     float3 Tangent : Tangent;
     float2 TextureC : TextureC;
+    float2 SplatC : SplatC;
 };
 
 struct PatchHullOut
@@ -36,6 +38,7 @@ struct DomainOut
     float3 WorldPosition : WorldPosition;
     float3x3 TBNMatrix : TBNMatrix;
     float2 TextureC : TextureC;
+    float2 SplatC : SplatC;
     float Depth : Depth;
 };
 
@@ -49,6 +52,7 @@ VertexOut VSMain(VertexIn input)
     vertexOut.Normal = input.Normal;
     vertexOut.Tangent = input.Tangent;
     vertexOut.TextureC = mul(float4(input.TextureC, 0.0f, 1.0f), objectCB.textureTransform).xy;
+    vertexOut.SplatC = input.TextureC;
     
     return vertexOut;
 }
@@ -66,33 +70,62 @@ DomainOut VSForCubeMapRendering(VertexIn input)
     pixelInput.Position = mul(float4(input.Position, 1.f), passCB.viewProjMatrix);
     pixelInput.Depth = mul(float4(input.Position, 1.f), passCB.viewMatrix).z;
     pixelInput.TextureC = mul(float4(input.TextureC, 0.0f, 1.0f), objectCB.textureTransform).xy;
+    pixelInput.SplatC = input.TextureC;
 
     return pixelInput;
 }
 
 //////////////////////////////////////////////////////////////////////////
 // Hull shader 
+float TessellationFactor(float3 position, float roughnessScale)
+{
+    const float distanceFromCamera = distance(position, passCB.eyePosition);
+    
+    const float d0 = passCB.nearZ;
+    const float d1 = 20.f;
+    
+    const float tess = MAX_TESSELATION_FACTOR * saturate((d1 - distanceFromCamera) / (d1 - d0)) * roughnessScale;
+    return clamp(tess, 1.f, MAX_TESSELATION_FACTOR);
+}
+
+// Factorul unei muchii depinde doar de capetele ei, ca cele doua patch-uri care o impart sa obtina aceeasi valoare
+// (altfel muchia se teseleaza diferit pe fiecare parte si apar crapaturi). Scalarea este maximul celor doua celule
+// de o parte si de alta a mijlocului muchiei; pentru diagonala unei celule ambele esantioane cad in aceeasi celula.
+float EdgeTessellationFactor(VertexOut a, VertexOut b)
+{
+    const float3 middle = (a.Position.xyz + b.Position.xyz) * 0.5f;
+    const float2 middleC = (a.SplatC + b.SplatC) * 0.5f;
+    
+    float width, height;
+    terrainTessellationScale.GetDimensions(width, height);
+    
+    const float2 edgeC = b.SplatC - a.SplatC;
+    const float2 normalC = normalize(float2(-edgeC.y, edgeC.x)) * 0.5f / float2(width, height);
+    
+    const float roughnessScale = max(
+        terrainTessellationScale.SampleLevel(gsamPointClamp, middleC + normalC, 0).r,
+        terrainTessellationScale.SampleLevel(gsamPointClamp, middleC - normalC, 0).r);
+    
+    return TessellationFactor(middle, roughnessScale);
+}
+
 PatchHullOut ConstantHS(
     InputPatch<VertexOut, 3> patch,
     uint patchId : SV_PrimitiveID)
 {
     PatchHullOut output;
     
-    float3 center = (patch[0].Position + patch[1].Position + patch[2].Position).xyz / 3.f;
-    
-    const float distanceFromCamera = distance(center, passCB.eyePosition);
+    // Muchia i este cea opusa varfului i
+    output.EdgeTess[0] = EdgeTessellationFactor(patch[1], patch[2]);
+    output.EdgeTess[1] = EdgeTessellationFactor(patch[2], patch[0]);
+    output.EdgeTess[2] = EdgeTessellationFactor(patch[0], patch[1]);
     
-    const float d0 = passCB.nearZ;
-    const float d1 = 20.f;
+    // Patch-urile plate primesc mai putina teselare in interior (scalare calculata pe CPU din rugozitatea terenului)
+    const float3 center = (patch[0].Position + patch[1].Position + patch[2].Position).xyz / 3.f;
+    const float2 patchC = (patch[0].SplatC + patch[1].SplatC + patch[2].SplatC) / 3.f;
+    const float roughnessScale = terrainTessellationScale.SampleLevel(gsamPointClamp, patchC, 0).r;
     
-    float tess = MAX_TESSELATION_FACTOR * saturate((d1 - distanceFromCamera) / (d1 - d0));
-    tess = clamp(tess, 1.f, MAX_TESSELATION_FACTOR);
-
-    output.EdgeTess[0] = tess;
-    output.EdgeTess[1] = tess;
-    output.EdgeTess[2] = tess;
-    
-    output.InsideTess[0] = tess;
+    output.InsideTess[0] = TessellationFactor(center, roughnessScale);
     
     return output;
 }
@@ -112,6 +145,7 @@ HullOut HSMain(InputPatch<VertexOut, 3> inputPatch,
     hullOut.Position = inputPatch[i].Position;
     hullOut.Normal = inputPatch[i].Normal;
     hullOut.TextureC = inputPatch[i].TextureC;
+    hullOut.SplatC = inputPatch[i].SplatC;
     hullOut.Tangent = inputPatch[i].Tangent;
     
     return hullOut;
@@ -133,6 +167,9 @@ DomainOut DSMain(
     domainOut.TextureC = barycentricCoord.x * tri[0].TextureC +
                          barycentricCoord.y * tri[1].TextureC +
                          barycentricCoord.z * tri[2].TextureC;
+    domainOut.SplatC = barycentricCoord.x * tri[0].SplatC +
+                       barycentricCoord.y * tri[1].SplatC +
+                       barycentricCoord.z * tri[2].SplatC;
 
     //=====================================================================
     // Calculare matrice TBN
@@ -152,18 +189,11 @@ DomainOut DSMain(
                            barycentricCoord.y * tri[1].Position +
                            barycentricCoord.z * tri[2].Position;
     
-    float heights[5] = { -10, 0, 15, 20, 300 };
-    heights[2] += 15 * NoiseFunction(worldPosition.x, worldPosition.z);
-    heights[3] += 40 * NoiseFunction(worldPosition.x, worldPosition.z);
     int textureIndex = 0;
-    for (int i = 0; i < 4; ++i)
-    {
-        if (worldPosition.y >= heights[i] && worldPosition.y < heights[i + 1])
-        {
-            textureIndex = i;
-            break;
-        }
-    }
+    float lerpFactor = 0.0f;
+    const float4 splat = terrainSplat.SampleLevel(gsamLinearClamp, domainOut.SplatC, 0);
+    DecodeTerrainSplat(splat.r, splat.g, splat.b, splat.a, textureIndex, lerpFactor);
+
     float4 displacement = terrainDisp.SampleLevel(gsamPointWrap, float3(domainOut.TextureC, textureIndex), 0);
     domainOut.WorldPosition = worldPosition.xyz + normal * displacement.r - normal;
 
@@ -221,25 +251,12 @@ float4 PSMain(DomainOut input) : SV_TARGET
 
     //===================================================================================
     // Calculam culoarea difuza a materialului in fucntie de inaltime
+    // Straturile si factorul de interpolare vin din harta de splat calculata pe CPU
     int textureIndex = 0;
     float lerpFactor = 0.0f;
 
-    float heights[5] = { -10, 0, 15, 20, 300 };
-    heights[2] += 15 * NoiseFunction(input.WorldPosition.x, input.WorldPosition.z);
-    heights[3] += 40 * NoiseFunction(input.WorldPosition.x, input.WorldPosition.z);
-
-    for (int i = 0; i < 4; ++i)
-    {
-        if (input.WorldPosition.y >= heights[i] && input.WorldPosition.y < heights[i + 1])
-        {
-            float range = heights[i + 1] - heights[i];
-            lerpFactor = (input.WorldPosition.y - heights[i]) / range;
-            
-            textureIndex = i;
-
-            break;
-        }
-    }
+    const float4 splat = terrainSplat.Sample(gsamLinearClamp, input.SplatC);
+    DecodeTerrainSplat(splat.r, splat.g, splat.b, splat.a, textureIndex, lerpFactor);
 
     const float4 texDisp1 = terrainDiffuse.Sample(gsamAnisotropicWrap, float3(input.TextureC, textureIndex));
     const float4 texDisp2 = terrainDiffuse.Sample(gsamAnisotropicWrap, float3(input.TextureC, textureIndex + 1));
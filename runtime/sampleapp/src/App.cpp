@@ -1,12 +1,18 @@
 #include "App.hpp"
 
+#include "engine/core/AllocationCounter.hpp"
+#include "engine/core/FrameArena.hpp"
 #include "engine/core/Utilities.hpp"
 #include "engine/core/Settings.hpp"
 #include "engine/platform/Window.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
 #include <sstream>
 
-App::App(engine::platform::Window& wnd) : window(wnd)
+App::App(engine::platform::Window& wnd, unsigned int headlessFrameCount)
+	: window(wnd), m_headlessFrameCount(headlessFrameCount)
 {
 	if (engine::core::Settings::UseRayTracing())
 	{
@@ -30,16 +36,108 @@ int App::Run()
 			return *msg;
 		}
 
+		// Memoria temporara a cadrului trecut se refoloseste
+		engine::core::FrameArena::SetBypass(IsArenaBypassFrame());
+		engine::core::FrameArena::BeginFrame();
+		m_frameCount++;
+
 		m_timer.UpdateDeltaTime();
+
+		const uint64_t allocationCount = engine::core::GetAllocationCount();
 		CalculateFrameStats();
 		Update();
+		CheckSteadyStateAllocations(allocationCount);
+
+		if (m_frameCount == m_headlessFrameCount)
+			return ReportHeadlessRun();
 	}
 }
 
+void App::CheckSteadyStateAllocations(uint64_t allocationCountBefore)
+{
+	if constexpr (!engine::core::AllocationCountingEnabled)
+		return;
+
+	if (m_warmUpFrames < WarmUpFrameCount)
+	{
+		m_warmUpFrames++;
+		return;
+	}
+
+	const uint64_t allocationCount = engine::core::GetAllocationCount() - allocationCountBefore;
+	const bool isBypassed = engine::core::FrameArena::IsBypassed();
+
+	AllocationStatistics& statistics = isBypassed ? m_bypassedAllocations : m_measuredAllocations;
+	statistics.frameCount++;
+	statistics.allocationCount += allocationCount;
+	statistics.maxFrameAllocationCount = std::max(statistics.maxFrameAllocationCount, allocationCount);
+
+	// Fara interfata nu se opreste la primul cadru care aloca: rezultatul se vede in rezumat
+	if (m_headlessFrameCount != 0)
+	{
+		std::printf(
+			"frame %u%s: %llu allocations\n",
+			m_frameCount,
+			isBypassed ? " (no arena)" : "",
+			(unsigned long long)allocationCount);
+		return;
+	}
+
+	if (allocationCount != 0)
+	{
+		engine::core::UncountedAllocationScope uncountedScope;
+		OutputDebugStringA(("Steady-state frame allocations: " + std::to_string(allocationCount) + "\n").c_str());
+	}
+
+	// Alocarile din cadru trec prin FrameVector sau prin memorie refolosita
+	assert(allocationCount == 0);
+}
+
+bool App::IsArenaBypassFrame() const
+{
+	if (!engine::core::AllocationCountingEnabled || m_headlessFrameCount <= WarmUpFrameCount)
+		return false;
+
+	const unsigned int bypassFrameCount = (m_headlessFrameCount - WarmUpFrameCount) / 2;
+	return m_warmUpFrames == WarmUpFrameCount && m_bypassedAllocations.frameCount < bypassFrameCount;
+}
+
+int App::ReportHeadlessRun() const
+{
+	if constexpr (!engine::core::AllocationCountingEnabled)
+	{
+		std::printf("%u frames rendered; allocations are counted only in Debug builds\n", m_frameCount);
+		return 0;
+	}
+
+	const auto printStatistics = [](const char* label, const AllocationStatistics& statistics)
+	{
+		const double averageAllocationCount =
+			statistics.frameCount != 0 ? (double)statistics.allocationCount / statistics.frameCount : 0.0;
+
+		std::printf(
+			"%-9s %6u frames: %.2f allocations per frame on average, %llu at most\n",
+			label,
+			statistics.frameCount,
+			averageAllocationCount,
+			(unsigned long long)statistics.maxFrameAllocationCount);
+	};
+
+	// Inainte: FrameVector aloca din heap; alocarile eliminate prin memorie refolosita raman eliminate in ambele
+	std::printf("%u frames, %u warm-up\n", m_frameCount, WarmUpFrameCount);
+	printStatistics("no arena", m_bypassedAllocations);
+	printStatistics("arena", m_measuredAllocations);
+
+	return m_measuredAllocations.allocationCount == 0 ? 0 : 1;
+}
+
 void App::Update()
 {
 	if (engine::gfx::GraphicsResources::GetInstance().GetSizeChnaged())
 	{
+		// Resursele recreate la redimensionare pot creste iar memoria refolosita
+		m_warmUpFrames = 0;
+
 		pGraphics->GetCameraController().RefreshCamera();
 		engine::gfx::GraphicsResources::GetInstance().SetSizeChnaged(false);
 	}
@@ -77,6 +175,9 @@ void App::Update()
 	const char ok = window.GetKeyboard().ReadChar();
 	if (ok == 'c')
 	{
+		// La cerere, nu in fiecare cadru
+		engine::core::UncountedAllocationScope uncountedScope;
+
 		std::stringstream text;
 		text << "===================================================="
 			 << "\n";
@@ -118,12 +219,20 @@ void App::CalculateFrameStats()
 
 	if ((m_timer.GetTimeSinceStart() - timeElapsed) >= 1.0f)
 	{
+		// O data pe secunda; nu intra in numaratoarea alocarilor din cadru
+		engine::core::UncountedAllocationScope uncountedScope;
+
 		float fps = (float)frameCnt;
 		float mspf = 1000.0f / fps;
 
 		wstring fpsStr = to_wstring(fps);
 		wstring mspfStr = to_wstring(mspf);
-		wstring windowText = L"fps: " + fpsStr + L" mspf: " + mspfStr;
+		// Apelurile de stare redundante sarite in ultimul cadru, in toate contextele lui
+		const engine::gfx::StateFilterStatistics& filterStatistics =
+			engine::gfx::GraphicsResources::GetContextManager().GetStateFilterStatistics();
+
+		wstring windowText = L"fps: " + fpsStr + L" mspf: " + mspfStr
+			+ L" filtered state calls: " + to_wstring(filterStatistics.GetTotal());
 
 		window.SetTitle(windowText.c_str());
 
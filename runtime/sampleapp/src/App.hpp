@@ -6,19 +6,47 @@
 #include "engine/gfx/RasterizationGraphics.hpp"
 #include "engine/gfx/RayTracingGraphics.hpp"
 
+#include <cstdint>
+
 class App
 {
 public:
-	App(engine::platform::Window& wnd);
+	// headlessFrameCount != 0: Run se opreste dupa atatea cadre si afiseaza alocarile din fiecare cadru
+	App(engine::platform::Window& wnd, unsigned int headlessFrameCount = 0);
 	int Run();
 
 private:
 	void CalculateFrameStats();
 	void Update();
+	// Doar in Debug: dupa incalzire, un cadru nu mai face alocari globale
+	void CheckSteadyStateAllocations(uint64_t allocationCountBefore);
+	// Fara interfata, prima jumatate a cadrelor de dupa incalzire ocoleste arena (FrameVector aloca din heap, ca
+	// inainte), ca rezumatul sa compare alocarile fara si cu arena
+	bool IsArenaBypassFrame() const;
+	// Rezumatul rularii fara interfata; codul de iesire e nenul daca un cadru cu arena a alocat
+	int ReportHeadlessRun() const;
 
 private:
 	engine::platform::Window& window;
 	engine::gfx::Graphics::Ptr pGraphics;
 
 	engine::core::TickTimer<float> m_timer;
+
+	// Cadre in care cozile si vectorii refolositi isi ating marimea (dupa pornire sau redimensionare)
+	static constexpr unsigned int WarmUpFrameCount = 300;
+	unsigned int m_warmUpFrames = 0;
+
+	unsigned int m_headlessFrameCount = 0;
+	unsigned int m_frameCount = 0;
+
+	struct AllocationStatistics
+	{
+		unsigned int frameCount = 0;
+		uint64_t allocationCount = 0;
+		uint64_t maxFrameAllocationCount = 0;
+	};
+
+	// Cadrele numarate dupa incalzire, fara si cu arena
+	AllocationStatistics m_bypassedAllocations;
+	AllocationStatistics m_measuredAllocations;
 };
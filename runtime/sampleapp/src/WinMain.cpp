@@ -1,6 +1,12 @@
 #include "App.hpp"
 #include "engine/platform/Window.hpp"
 
+#include <cstdlib>
+#include <cstring>
+
+// Destule cadre cat sa treaca incalzirea din App si sa ramana cateva sute numarate
+constexpr unsigned int DefaultHeadlessFrameCount = 600;
+
 void DisplayMessageBox(engine::platform::Window* window, const char* what, const char* type)
 {
 	HWND hWnd = window == nullptr ? nullptr : window->GetWindowHandler();
@@ -8,8 +14,20 @@ void DisplayMessageBox(engine::platform::Window* window, const char* what, const
 	MessageBoxA(hWnd, what, type, MB_OK | MB_ICONEXCLAMATION);
 }
 
-int main()
+// sampleapp --headless [cadre]: fereastra ascunsa; dupa numarul de cadre afiseaza alocarile pe cadru, fara si cu
+// arena de cadru, si iese
+int main(int argc, char* argv[])
 {
+	unsigned int headlessFrameCount = 0;
+	if (argc > 1 && std::strcmp(argv[1], "--headless") == 0)
+	{
+		headlessFrameCount = argc > 2 ? (unsigned int)std::strtoul(argv[2], nullptr, 10) : 0;
+		if (headlessFrameCount == 0)
+			headlessFrameCount = DefaultHeadlessFrameCount;
+	}
+
+	int exitCode = -1;
+
 #ifdef _DEBUG
 	// _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
 	_CrtMemState sOld;
@@ -21,9 +39,12 @@ int main()
 	std::unique_ptr<engine::platform::Window> window;
 	try
 	{
-		window = std::make_unique<engine::platform::Window>(1200, 600, L"Happy Window");
-		App app(*window);
-		app.Run();
+		window = std::make_unique<engine::platform::Window>(1200, 600, L"Happy Window", headlessFrameCount == 0);
+		App app(*window, headlessFrameCount);
+
+		const int runResult = app.Run();
+		if (headlessFrameCount != 0)
+			exitCode = runResult;
 	}
 	catch (const engine::core::CustomException& e)
 	{
@@ -59,5 +80,5 @@ int main()
 	}
 #endif
 
-	return -1;
+	return exitCode;
 }
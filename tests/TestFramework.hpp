@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+namespace engine::tests
+{
+
+////////////////////////////////////////////////
+// Framework minimal pentru testele modulelor care nu depind de D3D12
+// - TEST_CASE inregistreaza functia la pornire; TestMain.cpp le ruleaza pe toate in ordinea din fisier
+// - CHECK raporteaza esecul si continua testul; REQUIRE il opreste
+///////////////////////////////////////////////
+using TestFunction = void (*)();
+
+struct TestRegistrar
+{
+	TestRegistrar(const char* name, TestFunction function);
+};
+
+// Intoarce false ca REQUIRE sa poata iesi din test
+bool ReportFailure(const char* file, int line, const char* expression);
+
+}  // namespace engine::tests
+
+#define TEST_CASE(name)                                                                                          \
+	static void name();                                                                                          \
+	static const engine::tests::TestRegistrar name##Registrar(#name, name);                                      \
+	static void name()
+
+#define CHECK(expression)                                                                                        \
+	do                                                                                                           \
+	{                                                                                                            \
+		if (!(expression))                                                                                       \
+			engine::tests::ReportFailure(__FILE__, __LINE__, #expression);                                       \
+	} while (false)
+
+#define REQUIRE(expression)                                                                                      \
+	do                                                                                                           \
+	{                                                                                                            \
+		if (!(expression) && !engine::tests::ReportFailure(__FILE__, __LINE__, #expression))                     \
+			return;                                                                                              \
+	} while (false)
@@ -0,0 +1,62 @@
+#include "TestFramework.hpp"
+
+#include <cstdio>
+
+namespace engine::tests
+{
+
+namespace
+{
+
+struct TestEntry
+{
+	const char* name;
+	TestFunction function;
+};
+
+// Fara containere din STL: testele pentru AllocationCounter numara alocarile facute de teste
+constexpr size_t MaxTestCount = 256;
+TestEntry g_tests[MaxTestCount];
+size_t g_testCount = 0;
+size_t g_failureCount = 0;
+
+}  // namespace
+
+TestRegistrar::TestRegistrar(const char* name, TestFunction function)
+{
+	if (g_testCount == MaxTestCount)
+	{
+		std::fprintf(stderr, "Too many tests, %s is not registered\n", name);
+		g_failureCount++;
+		return;
+	}
+
+	g_tests[g_testCount++] = {name, function};
+}
+
+bool ReportFailure(const char* file, int line, const char* expression)
+{
+	std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", file, line, expression);
+	g_failureCount++;
+
+	return false;
+}
+
+}  // namespace engine::tests
+
+int main()
+{
+	using namespace engine::tests;
+
+	for (size_t i = 0; i < g_testCount; i++)
+	{
+		const size_t failureCount = g_failureCount;
+		g_tests[i].function();
+
+		std::printf("[%s] %s\n", g_failureCount == failureCount ? "  OK  " : "FAILED", g_tests[i].name);
+	}
+
+	std::printf("%zu tests, %zu failed checks\n", g_testCount, g_failureCount);
+
+	return g_failureCount == 0 ? 0 : 1;
+}
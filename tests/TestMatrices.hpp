@@ -0,0 +1,106 @@
+#pragma once
+
+#include "engine/math/FloatTypes.hpp"
+
+#include <cmath>
+
+namespace engine::tests
+{
+
+////////////////////////////////////////////////
+// Matricile camerei pentru testele fara DirectXMath
+// - aceleasi formule ca XMMatrixLookAtLH / XMMatrixPerspectiveFovLH / XMMatrixOrthographicLH (vectori linie,
+//   NDC z in [0, 1])
+///////////////////////////////////////////////
+inline engine::math::Float3 Normalize(const engine::math::Float3& v)
+{
+	const float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+	return {v[0] / length, v[1] / length, v[2] / length};
+}
+
+inline engine::math::Float3 Cross(const engine::math::Float3& a, const engine::math::Float3& b)
+{
+	return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+}
+
+inline float Dot(const engine::math::Float3& a, const engine::math::Float3& b)
+{
+	return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+inline engine::math::Float4x4 LookAtLH(
+	const engine::math::Float3& eye, const engine::math::Float3& target, const engine::math::Float3& up)
+{
+	const engine::math::Float3 z = Normalize({target[0] - eye[0], target[1] - eye[1], target[2] - eye[2]});
+	const engine::math::Float3 x = Normalize(Cross(up, z));
+	const engine::math::Float3 y = Cross(z, x);
+
+	return {{
+		{x[0], y[0], z[0], 0.f},
+		{x[1], y[1], z[1], 0.f},
+		{x[2], y[2], z[2], 0.f},
+		{-Dot(x, eye), -Dot(y, eye), -Dot(z, eye), 1.f},
+	}};
+}
+
+inline engine::math::Float4x4 PerspectiveFovLH(float fovY, float aspectRatio, float nearZ, float farZ)
+{
+	const float yScale = 1.f / std::tan(fovY / 2.f);
+	const float xScale = yScale / aspectRatio;
+	const float range = farZ / (farZ - nearZ);
+
+	return {{
+		{xScale, 0.f, 0.f, 0.f},
+		{0.f, yScale, 0.f, 0.f},
+		{0.f, 0.f, range, 1.f},
+		{0.f, 0.f, -range * nearZ, 0.f},
+	}};
+}
+
+inline engine::math::Float4x4 OrthographicLH(float width, float height, float nearZ, float farZ)
+{
+	const float range = 1.f / (farZ - nearZ);
+
+	return {{
+		{2.f / width, 0.f, 0.f, 0.f},
+		{0.f, 2.f / height, 0.f, 0.f},
+		{0.f, 0.f, range, 0.f},
+		{0.f, 0.f, -range * nearZ, 1.f},
+	}};
+}
+
+// Planele din coloanele matricei (Gribb - Hartmann), in ordinea din Frustum::FromViewProjMatrix
+inline engine::math::FrustumPlanes ExtractFrustumPlanes(const engine::math::Float4x4& viewProj)
+{
+	const auto column = [&viewProj](int c) -> engine::math::Float4
+	{
+		return {viewProj.m[0][c], viewProj.m[1][c], viewProj.m[2][c], viewProj.m[3][c]};
+	};
+	const auto combine = [](const engine::math::Float4& a, const engine::math::Float4& b, float sign)
+	{
+		return engine::math::Float4{a[0] + sign * b[0], a[1] + sign * b[1], a[2] + sign * b[2], a[3] + sign * b[3]};
+	};
+	const auto normalize = [](engine::math::Float4 plane)
+	{
+		const float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+		for (float& value : plane)
+			value /= length;
+
+		return plane;
+	};
+
+	const engine::math::Float4 c0 = column(0);
+	const engine::math::Float4 c1 = column(1);
+	const engine::math::Float4 c2 = column(2);
+	const engine::math::Float4 c3 = column(3);
+
+	return {
+		normalize(c2),
+		normalize(combine(c3, c2, -1.f)),
+		normalize(combine(c3, c0, -1.f)),
+		normalize(combine(c3, c0, 1.f)),
+		normalize(combine(c3, c1, -1.f)),
+		normalize(combine(c3, c1, 1.f))};
+}
+
+}  // namespace engine::tests
@@ -0,0 +1,176 @@
+#include "BindlessRecordArray.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+using engine::gfx::BindlessRecordArray;
+
+// Cresterea unui buffer bindless (GrowableStructuredBuffer) pana la N recorduri de marimea lui InstanceData. Bufferul
+// din upload heap e inlocuit de o alocare pe heap cu aceeasi logica de Upload: la schimbarea capacitatii se aloca unul
+// nou si se copiaza toate recordurile, altfel doar intervalul modificat. Se compara cresterea prin dublare, pornind de
+// la capacitatea minima, cu un buffer rezervat de la inceput, apoi se masoara un cadru obisnuit in care se modifica 1%
+// din recorduri
+namespace
+{
+
+// Aceeasi marime ca InstanceData: doua matrice, indexul materialului si padding
+struct alignas(16) Record
+{
+	float matrices[32];
+	uint32_t materialIndex;
+	float padding[3];
+};
+
+static_assert(sizeof(Record) == 144, "Record trebuie sa aiba marimea lui InstanceData");
+
+constexpr uint32_t RecordCounts[] = {1000, 10000, 100000, 1000000};
+
+// Recordurile noi se adauga in atatea cadre (ex. obiecte incarcate treptat)
+constexpr uint32_t GrowthFrameCount = 100;
+constexpr uint32_t SteadyFrameCount = 20;
+
+class HostGrowableBuffer
+{
+public:
+	explicit HostGrowableBuffer(uint32_t initialCapacity)
+	{
+		m_records.Reserve(initialCapacity);
+		Reallocate();
+	}
+
+	inline void CopyData(uint32_t index, const Record& record) { m_records.Write(index, record); }
+
+	uint64_t Upload()
+	{
+		if (m_records.GetCapacity() != m_allocatedCapacity)
+		{
+			Reallocate();
+			m_records.MarkAllDirty();
+		}
+
+		if (!m_records.IsDirty())
+			return 0;
+
+		const uint32_t begin = m_records.GetDirtyBegin();
+		const uint64_t size = (uint64_t)(m_records.GetDirtyEnd() - begin) * sizeof(Record);
+		std::memcpy(m_mapped.get() + begin, m_records.GetData() + begin, size);
+		m_records.ClearDirty();
+
+		return size;
+	}
+
+	inline uint32_t GetReallocationCount() const { return m_reallocationCount; }
+
+private:
+	void Reallocate()
+	{
+		m_allocatedCapacity = m_records.GetCapacity();
+		m_mapped = std::make_unique<Record[]>(m_allocatedCapacity);
+		m_reallocationCount++;
+	}
+
+	BindlessRecordArray<Record> m_records;
+	std::unique_ptr<Record[]> m_mapped;
+	uint32_t m_allocatedCapacity = 0;
+	uint32_t m_reallocationCount = 0;
+};
+
+struct Result
+{
+	uint32_t reallocationCount = 0;
+	uint64_t copiedBytes = 0;
+	double growthMs = 0.0;
+
+	uint64_t steadyCopiedBytes = 0;
+	double steadyMs = 0.0;
+};
+
+Result Measure(uint32_t recordCount, uint32_t initialCapacity)
+{
+	Result result;
+
+	const auto start = std::chrono::steady_clock::now();
+
+	HostGrowableBuffer buffer(initialCapacity);
+	Record record = {};
+
+	const uint32_t recordsPerFrame = recordCount / GrowthFrameCount;
+	for (uint32_t frame = 0; frame < GrowthFrameCount; frame++)
+	{
+		for (uint32_t i = frame * recordsPerFrame; i < (frame + 1) * recordsPerFrame; i++)
+		{
+			record.materialIndex = i;
+			buffer.CopyData(i, record);
+		}
+
+		result.copiedBytes += buffer.Upload();
+	}
+
+	result.growthMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	result.reallocationCount = buffer.GetReallocationCount() - 1;
+
+	// Obiectele care se misca sunt imprastiate, deci intervalul modificat acopera aproape tot bufferul
+	std::mt19937 random(9);
+	std::uniform_int_distribution<uint32_t> index(0, recordCount - 1);
+
+	const auto steadyStart = std::chrono::steady_clock::now();
+	for (uint32_t frame = 0; frame < SteadyFrameCount; frame++)
+	{
+		for (uint32_t k = 0; k < recordCount / 100; k++)
+			buffer.CopyData(index(random), record);
+
+		result.steadyCopiedBytes += buffer.Upload();
+	}
+
+	result.steadyMs =
+		std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - steadyStart).count();
+	result.steadyCopiedBytes /= SteadyFrameCount;
+	result.steadyMs /= SteadyFrameCount;
+
+	return result;
+}
+
+void PrintRow(uint32_t recordCount, const char* capacity, const Result& result)
+{
+	const double recordBytes = (double)recordCount * sizeof(Record);
+
+	std::printf(
+		"%8u  %-9s %8u %11.2f %9.2fx %11.3f %13.2f %11.3f\n",
+		recordCount,
+		capacity,
+		result.reallocationCount,
+		result.copiedBytes / (1024.0 * 1024.0),
+		result.copiedBytes / recordBytes,
+		result.growthMs,
+		result.steadyCopiedBytes / (1024.0 * 1024.0),
+		result.steadyMs);
+}
+
+}  // namespace
+
+int main()
+{
+	std::printf(
+		"%8s  %-9s %8s %11s %10s %11s %13s %11s\n",
+		"records",
+		"capacity",
+		"reallocs",
+		"copied MB",
+		"overhead",
+		"growth ms",
+		"MB / frame",
+		"ms / frame");
+
+	for (const uint32_t recordCount : RecordCounts)
+	{
+		PrintRow(recordCount, "doubling", Measure(recordCount, BindlessRecordArray<Record>::MinCapacity));
+		PrintRow(recordCount, "reserved", Measure(recordCount, recordCount));
+	}
+
+	return 0;
+}
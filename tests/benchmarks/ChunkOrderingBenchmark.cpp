@@ -0,0 +1,185 @@
+#include "ChunkOrdering.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using engine::gfx::ChunkOrdering;
+
+// Chunk-uri de teren asezate ca in GenerateChunks (de-a lungul curbei Hilbert), vazute din pozitii aleatoare ale
+// camerei. Pentru counting sort-ul pe benzi si pentru sortarea exacta dupa distanta se masoara: timpul, cat de
+// departe e ordinea de cea exacta (perechi inversate) si cate draw-uri raman dupa unirea chunk-urilor consecutive
+namespace
+{
+
+constexpr float ChunkSize = 16.f;
+constexpr int CameraCount = 64;
+
+constexpr int ChunkCountsPerSide[] = {16, 32, 64, 128};
+
+struct Result
+{
+	double microseconds = 0.0;
+	double invertedPairs = 0.0;
+	double drawCount = 0.0;
+};
+
+// Centrele chunk-urilor in ordinea din index buffer
+std::vector<std::array<float, 2>> MakeChunkCenters(int chunkCountPerSide)
+{
+	std::vector<std::array<float, 2>> centers;
+	centers.reserve(chunkCountPerSide * chunkCountPerSide);
+
+	for (int d = 0; d < chunkCountPerSide * chunkCountPerSide; d++)
+	{
+		int row, column;
+		ChunkOrdering::HilbertCurveToGrid(chunkCountPerSide, d, row, column);
+		centers.push_back({(row + 0.5f) * ChunkSize, (column + 0.5f) * ChunkSize});
+	}
+
+	return centers;
+}
+
+// Perechile (i < j) cu distances[i] > distances[j], prin merge sort
+uint64_t CountInversions(std::vector<float>& values, std::vector<float>& scratch, size_t begin, size_t end)
+{
+	if (end - begin < 2)
+		return 0;
+
+	const size_t middle = (begin + end) / 2;
+	uint64_t count = CountInversions(values, scratch, begin, middle) + CountInversions(values, scratch, middle, end);
+
+	size_t left = begin;
+	size_t right = middle;
+	size_t out = begin;
+	while (left < middle || right < end)
+	{
+		if (right == end || (left < middle && values[left] <= values[right]))
+		{
+			scratch[out++] = values[left++];
+		}
+		else
+		{
+			count += middle - left;
+			scratch[out++] = values[right++];
+		}
+	}
+
+	std::copy(scratch.begin() + begin, scratch.begin() + end, values.begin() + begin);
+	return count;
+}
+
+// Draw-urile ramase dupa unirea chunk-urilor vecine in index buffer (ca DrawRangeMerger)
+uint32_t CountDraws(const std::vector<uint32_t>& order)
+{
+	uint32_t drawCount = order.empty() ? 0 : 1;
+	for (size_t k = 1; k < order.size(); k++)
+	{
+		if (order[k] != order[k - 1] + 1)
+			drawCount++;
+	}
+
+	return drawCount;
+}
+
+template <typename SortFunction>
+Result Measure(const std::vector<std::array<float, 2>>& centers, float maxDistance, SortFunction sort)
+{
+	std::mt19937 random(11);
+	std::uniform_real_distribution<float> position(0.f, maxDistance / std::sqrt(2.f));
+
+	std::vector<float> distances(centers.size());
+	std::vector<uint32_t> order;
+	std::vector<float> orderedDistances(centers.size());
+	std::vector<float> scratch(centers.size());
+
+	Result result;
+	for (int camera = 0; camera < CameraCount; camera++)
+	{
+		const float cameraX = position(random);
+		const float cameraZ = position(random);
+
+		for (size_t i = 0; i < centers.size(); i++)
+			distances[i] = std::hypot(centers[i][0] - cameraX, centers[i][1] - cameraZ);
+
+		const auto start = std::chrono::steady_clock::now();
+		sort(distances, order);
+		result.microseconds +=
+			std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+		for (size_t k = 0; k < order.size(); k++)
+			orderedDistances[k] = distances[order[k]];
+
+		const double pairCount = (double)order.size() * (order.size() - 1) / 2.0;
+		result.invertedPairs += CountInversions(orderedDistances, scratch, 0, order.size()) / pairCount;
+		result.drawCount += CountDraws(order);
+	}
+
+	result.microseconds /= CameraCount;
+	result.invertedPairs /= CameraCount;
+	result.drawCount /= CameraCount;
+	return result;
+}
+
+template <uint32_t BandCount>
+void SortByBands(const std::vector<float>& distances, float maxDistance, std::vector<uint32_t>& order)
+{
+	ChunkOrdering::SortByDistanceBands<BandCount>(
+		(uint32_t)distances.size(), [&distances](uint32_t i) { return distances[i]; }, maxDistance, order);
+}
+
+void SortExactly(const std::vector<float>& distances, std::vector<uint32_t>& order)
+{
+	order.resize(distances.size());
+	for (uint32_t i = 0; i < (uint32_t)order.size(); i++)
+		order[i] = i;
+
+	std::sort(order.begin(), order.end(), [&distances](uint32_t a, uint32_t b) { return distances[a] < distances[b]; });
+}
+
+void PrintResult(const char* label, int chunkCount, const Result& result)
+{
+	std::printf(
+		"%7d  %-14s %10.1f %12.4f%% %10.0f\n",
+		chunkCount,
+		label,
+		result.microseconds,
+		result.invertedPairs * 100.0,
+		result.drawCount);
+}
+
+}  // namespace
+
+int main()
+{
+	std::printf("%7s  %-14s %10s %13s %10s\n", "chunks", "order", "us / sort", "inverted", "draws");
+
+	for (const int chunkCountPerSide : ChunkCountsPerSide)
+	{
+		const std::vector<std::array<float, 2>> centers = MakeChunkCenters(chunkCountPerSide);
+		const int chunkCount = (int)centers.size();
+
+		// maxDistance e diagonala terenului, ca sa nu ramana chunk-uri in afara benzilor
+		const float maxDistance = chunkCountPerSide * ChunkSize * std::sqrt(2.f);
+
+		const auto bands16 = [maxDistance](const std::vector<float>& distances, std::vector<uint32_t>& order)
+		{
+			SortByBands<16>(distances, maxDistance, order);
+		};
+		const auto bands64 = [maxDistance](const std::vector<float>& distances, std::vector<uint32_t>& order)
+		{
+			SortByBands<64>(distances, maxDistance, order);
+		};
+
+		PrintResult("16 bands", chunkCount, Measure(centers, maxDistance, bands16));
+		PrintResult("64 bands", chunkCount, Measure(centers, maxDistance, bands64));
+		PrintResult("std::sort", chunkCount, Measure(centers, maxDistance, SortExactly));
+	}
+
+	return 0;
+}
@@ -0,0 +1,236 @@
+#include "ConstantPacking.hpp"
+
+#include "engine/math/FloatTypes.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using engine::gfx::Float4x4;
+using engine::gfx::ObjectRecord;
+using engine::gfx::PackObjectRecords;
+using engine::gfx::RecordVersionTracker;
+
+// Octetii scrisi pe cadru in recordurile obiectelor (layout-ul ObjectRecord, cum ajunge in ObjectConstantBuffer si in
+// bufferul bindless), cu 3 FrameResources. Inainte: fiecare obiect se rescrie la fiecare cadru, cu transpusa si inversa
+// calculate separat pentru fiecare. Dupa: fiecare copie tine un RecordVersionTracker si rescrie doar obiectele a caror
+// versiune s-a schimbat de la ultima ei scriere, iar recordurile acestora se impacheteaza odata cu PackObjectRecords.
+// Un obiect modificat se rescrie deci in fiecare dintre cele 3 copii, cate o data, in cadrele urmatoare
+namespace
+{
+
+constexpr uint32_t FrameResourceCount = 3;
+constexpr int FrameCount = 60;
+
+constexpr uint32_t ObjectCounts[] = {1000, 10000, 100000};
+
+// Procentul de obiecte care se misca in fiecare cadru
+constexpr float DirtyFractions[] = {0.f, 0.05f, 0.25f, 1.f};
+
+struct Object
+{
+	Float4x4 transform;
+	Float4x4 textureTransform;
+	uint32_t version;
+};
+
+struct Result
+{
+	double bytesPerFrame = 0.0;
+	double msPerFrame = 0.0;
+};
+
+std::vector<Object> MakeObjects(uint32_t objectCount)
+{
+	std::mt19937 random(47);
+	std::uniform_real_distribution<float> position(-500.f, 500.f);
+
+	std::vector<Object> objects(objectCount);
+	for (Object& object : objects)
+	{
+		object.transform = {{1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f}};
+		object.transform.m[12] = position(random);
+		object.transform.m[13] = position(random);
+		object.transform.m[14] = position(random);
+		object.textureTransform = {{1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f}};
+		object.version = 1;
+	}
+
+	return objects;
+}
+
+// Obiectele care se misca in cadrul curent primesc o versiune noua
+void MoveObjects(std::vector<Object>& objects, float dirtyFraction, std::mt19937& random)
+{
+	std::uniform_real_distribution<float> chance(0.f, 1.f);
+	for (Object& object : objects)
+	{
+		if (chance(random) < dirtyFraction)
+		{
+			object.transform.m[12] += 0.5f;
+			object.version++;
+		}
+	}
+}
+
+Float4x4 Transpose(const Float4x4& matrix)
+{
+	Float4x4 result;
+	for (int r = 0; r < 4; r++)
+	{
+		for (int c = 0; c < 4; c++)
+			result.m[c * 4 + r] = matrix.m[r * 4 + c];
+	}
+
+	return result;
+}
+
+// Calea veche din UpdatePerObjectCB: transpusa, inversa si transformul de textura pentru fiecare obiect in parte
+void PackObjectRecord(const Object& object, ObjectRecord& record)
+{
+	engine::math::Float4x4 matrix;
+	engine::math::Float4x4 inverse;
+	std::memcpy(matrix.m, object.transform.m, sizeof(matrix.m));
+	engine::math::Invert(matrix, inverse);
+
+	Float4x4 invWorldMatrix;
+	std::memcpy(invWorldMatrix.m, inverse.m, sizeof(invWorldMatrix.m));
+
+	record.worldMatrix = Transpose(object.transform);
+	record.invWorldMatrix = Transpose(invWorldMatrix);
+	record.textureTransform = Transpose(object.textureTransform);
+}
+
+Result MeasureBefore(uint32_t objectCount, float dirtyFraction)
+{
+	std::vector<Object> objects = MakeObjects(objectCount);
+	std::vector<std::vector<ObjectRecord>> buffers(FrameResourceCount, std::vector<ObjectRecord>(objectCount));
+	std::mt19937 random(7);
+
+	uint64_t writtenBytes = 0;
+	double totalMs = 0.0;
+	for (int frame = 0; frame < FrameCount; frame++)
+	{
+		MoveObjects(objects, dirtyFraction, random);
+		std::vector<ObjectRecord>& buffer = buffers[frame % FrameResourceCount];
+
+		const auto start = std::chrono::steady_clock::now();
+
+		for (uint32_t id = 0; id < objectCount; id++)
+		{
+			PackObjectRecord(objects[id], buffer[id]);
+			writtenBytes += sizeof(ObjectRecord);
+		}
+
+		totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	return {(double)writtenBytes / FrameCount, totalMs / FrameCount};
+}
+
+Result MeasureAfter(uint32_t objectCount, float dirtyFraction)
+{
+	std::vector<Object> objects = MakeObjects(objectCount);
+	std::vector<std::vector<ObjectRecord>> buffers(FrameResourceCount, std::vector<ObjectRecord>(objectCount));
+	std::vector<RecordVersionTracker> versions(FrameResourceCount);
+	std::mt19937 random(7);
+
+	// Ca in FrameResources::WriteObjectRecords: obiectele vechi se aduna, apoi se impacheteaza toate odata
+	std::vector<uint32_t> staleObjects;
+	std::vector<Float4x4> transforms;
+	std::vector<Float4x4> textureTransforms;
+	std::vector<ObjectRecord> records;
+
+	// Primele FrameResourceCount cadre scriu toate recordurile in fiecare copie si nu intra in masuratoare
+	uint64_t writtenBytes = 0;
+	double totalMs = 0.0;
+	for (int frame = 0; frame < FrameCount + (int)FrameResourceCount; frame++)
+	{
+		MoveObjects(objects, dirtyFraction, random);
+		std::vector<ObjectRecord>& buffer = buffers[frame % FrameResourceCount];
+		RecordVersionTracker& tracker = versions[frame % FrameResourceCount];
+
+		const auto start = std::chrono::steady_clock::now();
+
+		staleObjects.clear();
+		for (uint32_t id = 0; id < objectCount; id++)
+		{
+			if (tracker.IsStale(id, objects[id].version))
+				staleObjects.push_back(id);
+		}
+
+		const size_t count = staleObjects.size();
+		transforms.resize(count);
+		textureTransforms.resize(count);
+		records.resize(count);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			transforms[i] = objects[staleObjects[i]].transform;
+			textureTransforms[i] = objects[staleObjects[i]].textureTransform;
+		}
+
+		PackObjectRecords(transforms.data(), textureTransforms.data(), count, records.data());
+
+		for (size_t i = 0; i < count; i++)
+		{
+			const uint32_t id = staleObjects[i];
+			buffer[id] = records[i];
+			tracker.SetWritten(id, objects[id].version);
+		}
+
+		const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		if (frame >= (int)FrameResourceCount)
+		{
+			writtenBytes += count * sizeof(ObjectRecord);
+			totalMs += ms;
+		}
+	}
+
+	return {(double)writtenBytes / FrameCount, totalMs / FrameCount};
+}
+
+}  // namespace
+
+int main()
+{
+	std::printf("record: %zu B, frame resources: %u, KB si ms pe cadru\n", sizeof(ObjectRecord), FrameResourceCount);
+	std::printf(
+		"%8s %7s %12s %12s %10s %12s %12s\n",
+		"objects",
+		"dirty",
+		"KB before",
+		"KB after",
+		"reduction",
+		"ms before",
+		"ms after");
+
+	for (const uint32_t objectCount : ObjectCounts)
+	{
+		for (const float dirtyFraction : DirtyFractions)
+		{
+			const Result before = MeasureBefore(objectCount, dirtyFraction);
+			const Result after = MeasureAfter(objectCount, dirtyFraction);
+
+			// Fara obiecte modificate nu se scrie nimic dupa
+			char reduction[32] = "-";
+			if (after.bytesPerFrame > 0.0)
+				std::snprintf(reduction, sizeof(reduction), "%.1fx", before.bytesPerFrame / after.bytesPerFrame);
+
+			std::printf(
+				"%8u %6.0f%% %12.1f %12.1f %10s %12.3f %12.3f\n",
+				objectCount,
+				dirtyFraction * 100.f,
+				before.bytesPerFrame / 1024.0,
+				after.bytesPerFrame / 1024.0,
+				reduction,
+				before.msPerFrame,
+				after.msPerFrame);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,150 @@
+#include "InstanceBatcher.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using engine::gfx::InstanceBatcher;
+using engine::gfx::SubMesh;
+
+// Desenarea obiectelor inainte si dupa instantiere, pe o scena cu putine combinatii (mesh, material), ca in
+// CreateObjects. Inainte: un DrawIndexedInstanced pentru fiecare obiect vizibil in fiecare view (ObjectRenderer fara
+// UseInstancing). Dupa: un draw pentru fiecare InstanceGroup. Timpul pe CPU e cel al construirii listei de draw-uri
+// pe cadru: lista per obiect, respectiv Reset + Add + Build din ObjectRenderer::BuildInstanceBatches
+namespace
+{
+
+constexpr uint32_t ViewCount = 8;
+constexpr uint32_t MeshCount = 8;
+constexpr uint32_t MaterialCount = 4;
+constexpr int FrameCount = 20;
+
+constexpr uint32_t ObjectCounts[] = {1000, 10000, 100000};
+
+// Cat de des e vizibil un obiect: camera principala, shadow map-ul si cele 6 fete ale cube map-ului
+constexpr float ViewVisibility[ViewCount] = {0.5f, 0.7f, 0.15f, 0.15f, 0.15f, 0.15f, 0.15f, 0.15f};
+
+struct Object
+{
+	SubMesh subMesh;
+	uint32_t materialID;
+	uint8_t visibleViews;
+};
+
+struct Draw
+{
+	SubMesh subMesh;
+	uint32_t materialID;
+	uint32_t objectIndex;
+};
+
+std::vector<Object> MakeObjects(uint32_t objectCount)
+{
+	std::mt19937 random(5);
+	std::uniform_int_distribution<uint32_t> mesh(0, MeshCount - 1);
+	std::uniform_int_distribution<uint32_t> material(0, MaterialCount - 1);
+	std::uniform_real_distribution<float> chance(0.f, 1.f);
+
+	std::vector<Object> objects(objectCount);
+	for (Object& object : objects)
+	{
+		const uint32_t meshIndex = mesh(random);
+		object.subMesh = {600 * (meshIndex + 1), 10000 * meshIndex, 0};
+		object.materialID = material(random);
+
+		object.visibleViews = 0;
+		for (uint32_t view = 0; view < ViewCount; view++)
+		{
+			if (chance(random) < ViewVisibility[view])
+				object.visibleViews |= (uint8_t)(1u << view);
+		}
+	}
+
+	return objects;
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+int main()
+{
+	std::printf(
+		"%8s %12s %12s %10s %12s %12s\n",
+		"objects",
+		"draws before",
+		"draws after",
+		"reduction",
+		"ms before",
+		"ms after");
+
+	for (const uint32_t objectCount : ObjectCounts)
+	{
+		const std::vector<Object> objects = MakeObjects(objectCount);
+
+		std::vector<std::vector<Draw>> draws(ViewCount);
+		InstanceBatcher batcher;
+		batcher.Create(ViewCount);
+
+		double beforeMs = 0.0;
+		double afterMs = 0.0;
+		for (int frame = 0; frame < FrameCount; frame++)
+		{
+			auto start = std::chrono::steady_clock::now();
+
+			for (std::vector<Draw>& viewDraws : draws)
+				viewDraws.clear();
+
+			for (uint32_t i = 0; i < objectCount; i++)
+			{
+				for (uint32_t view = 0; view < ViewCount; view++)
+				{
+					if (objects[i].visibleViews & (1u << view))
+						draws[view].push_back({objects[i].subMesh, objects[i].materialID, i});
+				}
+			}
+
+			beforeMs += ElapsedMs(start);
+
+			start = std::chrono::steady_clock::now();
+
+			batcher.Reset();
+			for (uint32_t i = 0; i < objectCount; i++)
+			{
+				for (uint32_t view = 0; view < ViewCount; view++)
+				{
+					if (objects[i].visibleViews & (1u << view))
+						batcher.Add(view, objects[i].subMesh, objects[i].materialID, i);
+				}
+			}
+
+			batcher.Build();
+
+			afterMs += ElapsedMs(start);
+		}
+
+		size_t drawsBefore = 0;
+		size_t drawsAfter = 0;
+		for (uint32_t view = 0; view < ViewCount; view++)
+		{
+			drawsBefore += draws[view].size();
+			drawsAfter += batcher.GetGroups(view).size();
+		}
+
+		std::printf(
+			"%8u %12zu %12zu %9.0fx %12.3f %12.3f\n",
+			objectCount,
+			drawsBefore,
+			drawsAfter,
+			(double)drawsBefore / drawsAfter,
+			beforeMs / FrameCount,
+			afterMs / FrameCount);
+	}
+
+	return 0;
+}
@@ -0,0 +1,226 @@
+#include "engine/math/LooseOctree.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using engine::math::BoxBounds;
+using engine::math::Float3;
+using engine::math::FrustumPlanes;
+using engine::math::LooseOctree;
+
+// Obiecte dinamice intr-o lume de 1024 x 1024 x 1024, ca in ObjectRenderer: majoritatea mici, cateva mari. Pentru
+// fiecare numar de obiecte se masoara inserarea, mutarea unei zecimi din ele (Update, ca obiectele animate intr-un
+// cadru) si interogarile de frustum, cutie si sfera, comparate cu parcurgerea tuturor cutiilor
+namespace
+{
+
+constexpr uint32_t ObjectCounts[] = {1000, 10000, 100000};
+constexpr int QueryCount = 200;
+
+constexpr BoxBounds World = {{-512.f, -512.f, -512.f}, {512.f, 512.f, 512.f}};
+
+BoxBounds MakeBox(std::mt19937& random)
+{
+	std::uniform_real_distribution<float> unit(0.f, 1.f);
+	std::uniform_real_distribution<float> position(-500.f, 500.f);
+
+	const float halfSize = unit(random) < 0.95f ? 0.5f + 4.5f * unit(random) : 5.f + 45.f * unit(random);
+
+	BoxBounds box;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		const float center = position(random);
+		box.min[axis] = center - halfSize;
+		box.max[axis] = center + halfSize;
+	}
+
+	return box;
+}
+
+// Piramida de 90 de grade spre +x, cu varful in eye, pana la farDistance
+FrustumPlanes MakeFrustum(const Float3& eye, float farDistance)
+{
+	const float side = 1.f / std::sqrt(2.f);
+
+	FrustumPlanes planes = {{
+		{1.f, 0.f, 0.f, -(eye[0] + 0.5f)},
+		{-1.f, 0.f, 0.f, eye[0] + farDistance},
+		{side, 0.f, -side, 0.f},
+		{side, 0.f, side, 0.f},
+		{side, -side, 0.f, 0.f},
+		{side, side, 0.f, 0.f}}};
+
+	for (int i = 2; i < 6; i++)
+		planes[i][3] = -(planes[i][0] * eye[0] + planes[i][1] * eye[1] + planes[i][2] * eye[2]);
+
+	return planes;
+}
+
+bool IntersectsFrustum(const BoxBounds& box, const FrustumPlanes& planes)
+{
+	for (const auto& plane : planes)
+	{
+		float farDistance = plane[3];
+		for (int axis = 0; axis < 3; axis++)
+			farDistance += plane[axis] * (plane[axis] > 0.f ? box.max[axis] : box.min[axis]);
+
+		if (farDistance < 0.f)
+			return false;
+	}
+
+	return true;
+}
+
+bool Overlaps(const BoxBounds& a, const BoxBounds& b)
+{
+	for (int axis = 0; axis < 3; axis++)
+	{
+		if (a.max[axis] < b.min[axis] || a.min[axis] > b.max[axis])
+			return false;
+	}
+
+	return true;
+}
+
+bool IntersectsSphere(const BoxBounds& box, const Float3& center, float radius)
+{
+	float distance2 = 0.f;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		const float nearest = std::clamp(center[axis], box.min[axis], box.max[axis]);
+		distance2 += (center[axis] - nearest) * (center[axis] - nearest);
+	}
+
+	return distance2 <= radius * radius;
+}
+
+double MicrosecondsSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Timpul mediu al unei interogari prin octree si prin parcurgerea tuturor cutiilor
+template <typename OctreeQuery, typename BruteForceTest>
+void MeasureQuery(
+	const char* label,
+	const std::vector<BoxBounds>& boxes,
+	OctreeQuery octreeQuery,
+	BruteForceTest bruteForceTest)
+{
+	std::vector<uint32_t> result;
+	double octreeUs = 0.0;
+	double bruteForceUs = 0.0;
+	uint64_t foundCount = 0;
+
+	for (int query = 0; query < QueryCount; query++)
+	{
+		result.clear();
+
+		auto start = std::chrono::steady_clock::now();
+		octreeQuery(query, result);
+		octreeUs += MicrosecondsSince(start);
+		foundCount += result.size();
+
+		start = std::chrono::steady_clock::now();
+		uint32_t bruteForceCount = 0;
+		for (const BoxBounds& box : boxes)
+		{
+			if (bruteForceTest(query, box))
+				bruteForceCount++;
+		}
+		bruteForceUs += MicrosecondsSince(start);
+
+		if (bruteForceCount != result.size())
+			std::printf("  %s: query %d found %zu, expected %u\n", label, query, result.size(), bruteForceCount);
+	}
+
+	std::printf(
+		"  %-8s %12.2f %14.2f %10.1fx %12.0f\n",
+		label,
+		octreeUs / QueryCount,
+		bruteForceUs / QueryCount,
+		bruteForceUs / octreeUs,
+		(double)foundCount / QueryCount);
+}
+
+}  // namespace
+
+int main()
+{
+	for (const uint32_t objectCount : ObjectCounts)
+	{
+		std::mt19937 random(7);
+
+		std::vector<BoxBounds> boxes(objectCount);
+		for (BoxBounds& box : boxes)
+			box = MakeBox(random);
+
+		LooseOctree octree(World);
+		std::vector<LooseOctree::Handle> handles(objectCount);
+
+		auto start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < objectCount; i++)
+			handles[i] = octree.Insert(boxes[i], i);
+		const double insertUs = MicrosecondsSince(start);
+
+		// O zecime din obiecte se muta putin, ca intr-un cadru
+		std::uniform_real_distribution<float> offset(-2.f, 2.f);
+		start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < objectCount; i += 10)
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const float delta = offset(random);
+				boxes[i].min[axis] += delta;
+				boxes[i].max[axis] += delta;
+			}
+
+			octree.Update(handles[i], boxes[i]);
+		}
+		const double updateUs = MicrosecondsSince(start);
+
+		std::printf(
+			"%u objects: insert %.1f ns / object, update %.1f ns / object, %u nodes\n",
+			objectCount,
+			insertUs * 1e3 / objectCount,
+			updateUs * 1e3 / ((objectCount + 9) / 10),
+			octree.GetNodeCount());
+		std::printf("  %-8s %12s %14s %11s %12s\n", "query", "octree us", "all boxes us", "speedup", "found");
+
+		std::vector<FrustumPlanes> frustums;
+		std::vector<BoxBounds> queryBoxes;
+		std::vector<Float3> centers;
+		std::uniform_real_distribution<float> position(-500.f, 500.f);
+		for (int query = 0; query < QueryCount; query++)
+		{
+			const Float3 eye = {position(random), position(random), position(random)};
+			frustums.push_back(MakeFrustum(eye, 300.f));
+			queryBoxes.push_back(
+				{{eye[0] - 50.f, eye[1] - 50.f, eye[2] - 50.f}, {eye[0] + 50.f, eye[1] + 50.f, eye[2] + 50.f}});
+			centers.push_back(eye);
+		}
+
+		MeasureQuery(
+			"frustum",
+			boxes,
+			[&](int query, std::vector<uint32_t>& result) { octree.QueryFrustum(frustums[query], result); },
+			[&](int query, const BoxBounds& box) { return IntersectsFrustum(box, frustums[query]); });
+		MeasureQuery(
+			"box",
+			boxes,
+			[&](int query, std::vector<uint32_t>& result) { octree.QueryBox(queryBoxes[query], result); },
+			[&](int query, const BoxBounds& box) { return Overlaps(box, queryBoxes[query]); });
+		MeasureQuery(
+			"sphere",
+			boxes,
+			[&](int query, std::vector<uint32_t>& result) { octree.QuerySphere(centers[query], 50.f, result); },
+			[&](int query, const BoxBounds& box) { return IntersectsSphere(box, centers[query], 50.f); });
+	}
+
+	return 0;
+}
@@ -0,0 +1,154 @@
+#include "MemoryPool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using engine::gfx::MemoryAllocation;
+using engine::gfx::MemoryMove;
+using engine::gfx::MemoryPool;
+
+// Incarcare asemanatoare cu GpuMemoryAllocator: heap-uri de 64 MB, alocari de la 64 KB (buffere, texturi mici) la
+// 8 MB (texturi mari), cu incarcari si descarcari repetate. Se masoara memoria ocupata de heap-uri fata de cea
+// ceruta, fragmentarea si cat recupereaza PlanDefragmentation
+namespace
+{
+
+constexpr uint64_t HeapSize = 64ull << 20;
+constexpr uint64_t MinAllocationSize = 64ull << 10;
+constexpr int RoundCount = 200;
+constexpr int AllocationsPerRound = 256;
+constexpr size_t MaxMovesPerFrame = 32;
+
+struct LiveAllocation
+{
+	MemoryAllocation allocation;
+	uint64_t requestedSize;
+};
+
+uint64_t RandomSize(std::mt19937& random)
+{
+	// Distributie log-uniforma intre 4 KB si 8 MB
+	std::uniform_real_distribution<double> exponent(12.0, 23.0);
+	return (uint64_t)std::exp2(exponent(random));
+}
+
+void PrintState(const char* label, const MemoryPool& pool, uint64_t requestedSize)
+{
+	const uint64_t reservedSize = pool.GetBlockCount() * HeapSize;
+
+	std::printf(
+		"%-28s heaps %3zu  requested %7.1f MB  used %7.1f MB  reserved %7.1f MB  fragmentation %.2f\n",
+		label,
+		pool.GetBlockCount(),
+		requestedSize / 1048576.0,
+		pool.GetUsedSize() / 1048576.0,
+		reservedSize / 1048576.0,
+		pool.GetFragmentation());
+}
+
+}  // namespace
+
+int main()
+{
+	MemoryPool pool;
+	pool.Create(HeapSize, MinAllocationSize);
+
+	std::mt19937 random(2024);
+	std::vector<LiveAllocation> live;
+	uint64_t requestedSize = 0;
+	uint64_t operationCount = 0;
+	size_t peakBlockCount = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (int round = 0; round < RoundCount; round++)
+	{
+		for (int i = 0; i < AllocationsPerRound; i++)
+		{
+			const uint64_t size = RandomSize(random);
+
+			MemoryAllocation allocation;
+			if (!pool.Allocate(size, MinAllocationSize, allocation))
+			{
+				pool.AddBlock();
+				pool.Allocate(size, MinAllocationSize, allocation);
+			}
+
+			live.push_back({allocation, size});
+			requestedSize += size;
+			operationCount++;
+		}
+
+		peakBlockCount = std::max(peakBlockCount, pool.GetBlockCount());
+
+		// Se descarca o parte aleatoare, ca la schimbarea chunk-urilor de teren
+		std::shuffle(live.begin(), live.end(), random);
+		const size_t freedCount = live.size() * 55 / 100;
+		for (size_t i = 0; i < freedCount; i++)
+		{
+			if (pool.Free(live[i].allocation))
+				pool.RemoveBlock(live[i].allocation.block);
+
+			requestedSize -= live[i].requestedSize;
+			operationCount++;
+		}
+		live.erase(live.begin(), live.begin() + freedCount);
+	}
+
+	const double churnMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	std::printf("%llu allocations / frees in %.2f ms (%.0f ns per operation), peak %zu heaps\n",
+		(unsigned long long)operationCount,
+		churnMs,
+		churnMs * 1e6 / (double)operationCount,
+		peakBlockCount);
+	PrintState("after churn", pool, requestedSize);
+
+	// Defragmentare incrementala, cate MaxMovesPerFrame mutari pe cadru, pana nu se mai gaseste loc pentru mutari
+	int frameCount = 0;
+	uint64_t movedSize = 0;
+	const auto defragmentationStart = std::chrono::steady_clock::now();
+
+	while (true)
+	{
+		const std::vector<MemoryMove> moves = pool.PlanDefragmentation(MaxMovesPerFrame);
+		if (moves.empty())
+			break;
+
+		for (const MemoryMove& move : moves)
+		{
+			for (LiveAllocation& liveAllocation : live)
+			{
+				MemoryAllocation& allocation = liveAllocation.allocation;
+				if (allocation.block == move.source.block && allocation.offset == move.source.offset)
+				{
+					allocation = move.destination;
+					break;
+				}
+			}
+
+			movedSize += move.source.size;
+			if (pool.Free(move.source))
+				pool.RemoveBlock(move.source.block);
+		}
+
+		// Sursa e mereu blocul cel mai putin folosit, deci se goleste inainte sa se treaca la altul
+		frameCount++;
+	}
+
+	const double defragmentationMs =
+		std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - defragmentationStart).count();
+
+	std::printf("defragmentation: %d frames, %.1f MB moved, %.2f ms planning\n",
+		frameCount,
+		movedSize / 1048576.0,
+		defragmentationMs);
+	PrintState("after defragmentation", pool, requestedSize);
+
+	return 0;
+}
@@ -0,0 +1,133 @@
+#include "TestMatrices.hpp"
+
+#include "MultiViewCuller.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace CullingView = engine::gfx::CullingView;
+using engine::gfx::MultiViewCuller;
+using engine::math::BoxBounds;
+using engine::math::Float3;
+using engine::math::Float4x4;
+
+// Trecerea de culling din RasterizationGraphics peste o grila de chunk-uri de teren: camera principala, shadow map-ul
+// ortografic si cele 6 fete ale cube map-ului. Se masoara timpul pe bounding box si procentul eliminat pe fiecare view
+// (MultiViewCuller::GetCulledRatio), cu 1, 2 si 8 view-uri active
+namespace
+{
+
+constexpr float ChunkSize = 16.f;
+constexpr int SweepCount = 20;
+
+constexpr int ChunkCountsPerSide[] = {32, 64, 128};
+constexpr int ActiveViewCounts[] = {1, 2, 8};
+
+std::vector<BoxBounds> MakeChunkGrid(int chunkCountPerSide)
+{
+	std::vector<BoxBounds> chunks;
+	chunks.reserve(chunkCountPerSide * chunkCountPerSide);
+
+	const float origin = -chunkCountPerSide * ChunkSize / 2.f;
+	for (int row = 0; row < chunkCountPerSide; row++)
+	{
+		for (int column = 0; column < chunkCountPerSide; column++)
+		{
+			const float x = origin + row * ChunkSize;
+			const float z = origin + column * ChunkSize;
+			const float height = 2.f + (float)((row * 7 + column * 3) % 13);
+			chunks.push_back({{x, -1.f, z}, {x + ChunkSize, height, z + ChunkSize}});
+		}
+	}
+
+	return chunks;
+}
+
+void SetViews(MultiViewCuller& culler, int activeViewCount)
+{
+	const Float3 eye = {0.f, 30.f, 0.f};
+	const Float4x4 mainViewProj = engine::math::Multiply(
+		engine::tests::LookAtLH(eye, {100.f, 0.f, 60.f}, {0.f, 1.f, 0.f}),
+		engine::tests::PerspectiveFovLH(1.f, 16.f / 9.f, 0.5f, 500.f));
+	culler.SetView(CullingView::Main, engine::tests::ExtractFrustumPlanes(mainViewProj), mainViewProj, eye, 500.f);
+
+	if (activeViewCount < 2)
+		return;
+
+	const Float3 light = {0.f, 300.f, 0.f};
+	const Float4x4 shadowViewProj = engine::math::Multiply(
+		engine::tests::LookAtLH(light, {0.f, 0.f, 0.f}, {0.f, 0.f, 1.f}),
+		engine::tests::OrthographicLH(400.f, 400.f, 1.f, 600.f));
+	culler.SetView(
+		CullingView::Shadow, engine::tests::ExtractFrustumPlanes(shadowViewProj), shadowViewProj, light, 0.f);
+
+	if (activeViewCount < 8)
+		return;
+
+	// Fetele cube map-ului in ordinea din CubeMapCameraController: +x, -x, +y, -y, +z, -z
+	const Float3 probe = {20.f, 15.f, 20.f};
+	const Float3 directions[6] = {
+		{1.f, 0.f, 0.f}, {-1.f, 0.f, 0.f}, {0.f, 1.f, 0.f}, {0.f, -1.f, 0.f}, {0.f, 0.f, 1.f}, {0.f, 0.f, -1.f}};
+	const Float3 ups[6] = {
+		{0.f, 1.f, 0.f}, {0.f, 1.f, 0.f}, {0.f, 0.f, -1.f}, {0.f, 0.f, 1.f}, {0.f, 1.f, 0.f}, {0.f, 1.f, 0.f}};
+	for (int face = 0; face < 6; face++)
+	{
+		const Float3 target = {
+			probe[0] + directions[face][0], probe[1] + directions[face][1], probe[2] + directions[face][2]};
+		const Float4x4 faceViewProj = engine::math::Multiply(
+			engine::tests::LookAtLH(probe, target, ups[face]),
+			engine::tests::PerspectiveFovLH(3.14159265f / 2.f, 1.f, 0.1f, 200.f));
+		culler.SetView(
+			(CullingView::Value)(CullingView::CubeMapFace0 + face),
+			engine::tests::ExtractFrustumPlanes(faceViewProj),
+			faceViewProj,
+			probe,
+			200.f);
+	}
+}
+
+}  // namespace
+
+int main()
+{
+	std::printf("%7s %6s %10s %8s %8s %10s\n", "chunks", "views", "ns / box", "main", "shadow", "cube map");
+
+	for (const int chunkCountPerSide : ChunkCountsPerSide)
+	{
+		const std::vector<BoxBounds> chunks = MakeChunkGrid(chunkCountPerSide);
+
+		for (const int activeViewCount : ActiveViewCounts)
+		{
+			MultiViewCuller culler;
+			SetViews(culler, activeViewCount);
+
+			double totalNs = 0.0;
+			for (int sweep = 0; sweep < SweepCount; sweep++)
+			{
+				const auto start = std::chrono::steady_clock::now();
+
+				culler.BeginSweep();
+				for (const BoxBounds& chunk : chunks)
+					culler.Cull(chunk);
+
+				totalNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+			}
+
+			float cubeMapRatio = 0.f;
+			for (int face = 0; face < 6; face++)
+				cubeMapRatio += culler.GetCulledRatio((CullingView::Value)(CullingView::CubeMapFace0 + face)) / 6.f;
+
+			std::printf(
+				"%7zu %6d %10.1f %7.1f%% %7.1f%% %9.1f%%\n",
+				chunks.size(),
+				activeViewCount,
+				totalNs / ((double)SweepCount * chunks.size()),
+				culler.GetCulledRatio(CullingView::Main) * 100.f,
+				culler.GetCulledRatio(CullingView::Shadow) * 100.f,
+				cubeMapRatio * 100.f);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,176 @@
+#include "TestMatrices.hpp"
+
+#include "OcclusionCuller.hpp"
+#include "RecordingScheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+using engine::gfx::Heightfield;
+using engine::gfx::OcclusionCuller;
+using engine::gfx::RecordingScheduler;
+using engine::math::BoxBounds;
+using engine::math::Float4x4;
+
+// Debitul occlusion culling-ului pe CPU intr-un cadru ca in RasterizationGraphics: ocluderul grosier al unui teren
+// cu dealuri, vazut de o camera care se roteste aproape de sol, apoi cutiile chunk-urilor si ale obiectelor testate
+// una cate una. Rasterizarea ruleaza pe rand si pe RecordingScheduler (un worker pentru fiecare nucleu in plus, cel
+// putin unul)
+namespace
+{
+
+constexpr int FrameCount = 200;
+constexpr int TerrainSidePointCount = 513;
+constexpr float TerrainSize = 1024.f;
+constexpr int BoxCount = 4096;
+
+constexpr uint32_t BufferWidth = 320;
+constexpr uint32_t BufferHeight = 192;
+constexpr uint32_t BandCount = 8;
+
+constexpr int OccluderCellCounts[] = {16, 32, 64};
+
+Heightfield MakeHills()
+{
+	Heightfield heightfield;
+	heightfield.sidePointCount = TerrainSidePointCount;
+	heightfield.minX = heightfield.minZ = -TerrainSize / 2.f;
+	heightfield.stepX = heightfield.stepZ = TerrainSize / (TerrainSidePointCount - 1);
+
+	for (int i = 0; i < TerrainSidePointCount; i++)
+	{
+		for (int j = 0; j < TerrainSidePointCount; j++)
+		{
+			const float x = heightfield.GetX(i);
+			const float z = heightfield.GetZ(j);
+			heightfield.heights.push_back(30.f * std::sin(x * 0.02f) * std::cos(z * 0.015f));
+		}
+	}
+
+	return heightfield;
+}
+
+// Cutii mici asezate pe teren, ca obiectele scenei
+std::vector<BoxBounds> MakeBoxes(const Heightfield& heightfield)
+{
+	std::mt19937 random(5);
+	std::uniform_int_distribution<int> point(0, TerrainSidePointCount - 1);
+
+	std::vector<BoxBounds> boxes;
+	boxes.reserve(BoxCount);
+	for (int k = 0; k < BoxCount; k++)
+	{
+		const int i = point(random);
+		const int j = point(random);
+		const float x = heightfield.GetX(i);
+		const float y = heightfield.GetHeight(i, j);
+		const float z = heightfield.GetZ(j);
+		boxes.push_back({{x - 2.f, y, z - 2.f}, {x + 2.f, y + 4.f, z + 2.f}});
+	}
+
+	return boxes;
+}
+
+Float4x4 MakeViewProj(int frame)
+{
+	const float angle = frame * 0.03f;
+	const engine::math::Float3 eye = {0.f, 15.f, 0.f};
+	const engine::math::Float3 target = {100.f * std::cos(angle), 20.f, 100.f * std::sin(angle)};
+
+	return engine::math::Multiply(
+		engine::tests::LookAtLH(eye, target, {0.f, 1.f, 0.f}),
+		engine::tests::PerspectiveFovLH(1.f, 16.f / 9.f, 0.5f, 1000.f));
+}
+
+void Measure(
+	const char* label,
+	const OcclusionCuller::Occluder& occluder,
+	const std::vector<BoxBounds>& boxes,
+	RecordingScheduler* scheduler)
+{
+	OcclusionCuller culler(BufferWidth, BufferHeight, BandCount);
+
+	double rasterizeMs = 0.0;
+	double testMs = 0.0;
+	uint64_t triangleCount = 0;
+	uint64_t occludedCount = 0;
+
+	for (int frame = 0; frame < FrameCount; frame++)
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		culler.BeginFrame(MakeViewProj(frame));
+		culler.AddOccluder(occluder);
+		culler.Rasterize(scheduler);
+
+		const auto rasterized = std::chrono::steady_clock::now();
+
+		for (const BoxBounds& box : boxes)
+		{
+			if (!culler.IsVisible(box))
+				occludedCount++;
+		}
+
+		const auto tested = std::chrono::steady_clock::now();
+
+		rasterizeMs += std::chrono::duration<double, std::milli>(rasterized - start).count();
+		testMs += std::chrono::duration<double, std::milli>(tested - rasterized).count();
+		triangleCount += culler.GetRasterizedTriangleCount();
+	}
+
+	char mode[32] = "serial";
+	if (scheduler)
+		std::snprintf(mode, sizeof(mode), "%u worker(s)", scheduler->GetWorkerCount());
+
+	std::printf(
+		"%-10s %-12s %10.0f %12.3f %12.1f %12.3f %12.1f %9.1f%%\n",
+		label,
+		mode,
+		(double)triangleCount / FrameCount,
+		rasterizeMs / FrameCount,
+		triangleCount / (rasterizeMs * 1e3),
+		testMs / FrameCount,
+		(double)BoxCount * FrameCount / (testMs * 1e3),
+		occludedCount * 100.0 / ((double)BoxCount * FrameCount));
+}
+
+}  // namespace
+
+int main()
+{
+	const Heightfield heightfield = MakeHills();
+	const std::vector<BoxBounds> boxes = MakeBoxes(heightfield);
+
+	RecordingScheduler scheduler;
+	scheduler.Create(std::max(2u, std::thread::hardware_concurrency()) - 1);
+
+	std::printf(
+		"%-10s %-12s %10s %12s %12s %12s %12s %10s\n",
+		"occluder",
+		"rasterize",
+		"triangles",
+		"ms / raster",
+		"Mtri / s",
+		"ms / tests",
+		"Mtests / s",
+		"occluded");
+
+	for (const int cellCount : OccluderCellCounts)
+	{
+		const OcclusionCuller::Occluder occluder = OcclusionCuller::BuildHeightfieldOccluder(heightfield, cellCount);
+
+		char label[16];
+		std::snprintf(label, sizeof(label), "%dx%d", cellCount, cellCount);
+
+		Measure(label, occluder, boxes, nullptr);
+		Measure(label, occluder, boxes, &scheduler);
+	}
+
+	return 0;
+}
@@ -0,0 +1,84 @@
+#include "TestMatrices.hpp"
+
+#include "ProjectedGrid.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+using engine::gfx::ProjectedGrid;
+using engine::math::Float4x4;
+
+// Costul pe CPU al grilei proiectate, refacuta in fiecare cadru in WaterRenderer::FrustumCulling: camera se roteste
+// deasupra apei, cu privirea putin in jos, ca sa apara si orizontul. Vertexul are asezarea lui Mesh::Vertex
+namespace
+{
+
+constexpr int FrameCount = 500;
+constexpr float WaterSize = 2000.f;
+
+constexpr uint32_t GridSizes[] = {64, 128, 256, 512};
+
+struct Vertex
+{
+	struct
+	{
+		float x, y, z;
+	} position;
+	float color[4];
+	float normal[3];
+	float tangent[3];
+	struct
+	{
+		float x, y;
+	} texC;
+};
+
+Float4x4 MakeViewProj(int frame)
+{
+	const float angle = frame * 0.0125f;
+	const engine::math::Float3 eye = {0.f, 25.f + 10.f * std::sin(angle * 3.f), 0.f};
+	const engine::math::Float3 target = {100.f * std::cos(angle), 0.f, 100.f * std::sin(angle)};
+
+	return engine::math::Multiply(
+		engine::tests::LookAtLH(eye, target, {0.f, 1.f, 0.f}),
+		engine::tests::PerspectiveFovLH(1.f, 16.f / 9.f, 0.5f, 1000.f));
+}
+
+}  // namespace
+
+int main()
+{
+	std::printf("%-10s %10s %12s %14s %10s\n", "grid", "vertices", "ms / frame", "ns / vertex", "visible");
+
+	for (const uint32_t size : GridSizes)
+	{
+		const ProjectedGrid grid(size, size, 4.f);
+		std::vector<Vertex> vertices;
+		int visibleCount = 0;
+
+		const auto start = std::chrono::steady_clock::now();
+
+		for (int frame = 0; frame < FrameCount; frame++)
+		{
+			if (grid.Generate(MakeViewProj(frame), WaterSize, WaterSize, vertices))
+				visibleCount++;
+		}
+
+		const double totalMs =
+			std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		std::printf(
+			"%4ux%-5u %10u %12.3f %14.1f %9d%%\n",
+			size,
+			size,
+			grid.GetVertexCount(),
+			totalMs / FrameCount,
+			totalMs * 1e6 / ((double)FrameCount * grid.GetVertexCount()),
+			visibleCount * 100 / FrameCount);
+	}
+
+	return 0;
+}
@@ -0,0 +1,139 @@
+#include "CommandContextPool.hpp"
+#include "RecordingScheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using engine::gfx::CommandContextPool;
+using engine::gfx::RecordingPass;
+using engine::gfx::RecordingScheduler;
+
+// Inregistrarea pass-urilor unui cadru din RasterizationGraphics pe thread-ul principal si pe 1, 3 si 7 workeri:
+// pass-ul principal, shadow map-ul si cele 6 fete ale cube map-ului. Fiecare pass ia un context din CommandContextPool
+// (cu 3 cadre in zbor, ca FrameResources) si scrie in el draw-uri simulate; lucrul pe draw tine locul apelurilor pe
+// command list. Speedup-ul e limitat de nucleele masinii, afisate in antet
+namespace
+{
+
+constexpr int FrameCount = 60;
+constexpr uint64_t FramesInFlight = 3;
+
+constexpr uint32_t WorkerCounts[] = {0, 1, 3, 7};
+
+// Draw-urile fiecarui pass: principal, shadow map, fetele cube map-ului
+constexpr uint32_t PassDrawCounts[] = {4000, 3000, 600, 600, 600, 600, 600, 600};
+
+struct Command
+{
+	uint64_t state;
+	uint32_t arguments[6];
+};
+
+// Tine locul unui command list: comenzile raman alocate intre cadre, ca memoria unui command allocator
+struct FakeContext
+{
+	std::vector<Command> commands;
+
+	void Reset() { commands.clear(); }
+
+	void Draw(uint32_t drawIndex)
+	{
+		// Validarea si codificarea unui draw, aproximate printr-un hash al starii
+		uint64_t state = drawIndex * 0x9E3779B97F4A7C15ull;
+		for (int i = 0; i < 64; i++)
+			state = (state ^ (state >> 29)) * 0xBF58476D1CE4E5B9ull;
+
+		commands.push_back({state, {drawIndex, 36, 1, drawIndex * 36, 0, drawIndex}});
+	}
+};
+
+struct Result
+{
+	double frameMs = 0.0;
+	size_t contextCount = 0;
+	uint64_t checksum = 0;
+};
+
+Result Measure(uint32_t workerCount)
+{
+	RecordingScheduler scheduler;
+	scheduler.Create(workerCount);
+
+	CommandContextPool<FakeContext> pool;
+	pool.Create([]() { return std::make_unique<FakeContext>(); });
+
+	constexpr size_t PassCount = sizeof(PassDrawCounts) / sizeof(PassDrawCounts[0]);
+	std::vector<FakeContext*> contexts(PassCount, nullptr);
+
+	// Lista de pass-uri se construieste o data, ca in OcclusionCuller; contextul fiecarui cadru se citeste din contexts
+	std::vector<RecordingPass> passes(PassCount);
+	for (size_t pass = 0; pass < PassCount; pass++)
+	{
+		passes[pass].begin = [&contexts, pass]() { contexts[pass]->Reset(); };
+		passes[pass].record = [&contexts, pass]()
+		{
+			for (uint32_t draw = 0; draw < PassDrawCounts[pass]; draw++)
+				contexts[pass]->Draw(draw);
+		};
+	}
+
+	Result result;
+	const auto start = std::chrono::steady_clock::now();
+
+	for (uint64_t frame = 1; frame <= FrameCount; frame++)
+	{
+		// GPU-ul a terminat cadrele mai vechi de FramesInFlight
+		const uint64_t completedFence = frame > FramesInFlight ? frame - FramesInFlight : 0;
+		for (FakeContext*& context : contexts)
+			context = &pool.Acquire(completedFence);
+
+		scheduler.Execute(passes);
+
+		for (FakeContext* context : contexts)
+		{
+			result.checksum += context->commands.back().state;
+			pool.Release(*context, frame);
+		}
+	}
+
+	result.frameMs =
+		std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / FrameCount;
+	result.contextCount = pool.GetSize();
+
+	return result;
+}
+
+}  // namespace
+
+int main()
+{
+	std::printf("hardware threads: %u\n", std::max(1u, std::thread::hardware_concurrency()));
+	std::printf("%8s %12s %10s %10s\n", "threads", "ms / frame", "speedup", "contexts");
+
+	double serialMs = 0.0;
+	uint64_t serialChecksum = 0;
+	for (const uint32_t workerCount : WorkerCounts)
+	{
+		const Result result = Measure(workerCount);
+		if (workerCount == 0)
+		{
+			serialMs = result.frameMs;
+			serialChecksum = result.checksum;
+		}
+
+		std::printf(
+			"%8u %12.3f %9.2fx %10zu%s\n",
+			workerCount + 1,
+			result.frameMs,
+			serialMs / result.frameMs,
+			result.contextCount,
+			result.checksum == serialChecksum ? "" : "  (alte comenzi decat serial)");
+	}
+
+	return 0;
+}
@@ -0,0 +1,121 @@
+#include "RenderQueue.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using engine::gfx::RadixSort;
+using engine::gfx::SortEntry;
+
+namespace SortKey = engine::gfx::SortKey;
+
+// Sortarea cheilor unei cozi de draw-uri (RenderQueue::Sort) cu radix sort-ul pe octeti, fata de std::stable_sort
+// (aceeasi garantie: la chei egale ramane ordinea de submit) si std::sort. Cheile de scena au putine layer-e, PSO-uri
+// si materiale, deci radix sort-ul sare trecerile cu un singur octet; cheile aleatoare folosesc toate cele 8 treceri
+namespace
+{
+
+constexpr size_t PacketCounts[] = {10000, 100000, 1000000};
+
+// Cate sortari se masoara pentru fiecare dimensiune, ca sa ramana ~1M de pachete sortate in total
+constexpr size_t SortedPacketsPerRow = 1000000;
+
+std::vector<SortEntry> MakeSceneEntries(size_t count)
+{
+	std::mt19937 random(3);
+	std::vector<SortEntry> entries(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		const uint32_t layer = random() % 3;
+		const uint32_t psoID = random() % 16;
+		const uint32_t materialID = random() % 64;
+		const uint32_t meshID = random() % 256;
+		const uint32_t depth = SortKey::QuantizeDepth((float)(random() % 1000), 1000.f);
+		entries[i] = {SortKey::Make(layer, psoID, materialID, meshID, depth), (uint32_t)i};
+	}
+
+	return entries;
+}
+
+std::vector<SortEntry> MakeRandomEntries(size_t count)
+{
+	std::mt19937_64 random(3);
+	std::vector<SortEntry> entries(count);
+	for (size_t i = 0; i < count; i++)
+		entries[i] = {random(), (uint32_t)i};
+
+	return entries;
+}
+
+bool IsSortedByKey(const std::vector<SortEntry>& entries)
+{
+	return std::is_sorted(
+		entries.begin(), entries.end(), [](const SortEntry& a, const SortEntry& b) { return a.key < b.key; });
+}
+
+// Timpul mediu pe sortare, in ms; fiecare sortare porneste de la aceeasi ordine de submit
+template <typename SortFunction>
+double Measure(const std::vector<SortEntry>& source, SortFunction sort)
+{
+	const size_t repeatCount = std::max<size_t>(1, SortedPacketsPerRow / source.size());
+
+	std::vector<SortEntry> entries;
+	double totalMs = 0.0;
+	for (size_t repeat = 0; repeat < repeatCount; repeat++)
+	{
+		entries = source;
+
+		const auto start = std::chrono::steady_clock::now();
+		sort(entries);
+		totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		if (!IsSortedByKey(entries))
+		{
+			std::printf("sortare gresita\n");
+			return -1.0;
+		}
+	}
+
+	return totalMs / repeatCount;
+}
+
+void PrintRow(size_t count, const char* keys, const char* order, double ms)
+{
+	std::printf("%9zu  %-7s %-13s %10.3f %12.1f\n", count, keys, order, ms, ms * 1e6 / count);
+}
+
+}  // namespace
+
+int main()
+{
+	std::printf("%9s  %-7s %-13s %10s %12s\n", "packets", "keys", "sort", "ms / sort", "ns / packet");
+
+	std::vector<SortEntry> scratch;
+	const auto radixSort = [&scratch](std::vector<SortEntry>& entries) { RadixSort(entries, scratch); };
+	const auto stableSort = [](std::vector<SortEntry>& entries)
+	{
+		std::stable_sort(
+			entries.begin(), entries.end(), [](const SortEntry& a, const SortEntry& b) { return a.key < b.key; });
+	};
+	const auto unstableSort = [](std::vector<SortEntry>& entries)
+	{
+		std::sort(entries.begin(), entries.end(), [](const SortEntry& a, const SortEntry& b) { return a.key < b.key; });
+	};
+
+	for (const size_t count : PacketCounts)
+	{
+		const std::vector<SortEntry> scene = MakeSceneEntries(count);
+		const std::vector<SortEntry> random = MakeRandomEntries(count);
+
+		PrintRow(count, "scene", "radix", Measure(scene, radixSort));
+		PrintRow(count, "scene", "stable_sort", Measure(scene, stableSort));
+		PrintRow(count, "scene", "sort", Measure(scene, unstableSort));
+		PrintRow(count, "random", "radix", Measure(random, radixSort));
+		PrintRow(count, "random", "stable_sort", Measure(random, stableSort));
+	}
+
+	return 0;
+}
@@ -0,0 +1,167 @@
+#include "TerrainPVS.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+using engine::gfx::Heightfield;
+using engine::gfx::TerrainPVS;
+using engine::math::BoxBounds;
+
+// Bake-ul PVS-ului pe un teren de marimea celui din RasterizationGraphics (400 x 400, grila de 145 x 145 puncte) cu
+// tintele de acolo: 16 x 16 chunk-uri de teren si 20 x 20 de apa. Se variaza rezolutia grilei de celule si numarul de
+// puncte de vedere; pentru fiecare se masoara bake-ul, salvarea si incarcarea fisierului
+namespace
+{
+
+constexpr int SidePointCount = 145;
+constexpr float TerrainSize = 400.f;
+constexpr int TerrainChunksPerSide = 16;
+constexpr int WaterChunksPerSide = 20;
+constexpr float WaterLevel = 0.f;
+
+struct Configuration
+{
+	int cellsPerSide;
+	int viewpointsPerSide;
+};
+
+// Timpul creste liniar cu numarul de celule: grila de 16 x 16 din scena costa de 4 ori cat cea de 8 x 8
+constexpr Configuration Configurations[] = {{4, 2}, {8, 2}, {8, 3}};
+
+// Dealuri si vai, cu amplitudinea terenului din scena
+float GetHeight(float x, float z)
+{
+	return 25.f * std::sin(x * 0.015f) * std::cos(z * 0.012f) + 8.f * std::sin(x * 0.05f + z * 0.04f);
+}
+
+Heightfield MakeTerrain()
+{
+	Heightfield heightfield;
+	heightfield.sidePointCount = SidePointCount;
+	heightfield.minX = heightfield.minZ = -TerrainSize / 2.f;
+	heightfield.stepX = heightfield.stepZ = TerrainSize / (SidePointCount - 1);
+
+	for (int i = 0; i < SidePointCount; i++)
+	{
+		for (int j = 0; j < SidePointCount; j++)
+			heightfield.heights.push_back(GetHeight(heightfield.GetX(i), heightfield.GetZ(j)));
+	}
+
+	return heightfield;
+}
+
+// Chunk-urile terenului acopera inaltimile din interiorul lor; cele ale apei sunt plate
+std::vector<BoxBounds> MakeTargets(const Heightfield& heightfield)
+{
+	std::vector<BoxBounds> targets;
+
+	const int pointsPerChunk = (SidePointCount - 1) / TerrainChunksPerSide;
+	for (int a = 0; a < TerrainChunksPerSide; a++)
+	{
+		for (int b = 0; b < TerrainChunksPerSide; b++)
+		{
+			float minY = heightfield.GetHeight(a * pointsPerChunk, b * pointsPerChunk);
+			float maxY = minY;
+			for (int i = a * pointsPerChunk; i <= (a + 1) * pointsPerChunk; i++)
+			{
+				for (int j = b * pointsPerChunk; j <= (b + 1) * pointsPerChunk; j++)
+				{
+					minY = std::min(minY, heightfield.GetHeight(i, j));
+					maxY = std::max(maxY, heightfield.GetHeight(i, j));
+				}
+			}
+
+			targets.push_back(
+				{{heightfield.GetX(a * pointsPerChunk), minY, heightfield.GetZ(b * pointsPerChunk)},
+				 {heightfield.GetX((a + 1) * pointsPerChunk), maxY, heightfield.GetZ((b + 1) * pointsPerChunk)}});
+		}
+	}
+
+	const float waterChunkSize = TerrainSize / WaterChunksPerSide;
+	for (int a = 0; a < WaterChunksPerSide; a++)
+	{
+		for (int b = 0; b < WaterChunksPerSide; b++)
+		{
+			const float minX = a * waterChunkSize - TerrainSize / 2.f;
+			const float minZ = b * waterChunkSize - TerrainSize / 2.f;
+			targets.push_back({{minX, WaterLevel, minZ}, {minX + waterChunkSize, WaterLevel, minZ + waterChunkSize}});
+		}
+	}
+
+	return targets;
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+int main()
+{
+	const Heightfield heightfield = MakeTerrain();
+	const std::vector<BoxBounds> targets = MakeTargets(heightfield);
+	const std::wstring path = (std::filesystem::temp_directory_path() / L"TerrainPVSBakeBenchmark.pvs").wstring();
+
+	std::printf(
+		"%-8s %10s %8s %8s %12s %12s %10s %12s %10s %10s\n",
+		"cells",
+		"viewpoints",
+		"levels",
+		"targets",
+		"bake ms",
+		"us / cell",
+		"visible",
+		"file bytes",
+		"save ms",
+		"load ms");
+
+	for (const Configuration& configuration : Configurations)
+	{
+		TerrainPVS::Properties properties = {};
+		properties.cellsPerSide = configuration.cellsPerSide;
+		properties.viewpointsPerSide = configuration.viewpointsPerSide;
+		properties.heightLevels = 4;
+		properties.minCameraHeightAboveTerrain = 2.f;
+		properties.maxCameraHeight = 120.f;
+		properties.heightMargin = 1.f;
+		properties.dilateNeighbours = true;
+
+		auto start = std::chrono::steady_clock::now();
+		const TerrainPVS::Ptr pvs = TerrainPVS::Bake(heightfield, targets, properties);
+		const double bakeMs = MillisecondsSince(start);
+
+		start = std::chrono::steady_clock::now();
+		pvs->Save(path);
+		const double saveMs = MillisecondsSince(start);
+
+		start = std::chrono::steady_clock::now();
+		const TerrainPVS::Ptr loaded =
+			TerrainPVS::Load(path, TerrainPVS::ComputeSourceHash(heightfield, targets, properties));
+		const double loadMs = MillisecondsSince(start);
+
+		std::printf(
+			"%3dx%-4d %10d %8d %8u %12.1f %12.1f %9.1f%% %12zu %10.2f %10.2f%s\n",
+			configuration.cellsPerSide,
+			configuration.cellsPerSide,
+			configuration.viewpointsPerSide * configuration.viewpointsPerSide * 3,
+			properties.heightLevels,
+			pvs->GetTargetCount(),
+			bakeMs,
+			bakeMs * 1e3 / pvs->GetCellCount(),
+			pvs->GetVisibleRatio() * 100.f,
+			pvs->GetCompressedSize(),
+			saveMs,
+			loadMs,
+			loaded ? "" : "  (load failed)");
+	}
+
+	std::filesystem::remove(path);
+	return 0;
+}
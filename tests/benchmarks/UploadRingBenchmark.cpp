@@ -0,0 +1,215 @@
+#include "UploadRingAllocator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <random>
+#include <vector>
+
+using engine::gfx::UploadRingAllocator;
+
+// Uploadurile de la pornire (vertex si index buffere) prin UploadRingAllocator, cu logica din
+// UploadManager::UploadBuffer: copierile se aduna intr-un lot, lotul pleaca doar cand ring-ul e plin, iar uploadurile
+// mai mari decat ring-ul primesc un buffer dedicat. Bufferul de upload e o alocare pe heap si coada de copiere termina
+// un submit cand e asteptat, deci se masoara partea de CPU: timpul, debitul si de cate ori CPU-ul asteapta GPU-ul.
+// Randul "per upload" e calea veche: un buffer de upload nou si un Flush(true) pentru fiecare buffer. Ring-ul se
+// creeaza inaintea masuratorii, ca la pornirea UploadManager
+namespace
+{
+
+constexpr uint64_t MB = 1024 * 1024;
+constexpr uint64_t BufferPlacementAlignment = 256;
+
+constexpr uint64_t RingCapacities[] = {4 * MB, 16 * MB, 64 * MB};
+
+constexpr int UploadCount = 2000;
+
+struct Result
+{
+	double ms = 0.0;
+	uint64_t bytes = 0;
+	uint32_t submitCount = 0;
+	uint32_t waitCount = 0;
+	uint32_t dedicatedCount = 0;
+};
+
+// Multe buffere mici (obiecte, chunk-uri), cateva medii si putine mari (terenul, apa)
+std::vector<uint64_t> MakeUploadSizes()
+{
+	std::mt19937 random(44);
+	std::uniform_real_distribution<float> chance(0.f, 1.f);
+
+	std::vector<uint64_t> sizes(UploadCount);
+	for (uint64_t& size : sizes)
+	{
+		const float kind = chance(random);
+		if (kind < 0.7f)
+			size = 1024 + random() % (64 * 1024);
+		else if (kind < 0.97f)
+			size = 64 * 1024 + random() % MB;
+		else
+			size = MB + random() % (12 * MB);
+	}
+
+	return sizes;
+}
+
+class HostUploadManager
+{
+public:
+	explicit HostUploadManager(uint64_t ringCapacity) : m_ringData(std::make_unique<uint8_t[]>(ringCapacity))
+	{
+		m_ring.Create(ringCapacity);
+	}
+
+	void Upload(const uint8_t* data, uint64_t size, Result& result)
+	{
+		m_ring.Reclaim(m_completedFenceValue);
+
+		if (size > m_ring.GetCapacity())
+		{
+			std::unique_ptr<uint8_t[]> dedicated(new uint8_t[size]);
+			std::memcpy(dedicated.get(), data, size);
+			m_dedicatedUploads.push_back({m_fenceValue + 1, std::move(dedicated)});
+			result.dedicatedCount++;
+			m_hasBatch = true;
+			return;
+		}
+
+		uint64_t offset = m_ring.Allocate(size, BufferPlacementAlignment);
+		while (offset == UploadRingAllocator::InvalidOffset)
+		{
+			Submit(result);
+			WaitForFence(m_ring.GetOldestFenceValue());
+			result.waitCount++;
+
+			m_ring.Reclaim(m_completedFenceValue);
+			offset = m_ring.Allocate(size, BufferPlacementAlignment);
+		}
+
+		std::memcpy(m_ringData.get() + offset, data, size);
+		m_hasBatch = true;
+	}
+
+	void WaitForIdle(Result& result)
+	{
+		Submit(result);
+		WaitForFence(m_fenceValue);
+		m_ring.Reclaim(m_completedFenceValue);
+	}
+
+private:
+	struct DedicatedUpload
+	{
+		uint64_t fenceValue;
+		std::unique_ptr<uint8_t[]> data;
+	};
+
+	void Submit(Result& result)
+	{
+		if (!m_hasBatch)
+			return;
+
+		m_ring.Retire(++m_fenceValue);
+		m_hasBatch = false;
+		result.submitCount++;
+	}
+
+	void WaitForFence(uint64_t fenceValue)
+	{
+		m_completedFenceValue = std::max(m_completedFenceValue, fenceValue);
+
+		while (!m_dedicatedUploads.empty() && m_dedicatedUploads.front().fenceValue <= m_completedFenceValue)
+			m_dedicatedUploads.pop_front();
+	}
+
+	UploadRingAllocator m_ring;
+	std::unique_ptr<uint8_t[]> m_ringData;
+	std::deque<DedicatedUpload> m_dedicatedUploads;
+
+	uint64_t m_fenceValue = 0;
+	uint64_t m_completedFenceValue = 0;
+	bool m_hasBatch = false;
+};
+
+Result MeasureRing(const std::vector<uint64_t>& sizes, const std::vector<uint8_t>& source, uint64_t ringCapacity)
+{
+	Result result;
+	HostUploadManager manager(ringCapacity);
+
+	const auto start = std::chrono::steady_clock::now();
+	for (const uint64_t size : sizes)
+	{
+		manager.Upload(source.data(), size, result);
+		result.bytes += size;
+	}
+
+	manager.WaitForIdle(result);
+
+	result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+Result MeasurePerUpload(const std::vector<uint64_t>& sizes, const std::vector<uint8_t>& source)
+{
+	Result result;
+	const auto start = std::chrono::steady_clock::now();
+
+	for (const uint64_t size : sizes)
+	{
+		std::unique_ptr<uint8_t[]> upload(new uint8_t[size]);
+		std::memcpy(upload.get(), source.data(), size);
+		result.bytes += size;
+
+		result.dedicatedCount++;
+		result.submitCount++;
+		result.waitCount++;
+	}
+
+	result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+void PrintRow(const char* label, const Result& result)
+{
+	std::printf(
+		"%-12s %10.1f %10.3f %10.2f %9u %9u %11u\n",
+		label,
+		result.bytes / (double)MB,
+		result.ms,
+		result.bytes / (double)MB / 1024.0 / (result.ms / 1000.0),
+		result.submitCount,
+		result.waitCount,
+		result.dedicatedCount);
+}
+
+}  // namespace
+
+int main()
+{
+	const std::vector<uint64_t> sizes = MakeUploadSizes();
+
+	uint64_t largestSize = 0;
+	for (const uint64_t size : sizes)
+		largestSize = std::max(largestSize, size);
+
+	const std::vector<uint8_t> source(largestSize, 0x5A);
+
+	std::printf(
+		"%-12s %10s %10s %10s %9s %9s %11s\n", "upload", "MB", "ms", "GB / s", "submits", "waits", "dedicated");
+
+	PrintRow("per upload", MeasurePerUpload(sizes, source));
+
+	for (const uint64_t capacity : RingCapacities)
+	{
+		char label[32];
+		std::snprintf(label, sizeof(label), "ring %llu MB", (unsigned long long)(capacity / MB));
+		PrintRow(label, MeasureRing(sizes, source, capacity));
+	}
+
+	return 0;
+}
@@ -0,0 +1,96 @@
+#include "TestFramework.hpp"
+
+#include "engine/core/AllocationCounter.hpp"
+#include "engine/core/FrameArena.hpp"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using engine::core::GetAllocationCount;
+using engine::core::UncountedAllocationScope;
+
+// Se compileaza cu _DEBUG (vezi tests/CMakeLists.txt), ca operator new sa fie inlocuit
+static_assert(engine::core::AllocationCountingEnabled);
+
+namespace
+{
+
+// Compilatorul poate elimina perechile new / delete nefolosite; adresa scrisa aici le pastreaza
+const void* volatile g_escaped = nullptr;
+
+template <typename T>
+void Escape(const T& pointer)
+{
+	g_escaped = &*pointer;
+}
+
+}  // namespace
+
+TEST_CASE(OperatorNewIsCounted)
+{
+	const uint64_t before = GetAllocationCount();
+
+	std::unique_ptr<int> value = std::make_unique<int>(1);
+	Escape(value);
+	std::vector<int> values;
+	values.reserve(16);
+	Escape(values.data());
+
+	CHECK(GetAllocationCount() - before == 2);
+
+	// new[] trece prin operator new
+	std::unique_ptr<int[]> array(new int[8]);
+	Escape(array.get());
+	CHECK(GetAllocationCount() - before == 3);
+}
+
+TEST_CASE(UncountedScopeAppliesToTheCurrentThread)
+{
+	const uint64_t before = GetAllocationCount();
+
+	{
+		UncountedAllocationScope uncountedScope;
+		std::unique_ptr<int> value = std::make_unique<int>(1);
+		Escape(value);
+
+		{
+			UncountedAllocationScope nestedScope;
+			std::unique_ptr<int> nested = std::make_unique<int>(2);
+			Escape(nested);
+		}
+
+		// Iesirea din scope-ul interior nu reporneste numaratoarea
+		std::unique_ptr<int> afterNested = std::make_unique<int>(3);
+		Escape(afterNested);
+		CHECK(GetAllocationCount() == before);
+
+		// Alte thread-uri se numara in continuare (pornirea thread-ului poate aloca si ea)
+		std::thread worker(
+			[]()
+			{
+				std::unique_ptr<int> workerValue = std::make_unique<int>(4);
+				Escape(workerValue);
+			});
+		worker.join();
+		CHECK(GetAllocationCount() - before >= 1);
+	}
+
+	const uint64_t afterScope = GetAllocationCount();
+	std::unique_ptr<int> value = std::make_unique<int>(5);
+	Escape(value);
+	CHECK(GetAllocationCount() - afterScope == 1);
+}
+
+TEST_CASE(FrameVectorDoesNotCount)
+{
+	engine::core::FrameArena::BeginFrame();
+
+	const uint64_t before = GetAllocationCount();
+
+	engine::core::FrameVector<int> values;
+	for (int i = 0; i < 10000; i++)
+		values.push_back(i);
+
+	CHECK(GetAllocationCount() == before);
+}
@@ -0,0 +1,100 @@
+#include "TestFramework.hpp"
+
+#include "engine/core/FixedQueue.hpp"
+
+#include <string>
+
+using engine::core::FixedQueue;
+
+namespace
+{
+
+// Numara obiectele in viata, ca sa se vada ca Pop / Clear / destructorul le distrug
+struct Counted
+{
+	explicit Counted(int value) : value(value) { liveCount++; }
+	Counted(const Counted& other) : value(other.value) { liveCount++; }
+	~Counted() { liveCount--; }
+
+	int value;
+
+	static inline int liveCount = 0;
+};
+
+}  // namespace
+
+TEST_CASE(ItemsLeaveInPushOrder)
+{
+	FixedQueue<int, 4> queue;
+	CHECK(queue.IsEmpty());
+	CHECK(queue.GetCapacity() == 4);
+
+	queue.Push(1);
+	queue.Push(2);
+	queue.Push(3);
+	CHECK(queue.GetSize() == 3);
+
+	CHECK(queue.Front() == 1);
+	queue.Pop();
+	CHECK(queue.Front() == 2);
+	queue.Pop();
+	CHECK(queue.Front() == 3);
+	queue.Pop();
+	CHECK(queue.IsEmpty());
+}
+
+TEST_CASE(FullQueueDropsTheOldestItem)
+{
+	FixedQueue<std::string, 4> queue;
+
+	for (int i = 0; i < 10; i++)
+		queue.Push(std::string(40, (char)('a' + i)));
+
+	CHECK(queue.GetSize() == 4);
+	CHECK(queue.Front()[0] == 'g');
+
+	queue.Pop();
+	CHECK(queue.Front()[0] == 'h');
+}
+
+TEST_CASE(IndicesWrapAround)
+{
+	FixedQueue<int, 3> queue;
+
+	for (int i = 0; i < 20; i++)
+	{
+		queue.Push(i);
+		queue.Push(i + 100);
+		CHECK(queue.Front() == i);
+		queue.Pop();
+		CHECK(queue.Front() == i + 100);
+		queue.Pop();
+	}
+
+	CHECK(queue.IsEmpty());
+}
+
+TEST_CASE(ClearAndDestructorDestroyItems)
+{
+	{
+		FixedQueue<Counted, 4> queue;
+		for (int i = 0; i < 6; i++)
+			queue.Push(Counted(i));
+
+		CHECK(Counted::liveCount == 4);
+
+		queue.Pop();
+		CHECK(Counted::liveCount == 3);
+
+		queue.Clear();
+		CHECK(Counted::liveCount == 0);
+		CHECK(queue.IsEmpty());
+
+		queue.Push(Counted(7));
+		queue.Push(Counted(8));
+		CHECK(queue.Front().value == 7);
+		CHECK(Counted::liveCount == 2);
+	}
+
+	CHECK(Counted::liveCount == 0);
+}
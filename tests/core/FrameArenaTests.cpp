@@ -0,0 +1,149 @@
+#include "TestFramework.hpp"
+
+#include "engine/core/FrameArena.hpp"
+
+#include <cstdint>
+#include <string>
+#include <thread>
+
+using engine::core::FrameAllocator;
+using engine::core::FrameArena;
+using engine::core::FrameVector;
+
+namespace
+{
+
+bool IsAligned(const void* pointer, size_t alignment)
+{
+	return ((uintptr_t)pointer & (alignment - 1)) == 0;
+}
+
+}  // namespace
+
+TEST_CASE(AllocationsRespectAlignment)
+{
+	FrameArena arena;
+
+	for (size_t alignment = 1; alignment <= 4096; alignment *= 2)
+	{
+		CHECK(IsAligned(arena.Allocate(3, alignment), alignment));
+		CHECK(IsAligned(arena.Allocate(1, alignment), alignment));
+	}
+
+	// Marimea 0 primeste tot o adresa distincta
+	const void* first = arena.Allocate(0, 8);
+	const void* second = arena.Allocate(0, 8);
+	CHECK(first != second);
+}
+
+TEST_CASE(AllocationsDoNotOverlap)
+{
+	FrameArena arena;
+
+	unsigned char* previous = nullptr;
+	for (int i = 0; i < 100; i++)
+	{
+		unsigned char* bytes = (unsigned char*)arena.Allocate(1000, 16);
+		for (int j = 0; j < 1000; j++)
+			bytes[j] = (unsigned char)i;
+
+		if (previous != nullptr)
+			CHECK(previous[999] == (unsigned char)(i - 1));
+
+		previous = bytes;
+	}
+
+	CHECK(arena.GetUsedSize() >= 100 * 1000);
+}
+
+TEST_CASE(GrowthIsConsolidatedByReset)
+{
+	FrameArena arena;
+
+	for (int i = 0; i < 1000; i++)
+		arena.Allocate(1000, 16);
+	CHECK(IsAligned(arena.Allocate(1 << 20, 256), 256));
+
+	CHECK(arena.GetGrowCount() > 1);
+	const size_t capacity = arena.GetCapacity();
+	const size_t peakSize = arena.GetPeakSize();
+
+	arena.Reset();
+	CHECK(arena.GetUsedSize() == 0);
+	CHECK(arena.GetCapacity() == capacity);
+
+	// Dupa Reset un singur bloc cuprinde tot cadrul, deci cadrele identice nu mai cresc arena
+	const uint64_t growCount = arena.GetGrowCount();
+	for (int frame = 0; frame < 10; frame++)
+	{
+		for (int i = 0; i < 1000; i++)
+			arena.Allocate(1000, 16);
+		arena.Allocate(1 << 20, 256);
+
+		arena.Reset();
+	}
+
+	CHECK(arena.GetGrowCount() == growCount);
+	CHECK(arena.GetPeakSize() >= peakSize);
+}
+
+TEST_CASE(ThreadArenaIsEmptiedAfterBeginFrame)
+{
+	{
+		FrameVector<int> values(100, 7);
+		CHECK(values[99] == 7);
+
+		std::basic_string<char, std::char_traits<char>, FrameAllocator<char>> text(
+			"a string longer than the small buffer of std::string");
+		CHECK(text.size() > 32);
+	}
+
+	CHECK(FrameArena::GetThreadArena().GetUsedSize() > 0);
+
+	const uint64_t frame = FrameArena::GetFrame();
+	FrameArena::BeginFrame();
+	CHECK(FrameArena::GetFrame() == frame + 1);
+	CHECK(FrameArena::GetThreadArena().GetUsedSize() == 0);
+}
+
+TEST_CASE(EachThreadHasItsOwnArena)
+{
+	FrameArena::BeginFrame();
+
+	FrameVector<char> mainValues(64);
+	const FrameArena* pMainArena = &FrameArena::GetThreadArena();
+	const size_t mainUsedSize = pMainArena->GetUsedSize();
+
+	const FrameArena* pWorkerArena = nullptr;
+	size_t workerUsedSize = 0;
+
+	std::thread worker(
+		[&]()
+		{
+			FrameVector<double> values(1000, 1.0);
+			pWorkerArena = &FrameArena::GetThreadArena();
+			workerUsedSize = pWorkerArena->GetUsedSize();
+		});
+	worker.join();
+
+	CHECK(pWorkerArena != pMainArena);
+	CHECK(workerUsedSize >= 1000 * sizeof(double));
+	CHECK(FrameArena::GetThreadArena().GetUsedSize() == mainUsedSize);
+}
+
+TEST_CASE(BypassAllocatesFromTheHeap)
+{
+	FrameArena::BeginFrame();
+	FrameArena::SetBypass(true);
+
+	{
+		FrameVector<int> values(1000, 3);
+		CHECK(values[999] == 3);
+		CHECK(FrameArena::GetThreadArena().GetUsedSize() == 0);
+	}
+
+	FrameArena::SetBypass(false);
+
+	FrameVector<int> values(1000, 3);
+	CHECK(FrameArena::GetThreadArena().GetUsedSize() >= 1000 * sizeof(int));
+}
@@ -0,0 +1,64 @@
+#include "TestFramework.hpp"
+
+#include "BindlessRecordArray.hpp"
+
+#include <cstdint>
+
+using engine::gfx::BindlessRecordArray;
+
+TEST_CASE(CapacityGrowsByDoubling)
+{
+	using Array = BindlessRecordArray<uint32_t>;
+
+	CHECK(Array::GetGrownCapacity(0, 1) == Array::MinCapacity);
+	CHECK(Array::GetGrownCapacity(64, 64) == 64);
+	CHECK(Array::GetGrownCapacity(64, 65) == 128);
+	CHECK(Array::GetGrownCapacity(64, 1000) == 1024);
+	CHECK(Array::GetGrownCapacity(256, 10) == 256);
+
+	Array records;
+	records.Reserve(100);
+	CHECK(records.GetCapacity() == 128);
+	CHECK(records.GetCount() == 0);
+
+	records.Write(300, 1);
+	CHECK(records.GetCapacity() == 512);
+	CHECK(records.GetCount() == 301);
+}
+
+TEST_CASE(WritesTrackTheDirtyRange)
+{
+	BindlessRecordArray<uint32_t> records;
+	CHECK(!records.IsDirty());
+
+	records.Write(5, 50);
+	records.Write(2, 20);
+	records.Write(3, 30);
+
+	CHECK(records.IsDirty());
+	CHECK(records.GetDirtyBegin() == 2);
+	CHECK(records.GetDirtyEnd() == 6);
+	CHECK(records[2] == 20 && records[5] == 50);
+	CHECK(records.GetData()[3] == 30);
+
+	records.ClearDirty();
+	CHECK(!records.IsDirty());
+
+	records.Write(4, 40);
+	CHECK(records.GetDirtyBegin() == 4);
+	CHECK(records.GetDirtyEnd() == 5);
+}
+
+TEST_CASE(MarkAllDirtyCoversEveryRecord)
+{
+	BindlessRecordArray<uint32_t> records;
+	records.MarkAllDirty();
+	CHECK(!records.IsDirty());
+
+	records.Write(9, 1);
+	records.ClearDirty();
+	records.MarkAllDirty();
+
+	CHECK(records.GetDirtyBegin() == 0);
+	CHECK(records.GetDirtyEnd() == 10);
+}
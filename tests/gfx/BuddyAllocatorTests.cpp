@@ -0,0 +1,166 @@
+#include "TestFramework.hpp"
+
+#include "BuddyAllocator.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <random>
+
+using engine::gfx::BuddyAllocator;
+
+TEST_CASE(SmallAllocationsUseTheMinimumBlock)
+{
+	BuddyAllocator allocator;
+	allocator.Create(1 << 20, 256);
+
+	CHECK(allocator.Allocate(100, 16) == 0);
+	CHECK(allocator.GetBlockSize(0) == 256);
+	CHECK(allocator.Allocate(300, 16) == 512);
+	CHECK(allocator.GetBlockSize(512) == 512);
+	// Jumatatea ramasa libera dupa prima injumatatire
+	CHECK(allocator.Allocate(256, 256) == 256);
+
+	CHECK(allocator.GetUsedSize() == 1024);
+	CHECK(allocator.GetAllocationCount() == 3);
+}
+
+TEST_CASE(AlignmentLargerThanSizePadsTheBlock)
+{
+	BuddyAllocator allocator;
+	allocator.Create(1 << 20, 256);
+
+	CHECK(allocator.Allocate(256, 256) == 0);
+
+	const uint64_t offset = allocator.Allocate(4096, 65536);
+	REQUIRE(offset != BuddyAllocator::InvalidOffset);
+	CHECK(offset % 65536 == 0);
+	CHECK(offset != 0);
+	// Alinierea se obtine dintr-un bloc cat alinierea, deci padding-ul se vede in memoria folosita
+	CHECK(allocator.GetBlockSize(offset) == 65536);
+	CHECK(allocator.GetUsedSize() == 256 + 65536);
+}
+
+TEST_CASE(RequestsLargerThanCapacityFail)
+{
+	BuddyAllocator allocator;
+	allocator.Create(1 << 16, 256);
+
+	CHECK(allocator.Allocate(0, 16) == BuddyAllocator::InvalidOffset);
+	CHECK(allocator.Allocate((1 << 16) + 1, 16) == BuddyAllocator::InvalidOffset);
+	CHECK(allocator.Allocate(16, 1 << 17) == BuddyAllocator::InvalidOffset);
+	CHECK(allocator.Allocate(1 << 16, 16) == 0);
+	CHECK(allocator.Allocate(1, 1) == BuddyAllocator::InvalidOffset);
+	CHECK(allocator.GetLargestFreeBlockSize() == 0);
+}
+
+TEST_CASE(FreedBuddiesCoalesce)
+{
+	BuddyAllocator allocator;
+	allocator.Create(4096, 256);
+
+	uint64_t offsets[16];
+	for (uint64_t& offset : offsets)
+		offset = allocator.Allocate(256, 256);
+
+	CHECK(allocator.GetLargestFreeBlockSize() == 0);
+
+	// Blocurile 1 si 2 nu sunt buddy: nu se pot uni
+	allocator.Free(offsets[1]);
+	allocator.Free(offsets[2]);
+	CHECK(allocator.GetLargestFreeBlockSize() == 256);
+
+	allocator.Free(offsets[0]);
+	CHECK(allocator.GetLargestFreeBlockSize() == 512);
+
+	allocator.Free(offsets[3]);
+	CHECK(allocator.GetLargestFreeBlockSize() == 1024);
+	CHECK(allocator.Allocate(1024, 1024) == 0);
+	allocator.Free(0);
+
+	for (int i = 4; i < 16; i++)
+		allocator.Free(offsets[i]);
+
+	CHECK(allocator.GetUsedSize() == 0);
+	CHECK(allocator.GetLargestFreeBlockSize() == 4096);
+	CHECK(allocator.Allocate(4096, 16) == 0);
+}
+
+TEST_CASE(LowestOffsetIsPreferredAmongEqualBlocks)
+{
+	BuddyAllocator allocator;
+	allocator.Create(4096, 256);
+
+	uint64_t offsets[4];
+	for (uint64_t& offset : offsets)
+		offset = allocator.Allocate(256, 256);
+
+	CHECK(offsets[3] == 768);
+
+	// Buddy-urile lor sunt ocupate, deci raman doua blocuri libere de 256
+	allocator.Free(offsets[3]);
+	allocator.Free(offsets[1]);
+
+	CHECK(allocator.Allocate(256, 256) == 256);
+	CHECK(allocator.Allocate(256, 256) == 768);
+	// Blocurile mici se iau inaintea injumatatirii unuia mare
+	CHECK(allocator.Allocate(256, 256) == 1024);
+}
+
+TEST_CASE(RandomAllocationsNeverOverlap)
+{
+	constexpr uint64_t Capacity = 1 << 24;
+
+	BuddyAllocator allocator;
+	allocator.Create(Capacity, 256);
+
+	std::mt19937 random(7);
+	// Offset -> marimea blocului
+	std::map<uint64_t, uint64_t> live;
+
+	for (int i = 0; i < 100000; i++)
+	{
+		if (live.empty() || random() % 3 != 0)
+		{
+			const uint64_t size = 1 + random() % (1u << (random() % 17));
+			const uint64_t alignment = 1ull << (random() % 12);
+
+			const uint64_t offset = allocator.Allocate(size, alignment);
+			if (offset == BuddyAllocator::InvalidOffset)
+				continue;
+
+			const uint64_t blockSize = allocator.GetBlockSize(offset);
+			CHECK(blockSize >= size);
+			CHECK(offset % alignment == 0 && offset % blockSize == 0);
+			CHECK(offset + blockSize <= Capacity);
+
+			const auto next = live.lower_bound(offset);
+			if (next != live.end())
+				CHECK(offset + blockSize <= next->first);
+			if (next != live.begin())
+				CHECK(std::prev(next)->first + std::prev(next)->second <= offset);
+
+			live[offset] = blockSize;
+		}
+		else
+		{
+			auto it = live.begin();
+			std::advance(it, random() % live.size());
+			allocator.Free(it->first);
+			live.erase(it);
+		}
+	}
+
+	uint64_t usedSize = 0;
+	for (const auto& [offset, blockSize] : live)
+		usedSize += blockSize;
+
+	CHECK(usedSize == allocator.GetUsedSize());
+	CHECK(live.size() == allocator.GetAllocationCount());
+
+	for (const auto& [offset, blockSize] : live)
+		allocator.Free(offset);
+
+	CHECK(allocator.GetUsedSize() == 0);
+	CHECK(allocator.GetLargestFreeBlockSize() == Capacity);
+}
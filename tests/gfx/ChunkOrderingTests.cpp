@@ -0,0 +1,119 @@
+#include "TestFramework.hpp"
+
+#include "ChunkOrdering.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using engine::gfx::ChunkOrdering;
+
+TEST_CASE(HilbertCurveVisitsEveryCellOnce)
+{
+	for (int side = 1; side <= 64; side *= 2)
+	{
+		std::vector<int> visitCount(side * side, 0);
+
+		bool isInside = true;
+		for (int d = 0; d < side * side; d++)
+		{
+			int row, column;
+			ChunkOrdering::HilbertCurveToGrid(side, d, row, column);
+
+			isInside = isInside && row >= 0 && row < side && column >= 0 && column < side;
+			if (isInside)
+				visitCount[row * side + column]++;
+		}
+
+		bool isBijective = true;
+		for (const int count : visitCount)
+			isBijective = isBijective && count == 1;
+
+		CHECK(isInside);
+		CHECK(isBijective);
+	}
+}
+
+TEST_CASE(HilbertCurveStepsAreAdjacent)
+{
+	for (int side = 2; side <= 64; side *= 2)
+	{
+		int previousRow, previousColumn;
+		ChunkOrdering::HilbertCurveToGrid(side, 0, previousRow, previousColumn);
+
+		// Curba incepe intr-un colt
+		CHECK(previousRow == 0 && previousColumn == 0);
+
+		bool isAdjacent = true;
+		for (int d = 1; d < side * side; d++)
+		{
+			int row, column;
+			ChunkOrdering::HilbertCurveToGrid(side, d, row, column);
+
+			isAdjacent = isAdjacent && std::abs(row - previousRow) + std::abs(column - previousColumn) == 1;
+			previousRow = row;
+			previousColumn = column;
+		}
+
+		CHECK(isAdjacent);
+	}
+}
+
+TEST_CASE(BandsGoFromNearToFar)
+{
+	constexpr uint32_t BandCount = 16;
+	constexpr float MaxDistance = 160.f;
+
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> distribution(0.f, 1.5f * MaxDistance);
+
+	std::vector<float> distances(1000);
+	for (float& distance : distances)
+		distance = distribution(random);
+
+	std::vector<uint32_t> order;
+	ChunkOrdering::SortByDistanceBands<BandCount>(
+		(uint32_t)distances.size(), [&distances](uint32_t i) { return distances[i]; }, MaxDistance, order);
+
+	REQUIRE(order.size() == distances.size());
+
+	const auto band = [&distances](uint32_t i)
+	{
+		return std::min((uint32_t)(distances[i] * (BandCount / MaxDistance)), BandCount - 1);
+	};
+
+	std::vector<int> seen(distances.size(), 0);
+	bool isOrdered = true;
+	for (size_t k = 0; k < order.size(); k++)
+	{
+		seen[order[k]]++;
+
+		// Benzile cresc, iar in interiorul unei benzi se pastreaza ordinea chunk-urilor (curba Hilbert)
+		if (k > 0)
+		{
+			const uint32_t previous = order[k - 1];
+			isOrdered = isOrdered && band(previous) <= band(order[k]);
+			isOrdered = isOrdered && (band(previous) < band(order[k]) || previous < order[k]);
+		}
+	}
+
+	bool isPermutation = true;
+	for (const int count : seen)
+		isPermutation = isPermutation && count == 1;
+
+	CHECK(isPermutation);
+	CHECK(isOrdered);
+
+	// Tot ce e dincolo de maxDistance ajunge in ultima banda, deci la sfarsit
+	bool farIsLast = true;
+	bool reachedFar = false;
+	for (const uint32_t i : order)
+	{
+		reachedFar = reachedFar || distances[i] >= MaxDistance;
+		farIsLast = farIsLast && (!reachedFar || band(i) == BandCount - 1);
+	}
+
+	CHECK(farIsLast);
+}
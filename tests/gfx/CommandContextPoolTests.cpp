@@ -0,0 +1,83 @@
+#include "TestFramework.hpp"
+
+#include "CommandContextPool.hpp"
+
+#include <memory>
+
+using engine::gfx::CommandContextPool;
+
+namespace
+{
+
+struct FakeContext
+{
+	int id;
+};
+
+CommandContextPool<FakeContext> MakePool(int& createdCount)
+{
+	CommandContextPool<FakeContext> pool;
+	pool.Create([&createdCount]() { return std::make_unique<FakeContext>(FakeContext{createdCount++}); });
+
+	return pool;
+}
+
+}  // namespace
+
+TEST_CASE(ContextIsReusedOnceItsFenceCompletes)
+{
+	int createdCount = 0;
+	CommandContextPool<FakeContext> pool = MakePool(createdCount);
+
+	FakeContext& first = pool.Acquire(0);
+	pool.Release(first, 1);
+	CHECK(pool.GetRetiredCount() == 1);
+
+	// Fence-ul inca nu a ajuns la 1: se creeaza un context nou
+	FakeContext& second = pool.Acquire(0);
+	CHECK(&second != &first);
+	CHECK(pool.GetSize() == 2);
+
+	FakeContext& reused = pool.Acquire(1);
+	CHECK(&reused == &first);
+	CHECK(pool.GetSize() == 2);
+	CHECK(pool.GetRetiredCount() == 0);
+}
+
+TEST_CASE(ContextsAreReusedInReleaseOrder)
+{
+	int createdCount = 0;
+	CommandContextPool<FakeContext> pool = MakePool(createdCount);
+
+	FakeContext& first = pool.Acquire(0);
+	FakeContext& second = pool.Acquire(0);
+	pool.Release(first, 1);
+	pool.Release(second, 2);
+
+	CHECK(&pool.Acquire(5) == &first);
+	CHECK(&pool.Acquire(5) == &second);
+	CHECK(createdCount == 2);
+}
+
+TEST_CASE(PoolGrowsOnlyToTheContextsInFlight)
+{
+	int createdCount = 0;
+	CommandContextPool<FakeContext> pool = MakePool(createdCount);
+
+	// 4 contexte pe cadru, GPU-ul cu doua cadre in urma
+	uint64_t fence = 0;
+	for (int frame = 0; frame < 100; frame++)
+	{
+		const uint64_t completed = fence > 2 ? fence - 2 : 0;
+
+		FakeContext* contexts[4];
+		for (FakeContext*& context : contexts)
+			context = &pool.Acquire(completed);
+
+		fence++;
+		for (FakeContext* context : contexts)
+			pool.Release(*context, fence);
+	}
+
+	CHECK(pool.GetSize() == 12);
+}
@@ -0,0 +1,69 @@
+#include "TestFramework.hpp"
+
+#include "CommandSequenceCache.hpp"
+
+#include <cstdint>
+
+using engine::gfx::CommandFingerprint;
+using engine::gfx::CommandSequenceCache;
+
+TEST_CASE(FingerprintIsFnv1a)
+{
+	CommandFingerprint empty;
+	CHECK(empty.Get() == 14695981039346656037ull);
+
+	// Valoarea de referinta FNV-1a pe 64 de biti pentru "a"
+	CommandFingerprint fingerprint;
+	fingerprint.Add("a", 1);
+	CHECK(fingerprint.Get() == 0xAF63DC4C8601EC8Cull);
+}
+
+TEST_CASE(FingerprintDependsOnValuesAndOrder)
+{
+	CommandFingerprint first;
+	first.Add(1u);
+	first.Add(2u);
+
+	CommandFingerprint same;
+	same.Add(1u);
+	same.Add(2u);
+
+	CommandFingerprint swapped;
+	swapped.Add(2u);
+	swapped.Add(1u);
+
+	CHECK(first.Get() == same.Get());
+	CHECK(first.Get() != swapped.Get());
+}
+
+TEST_CASE(SlotIsRecordedOnceUntilTheFingerprintChanges)
+{
+	CommandSequenceCache cache;
+	cache.Create(3);
+
+	CHECK(cache.NeedsRecording(0, 42));
+
+	cache.MarkRecorded(0, 42);
+	CHECK(!cache.NeedsRecording(0, 42));
+	CHECK(cache.NeedsRecording(0, 43));
+
+	// Fiecare frame resource are slotul lui
+	CHECK(cache.NeedsRecording(1, 42));
+	CHECK(cache.NeedsRecording(2, 42));
+}
+
+TEST_CASE(InvalidateForcesEverySlotToRecord)
+{
+	CommandSequenceCache cache;
+	cache.Create(2);
+
+	cache.MarkRecorded(0, 7);
+	cache.MarkRecorded(1, 7);
+	cache.Invalidate();
+
+	CHECK(cache.NeedsRecording(0, 7));
+	CHECK(cache.NeedsRecording(1, 7));
+
+	cache.MarkRecorded(1, 7);
+	CHECK(!cache.NeedsRecording(1, 7));
+}
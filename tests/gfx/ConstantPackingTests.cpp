@@ -0,0 +1,231 @@
+#include "TestFramework.hpp"
+
+#include "ConstantPacking.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+using engine::gfx::Float4x4;
+using engine::gfx::InvertMatrices;
+using engine::gfx::ObjectRecord;
+using engine::gfx::PackObjectRecords;
+using engine::gfx::RecordVersionTracker;
+using engine::gfx::TransposeMatrices;
+
+namespace
+{
+
+// Inversa de referinta, Gauss-Jordan cu pivotare partiala in double
+void ReferenceInverse(const Float4x4& matrix, double inverse[16])
+{
+	double m[4][8];
+	for (int row = 0; row < 4; row++)
+	{
+		for (int column = 0; column < 8; column++)
+			m[row][column] = column < 4 ? matrix.m[row * 4 + column] : (column - 4 == row ? 1.0 : 0.0);
+	}
+
+	for (int column = 0; column < 4; column++)
+	{
+		int pivot = column;
+		for (int row = column + 1; row < 4; row++)
+		{
+			if (std::fabs(m[row][column]) > std::fabs(m[pivot][column]))
+				pivot = row;
+		}
+
+		for (int k = 0; k < 8; k++)
+			std::swap(m[column][k], m[pivot][k]);
+
+		const double divisor = m[column][column];
+		for (int k = 0; k < 8; k++)
+			m[column][k] /= divisor;
+
+		for (int row = 0; row < 4; row++)
+		{
+			if (row == column)
+				continue;
+
+			const double factor = m[row][column];
+			for (int k = 0; k < 8; k++)
+				m[row][k] -= factor * m[column][k];
+		}
+	}
+
+	for (int row = 0; row < 4; row++)
+	{
+		for (int column = 0; column < 4; column++)
+			inverse[row * 4 + column] = m[row][column + 4];
+	}
+}
+
+// Matrice inversabile: diagonala dominanta, jumatate dintre ele transformari afine
+std::vector<Float4x4> MakeMatrices(std::mt19937& random, size_t count)
+{
+	std::uniform_real_distribution<float> distribution(-2.f, 2.f);
+
+	std::vector<Float4x4> matrices(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		for (float& value : matrices[i].m)
+			value = distribution(random);
+
+		for (int d = 0; d < 4; d++)
+			matrices[i].m[d * 5] += 8.f;
+
+		if (i % 2 == 0)
+		{
+			matrices[i].m[3] = matrices[i].m[7] = matrices[i].m[11] = 0.f;
+			matrices[i].m[15] = 1.f;
+		}
+	}
+
+	return matrices;
+}
+
+}  // namespace
+
+TEST_CASE(TransposeIsExactForEveryCount)
+{
+	std::mt19937 random(7);
+
+	// Numere care nu sunt multiplu de 4 trec prin grupul completat cu identitate
+	for (size_t count = 0; count <= 13; count++)
+	{
+		const std::vector<Float4x4> matrices = MakeMatrices(random, count);
+
+		std::vector<Float4x4> transposes(count + 1);
+		transposes[count].m[0] = 12345.f;
+		TransposeMatrices(matrices.data(), count, transposes.data());
+
+		CHECK(transposes[count].m[0] == 12345.f);
+
+		bool isExact = true;
+		for (size_t i = 0; i < count; i++)
+		{
+			for (int row = 0; row < 4; row++)
+			{
+				for (int column = 0; column < 4; column++)
+					isExact = isExact && transposes[i].m[column * 4 + row] == matrices[i].m[row * 4 + column];
+			}
+		}
+
+		CHECK(isExact);
+	}
+}
+
+TEST_CASE(InverseMatchesTheReference)
+{
+	std::mt19937 random(7);
+
+	for (size_t count = 0; count <= 13; count++)
+	{
+		for (int repetition = 0; repetition < 50; repetition++)
+		{
+			const std::vector<Float4x4> matrices = MakeMatrices(random, count);
+
+			std::vector<Float4x4> inverses(count + 1);
+			std::vector<Float4x4> inverseTransposes(count + 1);
+			inverses[count].m[0] = 12345.f;
+			inverseTransposes[count].m[0] = 12345.f;
+
+			InvertMatrices(matrices.data(), count, inverses.data(), inverseTransposes.data());
+
+			CHECK(inverses[count].m[0] == 12345.f);
+			CHECK(inverseTransposes[count].m[0] == 12345.f);
+
+			double maxError = 0.0;
+			for (size_t i = 0; i < count; i++)
+			{
+				double expected[16];
+				ReferenceInverse(matrices[i], expected);
+
+				for (int row = 0; row < 4; row++)
+				{
+					for (int column = 0; column < 4; column++)
+					{
+						const double value = expected[row * 4 + column];
+						maxError = std::max(maxError, std::fabs(inverses[i].m[row * 4 + column] - value));
+						maxError = std::max(maxError, std::fabs(inverseTransposes[i].m[column * 4 + row] - value));
+					}
+				}
+			}
+
+			CHECK(maxError < 1e-5);
+		}
+	}
+}
+
+TEST_CASE(InverseOutputsAreOptional)
+{
+	std::mt19937 random(3);
+	const std::vector<Float4x4> matrices = MakeMatrices(random, 5);
+
+	// Fiecare iesire calculata separat; inversa transpusa e transpusa inversei
+	std::vector<Float4x4> inverses(5);
+	std::vector<Float4x4> inverseTransposes(5);
+	InvertMatrices(matrices.data(), 5, inverses.data(), nullptr);
+	InvertMatrices(matrices.data(), 5, nullptr, inverseTransposes.data());
+
+	bool isTransposed = true;
+	for (size_t i = 0; i < 5; i++)
+	{
+		for (int k = 0; k < 16; k++)
+			isTransposed = isTransposed && inverses[i].m[k] == inverseTransposes[i].m[k % 4 * 4 + k / 4];
+	}
+
+	CHECK(isTransposed);
+}
+
+TEST_CASE(ObjectRecordsHoldTransposedMatrices)
+{
+	std::mt19937 random(11);
+	const size_t count = 6;
+
+	const std::vector<Float4x4> transforms = MakeMatrices(random, count);
+	const std::vector<Float4x4> textureTransforms = MakeMatrices(random, count);
+
+	std::vector<Float4x4> inverseTransposes(count);
+	InvertMatrices(transforms.data(), count, nullptr, inverseTransposes.data());
+
+	std::vector<ObjectRecord> records(count);
+	PackObjectRecords(transforms.data(), textureTransforms.data(), count, records.data());
+
+	bool isPacked = true;
+	for (size_t i = 0; i < count; i++)
+	{
+		for (int row = 0; row < 4; row++)
+		{
+			for (int column = 0; column < 4; column++)
+			{
+				const int index = row * 4 + column;
+				const int transposedIndex = column * 4 + row;
+
+				isPacked = isPacked && records[i].worldMatrix.m[transposedIndex] == transforms[i].m[index];
+				isPacked = isPacked && records[i].textureTransform.m[transposedIndex] == textureTransforms[i].m[index];
+				isPacked = isPacked && records[i].invWorldMatrix.m[index] == inverseTransposes[i].m[index];
+			}
+		}
+	}
+
+	CHECK(isPacked);
+}
+
+TEST_CASE(RecordIsRewrittenOnlyWhenItsVersionChanges)
+{
+	RecordVersionTracker tracker;
+	CHECK(tracker.IsStale(5, 1));
+
+	tracker.SetWritten(5, 1);
+	CHECK(!tracker.IsStale(5, 1));
+	CHECK(tracker.IsStale(5, 2));
+
+	// Recordurile sub cel mai mare ID scris raman nescrise
+	CHECK(tracker.IsStale(4, 1));
+
+	tracker.Invalidate();
+	CHECK(tracker.IsStale(5, 1));
+}
@@ -0,0 +1,187 @@
+#include "TestFramework.hpp"
+
+#include "DeferredReleaseQueue.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using engine::gfx::DeferredReleaseQueue;
+using engine::gfx::DeferredReleaseStatistics;
+
+namespace
+{
+
+// Adauga in released fiecare obiect eliberat, in ordinea apelurilor
+struct Recorder
+{
+	void operator()(int item) { released.push_back(item); }
+
+	std::vector<int> released;
+};
+
+}  // namespace
+
+TEST_CASE(ReleaseWaitsForTheRetiredFence)
+{
+	DeferredReleaseQueue<int> queue;
+	Recorder recorder;
+
+	queue.Push(1, 100);
+	queue.Push(2, 200);
+	queue.Retire(5);
+
+	CHECK(queue.Release(4, recorder) == 0);
+	CHECK(recorder.released.empty());
+
+	CHECK(queue.Release(5, recorder) == 300);
+	CHECK((recorder.released == std::vector<int>{1, 2}));
+	CHECK(queue.IsEmpty());
+}
+
+TEST_CASE(ReleaseKeepsPushOrderAcrossFences)
+{
+	DeferredReleaseQueue<int> queue;
+	Recorder recorder;
+
+	queue.Push(1, 10);
+	queue.Retire(1);
+	queue.Push(2, 20);
+	queue.Push(3, 30);
+	queue.Retire(2);
+	queue.Push(4, 40);
+	queue.Retire(3);
+
+	CHECK(queue.Release(2, recorder) == 60);
+	CHECK((recorder.released == std::vector<int>{1, 2, 3}));
+
+	// Fence-ul completat poate sari peste valori
+	CHECK(queue.Release(10, recorder) == 40);
+	CHECK((recorder.released == std::vector<int>{1, 2, 3, 4}));
+}
+
+TEST_CASE(UnretiredEntriesAreNeverReleased)
+{
+	DeferredReleaseQueue<int> queue;
+	Recorder recorder;
+
+	queue.Push(1, 10);
+	queue.Retire(1);
+	queue.Push(2, 20);
+
+	// Obiectul 2 poate fi folosit de liste inca netrimise, oricat de mare ar fi fence-ul completat
+	CHECK(queue.Release(UINT64_MAX - 1, recorder) == 10);
+	CHECK((recorder.released == std::vector<int>{1}));
+	CHECK(!queue.IsEmpty());
+
+	queue.Retire(2);
+	CHECK(queue.Release(1, recorder) == 0);
+	CHECK(queue.Release(2, recorder) == 20);
+	CHECK(queue.IsEmpty());
+}
+
+TEST_CASE(RetireBindsOnlyEntriesSinceThePreviousRetire)
+{
+	DeferredReleaseQueue<int> queue;
+	Recorder recorder;
+
+	queue.Push(1, 10);
+	queue.Retire(3);
+	queue.Retire(4);
+	queue.Push(2, 20);
+	queue.Retire(7);
+
+	CHECK(queue.Release(3, recorder) == 10);
+	CHECK(queue.Release(6, recorder) == 0);
+	CHECK(queue.Release(7, recorder) == 20);
+}
+
+TEST_CASE(FrameFenceReleasesAfterTheFrameCompletes)
+{
+	// Ca la EndFrame: obiectele din cadrul N se leaga de fence-ul trimis al cadrului N, nu de urmatorul
+	DeferredReleaseQueue<int> queue;
+	Recorder recorder;
+
+	uint64_t submittedFenceValue = 0;
+	for (int frame = 1; frame <= 4; frame++)
+	{
+		queue.Push(frame, 1);
+		submittedFenceValue++;
+
+		queue.Retire(submittedFenceValue);
+		// GPU-ul e cu doua cadre in urma
+		queue.Release(submittedFenceValue >= 2 ? submittedFenceValue - 2 : 0, recorder);
+	}
+
+	CHECK((recorder.released == std::vector<int>{1, 2}));
+
+	queue.Release(submittedFenceValue, recorder);
+	CHECK((recorder.released == std::vector<int>{1, 2, 3, 4}));
+}
+
+TEST_CASE(ReleaseAllIncludesUnretiredEntries)
+{
+	DeferredReleaseQueue<int> queue;
+	Recorder recorder;
+
+	queue.Push(1, 10);
+	queue.Retire(8);
+	queue.Push(2, 20);
+
+	CHECK(queue.ReleaseAll(recorder) == 30);
+	CHECK((recorder.released == std::vector<int>{1, 2}));
+	CHECK(queue.IsEmpty());
+
+	// Coada ramane folosibila
+	queue.Push(3, 30);
+	queue.Retire(9);
+	CHECK(queue.Release(9, recorder) == 30);
+}
+
+TEST_CASE(StatisticsTrackPendingAndReleasedSizes)
+{
+	DeferredReleaseQueue<int> queue;
+	Recorder recorder;
+
+	queue.Push(1, 100);
+	queue.Push(2, 50);
+	queue.Retire(1);
+	queue.Push(3, 25);
+
+	const DeferredReleaseStatistics& statistics = queue.GetStatistics();
+	CHECK(statistics.pendingCount == 3);
+	CHECK(statistics.pendingSize == 175);
+	CHECK(statistics.peakPendingSize == 175);
+	CHECK(statistics.releasedCount == 0);
+
+	queue.Release(1, recorder);
+	CHECK(statistics.pendingCount == 1);
+	CHECK(statistics.pendingSize == 25);
+	CHECK(statistics.releasedCount == 2);
+	CHECK(statistics.releasedSize == 150);
+
+	// Varful ramane pana se depaseste
+	queue.Push(4, 100);
+	CHECK(statistics.peakPendingSize == 175);
+	queue.Push(5, 100);
+	CHECK(statistics.peakPendingSize == 225);
+
+	queue.ReleaseAll(recorder);
+	CHECK(statistics.pendingCount == 0);
+	CHECK(statistics.pendingSize == 0);
+	CHECK(statistics.releasedCount == 5);
+	CHECK(statistics.releasedSize == 375);
+}
+
+TEST_CASE(MoveOnlyItemsAreReleasedOnce)
+{
+	DeferredReleaseQueue<std::unique_ptr<int>> queue;
+	int releaseCount = 0;
+
+	queue.Push(std::make_unique<int>(1), 4);
+	queue.Retire(1);
+	queue.Release(1, [&releaseCount](std::unique_ptr<int>& item) { releaseCount += item != nullptr ? 1 : 0; });
+
+	CHECK(releaseCount == 1);
+	CHECK(queue.IsEmpty());
+}
@@ -0,0 +1,201 @@
+#include "TestFramework.hpp"
+
+#include "DescriptorAllocator.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <utility>
+#include <vector>
+
+using engine::gfx::DescriptorAllocator;
+
+namespace
+{
+
+struct Range
+{
+	uint32_t index;
+	uint32_t count;
+};
+
+}  // namespace
+
+TEST_CASE(ConsecutiveAllocationsStayInOrder)
+{
+	DescriptorAllocator allocator;
+	allocator.Create(64, 0);
+
+	uint32_t expected = 0;
+	for (uint32_t i = 0; i < 10; i++)
+	{
+		const uint32_t count = i % 3 + 1;
+		CHECK(allocator.Allocate(count) == expected);
+		expected += count;
+	}
+
+	CHECK(allocator.GetFreeCount() == 64 - expected);
+	CHECK(allocator.Allocate(64) == DescriptorAllocator::InvalidIndex);
+}
+
+TEST_CASE(FreeMergesWithFreeNeighbours)
+{
+	DescriptorAllocator allocator;
+	allocator.Create(16, 0);
+
+	const uint32_t a = allocator.Allocate(4);
+	const uint32_t b = allocator.Allocate(4);
+	const uint32_t c = allocator.Allocate(4);
+	CHECK(allocator.GetFreeRangeCount() == 1);
+
+	allocator.Free(a, 4);
+	allocator.Free(c, 4);
+	CHECK(allocator.GetFreeRangeCount() == 2);
+	CHECK(allocator.GetLargestFreeRange() == 8);
+
+	// Primul interval liber care incape, de la inceputul heap-ului
+	CHECK(allocator.Allocate(2) == 0);
+	allocator.Free(0, 2);
+
+	allocator.Free(b, 4);
+	CHECK(allocator.GetFreeRangeCount() == 1);
+	CHECK(allocator.GetLargestFreeRange() == 16);
+	CHECK(allocator.GetFreeCount() == 16);
+}
+
+TEST_CASE(RandomAllocationsNeverOverlapAndStayCoalesced)
+{
+	constexpr uint32_t PersistentCount = 4096;
+
+	DescriptorAllocator allocator;
+	allocator.Create(PersistentCount, 0);
+
+	std::mt19937 random(1);
+	std::vector<bool> isUsed(PersistentCount, false);
+	std::vector<Range> live;
+
+	for (int iteration = 0; iteration < 200000; iteration++)
+	{
+		const uint32_t allocateChance = allocator.GetFreeCount() > PersistentCount / 4 ? 55 : 40;
+		if (live.empty() || random() % 100 < allocateChance)
+		{
+			const uint32_t count = 1 + random() % (random() % 8 == 0 ? 64 : 4);
+			const uint32_t index = allocator.Allocate(count);
+
+			// Esueaza doar cand niciun interval liber nu e destul de mare
+			if (index == DescriptorAllocator::InvalidIndex)
+			{
+				CHECK(allocator.GetLargestFreeRange() < count);
+				continue;
+			}
+
+			REQUIRE(index + count <= PersistentCount);
+
+			bool isOverlapping = false;
+			for (uint32_t i = index; i < index + count; i++)
+			{
+				isOverlapping = isOverlapping || isUsed[i];
+				isUsed[i] = true;
+			}
+
+			CHECK(!isOverlapping);
+			live.push_back({index, count});
+		}
+		else
+		{
+			const size_t liveIndex = random() % live.size();
+			const Range range = live[liveIndex];
+			live[liveIndex] = live.back();
+			live.pop_back();
+
+			for (uint32_t i = range.index; i < range.index + range.count; i++)
+				isUsed[i] = false;
+
+			allocator.Free(range.index, range.count);
+		}
+
+		if (iteration % 10000 != 0)
+			continue;
+
+		// Un interval liber pentru fiecare secventa de descriptori nefolositi
+		uint32_t freeCount = 0;
+		size_t freeRangeCount = 0;
+		for (uint32_t i = 0; i < PersistentCount; i++)
+		{
+			freeCount += isUsed[i] ? 0 : 1;
+			freeRangeCount += !isUsed[i] && (i == 0 || isUsed[i - 1]) ? 1 : 0;
+		}
+
+		CHECK(allocator.GetFreeCount() == freeCount);
+		CHECK(allocator.GetFreeRangeCount() == freeRangeCount);
+	}
+
+	for (const Range& range : live)
+		allocator.Free(range.index, range.count);
+
+	CHECK(allocator.GetFreeRangeCount() == 1);
+	CHECK(allocator.GetFreeCount() == PersistentCount);
+}
+
+TEST_CASE(TransientRegionFollowsThePersistentOne)
+{
+	constexpr uint32_t PersistentCount = 256;
+	constexpr uint32_t TransientCount = 128;
+
+	DescriptorAllocator allocator;
+	allocator.Create(PersistentCount, TransientCount);
+	CHECK(allocator.GetTransientCount() == TransientCount);
+
+	std::mt19937 random(2);
+	std::vector<int> owner(TransientCount, -1);
+	std::deque<std::pair<uint64_t, std::vector<Range>>> frames;
+
+	uint64_t fenceValue = 0;
+	for (int frame = 0; frame < 20000; frame++)
+	{
+		std::vector<Range> tables;
+		const int tableCount = random() % 20;
+		for (int table = 0; table < tableCount; table++)
+		{
+			const uint32_t count = 1 + random() % 16;
+			const uint32_t index = allocator.AllocateTransient(count);
+			if (index == DescriptorAllocator::InvalidIndex)
+				break;
+
+			REQUIRE(index >= PersistentCount && index + count <= PersistentCount + TransientCount);
+
+			bool isOverlapping = false;
+			for (uint32_t i = index - PersistentCount; i < index - PersistentCount + count; i++)
+			{
+				isOverlapping = isOverlapping || owner[i] != -1;
+				owner[i] = frame;
+			}
+
+			CHECK(!isOverlapping);
+			tables.push_back({index, count});
+		}
+
+		allocator.RetireTransient(++fenceValue);
+		frames.push_back({fenceValue, tables});
+
+		// GPU-ul ramane cu trei cadre in urma
+		const uint64_t completedFenceValue = fenceValue > 3 ? fenceValue - 3 : 0;
+		allocator.ReclaimTransient(completedFenceValue);
+
+		while (!frames.empty() && frames.front().first <= completedFenceValue)
+		{
+			for (const Range& table : frames.front().second)
+			{
+				for (uint32_t i = table.index - PersistentCount; i < table.index - PersistentCount + table.count; i++)
+					owner[i] = -1;
+			}
+
+			frames.pop_front();
+		}
+	}
+
+	// Fara regiune tranzitorie nu se aloca nimic
+	DescriptorAllocator renderTargets;
+	renderTargets.Create(8, 0);
+	CHECK(renderTargets.AllocateTransient(1) == DescriptorAllocator::InvalidIndex);
+}
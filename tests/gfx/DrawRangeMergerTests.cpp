@@ -0,0 +1,147 @@
+#include "TestFramework.hpp"
+
+#include "DrawRangeMerger.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+using engine::gfx::DrawRange;
+using engine::gfx::DrawRangeMerger;
+using engine::gfx::SubMesh;
+
+namespace
+{
+
+std::set<uint32_t> CollectIndices(const std::vector<DrawRange>& ranges)
+{
+	std::set<uint32_t> indices;
+	for (const DrawRange& range : ranges)
+	{
+		for (uint32_t index = range.startIndexLocation; index < range.GetEndIndexLocation(); index++)
+			indices.insert(index);
+	}
+
+	return indices;
+}
+
+}  // namespace
+
+TEST_CASE(AdjacentRangesAreJoined)
+{
+	DrawRangeMerger merger;
+	merger.Add(0, 6, 0);
+	merger.Add(6, 12, 0);
+	merger.Add(SubMesh{6, 18, 0});
+
+	REQUIRE(merger.GetDrawCount() == 1);
+	CHECK(merger.GetRanges()[0].startIndexLocation == 0);
+	CHECK(merger.GetRanges()[0].indexCount == 24);
+}
+
+TEST_CASE(GapsAndBaseVertexChangesStartNewDraws)
+{
+	DrawRangeMerger merger;
+	merger.Add(0, 6, 0);
+	merger.Add(7, 6, 0);
+	merger.Add(13, 6, 100);
+	merger.Add(19, 6, 100);
+
+	REQUIRE(merger.GetDrawCount() == 3);
+	CHECK(merger.GetRanges()[1].startIndexLocation == 7);
+	CHECK(merger.GetRanges()[2].baseVertexLocation == 100);
+	CHECK(merger.GetRanges()[2].indexCount == 12);
+}
+
+TEST_CASE(EmptyRangesAreIgnored)
+{
+	DrawRangeMerger merger;
+	merger.Add(0, 0, 0);
+	CHECK(merger.GetDrawCount() == 0);
+
+	merger.Add(0, 3, 0);
+	merger.Add(5, 0, 0);
+	merger.Add(3, 3, 0);
+	CHECK(merger.GetDrawCount() == 1);
+}
+
+TEST_CASE(AddKeepsInsertionOrder)
+{
+	DrawRangeMerger merger;
+	merger.Add(6, 6, 0);
+	merger.Add(0, 6, 0);
+
+	// Intervalul adaugat dupa nu se lipeste in fata celui anterior
+	CHECK(merger.GetDrawCount() == 2);
+
+	merger.Reset();
+	CHECK(merger.GetDrawCount() == 0);
+}
+
+TEST_CASE(MergeMinimalSortsByBaseVertexAndStart)
+{
+	const std::vector<DrawRange> ranges = {{12, 6, 0}, {0, 6, 8}, {6, 6, 0}, {6, 6, 8}, {0, 6, 0}};
+
+	const std::vector<DrawRange> merged = DrawRangeMerger::MergeMinimal(ranges);
+	REQUIRE(merged.size() == 2);
+	CHECK(merged[0].baseVertexLocation == 0 && merged[0].startIndexLocation == 0 && merged[0].indexCount == 18);
+	CHECK(merged[1].baseVertexLocation == 8 && merged[1].startIndexLocation == 0 && merged[1].indexCount == 12);
+}
+
+TEST_CASE(RandomVisibleChunksMergeToTheMinimalList)
+{
+	std::mt19937 random(3);
+
+	for (int iteration = 0; iteration < 2000; iteration++)
+	{
+		// Chunk-uri consecutive dintr-un index buffer, unele despartite de indecsi nefolositi
+		std::vector<DrawRange> chunks;
+		uint32_t start = 0;
+		const int chunkCount = 1 + random() % 64;
+		for (int i = 0; i < chunkCount; i++)
+		{
+			const uint32_t indexCount = random() % 4 == 0 ? 0 : 1 + random() % 10;
+			chunks.push_back({start, indexCount, 0});
+			start += indexCount + (random() % 5 == 0 ? 1 : 0);
+		}
+
+		std::vector<DrawRange> visible;
+		for (const DrawRange& chunk : chunks)
+		{
+			if (random() % 2 != 0)
+				visible.push_back(chunk);
+		}
+
+		std::shuffle(visible.begin(), visible.end(), random);
+		const std::vector<DrawRange> merged = DrawRangeMerger::MergeMinimal(visible);
+
+		// Aceiasi indecsi, fiecare o singura data, fara intervale goale sau lipite
+		size_t mergedIndexCount = 0;
+		for (size_t i = 0; i < merged.size(); i++)
+		{
+			CHECK(merged[i].indexCount != 0);
+			mergedIndexCount += merged[i].indexCount;
+
+			if (i > 0)
+				CHECK(merged[i - 1].GetEndIndexLocation() < merged[i].startIndexLocation);
+		}
+
+		const std::set<uint32_t> indices = CollectIndices(visible);
+		CHECK(CollectIndices(merged) == indices);
+		CHECK(mergedIndexCount == indices.size());
+
+		// Adaugate in ordinea din index buffer, Add da aceeasi lista
+		std::sort(
+			visible.begin(),
+			visible.end(),
+			[](const DrawRange& lhs, const DrawRange& rhs) { return lhs.startIndexLocation < rhs.startIndexLocation; });
+
+		DrawRangeMerger merger;
+		for (const DrawRange& range : visible)
+			merger.Add(range.startIndexLocation, range.indexCount, range.baseVertexLocation);
+
+		CHECK(merger.GetDrawCount() == merged.size());
+	}
+}
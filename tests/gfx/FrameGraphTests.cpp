@@ -0,0 +1,229 @@
+#include "TestFramework.hpp"
+
+#include "FrameGraph.hpp"
+
+#include <vector>
+
+using engine::gfx::FrameGraph;
+using engine::gfx::FrameGraphBarrier;
+using engine::gfx::FrameGraphPass;
+using engine::gfx::FrameGraphResource;
+namespace FrameGraphUsage = engine::gfx::FrameGraphUsage;
+namespace SplitBarrier = engine::gfx::SplitBarrier;
+
+namespace
+{
+
+bool IsBarrier(
+	const FrameGraphBarrier& barrier,
+	uint32_t resource,
+	FrameGraphUsage::Mask before,
+	FrameGraphUsage::Mask after,
+	SplitBarrier::Value split = SplitBarrier::None)
+{
+	return barrier.resource == resource && barrier.before == before && barrier.after == after
+		&& barrier.split == split;
+}
+
+// Lant de post-procesare: a -> b -> c -> backbuffer, plus un pass care scrie o resursa pe care nu o citeste nimeni
+struct PostProcessGraph
+{
+	PostProcessGraph()
+	{
+		FrameGraphResource backBuffer =
+			graph.ImportResource("backbuffer", FrameGraphUsage::Present, FrameGraphUsage::Present);
+		FrameGraphResource a = graph.CreateTransient("a", 1000, 256);
+		FrameGraphResource b = graph.CreateTransient("b", 1000, 256);
+		FrameGraphResource c = graph.CreateTransient("c", 500, 256);
+		FrameGraphResource unused = graph.CreateTransient("unused", 10, 16);
+
+		p0 = graph.AddPass("p0");
+		a = graph.Write(p0, a, FrameGraphUsage::RenderTarget);
+
+		p1 = graph.AddPass("p1");
+		graph.Read(p1, a, FrameGraphUsage::ShaderResource);
+		b = graph.Write(p1, b, FrameGraphUsage::RenderTarget);
+
+		unusedPass = graph.AddPass("unused");
+		graph.Write(unusedPass, unused, FrameGraphUsage::RenderTarget);
+
+		p2 = graph.AddPass("p2");
+		graph.Read(p2, b, FrameGraphUsage::ShaderResource);
+		c = graph.Write(p2, c, FrameGraphUsage::RenderTarget);
+
+		p3 = graph.AddPass("p3");
+		graph.Read(p3, c, FrameGraphUsage::ShaderResource);
+		graph.Read(p3, b, FrameGraphUsage::ShaderResource);
+		graph.Write(p3, backBuffer, FrameGraphUsage::RenderTarget);
+
+		graph.Compile();
+	}
+
+	FrameGraph graph;
+	FrameGraphPass p0, p1, unusedPass, p2, p3;
+};
+
+// Indecsii resurselor fizice din PostProcessGraph
+constexpr uint32_t BackBufferIndex = 0;
+constexpr uint32_t AIndex = 1;
+constexpr uint32_t BIndex = 2;
+constexpr uint32_t CIndex = 3;
+constexpr uint32_t UnusedIndex = 4;
+
+}  // namespace
+
+TEST_CASE(UnreadPassesAreCulled)
+{
+	PostProcessGraph setup;
+	const FrameGraph& graph = setup.graph;
+
+	CHECK(graph.IsCulled(setup.unusedPass));
+	CHECK(!graph.IsCulled(setup.p0));
+
+	const std::vector<FrameGraphPass> expectedOrder = {setup.p0, setup.p1, setup.p2, setup.p3};
+	CHECK(graph.GetExecutionOrder() == expectedOrder);
+	CHECK(graph.GetMemoryStatistics().culledPasses == 1);
+}
+
+TEST_CASE(TransientsWithDisjointLifetimesAlias)
+{
+	PostProcessGraph setup;
+	const FrameGraph& graph = setup.graph;
+
+	// a traieste in p0 - p1, c in p2 - p3: acelasi offset; b se suprapune cu amandoua
+	CHECK(graph.GetTransientOffset(AIndex) == 0);
+	CHECK(graph.GetTransientOffset(CIndex) == 0);
+	CHECK(graph.GetTransientOffset(BIndex) == 1024);
+	CHECK(graph.GetTransientOffset(BackBufferIndex) == FrameGraph::NoOffset);
+	CHECK(graph.GetTransientOffset(UnusedIndex) == FrameGraph::NoOffset);
+
+	CHECK(graph.GetMemoryStatistics().transientBytes == 2500);
+	CHECK(graph.GetMemoryStatistics().aliasedBytes == 2024);
+}
+
+TEST_CASE(BarriersFollowEachResourceUsage)
+{
+	PostProcessGraph setup;
+	const FrameGraph& graph = setup.graph;
+
+	REQUIRE(graph.GetBarriers(setup.p0).size() == 1);
+	CHECK(IsBarrier(graph.GetBarriers(setup.p0)[0], AIndex, FrameGraphUsage::Undefined, FrameGraphUsage::RenderTarget));
+
+	REQUIRE(graph.GetBarriers(setup.p1).size() == 2);
+	CHECK(IsBarrier(
+		graph.GetBarriers(setup.p1)[0], AIndex, FrameGraphUsage::RenderTarget, FrameGraphUsage::ShaderResource));
+	CHECK(IsBarrier(graph.GetBarriers(setup.p1)[1], BIndex, FrameGraphUsage::Undefined, FrameGraphUsage::RenderTarget));
+
+	// b e deja in ShaderResource din p2: citirea din p3 nu mai are tranzitie
+	REQUIRE(graph.GetBarriers(setup.p3).size() == 2);
+	CHECK(IsBarrier(
+		graph.GetBarriers(setup.p3)[0], BackBufferIndex, FrameGraphUsage::Present, FrameGraphUsage::RenderTarget));
+	CHECK(IsBarrier(
+		graph.GetBarriers(setup.p3)[1], CIndex, FrameGraphUsage::RenderTarget, FrameGraphUsage::ShaderResource));
+
+	REQUIRE(graph.GetFinalBarriers().size() == 1);
+	CHECK(IsBarrier(
+		graph.GetFinalBarriers()[0], BackBufferIndex, FrameGraphUsage::RenderTarget, FrameGraphUsage::Present));
+	CHECK(graph.GetMemoryStatistics().barrierCount == 8);
+}
+
+TEST_CASE(ProducersRunBeforeConsumersDeclaredEarlier)
+{
+	FrameGraph graph;
+	FrameGraphResource output = graph.ImportResource("output", FrameGraphUsage::Present, FrameGraphUsage::Present);
+	FrameGraphResource transient = graph.CreateTransient("transient", 64, 64);
+
+	const FrameGraphPass consumer = graph.AddPass("consumer", true);
+	const FrameGraphPass producer = graph.AddPass("producer");
+
+	transient = graph.Write(producer, transient, FrameGraphUsage::RenderTarget);
+	graph.Read(consumer, transient, FrameGraphUsage::ShaderResource);
+	graph.Write(consumer, output, FrameGraphUsage::RenderTarget);
+
+	graph.Compile();
+
+	const std::vector<FrameGraphPass> expectedOrder = {producer, consumer};
+	CHECK(graph.GetExecutionOrder() == expectedOrder);
+}
+
+TEST_CASE(SplitBarriersStartAfterTheLastUse)
+{
+	// Shadow map, apoi sase fete de cubemap si pass-ul principal care le citeste pe amandoua
+	for (bool useSplitBarriers : {false, true})
+	{
+		FrameGraph graph;
+		FrameGraphResource shadowMap =
+			graph.ImportResource("shadowMap", FrameGraphUsage::ShaderResource, FrameGraphUsage::ShaderResource);
+		FrameGraphResource cubeMap =
+			graph.ImportResource("cubeMap", FrameGraphUsage::ShaderResource, FrameGraphUsage::ShaderResource);
+		FrameGraphResource cubeDepth =
+			graph.ImportResource("cubeDepth", FrameGraphUsage::DepthWrite, FrameGraphUsage::Undefined);
+
+		const FrameGraphPass shadowPass = graph.AddPass("shadow");
+		shadowMap = graph.Write(shadowPass, shadowMap, FrameGraphUsage::DepthWrite);
+
+		FrameGraphPass firstFacePass = FrameGraph::NoPass;
+		for (int face = 0; face < 6; face++)
+		{
+			const FrameGraphPass facePass = graph.AddPass("face");
+			if (face == 0)
+				firstFacePass = facePass;
+
+			cubeMap = graph.Write(facePass, cubeMap, FrameGraphUsage::RenderTarget);
+			cubeDepth = graph.Write(facePass, cubeDepth, FrameGraphUsage::DepthWrite);
+		}
+
+		const FrameGraphPass mainPass = graph.AddPass("main", true);
+		graph.Read(mainPass, shadowMap, FrameGraphUsage::ShaderResource);
+		graph.Read(mainPass, cubeMap, FrameGraphUsage::ShaderResource);
+
+		graph.Compile(useSplitBarriers);
+
+		// Jumatatile unei tranzitii split se numara o singura data
+		CHECK(graph.GetMemoryStatistics().barrierCount == 4);
+
+		const std::vector<FrameGraphBarrier>& faceBarriers = graph.GetBarriers(firstFacePass);
+		const std::vector<FrameGraphBarrier>& mainBarriers = graph.GetBarriers(mainPass);
+		if (!useSplitBarriers)
+		{
+			CHECK(faceBarriers.size() == 1);
+			REQUIRE(mainBarriers.size() == 2);
+			CHECK(mainBarriers[0].split == SplitBarrier::None);
+			continue;
+		}
+
+		// Tranzitia shadow map-ului incepe dupa shadow pass si se termina in main pass
+		REQUIRE(faceBarriers.size() == 2);
+		CHECK(IsBarrier(
+			faceBarriers[1], 0, FrameGraphUsage::DepthWrite, FrameGraphUsage::ShaderResource, SplitBarrier::BeginOnly));
+		REQUIRE(mainBarriers.size() == 2);
+		CHECK(IsBarrier(
+			mainBarriers[0], 0, FrameGraphUsage::DepthWrite, FrameGraphUsage::ShaderResource, SplitBarrier::EndOnly));
+
+		// La fel cubemap-ul, inceput in shadow pass
+		REQUIRE(graph.GetBarriers(shadowPass).size() == 2);
+		CHECK(graph.GetBarriers(shadowPass)[1].split == SplitBarrier::BeginOnly);
+		CHECK(faceBarriers[0].split == SplitBarrier::EndOnly);
+	}
+}
+
+TEST_CASE(ResetRebuildsTheSameGraph)
+{
+	FrameGraph graph;
+
+	for (int frame = 0; frame < 3; frame++)
+	{
+		graph.Reset();
+
+		FrameGraphResource output = graph.ImportResource("output", FrameGraphUsage::Present, FrameGraphUsage::Present);
+		const FrameGraphPass pass = graph.AddPass("pass");
+		graph.Write(pass, output, FrameGraphUsage::RenderTarget);
+		graph.Compile();
+
+		CHECK(graph.GetPassCount() == 1);
+		CHECK(graph.GetResourceCount() == 1);
+		CHECK(graph.GetExecutionOrder().size() == 1);
+		CHECK(graph.GetResourceName(0) == "output");
+		CHECK(graph.GetBarriers(pass).size() == 1);
+	}
+}
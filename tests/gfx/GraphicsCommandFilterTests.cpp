@@ -0,0 +1,316 @@
+#include "TestFramework.hpp"
+
+#include "GraphicsCommandFilter.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using engine::gfx::GraphicsCommandFilter;
+using engine::gfx::StateFilterStatistics;
+
+namespace
+{
+
+// Tipurile D3D12 folosite de filtru, cu aceleasi nume de campuri
+struct FakeVertexBufferView
+{
+	uint64_t BufferLocation;
+	uint32_t SizeInBytes;
+	uint32_t StrideInBytes;
+};
+
+struct FakeIndexBufferView
+{
+	uint64_t BufferLocation;
+	uint32_t SizeInBytes;
+	uint32_t Format;
+};
+
+struct FakeDescriptorHandle
+{
+	uint64_t ptr;
+};
+
+struct FakeObject
+{
+};
+
+// Inregistreaza numele fiecarui apel care ajunge pe command list
+class FakeCommandList
+{
+public:
+	void SetPipelineState(FakeObject*) { Record("SetPipelineState"); }
+	void SetPipelineState1(FakeObject*) { Record("SetPipelineState1"); }
+	void SetGraphicsRootSignature(FakeObject*) { Record("SetGraphicsRootSignature"); }
+	void IASetPrimitiveTopology(uint32_t) { Record("IASetPrimitiveTopology"); }
+	void IASetVertexBuffers(uint32_t, uint32_t, const FakeVertexBufferView*) { Record("IASetVertexBuffers"); }
+	void IASetIndexBuffer(const FakeIndexBufferView*) { Record("IASetIndexBuffer"); }
+	void SetGraphicsRootConstantBufferView(uint32_t, uint64_t) { Record("SetGraphicsRootConstantBufferView"); }
+	void SetGraphicsRootShaderResourceView(uint32_t, uint64_t) { Record("SetGraphicsRootShaderResourceView"); }
+	void SetGraphicsRootDescriptorTable(uint32_t, FakeDescriptorHandle) { Record("SetGraphicsRootDescriptorTable"); }
+	void SetGraphicsRoot32BitConstant(uint32_t, uint32_t, uint32_t) { Record("SetGraphicsRoot32BitConstant"); }
+	void SetGraphicsRoot32BitConstants(uint32_t, uint32_t, const void*, uint32_t)
+	{
+		Record("SetGraphicsRoot32BitConstants");
+	}
+	void SetDescriptorHeaps(uint32_t, FakeObject* const*) { Record("SetDescriptorHeaps"); }
+	void ExecuteIndirect(FakeObject*, uint32_t, FakeObject*, uint64_t, FakeObject*, uint64_t)
+	{
+		Record("ExecuteIndirect");
+	}
+	void ExecuteBundle(FakeCommandList*) { Record("ExecuteBundle"); }
+
+	size_t GetCallCount() const { return m_calls.size(); }
+	const std::string& GetLastCall() const { return m_calls.back(); }
+
+private:
+	void Record(const char* name) { m_calls.emplace_back(name); }
+
+	std::vector<std::string> m_calls;
+};
+
+struct FilterFixture
+{
+	FilterFixture()
+	{
+		filter.SetCommandList(&commandList);
+		filter.Reset();
+	}
+
+	FakeCommandList commandList;
+	GraphicsCommandFilter<FakeCommandList> filter;
+};
+
+}  // namespace
+
+TEST_CASE(RedundantStateIsFiltered)
+{
+	FilterFixture fixture;
+	FakeObject pipelineState, rootSignature;
+	const FakeVertexBufferView vertexBuffer = {0x1000, 256, 32};
+	const FakeIndexBufferView indexBuffer = {0x2000, 128, 42};
+
+	for (int i = 0; i < 3; i++)
+	{
+		fixture.filter.SetPipelineState(&pipelineState);
+		fixture.filter.SetGraphicsRootSignature(&rootSignature);
+		fixture.filter.IASetPrimitiveTopology(4u);
+		fixture.filter.IASetVertexBuffers(0, 1, &vertexBuffer);
+		fixture.filter.IASetIndexBuffer(&indexBuffer);
+		fixture.filter.SetGraphicsRootConstantBufferView(0, 0x3000);
+		fixture.filter.SetGraphicsRootShaderResourceView(1, 0x4000);
+		fixture.filter.SetGraphicsRootDescriptorTable(2, FakeDescriptorHandle{0x5000});
+	}
+
+	CHECK(fixture.commandList.GetCallCount() == 8);
+
+	const StateFilterStatistics& statistics = fixture.filter.GetStatistics();
+	CHECK(statistics.pipelineStates == 2);
+	CHECK(statistics.rootSignatures == 2);
+	CHECK(statistics.primitiveTopologies == 2);
+	CHECK(statistics.vertexBuffers == 2);
+	CHECK(statistics.indexBuffers == 2);
+	CHECK(statistics.rootArguments == 6);
+	CHECK(statistics.GetTotal() == 16);
+}
+
+TEST_CASE(ChangedStateIsSent)
+{
+	FilterFixture fixture;
+	FakeObject first, second;
+	const FakeVertexBufferView vertexBuffers[] = {{0x1000, 256, 32}, {0x2000, 256, 16}};
+	FakeVertexBufferView changedVertexBuffers[] = {{0x1000, 256, 32}, {0x2000, 512, 16}};
+
+	fixture.filter.SetPipelineState(&first);
+	fixture.filter.SetPipelineState(&second);
+	fixture.filter.SetPipelineState(&first);
+	CHECK(fixture.commandList.GetCallCount() == 3);
+
+	// Un singur slot schimbat retrimite tot intervalul
+	fixture.filter.IASetVertexBuffers(0, 2, vertexBuffers);
+	fixture.filter.IASetVertexBuffers(0, 2, changedVertexBuffers);
+	CHECK(fixture.commandList.GetCallCount() == 5);
+
+	fixture.filter.IASetVertexBuffers(0, 2, changedVertexBuffers);
+	CHECK(fixture.commandList.GetCallCount() == 5);
+	CHECK(fixture.filter.GetStatistics().vertexBuffers == 1);
+}
+
+TEST_CASE(NullPipelineStateIsNeverFiltered)
+{
+	FilterFixture fixture;
+
+	fixture.filter.SetPipelineState<FakeObject>(nullptr);
+	fixture.filter.SetPipelineState<FakeObject>(nullptr);
+	CHECK(fixture.commandList.GetCallCount() == 2);
+}
+
+TEST_CASE(StateObjectInvalidatesPipelineState)
+{
+	FilterFixture fixture;
+	FakeObject pipelineState, stateObject;
+
+	fixture.filter.SetPipelineState(&pipelineState);
+	fixture.filter.SetPipelineState1(&stateObject);
+	fixture.filter.SetPipelineState(&pipelineState);
+
+	CHECK(fixture.commandList.GetCallCount() == 3);
+	CHECK(fixture.commandList.GetLastCall() == "SetPipelineState");
+}
+
+TEST_CASE(RootSignatureChangeInvalidatesRootArguments)
+{
+	FilterFixture fixture;
+	FakeObject first, second;
+	const uint32_t constants[] = {7, 9};
+
+	fixture.filter.SetGraphicsRootSignature(&first);
+	fixture.filter.SetGraphicsRootConstantBufferView(0, 0x3000);
+	fixture.filter.SetGraphicsRoot32BitConstants(1, 2, constants, 0);
+	CHECK(fixture.commandList.GetCallCount() == 3);
+
+	// Acelasi root signature nu sterge argumentele
+	fixture.filter.SetGraphicsRootSignature(&first);
+	fixture.filter.SetGraphicsRootConstantBufferView(0, 0x3000);
+	fixture.filter.SetGraphicsRoot32BitConstants(1, 2, constants, 0);
+	CHECK(fixture.commandList.GetCallCount() == 3);
+
+	fixture.filter.SetGraphicsRootSignature(&second);
+	fixture.filter.SetGraphicsRootConstantBufferView(0, 0x3000);
+	fixture.filter.SetGraphicsRoot32BitConstants(1, 2, constants, 0);
+	CHECK(fixture.commandList.GetCallCount() == 6);
+}
+
+TEST_CASE(DescriptorHeapRebindInvalidatesRootArguments)
+{
+	FilterFixture fixture;
+	FakeObject heap;
+	FakeObject* heaps[] = {&heap};
+	FakeObject pipelineState;
+
+	fixture.filter.SetPipelineState(&pipelineState);
+	fixture.filter.SetGraphicsRootDescriptorTable(2, FakeDescriptorHandle{0x5000});
+	fixture.filter.SetDescriptorHeaps(1, heaps);
+	CHECK(fixture.commandList.GetCallCount() == 3);
+
+	// Tabelul trebuie retrimis; PSO-ul nu depinde de heap-uri
+	fixture.filter.SetGraphicsRootDescriptorTable(2, FakeDescriptorHandle{0x5000});
+	fixture.filter.SetPipelineState(&pipelineState);
+	CHECK(fixture.commandList.GetCallCount() == 4);
+	CHECK(fixture.commandList.GetLastCall() == "SetGraphicsRootDescriptorTable");
+}
+
+TEST_CASE(ExecuteIndirectInvalidatesOnlyWrittenRootArguments)
+{
+	FilterFixture fixture;
+	FakeObject commandSignature, argumentBuffer, countBuffer;
+
+	fixture.filter.SetGraphicsRootConstantBufferView(0, 0x3000);
+	fixture.filter.SetGraphicsRoot32BitConstant(1, 5, 0);
+	fixture.filter.SetGraphicsRootShaderResourceView(2, 0x4000);
+
+	// Command signature-ul scrie constanta de la indexul 1
+	fixture.filter.ExecuteIndirect(&commandSignature, 1ull << 1, 16, &argumentBuffer, 0, &countBuffer, 0);
+	CHECK(fixture.commandList.GetCallCount() == 4);
+
+	fixture.filter.SetGraphicsRootConstantBufferView(0, 0x3000);
+	fixture.filter.SetGraphicsRootShaderResourceView(2, 0x4000);
+	CHECK(fixture.commandList.GetCallCount() == 4);
+
+	fixture.filter.SetGraphicsRoot32BitConstant(1, 5, 0);
+	CHECK(fixture.commandList.GetCallCount() == 5);
+}
+
+TEST_CASE(ExecuteBundleInvalidatesAllState)
+{
+	FilterFixture fixture;
+	FakeCommandList bundle;
+	FakeObject pipelineState, rootSignature;
+	const FakeIndexBufferView indexBuffer = {0x2000, 128, 42};
+
+	fixture.filter.SetPipelineState(&pipelineState);
+	fixture.filter.SetGraphicsRootSignature(&rootSignature);
+	fixture.filter.IASetPrimitiveTopology(4u);
+	fixture.filter.IASetIndexBuffer(&indexBuffer);
+	fixture.filter.ExecuteBundle(&bundle);
+	CHECK(fixture.commandList.GetCallCount() == 5);
+
+	fixture.filter.SetPipelineState(&pipelineState);
+	fixture.filter.SetGraphicsRootSignature(&rootSignature);
+	fixture.filter.IASetPrimitiveTopology(4u);
+	fixture.filter.IASetIndexBuffer(&indexBuffer);
+	CHECK(fixture.commandList.GetCallCount() == 9);
+
+	// Statisticile raman dupa invalidare
+	fixture.filter.SetPipelineState(&pipelineState);
+	CHECK(fixture.filter.GetStatistics().pipelineStates == 1);
+}
+
+TEST_CASE(ResetForgetsStateAndStatistics)
+{
+	FilterFixture fixture;
+	FakeObject pipelineState;
+
+	fixture.filter.SetPipelineState(&pipelineState);
+	fixture.filter.SetPipelineState(&pipelineState);
+	CHECK(fixture.filter.GetStatistics().GetTotal() == 1);
+
+	fixture.filter.Reset();
+	CHECK(fixture.filter.GetStatistics().GetTotal() == 0);
+
+	fixture.filter.SetPipelineState(&pipelineState);
+	CHECK(fixture.commandList.GetCallCount() == 2);
+}
+
+TEST_CASE(SingleConstantDoesNotValidateSecondDword)
+{
+	FilterFixture fixture;
+	const uint32_t first[] = {3, 5};
+	const uint32_t second[] = {8, 0};
+
+	fixture.filter.SetGraphicsRoot32BitConstants(0, 2, first, 0);
+	fixture.filter.SetGraphicsRoot32BitConstant(0, 8, 0);
+	CHECK(fixture.commandList.GetCallCount() == 2);
+
+	// Dword-ul 1 e inca 5 pe command list, deci {8, 0} trebuie trimis
+	fixture.filter.SetGraphicsRoot32BitConstants(0, 2, second, 0);
+	CHECK(fixture.commandList.GetCallCount() == 3);
+
+	fixture.filter.SetGraphicsRoot32BitConstants(0, 2, second, 0);
+	fixture.filter.SetGraphicsRoot32BitConstant(0, 0, 1);
+	CHECK(fixture.commandList.GetCallCount() == 3);
+}
+
+TEST_CASE(ConstantAtOffsetUpdatesItsDword)
+{
+	FilterFixture fixture;
+	const uint32_t values[] = {3, 5};
+	const uint32_t changed[] = {3, 6};
+
+	fixture.filter.SetGraphicsRoot32BitConstants(0, 2, values, 0);
+	fixture.filter.SetGraphicsRoot32BitConstant(0, 6, 1);
+	CHECK(fixture.commandList.GetCallCount() == 2);
+
+	fixture.filter.SetGraphicsRoot32BitConstants(0, 2, changed, 0);
+	CHECK(fixture.commandList.GetCallCount() == 2);
+
+	fixture.filter.SetGraphicsRoot32BitConstants(0, 2, values, 0);
+	CHECK(fixture.commandList.GetCallCount() == 3);
+}
+
+TEST_CASE(ConstantsPastCachedRangeAreNeverFiltered)
+{
+	FilterFixture fixture;
+	const uint32_t values[] = {1, 2, 3};
+
+	fixture.filter.SetGraphicsRoot32BitConstant(0, 9, 4);
+	fixture.filter.SetGraphicsRoot32BitConstant(0, 9, 4);
+	fixture.filter.SetGraphicsRoot32BitConstants(1, 3, values, 0);
+	fixture.filter.SetGraphicsRoot32BitConstants(1, 3, values, 0);
+	CHECK(fixture.commandList.GetCallCount() == 4);
+
+	// Primele doua dword-uri au fost retinute
+	fixture.filter.SetGraphicsRoot32BitConstants(1, 2, values, 0);
+	CHECK(fixture.commandList.GetCallCount() == 4);
+}
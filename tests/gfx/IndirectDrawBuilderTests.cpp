@@ -0,0 +1,112 @@
+#include "TestFramework.hpp"
+
+#include "IndirectDrawBuilder.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using engine::gfx::DrawRange;
+using engine::gfx::IndirectDrawBuilder;
+using engine::gfx::IndirectDrawIndexedArguments;
+using engine::gfx::IndirectObjectDrawArguments;
+using engine::gfx::MakeIndirectDrawArguments;
+using engine::gfx::SubMesh;
+
+namespace
+{
+
+template <typename T>
+T ReadAt(const std::vector<uint8_t>& memory, uint64_t offset)
+{
+	T value;
+	memcpy(&value, memory.data() + offset, sizeof(T));
+	return value;
+}
+
+}  // namespace
+
+TEST_CASE(ArgumentsStartAlignedAfterTheCounts)
+{
+	IndirectDrawBuilder<IndirectObjectDrawArguments> builder;
+	builder.Create(3, 5);
+
+	CHECK(builder.GetCountOffset(2) == 8);
+	CHECK(builder.GetArgumentOffset(0) == 16);
+	CHECK(builder.GetArgumentOffset(1) == 16 + 5 * 32);
+	CHECK(builder.GetBufferSize() == 16 + 3 * 5 * 32);
+
+	// Numar de view-uri multiplu de 4: argumentele urmeaza direct dupa numere
+	builder.Create(8, 5);
+	CHECK(builder.GetArgumentOffset(0) == 32);
+	CHECK(builder.GetBufferSize() == 32 + 8 * 5 * 32);
+}
+
+TEST_CASE(PackWritesCountsAndDrawsPerView)
+{
+	IndirectDrawBuilder<IndirectObjectDrawArguments> builder;
+	builder.Create(8, 5);
+
+	IndirectObjectDrawArguments first = {};
+	first.objectCBAddress = 0xABCD;
+	first.draw = {36, 1, 6, 2, 0};
+
+	IndirectObjectDrawArguments second = {};
+	second.objectCBAddress = 0x1;
+	second.draw = {6, 1, 0, 0, 0};
+
+	builder.Add(3, first);
+	builder.Add(3, second);
+	builder.Add(7, first);
+
+	std::vector<uint8_t> memory(builder.GetBufferSize(), 0xEE);
+	builder.Pack(memory.data());
+
+	CHECK(ReadAt<uint32_t>(memory, builder.GetCountOffset(0)) == 0);
+	CHECK(ReadAt<uint32_t>(memory, builder.GetCountOffset(3)) == 2);
+	CHECK(ReadAt<uint32_t>(memory, builder.GetCountOffset(7)) == 1);
+
+	const auto packed = ReadAt<IndirectObjectDrawArguments>(memory, builder.GetArgumentOffset(3) + 32);
+	CHECK(packed.objectCBAddress == 0x1);
+	CHECK(packed.draw.indexCountPerInstance == 6);
+
+	const auto last = ReadAt<IndirectObjectDrawArguments>(memory, builder.GetArgumentOffset(7));
+	CHECK(last.draw.startIndexLocation == 6 && last.draw.baseVertexLocation == 2);
+
+	// Zona nefolosita a unui view nu se scrie: GPU-ul citeste doar cate draw-uri spune count buffer-ul
+	CHECK(memory[builder.GetArgumentOffset(0)] == 0xEE);
+}
+
+TEST_CASE(ResetClearsCountsButKeepsTheLayout)
+{
+	IndirectDrawBuilder<IndirectDrawIndexedArguments> builder;
+	builder.Create(2, 4);
+
+	builder.Add(0, MakeIndirectDrawArguments(DrawRange{0, 3, 0}));
+	builder.Add(1, MakeIndirectDrawArguments(DrawRange{3, 6, 0}));
+	const uint64_t bufferSize = builder.GetBufferSize();
+
+	builder.Reset();
+	CHECK(builder.GetDrawCount(0) == 0);
+	CHECK(builder.GetDrawCount(1) == 0);
+	CHECK(builder.GetBufferSize() == bufferSize);
+
+	builder.Add(1, MakeIndirectDrawArguments(DrawRange{9, 3, 0}));
+	REQUIRE(builder.GetDrawCount(1) == 1);
+	CHECK(builder.GetDraws(1)[0].startIndexLocation == 9);
+}
+
+TEST_CASE(ArgumentsAreBuiltFromRangesAndSubMeshes)
+{
+	const IndirectDrawIndexedArguments fromRange = MakeIndirectDrawArguments(DrawRange{12, 24, -4});
+	CHECK(fromRange.indexCountPerInstance == 24);
+	CHECK(fromRange.instanceCount == 1);
+	CHECK(fromRange.startIndexLocation == 12);
+	CHECK(fromRange.baseVertexLocation == -4);
+	CHECK(fromRange.startInstanceLocation == 0);
+
+	const IndirectDrawIndexedArguments fromSubMesh = MakeIndirectDrawArguments(SubMesh{36, 6, 100});
+	CHECK(fromSubMesh.indexCountPerInstance == 36);
+	CHECK(fromSubMesh.startIndexLocation == 6);
+	CHECK(fromSubMesh.baseVertexLocation == 100);
+}
@@ -0,0 +1,137 @@
+#include "TestFramework.hpp"
+
+#include "InstanceBatcher.hpp"
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+using engine::gfx::InstanceBatcher;
+using engine::gfx::InstanceGroup;
+using engine::gfx::SubMesh;
+
+TEST_CASE(SameMeshAndMaterialShareAGroup)
+{
+	InstanceBatcher batcher;
+	batcher.Create(2);
+
+	const SubMesh rock = {100, 30, 0};
+	const SubMesh tree = {200, 60, 5};
+
+	batcher.Add(0, rock, 1, 0);
+	batcher.Add(0, tree, 1, 1);
+	batcher.Add(0, rock, 1, 2);
+	batcher.Add(0, rock, 2, 3);
+	batcher.Add(1, rock, 1, 0);
+	batcher.Build();
+
+	const std::vector<InstanceGroup>& groups = batcher.GetGroups(0);
+	REQUIRE(groups.size() == 3);
+
+	CHECK(groups[0].mesh.startIndexLocation == 30 && groups[0].materialID == 1);
+	CHECK(groups[0].firstInstance == 0 && groups[0].instanceCount == 2);
+	CHECK(groups[1].materialID == 2 && groups[1].instanceCount == 1);
+	CHECK(groups[2].mesh.baseVertexLocation == 5 && groups[2].firstInstance == 3);
+
+	// Instantele view-ului 1 urmeaza dupa cele ale view-ului 0
+	REQUIRE(batcher.GetGroups(1).size() == 1);
+	CHECK(batcher.GetGroups(1)[0].firstInstance == 4);
+
+	const std::vector<uint32_t> expectedObjects = {0, 2, 3, 1, 0};
+	CHECK(batcher.GetInstanceObjects() == expectedObjects);
+	CHECK(batcher.GetInstanceCount() == 5);
+}
+
+TEST_CASE(ResultDoesNotDependOnAddOrder)
+{
+	const SubMesh mesh = {36, 0, 0};
+
+	InstanceBatcher forward;
+	forward.Create(1);
+	for (uint32_t object = 0; object < 8; object++)
+		forward.Add(0, mesh, object % 2, object);
+	forward.Build();
+
+	InstanceBatcher backward;
+	backward.Create(1);
+	for (uint32_t object = 8; object-- > 0;)
+		backward.Add(0, mesh, object % 2, object);
+	backward.Build();
+
+	CHECK(forward.GetInstanceObjects() == backward.GetInstanceObjects());
+	CHECK(forward.GetGroups(0).size() == 2);
+}
+
+TEST_CASE(ResetStartsAnEmptyFrame)
+{
+	InstanceBatcher batcher;
+	batcher.Create(2);
+
+	batcher.Add(0, {6, 0, 0}, 0, 0);
+	batcher.Add(1, {6, 0, 0}, 0, 0);
+	batcher.Build();
+
+	batcher.Reset();
+	batcher.Build();
+	CHECK(batcher.GetGroups(0).empty());
+	CHECK(batcher.GetGroups(1).empty());
+	CHECK(batcher.GetInstanceCount() == 0);
+}
+
+TEST_CASE(RandomObjectsAreGroupedPerViewMeshAndMaterial)
+{
+	constexpr uint32_t ViewCount = 8;
+
+	std::mt19937 random(3);
+	InstanceBatcher batcher;
+	batcher.Create(ViewCount);
+
+	for (int iteration = 0; iteration < 500; iteration++)
+	{
+		batcher.Reset();
+
+		// Numarul de instante asteptat pentru fiecare (view, mesh, material)
+		std::map<std::pair<uint32_t, uint32_t>, uint32_t> expected[ViewCount];
+		uint32_t addedCount = 0;
+
+		const uint32_t objectCount = random() % 50;
+		for (uint32_t object = 0; object < objectCount; object++)
+		{
+			const uint32_t meshIndex = random() % 4;
+			const uint32_t materialID = random() % 3;
+			const SubMesh subMesh = {meshIndex * 30 + 3, meshIndex * 100, meshIndex * 7};
+
+			for (uint32_t view = 0; view < ViewCount; view++)
+			{
+				if (random() % 2 == 0)
+					continue;
+
+				batcher.Add(view, subMesh, materialID, object);
+				expected[view][{meshIndex, materialID}]++;
+				addedCount++;
+			}
+		}
+
+		batcher.Build();
+		CHECK(batcher.GetInstanceCount() == addedCount);
+
+		// Grupurile acopera bufferul de instante fara goluri, in ordinea view-urilor
+		uint32_t nextInstance = 0;
+		for (uint32_t view = 0; view < ViewCount; view++)
+		{
+			CHECK(batcher.GetGroups(view).size() == expected[view].size());
+
+			for (const InstanceGroup& group : batcher.GetGroups(view))
+			{
+				CHECK(group.firstInstance == nextInstance);
+				nextInstance += group.instanceCount;
+
+				const uint32_t meshIndex = (group.mesh.indexCount - 3) / 30;
+				const uint32_t expectedCount = expected[view][{meshIndex, group.materialID}];
+				CHECK(expectedCount == group.instanceCount);
+			}
+		}
+	}
+}
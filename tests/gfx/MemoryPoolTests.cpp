@@ -0,0 +1,234 @@
+#include "TestFramework.hpp"
+
+#include "MemoryPool.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using engine::gfx::MemoryAllocation;
+using engine::gfx::MemoryMove;
+using engine::gfx::MemoryPool;
+
+namespace
+{
+
+constexpr uint64_t BlockSize = 1 << 22;
+constexpr uint64_t MinAllocationSize = 1 << 16;
+
+MemoryAllocation AllocateOrGrow(MemoryPool& pool, uint64_t size)
+{
+	MemoryAllocation allocation;
+	if (!pool.Allocate(size, MinAllocationSize, allocation))
+	{
+		pool.AddBlock();
+		pool.Allocate(size, MinAllocationSize, allocation);
+	}
+
+	return allocation;
+}
+
+// Copierea pe care o face GpuMemoryAllocator, doar in evidenta alocarilor
+void ApplyMoves(MemoryPool& pool, const std::vector<MemoryMove>& moves, std::vector<MemoryAllocation>& allocations)
+{
+	for (const MemoryMove& move : moves)
+	{
+		const auto it = std::find_if(
+			allocations.begin(),
+			allocations.end(),
+			[&move](const MemoryAllocation& allocation)
+			{ return allocation.block == move.source.block && allocation.offset == move.source.offset; });
+
+		CHECK(it != allocations.end());
+		if (it != allocations.end())
+			*it = move.destination;
+
+		if (pool.Free(move.source))
+			pool.RemoveBlock(move.source.block);
+	}
+}
+
+}  // namespace
+
+TEST_CASE(AllocateFailsUntilABlockIsAdded)
+{
+	MemoryPool pool;
+	pool.Create(BlockSize, MinAllocationSize);
+
+	MemoryAllocation allocation;
+	CHECK(!pool.Allocate(1024, 256, allocation));
+	CHECK(!allocation.IsValid());
+
+	CHECK(pool.AddBlock() == 0);
+	CHECK(pool.Allocate(1024, 256, allocation));
+	CHECK(allocation.block == 0 && allocation.offset == 0 && allocation.size == 1024);
+	CHECK(pool.GetUsedSize() == MinAllocationSize);
+
+	// Mai mare decat un bloc: nu incape nicaieri
+	CHECK(!pool.Allocate(BlockSize + 1, 256, allocation));
+}
+
+TEST_CASE(RemovedBlockSlotsAreReused)
+{
+	MemoryPool pool;
+	pool.Create(BlockSize, MinAllocationSize);
+
+	pool.AddBlock();
+	pool.AddBlock();
+
+	MemoryAllocation first, second;
+	CHECK(pool.Allocate(BlockSize, MinAllocationSize, first));
+	CHECK(pool.Allocate(BlockSize, MinAllocationSize, second));
+	CHECK(first.block == 0 && second.block == 1);
+
+	CHECK(pool.Free(first));
+	pool.RemoveBlock(first.block);
+	CHECK(!pool.IsBlockUsed(0));
+	CHECK(pool.GetBlockCount() == 1);
+	CHECK(pool.GetBlockSlotCount() == 2);
+
+	CHECK(pool.AddBlock() == 0);
+	CHECK(pool.GetBlockCount() == 2);
+}
+
+TEST_CASE(FreeReportsEmptyBlocks)
+{
+	MemoryPool pool;
+	pool.Create(BlockSize, MinAllocationSize);
+	pool.AddBlock();
+
+	const MemoryAllocation first = AllocateOrGrow(pool, MinAllocationSize);
+	const MemoryAllocation second = AllocateOrGrow(pool, MinAllocationSize);
+
+	CHECK(!pool.Free(first));
+	CHECK(pool.Free(second));
+	CHECK(pool.GetFragmentation() == 0.f);
+}
+
+TEST_CASE(FragmentationMeasuresTheWorstBlock)
+{
+	MemoryPool pool;
+	pool.Create(BlockSize, MinAllocationSize);
+	pool.AddBlock();
+
+	std::vector<MemoryAllocation> allocations;
+	for (uint64_t i = 0; i < BlockSize / MinAllocationSize; i++)
+		allocations.push_back(AllocateOrGrow(pool, MinAllocationSize));
+
+	// Fiecare al doilea bloc liber: jumatate din memorie e libera, dar in bucati minime
+	for (size_t i = 0; i < allocations.size(); i += 2)
+		pool.Free(allocations[i]);
+
+	const float expected = 1.f - (float)MinAllocationSize / (float)(BlockSize / 2);
+	CHECK(pool.GetFragmentation() == expected);
+}
+
+TEST_CASE(PlanDefragmentationEmptiesTheLeastUsedBlock)
+{
+	MemoryPool pool;
+	pool.Create(BlockSize, MinAllocationSize);
+
+	std::vector<MemoryAllocation> allocations;
+	for (int i = 0; i < 3 * 64; i++)
+		allocations.push_back(AllocateOrGrow(pool, MinAllocationSize));
+
+	CHECK(pool.GetBlockCount() == 3);
+
+	// Blocul 2 ramane cu cele mai putine alocari
+	std::vector<MemoryAllocation> kept;
+	for (const MemoryAllocation& allocation : allocations)
+	{
+		const bool keep = allocation.block == 2 ? allocation.offset % (8 * MinAllocationSize) == 0
+												: allocation.offset % (2 * MinAllocationSize) == 0;
+		if (keep)
+			kept.push_back(allocation);
+		else
+			pool.Free(allocation);
+	}
+
+	const uint64_t usedSize = pool.GetUsedSize();
+
+	std::vector<MemoryMove> moves = pool.PlanDefragmentation(4);
+	CHECK(moves.size() == 4);
+	for (const MemoryMove& move : moves)
+	{
+		CHECK(move.source.block == 2);
+		CHECK(move.destination.block != 2);
+		CHECK(move.destination.size == move.source.size);
+		CHECK(move.destination.offset % move.destination.size == 0);
+	}
+
+	// Destinatiile sunt rezervate pana la eliberarea surselor
+	CHECK(pool.GetUsedSize() == usedSize + 4 * MinAllocationSize);
+	ApplyMoves(pool, moves, kept);
+	CHECK(pool.GetUsedSize() == usedSize);
+
+	moves = pool.PlanDefragmentation(64);
+	CHECK(moves.size() == 4);
+	ApplyMoves(pool, moves, kept);
+
+	CHECK(pool.GetBlockCount() == 2);
+	CHECK(!pool.IsBlockUsed(2));
+	CHECK(pool.GetUsedSize() == usedSize);
+}
+
+TEST_CASE(PlanDefragmentationNeedsTwoBlocks)
+{
+	MemoryPool pool;
+	pool.Create(BlockSize, MinAllocationSize);
+
+	CHECK(pool.PlanDefragmentation(16).empty());
+
+	AllocateOrGrow(pool, MinAllocationSize);
+	CHECK(pool.PlanDefragmentation(16).empty());
+}
+
+TEST_CASE(RandomChurnDefragmentsWithoutLosingAllocations)
+{
+	MemoryPool pool;
+	pool.Create(BlockSize, MinAllocationSize);
+
+	std::mt19937 random(11);
+
+	std::vector<MemoryAllocation> allocations;
+	for (int i = 0; i < 400; i++)
+		allocations.push_back(AllocateOrGrow(pool, (1 + random() % 8) * MinAllocationSize));
+
+	const size_t blockCount = pool.GetBlockCount();
+
+	std::shuffle(allocations.begin(), allocations.end(), random);
+	const size_t freedCount = allocations.size() * 2 / 3;
+	for (size_t i = 0; i < freedCount; i++)
+	{
+		if (pool.Free(allocations[i]))
+			pool.RemoveBlock(allocations[i].block);
+	}
+	allocations.erase(allocations.begin(), allocations.begin() + freedCount);
+
+	const uint64_t usedSize = pool.GetUsedSize();
+
+	for (int round = 0; round < 64; round++)
+	{
+		const std::vector<MemoryMove> moves = pool.PlanDefragmentation(64);
+		if (moves.empty())
+			break;
+
+		ApplyMoves(pool, moves, allocations);
+	}
+
+	CHECK(pool.GetUsedSize() == usedSize);
+	CHECK(pool.GetBlockCount() < blockCount);
+
+	// Toate alocarile raman valide dupa mutari
+	for (const MemoryAllocation& allocation : allocations)
+		CHECK(pool.IsBlockUsed(allocation.block));
+
+	for (const MemoryAllocation& allocation : allocations)
+	{
+		if (pool.Free(allocation))
+			pool.RemoveBlock(allocation.block);
+	}
+
+	CHECK(pool.GetBlockCount() == 0);
+}
@@ -0,0 +1,219 @@
+#include "TestFramework.hpp"
+#include "TestMatrices.hpp"
+
+#include "MultiViewCuller.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace CullingView = engine::gfx::CullingView;
+using engine::gfx::MultiViewCuller;
+using engine::math::BoxBounds;
+using engine::math::Float3;
+using engine::math::Float4;
+using engine::math::Float4x4;
+
+namespace
+{
+
+constexpr int ChunkCountPerSide = 32;
+constexpr float ChunkSize = 16.f;
+
+// Chunk-uri de teren ca in GenerateChunks, centrate in origine, cu inaltimi diferite
+std::vector<BoxBounds> MakeChunkGrid()
+{
+	std::vector<BoxBounds> chunks;
+	const float origin = -ChunkCountPerSide * ChunkSize / 2.f;
+
+	for (int row = 0; row < ChunkCountPerSide; row++)
+	{
+		for (int column = 0; column < ChunkCountPerSide; column++)
+		{
+			const float x = origin + row * ChunkSize;
+			const float z = origin + column * ChunkSize;
+			const float height = 2.f + (float)((row * 7 + column * 3) % 5);
+			chunks.push_back({{x, -1.f, z}, {x + ChunkSize, height, z + ChunkSize}});
+		}
+	}
+
+	return chunks;
+}
+
+// Testul de referinta in clip space: cutia e eliminata doar daca toate colturile ei sunt in afara aceluiasi plan
+bool IsInClipVolume(const Float4x4& viewProj, const BoxBounds& bounds)
+{
+	Float4 corners[8];
+	for (int i = 0; i < 8; i++)
+	{
+		const Float3 corner = {
+			(i & 1) ? bounds.max[0] : bounds.min[0],
+			(i & 2) ? bounds.max[1] : bounds.min[1],
+			(i & 4) ? bounds.max[2] : bounds.min[2]};
+		corners[i] = engine::math::TransformPoint(viewProj, corner);
+	}
+
+	const auto allOutside = [&corners](auto distance)
+	{
+		for (const Float4& corner : corners)
+		{
+			if (distance(corner) >= 0.f)
+				return false;
+		}
+
+		return true;
+	};
+
+	return !allOutside([](const Float4& c) { return c[2]; })
+		&& !allOutside([](const Float4& c) { return c[3] - c[2]; })
+		&& !allOutside([](const Float4& c) { return c[3] - c[0]; })
+		&& !allOutside([](const Float4& c) { return c[3] + c[0]; })
+		&& !allOutside([](const Float4& c) { return c[3] - c[1]; })
+		&& !allOutside([](const Float4& c) { return c[3] + c[1]; });
+}
+
+bool IsInRange(const Float3& position, float maxDistance, const BoxBounds& bounds)
+{
+	if (maxDistance <= 0.f)
+		return true;
+
+	const float dx = (bounds.min[0] + bounds.max[0]) / 2.f - position[0];
+	const float dy = (bounds.min[1] + bounds.max[1]) / 2.f - position[1];
+	const float dz = (bounds.min[2] + bounds.max[2]) / 2.f - position[2];
+	return dx * dx + dy * dy + dz * dz < maxDistance * maxDistance;
+}
+
+struct TestView
+{
+	CullingView::Value view;
+	Float4x4 viewProj;
+	Float3 position;
+	float maxDistance;
+};
+
+std::vector<TestView> MakeViews()
+{
+	std::vector<TestView> views;
+
+	// Camera principala, deasupra terenului, cu far mai mic decat terenul
+	const Float3 eye = {-37.f, 25.f, -61.f};
+	views.push_back(
+		{CullingView::Main,
+		 engine::math::Multiply(
+			 engine::tests::LookAtLH(eye, {40.f, 0.f, 90.f}, {0.f, 1.f, 0.f}),
+			 engine::tests::PerspectiveFovLH(1.f, 16.f / 9.f, 0.5f, 180.f)),
+		 eye,
+		 180.f});
+
+	// Shadow map-ul: ortografic, de sus, peste o parte din teren si fara test de distanta
+	const Float3 light = {13.f, 200.f, 7.f};
+	views.push_back(
+		{CullingView::Shadow,
+		 engine::math::Multiply(
+			 engine::tests::LookAtLH(light, {13.f, 0.f, 7.f}, {0.f, 0.f, 1.f}),
+			 engine::tests::OrthographicLH(150.f, 110.f, 1.f, 400.f)),
+		 light,
+		 0.f});
+
+	// O fata de cube map, cu distanta maxima mica
+	const Float3 probe = {5.f, 10.f, 3.f};
+	views.push_back(
+		{CullingView::CubeMapFace0,
+		 engine::math::Multiply(
+			 engine::tests::LookAtLH(probe, {100.f, 10.f, 3.f}, {0.f, 1.f, 0.f}),
+			 engine::tests::PerspectiveFovLH(3.14159265f / 2.f, 1.f, 0.1f, 100.f)),
+		 probe,
+		 100.f});
+
+	return views;
+}
+
+}  // namespace
+
+TEST_CASE(CulledRatioMatchesTheChunkGrid)
+{
+	const std::vector<BoxBounds> chunks = MakeChunkGrid();
+	const std::vector<TestView> views = MakeViews();
+
+	MultiViewCuller culler;
+	for (const TestView& view : views)
+	{
+		culler.SetView(
+			view.view,
+			engine::tests::ExtractFrustumPlanes(view.viewProj),
+			view.viewProj,
+			view.position,
+			view.maxDistance);
+	}
+
+	culler.BeginSweep();
+
+	std::vector<int> expectedVisible(views.size(), 0);
+	bool masksMatch = true;
+	for (const BoxBounds& chunk : chunks)
+	{
+		const CullingView::Mask mask = culler.Cull(chunk);
+
+		CullingView::Mask expectedMask = 0;
+		for (size_t i = 0; i < views.size(); i++)
+		{
+			const TestView& view = views[i];
+			if (IsInRange(view.position, view.maxDistance, chunk) && IsInClipVolume(view.viewProj, chunk))
+			{
+				expectedMask |= CullingView::ToMask(view.view);
+				expectedVisible[i]++;
+			}
+		}
+
+		masksMatch = masksMatch && mask == expectedMask;
+	}
+
+	CHECK(masksMatch);
+
+	for (size_t i = 0; i < views.size(); i++)
+	{
+		// Fiecare view elimina o parte din grila, dar nu tot
+		CHECK(expectedVisible[i] > 0);
+		CHECK(expectedVisible[i] < (int)chunks.size());
+
+		const float expectedRatio = 1.f - (float)expectedVisible[i] / chunks.size();
+		CHECK(std::abs(culler.GetCulledRatio(views[i].view) - expectedRatio) < 1e-6f);
+	}
+
+	// View-urile neactivate nu raporteaza nimic
+	CHECK(culler.GetCulledRatio((CullingView::Value)(CullingView::CubeMapFace0 + 1)) == 0.f);
+}
+
+TEST_CASE(SweepResetsTheCulledRatio)
+{
+	const std::vector<BoxBounds> chunks = MakeChunkGrid();
+	const TestView view = MakeViews()[0];
+
+	MultiViewCuller culler;
+	culler.SetView(
+		view.view, engine::tests::ExtractFrustumPlanes(view.viewProj), view.viewProj, view.position, view.maxDistance);
+
+	culler.BeginSweep();
+	for (const BoxBounds& chunk : chunks)
+		culler.Cull(chunk);
+
+	const float fullRatio = culler.GetCulledRatio(CullingView::Main);
+	CHECK(fullRatio > 0.f);
+
+	// O noua trecere doar peste chunk-urile vizibile: nimic nu mai e eliminat
+	culler.BeginSweep();
+	CHECK(culler.GetCulledRatio(CullingView::Main) == 0.f);
+
+	for (const BoxBounds& chunk : chunks)
+	{
+		if (IsInRange(view.position, view.maxDistance, chunk) && IsInClipVolume(view.viewProj, chunk))
+			culler.Cull(chunk);
+	}
+
+	CHECK(culler.GetCulledRatio(CullingView::Main) == 0.f);
+
+	// Dupa DisableView raportul e 0, iar masca nu mai contine view-ul
+	culler.DisableView(CullingView::Main);
+	culler.BeginSweep();
+	CHECK(culler.Cull(chunks[0]) == 0);
+	CHECK(culler.GetCulledRatio(CullingView::Main) == 0.f);
+}
@@ -0,0 +1,133 @@
+#include "TestFramework.hpp"
+#include "TestMatrices.hpp"
+
+#include "OcclusionCuller.hpp"
+#include "RecordingScheduler.hpp"
+
+#include <cmath>
+#include <vector>
+
+using engine::gfx::Heightfield;
+using engine::gfx::OcclusionCuller;
+using engine::gfx::RecordingScheduler;
+using engine::math::BoxBounds;
+using engine::math::Float3;
+
+namespace
+{
+
+// Camera in origine, privind spre +z
+engine::math::Float4x4 MakeViewProjection()
+{
+	return engine::tests::PerspectiveFovLH(1.f, 2.f, 0.5f, 250.f);
+}
+
+BoxBounds MakeBox(float minX, float minY, float minZ, float maxX, float maxY, float maxZ)
+{
+	return {{minX, minY, minZ}, {maxX, maxY, maxZ}};
+}
+
+// Perete de 20 x 20 la z = 10, in fata camerei
+OcclusionCuller::Occluder MakeWall()
+{
+	OcclusionCuller::Occluder wall;
+	wall.vertices = {{-10.f, -10.f, 10.f}, {10.f, -10.f, 10.f}, {10.f, 10.f, 10.f}, {-10.f, 10.f, 10.f}};
+	wall.indices = {0, 1, 2, 0, 2, 3};
+
+	return wall;
+}
+
+}  // namespace
+
+TEST_CASE(WallHidesOnlyWhatIsBehindIt)
+{
+	OcclusionCuller culler(256, 128, 4);
+	culler.BeginFrame(MakeViewProjection());
+	culler.AddOccluder(MakeWall());
+	culler.Rasterize();
+
+	CHECK(culler.GetRasterizedTriangleCount() == 2);
+
+	CHECK(!culler.IsVisible(MakeBox(-1.f, -1.f, 20.f, 1.f, 1.f, 22.f)));
+	CHECK(!culler.IsVisible(MakeBox(30.f, -1.f, 40.f, 32.f, 1.f, 42.f)));
+
+	CHECK(culler.IsVisible(MakeBox(-1.f, -1.f, 5.f, 1.f, 1.f, 6.f)));
+	CHECK(culler.IsVisible(MakeBox(-1.f, -1.f, 8.f, 1.f, 1.f, 12.f)));
+	CHECK(culler.IsVisible(MakeBox(11.f, -1.f, 11.f, 12.f, 1.f, 12.f)));
+
+	// Cutiile care ating planul near sunt considerate vizibile
+	CHECK(culler.IsVisible(MakeBox(-1.f, -1.f, -5.f, 1.f, 1.f, 1.f)));
+}
+
+TEST_CASE(SchedulerGivesTheSerialDepth)
+{
+	OcclusionCuller serialCuller(256, 128, 8);
+	serialCuller.BeginFrame(MakeViewProjection());
+	serialCuller.AddOccluder(MakeWall());
+	serialCuller.Rasterize();
+
+	RecordingScheduler scheduler;
+	scheduler.Create(3);
+
+	OcclusionCuller parallelCuller(256, 128, 8);
+	parallelCuller.BeginFrame(MakeViewProjection());
+	parallelCuller.AddOccluder(MakeWall());
+	parallelCuller.Rasterize(&scheduler);
+
+	// Benzile nu impart tile-uri, deci ordinea in care le iau workerii nu conteaza
+	bool isSame = true;
+	for (uint32_t y = 0; y < 128 / OcclusionCuller::TileHeight; y++)
+	{
+		for (uint32_t x = 0; x < 256 / OcclusionCuller::TileWidth; x++)
+			isSame = isSame && serialCuller.GetTileDepth(x, y) == parallelCuller.GetTileDepth(x, y);
+	}
+
+	CHECK(isSame);
+	CHECK(!parallelCuller.IsVisible(MakeBox(-1.f, -1.f, 20.f, 1.f, 1.f, 22.f)));
+}
+
+TEST_CASE(EmptyFrameHidesNothing)
+{
+	OcclusionCuller culler(256, 128, 4);
+	culler.BeginFrame(MakeViewProjection());
+	culler.Rasterize();
+
+	CHECK(culler.GetRasterizedTriangleCount() == 0);
+	CHECK(culler.IsVisible(MakeBox(-1.f, -1.f, 200.f, 1.f, 1.f, 201.f)));
+}
+
+TEST_CASE(HeightfieldOccluderStaysBelowTheTerrain)
+{
+	constexpr int SidePointCount = 65;
+
+	// Creasta de-a lungul lui z, cu valuri mici
+	Heightfield heightfield;
+	heightfield.sidePointCount = SidePointCount;
+	heightfield.minX = heightfield.minZ = -32.f;
+	heightfield.stepX = heightfield.stepZ = 1.f;
+
+	for (int i = 0; i < SidePointCount; i++)
+	{
+		for (int j = 0; j < SidePointCount; j++)
+		{
+			const float x = heightfield.GetX(i);
+			const float z = heightfield.GetZ(j);
+			heightfield.heights.push_back(20.f * std::exp(-x * x / 50.f) + std::sin(z) * 0.5f);
+		}
+	}
+
+	const OcclusionCuller::Occluder occluder = OcclusionCuller::BuildHeightfieldOccluder(heightfield, 16);
+
+	CHECK(occluder.vertices.size() == 17 * 17);
+	CHECK(occluder.indices.size() == 16 * 16 * 6);
+
+	bool isBelow = true;
+	for (const Float3& position : occluder.vertices)
+	{
+		const int i = (int)std::lround(position[0] + 32.f);
+		const int j = (int)std::lround(position[2] + 32.f);
+		isBelow = isBelow && position[1] <= heightfield.GetHeight(i, j) + 1e-5f;
+	}
+
+	CHECK(isBelow);
+}
@@ -0,0 +1,190 @@
+#include "TestFramework.hpp"
+#include "TestMatrices.hpp"
+
+#include "ProjectedGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using engine::gfx::ProjectedGrid;
+using engine::math::Float3;
+using engine::math::Float4;
+using engine::math::Float4x4;
+
+namespace
+{
+
+constexpr float NearZ = 0.5f;
+constexpr float FarZ = 1000.f;
+constexpr float MaxAmplitude = 1.f;
+constexpr float WaterWidth = 2000.f;
+constexpr float WaterLength = 2000.f;
+
+struct Vertex
+{
+	struct
+	{
+		float x, y, z;
+	} position;
+
+	struct
+	{
+		float x, y;
+	} texC;
+};
+
+Float4x4 MakeViewProj(const Float3& eye, const Float3& target)
+{
+	return engine::math::Multiply(
+		engine::tests::LookAtLH(eye, target, {0.f, 1.f, 0.f}),
+		engine::tests::PerspectiveFovLH(1.f, 16.f / 9.f, NearZ, FarZ));
+}
+
+Float4 ToNdc(const Float4x4& viewProj, const Vertex& vertex)
+{
+	const Float3 position = {vertex.position.x, vertex.position.y, vertex.position.z};
+	const Float4 clip = engine::math::TransformPoint(viewProj, position);
+	return {clip[0] / clip[3], clip[1] / clip[3], clip[2] / clip[3], clip[3]};
+}
+
+}  // namespace
+
+TEST_CASE(GridStopsAtTheHorizon)
+{
+	const Float3 eye = {0.f, 10.f, 0.f};
+	const Float4x4 viewProj = MakeViewProj(eye, {0.f, 10.f, 100.f});
+
+	constexpr uint32_t GridSize = 32;
+	const ProjectedGrid grid(GridSize, GridSize, MaxAmplitude);
+	std::vector<Vertex> vertices;
+	REQUIRE(grid.Generate(viewProj, WaterWidth, WaterLength, vertices));
+	REQUIRE(vertices.size() == grid.GetVertexCount());
+
+	// Camera priveste orizontal: apa e doar in jumatatea de jos a ecranului, iar grila nu trece de far
+	float maxNdcY = -1.f;
+	bool isOnScreen = true;
+	bool isOnPlane = true;
+	for (const Vertex& vertex : vertices)
+	{
+		const Float4 ndc = ToNdc(viewProj, vertex);
+		maxNdcY = std::max(maxNdcY, ndc[1]);
+
+		isOnScreen = isOnScreen && ndc[3] > 0.f && std::abs(ndc[0]) <= 1.001f && ndc[2] <= 1.001f;
+		isOnPlane = isOnPlane && vertex.position.y == 0.f;
+	}
+
+	CHECK(isOnScreen);
+	CHECK(isOnPlane);
+	CHECK(maxNdcY <= 0.f);
+	CHECK(maxNdcY > -0.1f);
+
+	// Fara limitarea la orizont, randurile de sus ar cadea toate pe far si s-ar suprapune pe ecran
+	bool rowsAreDistinct = true;
+	for (uint32_t i = 0; i < GridSize; i++)
+	{
+		const float rowY = ToNdc(viewProj, vertices[i * (GridSize + 1)])[1];
+		const float nextRowY = ToNdc(viewProj, vertices[(i + 1) * (GridSize + 1)])[1];
+		rowsAreDistinct = rowsAreDistinct && nextRowY > rowY + 0.005f;
+	}
+
+	CHECK(rowsAreDistinct);
+}
+
+TEST_CASE(GridCoversTheVisibleWater)
+{
+	const Float3 eye = {20.f, 40.f, -30.f};
+	const Float4x4 viewProj = MakeViewProj(eye, {60.f, 0.f, 80.f});
+
+	const ProjectedGrid grid(64, 48, MaxAmplitude);
+	std::vector<Vertex> vertices;
+	REQUIRE(grid.Generate(viewProj, WaterWidth, WaterLength, vertices));
+
+	// Grila e uniforma in spatiul ecran, deci colturile ei dau dreptunghiul acoperit
+	const Float4 bottomLeft = ToNdc(viewProj, vertices.front());
+	const Float4 topRight = ToNdc(viewProj, vertices.back());
+
+	// Razele prin pixelii care vad planul apei (intre near si far) trebuie sa cada in dreptunghi
+	Float4x4 invViewProj;
+	REQUIRE(engine::math::Invert(viewProj, invViewProj));
+
+	constexpr int SampleCount = 64;
+	float hitMinY = 1.f;
+	float hitMaxY = -1.f;
+	bool isCovered = true;
+	for (int i = 0; i <= SampleCount; i++)
+	{
+		for (int j = 0; j <= SampleCount; j++)
+		{
+			const float x = -1.f + 2.f * j / SampleCount;
+			const float y = -1.f + 2.f * i / SampleCount;
+
+			const Float4 nearPoint = engine::math::TransformPoint(invViewProj, {x, y, 0.f});
+			const Float4 farPoint = engine::math::TransformPoint(invViewProj, {x, y, 1.f});
+			const float nearY = nearPoint[1] / nearPoint[3];
+			const float farY = farPoint[1] / farPoint[3];
+
+			if (nearY * farY > 0.f)
+				continue;
+
+			hitMinY = std::min(hitMinY, y);
+			hitMaxY = std::max(hitMaxY, y);
+
+			const float epsilon = 1e-3f;
+			isCovered = isCovered && x >= bottomLeft[0] - epsilon && x <= topRight[0] + epsilon;
+			isCovered = isCovered && y >= bottomLeft[1] - epsilon && y <= topRight[1] + epsilon;
+		}
+	}
+
+	CHECK(isCovered);
+
+	// Dreptunghiul nu depaseste zona vizibila cu mai mult decat un rand de esantioane plus stratul valurilor
+	CHECK(bottomLeft[1] >= hitMinY - 2.f / SampleCount);
+	CHECK(topRight[1] <= hitMaxY + 2.f / SampleCount);
+
+	// Coordonatele de textura urmeaza conventia din GenerateChunks
+	bool isMapped = true;
+	for (const Vertex& vertex : vertices)
+	{
+		const float u = (vertex.position.z + WaterWidth / 2.f) / WaterWidth;
+		const float v = (vertex.position.x + WaterLength / 2.f) / WaterLength;
+		isMapped = isMapped && std::abs(vertex.texC.x - u) < 1e-5f && std::abs(vertex.texC.y - v) < 1e-5f;
+	}
+
+	CHECK(isMapped);
+}
+
+TEST_CASE(CameraBelowThePlane)
+{
+	const ProjectedGrid grid(16, 16, MaxAmplitude);
+	std::vector<Vertex> vertices;
+
+	// Sub apa, privind in jos: frustumul nu atinge stratul valurilor
+	CHECK(!grid.Generate(MakeViewProj({0.f, -20.f, 0.f}, {0.f, -120.f, 1.f}), WaterWidth, WaterLength, vertices));
+
+	// Sub apa, privind in sus: suprafata se vede de dedesubt
+	const Float4x4 viewProj = MakeViewProj({0.f, -20.f, 0.f}, {0.f, 30.f, 40.f});
+	REQUIRE(grid.Generate(viewProj, WaterWidth, WaterLength, vertices));
+
+	bool isVisible = true;
+	for (const Vertex& vertex : vertices)
+	{
+		const Float4 ndc = ToNdc(viewProj, vertex);
+		isVisible = isVisible && vertex.position.y == 0.f && ndc[3] > 0.f && ndc[2] <= 1.001f;
+	}
+
+	CHECK(isVisible);
+
+	// Deasupra apei, privind in sus: nici un punct al frustumului nu coboara pana la valuri
+	CHECK(!grid.Generate(MakeViewProj({0.f, 20.f, 0.f}, {0.f, 120.f, 1.f}), WaterWidth, WaterLength, vertices));
+}
+
+TEST_CASE(IndicesCoverEveryCell)
+{
+	const ProjectedGrid grid(5, 3, MaxAmplitude);
+	const std::vector<uint32_t> indices = grid.GenerateIndices();
+
+	REQUIRE(indices.size() == grid.GetIndexCount());
+	CHECK(indices.size() == 5 * 3 * 6);
+	CHECK(*std::max_element(indices.begin(), indices.end()) == grid.GetVertexCount() - 1);
+}
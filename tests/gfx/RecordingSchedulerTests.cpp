@@ -0,0 +1,111 @@
+#include "TestFramework.hpp"
+
+#include "RecordingScheduler.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using engine::gfx::RecordingPass;
+using engine::gfx::RecordingScheduler;
+
+namespace
+{
+
+constexpr uint32_t PassCount = 8;
+
+// Pass-uri care noteaza begin-urile si end-urile (p, respectiv 100 + p) in order si numara record-urile
+std::vector<RecordingPass> MakePasses(std::vector<int>& order, std::atomic<uint32_t>* recordCounts)
+{
+	std::vector<RecordingPass> passes;
+	for (int pass = 0; pass < (int)PassCount; pass++)
+	{
+		passes.push_back(
+			{[&order, pass]() { order.push_back(pass); },
+			 [recordCounts, pass]() { recordCounts[pass]++; },
+			 [&order, pass]() { order.push_back(100 + pass); }});
+	}
+
+	return passes;
+}
+
+}  // namespace
+
+TEST_CASE(WithoutWorkersEachPassRunsToTheEnd)
+{
+	RecordingScheduler scheduler;
+	scheduler.Create(0);
+	CHECK(!scheduler.IsParallel());
+
+	std::vector<int> order;
+	std::atomic<uint32_t> recordCounts[PassCount] = {};
+	scheduler.Execute(MakePasses(order, recordCounts));
+
+	REQUIRE(order.size() == 2 * PassCount);
+	for (uint32_t pass = 0; pass < PassCount; pass++)
+	{
+		CHECK(order[2 * pass] == (int)pass);
+		CHECK(order[2 * pass + 1] == 100 + (int)pass);
+		CHECK(recordCounts[pass] == 1);
+	}
+}
+
+TEST_CASE(WorkersRecordBetweenOrderedBeginsAndEnds)
+{
+	for (uint32_t workerCount : {1u, 3u, 7u})
+	{
+		RecordingScheduler scheduler;
+		scheduler.Create(workerCount);
+		CHECK(scheduler.GetWorkerCount() == workerCount);
+
+		for (int frame = 0; frame < 200; frame++)
+		{
+			std::vector<int> order;
+			std::atomic<uint32_t> recordCounts[PassCount] = {};
+			scheduler.Execute(MakePasses(order, recordCounts));
+
+			REQUIRE(order.size() == 2 * PassCount);
+			for (uint32_t pass = 0; pass < PassCount; pass++)
+			{
+				CHECK(order[pass] == (int)pass);
+				CHECK(order[PassCount + pass] == 100 + (int)pass);
+				CHECK(recordCounts[pass] == 1);
+			}
+		}
+	}
+}
+
+TEST_CASE(RecordExceptionIsRethrownAfterAllRecords)
+{
+	RecordingScheduler scheduler;
+	scheduler.Create(3);
+
+	std::atomic<uint32_t> recordCount = 0;
+	bool isEndCalled = false;
+
+	std::vector<RecordingPass> passes;
+	passes.push_back({nullptr, []() { throw std::runtime_error("record"); }, nullptr});
+	for (int pass = 0; pass < 4; pass++)
+		passes.push_back({nullptr, [&recordCount]() { recordCount++; }, [&isEndCalled]() { isEndCalled = true; }});
+
+	bool isThrown = false;
+	try
+	{
+		scheduler.Execute(passes);
+	}
+	catch (const std::runtime_error&)
+	{
+		isThrown = true;
+	}
+
+	CHECK(isThrown);
+	CHECK(recordCount == 4);
+	CHECK(!isEndCalled);
+
+	// Scheduler-ul ramane folosibil dupa exceptie
+	passes.erase(passes.begin());
+	scheduler.Execute(passes);
+	CHECK(recordCount == 8);
+	CHECK(isEndCalled);
+}
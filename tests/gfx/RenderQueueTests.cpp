@@ -0,0 +1,98 @@
+#include "TestFramework.hpp"
+
+#include "RenderQueue.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using engine::gfx::RadixSort;
+using engine::gfx::RenderQueue;
+using engine::gfx::SortEntry;
+
+namespace SortKey = engine::gfx::SortKey;
+
+TEST_CASE(KeyFieldsOrderFromLayerToDepth)
+{
+	CHECK(SortKey::Make(0, 0, 0, 0, 1) == 1);
+	CHECK(SortKey::Make(1, 0, 0, 0, 0) == uint64_t(1) << 60);
+
+	// Layer-ul castiga in fata oricarui camp de sub el
+	CHECK(SortKey::Make(0, 4095, 65535, 65535, 65535) < SortKey::Make(1, 0, 0, 0, 0));
+	CHECK(SortKey::Make(2, 3, 0, 0, 0) < SortKey::Make(2, 3, 1, 0, 0));
+
+	// Valorile prea mari se trunchiaza si nu intra in campul vecin
+	CHECK(SortKey::Make(0, 0, 0, 0, 0x10001) == 1);
+	CHECK(SortKey::Make(0, 0x1001, 0, 0, 0) == SortKey::Make(0, 1, 0, 0, 0));
+}
+
+TEST_CASE(DepthQuantizationClampsAndReverses)
+{
+	CHECK(SortKey::QuantizeDepth(0.f, 10.f) == 0);
+	CHECK(SortKey::QuantizeDepth(10.f, 10.f) == 65535);
+	CHECK(SortKey::QuantizeDepth(5.f, 10.f) == 32768);
+	CHECK(SortKey::QuantizeDepth(-1.f, 10.f) == 0);
+	CHECK(SortKey::QuantizeDepth(20.f, 10.f) == 65535);
+	CHECK(SortKey::QuantizeDepth(0.f, 10.f, true) == 65535);
+	CHECK(SortKey::QuantizeDepth(5.f, 0.f) == 0);
+}
+
+TEST_CASE(RadixSortMatchesStableSort)
+{
+	std::mt19937_64 random(1);
+	std::vector<SortEntry> scratch;
+
+	for (int iteration = 0; iteration < 300; iteration++)
+	{
+		const size_t count = random() % 3000;
+
+		// Chei complet aleatoare, chei cu un singur octet variabil si chei reale cu multe duplicate
+		std::vector<SortEntry> entries(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			uint64_t key = random();
+			if (iteration % 3 == 0)
+				key &= 0xFF00;
+			else if (iteration % 3 == 1)
+				key = SortKey::Make(random() % 2, random() % 4, random() % 8, 0, random() % 5);
+
+			entries[i] = {key, (uint32_t)i};
+		}
+
+		std::vector<SortEntry> expected = entries;
+		std::stable_sort(
+			expected.begin(),
+			expected.end(),
+			[](const SortEntry& lhs, const SortEntry& rhs) { return lhs.key < rhs.key; });
+
+		RadixSort(entries, scratch);
+
+		bool isEqual = true;
+		for (size_t i = 0; i < count; i++)
+			isEqual = isEqual && entries[i].key == expected[i].key && entries[i].packet == expected[i].packet;
+
+		CHECK(isEqual);
+	}
+}
+
+TEST_CASE(QueueReturnsPacketsInKeyOrder)
+{
+	RenderQueue<int> queue;
+
+	queue.Submit(SortKey::Make(1, 0, 0, 0, 0), 10);
+	queue.Submit(SortKey::Make(0, 2, 0, 0, 0), 20);
+	queue.Submit(SortKey::Make(0, 1, 0, 0, 0), 30);
+	queue.Submit(SortKey::Make(0, 1, 0, 0, 0), 40);
+	queue.Sort();
+
+	REQUIRE(queue.GetPacketCount() == 4);
+	CHECK(queue.GetSortedPacket(0) == 30);
+	CHECK(queue.GetSortedPacket(1) == 40);
+	CHECK(queue.GetSortedPacket(2) == 20);
+	CHECK(queue.GetSortedPacket(3) == 10);
+	CHECK(queue.GetSortedKey(3) == SortKey::Make(1, 0, 0, 0, 0));
+
+	queue.Reset();
+	CHECK(queue.GetPacketCount() == 0);
+}
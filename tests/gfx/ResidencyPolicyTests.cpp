@@ -0,0 +1,181 @@
+#include "TestFramework.hpp"
+
+#include "ResidencyPolicy.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using engine::gfx::ResidencyPolicy;
+
+namespace ResidencyPriority = engine::gfx::ResidencyPriority;
+
+using Handle = ResidencyPolicy::Handle;
+
+TEST_CASE(OverBudgetEvictsLowPriorityThenLeastRecentlyUsed)
+{
+	ResidencyPolicy policy;
+	const Handle old = policy.Add(10, ResidencyPriority::Normal, 1);
+	const Handle recent = policy.Add(10, ResidencyPriority::Normal, 3);
+	const Handle low = policy.Add(10, ResidencyPriority::Low, 5);
+	const Handle high = policy.Add(10, ResidencyPriority::High, 0);
+	CHECK(policy.GetResidentSize() == 40);
+
+	std::vector<Handle> evicted;
+	std::vector<Handle> madeResident;
+	policy.Update(5, 20, evicted, madeResident);
+
+	const std::vector<Handle> expected = {low, old};
+	CHECK(evicted == expected);
+	CHECK(madeResident.empty());
+	CHECK(!policy.IsResident(old) && policy.IsResident(recent) && policy.IsResident(high));
+	CHECK(policy.GetResidentSize() == 20);
+	CHECK(policy.GetStatistics().evictedCount == 2);
+	CHECK(policy.GetStatistics().evictedSize == 20);
+}
+
+TEST_CASE(ResourcesInFlightAreNotEvicted)
+{
+	ResidencyPolicy policy;
+	const Handle finished = policy.Add(10, ResidencyPriority::Normal, 1);
+	const Handle inFlight = policy.Add(10, ResidencyPriority::Low, 4);
+
+	std::vector<Handle> evicted;
+	std::vector<Handle> madeResident;
+	policy.Update(2, 5, evicted, madeResident);
+
+	// Doar resursa terminata de GPU pleaca; bugetul ramane depasit in acest cadru
+	const std::vector<Handle> expected = {finished};
+	CHECK(evicted == expected);
+	CHECK(policy.IsResident(inFlight));
+	CHECK(policy.GetStatistics().overBudgetFrameCount == 1);
+
+	policy.Update(4, 5, evicted, madeResident);
+	CHECK(!policy.IsResident(inFlight));
+	CHECK(policy.GetResidentSize() == 0);
+}
+
+TEST_CASE(UsingAnEvictedResourceIsAMiss)
+{
+	ResidencyPolicy policy;
+	const Handle handle = policy.Add(10, ResidencyPriority::Normal, 0);
+
+	std::vector<Handle> evicted;
+	std::vector<Handle> madeResident;
+	policy.Update(0, 0, evicted, madeResident);
+	REQUIRE(!policy.IsResident(handle));
+
+	CHECK(policy.MarkUsed(handle, 1));
+	CHECK(policy.IsResident(handle));
+	CHECK(policy.GetResidentSize() == 10);
+
+	// A doua folosire in acelasi cadru nu se mai numara
+	CHECK(!policy.MarkUsed(handle, 1));
+	CHECK(!policy.MarkUsed(handle, 2));
+
+	CHECK(policy.GetStatistics().useCount == 2);
+	CHECK(policy.GetStatistics().missCount == 1);
+	CHECK(policy.GetStatistics().GetMissRate() == 0.5);
+}
+
+TEST_CASE(UnderBudgetPrefetchesHighPriorityFirst)
+{
+	ResidencyPolicy policy;
+	const Handle normal = policy.Add(10, ResidencyPriority::Normal, 2);
+	const Handle high = policy.Add(10, ResidencyPriority::High, 1);
+	const Handle large = policy.Add(50, ResidencyPriority::High, 3);
+
+	std::vector<Handle> evicted;
+	std::vector<Handle> madeResident;
+	policy.Update(3, 0, evicted, madeResident);
+	REQUIRE(policy.GetResidentSize() == 0);
+
+	// Update-ul care evacueaza nu aduce nimic inapoi
+	CHECK(madeResident.empty());
+
+	// large nu incape; din ce incape, intai prioritatea mare
+	policy.Update(3, 20, evicted, madeResident);
+	const std::vector<Handle> expected = {high, normal};
+	CHECK(madeResident == expected);
+	CHECK(!policy.IsResident(large));
+	CHECK(policy.GetStatistics().prefetchCount == 2);
+}
+
+TEST_CASE(RemovedHandlesAreReused)
+{
+	ResidencyPolicy policy;
+	const Handle first = policy.Add(10, ResidencyPriority::Normal, 0);
+	policy.Add(20, ResidencyPriority::Normal, 0);
+
+	policy.Remove(first);
+	CHECK(policy.GetCount() == 1);
+	CHECK(policy.GetTotalSize() == 20);
+	CHECK(policy.GetResidentSize() == 20);
+
+	const Handle reused = policy.Add(5, ResidencyPriority::Low, 1);
+	CHECK(reused == first);
+	CHECK(policy.GetSize(reused) == 5);
+	CHECK(policy.GetCount() == 2);
+}
+
+TEST_CASE(RandomWorkloadKeepsTheInvariants)
+{
+	constexpr int ResourceCount = 200;
+	constexpr uint64_t FramesInFlight = 2;
+
+	std::mt19937 random(7);
+	ResidencyPolicy policy;
+
+	std::vector<Handle> handles;
+	std::vector<uint64_t> lastUsedFrames(ResourceCount, 0);
+	uint64_t totalSize = 0;
+	for (int i = 0; i < ResourceCount; i++)
+	{
+		const uint64_t size = 1 + random() % 16;
+		handles.push_back(policy.Add(size, (ResidencyPriority::Value)(random() % ResidencyPriority::Count), 0));
+		totalSize += size;
+	}
+
+	const uint64_t budget = totalSize / 2;
+	std::vector<Handle> evicted;
+	std::vector<Handle> madeResident;
+
+	for (uint64_t frame = 1; frame <= 5000; frame++)
+	{
+		// Working set care aluneca incet, plus cateva folosiri aleatoare
+		const int start = (int)(frame / 30) % ResourceCount;
+		for (int i = 0; i < 50; i++)
+		{
+			const int resource = random() % 8 == 0 ? random() % ResourceCount : (start + i) % ResourceCount;
+
+			policy.MarkUsed(handles[resource], frame);
+			CHECK(policy.IsResident(handles[resource]));
+			lastUsedFrames[resource] = frame;
+		}
+
+		const uint64_t completedFrame = frame > FramesInFlight ? frame - FramesInFlight : 0;
+		const uint64_t overBudgetFrameCount = policy.GetStatistics().overBudgetFrameCount;
+		policy.Update(completedFrame, budget, evicted, madeResident);
+
+		bool isEvictionSafe = true;
+		for (Handle handle : evicted)
+			isEvictionSafe = isEvictionSafe && lastUsedFrames[handle] <= completedFrame;
+
+		CHECK(isEvictionSafe);
+		CHECK(policy.GetResidentSize() <= budget || policy.GetStatistics().overBudgetFrameCount > overBudgetFrameCount);
+	}
+
+	uint64_t residentSize = 0;
+	for (Handle handle : handles)
+		residentSize += policy.IsResident(handle) ? policy.GetSize(handle) : 0;
+
+	CHECK(residentSize == policy.GetResidentSize());
+	CHECK(policy.GetTotalSize() == totalSize);
+
+	for (Handle handle : handles)
+		policy.Remove(handle);
+
+	CHECK(policy.GetCount() == 0);
+	CHECK(policy.GetResidentSize() == 0);
+	CHECK(policy.GetTotalSize() == 0);
+}
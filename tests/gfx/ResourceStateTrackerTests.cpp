@@ -0,0 +1,188 @@
+#include "TestFramework.hpp"
+
+#include "ResourceStateTracker.hpp"
+
+#include <cstdint>
+
+using engine::core::FrameVector;
+using engine::gfx::ResourceStateTracker;
+using engine::gfx::StateTransition;
+using engine::gfx::SubresourceStates;
+
+namespace SplitBarrier = engine::gfx::SplitBarrier;
+
+namespace
+{
+
+// Valorile D3D12_RESOURCE_STATES folosite in teste
+enum State : uint32_t
+{
+	Common = 0,
+	RenderTarget = 0x4,
+	DepthWrite = 0x10,
+	ShaderResource = 0xC0,
+	CopyDest = 0x400
+};
+
+constexpr uint32_t AllSubresources = SubresourceStates::AllSubresources;
+
+}  // namespace
+
+TEST_CASE(SubresourceStatesSplitAndMergeBack)
+{
+	SubresourceStates states(ShaderResource);
+	CHECK(states.IsUniform());
+
+	states.SetState(2, RenderTarget, 4);
+	CHECK(!states.IsUniform());
+	CHECK(states.GetState(2) == RenderTarget);
+	CHECK(states.GetState(0) == ShaderResource);
+
+	states.SetState(2, ShaderResource, 4);
+	CHECK(states.IsUniform());
+	CHECK(states.GetState() == ShaderResource);
+
+	states.SetState(1, CopyDest, 4);
+	states.SetState(AllSubresources, Common, 4);
+	CHECK(states.IsUniform());
+	CHECK(states.GetState() == Common);
+}
+
+TEST_CASE(FirstUseIsResolvedAtSubmit)
+{
+	int texture;
+	SubresourceStates committed(Common);
+
+	ResourceStateTracker tracker;
+	CHECK(tracker.Transition(&texture, committed, 1, AllSubresources, RenderTarget));
+	CHECK(tracker.GetPendingBarriers().empty());
+	CHECK(!tracker.Transition(&texture, committed, 1, AllSubresources, RenderTarget));
+
+	tracker.Transition(&texture, committed, 1, AllSubresources, ShaderResource);
+	REQUIRE(tracker.GetPendingBarriers().size() == 1);
+	CHECK(tracker.GetPendingBarriers()[0].before == RenderTarget);
+	CHECK(tracker.GetPendingBarriers()[0].after == ShaderResource);
+
+	FrameVector<StateTransition> fixups;
+	tracker.Resolve(fixups);
+
+	REQUIRE(fixups.size() == 1);
+	CHECK(fixups[0].resource == &texture && fixups[0].subresource == AllSubresources);
+	CHECK(fixups[0].before == Common && fixups[0].after == RenderTarget);
+	CHECK(committed.GetState() == ShaderResource);
+	CHECK(tracker.GetTrackedResourceCount() == 0);
+}
+
+TEST_CASE(SubresourceUsesAreResolvedPerSubresource)
+{
+	int cubeMap;
+	SubresourceStates committed(ShaderResource);
+
+	// Prima lista scrie doar fata 2
+	ResourceStateTracker first;
+	first.Transition(&cubeMap, committed, 6, 2, RenderTarget);
+
+	FrameVector<StateTransition> fixups;
+	first.Resolve(fixups);
+
+	REQUIRE(fixups.size() == 1);
+	CHECK(fixups[0].subresource == 2 && fixups[0].before == ShaderResource && fixups[0].after == RenderTarget);
+	CHECK(!committed.IsUniform());
+	CHECK(committed.GetState(2) == RenderTarget && committed.GetState(0) == ShaderResource);
+
+	// A doua citeste toata resursa: tranzitie doar pentru fata care difera
+	ResourceStateTracker second;
+	second.Transition(&cubeMap, committed, 6, AllSubresources, ShaderResource);
+
+	fixups.clear();
+	second.Resolve(fixups);
+
+	REQUIRE(fixups.size() == 1);
+	CHECK(fixups[0].subresource == 2 && fixups[0].after == ShaderResource);
+	CHECK(committed.IsUniform() && committed.GetState() == ShaderResource);
+}
+
+TEST_CASE(SplitTransitionEndsAtTheNextUse)
+{
+	int shadowMap;
+	SubresourceStates committed(ShaderResource);
+
+	ResourceStateTracker tracker;
+	tracker.Transition(&shadowMap, committed, 1, AllSubresources, DepthWrite);
+	tracker.BeginTransition(&shadowMap, committed, 1, AllSubresources, ShaderResource);
+
+	REQUIRE(tracker.GetPendingBarriers().size() == 1);
+	CHECK(tracker.GetPendingBarriers()[0].split == SplitBarrier::BeginOnly);
+
+	tracker.Transition(&shadowMap, committed, 1, AllSubresources, ShaderResource);
+
+	REQUIRE(tracker.GetPendingBarriers().size() == 2);
+	const StateTransition& end = tracker.GetPendingBarriers()[1];
+	CHECK(end.split == SplitBarrier::EndOnly && end.before == DepthWrite && end.after == ShaderResource);
+
+	// O tranzitie inceputa si ramasa deschisa se termina inainte de inchiderea listei
+	tracker.BeginTransition(&shadowMap, committed, 1, AllSubresources, CopyDest);
+	tracker.EndPendingTransitions();
+
+	REQUIRE(tracker.GetPendingBarriers().size() == 4);
+	CHECK(tracker.GetPendingBarriers()[3].split == SplitBarrier::EndOnly);
+
+	FrameVector<StateTransition> fixups;
+	tracker.Resolve(fixups);
+
+	REQUIRE(fixups.size() == 1);
+	CHECK(fixups[0].before == ShaderResource && fixups[0].after == DepthWrite);
+	CHECK(committed.GetState() == CopyDest);
+}
+
+TEST_CASE(UseWithAnotherStateEndsTheSplitFirst)
+{
+	int texture;
+	SubresourceStates committed(Common);
+
+	ResourceStateTracker tracker;
+	tracker.Transition(&texture, committed, 1, AllSubresources, CopyDest);
+	tracker.BeginTransition(&texture, committed, 1, AllSubresources, ShaderResource);
+	tracker.Transition(&texture, committed, 1, AllSubresources, RenderTarget);
+
+	const auto& barriers = tracker.GetPendingBarriers();
+	REQUIRE(barriers.size() == 3);
+	CHECK(barriers[1].split == SplitBarrier::EndOnly);
+	CHECK(barriers[2].before == ShaderResource && barriers[2].after == RenderTarget);
+
+	tracker.Reset();
+	CHECK(tracker.GetTrackedResourceCount() == 0);
+	CHECK(tracker.GetPendingBarriers().empty());
+}
+
+TEST_CASE(SplitOverMixedStatesIsPerSubresource)
+{
+	int texture;
+	SubresourceStates committed(ShaderResource);
+
+	ResourceStateTracker tracker;
+	tracker.Transition(&texture, committed, 3, AllSubresources, ShaderResource);
+	tracker.Transition(&texture, committed, 3, 1, RenderTarget);
+	tracker.ClearPendingBarriers();
+
+	// Subresursele 0 si 2 pleaca din ShaderResource, 1 din RenderTarget
+	tracker.BeginTransition(&texture, committed, 3, AllSubresources, CopyDest);
+	CHECK(tracker.GetPendingBarriers().size() == 3);
+
+	tracker.EndPendingTransitions();
+
+	const auto& barriers = tracker.GetPendingBarriers();
+	REQUIRE(barriers.size() == 6);
+	for (uint32_t i = 0; i < 3; i++)
+	{
+		CHECK(barriers[3 + i].split == SplitBarrier::EndOnly);
+		CHECK(barriers[3 + i].subresource == i);
+	}
+	CHECK(barriers[4].before == RenderTarget);
+
+	FrameVector<StateTransition> fixups;
+	tracker.Resolve(fixups);
+
+	CHECK(fixups.empty());
+	CHECK(committed.IsUniform() && committed.GetState() == CopyDest);
+}
@@ -0,0 +1,170 @@
+#include "TestFramework.hpp"
+
+#include "TerrainPVS.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+using engine::gfx::Heightfield;
+using engine::gfx::TerrainPVS;
+using engine::math::BoxBounds;
+
+namespace
+{
+
+constexpr int SidePointCount = 81;
+constexpr float TerrainSize = 400.f;
+constexpr int TargetsPerSide = 8;
+constexpr float TargetSize = TerrainSize / TargetsPerSide;
+
+// Creasta inalta de-a lungul lui z, la x = 0, care desparte cele doua jumatati ale terenului
+float GetHeight(float x, float z)
+{
+	return 40.f * std::exp(-(x * x) / (2.f * 15.f * 15.f)) + 5.f * std::sin(z * 0.05f);
+}
+
+struct Terrain
+{
+	Terrain()
+	{
+		heightfield.sidePointCount = SidePointCount;
+		heightfield.minX = heightfield.minZ = -TerrainSize / 2.f;
+		heightfield.stepX = heightfield.stepZ = TerrainSize / (SidePointCount - 1);
+
+		for (int i = 0; i < SidePointCount; i++)
+		{
+			for (int j = 0; j < SidePointCount; j++)
+				heightfield.heights.push_back(GetHeight(heightfield.GetX(i), heightfield.GetZ(j)));
+		}
+
+		// Tinta (a, b) are indexul a * TargetsPerSide + b
+		for (int a = 0; a < TargetsPerSide; a++)
+		{
+			for (int b = 0; b < TargetsPerSide; b++)
+			{
+				const float minX = a * TargetSize - TerrainSize / 2.f;
+				const float minZ = b * TargetSize - TerrainSize / 2.f;
+
+				float minY = GetHeight(minX, minZ);
+				float maxY = minY;
+				for (int i = 0; i <= 10; i++)
+				{
+					for (int j = 0; j <= 10; j++)
+					{
+						const float height = GetHeight(minX + i * TargetSize / 10.f, minZ + j * TargetSize / 10.f);
+						minY = std::min(minY, height);
+						maxY = std::max(maxY, height);
+					}
+				}
+
+				targets.push_back({{minX, minY, minZ}, {minX + TargetSize, maxY, minZ + TargetSize}});
+			}
+		}
+	}
+
+	Heightfield heightfield;
+	std::vector<BoxBounds> targets;
+};
+
+constexpr TerrainPVS::Properties Properties = {8, 3, 4, 2.f, 120.f, 1.f, true};
+
+}  // namespace
+
+TEST_CASE(RidgeHidesTheFarSide)
+{
+	const Terrain terrain;
+	const TerrainPVS::Ptr pvs = TerrainPVS::Bake(terrain.heightfield, terrain.targets, Properties);
+
+	CHECK(pvs->GetTargetCount() == TargetsPerSide * TargetsPerSide);
+	CHECK(pvs->GetCellCount() == 8 * 8 * 4);
+	CHECK(pvs->GetVisibleRatio() < 1.f);
+
+	// Camera jos, la vest de creasta
+	const int cell = pvs->GetCell(-150.f, 5.f, 0.f);
+	REQUIRE(cell >= 0);
+	CHECK(pvs->IsVisible(cell, 1 * TargetsPerSide + 4));
+	CHECK(!pvs->IsVisible(cell, 7 * TargetsPerSide + 4));
+
+	// Peste maxCameraHeight sau in afara grilei nu exista PVS
+	CHECK(pvs->GetCell(-150.f, 130.f, 0.f) == -1);
+	CHECK(pvs->GetCell(-250.f, 5.f, 0.f) == -1);
+}
+
+TEST_CASE(TargetsSeenByAFineRayAreVisible)
+{
+	const Terrain terrain;
+	const TerrainPVS::Ptr pvs = TerrainPVS::Bake(terrain.heightfield, terrain.targets, Properties);
+
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> position(-200.f, 199.9f);
+	std::uniform_real_distribution<float> fraction(0.f, 1.f);
+
+	// Raze fara marja, cu pas mic; orice tinta atinsa trebuie sa fie in PVS-ul celulei camerei
+	int visibleCount = 0;
+	int missingCount = 0;
+	for (int sample = 0; sample < 5000; sample++)
+	{
+		const float cameraX = position(random);
+		const float cameraZ = position(random);
+		const float ground = GetHeight(cameraX, cameraZ) + 2.f;
+		const float cameraY = ground + (120.f - ground) * fraction(random);
+
+		const uint32_t target = random() % pvs->GetTargetCount();
+		const float pointX = terrain.targets[target].min[0] + TargetSize * fraction(random);
+		const float pointZ = terrain.targets[target].min[2] + TargetSize * fraction(random);
+		const float pointY = GetHeight(pointX, pointZ) + 0.01f;
+
+		bool isClear = true;
+		for (int step = 1; step < 400 && isClear; step++)
+		{
+			const float t = step / 400.f;
+			const float x = cameraX + (pointX - cameraX) * t;
+			const float y = cameraY + (pointY - cameraY) * t;
+			const float z = cameraZ + (pointZ - cameraZ) * t;
+			isClear = y >= GetHeight(x, z);
+		}
+
+		if (!isClear)
+			continue;
+
+		visibleCount++;
+		if (!pvs->IsVisible(pvs->GetCell(cameraX, cameraY, cameraZ), target))
+			missingCount++;
+	}
+
+	CHECK(visibleCount > 0);
+	CHECK(missingCount == 0);
+}
+
+TEST_CASE(SavedPVSLoadsOnlyForTheSameSource)
+{
+	const Terrain terrain;
+	const TerrainPVS::Ptr pvs = TerrainPVS::Bake(terrain.heightfield, terrain.targets, Properties);
+
+	const std::wstring path = (std::filesystem::temp_directory_path() / L"TerrainPVSTests.pvs").wstring();
+	REQUIRE(pvs->Save(path));
+
+	const uint64_t sourceHash = TerrainPVS::ComputeSourceHash(terrain.heightfield, terrain.targets, Properties);
+	const TerrainPVS::Ptr loaded = TerrainPVS::Load(path, sourceHash);
+	REQUIRE(loaded != nullptr);
+
+	bool isSame = true;
+	for (int cell = 0; cell < pvs->GetCellCount(); cell++)
+	{
+		for (uint32_t target = 0; target < pvs->GetTargetCount(); target++)
+			isSame = isSame && loaded->IsVisible(cell, target) == pvs->IsVisible(cell, target);
+	}
+
+	CHECK(isSame);
+	CHECK(loaded->GetCell(-150.f, 5.f, 0.f) == pvs->GetCell(-150.f, 5.f, 0.f));
+
+	// Alte date de intrare: fisierul trebuie refacut
+	CHECK(TerrainPVS::Load(path, sourceHash + 1) == nullptr);
+
+	std::filesystem::remove(path);
+	CHECK(TerrainPVS::Load(path, sourceHash) == nullptr);
+}
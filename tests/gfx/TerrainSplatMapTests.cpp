@@ -0,0 +1,156 @@
+#include "TestFramework.hpp"
+
+#include "TerrainSplat.h"
+#include "TerrainSplatMap.hpp"
+#include "engine/core/CustomException.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using engine::gfx::TerrainSplatMap;
+
+namespace
+{
+
+constexpr float GridWidth = 200.f;
+constexpr float GridLength = 300.f;
+constexpr uint32_t Resolution = 64;
+
+// Trece prin toate benzile de inaltime, cu variatie pe ambele axe
+float Hills(float x, float z)
+{
+	return 0.08f * x + 25.f * std::sin(z * 0.03f) + 5.f;
+}
+
+// Doar stratul 0 -> 1, a carui banda [-10, 0) nu depinde de zgomot: texelii depind doar de x
+float SlopeAlongX(float x, float)
+{
+	return -10.f + 9.9f * (x + GridLength / 2.f) / GridLength;
+}
+
+uint32_t GetWeight(uint32_t texel, uint32_t channel)
+{
+	return (texel >> (8 * channel)) & 0xFF;
+}
+
+// Ce obtine shaderul din texel: indicele stratului plus factorul de interpolare
+float DecodeLayer(uint32_t texel)
+{
+	int index;
+	float lerpFactor;
+	DecodeTerrainSplat(
+		GetWeight(texel, 0) / 255.f,
+		GetWeight(texel, 1) / 255.f,
+		GetWeight(texel, 2) / 255.f,
+		GetWeight(texel, 3) / 255.f,
+		index,
+		lerpFactor);
+
+	return index + lerpFactor;
+}
+
+}  // namespace
+
+TEST_CASE(BakedTexelsDecodeToTheShaderBlend)
+{
+	const TerrainSplatMap::Ptr splatMap = TerrainSplatMap::Bake(Hills, GridWidth, GridLength, Resolution);
+
+	CHECK(splatMap->Validate(Hills) <= TerrainSplatMap::ValidationTolerance);
+
+	// Centrul texelului (i, j) are v = (i + 0.5) / N pe X si u = (j + 0.5) / N pe Z
+	float maxError = 0.f;
+	for (uint32_t i = 0; i < Resolution; i++)
+	{
+		const float v = (i + 0.5f) / Resolution;
+		const float x = v * GridLength - GridLength / 2.f;
+
+		for (uint32_t j = 0; j < Resolution; j++)
+		{
+			const float u = (j + 0.5f) / Resolution;
+			const float z = u * GridWidth - GridWidth / 2.f;
+
+			int index;
+			float lerpFactor;
+			ComputeTerrainLayerBlend(x, Hills(x, z), z, index, lerpFactor);
+
+			const float error = std::abs(DecodeLayer(splatMap->GetMip(0)[i * Resolution + j]) - (index + lerpFactor));
+			maxError = std::max(maxError, error);
+		}
+	}
+
+	CHECK(maxError <= TerrainSplatMap::ValidationTolerance);
+}
+
+TEST_CASE(RowsFollowXAndColumnsFollowZ)
+{
+	const TerrainSplatMap::Ptr splatMap = TerrainSplatMap::Bake(SlopeAlongX, GridWidth, GridLength, Resolution);
+	const std::vector<uint32_t>& texels = splatMap->GetMip(0);
+
+	bool rowsAreUniform = true;
+	bool rowsIncrease = true;
+	for (uint32_t i = 0; i < Resolution; i++)
+	{
+		for (uint32_t j = 1; j < Resolution; j++)
+			rowsAreUniform = rowsAreUniform && texels[i * Resolution + j] == texels[i * Resolution];
+
+		if (i > 0)
+		{
+			const float previousLayer = DecodeLayer(texels[(i - 1) * Resolution]);
+			rowsIncrease = rowsIncrease && DecodeLayer(texels[i * Resolution]) > previousLayer;
+		}
+	}
+
+	CHECK(rowsAreUniform);
+	CHECK(rowsIncrease);
+	CHECK(DecodeLayer(texels[0]) < 0.05f);
+	CHECK(DecodeLayer(texels[(Resolution - 1) * Resolution]) > 0.95f);
+}
+
+TEST_CASE(EveryMipKeepsTheWeightsNormalized)
+{
+	const TerrainSplatMap::Ptr splatMap = TerrainSplatMap::Bake(Hills, GridWidth, GridLength, Resolution);
+
+	// 64, 32, ..., 1
+	REQUIRE(splatMap->GetMipCount() == 7);
+	CHECK(splatMap->GetMip(6).size() == 1);
+
+	// Stratul 0 are ponderea 255 - suma celorlalte, deci suma nu poate depasi 255 (plus rotunjirea mediei)
+	bool isNormalized = true;
+	for (uint32_t level = 0; level < splatMap->GetMipCount(); level++)
+	{
+		const uint32_t size = Resolution >> level;
+		REQUIRE(splatMap->GetMip(level).size() == size * size);
+
+		for (const uint32_t texel : splatMap->GetMip(level))
+		{
+			const uint32_t sum = GetWeight(texel, 0) + GetWeight(texel, 1) + GetWeight(texel, 2) + GetWeight(texel, 3);
+			isNormalized = isNormalized && sum <= 255 + 2 * level;
+		}
+	}
+
+	CHECK(isNormalized);
+}
+
+TEST_CASE(ValidateRejectsAnotherHeightfield)
+{
+	const TerrainSplatMap::Ptr splatMap = TerrainSplatMap::Bake(Hills, GridWidth, GridLength, Resolution);
+
+	CHECK(splatMap->Validate(SlopeAlongX) > TerrainSplatMap::ValidationTolerance);
+}
+
+TEST_CASE(ResolutionMustBeAPowerOfTwo)
+{
+	bool hasThrown = false;
+	try
+	{
+		TerrainSplatMap::Bake(Hills, GridWidth, GridLength, 48);
+	}
+	catch (const engine::core::CustomException&)
+	{
+		hasThrown = true;
+	}
+
+	CHECK(hasThrown);
+}
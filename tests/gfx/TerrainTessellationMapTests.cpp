@@ -0,0 +1,165 @@
+#include "TestFramework.hpp"
+
+#include "TerrainTessellationMap.hpp"
+#include "engine/core/CustomException.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+using engine::gfx::TerrainTessellationMap;
+
+namespace
+{
+
+constexpr float GridWidth = 200.f;
+constexpr float GridLength = 300.f;
+constexpr int SidePointCount = 33;
+
+constexpr TerrainTessellationMap::Properties Properties = {2.f, 0.25f, 8};
+
+// Un plan e reprodus exact de patch-ul biliniar
+float Plane(float x, float z)
+{
+	return 0.3f * x - 0.1f * z + 2.f;
+}
+
+// Valuri mai scurte decat o celula (~9 unitati), cu amplitudine mult peste fullTessellationDeviation
+float Ripples(float x, float z)
+{
+	return 6.f * std::sin(x * 1.3f) * std::cos(z * 1.1f);
+}
+
+// Plat pentru x < 0, accidentat pentru x >= 0
+float RoughEast(float x, float z)
+{
+	return x < 0.f ? 1.f : 1.f + Ripples(x, z);
+}
+
+}  // namespace
+
+TEST_CASE(FlatTerrainGetsTheMinimumScale)
+{
+	const TerrainTessellationMap::Ptr tessellationMap =
+		TerrainTessellationMap::Compute(Plane, GridWidth, GridLength, SidePointCount, Properties);
+
+	REQUIRE(tessellationMap->GetResolution() == SidePointCount);
+
+	// Scalarea se rotunjeste in sus la 8 biti
+	const float minScale = std::ceil(Properties.minScale * 255.f) / 255.f;
+
+	bool isMinimal = true;
+	for (uint32_t row = 0; row < SidePointCount; row++)
+	{
+		for (uint32_t column = 0; column < SidePointCount; column++)
+			isMinimal = isMinimal && tessellationMap->GetScale(row, column) == minScale;
+	}
+
+	CHECK(isMinimal);
+}
+
+TEST_CASE(RoughTerrainGetsFullTessellation)
+{
+	const TerrainTessellationMap::Ptr tessellationMap =
+		TerrainTessellationMap::Compute(Ripples, GridWidth, GridLength, SidePointCount, Properties);
+
+	bool isFull = true;
+	for (const uint8_t scale : tessellationMap->GetData())
+		isFull = isFull && scale == 255;
+
+	CHECK(isFull);
+}
+
+TEST_CASE(ScaleGrowsWithTheDeviation)
+{
+	CHECK(TerrainTessellationMap::DeviationToScale(0.f, Properties) == Properties.minScale);
+	CHECK(TerrainTessellationMap::DeviationToScale(1.f, Properties) == 0.5f);
+	CHECK(TerrainTessellationMap::DeviationToScale(2.f, Properties) == 1.f);
+	CHECK(TerrainTessellationMap::DeviationToScale(50.f, Properties) == 1.f);
+
+	bool isMonotonic = true;
+	float previousScale = 0.f;
+	for (int i = 0; i <= 300; i++)
+	{
+		const float scale = TerrainTessellationMap::DeviationToScale(i * 0.01f, Properties);
+		isMonotonic = isMonotonic && scale >= previousScale;
+		previousScale = scale;
+	}
+
+	CHECK(isMonotonic);
+
+	// Deviatia masurata creste cu amplitudinea denivelarilor
+	float previousDeviation = -1.f;
+	for (float amplitude = 0.f; amplitude <= 4.f; amplitude += 0.5f)
+	{
+		const auto heightFunction = [amplitude](float x, float z)
+		{
+			return amplitude * std::sin(x * 0.7f) * std::sin(z * 0.7f);
+		};
+
+		const float deviation = TerrainTessellationMap::MeasureCellDeviation(heightFunction, 0.f, 0.f, 4.f, 4.f, 8);
+		isMonotonic = isMonotonic && deviation > previousDeviation;
+		previousDeviation = deviation;
+	}
+
+	CHECK(isMonotonic);
+	CHECK(TerrainTessellationMap::MeasureCellDeviation(Plane, -5.f, 3.f, 4.f, 6.f, 8) < 1e-4f);
+}
+
+TEST_CASE(RowsFollowXAndColumnsFollowZ)
+{
+	const TerrainTessellationMap::Ptr tessellationMap =
+		TerrainTessellationMap::Compute(RoughEast, GridWidth, GridLength, SidePointCount, Properties);
+
+	// Celula (i, j) incepe la x = i * dx - length / 2 si z = j * dz - width / 2, ca in GenerateChunks
+	const float dx = GridLength / SidePointCount;
+
+	bool isOrdered = true;
+	for (uint32_t row = 0; row + 1 < SidePointCount; row++)
+	{
+		const float x0 = row * dx - GridLength / 2.f;
+		const bool isFlat = x0 + dx < 0.f;
+		const bool isRough = x0 >= 0.f;
+
+		for (uint32_t column = 0; column + 1 < SidePointCount; column++)
+		{
+			const float scale = tessellationMap->GetScale(row, column);
+
+			if (isFlat)
+				isOrdered = isOrdered && scale < 0.5f;
+			if (isRough)
+				isOrdered = isOrdered && scale == 1.f;
+		}
+	}
+
+	CHECK(isOrdered);
+
+	// Ultimul rand si ultima coloana (fara celula proprie) dubleaza vecinii
+	bool isDuplicated = true;
+	const uint32_t last = SidePointCount - 1;
+	for (uint32_t i = 0; i < SidePointCount; i++)
+	{
+		isDuplicated = isDuplicated && tessellationMap->GetScale(i, last) == tessellationMap->GetScale(i, last - 1);
+		isDuplicated = isDuplicated && tessellationMap->GetScale(last, i) == tessellationMap->GetScale(last - 1, i);
+	}
+
+	CHECK(isDuplicated);
+
+	// Datele sunt rand cu rand, un octet pe texel
+	CHECK(tessellationMap->GetData().size() == SidePointCount * SidePointCount);
+	CHECK(tessellationMap->GetData()[last * SidePointCount] / 255.f == tessellationMap->GetScale(last, 0));
+}
+
+TEST_CASE(InvalidPropertiesAreRejected)
+{
+	bool hasThrown = false;
+	try
+	{
+		TerrainTessellationMap::Compute(Plane, GridWidth, GridLength, SidePointCount, {0.f, 0.25f, 8});
+	}
+	catch (const engine::core::CustomException&)
+	{
+		hasThrown = true;
+	}
+
+	CHECK(hasThrown);
+}
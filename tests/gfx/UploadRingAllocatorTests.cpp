@@ -0,0 +1,139 @@
+#include "TestFramework.hpp"
+
+#include "UploadRingAllocator.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using engine::gfx::UploadRingAllocator;
+
+TEST_CASE(AllocationsAreAlignedAndInOrder)
+{
+	UploadRingAllocator ring;
+	ring.Create(1024);
+
+	CHECK(ring.Allocate(300, 256) == 0);
+	CHECK(ring.Allocate(100, 4) == 300);
+	CHECK(ring.Allocate(100, 256) == 512);
+	CHECK(ring.GetUsedSize() == 612);
+	CHECK(ring.GetPendingSize() == 612);
+
+	CHECK(ring.Allocate(0, 4) == UploadRingAllocator::InvalidOffset);
+	CHECK(ring.Allocate(2048, 4) == UploadRingAllocator::InvalidOffset);
+}
+
+TEST_CASE(SpaceReturnsWhenTheFenceCompletes)
+{
+	UploadRingAllocator ring;
+	ring.Create(1024);
+
+	CHECK(ring.Allocate(300, 256) == 0);
+	CHECK(ring.Allocate(300, 256) == 512);
+	ring.Retire(1);
+	CHECK(ring.GetPendingSize() == 0);
+	CHECK(ring.GetOldestFenceValue() == 1);
+
+	// Nu incape pana la capat, iar inceputul e inca folosit de GPU
+	CHECK(ring.Allocate(300, 256) == UploadRingAllocator::InvalidOffset);
+
+	ring.Reclaim(0);
+	CHECK(ring.HasRetiredSpace());
+
+	ring.Reclaim(1);
+	CHECK(!ring.HasRetiredSpace());
+	CHECK(ring.GetUsedSize() == 0);
+	CHECK(ring.GetOldestFenceValue() == 0);
+
+	// Ring-ul gol porneste din nou de la inceput
+	CHECK(ring.Allocate(1024, 256) == 0);
+}
+
+TEST_CASE(WrapSkipsTheTailUntilItIsReclaimed)
+{
+	UploadRingAllocator ring;
+	ring.Create(1000);
+
+	CHECK(ring.Allocate(600, 8) == 0);
+	ring.Retire(1);
+	CHECK(ring.Allocate(300, 8) == 600);
+	ring.Retire(2);
+	ring.Reclaim(1);
+
+	// Restul de 100 de octeti de la capat se pierde pana la Reclaim(3)
+	CHECK(ring.Allocate(200, 8) == 0);
+	CHECK(ring.GetUsedSize() == 600);
+	ring.Retire(3);
+
+	CHECK(ring.Allocate(500, 8) == UploadRingAllocator::InvalidOffset);
+	ring.Reclaim(2);
+	CHECK(ring.Allocate(500, 8) == 200);
+}
+
+TEST_CASE(LiveAllocationsNeverOverlap)
+{
+	constexpr uint64_t Capacity = 4096;
+
+	struct Allocation
+	{
+		uint64_t offset;
+		uint64_t size;
+		uint64_t fenceValue;
+	};
+
+	std::mt19937 random(1);
+	UploadRingAllocator ring;
+	ring.Create(Capacity);
+
+	std::vector<Allocation> live;
+	uint64_t fenceValue = 0;
+
+	const auto reclaimOldest = [&]()
+	{
+		const uint64_t completed = ring.GetOldestFenceValue();
+		ring.Reclaim(completed);
+
+		live.erase(
+			std::remove_if(
+				live.begin(),
+				live.end(),
+				[completed](const Allocation& allocation) { return allocation.fenceValue <= completed; }),
+			live.end());
+	};
+
+	for (int i = 0; i < 50000; i++)
+	{
+		const uint64_t size = 1 + random() % 900;
+		const uint64_t alignment = uint64_t(1) << (random() % 9);
+
+		const uint64_t offset = ring.Allocate(size, alignment);
+		if (offset == UploadRingAllocator::InvalidOffset)
+		{
+			ring.Retire(++fenceValue);
+			reclaimOldest();
+			continue;
+		}
+
+		CHECK(offset % alignment == 0);
+		CHECK(offset + size <= Capacity);
+
+		bool isOverlapping = false;
+		for (const Allocation& allocation : live)
+		{
+			if (offset < allocation.offset + allocation.size && allocation.offset < offset + size)
+				isOverlapping = true;
+		}
+
+		CHECK(!isOverlapping);
+
+		// Alocarea apartine submit-ului urmator
+		live.push_back({offset, size, fenceValue + 1});
+
+		if (random() % 7 == 0)
+			ring.Retire(++fenceValue);
+
+		if (random() % 5 == 0 && ring.HasRetiredSpace())
+			reclaimOldest();
+	}
+}
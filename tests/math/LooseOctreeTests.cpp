@@ -0,0 +1,252 @@
+#include "TestFramework.hpp"
+
+#include "engine/math/LooseOctree.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+using engine::math::BoxBounds;
+using engine::math::Float3;
+using engine::math::FrustumPlanes;
+using engine::math::LooseOctree;
+
+namespace
+{
+
+constexpr BoxBounds World = {{-512.f, -512.f, -512.f}, {512.f, 512.f, 512.f}};
+
+class RandomBoxes
+{
+public:
+	explicit RandomBoxes(uint32_t seed) : m_random(seed) {}
+
+	float Uniform(float low, float high) { return std::uniform_real_distribution<float>(low, high)(m_random); }
+	uint32_t Next() { return m_random(); }
+
+	// Majoritatea obiectelor mici, cateva foarte mari; unele ies din lume
+	BoxBounds Make()
+	{
+		const float halfSize = Uniform(0.f, 1.f) < 0.9f ? Uniform(0.1f, 5.f) : Uniform(5.f, 400.f);
+
+		BoxBounds box;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			const float center = Uniform(-600.f, 600.f);
+			box.min[axis] = center - halfSize * Uniform(0.2f, 1.f);
+			box.max[axis] = center + halfSize * Uniform(0.2f, 1.f);
+		}
+
+		return box;
+	}
+
+private:
+	std::mt19937 m_random;
+};
+
+bool Overlaps(const BoxBounds& a, const BoxBounds& b)
+{
+	for (int axis = 0; axis < 3; axis++)
+	{
+		if (a.max[axis] < b.min[axis] || a.min[axis] > b.max[axis])
+			return false;
+	}
+
+	return true;
+}
+
+bool IntersectsSphere(const BoxBounds& box, const Float3& center, float radius)
+{
+	float distance2 = 0.f;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		const float nearest = std::clamp(center[axis], box.min[axis], box.max[axis]);
+		distance2 += (center[axis] - nearest) * (center[axis] - nearest);
+	}
+
+	return distance2 <= radius * radius;
+}
+
+// Un colt al cutiei in interiorul tuturor planelor nu e suficient; testul e acelasi ca in Frustum::IntersectBoundingBox
+bool IntersectsFrustum(const BoxBounds& box, const FrustumPlanes& planes)
+{
+	for (const auto& plane : planes)
+	{
+		float farDistance = plane[3];
+		for (int axis = 0; axis < 3; axis++)
+			farDistance += plane[axis] * (plane[axis] > 0.f ? box.max[axis] : box.min[axis]);
+
+		if (farDistance < 0.f)
+			return false;
+	}
+
+	return true;
+}
+
+// Piramida cu varful in eye, privind spre +x, intre near si far; normalele spre interior
+FrustumPlanes MakeFrustum(const Float3& eye, float nearDistance, float farDistance)
+{
+	const float side = 1.f / std::sqrt(2.f);
+
+	FrustumPlanes planes = {{
+		{1.f, 0.f, 0.f, -(eye[0] + nearDistance)},
+		{-1.f, 0.f, 0.f, eye[0] + farDistance},
+		{side, 0.f, -side, 0.f},
+		{side, 0.f, side, 0.f},
+		{side, -side, 0.f, 0.f},
+		{side, side, 0.f, 0.f}}};
+
+	// Planele laterale trec prin eye
+	for (int i = 2; i < 6; i++)
+		planes[i][3] = -(planes[i][0] * eye[0] + planes[i][1] * eye[1] + planes[i][2] * eye[2]);
+
+	return planes;
+}
+
+}  // namespace
+
+TEST_CASE(QueriesFindInsertedObjects)
+{
+	LooseOctree octree(World);
+
+	const LooseOctree::Handle small = octree.Insert({{10.f, 10.f, 10.f}, {11.f, 11.f, 11.f}}, 1);
+	octree.Insert({{-300.f, -5.f, -5.f}, {300.f, 5.f, 5.f}}, 2);
+	octree.Insert({{900.f, 900.f, 900.f}, {901.f, 901.f, 901.f}}, 3);
+
+	CHECK(octree.GetObjectCount() == 3);
+	CHECK(octree.GetUserData(small) == 1);
+
+	std::vector<uint32_t> result;
+	octree.QueryBox({{9.f, 9.f, 9.f}, {12.f, 12.f, 12.f}}, result);
+	CHECK(result == std::vector<uint32_t>{1});
+
+	// Obiectul din afara lumii se gaseste si el
+	result.clear();
+	octree.QuerySphere({900.5f, 900.5f, 900.5f}, 2.f, result);
+	CHECK(result == std::vector<uint32_t>{3});
+
+	result.clear();
+	octree.QueryRay({-400.f, 0.f, 0.f}, {1.f, 0.f, 0.f}, 1000.f, result);
+	CHECK(result == std::vector<uint32_t>{2});
+
+	// Frustum spre +x care atinge obiectul mic si bara, dar nu si obiectul din afara lumii
+	result.clear();
+	octree.QueryFrustum(MakeFrustum({0.f, 10.5f, 10.5f}, 5.f, 20.f), result);
+	std::sort(result.begin(), result.end());
+	CHECK(result == std::vector<uint32_t>({1, 2}));
+
+	octree.Update(small, {{-100.f, 100.f, -100.f}, {-99.f, 101.f, -99.f}});
+	result.clear();
+	octree.QueryBox({{9.f, 9.f, 9.f}, {12.f, 12.f, 12.f}}, result);
+	CHECK(result.empty());
+
+	octree.Remove(small);
+	CHECK(octree.GetObjectCount() == 2);
+
+	octree.Clear();
+	CHECK(octree.GetObjectCount() == 0);
+}
+
+TEST_CASE(RandomQueriesMatchBruteForce)
+{
+	constexpr uint32_t ObjectCount = 5000;
+
+	RandomBoxes random(1);
+	LooseOctree octree(World);
+
+	std::vector<BoxBounds> boxes(ObjectCount);
+	std::vector<LooseOctree::Handle> handles(ObjectCount);
+	std::vector<bool> isAlive(ObjectCount, true);
+	for (uint32_t i = 0; i < ObjectCount; i++)
+	{
+		boxes[i] = random.Make();
+		handles[i] = octree.Insert(boxes[i], i);
+	}
+
+	std::vector<uint32_t> result;
+	for (int iteration = 0; iteration < 30; iteration++)
+	{
+		// Obiecte mutate, scoase si adaugate din nou
+		for (int change = 0; change < 1000; change++)
+		{
+			const uint32_t i = random.Next() % ObjectCount;
+			if (!isAlive[i])
+			{
+				boxes[i] = random.Make();
+				handles[i] = octree.Insert(boxes[i], i);
+				isAlive[i] = true;
+			}
+			else if (random.Next() % 10 == 0)
+			{
+				octree.Remove(handles[i]);
+				isAlive[i] = false;
+			}
+			else
+			{
+				for (int axis = 0; axis < 3; axis++)
+				{
+					const float offset = random.Uniform(-20.f, 20.f);
+					boxes[i].min[axis] += offset;
+					boxes[i].max[axis] += offset;
+				}
+
+				octree.Update(handles[i], boxes[i]);
+			}
+		}
+
+		const BoxBounds query = random.Make();
+		result.clear();
+		octree.QueryBox(query, result);
+
+		std::set<uint32_t> found(result.begin(), result.end());
+		CHECK(found.size() == result.size());
+
+		uint32_t boxMismatches = 0;
+		for (uint32_t i = 0; i < ObjectCount; i++)
+		{
+			if (isAlive[i] && Overlaps(boxes[i], query) != (found.count(i) != 0))
+				boxMismatches++;
+		}
+
+		CHECK(boxMismatches == 0);
+
+		const Float3 center = {
+			random.Uniform(-600.f, 600.f), random.Uniform(-600.f, 600.f), random.Uniform(-600.f, 600.f)};
+		const float radius = random.Uniform(1.f, 200.f);
+
+		result.clear();
+		octree.QuerySphere(center, radius, result);
+
+		found = std::set<uint32_t>(result.begin(), result.end());
+		CHECK(found.size() == result.size());
+
+		uint32_t sphereMismatches = 0;
+		for (uint32_t i = 0; i < ObjectCount; i++)
+		{
+			if (isAlive[i] && IntersectsSphere(boxes[i], center, radius) != (found.count(i) != 0))
+				sphereMismatches++;
+		}
+
+		CHECK(sphereMismatches == 0);
+
+		const FrustumPlanes frustum = MakeFrustum(center, random.Uniform(0.5f, 10.f), random.Uniform(50.f, 800.f));
+
+		result.clear();
+		octree.QueryFrustum(frustum, result);
+
+		found = std::set<uint32_t>(result.begin(), result.end());
+		CHECK(found.size() == result.size());
+
+		uint32_t frustumMismatches = 0;
+		for (uint32_t i = 0; i < ObjectCount; i++)
+		{
+			if (isAlive[i] && IntersectsFrustum(boxes[i], frustum) != (found.count(i) != 0))
+				frustumMismatches++;
+		}
+
+		CHECK(frustumMismatches == 0);
+	}
+}